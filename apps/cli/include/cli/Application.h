@@ -7,6 +7,7 @@
 // Include singleton headers for complete types
 #include "../../foundation/logging/Logger.h"
 #include "../../foundation/config/ConfigManager.h"
+#include "../../foundation/memory/FrameArena.h"
 
 // Include core types we need
 #include "../../core/rendering/RenderTypes.h"
@@ -27,6 +28,7 @@ namespace VoxelEditor {
     namespace FileIO { class FileManager; }
     
     namespace Events { class EventDispatcher; }
+    namespace Memory { class MemoryGovernor; }
     namespace Logging { class Logger; }
     namespace Config { class ConfigManager; }
 }
@@ -132,6 +134,12 @@ private:
     std::unique_ptr<MouseInteraction> m_mouseInteraction;
     std::unique_ptr<VoxelMeshGenerator> m_meshGenerator;
     
+    // Scratch memory for one frame; reset at the start of every update()
+    Memory::FrameArena m_frameArena;
+    
+    // Keeps caches and history under one memory ceiling; sampled in update()
+    std::unique_ptr<Memory::MemoryGovernor> m_memoryGovernor;
+    
     // Application state
     bool m_running = false;
     bool m_headless = false;
@@ -146,9 +154,7 @@ private:
     // Mesh resolution settings
     SurfaceGen::PreviewQuality m_meshResolution = SurfaceGen::PreviewQuality::Disabled; // Default to auto (8cm)
     
-    // Current scene data for rendering
-    std::vector<Rendering::Mesh> m_voxelMeshes;
-    std::vector<Rendering::Mesh> m_edgeMeshes;  // Wireframe edge meshes
+    // Current scene data for rendering; voxel meshes live per chunk in m_meshGenerator
     Rendering::ShaderId m_defaultShaderId = Rendering::InvalidId;
     bool m_showEdges = true;  // Toggle for edge rendering
     bool m_debugGridVisible = false;  // Toggle for debug grid overlay
@@ -158,6 +164,7 @@ private:
     bool initializeCoreSystem();
     bool initializeRendering();
     bool initializeCLI();
+    void registerMemoryBudgets();
     void registerCommands();
     void processInput();
     
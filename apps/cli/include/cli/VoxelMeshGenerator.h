@@ -2,46 +2,146 @@
 
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 #include "rendering/RenderTypes.h"
 #include "voxel_data/VoxelTypes.h"
 #include "math/Vector3f.h"
+#include "math/Vector3i.h"
+#include "math/CoordinateTypes.h"
+#include "memory/FrameArena.h"
+#include "events/EventHandler.h"
+#include "events/CommonEvents.h"
 
 namespace VoxelEditor {
 namespace VoxelData {
     class VoxelDataManager;
 }
 
-class VoxelMeshGenerator {
+class VoxelMeshGenerator : public Events::EventHandler<Events::VoxelChangedEvent> {
 public:
-    struct Vertex {
-        Math::Vector3f position;
-        Math::Vector3f normal;
-        Math::Vector3f color;
+    // Voxels per chunk edge, counted in the chunk's own resolution
+    static constexpr int CHUNK_VOXELS = 16;
+    
+    // Chunks never mix resolutions, so neighbours of one size cull each other
+    struct ChunkKey {
+        VoxelData::VoxelResolution resolution;
+        Math::Vector3i coord;
+        
+        bool operator==(const ChunkKey& other) const {
+            return resolution == other.resolution && coord == other.coord;
+        }
+    };
+    
+    struct ChunkKeyHash {
+        size_t operator()(const ChunkKey& key) const {
+            return key.coord.hash() * 31 + static_cast<size_t>(key.resolution);
+        }
     };
     
+    // Render data of one chunk: visible faces at full size, and the outline
+    // of every voxel in it for the wireframe overlay
+    struct ChunkMesh {
+        Rendering::Mesh faces;
+        Rendering::Mesh edges;
+        size_t voxelCount = 0;
+    };
+    
+    using ChunkMap = std::unordered_map<ChunkKey, ChunkMesh, ChunkKeyHash>;
+    using BufferCallback = std::function<void(Rendering::Mesh&)>;
+    
     VoxelMeshGenerator();
     ~VoxelMeshGenerator();
     
+    // Scratch arena for the voxel snapshot taken under the manager lock; it
+    // is rewound before each call returns. nullptr uses a local arena.
+    void setArena(Memory::FrameArena* arena) { m_arena = arena; }
+    
     // Generate a simple cube mesh for all voxels
     Rendering::Mesh generateCubeMesh(const VoxelData::VoxelDataManager& voxelData);
     
     // Generate edge lines for all voxels (for wireframe overlay)
     Rendering::Mesh generateEdgeMesh(const VoxelData::VoxelDataManager& voxelData);
     
+    // Chunked render meshes. Edits mark the chunks they touch dirty, either
+    // through VoxelChangedEvent or markVoxelDirty(), and updateChunkMeshes()
+    // rebuilds only those. Faces shared by two voxels of the same resolution
+    // are left out. upload is called for every rebuilt mesh and release for
+    // every mesh that is replaced or dropped, so GPU buffers live exactly as
+    // long as their chunk.
+    void setBufferCallbacks(BufferCallback upload, BufferCallback release);
+    
+    // Dirties the voxel's chunk and the chunks of its six neighbours
+    void markVoxelDirty(const Math::IncrementCoordinates& pos, VoxelData::VoxelResolution resolution);
+    void markAllChunksDirty();
+    
+    // Rebuilds the dirty chunks and returns how many were rebuilt or dropped.
+    // A resolution whose voxel count no longer matches the built chunks was
+    // changed without events (clear, file load) and is rebuilt whole.
+    size_t updateChunkMeshes(const VoxelData::VoxelDataManager& voxelData);
+    
+    const ChunkMap& getChunkMeshes() const { return m_chunks; }
+    size_t getChunkMeshMemoryUsage() const;
+    
+    // Drops every chunk through the release callback. Call before the render
+    // engine goes away; the destructor does not release GPU buffers.
+    void clearChunkMeshes();
+    
+    static ChunkKey getChunkKey(const Math::IncrementCoordinates& pos, VoxelData::VoxelResolution resolution);
+    
+    // EventHandler
+    void handleEvent(const Events::VoxelChangedEvent& event) override;
+    
 private:
+    // Bottom-center world position and edge length of one voxel
+    struct VoxelBox {
+        Math::Vector3f position;
+        float size;
+    };
+    
+    // Copies every voxel of every resolution into boxes, holding the
+    // manager lock only while copying
+    void collectVoxelBoxes(const VoxelData::VoxelDataManager& voxelData,
+                           std::pmr::vector<VoxelBox>& boxes) const;
+    
     // Add cube vertices for a single voxel
-    void addCube(std::vector<Vertex>& vertices, 
-                 std::vector<uint32_t>& indices,
+    void addCube(Rendering::Mesh& mesh,
                  const Math::Vector3f& position,
                  float size,
-                 const Math::Vector3f& color);
+                 const Rendering::Color& color);
                  
     // Add edge lines for a single voxel
-    void addCubeEdges(std::vector<Vertex>& vertices,
-                      std::vector<uint32_t>& indices,
+    void addCubeEdges(Rendering::Mesh& mesh,
                       const Math::Vector3f& position,
                       float size,
-                      const Math::Vector3f& color);
+                      const Rendering::Color& color);
+    
+    // Add the faces of one voxel selected by faceMask (bit i = s_cubeFaces[i])
+    void addCubeFaces(Rendering::Mesh& mesh,
+                      const Math::Vector3f& position,
+                      float size,
+                      uint32_t faceMask,
+                      const Rendering::Color& color);
+    
+    void buildChunk(const VoxelData::VoxelDataManager& voxelData,
+                    const ChunkKey& key,
+                    ChunkMesh& chunk);
+    void releaseChunk(ChunkMesh& chunk);
+    
+    Memory::FrameArena* m_arena = nullptr;
+    
+    ChunkMap m_chunks;
+    size_t m_builtVoxelCounts[static_cast<int>(VoxelData::VoxelResolution::COUNT)] = {};
+    BufferCallback m_uploadBuffers;
+    BufferCallback m_releaseBuffers;
+    
+    // Filled from event handlers, which may run on any thread
+    std::unordered_set<ChunkKey, ChunkKeyHash> m_dirtyChunks;
+    bool m_allDirty = false;
+    mutable std::mutex m_dirtyMutex;
     
     // Cube vertex data (8 vertices)
     static const float s_cubeVertices[8][3];
@@ -49,6 +149,8 @@ private:
     static const uint32_t s_cubeFaces[6][4];
     // Face normals
     static const float s_faceNormals[6][3];
+    // Neighbour offset of each face, in voxel sizes
+    static const int s_faceOffsets[6][3];
 };
 
 } // namespace VoxelEditor
\ No newline at end of file
@@ -53,6 +53,7 @@
 #include "events/EventDispatcher.h"
 #include "logging/Logger.h"
 #include "config/ConfigManager.h"
+#include "memory/MemoryGovernor.h"
 #include "math/Matrix4f.h"
 #include "math/Vector2f.h"
 #include "math/Vector3f.h"
@@ -150,6 +151,17 @@ int Application::run() {
 void Application::shutdown() {
     std::cout << "\nShutting down..." << std::endl;
     
+    // Its callbacks point into the systems below
+    m_memoryGovernor.reset();
+    
+    // Chunk GPU buffers go back while the window's GL context still exists
+    if (m_meshGenerator) {
+        if (m_eventDispatcher) {
+            m_eventDispatcher->unsubscribe<Events::VoxelChangedEvent>(m_meshGenerator.get());
+        }
+        m_meshGenerator->clearChunkMeshes();
+    }
+    
     // Cleanup in reverse order
     m_mouseInteraction.reset();
     m_renderWindow.reset();
@@ -175,6 +187,9 @@ void Application::shutdown() {
     
     // Foundation (singletons don't need reset, only EventDispatcher)
     m_eventDispatcher.reset();
+    
+    // Write out anything still queued and go back to synchronous logging
+    Logging::Logger::getInstance().setAsync(false);
 }
 
 bool Application::initializeFoundation() {
@@ -211,6 +226,10 @@ bool Application::initializeFoundation() {
                 std::make_unique<FilteredConsoleOutput>());
         }
         
+        // Debug logging is on, so keep file and console writes off the
+        // editing threads
+        Logging::Logger::getInstance().setAsync(true);
+        
         // Config is a singleton
         Config::ConfigManager::getInstance().setValue("workspace.size", 5.0f);
         Config::ConfigManager::getInstance().setValue("workspace.min", 2.0f);
@@ -281,6 +300,8 @@ bool Application::initializeCoreSystem() {
         // File manager
         m_fileManager = std::make_unique<FileIO::FileManager>();
         
+        registerMemoryBudgets();
+        
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Failed to initialize core systems: " << e.what() << std::endl;
@@ -288,6 +309,68 @@ bool Application::initializeCoreSystem() {
     }
 }
 
+void Application::registerMemoryBudgets() {
+    // One ceiling for the whole editor; the governor decides which cache
+    // pays when the process goes over it
+    size_t ceilingMB = static_cast<size_t>(std::max(
+        Config::ConfigManager::getInstance().getValue<int>("memory.ceiling_mb", 4096), 256));
+    
+    m_memoryGovernor = std::make_unique<Memory::MemoryGovernor>(
+        &Memory::MemoryManager::getInstance().getOptimizer());
+    m_memoryGovernor->setCeiling(ceilingMB * 1024 * 1024);
+    
+    // Budgets also become each system's own hard limit. Eviction costs rank
+    // what a byte is worth: previews are redone in a frame, meshes in a few,
+    // and dropped undo history is gone for good.
+    const size_t previewBudget = 64 * 1024 * 1024;
+    const size_t meshBudget = 256 * 1024 * 1024;
+    const size_t selectionBudget = 32 * 1024 * 1024;
+    const size_t historyBudget = 256 * 1024 * 1024;
+    
+    SurfaceGen::SurfaceGenerator* surfaceGenerator = m_surfaceGenerator.get();
+    Selection::SelectionManager* selectionManager = m_selectionManager.get();
+    UndoRedo::HistoryManager* historyManager = m_historyManager.get();
+    
+    m_surfaceGenerator->setPreviewCacheMaxMemory(previewBudget);
+    Memory::MemoryGovernor::CacheRegistration preview;
+    preview.name = "SmoothingPreviewCache";
+    preview.budgetBytes = previewBudget;
+    preview.evictionCost = 0.5f;
+    preview.getUsage = [surfaceGenerator]() { return surfaceGenerator->getPreviewCacheMemoryUsage(); };
+    preview.evict = [surfaceGenerator](size_t bytes) { return surfaceGenerator->releasePreviewCacheMemory(bytes); };
+    m_memoryGovernor->registerCache(std::move(preview));
+    
+    m_surfaceGenerator->setCacheMaxMemory(meshBudget);
+    Memory::MemoryGovernor::CacheRegistration meshes;
+    meshes.name = "MeshCache";
+    meshes.budgetBytes = meshBudget;
+    meshes.evictionCost = 1.0f;
+    meshes.getUsage = [surfaceGenerator]() { return surfaceGenerator->getCacheMemoryUsage(); };
+    meshes.evict = [surfaceGenerator](size_t bytes) { return surfaceGenerator->releaseCacheMemory(bytes); };
+    // A cache that rarely hits is worth little however costly its meshes were
+    meshes.getValueScale = [surfaceGenerator]() { return std::max(0.1f, surfaceGenerator->getCacheHitRate()); };
+    m_memoryGovernor->registerCache(std::move(meshes));
+    
+    m_selectionManager->setMaxHistoryMemory(selectionBudget);
+    Memory::MemoryGovernor::CacheRegistration selection;
+    selection.name = "SelectionHistory";
+    selection.budgetBytes = selectionBudget;
+    selection.evictionCost = 2.0f;
+    selection.getUsage = [selectionManager]() { return selectionManager->getHistoryMemoryUsage(); };
+    selection.evict = [selectionManager](size_t bytes) { return selectionManager->releaseHistoryMemory(bytes); };
+    m_memoryGovernor->registerCache(std::move(selection));
+    
+    m_historyManager->setMaxMemoryUsage(historyBudget);
+    Memory::MemoryGovernor::CacheRegistration history;
+    history.name = "UndoHistory";
+    history.budgetBytes = historyBudget;
+    history.evictionCost = 8.0f;
+    history.getUsage = [historyManager]() { return historyManager->getMemoryUsage(); };
+    history.evict = [historyManager](size_t bytes) { return historyManager->releaseMemory(bytes); };
+    history.compress = [historyManager]() { return historyManager->optimizeMemory(); };
+    m_memoryGovernor->registerCache(std::move(history));
+}
+
 bool Application::initializeRendering() {
     try {
         // Create render window
@@ -427,17 +510,35 @@ bool Application::initializeCLI() {
             m_mouseInteraction = std::make_unique<MouseInteraction>(this);
             m_mouseInteraction->initialize();
             m_meshGenerator = std::make_unique<VoxelMeshGenerator>();
+            m_meshGenerator->setArena(&m_frameArena);
             
             // The RenderEngine will handle all OpenGL initialization
+            m_meshGenerator->setBufferCallbacks(
+                [this](Rendering::Mesh& mesh) {
+                    if (m_renderEngine) m_renderEngine->setupMeshBuffers(mesh);
+                },
+                [this](Rendering::Mesh& mesh) {
+                    if (m_renderEngine) m_renderEngine->cleanupMeshBuffers(mesh);
+                });
+            
+            // Voxel edits mark their chunks dirty; requestMeshUpdate() then
+            // rebuilds just those
+            m_eventDispatcher->subscribe<Events::VoxelChangedEvent>(m_meshGenerator.get());
+            
+            if (m_memoryGovernor) {
+                // Every chunk may be on screen, so the meshes are counted
+                // against the ceiling but never evicted
+                VoxelMeshGenerator* meshGenerator = m_meshGenerator.get();
+                Memory::MemoryGovernor::CacheRegistration chunkMeshes;
+                chunkMeshes.name = "RenderChunkMeshes";
+                chunkMeshes.getUsage = [meshGenerator]() { return meshGenerator->getChunkMeshMemoryUsage(); };
+                m_memoryGovernor->registerCache(std::move(chunkMeshes));
+            }
             
             // Create initial scene
             createScene();
         }
         
-        // Subscribe to voxel change events
-        // TODO: Implement proper event handlers when EventHandler supports lambdas
-        // For now, voxel mesh will be updated manually when needed
-        
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Failed to initialize CLI: " << e.what() << std::endl;
@@ -497,11 +598,18 @@ void Application::processInput() {
 }
 
 void Application::update() {
+    // Everything allocated in the previous frame's scratch is dead by now
+    m_frameArena.reset();
+    
     // Update mouse interaction if available
     if (m_mouseInteraction) {
         m_mouseInteraction->update();
     }
     
+    if (m_memoryGovernor) {
+        m_memoryGovernor->update();
+    }
+    
     // Process any pending events
     if (m_renderWindow) {
         m_renderWindow->pollEvents();
@@ -525,44 +633,46 @@ void Application::render() {
     // Clear with grey background
     m_renderEngine->clear(Rendering::ClearFlags::All, Rendering::Color(0.3f, 0.3f, 0.3f, 1.0f));
     
-    // Render all voxel meshes
+    // Render all voxel chunk meshes
+    const VoxelMeshGenerator::ChunkMap* chunks = m_meshGenerator ? &m_meshGenerator->getChunkMeshes() : nullptr;
     
-    for (size_t i = 0; i < m_voxelMeshes.size(); ++i) {
-        const auto& mesh = m_voxelMeshes[i];
-        if (!mesh.vertices.empty()) {
-            
-            // Create identity transform and basic material
-            Rendering::Transform transform;
-            Rendering::Material material;
-            material.albedo = Rendering::Color(0.8f, 0.8f, 0.8f, 1.0f);
-            
-            // Use configured shader or default to enhanced
-            if (m_defaultShaderId == Rendering::InvalidId) {
-                m_defaultShaderId = m_renderEngine->getBuiltinShader("enhanced");
+    if (chunks && !chunks->empty()) {
+        // Create identity transform and basic material
+        Rendering::Transform transform;
+        Rendering::Material material;
+        material.albedo = Rendering::Color(0.8f, 0.8f, 0.8f, 1.0f);
+        
+        // Use configured shader or default to enhanced
+        if (m_defaultShaderId == Rendering::InvalidId) {
+            m_defaultShaderId = m_renderEngine->getBuiltinShader("enhanced");
+        }
+        material.shader = m_defaultShaderId;
+        
+        for (const auto& entry : *chunks) {
+            // A chunk buried on every side has edges but no visible faces
+            if (!entry.second.faces.vertices.empty()) {
+                m_renderEngine->renderMesh(entry.second.faces, transform, material);
             }
-            material.shader = m_defaultShaderId;
-            
-            m_renderEngine->renderMesh(mesh, transform, material);
         }
     }
     
     // Render edge meshes as lines if enabled
-    if (m_showEdges && !m_edgeMeshes.empty()) {
+    if (m_showEdges && chunks && !chunks->empty()) {
         // Set up for line rendering
         m_renderEngine->setLineWidth(2.0f);  // Thicker lines for visibility
         
-        for (const auto& edgeMesh : m_edgeMeshes) {
-            if (edgeMesh.vertices.empty()) continue;
-            
-            // Create material for edges
-            Rendering::Transform transform;
-            Rendering::Material edgeMaterial;
-            edgeMaterial.albedo = Rendering::Color(0.1f, 0.1f, 0.1f, 1.0f);  // Dark edges
-            edgeMaterial.shader = m_renderEngine->getBuiltinShader("basic");  // Use basic shader for lines
-            edgeMaterial.doubleSided = true;
+        // Create material for edges
+        Rendering::Transform transform;
+        Rendering::Material edgeMaterial;
+        edgeMaterial.albedo = Rendering::Color(0.1f, 0.1f, 0.1f, 1.0f);  // Dark edges
+        edgeMaterial.shader = m_renderEngine->getBuiltinShader("basic");  // Use basic shader for lines
+        edgeMaterial.doubleSided = true;
+        
+        for (const auto& entry : *chunks) {
+            if (entry.second.edges.vertices.empty()) continue;
             
             // Use the proper render method for lines
-            m_renderEngine->renderMeshAsLines(edgeMesh, transform, edgeMaterial);
+            m_renderEngine->renderMeshAsLines(entry.second.edges, transform, edgeMaterial);
         }
         
         // Reset line width
@@ -628,61 +738,14 @@ void Application::updateVoxelMesh() {
         return;
     }
     
-    // Generate mesh from voxel data using the VoxelMeshGenerator
-    auto generatedMesh = m_meshGenerator->generateCubeMesh(*m_voxelManager);
+    // Only the chunks touched since the last update are rebuilt; their old
+    // GPU buffers are released and the new ones uploaded through the
+    // generator's buffer callbacks
+    size_t rebuiltChunks = m_meshGenerator->updateChunkMeshes(*m_voxelManager);
     
-    // Debug: Print mesh statistics
     Logging::Logger::getInstance().debugfc("Application",
-        "Mesh update: %zu vertices, %zu indices", 
-        generatedMesh.vertices.size(), generatedMesh.indices.size());
-    
-    // Clear existing meshes
-    m_voxelMeshes.clear();
-    m_edgeMeshes.clear();
-    
-    // Convert VoxelMeshGenerator::Mesh to Rendering::Mesh if we have data
-    if (!generatedMesh.vertices.empty()) {
-        Rendering::Mesh renderMesh;
-        
-        // Convert vertices from generator format to rendering format
-        renderMesh.vertices.reserve(generatedMesh.vertices.size());
-        for (const auto& v : generatedMesh.vertices) {
-            Rendering::Vertex renderVertex;
-            renderVertex.position = v.position;
-            renderVertex.normal = v.normal;
-            renderVertex.texCoords = Math::Vector2f(0.0f, 0.0f); // No tex coords for now
-            renderVertex.color = v.color;
-            renderMesh.vertices.push_back(renderVertex);
-        }
-        
-        // Copy indices
-        renderMesh.indices = generatedMesh.indices;
-        
-        // Set up mesh for rendering (this will create GPU buffers)
-        if (m_renderEngine) {
-            m_renderEngine->setupMeshBuffers(renderMesh);
-        }
-        
-        // Add to our mesh collection
-        size_t vertexCount = renderMesh.vertices.size();
-        m_voxelMeshes.push_back(std::move(renderMesh));
-        
-        Logging::Logger::getInstance().debugfc("Application",
-            "Created render mesh with %zu vertices", vertexCount);
-            
-        // Generate edge mesh for wireframe overlay
-        auto edgeMesh = m_meshGenerator->generateEdgeMesh(*m_voxelManager);
-        if (!edgeMesh.vertices.empty()) {
-            // Set up edge mesh for rendering
-            if (m_renderEngine) {
-                m_renderEngine->setupMeshBuffers(edgeMesh);
-            }
-            m_edgeMeshes.push_back(std::move(edgeMesh));
-            
-            Logging::Logger::getInstance().debugfc("Application",
-                "Created edge mesh with %zu vertices", m_edgeMeshes.back().vertices.size());
-        }
-    }
+        "Mesh update: %zu chunks rebuilt, %zu chunks cached",
+        rebuiltChunks, m_meshGenerator->getChunkMeshes().size());
 }
 
 
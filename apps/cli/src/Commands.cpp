@@ -20,6 +20,7 @@
 #include "cli/RenderWindow.h"
 #include "cli/BuildInfo.h"
 #include "cli/MouseInteraction.h"
+#include "cli/VoxelMeshGenerator.h"
 
 // Core includes
 #include "voxel_data/VoxelDataManager.h"
@@ -1503,11 +1504,18 @@ void Application::registerCommands() {
                 ss << "\nRender engine status: " << (m_renderEngine->isInitialized() ? "Initialized" : "Not initialized") << "\n";
                 
                 // Check if we have meshes
-                ss << "\nVoxel meshes: " << m_voxelMeshes.size() << "\n";
-                for (size_t i = 0; i < m_voxelMeshes.size(); i++) {
-                    ss << "  Mesh " << i << ": " << m_voxelMeshes[i].vertices.size() 
-                       << " vertices, " << m_voxelMeshes[i].indices.size() << " indices\n";
+                size_t chunkCount = 0;
+                size_t vertexCount = 0;
+                size_t indexCount = 0;
+                if (m_meshGenerator) {
+                    for (const auto& entry : m_meshGenerator->getChunkMeshes()) {
+                        ++chunkCount;
+                        vertexCount += entry.second.faces.vertices.size();
+                        indexCount += entry.second.faces.indices.size();
+                    }
                 }
+                ss << "\nVoxel chunk meshes: " << chunkCount << "\n";
+                ss << "  " << vertexCount << " vertices, " << indexCount << " indices\n";
                 
                 return CommandResult::Success(ss.str());
             }
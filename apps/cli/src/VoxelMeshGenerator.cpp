@@ -2,7 +2,9 @@
 #include "voxel_data/VoxelDataManager.h"
 #include "logging/Logger.h"
 #include "math/CoordinateTypes.h"
+#include "math/CoordinateConverter.h"
 #include <algorithm>
+#include <cmath>
 
 namespace VoxelEditor {
 
@@ -38,88 +40,102 @@ const float VoxelMeshGenerator::s_faceNormals[6][3] = {
     { 0.0f,  1.0f,  0.0f}  // Top
 };
 
+// Neighbour offsets matching s_cubeFaces
+const int VoxelMeshGenerator::s_faceOffsets[6][3] = {
+    { 0,  0, -1}, // Front
+    { 0,  0,  1}, // Back
+    {-1,  0,  0}, // Left
+    { 1,  0,  0}, // Right
+    { 0, -1,  0}, // Bottom
+    { 0,  1,  0}  // Top
+};
+
+namespace {
+
+int getVoxelSizeCm(VoxelData::VoxelResolution resolution) {
+    return static_cast<int>(std::lround(VoxelData::getVoxelSize(resolution) * 100.0f));
+}
+
+int floorDiv(int value, int divisor) {
+    int quotient = value / divisor;
+    return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+}
+
 VoxelMeshGenerator::VoxelMeshGenerator() {
 }
 
 VoxelMeshGenerator::~VoxelMeshGenerator() {
 }
 
-Rendering::Mesh VoxelMeshGenerator::generateCubeMesh(const VoxelData::VoxelDataManager& voxelData) {
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
-    
-    // Create mesh (declare early for error returns)
-    Rendering::Mesh mesh;
-    
-    Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
-        "Generating mesh for all voxels across all resolutions");
-    
+void VoxelMeshGenerator::collectVoxelBoxes(const VoxelData::VoxelDataManager& voxelData,
+                                           std::pmr::vector<VoxelBox>& boxes) const {
     // Iterate through all resolutions to render ALL voxels, not just active resolution
-    size_t totalVoxelCount = 0;
     for (int i = 0; i < static_cast<int>(VoxelData::VoxelResolution::COUNT); ++i) {
         VoxelData::VoxelResolution resolution = static_cast<VoxelData::VoxelResolution>(i);
         float voxelSize = VoxelData::getVoxelSize(resolution);
         
-        // Get all voxels at this resolution
-        auto voxelPositions = voxelData.getAllVoxels(resolution);
-        
-        if (!voxelPositions.empty()) {
-            Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
-                "Resolution %d: Found %zu voxels to render (size: %.2f)", 
-                i, voxelPositions.size(), voxelSize);
-        }
-        
         // Get the voxel grid for proper coordinate conversion
         const VoxelData::VoxelGrid* grid = voxelData.getGrid(resolution);
-        if (!grid && !voxelPositions.empty()) {
-            Logging::Logger::getInstance().errorfc("VoxelMeshGenerator", 
-                "Failed to get grid for resolution %d", i);
+        if (!grid) {
             continue;
         }
         
-        // Generate cube for each voxel at this resolution
-        for (const auto& voxelPos : voxelPositions) {
-            // Convert voxel grid coordinates to world position using grid's coordinate system
+        // Convert voxel grid coordinates to world position using grid's coordinate system
+        size_t firstBox = boxes.size();
+        voxelData.forEachVoxel(resolution, [&](const VoxelData::VoxelPosition& voxelPos) {
             Math::WorldCoordinates worldCoords = grid->incrementToWorld(voxelPos.incrementPos);
-            Math::Vector3f worldPos(worldCoords.x(), worldCoords.y(), worldCoords.z());
-            
-            if (totalVoxelCount < 3) {
-                Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
-                    "  Voxel %zu at grid pos (%d, %d, %d) -> world pos (%.3f, %.3f, %.3f)",
-                    totalVoxelCount, voxelPos.incrementPos.x(), voxelPos.incrementPos.y(), voxelPos.incrementPos.z(),
-                    worldPos.x, worldPos.y, worldPos.z);
-                Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
-                    "  VoxelSize: %.3f, Scale: %.3f, Final size: %.3f",
-                    voxelSize, 0.95f, voxelSize * 0.95f);
-            }
-            
-            // Use red color as expected by tests
-            Math::Vector3f color(1.0f, 0.0f, 0.0f);  // Red
-            
-            addCube(vertices, indices, worldPos, voxelSize * 0.95f, color); // Slight gap between cubes
-            totalVoxelCount++;
+            boxes.push_back({worldCoords.value(), voxelSize});
+        });
+        
+        if (boxes.size() > firstBox) {
+            Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
+                "Resolution %d: Found %zu voxels to render (size: %.2f)", 
+                i, boxes.size() - firstBox, voxelSize);
         }
     }
+}
+
+Rendering::Mesh VoxelMeshGenerator::generateCubeMesh(const VoxelData::VoxelDataManager& voxelData) {
+    Rendering::Mesh mesh;
     
     Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
-        "Total voxels rendered: %zu", totalVoxelCount);
-    
-    if (!vertices.empty()) {
-        // Convert our vertices to the format expected by Rendering::Mesh
-        mesh.vertices.resize(vertices.size());
-        for (size_t i = 0; i < vertices.size(); ++i) {
-            mesh.vertices[i].position = Math::WorldCoordinates(vertices[i].position);
-            mesh.vertices[i].normal = vertices[i].normal;
-            mesh.vertices[i].color = Rendering::Color(
-                vertices[i].color.x,
-                vertices[i].color.y,
-                vertices[i].color.z,
-                1.0f
-            );
-        }
+        "Generating mesh for all voxels across all resolutions");
+    
+    // The snapshot is scratch; vertices go straight into the mesh
+    Memory::FrameArena localArena;
+    Memory::FrameArena& scratch = m_arena ? *m_arena : localArena;
+    Memory::ArenaScope scratchScope(scratch);
+    
+    std::pmr::vector<VoxelBox> boxes(scratch.getResource());
+    collectVoxelBoxes(voxelData, boxes);
+    
+    mesh.vertices.reserve(boxes.size() * 24);
+    mesh.indices.reserve(boxes.size() * 36);
+    
+    // Use red color as expected by tests
+    const Rendering::Color color(1.0f, 0.0f, 0.0f, 1.0f);
+    
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const VoxelBox& box = boxes[i];
         
-        mesh.indices = std::move(indices);
+        if (i < 3) {
+            Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
+                "  Voxel %zu at world pos (%.3f, %.3f, %.3f)",
+                i, box.position.x, box.position.y, box.position.z);
+            Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
+                "  VoxelSize: %.3f, Scale: %.3f, Final size: %.3f",
+                box.size, 0.95f, box.size * 0.95f);
+        }
         
+        addCube(mesh, box.position, box.size * 0.95f, color); // Slight gap between cubes
+    }
+    
+    Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
+        "Total voxels rendered: %zu", boxes.size());
+    
+    if (!mesh.vertices.empty()) {
         Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
             "Generated mesh with %zu vertices and %zu indices", 
             mesh.vertices.size(), mesh.indices.size());
@@ -139,109 +155,81 @@ Rendering::Mesh VoxelMeshGenerator::generateCubeMesh(const VoxelData::VoxelDataM
     return mesh;
 }
 
-void VoxelMeshGenerator::addCube(std::vector<Vertex>& vertices,
-                                std::vector<uint32_t>& indices,
+void VoxelMeshGenerator::addCube(Rendering::Mesh& mesh,
                                 const Math::Vector3f& position,
                                 float size,
-                                const Math::Vector3f& color) {
-    uint32_t baseIndex = vertices.size();
-    
+                                const Rendering::Color& color) {
+    addCubeFaces(mesh, position, size, 0x3F, color);
+}
+
+void VoxelMeshGenerator::addCubeFaces(Rendering::Mesh& mesh,
+                                     const Math::Vector3f& position,
+                                     float size,
+                                     uint32_t faceMask,
+                                     const Rendering::Color& color) {
     // Interpret position as bottom-center of the cube
     // Adjust cube center to be at (position.x, position.y + size/2, position.z)
     Math::Vector3f cubeCenter(position.x, position.y + size * 0.5f, position.z);
     
     // Add vertices for each face
     for (int face = 0; face < 6; ++face) {
+        if (!(faceMask & (1u << face))) {
+            continue;
+        }
+        
         Math::Vector3f normal(s_faceNormals[face][0], 
                              s_faceNormals[face][1], 
                              s_faceNormals[face][2]);
+        uint32_t faceBase = static_cast<uint32_t>(mesh.vertices.size());
         
         // Add 4 vertices for this face
         for (int v = 0; v < 4; ++v) {
             int vertexIndex = s_cubeFaces[face][v];
-            Vertex vertex;
-            vertex.position = Math::Vector3f(
+            Math::Vector3f vertexPos(
                 cubeCenter.x + s_cubeVertices[vertexIndex][0] * size,
                 cubeCenter.y + s_cubeVertices[vertexIndex][1] * size,
                 cubeCenter.z + s_cubeVertices[vertexIndex][2] * size
             );
-            vertex.normal = normal;
-            vertex.color = color;
-            vertices.push_back(vertex);
+            mesh.vertices.emplace_back(Math::WorldCoordinates(vertexPos), normal,
+                                       Math::Vector2f::zero(), color);
         }
         
         // Add indices for 2 triangles
-        uint32_t faceBase = baseIndex + face * 4;
         // First triangle
-        indices.push_back(faceBase + 0);
-        indices.push_back(faceBase + 1);
-        indices.push_back(faceBase + 2);
+        mesh.indices.push_back(faceBase + 0);
+        mesh.indices.push_back(faceBase + 1);
+        mesh.indices.push_back(faceBase + 2);
         // Second triangle
-        indices.push_back(faceBase + 0);
-        indices.push_back(faceBase + 2);
-        indices.push_back(faceBase + 3);
+        mesh.indices.push_back(faceBase + 0);
+        mesh.indices.push_back(faceBase + 2);
+        mesh.indices.push_back(faceBase + 3);
     }
 }
 
 Rendering::Mesh VoxelMeshGenerator::generateEdgeMesh(const VoxelData::VoxelDataManager& voxelData) {
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
-    
-    // Create mesh (declare early for error returns)
     Rendering::Mesh mesh;
     
     Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
         "Generating edge mesh for all voxels across all resolutions");
     
-    // Iterate through all resolutions to render ALL voxels, not just active resolution
-    for (int i = 0; i < static_cast<int>(VoxelData::VoxelResolution::COUNT); ++i) {
-        VoxelData::VoxelResolution resolution = static_cast<VoxelData::VoxelResolution>(i);
-        float voxelSize = VoxelData::getVoxelSize(resolution);
-        
-        // Get all voxels at this resolution
-        auto voxelPositions = voxelData.getAllVoxels(resolution);
-        
-        if (voxelPositions.empty()) {
-            continue;
-        }
-        
-        // Get the voxel grid for proper coordinate conversion
-        const VoxelData::VoxelGrid* grid = voxelData.getGrid(resolution);
-        if (!grid) {
-            Logging::Logger::getInstance().errorfc("VoxelMeshGenerator", 
-                "Failed to get grid for resolution %d", i);
-            continue;
-        }
-        
-        // Generate edge lines for each voxel at this resolution
-        for (const auto& voxelPos : voxelPositions) {
-            // Convert voxel grid coordinates to world position using grid's coordinate system
-            Math::WorldCoordinates worldCoords = grid->incrementToWorld(voxelPos.incrementPos);
-            Math::Vector3f worldPos(worldCoords.x(), worldCoords.y(), worldCoords.z());
-            
-            // Use black color for edges
-            Math::Vector3f edgeColor(0.1f, 0.1f, 0.1f);  // Very dark gray
-            
-            addCubeEdges(vertices, indices, worldPos, voxelSize * 0.95f, edgeColor);
-        }
+    Memory::FrameArena localArena;
+    Memory::FrameArena& scratch = m_arena ? *m_arena : localArena;
+    Memory::ArenaScope scratchScope(scratch);
+    
+    std::pmr::vector<VoxelBox> boxes(scratch.getResource());
+    collectVoxelBoxes(voxelData, boxes);
+    
+    mesh.vertices.reserve(boxes.size() * 8);
+    mesh.indices.reserve(boxes.size() * 24);
+    
+    // Use black color for edges
+    const Rendering::Color edgeColor(0.1f, 0.1f, 0.1f, 1.0f);  // Very dark gray
+    
+    for (const VoxelBox& box : boxes) {
+        addCubeEdges(mesh, box.position, box.size * 0.95f, edgeColor);
     }
     
-    if (!vertices.empty()) {
-        // Convert our vertices to the format expected by Rendering::Mesh
-        mesh.vertices.resize(vertices.size());
-        for (size_t i = 0; i < vertices.size(); ++i) {
-            mesh.vertices[i].position = Math::WorldCoordinates(vertices[i].position);
-            mesh.vertices[i].normal = vertices[i].normal;
-            mesh.vertices[i].color = Rendering::Color(
-                vertices[i].color.x,
-                vertices[i].color.y,
-                vertices[i].color.z,
-                1.0f
-            );
-        }
-        
-        mesh.indices = std::move(indices);
-        
+    if (!mesh.vertices.empty()) {
         Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
             "Generated edge mesh with %zu vertices and %zu indices", 
             mesh.vertices.size(), mesh.indices.size());
@@ -250,12 +238,11 @@ Rendering::Mesh VoxelMeshGenerator::generateEdgeMesh(const VoxelData::VoxelDataM
     return mesh;
 }
 
-void VoxelMeshGenerator::addCubeEdges(std::vector<Vertex>& vertices,
-                                     std::vector<uint32_t>& indices,
+void VoxelMeshGenerator::addCubeEdges(Rendering::Mesh& mesh,
                                      const Math::Vector3f& position,
                                      float size,
-                                     const Math::Vector3f& color) {
-    uint32_t baseIndex = vertices.size();
+                                     const Rendering::Color& color) {
+    uint32_t baseIndex = mesh.vertices.size();
     
     // Interpret position as bottom-center of the cube
     // Adjust cube center to be at (position.x, position.y + size/2, position.z)
@@ -263,15 +250,14 @@ void VoxelMeshGenerator::addCubeEdges(std::vector<Vertex>& vertices,
     
     // Add 8 unique vertices for the cube corners
     for (int i = 0; i < 8; ++i) {
-        Vertex vertex;
-        vertex.position = Math::Vector3f(
+        Math::Vector3f vertexPos(
             cubeCenter.x + s_cubeVertices[i][0] * size,
             cubeCenter.y + s_cubeVertices[i][1] * size,
             cubeCenter.z + s_cubeVertices[i][2] * size
         );
-        vertex.normal = Math::Vector3f(0, 1, 0); // Dummy normal for lines
-        vertex.color = color;
-        vertices.push_back(vertex);
+        // Dummy normal for lines
+        mesh.vertices.emplace_back(Math::WorldCoordinates(vertexPos), Math::Vector3f(0, 1, 0),
+                                   Math::Vector2f::zero(), color);
     }
     
     // Define the 12 edges of a cube
@@ -287,9 +273,216 @@ void VoxelMeshGenerator::addCubeEdges(std::vector<Vertex>& vertices,
     
     // Add line indices for each edge
     for (int i = 0; i < 12; ++i) {
-        indices.push_back(baseIndex + edges[i][0]);
-        indices.push_back(baseIndex + edges[i][1]);
+        mesh.indices.push_back(baseIndex + edges[i][0]);
+        mesh.indices.push_back(baseIndex + edges[i][1]);
+    }
+}
+
+VoxelMeshGenerator::ChunkKey VoxelMeshGenerator::getChunkKey(const Math::IncrementCoordinates& pos,
+                                                            VoxelData::VoxelResolution resolution) {
+    int span = CHUNK_VOXELS * getVoxelSizeCm(resolution);
+    return ChunkKey{resolution, Math::Vector3i(floorDiv(pos.x(), span),
+                                               floorDiv(pos.y(), span),
+                                               floorDiv(pos.z(), span))};
+}
+
+void VoxelMeshGenerator::setBufferCallbacks(BufferCallback upload, BufferCallback release) {
+    m_uploadBuffers = std::move(upload);
+    m_releaseBuffers = std::move(release);
+}
+
+void VoxelMeshGenerator::markVoxelDirty(const Math::IncrementCoordinates& pos,
+                                        VoxelData::VoxelResolution resolution) {
+    int sizeCm = getVoxelSizeCm(resolution);
+    
+    // A neighbour in another chunk gains or loses the face it shares with
+    // this voxel, so its chunk has to be rebuilt as well
+    std::lock_guard<std::mutex> lock(m_dirtyMutex);
+    m_dirtyChunks.insert(getChunkKey(pos, resolution));
+    for (int face = 0; face < 6; ++face) {
+        Math::Vector3i offset(s_faceOffsets[face][0], s_faceOffsets[face][1], s_faceOffsets[face][2]);
+        m_dirtyChunks.insert(getChunkKey(Math::IncrementCoordinates(pos.value() + offset * sizeCm), resolution));
+    }
+}
+
+void VoxelMeshGenerator::markAllChunksDirty() {
+    std::lock_guard<std::mutex> lock(m_dirtyMutex);
+    m_allDirty = true;
+}
+
+void VoxelMeshGenerator::handleEvent(const Events::VoxelChangedEvent& event) {
+    markVoxelDirty(Math::IncrementCoordinates(event.gridPos), event.resolution);
+}
+
+size_t VoxelMeshGenerator::updateChunkMeshes(const VoxelData::VoxelDataManager& voxelData) {
+    std::unordered_set<ChunkKey, ChunkKeyHash> dirty;
+    bool allDirty = false;
+    {
+        std::lock_guard<std::mutex> lock(m_dirtyMutex);
+        dirty.swap(m_dirtyChunks);
+        allDirty = m_allDirty;
+        m_allDirty = false;
     }
+    
+    std::unordered_set<ChunkKey, ChunkKeyHash> visited;
+    size_t changedChunks = 0;
+    auto rebuild = [&](const ChunkKey& key) {
+        if (!visited.insert(key).second) {
+            return;
+        }
+        
+        size_t& builtCount = m_builtVoxelCounts[static_cast<int>(key.resolution)];
+        auto it = m_chunks.find(key);
+        bool existed = it != m_chunks.end();
+        if (!existed) {
+            it = m_chunks.emplace(key, ChunkMesh()).first;
+        }
+        ChunkMesh& chunk = it->second;
+        builtCount -= chunk.voxelCount;
+        
+        releaseChunk(chunk);
+        buildChunk(voxelData, key, chunk);
+        
+        if (chunk.voxelCount == 0) {
+            m_chunks.erase(it);
+            changedChunks += existed ? 1 : 0;
+            return;
+        }
+        
+        ++changedChunks;
+        builtCount += chunk.voxelCount;
+        if (m_uploadBuffers) {
+            m_uploadBuffers(chunk.faces);
+            m_uploadBuffers(chunk.edges);
+        }
+    };
+    
+    for (const ChunkKey& key : dirty) {
+        rebuild(key);
+    }
+    
+    // Edits that bypass events show up as a count that no longer matches
+    for (int i = 0; i < static_cast<int>(VoxelData::VoxelResolution::COUNT); ++i) {
+        VoxelData::VoxelResolution resolution = static_cast<VoxelData::VoxelResolution>(i);
+        if (!allDirty && voxelData.getVoxelCount(resolution) == m_builtVoxelCounts[i]) {
+            continue;
+        }
+        
+        std::unordered_set<ChunkKey, ChunkKeyHash> keys;
+        for (const auto& entry : m_chunks) {
+            if (entry.first.resolution == resolution) {
+                keys.insert(entry.first);
+            }
+        }
+        voxelData.forEachVoxel(resolution, [&](const VoxelData::VoxelPosition& voxelPos) {
+            keys.insert(getChunkKey(voxelPos.incrementPos, resolution));
+        });
+        
+        for (const ChunkKey& key : keys) {
+            rebuild(key);
+        }
+    }
+    
+    if (changedChunks > 0) {
+        Logging::Logger::getInstance().debugfc("VoxelMeshGenerator",
+            "Rebuilt %zu chunk meshes, %zu chunks cached", changedChunks, m_chunks.size());
+    }
+    
+    return changedChunks;
+}
+
+void VoxelMeshGenerator::buildChunk(const VoxelData::VoxelDataManager& voxelData,
+                                    const ChunkKey& key,
+                                    ChunkMesh& chunk) {
+    chunk.faces.clear();
+    chunk.edges.clear();
+    chunk.voxelCount = 0;
+    
+    int sizeCm = getVoxelSizeCm(key.resolution);
+    int span = CHUNK_VOXELS * sizeCm;
+    Math::Vector3i chunkMin = key.coord * span;
+    Math::Vector3i chunkMax = chunkMin + Math::Vector3i(span - 1, span - 1, span - 1);
+    
+    // One range query, grown by a voxel on every side, holds every neighbour
+    // the faces are tested against
+    Math::Vector3i shell(sizeCm, sizeCm, sizeCm);
+    std::vector<VoxelData::VoxelPosition> voxels = voxelData.getVoxelsInRange(
+        key.resolution,
+        Math::IncrementCoordinates(chunkMin - shell),
+        Math::IncrementCoordinates(chunkMax + shell));
+    if (voxels.empty()) {
+        return;
+    }
+    
+    Memory::FrameArena localArena;
+    Memory::FrameArena& scratch = m_arena ? *m_arena : localArena;
+    Memory::ArenaScope scratchScope(scratch);
+    
+    std::pmr::unordered_set<Math::Vector3i> occupied(scratch.getResource());
+    occupied.reserve(voxels.size());
+    for (const VoxelData::VoxelPosition& voxel : voxels) {
+        occupied.insert(voxel.incrementPos.value());
+    }
+    
+    // Full size rather than the 0.95 of generateCubeMesh: with a gap the
+    // culled faces would show through it
+    const float voxelSize = VoxelData::getVoxelSize(key.resolution);
+    const Rendering::Color color(1.0f, 0.0f, 0.0f, 1.0f);
+    const Rendering::Color edgeColor(0.1f, 0.1f, 0.1f, 1.0f);
+    
+    for (const VoxelData::VoxelPosition& voxel : voxels) {
+        const Math::Vector3i& pos = voxel.incrementPos.value();
+        if (pos.x < chunkMin.x || pos.x > chunkMax.x ||
+            pos.y < chunkMin.y || pos.y > chunkMax.y ||
+            pos.z < chunkMin.z || pos.z > chunkMax.z) {
+            continue;
+        }
+        
+        uint32_t faceMask = 0;
+        for (int face = 0; face < 6; ++face) {
+            Math::Vector3i neighbour = pos + Math::Vector3i(s_faceOffsets[face][0],
+                                                            s_faceOffsets[face][1],
+                                                            s_faceOffsets[face][2]) * sizeCm;
+            if (occupied.find(neighbour) == occupied.end()) {
+                faceMask |= 1u << face;
+            }
+        }
+        
+        Math::Vector3f position = Math::CoordinateConverter::incrementToWorld(voxel.incrementPos).value();
+        addCubeFaces(chunk.faces, position, voxelSize, faceMask, color);
+        addCubeEdges(chunk.edges, position, voxelSize, edgeColor);
+        ++chunk.voxelCount;
+    }
+}
+
+void VoxelMeshGenerator::releaseChunk(ChunkMesh& chunk) {
+    if (m_releaseBuffers) {
+        m_releaseBuffers(chunk.faces);
+        m_releaseBuffers(chunk.edges);
+    }
+}
+
+size_t VoxelMeshGenerator::getChunkMeshMemoryUsage() const {
+    size_t total = 0;
+    for (const auto& entry : m_chunks) {
+        for (const Rendering::Mesh* mesh : {&entry.second.faces, &entry.second.edges}) {
+            total += mesh->vertices.capacity() * sizeof(Rendering::Vertex);
+            total += mesh->indices.capacity() * sizeof(uint32_t);
+        }
+    }
+    return total;
+}
+
+void VoxelMeshGenerator::clearChunkMeshes() {
+    for (auto& entry : m_chunks) {
+        releaseChunk(entry.second);
+    }
+    m_chunks.clear();
+    std::fill(std::begin(m_builtVoxelCounts), std::end(m_builtVoxelCounts), 0);
+    
+    std::lock_guard<std::mutex> lock(m_dirtyMutex);
+    m_dirtyChunks.clear();
+    m_allDirty = false;
 }
 
 } // namespace VoxelEditor
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "voxel_data/VoxelTypes.h"
 #include "math/Vector3f.h"
 #include "math/Vector3i.h"
+#include "events/EventDispatcher.h"
 #include <cmath>
 #include <memory>
 #include <set>
@@ -439,5 +440,178 @@ TEST_F(VoxelMeshGeneratorTest, EmptySceneAllResolutions) {
     EXPECT_EQ(mesh.indices.size(), 0) << "Empty scene should generate no indices";
 }
 
+// Test 13: A scratch arena changes nothing in the output and is rewound
+TEST_F(VoxelMeshGeneratorTest, ArenaProducesSameMesh) {
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(voxelManager->setVoxel(Math::Vector3i(i * 8, 0, 0), VoxelData::VoxelResolution::Size_8cm, true));
+    }
+    ASSERT_TRUE(voxelManager->setVoxel(Math::Vector3i(64, 64, 64), VoxelData::VoxelResolution::Size_64cm, true));
+    
+    auto expected = meshGenerator->generateCubeMesh(*voxelManager);
+    auto expectedEdges = meshGenerator->generateEdgeMesh(*voxelManager);
+    
+    Memory::FrameArena arena;
+    meshGenerator->setArena(&arena);
+    auto mesh = meshGenerator->generateCubeMesh(*voxelManager);
+    auto edgeMesh = meshGenerator->generateEdgeMesh(*voxelManager);
+    
+    ASSERT_EQ(mesh.vertices.size(), expected.vertices.size());
+    EXPECT_EQ(mesh.indices, expected.indices);
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        EXPECT_EQ(mesh.vertices[i].position, expected.vertices[i].position);
+        EXPECT_EQ(mesh.vertices[i].normal, expected.vertices[i].normal);
+    }
+    EXPECT_EQ(edgeMesh.vertices.size(), expectedEdges.vertices.size());
+    EXPECT_EQ(edgeMesh.indices, expectedEdges.indices);
+    
+    EXPECT_EQ(arena.getBytesUsed(), 0u);
+    EXPECT_GT(arena.getPeakBytesUsed(), 0u);
+}
+
+// Test 14: Faces shared by same-resolution neighbours are culled
+TEST_F(VoxelMeshGeneratorTest, ChunkMeshCullsSharedFaces) {
+    ASSERT_TRUE(voxelManager->setVoxel(Math::Vector3i(0, 0, 0), VoxelData::VoxelResolution::Size_8cm, true));
+    ASSERT_TRUE(voxelManager->setVoxel(Math::Vector3i(8, 0, 0), VoxelData::VoxelResolution::Size_8cm, true));
+    
+    EXPECT_EQ(meshGenerator->updateChunkMeshes(*voxelManager), 1u);
+    
+    const auto& chunks = meshGenerator->getChunkMeshes();
+    ASSERT_EQ(chunks.size(), 1u);
+    const auto& chunk = chunks.begin()->second;
+    EXPECT_EQ(chunk.voxelCount, 2u);
+    EXPECT_EQ(chunk.faces.vertices.size(), 10u * 4u) << "Two touching cubes show 10 faces";
+    EXPECT_EQ(chunk.faces.indices.size(), 10u * 6u);
+    EXPECT_EQ(chunk.edges.vertices.size(), 2u * 8u);
+    EXPECT_TRUE(validateNormals(chunk.faces));
+    
+    // No face points at the neighbour: the +X face of the first cube and the
+    // -X face of the second both sit on the plane between them
+    float sharedX = VoxelData::getVoxelSize(VoxelData::VoxelResolution::Size_8cm) * 0.5f;
+    for (size_t v = 0; v < chunk.faces.vertices.size(); v += 4) {
+        const auto& vertex = chunk.faces.vertices[v];
+        bool onSharedPlane = std::abs(vertex.position.x() - sharedX) < 0.001f;
+        EXPECT_FALSE(onSharedPlane && std::abs(vertex.normal.x) > 0.5f);
+    }
+}
+
+// Test 15: Neighbours across a chunk border still cull each other, other
+// resolutions do not
+TEST_F(VoxelMeshGeneratorTest, ChunkMeshCullsAcrossChunksButNotResolutions) {
+    const int span = VoxelMeshGenerator::CHUNK_VOXELS;  // 1cm voxels
+    ASSERT_TRUE(voxelManager->setVoxel(Math::Vector3i(span - 1, 0, 0), VoxelData::VoxelResolution::Size_1cm, true));
+    ASSERT_TRUE(voxelManager->setVoxel(Math::Vector3i(span, 0, 0), VoxelData::VoxelResolution::Size_1cm, true));
+    ASSERT_TRUE(voxelManager->setVoxel(Math::Vector3i(span - 1, 1, 0), VoxelData::VoxelResolution::Size_2cm, true));
+    
+    EXPECT_EQ(meshGenerator->updateChunkMeshes(*voxelManager), 3u);
+    
+    size_t oneCmFaces = 0;
+    size_t twoCmFaces = 0;
+    for (const auto& entry : meshGenerator->getChunkMeshes()) {
+        size_t faces = entry.second.faces.vertices.size() / 4;
+        if (entry.first.resolution == VoxelData::VoxelResolution::Size_1cm) {
+            oneCmFaces += faces;
+        } else {
+            twoCmFaces += faces;
+        }
+    }
+    EXPECT_EQ(oneCmFaces, 10u);
+    EXPECT_EQ(twoCmFaces, 6u);
+}
+
+// Test 16: Only the chunks an edit touches are rebuilt and re-uploaded
+TEST_F(VoxelMeshGeneratorTest, ChunkMeshRebuildsOnlyDirtyChunks) {
+    Events::EventDispatcher dispatcher;
+    VoxelData::VoxelDataManager manager(&dispatcher);
+    manager.resizeWorkspace(Math::Vector3f(5.0f, 5.0f, 5.0f));
+    dispatcher.subscribe<Events::VoxelChangedEvent>(meshGenerator.get());
+    
+    size_t uploads = 0;
+    size_t releases = 0;
+    meshGenerator->setBufferCallbacks(
+        [&uploads](Rendering::Mesh& mesh) { ++uploads; mesh.vertexBuffer = 1; },
+        [&releases](Rendering::Mesh& mesh) { if (mesh.vertexBuffer) ++releases; mesh.vertexBuffer = 0; });
+    
+    // Four chunks far apart
+    const auto resolution = VoxelData::VoxelResolution::Size_4cm;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(manager.setVoxel(Math::Vector3i(-160 + i * 100, 0, 0), resolution, true));
+    }
+    EXPECT_EQ(meshGenerator->updateChunkMeshes(manager), 4u);
+    EXPECT_EQ(meshGenerator->getChunkMeshes().size(), 4u);
+    EXPECT_EQ(uploads, 8u);
+    EXPECT_EQ(releases, 0u);
+    
+    // Nothing changed, nothing rebuilt
+    EXPECT_EQ(meshGenerator->updateChunkMeshes(manager), 0u);
+    
+    // Growing one voxel touches a single chunk
+    ASSERT_TRUE(manager.setVoxel(Math::Vector3i(-156, 0, 0), resolution, true));
+    EXPECT_EQ(meshGenerator->updateChunkMeshes(manager), 1u);
+    EXPECT_EQ(uploads, 10u);
+    EXPECT_EQ(releases, 2u);
+    
+    // Removing the last voxel of a chunk drops it and its buffers
+    ASSERT_TRUE(manager.setVoxel(Math::Vector3i(140, 0, 0), resolution, false));
+    EXPECT_EQ(meshGenerator->updateChunkMeshes(manager), 1u);
+    EXPECT_EQ(meshGenerator->getChunkMeshes().size(), 3u);
+    EXPECT_EQ(releases, 4u);
+    
+    dispatcher.unsubscribe<Events::VoxelChangedEvent>(meshGenerator.get());
+}
+
+// Test 17: Changes made without events are caught by the voxel count check
+TEST_F(VoxelMeshGeneratorTest, ChunkMeshNoticesClearWithoutEvents) {
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(voxelManager->setVoxel(Math::Vector3i(i * 64, 0, 0), VoxelData::VoxelResolution::Size_16cm, true));
+    }
+    meshGenerator->updateChunkMeshes(*voxelManager);
+    EXPECT_FALSE(meshGenerator->getChunkMeshes().empty());
+    EXPECT_GT(meshGenerator->getChunkMeshMemoryUsage(), 0u);
+    
+    voxelManager->clearAll();
+    meshGenerator->updateChunkMeshes(*voxelManager);
+    EXPECT_TRUE(meshGenerator->getChunkMeshes().empty());
+    EXPECT_EQ(meshGenerator->getChunkMeshMemoryUsage(), 0u);
+}
+
+// Test 18: Incremental chunk meshes match a full rebuild after random edits
+TEST_F(VoxelMeshGeneratorTest, ChunkMeshIncrementalMatchesFullRebuild) {
+    Events::EventDispatcher dispatcher;
+    VoxelData::VoxelDataManager manager(&dispatcher);
+    manager.resizeWorkspace(Math::Vector3f(5.0f, 5.0f, 5.0f));
+    dispatcher.subscribe<Events::VoxelChangedEvent>(meshGenerator.get());
+    
+    const auto resolution = VoxelData::VoxelResolution::Size_4cm;
+    uint32_t seed = 12345;
+    auto next = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+    
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 200; ++i) {
+            // Cells on the 4cm lattice so neighbours line up
+            Math::Vector3i pos(static_cast<int>(next() % 40) * 4 - 80,
+                               static_cast<int>(next() % 20) * 4,
+                               static_cast<int>(next() % 40) * 4 - 80);
+            manager.setVoxel(pos, resolution, (next() % 3) != 0);
+        }
+        meshGenerator->updateChunkMeshes(manager);
+    }
+    
+    VoxelMeshGenerator fresh;
+    fresh.updateChunkMeshes(manager);
+    
+    const auto& incremental = meshGenerator->getChunkMeshes();
+    const auto& rebuilt = fresh.getChunkMeshes();
+    ASSERT_EQ(incremental.size(), rebuilt.size());
+    for (const auto& entry : rebuilt) {
+        auto it = incremental.find(entry.first);
+        ASSERT_NE(it, incremental.end());
+        EXPECT_EQ(it->second.voxelCount, entry.second.voxelCount);
+        EXPECT_EQ(it->second.faces.vertices.size(), entry.second.faces.vertices.size());
+        EXPECT_EQ(it->second.faces.indices.size(), entry.second.faces.indices.size());
+    }
+    
+    dispatcher.unsubscribe<Events::VoxelChangedEvent>(meshGenerator.get());
+}
+
 } // namespace Tests
 } // namespace VoxelEditor
\ No newline at end of file
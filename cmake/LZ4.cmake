@@ -0,0 +1,39 @@
+# LZ4.cmake
+# Finds the optional LZ4 compression library and links it into targets
+
+# Find LZ4 through pkg-config first
+find_package(PkgConfig)
+if(PkgConfig_FOUND)
+    pkg_check_modules(LZ4 liblz4)
+endif()
+
+# If pkg-config didn't find LZ4, try to find it manually
+if(NOT LZ4_FOUND)
+    find_path(LZ4_INCLUDE_DIR lz4.h
+        PATHS /opt/homebrew/include /usr/local/include /usr/include
+    )
+    find_library(LZ4_LIBRARY NAMES lz4
+        PATHS /opt/homebrew/lib /usr/local/lib /usr/lib
+    )
+    if(LZ4_INCLUDE_DIR AND LZ4_LIBRARY)
+        set(LZ4_FOUND TRUE)
+        set(LZ4_INCLUDE_DIRS ${LZ4_INCLUDE_DIR})
+        set(LZ4_LIBRARIES ${LZ4_LIBRARY})
+    endif()
+endif()
+
+# Function to link LZ4 into a target and define HAVE_LZ4 for its sources
+# Does nothing when LZ4 was not found
+# Usage: target_link_lz4(target)
+function(target_link_lz4 target)
+    if(NOT LZ4_FOUND)
+        return()
+    endif()
+
+    target_include_directories(${target} PRIVATE ${LZ4_INCLUDE_DIRS})
+    target_compile_definitions(${target} PRIVATE HAVE_LZ4)
+    if(LZ4_LIBDIR)
+        target_link_directories(${target} PUBLIC ${LZ4_LIBDIR})
+    endif()
+    target_link_libraries(${target} PUBLIC ${LZ4_LIBRARIES})
+endfunction()
@@ -192,6 +192,32 @@ struct STLExportStats {
     std::vector<std::string> warnings;
 };
 
+// STL import options
+struct STLImportOptions {
+    STLUnits units = STLUnits::Millimeters;  // Units stored in the file; positions are returned in meters
+    bool weldVertices = true;                // Merge coincident vertices into an indexed mesh
+    float weldTolerance = 0.0f;              // In meters; 0 merges only bit-identical positions
+    unsigned int threadCount = 0;            // 0 = hardware concurrency
+    
+    static STLImportOptions Default() { return STLImportOptions(); }
+    
+    static STLImportOptions Unwelded() {
+        STLImportOptions options;
+        options.weldVertices = false;
+        return options;
+    }
+};
+
+// STL import statistics
+struct STLImportStats {
+    size_t triangleCount = 0;
+    size_t sourceVertexCount = 0;   // 3 per triangle, before welding
+    size_t vertexCount = 0;         // After welding
+    float importTime = 0.0f;
+    size_t fileSize = 0;
+    bool binary = false;
+};
+
 // Progress callback
 using ProgressCallback = std::function<void(float progress, const std::string& message)>;
 using SaveCompleteCallback = std::function<void(bool success, const std::string& filename)>;
@@ -29,6 +29,9 @@ public:
     // Mesh repair
     Rendering::Mesh repairMesh(const Rendering::Mesh& mesh) const;
     
+    // Unit conversion; every STL reader and writer derives its scale from this
+    static float getUnitToMillimeters(STLUnits unit);
+    
     // Statistics
     STLExportStats getLastExportStats() const { return m_lastStats; }
     
@@ -55,12 +58,6 @@ private:
     
     // Unit conversion
     float getUnitScale(STLUnits from, STLUnits to) const;
-    float getUnitToMillimeters(STLUnits unit) const;
-    
-    // Binary STL writing
-    void writeBinaryHeader(std::ofstream& file, uint32_t triangleCount);
-    void writeBinaryTriangle(std::ofstream& file, const Math::Vector3f& v0,
-                           const Math::Vector3f& v1, const Math::Vector3f& v2);
     
     // ASCII STL writing
     void writeASCIIHeader(std::ofstream& file, const std::string& name);
@@ -90,40 +87,55 @@ private:
     void updateStats(const Rendering::Mesh& mesh);
 };
 
-// STL file reader (for validation and testing)
+// STL file reader (for validation, testing and reference meshes)
+// Binary files are memory-mapped and decoded in parallel; ASCII files are split
+// into facet-aligned chunks parsed in parallel. Coincident vertices are welded
+// through a hash table so the result is an indexed mesh.
 class STLImporter {
 public:
     STLImporter();
     ~STLImporter();
     
     // Import STL file
-    bool importMesh(const std::string& filename, Rendering::Mesh& mesh);
+    bool importMesh(const std::string& filename, Rendering::Mesh& mesh,
+                   const STLImportOptions& options = STLImportOptions::Default());
     
     // Format detection
     bool isBinarySTL(const std::string& filename) const;
     
+    // Statistics
+    STLImportStats getLastImportStats() const { return m_lastStats; }
+    
     // Error handling
     FileError getLastError() const { return m_lastError; }
     std::string getLastErrorMessage() const { return m_lastErrorMessage; }
     
 private:
+    STLImportStats m_lastStats;
     FileError m_lastError = FileError::None;
     std::string m_lastErrorMessage;
     
-    // Format-specific import
-    bool importBinarySTL(const std::string& filename, Rendering::Mesh& mesh);
-    bool importASCIISTL(const std::string& filename, Rendering::Mesh& mesh);
+    // Format detection on file contents
+    static bool isBinarySTL(const uint8_t* data, size_t size);
     
-    // Binary STL reading
-    bool readBinaryHeader(std::ifstream& file, uint32_t& triangleCount);
-    bool readBinaryTriangle(std::ifstream& file, Math::Vector3f& v0,
-                          Math::Vector3f& v1, Math::Vector3f& v2,
-                          Math::Vector3f& normal);
+    // Format-specific import into a triangle soup (3 positions per triangle)
+    bool importBinarySTL(const uint8_t* data, size_t size, std::vector<Math::Vector3f>& positions,
+                        unsigned int threadCount);
+    bool importASCIISTL(const char* data, size_t size, std::vector<Math::Vector3f>& positions,
+                       unsigned int threadCount);
     
     // ASCII STL parsing
-    bool parseASCIISTL(std::ifstream& file, Rendering::Mesh& mesh);
-    bool parseVertex(const std::string& line, Math::Vector3f& vertex);
-    bool parseNormal(const std::string& line, Math::Vector3f& normal);
+    // Returns where facet data starts after the "solid <name>" header, or
+    // nullptr when the header is missing
+    static const char* skipASCIIHeader(const char* begin, const char* end);
+    static bool parseASCIIChunk(const char* begin, const char* end, std::vector<Math::Vector3f>& positions);
+    static const char* findFacetStart(const char* begin, const char* end);
+    
+    // Mesh construction (welding, unit conversion and normals)
+    void buildMesh(const std::vector<Math::Vector3f>& positions, const STLImportOptions& options,
+                  Rendering::Mesh& mesh) const;
+    
+    unsigned int resolveThreadCount(unsigned int requested, size_t workItems) const;
     
     // Error handling
     void setError(FileError error, const std::string& message);
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "FileTypes.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#ifdef VOXEL_EDITOR_WINDOWS
+#include <cstdio>
+#endif
+
+namespace VoxelEditor {
+namespace FileIO {
+
+// Streaming binary STL writer.
+// Triangles are appended in batches (for example straight from the mesher) and
+// encoded into pre-sized 50-byte records, with normals computed in parallel
+// chunks. Each block of records reaches the file with a single write, and the
+// triangle count in the header is patched in place on close(), so the complete
+// mesh never has to be buffered and the total count need not be known up front.
+class STLStreamWriter {
+public:
+    static constexpr size_t HEADER_SIZE = 84;   // 80 byte header + uint32 count
+    static constexpr size_t RECORD_SIZE = 50;   // normal + 3 vertices + attribute
+
+    STLStreamWriter();
+    ~STLStreamWriter();
+
+    STLStreamWriter(const STLStreamWriter&) = delete;
+    STLStreamWriter& operator=(const STLStreamWriter&) = delete;
+
+    // Stream lifetime
+    bool open(const std::string& filename,
+             const STLExportOptions& options = STLExportOptions::Default());
+    bool close();
+    bool isOpen() const;
+
+    // Batch input (indexed batches are bounds-checked before anything is written)
+    bool writeTriangles(const std::vector<Rendering::Vertex>& vertices,
+                       const std::vector<uint32_t>& indices);
+    bool writeTriangles(const std::vector<Math::WorldCoordinates>& vertices,
+                       const std::vector<uint32_t>& indices);
+    bool writeTriangleSoup(const std::vector<Math::Vector3f>& positions);
+    bool writeMesh(const Rendering::Mesh& mesh) { return writeTriangles(mesh.vertices, mesh.indices); }
+
+    // Configuration
+    void setThreadCount(unsigned int threadCount) { m_threadCount = threadCount; }
+    unsigned int getThreadCount() const { return m_threadCount; }
+    void setBlockTriangles(size_t triangles) { m_blockTriangles = triangles > 0 ? triangles : 1; }
+    size_t getBlockTriangles() const { return m_blockTriangles; }
+
+    // Statistics
+    uint64_t getTriangleCount() const { return m_triangleCount; }
+    uint64_t getBytesWritten() const { return m_bytesWritten; }
+
+    // Error handling
+    FileError getLastError() const { return m_lastError; }
+    std::string getLastErrorMessage() const { return m_lastErrorMessage; }
+
+    // Encode one triangle (normal computed from winding) into a 50-byte record
+    static void encodeTriangle(uint8_t* record, const Math::Vector3f& v0,
+                              const Math::Vector3f& v1, const Math::Vector3f& v2);
+
+private:
+#ifdef VOXEL_EDITOR_WINDOWS
+    std::FILE* m_file = nullptr;
+#else
+    int m_fd = -1;
+#endif
+    std::string m_filename;
+    uint64_t m_triangleCount = 0;
+    uint64_t m_bytesWritten = 0;
+
+    // Combined scale/translation/unit conversion: p' = p * m_scale + m_offset
+    float m_scale = 1.0f;
+    Math::Vector3f m_offset = Math::Vector3f(0, 0, 0);
+
+    unsigned int m_threadCount = 0;                 // 0 = hardware concurrency
+    size_t m_blockTriangles = 1 << 20;              // ~50MB of records per write
+    std::vector<uint8_t> m_recordBuffer;
+
+    FileError m_lastError = FileError::None;
+    std::string m_lastErrorMessage;
+
+    // Encode up to m_blockTriangles triangles at a time and flush each block
+    template<typename PositionFn>
+    bool writeBatch(size_t triangleCount, PositionFn&& position);
+
+    // Raw file access
+    bool writeBlock(const uint8_t* data, size_t size);
+    bool writeAt(uint64_t offset, const uint8_t* data, size_t size);
+    void closeHandle();
+
+    unsigned int resolveThreadCount(size_t triangleCount) const;
+    static float getUnitsPerMeter(STLUnits units);
+
+    // Error handling
+    void setError(FileError error, const std::string& message);
+    void clearError();
+};
+
+} // namespace FileIO
+} // namespace VoxelEditor
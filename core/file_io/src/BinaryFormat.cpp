@@ -526,7 +526,7 @@ bool BinaryFormat::writeGroupDataChunk(BinaryWriter& writer, const Groups::Group
             w.writeFloat(pivot.z());
             
             // Write voxel IDs
-            auto voxels = group->getVoxels();
+            const auto& voxels = group->getVoxels();
             w.writeUInt32(static_cast<uint32_t>(voxels.size()));
             for (const auto& voxelId : voxels) {
                 w.writeInt32(voxelId.position.x());
@@ -1,6 +1,7 @@
 #include "../include/file_io/FileManager.h"
 #include "../include/file_io/BinaryIO.h"
 #include "logging/Logger.h"
+#include "logging/PerformanceProfiler.h"
 #include <fstream>
 #include <filesystem>
 #include <algorithm>
@@ -30,6 +31,7 @@ FileManager::~FileManager() {
 
 FileResult FileManager::saveProject(const std::string& filename, const Project& project,
                                   const SaveOptions& options) {
+    PROFILE_SCOPE("FileManager::saveProject");
     auto startTime = std::chrono::steady_clock::now();
     
     reportProgress(0.0f, "Starting save...");
@@ -55,6 +57,7 @@ FileResult FileManager::saveProject(const std::string& filename, const Project&
 
 FileResult FileManager::loadProject(const std::string& filename, Project& project,
                                   const LoadOptions& options) {
+    PROFILE_SCOPE("FileManager::loadProject");
     auto startTime = std::chrono::steady_clock::now();
     
     reportProgress(0.0f, "Starting load...");
@@ -80,6 +83,7 @@ bool FileManager::hasProject(const std::string& filename) const {
 
 FileResult FileManager::exportSTL(const std::string& filename, const Rendering::Mesh& mesh,
                                 const STLExportOptions& options) {
+    PROFILE_SCOPE("FileManager::exportSTL");
     try {
         reportProgress(0.0f, "Exporting STL...");
         
@@ -98,6 +102,7 @@ FileResult FileManager::exportSTL(const std::string& filename, const Rendering::
 FileResult FileManager::exportMultiSTL(const std::string& filename, 
                                      const std::vector<Rendering::Mesh>& meshes,
                                      const STLExportOptions& options) {
+    PROFILE_SCOPE("FileManager::exportMultiSTL");
     try {
         reportProgress(0.0f, "Exporting STL meshes...");
         
@@ -374,6 +379,7 @@ FileResult FileManager::loadProjectInternal(const std::string& filename,
 }
 
 bool FileManager::createBackup(const std::string& filename) {
+    PROFILE_SCOPE("FileManager::createBackup");
     try {
         std::string backupFilename = getBackupFilename(filename);
         std::filesystem::copy(filename, backupFilename);
@@ -432,6 +438,7 @@ std::vector<std::string> FileManager::findBackupFiles(const std::string& filenam
 }
 
 void FileManager::autoSaveThreadFunc() {
+    Logging::PerformanceProfiler::getInstance().setThreadName("AutoSave");
     while (m_autoSaveThreadRunning) {
         std::this_thread::sleep_for(std::chrono::seconds(1));
         
@@ -446,6 +453,7 @@ void FileManager::autoSaveThreadFunc() {
 }
 
 void FileManager::performAutoSave(AutoSaveEntry& entry) {
+    PROFILE_SCOPE("FileManager::performAutoSave");
     std::string autoSaveFile = getAutoSaveFilename(entry.filename);
     
     SaveOptions options = SaveOptions::Fast();
@@ -1,4 +1,5 @@
 #include "../include/file_io/STLExporter.h"
+#include "../include/file_io/STLStreamWriter.h"
 #include "logging/Logger.h"
 #include <cstring>
 #include <fstream>
@@ -29,21 +30,20 @@ bool STLExporter::exportMesh(const std::string& filename, const Rendering::Mesh&
         }
     }
     
-    // Preprocess mesh
-    Rendering::Mesh processedMesh = preprocessMesh(mesh, options);
-    
-    // Export based on format
+    // Export based on format. The binary writer applies scale, translation and
+    // unit conversion while streaming, so the mesh is not copied first.
     bool success = false;
     if (options.format == STLFormat::Binary) {
-        success = exportBinarySTL(filename, processedMesh, options);
+        success = exportBinarySTL(filename, mesh, options);
     } else {
+        Rendering::Mesh processedMesh = preprocessMesh(mesh, options);
         success = exportASCIISTL(filename, processedMesh, options);
     }
     
     if (success) {
         auto endTime = std::chrono::steady_clock::now();
         m_lastStats.exportTime = std::chrono::duration<float>(endTime - startTime).count();
-        updateStats(processedMesh);
+        updateStats(mesh);
         
         // Get file size
         if (std::filesystem::exists(filename)) {
@@ -138,36 +138,18 @@ Rendering::Mesh STLExporter::repairMesh(const Rendering::Mesh& mesh) const {
 
 bool STLExporter::exportBinarySTL(const std::string& filename, const Rendering::Mesh& mesh,
                                 const STLExportOptions& options) {
-    std::ofstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        setError(FileError::AccessDenied, "Cannot open file for writing");
+    STLStreamWriter writer;
+    if (!writer.open(filename, options)) {
+        setError(writer.getLastError(), writer.getLastErrorMessage());
         return false;
     }
     
-    // Calculate triangle count
-    uint32_t triangleCount = static_cast<uint32_t>(mesh.indices.size() / 3);
-    
-    // Write header
-    writeBinaryHeader(file, triangleCount);
-    
-    // Write triangles
-    for (size_t i = 0; i < mesh.indices.size(); i += 3) {
-        // Bounds check
-        if (mesh.indices[i] >= mesh.vertices.size() ||
-            mesh.indices[i + 1] >= mesh.vertices.size() ||
-            mesh.indices[i + 2] >= mesh.vertices.size()) {
-            setError(FileError::InvalidFormat, "Index out of bounds during export");
-            return false;
-        }
-        
-        const Math::Vector3f& v0 = mesh.vertices[mesh.indices[i]].position.value();
-        const Math::Vector3f& v1 = mesh.vertices[mesh.indices[i + 1]].position.value();
-        const Math::Vector3f& v2 = mesh.vertices[mesh.indices[i + 2]].position.value();
-        
-        writeBinaryTriangle(file, v0, v1, v2);
+    if (!writer.writeMesh(mesh) || !writer.close()) {
+        setError(writer.getLastError(), writer.getLastErrorMessage());
+        return false;
     }
     
-    return file.good();
+    return true;
 }
 
 bool STLExporter::exportASCIISTL(const std::string& filename, const Rendering::Mesh& mesh,
@@ -287,7 +269,7 @@ float STLExporter::getUnitScale(STLUnits from, STLUnits to) const {
     return fromMM / toMM;
 }
 
-float STLExporter::getUnitToMillimeters(STLUnits unit) const {
+float STLExporter::getUnitToMillimeters(STLUnits unit) {
     switch (unit) {
         case STLUnits::Millimeters: return 1.0f;
         case STLUnits::Centimeters: return 10.0f;
@@ -297,45 +279,6 @@ float STLExporter::getUnitToMillimeters(STLUnits unit) const {
     }
 }
 
-void STLExporter::writeBinaryHeader(std::ofstream& file, uint32_t triangleCount) {
-    // Write 80 byte header (can be anything)
-    char header[80];
-    std::memset(header, 0, 80);
-    std::strcpy(header, "Binary STL exported by VoxelEditor");
-    file.write(header, 80);
-    
-    // Write triangle count
-    file.write(reinterpret_cast<const char*>(&triangleCount), sizeof(uint32_t));
-}
-
-void STLExporter::writeBinaryTriangle(std::ofstream& file, const Math::Vector3f& v0,
-                                    const Math::Vector3f& v1, const Math::Vector3f& v2) {
-    // Calculate normal
-    Math::Vector3f normal = calculateTriangleNormal(v0, v1, v2);
-    
-    // Write normal
-    file.write(reinterpret_cast<const char*>(&normal.x), sizeof(float));
-    file.write(reinterpret_cast<const char*>(&normal.y), sizeof(float));
-    file.write(reinterpret_cast<const char*>(&normal.z), sizeof(float));
-    
-    // Write vertices
-    file.write(reinterpret_cast<const char*>(&v0.x), sizeof(float));
-    file.write(reinterpret_cast<const char*>(&v0.y), sizeof(float));
-    file.write(reinterpret_cast<const char*>(&v0.z), sizeof(float));
-    
-    file.write(reinterpret_cast<const char*>(&v1.x), sizeof(float));
-    file.write(reinterpret_cast<const char*>(&v1.y), sizeof(float));
-    file.write(reinterpret_cast<const char*>(&v1.z), sizeof(float));
-    
-    file.write(reinterpret_cast<const char*>(&v2.x), sizeof(float));
-    file.write(reinterpret_cast<const char*>(&v2.y), sizeof(float));
-    file.write(reinterpret_cast<const char*>(&v2.z), sizeof(float));
-    
-    // Write attribute byte count (always 0)
-    uint16_t attributeByteCount = 0;
-    file.write(reinterpret_cast<const char*>(&attributeByteCount), sizeof(uint16_t));
-}
-
 void STLExporter::writeASCIIHeader(std::ofstream& file, const std::string& name) {
     file << "solid " << name << std::endl;
 }
@@ -451,113 +394,5 @@ void STLExporter::updateStats(const Rendering::Mesh& mesh) {
     m_lastStats.watertight = isWatertight(mesh);
 }
 
-// STLImporter implementation
-STLImporter::STLImporter() = default;
-STLImporter::~STLImporter() = default;
-
-bool STLImporter::importMesh(const std::string& filename, Rendering::Mesh& mesh) {
-    clearError();
-    
-    if (!std::filesystem::exists(filename)) {
-        setError(FileError::FileNotFound, "File not found: " + filename);
-        return false;
-    }
-    
-    if (isBinarySTL(filename)) {
-        return importBinarySTL(filename, mesh);
-    } else {
-        return importASCIISTL(filename, mesh);
-    }
-}
-
-bool STLImporter::isBinarySTL(const std::string& filename) const {
-    std::ifstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        return false;
-    }
-    
-    // Read first 5 bytes
-    char buffer[6];
-    file.read(buffer, 5);
-    buffer[5] = '\0';
-    
-    // ASCII STL files start with "solid"
-    return std::string(buffer) != "solid";
-}
-
-bool STLImporter::importBinarySTL(const std::string& filename, Rendering::Mesh& mesh) {
-    // TODO: Implement binary STL import
-    return false;
-}
-
-bool STLImporter::importASCIISTL(const std::string& filename, Rendering::Mesh& mesh) {
-    // TODO: Implement ASCII STL import
-    return false;
-}
-
-bool STLImporter::readBinaryHeader(std::ifstream& file, uint32_t& triangleCount) {
-    // Skip 80 byte header
-    file.seekg(80, std::ios::beg);
-    
-    // Read triangle count
-    file.read(reinterpret_cast<char*>(&triangleCount), sizeof(uint32_t));
-    
-    return file.good();
-}
-
-bool STLImporter::readBinaryTriangle(std::ifstream& file, Math::Vector3f& v0,
-                                   Math::Vector3f& v1, Math::Vector3f& v2,
-                                   Math::Vector3f& normal) {
-    // Read normal
-    file.read(reinterpret_cast<char*>(&normal.x), sizeof(float));
-    file.read(reinterpret_cast<char*>(&normal.y), sizeof(float));
-    file.read(reinterpret_cast<char*>(&normal.z), sizeof(float));
-    
-    // Read vertices
-    file.read(reinterpret_cast<char*>(&v0.x), sizeof(float));
-    file.read(reinterpret_cast<char*>(&v0.y), sizeof(float));
-    file.read(reinterpret_cast<char*>(&v0.z), sizeof(float));
-    
-    file.read(reinterpret_cast<char*>(&v1.x), sizeof(float));
-    file.read(reinterpret_cast<char*>(&v1.y), sizeof(float));
-    file.read(reinterpret_cast<char*>(&v1.z), sizeof(float));
-    
-    file.read(reinterpret_cast<char*>(&v2.x), sizeof(float));
-    file.read(reinterpret_cast<char*>(&v2.y), sizeof(float));
-    file.read(reinterpret_cast<char*>(&v2.z), sizeof(float));
-    
-    // Skip attribute byte count
-    uint16_t attributeByteCount;
-    file.read(reinterpret_cast<char*>(&attributeByteCount), sizeof(uint16_t));
-    
-    return file.good();
-}
-
-bool STLImporter::parseASCIISTL(std::ifstream& file, Rendering::Mesh& mesh) {
-    // TODO: Implement ASCII STL parsing
-    return false;
-}
-
-bool STLImporter::parseVertex(const std::string& line, Math::Vector3f& vertex) {
-    // TODO: Implement vertex parsing
-    return false;
-}
-
-bool STLImporter::parseNormal(const std::string& line, Math::Vector3f& normal) {
-    // TODO: Implement normal parsing
-    return false;
-}
-
-void STLImporter::setError(FileError error, const std::string& message) {
-    m_lastError = error;
-    m_lastErrorMessage = message;
-    LOG_ERROR("STLImporter: " + message);
-}
-
-void STLImporter::clearError() {
-    m_lastError = FileError::None;
-    m_lastErrorMessage.clear();
-}
-
 } // namespace FileIO
 } // namespace VoxelEditor
\ No newline at end of file
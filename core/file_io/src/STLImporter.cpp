@@ -0,0 +1,530 @@
+#include "../include/file_io/STLExporter.h"
+#include "logging/Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <thread>
+
+#ifdef VOXEL_EDITOR_WINDOWS
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace VoxelEditor {
+namespace FileIO {
+
+namespace {
+
+constexpr size_t BINARY_HEADER_SIZE = 84;
+constexpr size_t BINARY_RECORD_SIZE = 50;
+
+// Below these sizes a file is decoded on the calling thread
+constexpr size_t PARALLEL_BINARY_TRIANGLES = 65536;
+constexpr size_t PARALLEL_ASCII_BYTES = 4 * 1024 * 1024;
+
+// Read-only view of a whole file; memory-mapped where the platform allows it
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filename) {
+#ifdef VOXEL_EDITOR_WINDOWS
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return;
+        }
+        m_buffer.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        file.read(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size());
+        m_valid = file.good() || file.eof();
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == 0) {
+            m_size = static_cast<size_t>(st.st_size);
+            if (m_size == 0) {
+                m_valid = true;
+            } else {
+                void* mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapping != MAP_FAILED) {
+                    ::madvise(mapping, m_size, MADV_SEQUENTIAL);
+                    m_data = static_cast<const uint8_t*>(mapping);
+                    m_valid = true;
+                }
+            }
+        }
+        ::close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef VOXEL_EDITOR_WINDOWS
+        if (m_data) {
+            ::munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isValid() const { return m_valid; }
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_valid = false;
+#ifdef VOXEL_EDITOR_WINDOWS
+    std::vector<uint8_t> m_buffer;
+#endif
+};
+
+inline Math::Vector3f loadVector(const uint8_t* src) {
+    Math::Vector3f v;
+    std::memcpy(&v.x, src, sizeof(float));
+    std::memcpy(&v.y, src + 4, sizeof(float));
+    std::memcpy(&v.z, src + 8, sizeof(float));
+    return v;
+}
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+}
+
+inline bool parseFloat(const char*& p, const char* end, float& value) {
+    while (p < end && isSpace(*p)) ++p;
+    if (p < end && *p == '+') ++p;  // from_chars does not accept a leading '+'
+#if defined(__cpp_lib_to_chars)
+    auto result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    p = result.ptr;
+    return true;
+#else
+    // Standard libraries without floating-point from_chars: bounded strtof
+    char buffer[64];
+    size_t length = 0;
+    while (p + length < end && length < sizeof(buffer) - 1 && !isSpace(p[length])) {
+        buffer[length] = p[length];
+        ++length;
+    }
+    buffer[length] = '\0';
+    char* parsedEnd = nullptr;
+    value = std::strtof(buffer, &parsedEnd);
+    if (parsedEnd == buffer) {
+        return false;
+    }
+    p += parsedEnd - buffer;
+    return true;
+#endif
+}
+
+// Welding key: exact float bit patterns, or lattice cells when a tolerance is set
+struct WeldKey {
+    uint64_t x, y, z;
+
+    bool operator==(const WeldKey& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+};
+
+inline uint64_t floatKey(float value) {
+    if (value == 0.0f) value = 0.0f;  // Fold -0 into +0
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline uint64_t hashKey(const WeldKey& key) {
+    uint64_t h = key.x * 0x9E3779B97F4A7C15ull;
+    h ^= key.y * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+    h ^= key.z * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+    return h ^ (h >> 31);
+}
+
+inline float getMetersPerUnit(STLUnits units) {
+    return STLExporter::getUnitToMillimeters(units) / 1000.0f;
+}
+
+} // anonymous namespace
+
+STLImporter::STLImporter() = default;
+STLImporter::~STLImporter() = default;
+
+bool STLImporter::importMesh(const std::string& filename, Rendering::Mesh& mesh,
+                           const STLImportOptions& options) {
+    clearError();
+    m_lastStats = STLImportStats();
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (!std::filesystem::exists(filename)) {
+        setError(FileError::FileNotFound, "File not found: " + filename);
+        return false;
+    }
+
+    MappedFile file(filename);
+    if (!file.isValid()) {
+        setError(FileError::ReadError, "Cannot open file for reading: " + filename);
+        return false;
+    }
+    if (file.size() == 0) {
+        setError(FileError::InvalidFormat, "Empty STL file: " + filename);
+        return false;
+    }
+
+    m_lastStats.fileSize = file.size();
+    m_lastStats.binary = isBinarySTL(file.data(), file.size());
+
+    std::vector<Math::Vector3f> positions;
+    bool success = m_lastStats.binary
+        ? importBinarySTL(file.data(), file.size(), positions, options.threadCount)
+        : importASCIISTL(reinterpret_cast<const char*>(file.data()), file.size(), positions,
+                         options.threadCount);
+    if (!success) {
+        return false;
+    }
+
+    buildMesh(positions, options, mesh);
+
+    auto endTime = std::chrono::steady_clock::now();
+    m_lastStats.importTime = std::chrono::duration<float>(endTime - startTime).count();
+    m_lastStats.triangleCount = positions.size() / 3;
+    m_lastStats.sourceVertexCount = positions.size();
+    m_lastStats.vertexCount = mesh.vertices.size();
+
+    return true;
+}
+
+bool STLImporter::isBinarySTL(const std::string& filename) const {
+    MappedFile file(filename);
+    if (!file.isValid() || file.size() == 0) {
+        return false;
+    }
+    return isBinarySTL(file.data(), file.size());
+}
+
+bool STLImporter::isBinarySTL(const uint8_t* data, size_t size) {
+    // Some binary exporters start their header with "solid" too, so an exact
+    // size match with the declared triangle count wins over the keyword
+    if (size >= BINARY_HEADER_SIZE) {
+        uint32_t triangleCount = 0;
+        std::memcpy(&triangleCount, data + 80, sizeof(uint32_t));
+        if (BINARY_HEADER_SIZE + static_cast<uint64_t>(triangleCount) * BINARY_RECORD_SIZE == size) {
+            return true;
+        }
+    }
+
+    // ASCII STL files start with "solid"
+    size_t i = 0;
+    while (i < size && isSpace(static_cast<char>(data[i]))) ++i;
+    return !(size - i >= 5 && std::memcmp(data + i, "solid", 5) == 0);
+}
+
+bool STLImporter::importBinarySTL(const uint8_t* data, size_t size, std::vector<Math::Vector3f>& positions,
+                                unsigned int threadCount) {
+    if (size < BINARY_HEADER_SIZE) {
+        setError(FileError::CorruptedData, "Binary STL header is truncated");
+        return false;
+    }
+
+    uint32_t triangleCount = 0;
+    std::memcpy(&triangleCount, data + 80, sizeof(uint32_t));
+    if (size < BINARY_HEADER_SIZE + static_cast<uint64_t>(triangleCount) * BINARY_RECORD_SIZE) {
+        setError(FileError::CorruptedData, "Binary STL is truncated: expected " +
+                 std::to_string(triangleCount) + " triangles");
+        return false;
+    }
+
+    positions.resize(static_cast<size_t>(triangleCount) * 3);
+    const uint8_t* records = data + BINARY_HEADER_SIZE;
+    Math::Vector3f* out = positions.data();
+
+    // Stored normals are skipped; they are recomputed from the winding in buildMesh
+    auto decodeRange = [records, out](size_t first, size_t last) {
+        for (size_t t = first; t < last; ++t) {
+            const uint8_t* record = records + t * BINARY_RECORD_SIZE;
+            out[t * 3] = loadVector(record + 12);
+            out[t * 3 + 1] = loadVector(record + 24);
+            out[t * 3 + 2] = loadVector(record + 36);
+        }
+    };
+
+    unsigned int numThreads = triangleCount >= PARALLEL_BINARY_TRIANGLES
+        ? resolveThreadCount(threadCount, triangleCount / (PARALLEL_BINARY_TRIANGLES / 4))
+        : 1;
+    if (numThreads <= 1) {
+        decodeRange(0, triangleCount);
+        return true;
+    }
+
+    std::vector<std::future<void>> futures;
+    size_t perThread = triangleCount / numThreads;
+    size_t remainder = triangleCount % numThreads;
+    for (unsigned int t = 0; t < numThreads; ++t) {
+        size_t first = t * perThread + std::min(static_cast<size_t>(t), remainder);
+        size_t last = first + perThread + (t < remainder ? 1 : 0);
+        futures.push_back(std::async(std::launch::async, decodeRange, first, last));
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+
+    return true;
+}
+
+bool STLImporter::importASCIISTL(const char* data, size_t size, std::vector<Math::Vector3f>& positions,
+                               unsigned int threadCount) {
+    const char* begin = data;
+    const char* end = data + size;
+
+    begin = skipASCIIHeader(begin, end);
+    if (!begin) {
+        setError(FileError::CorruptedData, "ASCII STL does not start with \"solid\"");
+        return false;
+    }
+
+    unsigned int numThreads = size >= PARALLEL_ASCII_BYTES
+        ? resolveThreadCount(threadCount, size / (PARALLEL_ASCII_BYTES / 4))
+        : 1;
+
+    // Chunk boundaries are moved forward to the next facet so that every
+    // chunk holds whole triangles
+    std::vector<const char*> bounds;
+    bounds.push_back(begin);
+    size_t span = static_cast<size_t>(end - begin);
+    for (unsigned int t = 1; t < numThreads; ++t) {
+        const char* target = std::max(bounds.back(), begin + span * t / numThreads);
+        bounds.push_back(findFacetStart(target, end));
+    }
+    bounds.push_back(end);
+
+    bool success = true;
+    if (bounds.size() == 2) {
+        success = parseASCIIChunk(bounds[0], bounds[1], positions);
+    } else {
+        std::vector<std::vector<Math::Vector3f>> chunkPositions(bounds.size() - 1);
+        std::vector<std::future<bool>> futures;
+        for (size_t c = 0; c + 1 < bounds.size(); ++c) {
+            chunkPositions[c].reserve(static_cast<size_t>(bounds[c + 1] - bounds[c]) / 80);
+            futures.push_back(std::async(std::launch::async, [&, c]() {
+                return parseASCIIChunk(bounds[c], bounds[c + 1], chunkPositions[c]);
+            }));
+        }
+
+        size_t total = 0;
+        for (size_t c = 0; c < futures.size(); ++c) {
+            success = futures[c].get() && success;
+            total += chunkPositions[c].size();
+        }
+
+        if (success) {
+            positions.reserve(total);
+            for (const auto& chunk : chunkPositions) {
+                positions.insert(positions.end(), chunk.begin(), chunk.end());
+            }
+        }
+    }
+
+    if (!success) {
+        setError(FileError::CorruptedData, "Malformed vertex in ASCII STL");
+        return false;
+    }
+    if (positions.size() % 3 != 0) {
+        setError(FileError::CorruptedData, "ASCII STL facet does not have exactly 3 vertices");
+        return false;
+    }
+
+    return true;
+}
+
+bool STLImporter::parseASCIIChunk(const char* begin, const char* end, std::vector<Math::Vector3f>& positions) {
+    const char* p = begin;
+    while (p < end) {
+        while (p < end && isSpace(*p)) ++p;
+        const char* token = p;
+        while (p < end && !isSpace(*p)) ++p;
+
+        // Only vertex lines carry data; facet normals are recomputed from the winding
+        if (p - token == 6 && std::memcmp(token, "vertex", 6) == 0) {
+            Math::Vector3f vertex;
+            if (!parseFloat(p, end, vertex.x) ||
+                !parseFloat(p, end, vertex.y) ||
+                !parseFloat(p, end, vertex.z)) {
+                return false;
+            }
+            positions.push_back(vertex);
+        }
+    }
+    return true;
+}
+
+const char* STLImporter::skipASCIIHeader(const char* begin, const char* end) {
+    const char* p = begin;
+    while (p < end && isSpace(*p)) ++p;
+    if (end - p < 5 || std::memcmp(p, "solid", 5) != 0) {
+        return nullptr;
+    }
+    p += 5;
+
+    // The name runs to the end of the line and is skipped so it cannot be
+    // mistaken for a keyword. Writers that put everything on one line leave
+    // the first facet there, so parsing resumes at it.
+    while (p < end && *p != '\n') {
+        while (p < end && *p != '\n' && isSpace(*p)) ++p;
+        const char* token = p;
+        while (p < end && !isSpace(*p)) ++p;
+        size_t length = static_cast<size_t>(p - token);
+        if ((length == 5 && std::memcmp(token, "facet", 5) == 0) ||
+            (length == 8 && std::memcmp(token, "endsolid", 8) == 0)) {
+            return token;
+        }
+    }
+    return p;
+}
+
+const char* STLImporter::findFacetStart(const char* begin, const char* end) {
+    // A facet keyword preceded by whitespace ("endfacet" is preceded by 'd')
+    const char* p = begin;
+    while (p + 5 <= end) {
+        const char* hit = static_cast<const char*>(std::memchr(p, 'f', static_cast<size_t>(end - p)));
+        if (!hit || hit + 5 > end) {
+            break;
+        }
+        if (std::memcmp(hit, "facet", 5) == 0 && hit > begin && isSpace(hit[-1])) {
+            return hit;
+        }
+        p = hit + 1;
+    }
+    return end;
+}
+
+void STLImporter::buildMesh(const std::vector<Math::Vector3f>& positions, const STLImportOptions& options,
+                          Rendering::Mesh& mesh) const {
+    mesh.clear();
+
+    const float unitScale = getMetersPerUnit(options.units);
+    const size_t cornerCount = positions.size();
+    if (cornerCount == 0) {
+        return;
+    }
+
+    if (!options.weldVertices) {
+        mesh.vertices.resize(cornerCount);
+        mesh.indices.resize(cornerCount);
+        for (size_t i = 0; i < cornerCount; i += 3) {
+            Math::Vector3f v0 = positions[i] * unitScale;
+            Math::Vector3f v1 = positions[i + 1] * unitScale;
+            Math::Vector3f v2 = positions[i + 2] * unitScale;
+            Math::Vector3f normal = (v1 - v0).cross(v2 - v0).normalized();
+            mesh.vertices[i] = Rendering::Vertex(v0, normal);
+            mesh.vertices[i + 1] = Rendering::Vertex(v1, normal);
+            mesh.vertices[i + 2] = Rendering::Vertex(v2, normal);
+            mesh.indices[i] = static_cast<uint32_t>(i);
+            mesh.indices[i + 1] = static_cast<uint32_t>(i + 1);
+            mesh.indices[i + 2] = static_cast<uint32_t>(i + 2);
+        }
+        return;
+    }
+
+    // Open-addressing table of vertex indices (+1, 0 marks an empty slot)
+    size_t capacity = 16;
+    while (capacity < cornerCount * 2) {
+        capacity <<= 1;
+    }
+    const size_t mask = capacity - 1;
+    std::vector<uint32_t> slots(capacity, 0);
+    std::vector<WeldKey> keys;
+    keys.reserve(cornerCount / 4);
+
+    const bool quantize = options.weldTolerance > 0.0f;
+    const double invTolerance = quantize ? 1.0 / options.weldTolerance : 0.0;
+
+    mesh.indices.resize(cornerCount);
+    mesh.vertices.reserve(cornerCount / 4);
+    std::vector<Math::Vector3f> normalSums;
+    normalSums.reserve(cornerCount / 4);
+
+    for (size_t i = 0; i < cornerCount; ++i) {
+        Math::Vector3f position = positions[i] * unitScale;
+        WeldKey key;
+        if (quantize) {
+            key.x = static_cast<uint64_t>(std::llround(position.x * invTolerance));
+            key.y = static_cast<uint64_t>(std::llround(position.y * invTolerance));
+            key.z = static_cast<uint64_t>(std::llround(position.z * invTolerance));
+        } else {
+            key.x = floatKey(position.x);
+            key.y = floatKey(position.y);
+            key.z = floatKey(position.z);
+        }
+
+        size_t slot = hashKey(key) & mask;
+        while (slots[slot] != 0 && !(keys[slots[slot] - 1] == key)) {
+            slot = (slot + 1) & mask;
+        }
+
+        if (slots[slot] == 0) {
+            keys.push_back(key);
+            mesh.vertices.emplace_back(position);
+            normalSums.push_back(Math::Vector3f(0, 0, 0));
+            slots[slot] = static_cast<uint32_t>(keys.size());
+        }
+        mesh.indices[i] = slots[slot] - 1;
+    }
+
+    // Area-weighted vertex normals from the face windings
+    for (size_t i = 0; i < cornerCount; i += 3) {
+        uint32_t i0 = mesh.indices[i];
+        uint32_t i1 = mesh.indices[i + 1];
+        uint32_t i2 = mesh.indices[i + 2];
+        const Math::Vector3f& v0 = mesh.vertices[i0].position.value();
+        Math::Vector3f faceNormal = (mesh.vertices[i1].position.value() - v0)
+            .cross(mesh.vertices[i2].position.value() - v0);
+        normalSums[i0] += faceNormal;
+        normalSums[i1] += faceNormal;
+        normalSums[i2] += faceNormal;
+    }
+
+    for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+        float length = normalSums[v].length();
+        mesh.vertices[v].normal = length > 0.0f ? normalSums[v] / length : Math::Vector3f::UnitZ();
+    }
+}
+
+unsigned int STLImporter::resolveThreadCount(unsigned int requested, size_t workItems) const {
+    unsigned int numThreads = requested;
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0) numThreads = 4; // Default to 4 if detection fails
+    }
+    return static_cast<unsigned int>(std::max<size_t>(1, std::min<size_t>(numThreads, workItems)));
+}
+
+void STLImporter::setError(FileError error, const std::string& message) {
+    m_lastError = error;
+    m_lastErrorMessage = message;
+    LOG_ERROR("STLImporter: " + message);
+}
+
+void STLImporter::clearError() {
+    m_lastError = FileError::None;
+    m_lastErrorMessage.clear();
+}
+
+} // namespace FileIO
+} // namespace VoxelEditor
@@ -0,0 +1,334 @@
+#include "../include/file_io/STLStreamWriter.h"
+#include "../include/file_io/STLExporter.h"
+#include "logging/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <thread>
+
+#ifndef VOXEL_EDITOR_WINDOWS
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace VoxelEditor {
+namespace FileIO {
+
+namespace {
+
+// Below this many triangles a block is encoded on the calling thread
+constexpr size_t PARALLEL_THRESHOLD = 16384;
+
+inline void storeVector(uint8_t* dst, const Math::Vector3f& v) {
+    std::memcpy(dst, &v.x, sizeof(float));
+    std::memcpy(dst + 4, &v.y, sizeof(float));
+    std::memcpy(dst + 8, &v.z, sizeof(float));
+}
+
+} // anonymous namespace
+
+STLStreamWriter::STLStreamWriter() = default;
+
+STLStreamWriter::~STLStreamWriter() {
+    if (isOpen()) {
+        close();
+    }
+}
+
+bool STLStreamWriter::open(const std::string& filename, const STLExportOptions& options) {
+    clearError();
+    if (isOpen()) {
+        close();
+    }
+
+#ifdef VOXEL_EDITOR_WINDOWS
+    m_file = std::fopen(filename.c_str(), "wb");
+    if (!m_file) {
+        setError(FileError::AccessDenied, "Cannot open file for writing");
+        return false;
+    }
+#else
+    m_fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (m_fd < 0) {
+        setError(FileError::AccessDenied, "Cannot open file for writing");
+        return false;
+    }
+#endif
+
+    m_filename = filename;
+    m_triangleCount = 0;
+    m_bytesWritten = 0;
+
+    // Same order as STLExporter::preprocessMesh: scale, translate, then unit conversion
+    float unitScale = getUnitsPerMeter(options.units);
+    m_scale = options.scale * unitScale;
+    m_offset = options.translation * unitScale;
+
+    // Header with a zero count; the real count is patched in close()
+    uint8_t header[HEADER_SIZE];
+    std::memset(header, 0, HEADER_SIZE);
+    std::strcpy(reinterpret_cast<char*>(header), "Binary STL exported by VoxelEditor");
+    if (!writeBlock(header, HEADER_SIZE)) {
+        closeHandle();
+        return false;
+    }
+
+    return true;
+}
+
+bool STLStreamWriter::close() {
+    if (!isOpen()) {
+        return false;
+    }
+
+    bool success = m_lastError == FileError::None;
+    if (success) {
+        if (m_triangleCount > UINT32_MAX) {
+            setError(FileError::WriteError, "Triangle count exceeds binary STL limit");
+            success = false;
+        } else {
+            uint32_t count = static_cast<uint32_t>(m_triangleCount);
+            success = writeAt(80, reinterpret_cast<const uint8_t*>(&count), sizeof(uint32_t));
+        }
+    }
+
+    closeHandle();
+
+    // Release the staging buffer; a closed writer should not pin tens of MB
+    std::vector<uint8_t>().swap(m_recordBuffer);
+    return success;
+}
+
+bool STLStreamWriter::isOpen() const {
+#ifdef VOXEL_EDITOR_WINDOWS
+    return m_file != nullptr;
+#else
+    return m_fd >= 0;
+#endif
+}
+
+bool STLStreamWriter::writeTriangles(const std::vector<Rendering::Vertex>& vertices,
+                                    const std::vector<uint32_t>& indices) {
+    if (!indices.empty()) {
+        uint32_t maxIndex = *std::max_element(indices.begin(), indices.end());
+        if (maxIndex >= vertices.size()) {
+            setError(FileError::InvalidFormat, "Index out of bounds during export");
+            return false;
+        }
+    }
+
+    const Rendering::Vertex* v = vertices.data();
+    const uint32_t* idx = indices.data();
+    return writeBatch(indices.size() / 3, [v, idx](size_t t, Math::Vector3f& a,
+                                                   Math::Vector3f& b, Math::Vector3f& c) {
+        a = v[idx[t * 3]].position.value();
+        b = v[idx[t * 3 + 1]].position.value();
+        c = v[idx[t * 3 + 2]].position.value();
+    });
+}
+
+bool STLStreamWriter::writeTriangles(const std::vector<Math::WorldCoordinates>& vertices,
+                                    const std::vector<uint32_t>& indices) {
+    if (!indices.empty()) {
+        uint32_t maxIndex = *std::max_element(indices.begin(), indices.end());
+        if (maxIndex >= vertices.size()) {
+            setError(FileError::InvalidFormat, "Index out of bounds during export");
+            return false;
+        }
+    }
+
+    const Math::WorldCoordinates* v = vertices.data();
+    const uint32_t* idx = indices.data();
+    return writeBatch(indices.size() / 3, [v, idx](size_t t, Math::Vector3f& a,
+                                                   Math::Vector3f& b, Math::Vector3f& c) {
+        a = v[idx[t * 3]].value();
+        b = v[idx[t * 3 + 1]].value();
+        c = v[idx[t * 3 + 2]].value();
+    });
+}
+
+bool STLStreamWriter::writeTriangleSoup(const std::vector<Math::Vector3f>& positions) {
+    const Math::Vector3f* p = positions.data();
+    return writeBatch(positions.size() / 3, [p](size_t t, Math::Vector3f& a,
+                                                Math::Vector3f& b, Math::Vector3f& c) {
+        a = p[t * 3];
+        b = p[t * 3 + 1];
+        c = p[t * 3 + 2];
+    });
+}
+
+void STLStreamWriter::encodeTriangle(uint8_t* record, const Math::Vector3f& v0,
+                                    const Math::Vector3f& v1, const Math::Vector3f& v2) {
+    Math::Vector3f normal = (v1 - v0).cross(v2 - v0).normalized();
+    storeVector(record, normal);
+    storeVector(record + 12, v0);
+    storeVector(record + 24, v1);
+    storeVector(record + 36, v2);
+    record[48] = 0;
+    record[49] = 0;
+}
+
+template<typename PositionFn>
+bool STLStreamWriter::writeBatch(size_t triangleCount, PositionFn&& position) {
+    if (!isOpen()) {
+        setError(FileError::WriteError, "STL stream is not open");
+        return false;
+    }
+    if (triangleCount == 0) {
+        return true;
+    }
+
+    const float scale = m_scale;
+    const Math::Vector3f offset = m_offset;
+    auto encodeRange = [&position, scale, offset](uint8_t* records, size_t first, size_t last) {
+        Math::Vector3f v0, v1, v2;
+        for (size_t t = first; t < last; ++t) {
+            position(t, v0, v1, v2);
+            encodeTriangle(records, v0 * scale + offset, v1 * scale + offset, v2 * scale + offset);
+            records += RECORD_SIZE;
+        }
+    };
+
+    for (size_t blockStart = 0; blockStart < triangleCount; blockStart += m_blockTriangles) {
+        size_t blockEnd = std::min(triangleCount, blockStart + m_blockTriangles);
+        size_t blockSize = blockEnd - blockStart;
+        m_recordBuffer.resize(blockSize * RECORD_SIZE);
+        uint8_t* records = m_recordBuffer.data();
+
+        unsigned int numThreads = resolveThreadCount(blockSize);
+        if (numThreads <= 1) {
+            encodeRange(records, blockStart, blockEnd);
+        } else {
+            std::vector<std::future<void>> futures;
+            futures.reserve(numThreads);
+            size_t perThread = blockSize / numThreads;
+            size_t remainder = blockSize % numThreads;
+
+            for (unsigned int t = 0; t < numThreads; ++t) {
+                size_t first = t * perThread + std::min(static_cast<size_t>(t), remainder);
+                size_t last = first + perThread + (t < remainder ? 1 : 0);
+                futures.push_back(std::async(std::launch::async, [&, first, last]() {
+                    encodeRange(records + first * RECORD_SIZE, blockStart + first, blockStart + last);
+                }));
+            }
+
+            for (auto& future : futures) {
+                future.wait();
+            }
+        }
+
+        if (!writeBlock(records, m_recordBuffer.size())) {
+            return false;
+        }
+        m_triangleCount += blockSize;
+    }
+
+    return true;
+}
+
+bool STLStreamWriter::writeBlock(const uint8_t* data, size_t size) {
+#ifdef VOXEL_EDITOR_WINDOWS
+    if (std::fwrite(data, 1, size, m_file) != size) {
+        setError(FileError::WriteError, "Failed to write STL data");
+        return false;
+    }
+    m_bytesWritten += size;
+    return true;
+#else
+    // One write() per block; the loop only repeats on short writes
+    while (size > 0) {
+        ssize_t written = ::write(m_fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            setError(errno == ENOSPC ? FileError::DiskFull : FileError::WriteError,
+                     "Failed to write STL data");
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+        m_bytesWritten += static_cast<uint64_t>(written);
+    }
+    return true;
+#endif
+}
+
+bool STLStreamWriter::writeAt(uint64_t offset, const uint8_t* data, size_t size) {
+#ifdef VOXEL_EDITOR_WINDOWS
+    if (std::fseek(m_file, static_cast<long>(offset), SEEK_SET) != 0 ||
+        std::fwrite(data, 1, size, m_file) != size) {
+        setError(FileError::WriteError, "Failed to update STL header");
+        return false;
+    }
+    return true;
+#else
+    while (size > 0) {
+        ssize_t written = ::pwrite(m_fd, data, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            setError(FileError::WriteError, "Failed to update STL header");
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+    return true;
+#endif
+}
+
+void STLStreamWriter::closeHandle() {
+#ifdef VOXEL_EDITOR_WINDOWS
+    if (m_file) {
+        if (std::fclose(m_file) != 0 && m_lastError == FileError::None) {
+            setError(FileError::WriteError, "Failed to close STL file");
+        }
+        m_file = nullptr;
+    }
+#else
+    if (m_fd >= 0) {
+        if (::close(m_fd) != 0 && m_lastError == FileError::None) {
+            setError(FileError::WriteError, "Failed to close STL file");
+        }
+        m_fd = -1;
+    }
+#endif
+}
+
+unsigned int STLStreamWriter::resolveThreadCount(size_t triangleCount) const {
+    if (triangleCount < PARALLEL_THRESHOLD) {
+        return 1;
+    }
+
+    unsigned int numThreads = m_threadCount;
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0) numThreads = 4; // Default to 4 if detection fails
+    }
+
+    // Keep each chunk large enough to amortize the task launch
+    size_t maxUseful = std::max<size_t>(1, triangleCount / (PARALLEL_THRESHOLD / 4));
+    return static_cast<unsigned int>(std::min<size_t>(numThreads, maxUseful));
+}
+
+float STLStreamWriter::getUnitsPerMeter(STLUnits units) {
+    return 1000.0f / STLExporter::getUnitToMillimeters(units);
+}
+
+void STLStreamWriter::setError(FileError error, const std::string& message) {
+    m_lastError = error;
+    m_lastErrorMessage = message;
+    LOG_ERROR("STLStreamWriter: " + message);
+}
+
+void STLStreamWriter::clearError() {
+    m_lastError = FileError::None;
+    m_lastErrorMessage.clear();
+}
+
+} // namespace FileIO
+} // namespace VoxelEditor
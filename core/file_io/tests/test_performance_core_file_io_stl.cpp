@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include "file_io/STLExporter.h"
+#include "file_io/STLStreamWriter.h"
+#include "rendering/RenderTypes.h"
+
+using namespace VoxelEditor;
+using namespace VoxelEditor::FileIO;
+
+class STLPerformanceTest : public ::testing::Test {
+protected:
+    std::string m_testDir = "test_stl_performance";
+
+    void SetUp() override {
+        std::filesystem::create_directories(m_testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_testDir);
+    }
+
+    // Grid of quads in the XY plane; 2 * quadsPerSide^2 triangles
+    Rendering::Mesh createGridMesh(int quadsPerSide) {
+        Rendering::Mesh mesh;
+        int side = quadsPerSide + 1;
+        mesh.vertices.reserve(static_cast<size_t>(side) * side);
+        mesh.indices.reserve(static_cast<size_t>(quadsPerSide) * quadsPerSide * 6);
+        for (int y = 0; y < side; ++y) {
+            for (int x = 0; x < side; ++x) {
+                mesh.vertices.emplace_back(Math::Vector3f(x * 0.01f, y * 0.01f, 0.0f));
+            }
+        }
+        for (int y = 0; y < quadsPerSide; ++y) {
+            for (int x = 0; x < quadsPerSide; ++x) {
+                uint32_t i0 = y * side + x;
+                uint32_t i1 = i0 + 1;
+                uint32_t i2 = i0 + side + 1;
+                uint32_t i3 = i0 + side;
+                mesh.indices.insert(mesh.indices.end(), {i0, i1, i2, i2, i3, i0});
+            }
+        }
+        return mesh;
+    }
+
+    static double millisecondsSince(std::chrono::high_resolution_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+};
+
+// Binary export and import of a 1M+ triangle mesh
+TEST_F(STLPerformanceTest, BinaryRoundTripMillionTriangles) {
+    const int quadsPerSide = 724;  // 1,048,352 triangles
+    Rendering::Mesh mesh = createGridMesh(quadsPerSide);
+    const size_t triangleCount = mesh.getTriangleCount();
+    std::string filename = m_testDir + "/grid_binary.stl";
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    STLStreamWriter writer;
+    ASSERT_TRUE(writer.open(filename));
+    ASSERT_TRUE(writer.writeMesh(mesh));
+    ASSERT_TRUE(writer.close());
+    double exportMs = millisecondsSince(startTime);
+
+    EXPECT_EQ(std::filesystem::file_size(filename),
+              STLStreamWriter::HEADER_SIZE + triangleCount * STLStreamWriter::RECORD_SIZE);
+
+    STLImporter importer;
+    Rendering::Mesh imported;
+    startTime = std::chrono::high_resolution_clock::now();
+    ASSERT_TRUE(importer.importMesh(filename, imported));
+    double importMs = millisecondsSince(startTime);
+
+    EXPECT_EQ(imported.getTriangleCount(), triangleCount);
+    EXPECT_EQ(imported.getVertexCount(), mesh.getVertexCount());  // Fully welded
+
+    std::cout << "Binary STL, " << triangleCount << " triangles: export " << exportMs << " ms ("
+              << triangleCount / (exportMs / 1000.0) / 1e6 << " Mtri/s), import+weld " << importMs << " ms ("
+              << triangleCount / (importMs / 1000.0) / 1e6 << " Mtri/s)" << std::endl;
+
+    EXPECT_LT(exportMs, 5000.0);
+    EXPECT_LT(importMs, 5000.0);
+}
+
+// ASCII import of a 1M+ triangle file
+TEST_F(STLPerformanceTest, ASCIIImportMillionTriangles) {
+    const int quadsPerSide = 724;
+    std::string filename = m_testDir + "/grid_ascii.stl";
+    {
+        std::ofstream file(filename);
+        file << "solid grid\n";
+        for (int y = 0; y < quadsPerSide; ++y) {
+            for (int x = 0; x < quadsPerSide; ++x) {
+                int x1 = x + 1, y1 = y + 1;
+                file << "facet normal 0 0 1\nouter loop\n"
+                     << "vertex " << x << " " << y << " 0\nvertex " << x1 << " " << y << " 0\nvertex " << x1 << " " << y1 << " 0\n"
+                     << "endloop\nendfacet\n"
+                     << "facet normal 0 0 1\nouter loop\n"
+                     << "vertex " << x1 << " " << y1 << " 0\nvertex " << x << " " << y1 << " 0\nvertex " << x << " " << y << " 0\n"
+                     << "endloop\nendfacet\n";
+            }
+        }
+        file << "endsolid grid\n";
+    }
+
+    STLImporter importer;
+    Rendering::Mesh imported;
+    auto startTime = std::chrono::high_resolution_clock::now();
+    ASSERT_TRUE(importer.importMesh(filename, imported));
+    double importMs = millisecondsSince(startTime);
+
+    const size_t triangleCount = static_cast<size_t>(quadsPerSide) * quadsPerSide * 2;
+    EXPECT_EQ(imported.getTriangleCount(), triangleCount);
+    EXPECT_EQ(imported.getVertexCount(), static_cast<size_t>(quadsPerSide + 1) * (quadsPerSide + 1));
+
+    std::cout << "ASCII STL, " << triangleCount << " triangles ("
+              << std::filesystem::file_size(filename) / (1024 * 1024) << " MB): import+weld " << importMs << " ms ("
+              << triangleCount / (importMs / 1000.0) / 1e6 << " Mtri/s)" << std::endl;
+
+    EXPECT_LT(importMs, 10000.0);
+}
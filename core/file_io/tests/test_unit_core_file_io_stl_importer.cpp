@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include "file_io/STLExporter.h"
+#include "file_io/STLStreamWriter.h"
+#include "rendering/RenderTypes.h"
+
+namespace VoxelEditor {
+namespace FileIO {
+
+class STLImporterTest : public ::testing::Test {
+protected:
+    std::unique_ptr<STLImporter> m_importer;
+    std::string m_testDir = "test_stl_import";
+
+    void SetUp() override {
+        m_importer = std::make_unique<STLImporter>();
+        std::filesystem::create_directories(m_testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_testDir);
+    }
+
+    Rendering::Mesh createCubeMesh() {
+        Rendering::Mesh mesh;
+        mesh.vertices = {
+            Rendering::Vertex{Math::Vector3f(0, 0, 0)}, Rendering::Vertex{Math::Vector3f(1, 0, 0)},
+            Rendering::Vertex{Math::Vector3f(1, 1, 0)}, Rendering::Vertex{Math::Vector3f(0, 1, 0)},
+            Rendering::Vertex{Math::Vector3f(0, 0, 1)}, Rendering::Vertex{Math::Vector3f(1, 0, 1)},
+            Rendering::Vertex{Math::Vector3f(1, 1, 1)}, Rendering::Vertex{Math::Vector3f(0, 1, 1)}
+        };
+        mesh.indices = {
+            0, 2, 1,  2, 0, 3,   // Front (-Z)
+            4, 5, 6,  6, 7, 4,   // Back (+Z)
+            0, 7, 3,  7, 0, 4,   // Left (-X)
+            1, 2, 6,  6, 5, 1,   // Right (+X)
+            3, 7, 6,  6, 2, 3,   // Top (+Y)
+            0, 1, 5,  5, 4, 0    // Bottom (-Y)
+        };
+        return mesh;
+    }
+
+    void writeText(const std::string& filename, const std::string& text) {
+        std::ofstream file(filename);
+        file << text;
+    }
+
+    // ASCII grid of quads in the XY plane written without the exporter
+    void writeASCIIGrid(const std::string& filename, int quadsPerSide) {
+        std::ofstream file(filename);
+        file << "solid grid\n";
+        for (int y = 0; y < quadsPerSide; ++y) {
+            for (int x = 0; x < quadsPerSide; ++x) {
+                float x0 = x * 1.0f, x1 = (x + 1) * 1.0f;
+                float y0 = y * 1.0f, y1 = (y + 1) * 1.0f;
+                float tris[2][9] = {
+                    {x0, y0, 0, x1, y0, 0, x1, y1, 0},
+                    {x1, y1, 0, x0, y1, 0, x0, y0, 0}
+                };
+                for (const auto& tri : tris) {
+                    file << "  facet normal 0 0 1\n    outer loop\n";
+                    for (int v = 0; v < 3; ++v) {
+                        file << "      vertex " << tri[v * 3] << " " << tri[v * 3 + 1] << " " << tri[v * 3 + 2] << "\n";
+                    }
+                    file << "    endloop\n  endfacet\n";
+                }
+            }
+        }
+        file << "endsolid grid\n";
+    }
+};
+
+TEST_F(STLImporterTest, ImportBinaryWeldsVertices) {
+    // REQ-8.2.1: System shall export STL files for 3D printing and sharing
+    STLExporter exporter;
+    STLExportOptions exportOptions = STLExportOptions::Default();  // Millimeters
+    std::string filename = m_testDir + "/cube.stl";
+    ASSERT_TRUE(exporter.exportMesh(filename, createCubeMesh(), exportOptions));
+
+    Rendering::Mesh mesh;
+    ASSERT_TRUE(m_importer->importMesh(filename, mesh));
+
+    EXPECT_EQ(mesh.getTriangleCount(), 12u);
+    EXPECT_EQ(mesh.getVertexCount(), 8u);
+
+    STLImportStats stats = m_importer->getLastImportStats();
+    EXPECT_TRUE(stats.binary);
+    EXPECT_EQ(stats.triangleCount, 12u);
+    EXPECT_EQ(stats.sourceVertexCount, 36u);
+    EXPECT_EQ(stats.vertexCount, 8u);
+
+    // Millimeters in the file are converted back to meters
+    for (const auto& vertex : mesh.vertices) {
+        EXPECT_NEAR(vertex.position.x(), std::round(vertex.position.x()), 1e-5f);
+        EXPECT_LE(vertex.position.x(), 1.0f + 1e-5f);
+    }
+
+    // Welded cube corner normals point away from the center
+    for (const auto& vertex : mesh.vertices) {
+        Math::Vector3f outward = vertex.position.value() - Math::Vector3f(0.5f, 0.5f, 0.5f);
+        EXPECT_GT(vertex.normal.dot(outward), 0.0f);
+    }
+}
+
+TEST_F(STLImporterTest, ImportBinaryUnwelded) {
+    STLExporter exporter;
+    std::string filename = m_testDir + "/cube_raw.stl";
+    ASSERT_TRUE(exporter.exportMesh(filename, createCubeMesh()));
+
+    Rendering::Mesh mesh;
+    ASSERT_TRUE(m_importer->importMesh(filename, mesh, STLImportOptions::Unwelded()));
+
+    EXPECT_EQ(mesh.getTriangleCount(), 12u);
+    EXPECT_EQ(mesh.getVertexCount(), 36u);
+}
+
+TEST_F(STLImporterTest, ImportASCIIFromExporter) {
+    STLExporter exporter;
+    STLExportOptions exportOptions = STLExportOptions::CAD();  // ASCII, meters
+    exportOptions.validateWatertight = false;
+    std::string filename = m_testDir + "/cube_ascii.stl";
+    ASSERT_TRUE(exporter.exportMesh(filename, createCubeMesh(), exportOptions));
+
+    EXPECT_FALSE(m_importer->isBinarySTL(filename));
+
+    STLImportOptions options;
+    options.units = STLUnits::Meters;
+    Rendering::Mesh mesh;
+    ASSERT_TRUE(m_importer->importMesh(filename, mesh, options));
+
+    EXPECT_EQ(mesh.getTriangleCount(), 12u);
+    EXPECT_EQ(mesh.getVertexCount(), 8u);
+    EXPECT_FALSE(m_importer->getLastImportStats().binary);
+}
+
+TEST_F(STLImporterTest, ParallelASCIIMatchesSerial) {
+    // ~6MB of text, above the parallel parsing threshold
+    std::string filename = m_testDir + "/grid.stl";
+    writeASCIIGrid(filename, 90);
+
+    STLImportOptions serialOptions;
+    serialOptions.units = STLUnits::Meters;
+    serialOptions.threadCount = 1;
+    Rendering::Mesh serial;
+    ASSERT_TRUE(m_importer->importMesh(filename, serial, serialOptions));
+
+    STLImportOptions parallelOptions = serialOptions;
+    parallelOptions.threadCount = 4;
+    Rendering::Mesh parallel;
+    ASSERT_TRUE(m_importer->importMesh(filename, parallel, parallelOptions));
+
+    EXPECT_EQ(serial.getTriangleCount(), 90u * 90u * 2u);
+    EXPECT_EQ(serial.getVertexCount(), 91u * 91u);
+    ASSERT_EQ(serial.indices, parallel.indices);
+    ASSERT_EQ(serial.vertices.size(), parallel.vertices.size());
+    for (size_t i = 0; i < serial.vertices.size(); ++i) {
+        EXPECT_EQ(serial.vertices[i].position, parallel.vertices[i].position);
+    }
+}
+
+TEST_F(STLImporterTest, BinaryHeaderStartingWithSolid) {
+    std::string filename = m_testDir + "/solid_header.stl";
+    std::vector<Math::Vector3f> soup = {
+        Math::Vector3f(0, 0, 0), Math::Vector3f(1, 0, 0), Math::Vector3f(0, 1, 0)
+    };
+    STLStreamWriter writer;
+    ASSERT_TRUE(writer.open(filename));
+    ASSERT_TRUE(writer.writeTriangleSoup(soup));
+    ASSERT_TRUE(writer.close());
+
+    // Overwrite the header text the way some exporters do
+    {
+        std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+        file.write("solid binary", 12);
+    }
+
+    EXPECT_TRUE(m_importer->isBinarySTL(filename));
+    Rendering::Mesh mesh;
+    ASSERT_TRUE(m_importer->importMesh(filename, mesh));
+    EXPECT_EQ(mesh.getTriangleCount(), 1u);
+}
+
+TEST_F(STLImporterTest, WeldTolerance) {
+    std::string filename = m_testDir + "/near.stl";
+    writeText(filename,
+        "solid near\n"
+        "facet normal 0 0 1\nouter loop\n"
+        "vertex 0 0 0\nvertex 1 0 0\nvertex 0 1 0\n"
+        "endloop\nendfacet\n"
+        "facet normal 0 0 1\nouter loop\n"
+        "vertex 1.0000001 0 0\nvertex 1 1 0\nvertex +0.0000001 1 0\n"
+        "endloop\nendfacet\n"
+        "endsolid near\n");
+
+    STLImportOptions exact;
+    exact.units = STLUnits::Meters;
+    Rendering::Mesh exactMesh;
+    ASSERT_TRUE(m_importer->importMesh(filename, exactMesh, exact));
+    EXPECT_EQ(exactMesh.getVertexCount(), 6u);
+
+    STLImportOptions tolerant = exact;
+    tolerant.weldTolerance = 1e-4f;
+    Rendering::Mesh tolerantMesh;
+    ASSERT_TRUE(m_importer->importMesh(filename, tolerantMesh, tolerant));
+    EXPECT_EQ(tolerantMesh.getVertexCount(), 4u);
+}
+
+TEST_F(STLImporterTest, TruncatedBinaryFails) {
+    std::string filename = m_testDir + "/truncated.stl";
+    {
+        std::ofstream file(filename, std::ios::binary);
+        char header[80] = {};
+        uint32_t count = 10;
+        file.write(header, 80);
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        char record[50] = {};
+        file.write(record, 50);
+    }
+
+    Rendering::Mesh mesh;
+    EXPECT_FALSE(m_importer->importMesh(filename, mesh));
+    EXPECT_EQ(m_importer->getLastError(), FileError::CorruptedData);
+}
+
+TEST_F(STLImporterTest, MalformedASCIIFails) {
+    std::string filename = m_testDir + "/malformed.stl";
+    writeText(filename,
+        "solid bad\nfacet normal 0 0 1\nouter loop\n"
+        "vertex 0 0 zero\nvertex 1 0 0\nvertex 0 1 0\n"
+        "endloop\nendfacet\nendsolid bad\n");
+
+    Rendering::Mesh mesh;
+    EXPECT_FALSE(m_importer->importMesh(filename, mesh));
+    EXPECT_EQ(m_importer->getLastError(), FileError::CorruptedData);
+}
+
+TEST_F(STLImporterTest, ASCIIHeaderIsParsedNotDropped) {
+    // Everything on one line: the first facet shares the header line
+    std::string oneLine = m_testDir + "/one_line.stl";
+    writeText(oneLine,
+        "solid part facet normal 0 0 1 outer loop vertex 0 0 0 vertex 1 0 0 vertex 0 1 0 "
+        "endloop endfacet facet normal 0 0 1 outer loop vertex 1 0 0 vertex 1 1 0 vertex 0 1 0 "
+        "endloop endfacet endsolid part");
+
+    Rendering::Mesh mesh;
+    ASSERT_TRUE(m_importer->importMesh(oneLine, mesh));
+    EXPECT_EQ(mesh.getTriangleCount(), 2u);
+
+    // A name made of keywords is still only a name
+    std::string keywordName = m_testDir + "/keyword_name.stl";
+    writeText(keywordName,
+        "solid vertex 9 9\nfacet normal 0 0 1\nouter loop\n"
+        "vertex 0 0 0\nvertex 1 0 0\nvertex 0 1 0\n"
+        "endloop\nendfacet\nendsolid\n");
+
+    ASSERT_TRUE(m_importer->importMesh(keywordName, mesh));
+    EXPECT_EQ(mesh.getTriangleCount(), 1u);
+}
+
+TEST_F(STLImporterTest, MissingFileFails) {
+    Rendering::Mesh mesh;
+    EXPECT_FALSE(m_importer->importMesh(m_testDir + "/missing.stl", mesh));
+    EXPECT_EQ(m_importer->getLastError(), FileError::FileNotFound);
+}
+
+} // namespace FileIO
+} // namespace VoxelEditor
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include "file_io/STLStreamWriter.h"
+#include "file_io/STLExporter.h"
+#include "rendering/RenderTypes.h"
+
+namespace VoxelEditor {
+namespace FileIO {
+
+class STLStreamWriterTest : public ::testing::Test {
+protected:
+    std::string m_testDir = "test_stl_stream_output";
+
+    void SetUp() override {
+        std::filesystem::create_directories(m_testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_testDir);
+    }
+
+    // Grid of quads in the XY plane, two triangles each
+    Rendering::Mesh createGridMesh(int quadsPerSide) {
+        Rendering::Mesh mesh;
+        int side = quadsPerSide + 1;
+        for (int y = 0; y < side; ++y) {
+            for (int x = 0; x < side; ++x) {
+                mesh.vertices.push_back(Rendering::Vertex{
+                    Math::Vector3f(x * 0.01f, y * 0.01f, 0.0f), Math::Vector3f(0, 0, 1), Math::Vector2f(0, 0)});
+            }
+        }
+        for (int y = 0; y < quadsPerSide; ++y) {
+            for (int x = 0; x < quadsPerSide; ++x) {
+                uint32_t i0 = y * side + x;
+                uint32_t i1 = i0 + 1;
+                uint32_t i2 = i0 + side + 1;
+                uint32_t i3 = i0 + side;
+                mesh.indices.insert(mesh.indices.end(), {i0, i1, i2, i2, i3, i0});
+            }
+        }
+        return mesh;
+    }
+
+    std::vector<uint8_t> readFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    uint32_t readTriangleCount(const std::vector<uint8_t>& data) {
+        uint32_t count = 0;
+        std::memcpy(&count, data.data() + 80, sizeof(uint32_t));
+        return count;
+    }
+
+    Math::Vector3f readVector(const std::vector<uint8_t>& data, size_t offset) {
+        Math::Vector3f v;
+        std::memcpy(&v.x, data.data() + offset, sizeof(float));
+        std::memcpy(&v.y, data.data() + offset + 4, sizeof(float));
+        std::memcpy(&v.z, data.data() + offset + 8, sizeof(float));
+        return v;
+    }
+};
+
+TEST_F(STLStreamWriterTest, EncodeTriangleRecord) {
+    uint8_t record[STLStreamWriter::RECORD_SIZE];
+    std::memset(record, 0xFF, sizeof(record));
+
+    STLStreamWriter::encodeTriangle(record, Math::Vector3f(0, 0, 0), Math::Vector3f(1, 0, 0), Math::Vector3f(0, 1, 0));
+
+    std::vector<uint8_t> data(record, record + sizeof(record));
+    Math::Vector3f normal = readVector(data, 0);
+    EXPECT_FLOAT_EQ(normal.z, 1.0f);
+    EXPECT_FLOAT_EQ(readVector(data, 24).x, 1.0f);
+    EXPECT_FLOAT_EQ(readVector(data, 36).y, 1.0f);
+    EXPECT_EQ(record[48], 0);
+    EXPECT_EQ(record[49], 0);
+}
+
+TEST_F(STLStreamWriterTest, StreamedBatchesPatchHeaderCount) {
+    // REQ-8.2.1: System shall export STL files for 3D printing and sharing
+    Rendering::Mesh mesh = createGridMesh(4);  // 32 triangles
+    std::string filename = m_testDir + "/batches.stl";
+
+    STLStreamWriter writer;
+    ASSERT_TRUE(writer.open(filename));
+    EXPECT_TRUE(writer.writeMesh(mesh));
+    EXPECT_TRUE(writer.writeMesh(mesh));
+    EXPECT_TRUE(writer.writeMesh(mesh));
+    EXPECT_EQ(writer.getTriangleCount(), 96u);
+    ASSERT_TRUE(writer.close());
+    EXPECT_FALSE(writer.isOpen());
+
+    std::vector<uint8_t> data = readFile(filename);
+    EXPECT_EQ(data.size(), STLStreamWriter::HEADER_SIZE + 96 * STLStreamWriter::RECORD_SIZE);
+    EXPECT_EQ(readTriangleCount(data), 96u);
+}
+
+TEST_F(STLStreamWriterTest, ParallelOutputMatchesSerial) {
+    Rendering::Mesh mesh = createGridMesh(128);  // 32768 triangles, above the parallel threshold
+
+    STLStreamWriter serial;
+    serial.setThreadCount(1);
+    ASSERT_TRUE(serial.open(m_testDir + "/serial.stl"));
+    ASSERT_TRUE(serial.writeMesh(mesh));
+    ASSERT_TRUE(serial.close());
+
+    STLStreamWriter parallel;
+    parallel.setThreadCount(4);
+    parallel.setBlockTriangles(20000);  // Force a partial second block
+    ASSERT_TRUE(parallel.open(m_testDir + "/parallel.stl"));
+    ASSERT_TRUE(parallel.writeMesh(mesh));
+    ASSERT_TRUE(parallel.close());
+
+    EXPECT_EQ(readFile(m_testDir + "/serial.stl"), readFile(m_testDir + "/parallel.stl"));
+}
+
+TEST_F(STLStreamWriterTest, MatchesExporterOutput) {
+    Rendering::Mesh mesh = createGridMesh(8);
+    STLExportOptions options = STLExportOptions::Default();
+    options.validateWatertight = false;
+    options.scale = 2.0f;
+    options.translation = Math::Vector3f(1.0f, 0.0f, -1.0f);
+    options.units = STLUnits::Centimeters;
+
+    STLExporter exporter;
+    ASSERT_TRUE(exporter.exportMesh(m_testDir + "/exporter.stl", mesh, options));
+
+    STLStreamWriter writer;
+    ASSERT_TRUE(writer.open(m_testDir + "/stream.stl", options));
+    ASSERT_TRUE(writer.writeMesh(mesh));
+    ASSERT_TRUE(writer.close());
+
+    EXPECT_EQ(readFile(m_testDir + "/exporter.stl"), readFile(m_testDir + "/stream.stl"));
+}
+
+TEST_F(STLStreamWriterTest, AppliesScaleTranslationAndUnits) {
+    STLExportOptions options = STLExportOptions::Default();
+    options.scale = 2.0f;
+    options.translation = Math::Vector3f(1.0f, 0.0f, 0.0f);
+    options.units = STLUnits::Millimeters;
+
+    std::vector<Math::Vector3f> soup = {
+        Math::Vector3f(0, 0, 0), Math::Vector3f(1, 0, 0), Math::Vector3f(0, 1, 0)
+    };
+
+    STLStreamWriter writer;
+    ASSERT_TRUE(writer.open(m_testDir + "/transform.stl", options));
+    ASSERT_TRUE(writer.writeTriangleSoup(soup));
+    ASSERT_TRUE(writer.close());
+
+    std::vector<uint8_t> data = readFile(m_testDir + "/transform.stl");
+    ASSERT_EQ(data.size(), STLStreamWriter::HEADER_SIZE + STLStreamWriter::RECORD_SIZE);
+
+    // (p * 2 + (1,0,0)) meters -> millimeters
+    Math::Vector3f v0 = readVector(data, STLStreamWriter::HEADER_SIZE + 12);
+    Math::Vector3f v1 = readVector(data, STLStreamWriter::HEADER_SIZE + 24);
+    EXPECT_FLOAT_EQ(v0.x, 1000.0f);
+    EXPECT_FLOAT_EQ(v1.x, 3000.0f);
+}
+
+TEST_F(STLStreamWriterTest, WorldCoordinateBatches) {
+    std::vector<Math::WorldCoordinates> vertices = {
+        Math::WorldCoordinates(0, 0, 0), Math::WorldCoordinates(1, 0, 0),
+        Math::WorldCoordinates(1, 1, 0), Math::WorldCoordinates(0, 1, 0)
+    };
+    std::vector<uint32_t> indices = {0, 1, 2, 2, 3, 0};
+
+    STLStreamWriter writer;
+    ASSERT_TRUE(writer.open(m_testDir + "/world.stl"));
+    EXPECT_TRUE(writer.writeTriangles(vertices, indices));
+    ASSERT_TRUE(writer.close());
+
+    EXPECT_EQ(readTriangleCount(readFile(m_testDir + "/world.stl")), 2u);
+}
+
+TEST_F(STLStreamWriterTest, RejectsOutOfBoundsIndices) {
+    Rendering::Mesh mesh = createGridMesh(1);
+    mesh.indices.push_back(0);
+    mesh.indices.push_back(1);
+    mesh.indices.push_back(99);
+
+    STLStreamWriter writer;
+    ASSERT_TRUE(writer.open(m_testDir + "/invalid.stl"));
+    EXPECT_FALSE(writer.writeMesh(mesh));
+    EXPECT_EQ(writer.getLastError(), FileError::InvalidFormat);
+    EXPECT_EQ(writer.getTriangleCount(), 0u);
+    EXPECT_FALSE(writer.close());
+}
+
+TEST_F(STLStreamWriterTest, WriteWithoutOpenFails) {
+    STLStreamWriter writer;
+    EXPECT_FALSE(writer.writeMesh(createGridMesh(1)));
+    EXPECT_EQ(writer.getLastError(), FileError::WriteError);
+    EXPECT_FALSE(writer.close());
+}
+
+TEST_F(STLStreamWriterTest, OpenInvalidPathFails) {
+    STLStreamWriter writer;
+    EXPECT_FALSE(writer.open("/invalid/path/that/does/not/exist/test.stl"));
+    EXPECT_EQ(writer.getLastError(), FileError::AccessDenied);
+    EXPECT_FALSE(writer.isOpen());
+}
+
+} // namespace FileIO
+} // namespace VoxelEditor
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "GroupTypes.h"
+#include "GroupHierarchy.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <functional>
+#include <mutex>
+
+namespace VoxelEditor {
+namespace Groups {
+
+class VoxelGroup;
+
+// Totals for a group and everything below it in the hierarchy
+struct GroupAggregate {
+    size_t groupCount = 0;
+    size_t voxelCount = 0;
+    // Voxels of groups that are themselves visible
+    size_t visibleVoxelCount = 0;
+    Math::BoundingBox bounds;
+    // Bounds of the visible groups only; invalid when none is visible
+    Math::BoundingBox visibleBounds;
+};
+
+// Cached aggregates over GroupHierarchy. Groups report changes through
+// markDirty, which only records the id; update() refreshes each dirty group
+// once and then re-aggregates the touched nodes deepest first, so a burst
+// of edits costs one pass over the paths to the root. Root groups hang
+// under a node for INVALID_GROUP_ID whose aggregate covers every group.
+class GroupAggregateTree {
+public:
+    using GroupLookup = std::function<const VoxelGroup*(GroupId)>;
+
+    GroupAggregateTree();
+
+    // Safe to call from any thread, including with a group's mutex held
+    void markDirty(GroupId id);
+    // Drops the node; its parent is re-aggregated on the next update
+    void removeGroup(GroupId id);
+    void clear();
+
+    // Brings the tree up to date; lookup returns null for deleted groups
+    void update(const GroupHierarchy& hierarchy, const GroupLookup& lookup);
+    bool needsUpdate() const;
+
+    // As of the last update; null if the group is unknown
+    const GroupAggregate* find(GroupId id) const;
+    const GroupAggregate& getTotal() const { return m_nodes.at(INVALID_GROUP_ID).aggregate; }
+
+private:
+    struct Node {
+        GroupId parent = INVALID_GROUP_ID;
+        std::vector<GroupId> children;
+        size_t voxelCount = 0;
+        Math::BoundingBox bounds;
+        bool visible = true;
+        GroupAggregate aggregate;
+    };
+
+    std::unordered_map<GroupId, Node> m_nodes;
+    // Nodes whose aggregate must be rebuilt, with their ancestors
+    std::unordered_set<GroupId> m_stale;
+
+    mutable std::mutex m_dirtyMutex;
+    std::unordered_set<GroupId> m_dirty;
+
+    void link(GroupId id, GroupId parent);
+    void unlink(GroupId id);
+    void aggregate(GroupId id);
+    int depth(GroupId id) const;
+};
+
+} // namespace Groups
+} // namespace VoxelEditor
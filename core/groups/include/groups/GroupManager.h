@@ -3,6 +3,8 @@
 #include "GroupTypes.h"
 #include "VoxelGroup.h"
 #include "GroupHierarchy.h"
+#include "GroupMembershipIndex.h"
+#include "GroupAggregateTree.h"
 #include "GroupOperations.h"
 #include "GroupEvents.h"
 #include "../../voxel_data/VoxelDataManager.h"
@@ -75,6 +77,9 @@ public:
     std::vector<GroupId> splitGroup(GroupId sourceId, 
                                    const std::vector<std::vector<VoxelId>>& voxelSets,
                                    const std::vector<std::string>& newNames);
+    // Splits every face-connected island except the largest into its own
+    // group; returns the new groups, empty if the group is one piece
+    std::vector<GroupId> splitGroupIntoIslands(GroupId sourceId);
     
     // Hierarchy management
     bool setParentGroup(GroupId child, GroupId parent);
@@ -101,6 +106,11 @@ public:
     size_t getGroupCount() const;
     Math::BoundingBox getGroupsBounds() const;
     Math::BoundingBox getGroupBounds(GroupId id) const;
+    // Bounds of the visible groups, for culling
+    Math::BoundingBox getVisibleGroupsBounds() const;
+    // Totals over a group and all of its descendants
+    GroupAggregate getHierarchyAggregate(GroupId id) const;
+    Math::BoundingBox getHierarchyBounds(GroupId id) const;
     
     // Validation and cleanup
     bool validateGroups() const;
@@ -124,11 +134,14 @@ public:
     
     // Internal method for group operations
     void updateVoxelGroupMembership(const VoxelId& voxel, GroupId oldGroup, GroupId newGroup);
+    // Replaces a group's voxels and its entries in the membership index
+    bool setGroupVoxels(GroupId id, const std::vector<VoxelId>& voxels);
     
 private:
     std::unordered_map<GroupId, std::unique_ptr<VoxelGroup>> m_groups;
     std::unique_ptr<GroupHierarchy> m_hierarchy;
-    std::unordered_map<VoxelId, std::vector<GroupId>> m_voxelToGroups; // for fast lookup
+    GroupMembershipIndex m_membership; // voxel -> groups, per brick
+    mutable GroupAggregateTree m_aggregates; // subtree totals, refreshed on query
     
     GroupId m_nextGroupId = 1;
     VoxelData::VoxelDataManager* m_voxelManager;
@@ -140,8 +153,8 @@ private:
     GroupId generateGroupId();
     std::string generateUniqueGroupName(const std::string& baseName) const;
     Rendering::Color assignGroupColor() const;
-    void updateVoxelMapping(GroupId groupId, const VoxelId& voxel, bool add);
-    void removeFromVoxelMapping(GroupId groupId);
+    void trackGroup(VoxelGroup& group);
+    const GroupAggregateTree& aggregates() const;
     
     // Internal methods without locking
     bool deleteGroupInternal(GroupId id);
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "VoxelBrickSet.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace VoxelEditor {
+namespace Groups {
+
+// Reverse lookup from voxel to the groups that hold it. Each brick keeps a
+// small palette of the groups present in it, with one cell set per group,
+// so a lookup is one hash probe plus a bit test per palette entry and a
+// solid group costs bits per voxel instead of a map node and a vector.
+// The bricks each group appears in are tracked too, so dropping a group
+// visits only its own bricks.
+class GroupMembershipIndex {
+public:
+    struct PaletteEntry {
+        GroupId group;
+        BrickCells cells;
+    };
+    using Palette = std::vector<PaletteEntry>;
+
+    // Add and remove return whether the index changed
+    bool add(GroupId group, const VoxelId& voxel);
+    bool remove(GroupId group, const VoxelId& voxel);
+    // Adds every voxel of the set, a brick at a time
+    void addGroup(GroupId group, const VoxelBrickSet& voxels);
+    // Drops the group from every brick it is in
+    void removeGroup(GroupId group);
+    void clear();
+
+    bool contains(GroupId group, const VoxelId& voxel) const;
+    std::vector<GroupId> findGroups(const VoxelId& voxel) const;
+    // First group holding the voxel, or INVALID_GROUP_ID
+    GroupId findFirstGroup(const VoxelId& voxel) const;
+
+    // Number of (voxel, group) pairs
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    size_t getBrickCount() const { return m_bricks.size(); }
+    // Heap bytes held by the index
+    size_t getMemoryUsage() const;
+
+    // Calls visitor(voxel, group) for every pair
+    template<typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        for (const auto& [key, palette] : m_bricks) {
+            for (const auto& entry : palette) {
+                entry.cells.forEach([&](uint16_t cell) {
+                    visitor(VoxelBrickSet::voxelAt(key, cell), entry.group);
+                });
+            }
+        }
+    }
+
+private:
+    std::unordered_map<uint64_t, Palette> m_bricks;
+    std::unordered_map<GroupId, std::unordered_set<uint64_t>> m_groupBricks;
+    size_t m_size = 0;
+};
+
+} // namespace Groups
+} // namespace VoxelEditor
@@ -5,6 +5,7 @@
 #include "../../foundation/math/Vector3f.h"
 #include "../../foundation/math/CoordinateTypes.h"
 #include "../../foundation/math/BoundingBox.h"
+#include <array>
 #include <vector>
 #include <memory>
 #include <unordered_set>
@@ -42,7 +43,8 @@ private:
     VoxelData::VoxelDataManager* m_voxelManager;
     GroupId m_groupId;
     Math::WorldCoordinates m_offset;
-    std::vector<std::pair<VoxelId, VoxelId>> m_voxelMoves; // old -> new positions
+    std::vector<VoxelId> m_oldVoxels;
+    std::vector<VoxelId> m_newVoxels;
     bool m_executed = false;
 };
 
@@ -68,6 +70,7 @@ private:
     std::string m_newName;
     Math::WorldCoordinates m_offset;
     std::vector<VoxelId> m_createdVoxels;
+    std::vector<VoxelId> m_placedVoxels; // created voxels that were free to place
     bool m_executed = false;
 };
 
@@ -89,7 +92,8 @@ private:
     GroupId m_groupId;
     Math::Vector3f m_eulerAngles;
     Math::WorldCoordinates m_pivot;
-    std::vector<std::pair<VoxelId, VoxelId>> m_voxelMoves;
+    std::vector<VoxelId> m_oldVoxels;
+    std::vector<VoxelId> m_newVoxels;
     bool m_executed = false;
 };
 
@@ -110,7 +114,8 @@ private:
     GroupId m_groupId;
     float m_scaleFactor;
     Math::WorldCoordinates m_pivot;
-    std::vector<std::pair<VoxelId, VoxelId>> m_voxelMoves;
+    std::vector<VoxelId> m_oldVoxels;
+    std::vector<VoxelId> m_newVoxels;
     bool m_executed = false;
 };
 
@@ -165,6 +170,28 @@ namespace GroupOperationUtils {
     // Calculate new voxel position after transformation
     VoxelId transformVoxel(const VoxelId& voxel, const GroupTransform& transform);
     
+    // Exact transform on the 1cm increment lattice: a rotation by multiples
+    // of 90 degrees about an integer pivot, then an integer translation
+    struct LatticeTransform {
+        std::array<int, 9> rotation = {1, 0, 0, 0, 1, 0, 0, 0, 1}; // Row-major
+        bool rotates = false;
+        Math::Vector3i pivot = Math::Vector3i::Zero();
+        Math::Vector3i translation = Math::Vector3i::Zero();
+    };
+    
+    // Expresses "rotate by eulerAngles about pivot, then move by offset" on
+    // the lattice, with the same Z, Y, X rotation order as
+    // RotateGroupOperation. Returns false if the transform does not map
+    // increments onto increments; callers then convert voxel by voxel.
+    bool makeLatticeTransform(const Math::WorldCoordinates& offset, const Math::Vector3f& eulerAngles,
+                              const Math::WorldCoordinates& pivot, LatticeTransform& transform);
+    
+    // Transforms all voxels in one vectorized pass
+    std::vector<VoxelId> transformVoxels(const std::vector<VoxelId>& voxels, const LatticeTransform& transform);
+    
+    // Voxel lists in the form VoxelDataManager::replaceVoxels takes
+    std::vector<VoxelData::VoxelPosition> toVoxelPositions(const std::vector<VoxelId>& voxels);
+    
     // Calculate bounding box for a set of voxels
     Math::BoundingBox calculateBounds(const std::vector<VoxelId>& voxels);
     
@@ -39,14 +39,10 @@ struct VoxelId {
     }
     
     size_t hash() const {
-        const Math::Vector3i& pos = position.value();
-        size_t h1 = std::hash<int>{}(pos.x);
-        size_t h2 = std::hash<int>{}(pos.y);
-        size_t h3 = std::hash<int>{}(pos.z);
-        size_t h4 = std::hash<int>{}(static_cast<int>(resolution));
+        size_t h = position.value().hash();
         
         // Combine hashes
-        return h1 ^ (h2 << 1) ^ (h3 << 2) ^ (h4 << 3);
+        return h ^ (static_cast<size_t>(resolution) * 0x9E3779B9u + (h << 6) + (h >> 2));
     }
     
     // Convert to world position 
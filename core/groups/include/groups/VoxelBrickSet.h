@@ -0,0 +1,94 @@
+#pragma once
+
+#include "GroupTypes.h"
+#include "voxel_math/BrickCells.h"
+#include <unordered_map>
+#include <vector>
+#include <iterator>
+#include <cstdint>
+
+namespace VoxelEditor {
+namespace Groups {
+
+// Brick cell container shared with selections
+using BrickCells = Math::BrickCells;
+
+// Voxel ids of one group, stored as bricks of cells per resolution instead
+// of one hash node per voxel. Large solid groups drop to a fraction of a
+// byte per voxel, and iteration walks bricks in memory order.
+class VoxelBrickSet {
+public:
+    using BrickMap = std::unordered_map<uint64_t, BrickCells>;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = VoxelId;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const VoxelId*;
+        using reference = const VoxelId&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return m_current; }
+        pointer operator->() const { return &m_current; }
+        const_iterator& operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator& other) const {
+            return m_it == other.m_it && (m_it == m_end || m_cell == other.m_cell);
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class VoxelBrickSet;
+        const_iterator(BrickMap::const_iterator it, BrickMap::const_iterator end);
+        void settle();
+
+        BrickMap::const_iterator m_it;
+        BrickMap::const_iterator m_end;
+        uint32_t m_cell = 0;
+        VoxelId m_current;
+    };
+
+    // Element access; insert and erase return whether the set changed
+    bool insert(const VoxelId& voxel);
+    bool erase(const VoxelId& voxel);
+    bool contains(const VoxelId& voxel) const;
+    void clear();
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    const_iterator begin() const { return const_iterator(m_bricks.begin(), m_bricks.end()); }
+    const_iterator end() const { return const_iterator(m_bricks.end(), m_bricks.end()); }
+
+    std::vector<VoxelId> toVector() const;
+    // World bounds of all voxels, from per-brick extents; empty box if none
+    Math::BoundingBox getBounds() const;
+
+    const BrickMap& getBricks() const { return m_bricks; }
+    size_t getBrickCount() const { return m_bricks.size(); }
+    // Heap bytes held by the set
+    size_t getMemoryUsage() const;
+
+    // Brick addressing
+    static uint64_t brickKey(const VoxelId& voxel);
+    static uint16_t cellIndex(const VoxelId& voxel);
+    static VoxelId voxelAt(uint64_t key, uint32_t cell);
+    static VoxelData::VoxelResolution keyResolution(uint64_t key) {
+        return static_cast<VoxelData::VoxelResolution>(key >> 60);
+    }
+    // Bytes a hash map of this many buckets and nodes of Node takes
+    template<typename Node>
+    static size_t hashMapMemory(size_t buckets, size_t nodes) {
+        return buckets * sizeof(void*) + nodes * (sizeof(Node) + sizeof(void*));
+    }
+
+private:
+    BrickMap m_bricks;
+    size_t m_size = 0;
+};
+
+} // namespace Groups
+} // namespace VoxelEditor
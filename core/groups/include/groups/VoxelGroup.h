@@ -1,15 +1,21 @@
 #pragma once
 
 #include "GroupTypes.h"
-#include <unordered_set>
+#include "VoxelBrickSet.h"
+#include "voxel_data/VoxelConnectivity.h"
 #include <memory>
 #include <mutex>
+#include <functional>
 
 namespace VoxelEditor {
 namespace Groups {
 
 class VoxelGroup {
 public:
+    // Called with the group id after membership, bounds or visibility change,
+    // while the group's mutex is held
+    using ChangeCallback = std::function<void(GroupId)>;
+    
     VoxelGroup(GroupId id, const std::string& name);
     ~VoxelGroup() = default;
     
@@ -41,11 +47,20 @@ public:
     bool removeVoxel(const VoxelId& voxel);
     bool containsVoxel(const VoxelId& voxel) const;
     void clearVoxels();
+    // Replaces the whole membership, for bulk transforms
+    void setVoxels(const std::vector<VoxelId>& voxels);
     
-    const std::unordered_set<VoxelId>& getVoxels() const { return m_voxels; }
+    const VoxelBrickSet& getVoxels() const { return m_voxels; }
     std::vector<VoxelId> getVoxelList() const;
     size_t getVoxelCount() const { return m_voxels.size(); }
     bool isEmpty() const { return m_voxels.empty(); }
+    // Heap bytes held by the group, membership bricks included
+    size_t getMemoryUsage() const;
+    
+    // Face-connected islands of the group's voxels. Connectivity is built on
+    // first use and then follows addVoxel/removeVoxel brick by brick.
+    std::vector<std::vector<VoxelId>> getIslands() const;
+    size_t getIslandCount() const;
     
     // Bounding box
     Math::BoundingBox getBoundingBox() const;
@@ -68,17 +83,27 @@ public:
     // Thread safety
     std::mutex& getMutex() const { return m_mutex; }
     
+    void setChangeCallback(ChangeCallback callback);
+    
 private:
     GroupId m_id;
     GroupMetadata m_metadata;
-    std::unordered_set<VoxelId> m_voxels;
+    VoxelBrickSet m_voxels;
     
-    // Cached bounding box
+    ChangeCallback m_onChanged;
+    
+    // Cached bounding box; grows with added voxels and is only rebuilt when
+    // a voxel on its boundary goes away
     mutable Math::BoundingBox m_bounds;
     mutable bool m_boundsValid = false;
     mutable std::mutex m_mutex;
     
+    // Cached island labels; null until first asked for
+    mutable std::unique_ptr<VoxelData::VoxelConnectivity> m_islands;
+    
     void updateBounds() const;
+    void notifyChanged() const { if (m_onChanged) m_onChanged(m_id); }
+    const VoxelData::VoxelConnectivity& islands() const;
     float getVoxelSize(VoxelData::VoxelResolution resolution) const;
 };
 
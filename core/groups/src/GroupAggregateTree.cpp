@@ -0,0 +1,179 @@
+#include "../include/groups/GroupAggregateTree.h"
+#include "../include/groups/VoxelGroup.h"
+#include <algorithm>
+
+namespace VoxelEditor {
+namespace Groups {
+
+GroupAggregateTree::GroupAggregateTree() {
+    m_nodes[INVALID_GROUP_ID];
+}
+
+void GroupAggregateTree::markDirty(GroupId id) {
+    std::lock_guard<std::mutex> lock(m_dirtyMutex);
+    m_dirty.insert(id);
+}
+
+void GroupAggregateTree::removeGroup(GroupId id) {
+    {
+        std::lock_guard<std::mutex> lock(m_dirtyMutex);
+        m_dirty.erase(id);
+    }
+    if (id == INVALID_GROUP_ID) return;
+
+    auto it = m_nodes.find(id);
+    if (it == m_nodes.end()) return;
+
+    // Children become roots, as they do in GroupHierarchy
+    Node& root = m_nodes[INVALID_GROUP_ID];
+    for (GroupId child : it->second.children) {
+        m_nodes[child].parent = INVALID_GROUP_ID;
+        root.children.push_back(child);
+    }
+    m_stale.insert(INVALID_GROUP_ID);
+
+    unlink(id);
+    m_stale.erase(id);
+    m_nodes.erase(id);
+}
+
+void GroupAggregateTree::clear() {
+    {
+        std::lock_guard<std::mutex> lock(m_dirtyMutex);
+        m_dirty.clear();
+    }
+    m_nodes.clear();
+    m_nodes[INVALID_GROUP_ID];
+    m_stale.clear();
+}
+
+bool GroupAggregateTree::needsUpdate() const {
+    std::lock_guard<std::mutex> lock(m_dirtyMutex);
+    return !m_dirty.empty() || !m_stale.empty();
+}
+
+const GroupAggregate* GroupAggregateTree::find(GroupId id) const {
+    auto it = m_nodes.find(id);
+    return it != m_nodes.end() ? &it->second.aggregate : nullptr;
+}
+
+void GroupAggregateTree::update(const GroupHierarchy& hierarchy, const GroupLookup& lookup) {
+    std::unordered_set<GroupId> dirty;
+    {
+        std::lock_guard<std::mutex> lock(m_dirtyMutex);
+        dirty.swap(m_dirty);
+    }
+
+    // Drop deleted groups and create nodes for new ones before linking, so
+    // a parent created in the same batch is found
+    std::vector<std::pair<GroupId, const VoxelGroup*>> live;
+    live.reserve(dirty.size());
+    for (GroupId id : dirty) {
+        if (id == INVALID_GROUP_ID) continue;
+        const VoxelGroup* group = lookup(id);
+        if (!group) {
+            removeGroup(id);
+            continue;
+        }
+        if (m_nodes.emplace(id, Node()).second) {
+            m_nodes[INVALID_GROUP_ID].children.push_back(id);
+        }
+        live.emplace_back(id, group);
+    }
+
+    // Refresh each dirty group's own summary and parent link
+    for (const auto& [id, group] : live) {
+        Node& node = m_nodes[id];
+        node.voxelCount = group->getVoxelCount();
+        node.bounds = group->getBoundingBox();
+        node.visible = group->isVisible();
+
+        GroupId parent = hierarchy.getParent(id);
+        if (m_nodes.find(parent) == m_nodes.end()) {
+            parent = INVALID_GROUP_ID;
+        }
+        if (parent != node.parent) {
+            unlink(id);
+            link(id, parent);
+        }
+        m_stale.insert(id);
+    }
+
+    if (m_stale.empty()) return;
+
+    // Stale nodes and their ancestors, rebuilt deepest first so children
+    // are current when their parent aggregates them
+    std::unordered_set<GroupId> touched;
+    for (GroupId id : m_stale) {
+        GroupId current = id;
+        while (m_nodes.count(current) && touched.insert(current).second && current != INVALID_GROUP_ID) {
+            current = m_nodes[current].parent;
+        }
+    }
+    m_stale.clear();
+
+    std::vector<std::pair<int, GroupId>> order;
+    order.reserve(touched.size());
+    for (GroupId id : touched) {
+        order.emplace_back(depth(id), id);
+    }
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (const auto& [level, id] : order) {
+        aggregate(id);
+    }
+}
+
+void GroupAggregateTree::link(GroupId id, GroupId parent) {
+    m_nodes[id].parent = parent;
+    m_nodes[parent].children.push_back(id);
+}
+
+void GroupAggregateTree::unlink(GroupId id) {
+    GroupId parent = m_nodes[id].parent;
+    auto it = m_nodes.find(parent);
+    if (it != m_nodes.end()) {
+        auto& children = it->second.children;
+        children.erase(std::remove(children.begin(), children.end(), id), children.end());
+        m_stale.insert(parent);
+    }
+}
+
+void GroupAggregateTree::aggregate(GroupId id) {
+    Node& node = m_nodes[id];
+    GroupAggregate result;
+
+    if (id != INVALID_GROUP_ID) {
+        result.groupCount = 1;
+        result.voxelCount = node.voxelCount;
+        result.bounds = node.bounds;
+        if (node.visible) {
+            result.visibleVoxelCount = node.voxelCount;
+            result.visibleBounds = node.bounds;
+        }
+    }
+
+    for (GroupId child : node.children) {
+        const GroupAggregate& sub = m_nodes[child].aggregate;
+        result.groupCount += sub.groupCount;
+        result.voxelCount += sub.voxelCount;
+        result.visibleVoxelCount += sub.visibleVoxelCount;
+        result.bounds.expandToInclude(sub.bounds);
+        result.visibleBounds.expandToInclude(sub.visibleBounds);
+    }
+
+    node.aggregate = result;
+}
+
+int GroupAggregateTree::depth(GroupId id) const {
+    int level = 0;
+    while (id != INVALID_GROUP_ID) {
+        auto it = m_nodes.find(id);
+        if (it == m_nodes.end()) break;
+        id = it->second.parent;
+        ++level;
+    }
+    return level;
+}
+
+} // namespace Groups
+} // namespace VoxelEditor
@@ -22,14 +22,15 @@ GroupId GroupManager::createGroup(const std::string& name, const std::vector<Vox
     std::string uniqueName = name.empty() ? generateUniqueGroupName("Group") : name;
     
     auto group = std::make_unique<VoxelGroup>(id, uniqueName);
+    trackGroup(*group);
     
     // Set a color from the palette
     group->setColor(assignGroupColor());
     
     // Add voxels if provided
-    for (const auto& voxel : voxels) {
-        group->addVoxel(voxel);
-        updateVoxelMapping(id, voxel, true);
+    if (!voxels.empty()) {
+        group->setVoxels(voxels);
+        m_membership.addGroup(id, group->getVoxels());
     }
     
     m_groups[id] = std::move(group);
@@ -55,11 +56,12 @@ bool GroupManager::deleteGroupInternal(GroupId id) {
     std::string name = it->second->getName();
     auto voxels = it->second->getVoxelList();
     
-    // Remove from hierarchy
+    // Remove from hierarchy; children become roots
     m_hierarchy->removeFromHierarchy(id);
+    m_aggregates.removeGroup(id);
     
     // Remove from voxel mapping
-    removeFromVoxelMapping(id);
+    m_membership.removeGroup(id);
     
     // Delete the group
     m_groups.erase(it);
@@ -130,7 +132,7 @@ bool GroupManager::addVoxelToGroup(GroupId id, const VoxelId& voxel) {
     }
     
     if (it->second->addVoxel(voxel)) {
-        updateVoxelMapping(id, voxel, true);
+        m_membership.add(id, voxel);
         return true;
     }
     
@@ -146,7 +148,7 @@ bool GroupManager::removeVoxelFromGroup(GroupId id, const VoxelId& voxel) {
     }
     
     if (it->second->removeVoxel(voxel)) {
-        updateVoxelMapping(id, voxel, false);
+        m_membership.remove(id, voxel);
         return true;
     }
     
@@ -167,23 +169,13 @@ std::vector<VoxelId> GroupManager::getGroupVoxels(GroupId id) const {
 GroupId GroupManager::findGroupContaining(const VoxelId& voxel) const {
     std::lock_guard<std::mutex> lock(m_mutex);
     
-    auto it = m_voxelToGroups.find(voxel);
-    if (it != m_voxelToGroups.end() && !it->second.empty()) {
-        return it->second.front();
-    }
-    
-    return INVALID_GROUP_ID;
+    return m_membership.findFirstGroup(voxel);
 }
 
 std::vector<GroupId> GroupManager::findGroupsContaining(const VoxelId& voxel) const {
     std::lock_guard<std::mutex> lock(m_mutex);
     
-    auto it = m_voxelToGroups.find(voxel);
-    if (it != m_voxelToGroups.end()) {
-        return it->second;
-    }
-    
-    return {};
+    return m_membership.findGroups(voxel);
 }
 
 void GroupManager::hideGroup(GroupId id) {
@@ -369,6 +361,31 @@ std::vector<GroupId> GroupManager::splitGroup(GroupId sourceId,
     return {};
 }
 
+std::vector<GroupId> GroupManager::splitGroupIntoIslands(GroupId sourceId) {
+    const VoxelGroup* group = getGroup(sourceId);
+    if (!group) {
+        return {};
+    }
+    
+    auto islands = group->getIslands();
+    if (islands.size() < 2) {
+        return {};
+    }
+    
+    // The largest island stays behind so the source group keeps its identity
+    auto largest = std::max_element(islands.begin(), islands.end(),
+        [](const auto& a, const auto& b) { return a.size() < b.size(); });
+    islands.erase(largest);
+    
+    std::vector<std::string> names;
+    names.reserve(islands.size());
+    for (size_t i = 0; i < islands.size(); ++i) {
+        names.push_back(group->getName() + " Island " + std::to_string(i + 1));
+    }
+    
+    return splitGroup(sourceId, islands, names);
+}
+
 bool GroupManager::setParentGroup(GroupId child, GroupId parent) {
     std::lock_guard<std::mutex> lock(m_mutex);
     
@@ -378,7 +395,11 @@ bool GroupManager::setParentGroup(GroupId child, GroupId parent) {
         return false;
     }
     
-    return m_hierarchy->setParent(child, parent);
+    if (!m_hierarchy->setParent(child, parent)) {
+        return false;
+    }
+    m_aggregates.markDirty(child);
+    return true;
 }
 
 GroupId GroupManager::getParentGroup(GroupId id) const {
@@ -490,13 +511,11 @@ GroupStats GroupManager::getStatistics() const {
     GroupStats stats;
     
     stats.totalGroups = m_groups.size();
-    stats.totalVoxels = 0;
+    stats.totalVoxels = aggregates().getTotal().voxelCount;
     stats.maxGroupSize = 0;
     
     for (const auto& [id, group] : m_groups) {
-        size_t voxelCount = group->getVoxelCount();
-        stats.totalVoxels += voxelCount;
-        stats.maxGroupSize = std::max(stats.maxGroupSize, voxelCount);
+        stats.maxGroupSize = std::max(stats.maxGroupSize, group->getVoxelCount());
     }
     
     stats.averageGroupSize = (stats.totalGroups > 0) ? 
@@ -504,23 +523,21 @@ GroupStats GroupManager::getStatistics() const {
     
     stats.maxHierarchyDepth = m_hierarchy->getMaxDepth();
     
-    // Estimate memory usage
-    stats.memoryUsage = sizeof(GroupManager) + 
-                       m_groups.size() * (sizeof(GroupId) + sizeof(std::unique_ptr<VoxelGroup>)) +
-                       stats.totalVoxels * sizeof(VoxelId);
+    // Memory held by groups, their membership bricks and the reverse index
+    stats.memoryUsage = sizeof(GroupManager) +
+                       VoxelBrickSet::hashMapMemory<decltype(m_groups)::value_type>(m_groups.bucket_count(),
+                                                                                     m_groups.size()) +
+                       m_membership.getMemoryUsage();
+    for (const auto& [id, group] : m_groups) {
+        stats.memoryUsage += group->getMemoryUsage();
+    }
     
     return stats;
 }
 
 size_t GroupManager::getTotalVoxelCount() const {
     std::lock_guard<std::mutex> lock(m_mutex);
-    size_t count = 0;
-    
-    for (const auto& [id, group] : m_groups) {
-        count += group->getVoxelCount();
-    }
-    
-    return count;
+    return aggregates().getTotal().voxelCount;
 }
 
 size_t GroupManager::getGroupCount() const {
@@ -530,23 +547,25 @@ size_t GroupManager::getGroupCount() const {
 
 Math::BoundingBox GroupManager::getGroupsBounds() const {
     std::lock_guard<std::mutex> lock(m_mutex);
-    
-    Math::BoundingBox bounds;
-    bool first = true;
-    
-    for (const auto& [id, group] : m_groups) {
-        if (!group->isEmpty()) {
-            auto groupBounds = group->getBoundingBox();
-            if (first) {
-                bounds = groupBounds;
-                first = false;
-            } else {
-                bounds.expandToInclude(groupBounds);
-            }
-        }
+    return aggregates().getTotal().bounds;
+}
+
+Math::BoundingBox GroupManager::getVisibleGroupsBounds() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return aggregates().getTotal().visibleBounds;
+}
+
+GroupAggregate GroupManager::getHierarchyAggregate(GroupId id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_groups.find(id) == m_groups.end()) {
+        return GroupAggregate();
     }
-    
-    return bounds;
+    const GroupAggregate* aggregate = aggregates().find(id);
+    return aggregate ? *aggregate : GroupAggregate();
+}
+
+Math::BoundingBox GroupManager::getHierarchyBounds(GroupId id) const {
+    return getHierarchyAggregate(id).bounds;
 }
 
 Math::BoundingBox GroupManager::getGroupBounds(GroupId id) const {
@@ -574,29 +593,24 @@ bool GroupManager::validateGroupsInternal() const {
     }
     
     // Check voxel mapping consistency
-    for (const auto& [voxelId, groupIds] : m_voxelToGroups) {
-        for (GroupId groupId : groupIds) {
-            auto it = m_groups.find(groupId);
-            if (it == m_groups.end() || !it->second->containsVoxel(voxelId)) {
-                return false;
-            }
-        }
+    bool consistent = true;
+    m_membership.forEach([&](const VoxelId& voxel, GroupId groupId) {
+        if (!consistent) return;
+        auto it = m_groups.find(groupId);
+        consistent = it != m_groups.end() && it->second->containsVoxel(voxel);
+    });
+    if (!consistent) {
+        return false;
     }
     
-    // Check all group voxels are in mapping
+    // Every pair in the index is a group voxel, so equal counts mean every
+    // group voxel is in the index
+    size_t groupVoxels = 0;
     for (const auto& [groupId, group] : m_groups) {
-        auto voxels = group->getVoxelList();
-        for (const auto& voxel : voxels) {
-            auto mapIt = m_voxelToGroups.find(voxel);
-            if (mapIt == m_voxelToGroups.end()) {
-                return false;
-            }
-            
-            const auto& groupIds = mapIt->second;
-            if (std::find(groupIds.begin(), groupIds.end(), groupId) == groupIds.end()) {
-                return false;
-            }
-        }
+        groupVoxels += group->getVoxelCount();
+    }
+    if (groupVoxels != m_membership.size()) {
+        return false;
     }
     
     return true;
@@ -650,12 +664,14 @@ bool GroupManager::importData(const GroupManagerData& data) {
     
     // Clear existing data
     m_groups.clear();
-    m_voxelToGroups.clear();
+    m_membership.clear();
+    m_aggregates.clear();
     m_hierarchy = std::make_unique<GroupHierarchy>();
     
     // Import groups
     for (const auto& [id, metadata] : data.groups) {
         auto group = std::make_unique<VoxelGroup>(id, metadata.name);
+        trackGroup(*group);
         group->setMetadata(metadata);
         m_groups[id] = std::move(group);
     }
@@ -666,10 +682,12 @@ bool GroupManager::importData(const GroupManagerData& data) {
         if (it != m_groups.end()) {
             for (const auto& voxel : voxels) {
                 it->second->addVoxel(voxel);
-                updateVoxelMapping(id, voxel, true);
             }
         }
     }
+    for (const auto& [id, group] : m_groups) {
+        m_membership.addGroup(id, group->getVoxels());
+    }
     
     // Import hierarchy
     m_hierarchy->importData(data.hierarchy);
@@ -691,39 +709,25 @@ std::string GroupManager::generateUniqueGroupName(const std::string& baseName) c
     return GroupOperationUtils::generateUniqueName(baseName, existingNames);
 }
 
-Rendering::Color GroupManager::assignGroupColor() const {
-    // Use the next color from the palette based on group count
-    return GroupColorPalette::getColorForIndex(m_groups.size());
+void GroupManager::trackGroup(VoxelGroup& group) {
+    m_aggregates.markDirty(group.getId());
+    group.setChangeCallback([this](GroupId id) { m_aggregates.markDirty(id); });
 }
 
-void GroupManager::updateVoxelMapping(GroupId groupId, const VoxelId& voxel, bool add) {
-    auto& groupIds = m_voxelToGroups[voxel];
-    
-    if (add) {
-        if (std::find(groupIds.begin(), groupIds.end(), groupId) == groupIds.end()) {
-            groupIds.push_back(groupId);
-        }
-    } else {
-        groupIds.erase(std::remove(groupIds.begin(), groupIds.end(), groupId), groupIds.end());
-        if (groupIds.empty()) {
-            m_voxelToGroups.erase(voxel);
-        }
+const GroupAggregateTree& GroupManager::aggregates() const {
+    // Mutex should already be held
+    if (m_aggregates.needsUpdate()) {
+        m_aggregates.update(*m_hierarchy, [this](GroupId id) -> const VoxelGroup* {
+            auto it = m_groups.find(id);
+            return it != m_groups.end() ? it->second.get() : nullptr;
+        });
     }
+    return m_aggregates;
 }
 
-void GroupManager::removeFromVoxelMapping(GroupId groupId) {
-    for (auto& [voxel, groups] : m_voxelToGroups) {
-        groups.erase(std::remove(groups.begin(), groups.end(), groupId), groups.end());
-    }
-    
-    // Clean up empty entries
-    for (auto it = m_voxelToGroups.begin(); it != m_voxelToGroups.end(); ) {
-        if (it->second.empty()) {
-            it = m_voxelToGroups.erase(it);
-        } else {
-            ++it;
-        }
-    }
+Rendering::Color GroupManager::assignGroupColor() const {
+    // Use the next color from the palette based on group count
+    return GroupColorPalette::getColorForIndex(m_groups.size());
 }
 
 void GroupManager::dispatchGroupCreated(GroupId groupId, const std::string& name,
@@ -783,8 +787,24 @@ std::unique_ptr<GroupOperation> GroupManager::createScaleOperation(GroupId group
 // Add this method to the public interface for GroupOperations to use
 void GroupManager::updateVoxelGroupMembership(const VoxelId& voxel, GroupId oldGroup, GroupId newGroup) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    updateVoxelMapping(oldGroup, voxel, false);
-    updateVoxelMapping(newGroup, voxel, true);
+    m_membership.remove(oldGroup, voxel);
+    if (newGroup != INVALID_GROUP_ID) {
+        m_membership.add(newGroup, voxel);
+    }
+}
+
+bool GroupManager::setGroupVoxels(GroupId id, const std::vector<VoxelId>& voxels) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    auto it = m_groups.find(id);
+    if (it == m_groups.end()) {
+        return false;
+    }
+    
+    m_membership.removeGroup(id);
+    it->second->setVoxels(voxels);
+    m_membership.addGroup(id, it->second->getVoxels());
+    return true;
 }
 
 } // namespace Groups
@@ -0,0 +1,164 @@
+#include "../include/groups/GroupMembershipIndex.h"
+#include <algorithm>
+
+namespace VoxelEditor {
+namespace Groups {
+
+namespace {
+
+using Palette = GroupMembershipIndex::Palette;
+
+inline Palette::iterator findEntry(Palette& palette, GroupId group) {
+    return std::find_if(palette.begin(), palette.end(),
+                        [group](const auto& entry) { return entry.group == group; });
+}
+
+inline Palette::const_iterator findEntry(const Palette& palette, GroupId group) {
+    return std::find_if(palette.begin(), palette.end(),
+                        [group](const auto& entry) { return entry.group == group; });
+}
+
+}
+
+bool GroupMembershipIndex::add(GroupId group, const VoxelId& voxel) {
+    uint64_t key = VoxelBrickSet::brickKey(voxel);
+    Palette& palette = m_bricks[key];
+    auto entry = findEntry(palette, group);
+    if (entry == palette.end()) {
+        palette.push_back({group, BrickCells()});
+        entry = palette.end() - 1;
+        m_groupBricks[group].insert(key);
+    }
+    if (!entry->cells.insert(VoxelBrickSet::cellIndex(voxel))) {
+        return false;
+    }
+    ++m_size;
+    return true;
+}
+
+bool GroupMembershipIndex::remove(GroupId group, const VoxelId& voxel) {
+    auto it = m_bricks.find(VoxelBrickSet::brickKey(voxel));
+    if (it == m_bricks.end()) {
+        return false;
+    }
+    Palette& palette = it->second;
+    auto entry = findEntry(palette, group);
+    if (entry == palette.end() || !entry->cells.erase(VoxelBrickSet::cellIndex(voxel))) {
+        return false;
+    }
+    if (entry->cells.empty()) {
+        auto groupIt = m_groupBricks.find(group);
+        groupIt->second.erase(it->first);
+        if (groupIt->second.empty()) {
+            m_groupBricks.erase(groupIt);
+        }
+        palette.erase(entry);
+        if (palette.empty()) {
+            m_bricks.erase(it);
+        }
+    }
+    --m_size;
+    return true;
+}
+
+void GroupMembershipIndex::addGroup(GroupId group, const VoxelBrickSet& voxels) {
+    if (voxels.empty()) {
+        return;
+    }
+    auto& groupBricks = m_groupBricks[group];
+    for (const auto& [key, cells] : voxels.getBricks()) {
+        Palette& palette = m_bricks[key];
+        auto entry = findEntry(palette, group);
+        if (entry == palette.end()) {
+            palette.push_back({group, cells});
+            groupBricks.insert(key);
+            m_size += cells.size();
+        } else {
+            uint32_t before = entry->cells.size();
+            entry->cells.unite(cells);
+            m_size += entry->cells.size() - before;
+        }
+    }
+}
+
+void GroupMembershipIndex::removeGroup(GroupId group) {
+    auto groupIt = m_groupBricks.find(group);
+    if (groupIt == m_groupBricks.end()) {
+        return;
+    }
+    for (uint64_t key : groupIt->second) {
+        auto it = m_bricks.find(key);
+        Palette& palette = it->second;
+        auto entry = findEntry(palette, group);
+        m_size -= entry->cells.size();
+        palette.erase(entry);
+        if (palette.empty()) {
+            m_bricks.erase(it);
+        }
+    }
+    m_groupBricks.erase(groupIt);
+}
+
+void GroupMembershipIndex::clear() {
+    m_bricks.clear();
+    m_groupBricks.clear();
+    m_size = 0;
+}
+
+bool GroupMembershipIndex::contains(GroupId group, const VoxelId& voxel) const {
+    auto it = m_bricks.find(VoxelBrickSet::brickKey(voxel));
+    if (it == m_bricks.end()) {
+        return false;
+    }
+    auto entry = findEntry(it->second, group);
+    return entry != it->second.end() && entry->cells.contains(VoxelBrickSet::cellIndex(voxel));
+}
+
+std::vector<GroupId> GroupMembershipIndex::findGroups(const VoxelId& voxel) const {
+    std::vector<GroupId> groups;
+    auto it = m_bricks.find(VoxelBrickSet::brickKey(voxel));
+    if (it == m_bricks.end()) {
+        return groups;
+    }
+    uint16_t cell = VoxelBrickSet::cellIndex(voxel);
+    for (const auto& entry : it->second) {
+        if (entry.cells.contains(cell)) {
+            groups.push_back(entry.group);
+        }
+    }
+    return groups;
+}
+
+GroupId GroupMembershipIndex::findFirstGroup(const VoxelId& voxel) const {
+    auto it = m_bricks.find(VoxelBrickSet::brickKey(voxel));
+    if (it == m_bricks.end()) {
+        return INVALID_GROUP_ID;
+    }
+    uint16_t cell = VoxelBrickSet::cellIndex(voxel);
+    for (const auto& entry : it->second) {
+        if (entry.cells.contains(cell)) {
+            return entry.group;
+        }
+    }
+    return INVALID_GROUP_ID;
+}
+
+size_t GroupMembershipIndex::getMemoryUsage() const {
+    size_t bytes = VoxelBrickSet::hashMapMemory<std::pair<const uint64_t, Palette>>(m_bricks.bucket_count(),
+                                                                                  m_bricks.size());
+    for (const auto& [key, palette] : m_bricks) {
+        bytes += palette.capacity() * sizeof(PaletteEntry);
+        for (const auto& entry : palette) {
+            bytes += entry.cells.getMemoryUsage();
+        }
+    }
+    using GroupBricks = std::pair<const GroupId, std::unordered_set<uint64_t>>;
+    bytes += VoxelBrickSet::hashMapMemory<GroupBricks>(m_groupBricks.bucket_count(), m_groupBricks.size());
+    for (const auto& [group, keys] : m_groupBricks) {
+        bytes += VoxelBrickSet::hashMapMemory<uint64_t>(keys.bucket_count(), keys.size());
+    }
+    return bytes;
+}
+
+} // namespace Groups
+} // namespace VoxelEditor
@@ -1,6 +1,7 @@
 #include "../include/groups/GroupOperations.h"
 #include "../include/groups/GroupManager.h"
 #include "../include/groups/VoxelGroup.h"
+#include "voxel_math/VoxelMathSIMD.h"
 #include <cmath>
 #include <algorithm>
 #include <sstream>
@@ -8,6 +9,28 @@
 namespace VoxelEditor {
 namespace Groups {
 
+namespace {
+
+// Moved copies of voxels, exact on the lattice when the offset allows
+std::vector<VoxelId> translateVoxels(const std::vector<VoxelId>& voxels, const Math::WorldCoordinates& offset) {
+    GroupOperationUtils::LatticeTransform lattice;
+    if (GroupOperationUtils::makeLatticeTransform(offset, Math::Vector3f(0, 0, 0),
+                                                  Math::WorldCoordinates::zero(), lattice)) {
+        return GroupOperationUtils::transformVoxels(voxels, lattice);
+    }
+    
+    // Sub-centimeter offset: round each voxel through world space
+    std::vector<VoxelId> result;
+    result.reserve(voxels.size());
+    for (const auto& voxel : voxels) {
+        Math::WorldCoordinates newWorldCoords = voxel.getWorldPosition() + offset;
+        result.emplace_back(Math::CoordinateConverter::worldToIncrement(newWorldCoords), voxel.resolution);
+    }
+    return result;
+}
+
+}
+
 // MoveGroupOperation implementation
 MoveGroupOperation::MoveGroupOperation(GroupManager* groupManager, 
                                      VoxelData::VoxelDataManager* voxelManager,
@@ -24,76 +47,19 @@ bool MoveGroupOperation::execute() {
     auto group = m_groupManager->getGroup(m_groupId);
     if (!group) return false;
     
-    // Get all voxels in the group
-    auto voxelList = group->getVoxelList();
-    m_voxelMoves.clear();
-    m_voxelMoves.reserve(voxelList.size());
-    
-    // Calculate new positions for all voxels
-    Math::Vector3f workspaceSize = m_voxelManager->getWorkspaceSize();
-    
-    for (const auto& voxel : voxelList) {
-        // Use VoxelId's getWorldPosition() method which handles centered coordinate system
-        Math::WorldCoordinates worldCoords = voxel.getWorldPosition();
-        Math::WorldCoordinates newWorldCoords = worldCoords + m_offset;
-        
-        // Convert back to grid coordinates using the centralized converter
-        Math::IncrementCoordinates newGridCoords = Math::CoordinateConverter::worldToIncrement(newWorldCoords);
-        
-        VoxelId newVoxel(newGridCoords, voxel.resolution);
-        m_voxelMoves.emplace_back(voxel, newVoxel);
-    }
-    
-    // Validate new positions are within workspace
-    std::vector<VoxelId> newPositions;
-    for (const auto& [oldPos, newPos] : m_voxelMoves) {
-        newPositions.push_back(newPos);
-    }
+    std::vector<VoxelId> oldVoxels = group->getVoxelList();
+    std::vector<VoxelId> newVoxels = translateVoxels(oldVoxels, m_offset);
     
-    // Create workspace bounds using centered coordinate system
-    Math::BoundingBox workspaceBounds(
-        Math::Vector3f(-workspaceSize.x/2, 0.0f, -workspaceSize.z/2),
-        Math::Vector3f(workspaceSize.x/2, workspaceSize.y, workspaceSize.z/2)
-    );
-    if (!GroupOperationUtils::validateVoxelPositions(newPositions, workspaceBounds)) {
-        m_voxelMoves.clear();
+    // One batched edit validates bounds and collisions and swaps the voxels
+    auto result = m_voxelManager->replaceVoxels(GroupOperationUtils::toVoxelPositions(oldVoxels),
+                                                GroupOperationUtils::toVoxelPositions(newVoxels));
+    if (!result.success) {
         return false;
     }
     
-    // Check for collisions with existing voxels
-    for (const auto& [oldPos, newPos] : m_voxelMoves) {
-        // Position is already in IncrementCoordinates, no conversion needed
-        Math::IncrementCoordinates newIncrement = newPos.position;
-        
-        if (m_voxelManager->hasVoxel(newIncrement, newPos.resolution)) {
-            // Check if it's not the same voxel we're moving
-            bool isSameVoxel = false;
-            for (const auto& [checkOld, checkNew] : m_voxelMoves) {
-                if (checkOld == newPos) {
-                    isSameVoxel = true;
-                    break;
-                }
-            }
-            if (!isSameVoxel) {
-                m_voxelMoves.clear();
-                return false;
-            }
-        }
-    }
-    
-    // Clear the group and rebuild with moved voxels
-    group->clearVoxels();
-    
-    // Remove old voxels from VoxelDataManager and add new ones
-    for (const auto& [oldPos, newPos] : m_voxelMoves) {
-        // Convert grid coordinates to increment coordinates for VoxelDataManager
-        Math::IncrementCoordinates oldIncrement = oldPos.position;
-        Math::IncrementCoordinates newIncrement = newPos.position;
-        
-        m_voxelManager->setVoxel(oldIncrement, oldPos.resolution, false);
-        m_voxelManager->setVoxel(newIncrement, newPos.resolution, true);
-        group->addVoxel(newPos);
-    }
+    m_groupManager->setGroupVoxels(m_groupId, newVoxels);
+    m_oldVoxels = std::move(oldVoxels);
+    m_newVoxels = std::move(newVoxels);
     
     m_executed = true;
     return true;
@@ -105,20 +71,12 @@ bool MoveGroupOperation::undo() {
     auto group = m_groupManager->getGroup(m_groupId);
     if (!group) return false;
     
-    // Clear the group and rebuild with original voxels
-    group->clearVoxels();
-    
-    // Remove new voxels from VoxelDataManager and restore old ones
-    Math::Vector3f workspaceSize = m_voxelManager->getWorkspaceSize();
-    for (const auto& [oldPos, newPos] : m_voxelMoves) {
-        // Convert grid coordinates to increment coordinates for VoxelDataManager
-        Math::IncrementCoordinates oldIncrement = oldPos.position;
-        Math::IncrementCoordinates newIncrement = newPos.position;
-        
-        m_voxelManager->setVoxel(newIncrement, newPos.resolution, false);
-        m_voxelManager->setVoxel(oldIncrement, oldPos.resolution, true);
-        group->addVoxel(oldPos);
+    auto result = m_voxelManager->replaceVoxels(GroupOperationUtils::toVoxelPositions(m_newVoxels),
+                                                GroupOperationUtils::toVoxelPositions(m_oldVoxels));
+    if (!result.success) {
+        return false;
     }
+    m_groupManager->setGroupVoxels(m_groupId, m_oldVoxels);
     
     m_executed = false;
     return true;
@@ -165,32 +123,22 @@ bool CopyGroupOperation::execute() {
     newGroup->setMetadata(metadata);
     
     // Copy voxels with offset
-    auto sourceVoxels = sourceGroup->getVoxelList();
-    m_createdVoxels.clear();
-    m_createdVoxels.reserve(sourceVoxels.size());
-    
-    Math::Vector3f workspaceSize = m_voxelManager->getWorkspaceSize();
-    
+    m_createdVoxels = translateVoxels(sourceGroup->getVoxelList(), m_offset);
     
-    for (const auto& voxel : sourceVoxels) {
-        // Use VoxelId's getWorldPosition() method which handles centered coordinate system
-        Math::WorldCoordinates worldCoords = voxel.getWorldPosition();
-        Math::Vector3f worldPos = worldCoords.value();
-        Math::Vector3f newWorldPos = worldPos + m_offset.value();
-        
-        // Convert back to grid coordinates using the centralized converter
-        Math::IncrementCoordinates newGridCoords = Math::CoordinateConverter::worldToIncrement(
-            Math::WorldCoordinates(newWorldPos));
-        
-        VoxelId newVoxel(newGridCoords, voxel.resolution);
-        
-        // Always create the copied voxel (even if there's a collision)
-        // Position is already in IncrementCoordinates, no conversion needed
-        Math::IncrementCoordinates newIncrement = newVoxel.position;
-        m_voxelManager->setVoxel(newIncrement, newVoxel.resolution, true);
-        newGroup->addVoxel(newVoxel);
-        m_createdVoxels.push_back(newVoxel);
+    auto result = m_voxelManager->replaceVoxels({}, GroupOperationUtils::toVoxelPositions(m_createdVoxels));
+    if (result.success) {
+        m_placedVoxels = m_createdVoxels;
+    } else {
+        // The copy keeps every voxel even where the scene is occupied; place
+        // the ones that fit one at a time
+        m_placedVoxels.clear();
+        for (const auto& voxel : m_createdVoxels) {
+            if (m_voxelManager->setVoxel(voxel.position, voxel.resolution, true)) {
+                m_placedVoxels.push_back(voxel);
+            }
+        }
     }
+    m_groupManager->setGroupVoxels(m_createdGroupId, m_createdVoxels);
     
     m_executed = true;
     return true;
@@ -199,18 +147,14 @@ bool CopyGroupOperation::execute() {
 bool CopyGroupOperation::undo() {
     if (!m_executed) return false;
     
-    // Remove all created voxels
-    Math::Vector3f workspaceSize = m_voxelManager->getWorkspaceSize();
-    for (const auto& voxel : m_createdVoxels) {
-        // Convert grid coordinates to increment coordinates for VoxelDataManager
-        Math::IncrementCoordinates increment = voxel.position;
-        m_voxelManager->setVoxel(increment, voxel.resolution, false);
-    }
+    // Remove the voxels the copy placed
+    m_voxelManager->replaceVoxels(GroupOperationUtils::toVoxelPositions(m_placedVoxels), {});
     
     // Delete the created group
     m_groupManager->deleteGroup(m_createdGroupId);
     m_createdGroupId = INVALID_GROUP_ID;
     m_createdVoxels.clear();
+    m_placedVoxels.clear();
     
     m_executed = false;
     return true;
@@ -243,87 +187,67 @@ bool RotateGroupOperation::execute() {
     auto group = m_groupManager->getGroup(m_groupId);
     if (!group) return false;
     
-    // Get all voxels in the group
-    auto voxelList = group->getVoxelList();
-    m_voxelMoves.clear();
-    m_voxelMoves.reserve(voxelList.size());
-    
-    // Create rotation matrix from Euler angles
-    float cx = std::cos(m_eulerAngles.x);
-    float sx = std::sin(m_eulerAngles.x);
-    float cy = std::cos(m_eulerAngles.y);
-    float sy = std::sin(m_eulerAngles.y);
-    float cz = std::cos(m_eulerAngles.z);
-    float sz = std::sin(m_eulerAngles.z);
+    std::vector<VoxelId> oldVoxels = group->getVoxelList();
+    std::vector<VoxelId> newVoxels;
     
-    // Calculate new positions for all voxels
-    Math::Vector3f workspaceSize = m_voxelManager->getWorkspaceSize();
-    
-    for (const auto& voxel : voxelList) {
-        // Use the proper coordinate conversion
-        Math::WorldCoordinates worldCoords = voxel.getWorldPosition();
-        Math::Vector3f worldPos = worldCoords.value();
-        
-        // Translate to pivot
-        Math::Vector3f relPos = worldPos - m_pivot.value();
-        
-        // Apply rotation (ZYX order)
-        Math::Vector3f rotated;
-        // Z rotation
-        float tempX = relPos.x * cz - relPos.y * sz;
-        float tempY = relPos.x * sz + relPos.y * cz;
-        relPos.x = tempX;
-        relPos.y = tempY;
-        
-        // Y rotation
-        tempX = relPos.x * cy + relPos.z * sy;
-        float tempZ = -relPos.x * sy + relPos.z * cy;
-        relPos.x = tempX;
-        relPos.z = tempZ;
-        
-        // X rotation
-        tempY = relPos.y * cx - relPos.z * sx;
-        tempZ = relPos.y * sx + relPos.z * cx;
-        relPos.y = tempY;
-        relPos.z = tempZ;
-        
-        // Translate back from pivot
-        Math::Vector3f newWorldPos = relPos + m_pivot.value();
-        
-        // Convert back to grid coordinates using the centralized converter
-        Math::IncrementCoordinates newGridCoords = Math::CoordinateConverter::worldToIncrement(
-            Math::WorldCoordinates(newWorldPos));
-        
-        VoxelId newVoxel(newGridCoords, voxel.resolution);
+    GroupOperationUtils::LatticeTransform lattice;
+    if (GroupOperationUtils::makeLatticeTransform(Math::WorldCoordinates::zero(), m_eulerAngles,
+                                                  m_pivot, lattice)) {
+        // Quarter turns about a lattice pivot permute the lattice
+        newVoxels = GroupOperationUtils::transformVoxels(oldVoxels, lattice);
+    } else {
+        // Create rotation matrix from Euler angles
+        float cx = std::cos(m_eulerAngles.x);
+        float sx = std::sin(m_eulerAngles.x);
+        float cy = std::cos(m_eulerAngles.y);
+        float sy = std::sin(m_eulerAngles.y);
+        float cz = std::cos(m_eulerAngles.z);
+        float sz = std::sin(m_eulerAngles.z);
         
-        m_voxelMoves.emplace_back(voxel, newVoxel);
-    }
-    
-    // Check for overlaps
-    std::unordered_set<VoxelId> newPositions;
-    for (const auto& [oldPos, newPos] : m_voxelMoves) {
-        if (!newPositions.insert(newPos).second) {
-            // Duplicate position after rotation
-            m_voxelMoves.clear();
-            return false;
+        newVoxels.reserve(oldVoxels.size());
+        for (const auto& voxel : oldVoxels) {
+            // Translate to pivot
+            Math::Vector3f relPos = voxel.getWorldPosition().value() - m_pivot.value();
+            
+            // Apply rotation (ZYX order)
+            // Z rotation
+            float tempX = relPos.x * cz - relPos.y * sz;
+            float tempY = relPos.x * sz + relPos.y * cz;
+            relPos.x = tempX;
+            relPos.y = tempY;
+            
+            // Y rotation
+            tempX = relPos.x * cy + relPos.z * sy;
+            float tempZ = -relPos.x * sy + relPos.z * cy;
+            relPos.x = tempX;
+            relPos.z = tempZ;
+            
+            // X rotation
+            tempY = relPos.y * cx - relPos.z * sx;
+            tempZ = relPos.y * sx + relPos.z * cx;
+            relPos.y = tempY;
+            relPos.z = tempZ;
+            
+            // Translate back from pivot
+            Math::Vector3f newWorldPos = relPos + m_pivot.value();
+            
+            // Convert back to grid coordinates using the centralized converter
+            Math::IncrementCoordinates newGridCoords = Math::CoordinateConverter::worldToIncrement(
+                Math::WorldCoordinates(newWorldPos));
+            newVoxels.emplace_back(newGridCoords, voxel.resolution);
         }
     }
     
-    // Remove old voxels
-    for (const auto& [oldPos, newPos] : m_voxelMoves) {
-        // Convert grid coordinates to increment coordinates for VoxelDataManager
-        Math::IncrementCoordinates oldIncrement = oldPos.position;
-        m_voxelManager->setVoxel(oldIncrement, oldPos.resolution, false);
-        group->removeVoxel(oldPos);
+    // Rotated voxels that land on one another are rejected as overlaps
+    auto result = m_voxelManager->replaceVoxels(GroupOperationUtils::toVoxelPositions(oldVoxels),
+                                                GroupOperationUtils::toVoxelPositions(newVoxels));
+    if (!result.success) {
+        return false;
     }
     
-    // Add new voxels
-    for (const auto& [oldPos, newPos] : m_voxelMoves) {
-        // Position is already in IncrementCoordinates, no conversion needed
-        Math::IncrementCoordinates newIncrement = newPos.position;
-        m_voxelManager->setVoxel(newIncrement, newPos.resolution, true);
-        group->addVoxel(newPos);
-    }
+    m_groupManager->setGroupVoxels(m_groupId, newVoxels);
+    m_oldVoxels = std::move(oldVoxels);
+    m_newVoxels = std::move(newVoxels);
     
     m_executed = true;
     return true;
@@ -335,24 +259,12 @@ bool RotateGroupOperation::undo() {
     auto group = m_groupManager->getGroup(m_groupId);
     if (!group) return false;
     
-    // Get workspace size for coordinate conversion
-    Math::Vector3f workspaceSize = m_voxelManager->getWorkspaceSize();
-    
-    // Remove rotated voxels
-    for (const auto& [oldPos, newPos] : m_voxelMoves) {
-        // Position is already in IncrementCoordinates, no conversion needed
-        Math::IncrementCoordinates newIncrement = newPos.position;
-        m_voxelManager->setVoxel(newIncrement, newPos.resolution, false);
-        group->removeVoxel(newPos);
-    }
-    
-    // Restore original voxels
-    for (const auto& [oldPos, newPos] : m_voxelMoves) {
-        // Convert grid coordinates to increment coordinates for VoxelDataManager
-        Math::IncrementCoordinates oldIncrement = oldPos.position;
-        m_voxelManager->setVoxel(oldIncrement, oldPos.resolution, true);
-        group->addVoxel(oldPos);
+    auto result = m_voxelManager->replaceVoxels(GroupOperationUtils::toVoxelPositions(m_newVoxels),
+                                                GroupOperationUtils::toVoxelPositions(m_oldVoxels));
+    if (!result.success) {
+        return false;
     }
+    m_groupManager->setGroupVoxels(m_groupId, m_oldVoxels);
     
     m_executed = false;
     return true;
@@ -390,9 +302,6 @@ bool ScaleGroupOperation::execute() {
     // For now, we'll implement a simple approach that works for integer scale factors
     // TODO: Implement more sophisticated scaling with resampling
     
-    auto voxelList = group->getVoxelList();
-    m_voxelMoves.clear();
-    
     // For non-integer scales, we'd need to implement voxel resampling
     // For now, return false for non-integer scales
     if (std::abs(m_scaleFactor - std::round(m_scaleFactor)) > 0.001f) {
@@ -400,61 +309,61 @@ bool ScaleGroupOperation::execute() {
     }
     
     int scale = static_cast<int>(std::round(m_scaleFactor));
+    if (scale <= 1) {
+        // Scaling down is not implemented yet
+        return false;
+    }
     
-    // Get workspace size for coordinate conversions
-    Math::Vector3f workspaceSize = m_voxelManager->getWorkspaceSize();
+    std::vector<VoxelId> oldVoxels = group->getVoxelList();
+    std::vector<VoxelId> newVoxels;
+    newVoxels.reserve(oldVoxels.size() * scale * scale * scale);
     
-    if (scale > 1) {
-        // Scaling up: each voxel becomes a cube of voxels
-        
-        for (const auto& voxel : voxelList) {
-            // Use the centralized coordinate converter
-            Math::WorldCoordinates worldCoords = Math::CoordinateConverter::incrementToWorld(
-                voxel.position);
-            Math::Vector3f worldPos = worldCoords.value();
-            float voxelSize = VoxelData::getVoxelSize(voxel.resolution);
-            
-            Math::Vector3f relPos = worldPos - m_pivot.value();
-            
+    // Scaling up: each voxel becomes a cube of voxels
+    GroupOperationUtils::LatticeTransform lattice;
+    bool onLattice = GroupOperationUtils::makeLatticeTransform(Math::WorldCoordinates::zero(),
+                                                               Math::Vector3f(0, 0, 0), m_pivot, lattice);
+    for (const auto& voxel : oldVoxels) {
+        if (onLattice) {
+            int voxelStep = static_cast<int>(std::round(voxel.getVoxelSize() * 100.0f));
+            Math::Vector3i scaledPos = (voxel.position.value() - lattice.pivot) * scale + lattice.pivot;
             for (int dx = 0; dx < scale; ++dx) {
                 for (int dy = 0; dy < scale; ++dy) {
                     for (int dz = 0; dz < scale; ++dz) {
-                        Math::Vector3f newRelPos = relPos * m_scaleFactor + 
-                            Math::Vector3f(dx * voxelSize, dy * voxelSize, dz * voxelSize);
-                        Math::Vector3f newWorldPos = newRelPos + m_pivot.value();
-                        
-                        // Convert back to grid coordinates using the centralized converter
-                        Math::IncrementCoordinates newGridCoords = Math::CoordinateConverter::worldToIncrement(
-                            Math::WorldCoordinates(newWorldPos));
-                        
-                        VoxelId newVoxel(newGridCoords, voxel.resolution);
-                        
-                        m_voxelMoves.emplace_back(voxel, newVoxel);
+                        newVoxels.emplace_back(Math::IncrementCoordinates(
+                            scaledPos + Math::Vector3i(dx, dy, dz) * voxelStep), voxel.resolution);
                     }
                 }
             }
+            continue;
+        }
+        
+        Math::Vector3f relPos = Math::CoordinateConverter::incrementToWorld(voxel.position).value() - m_pivot.value();
+        float voxelSize = voxel.getVoxelSize();
+        for (int dx = 0; dx < scale; ++dx) {
+            for (int dy = 0; dy < scale; ++dy) {
+                for (int dz = 0; dz < scale; ++dz) {
+                    Math::Vector3f newRelPos = relPos * m_scaleFactor + 
+                        Math::Vector3f(dx * voxelSize, dy * voxelSize, dz * voxelSize);
+                    Math::Vector3f newWorldPos = newRelPos + m_pivot.value();
+                    
+                    // Convert back to grid coordinates using the centralized converter
+                    Math::IncrementCoordinates newGridCoords = Math::CoordinateConverter::worldToIncrement(
+                        Math::WorldCoordinates(newWorldPos));
+                    newVoxels.emplace_back(newGridCoords, voxel.resolution);
+                }
+            }
         }
-    } else {
-        // Scaling down is not implemented yet
-        return false;
     }
     
-    // Execute the moves
-    // First remove all old voxels
-    for (const auto& voxel : voxelList) {
-        // Position is already in IncrementCoordinates, no conversion needed
-        Math::IncrementCoordinates oldIncrement = voxel.position;
-        m_voxelManager->setVoxel(oldIncrement, voxel.resolution, false);
-        group->removeVoxel(voxel);
+    auto result = m_voxelManager->replaceVoxels(GroupOperationUtils::toVoxelPositions(oldVoxels),
+                                                GroupOperationUtils::toVoxelPositions(newVoxels));
+    if (!result.success) {
+        return false;
     }
     
-    // Add new voxels
-    for (const auto& [oldPos, newPos] : m_voxelMoves) {
-        // Position is already in IncrementCoordinates, no conversion needed
-        Math::IncrementCoordinates newIncrement = newPos.position;
-        m_voxelManager->setVoxel(newIncrement, newPos.resolution, true);
-        group->addVoxel(newPos);
-    }
+    m_groupManager->setGroupVoxels(m_groupId, newVoxels);
+    m_oldVoxels = std::move(oldVoxels);
+    m_newVoxels = std::move(newVoxels);
     
     m_executed = true;
     return true;
@@ -466,34 +375,12 @@ bool ScaleGroupOperation::undo() {
     auto group = m_groupManager->getGroup(m_groupId);
     if (!group) return false;
     
-    // Remove scaled voxels
-    std::unordered_set<VoxelId> uniqueNewPositions;
-    for (const auto& [oldPos, newPos] : m_voxelMoves) {
-        uniqueNewPositions.insert(newPos);
-    }
-    
-    // Get workspace size for coordinate conversion
-    Math::Vector3f workspaceSize = m_voxelManager->getWorkspaceSize();
-    
-    for (const auto& voxel : uniqueNewPositions) {
-        // Convert grid coordinates to increment coordinates for VoxelDataManager
-        Math::IncrementCoordinates increment = voxel.position;
-        m_voxelManager->setVoxel(increment, voxel.resolution, false);
-        group->removeVoxel(voxel);
-    }
-    
-    // Restore original voxels
-    std::unordered_set<VoxelId> uniqueOldPositions;
-    for (const auto& [oldPos, newPos] : m_voxelMoves) {
-        uniqueOldPositions.insert(oldPos);
-    }
-    
-    for (const auto& voxel : uniqueOldPositions) {
-        // Convert grid coordinates to increment coordinates for VoxelDataManager
-        Math::IncrementCoordinates increment = voxel.position;
-        m_voxelManager->setVoxel(increment, voxel.resolution, true);
-        group->addVoxel(voxel);
+    auto result = m_voxelManager->replaceVoxels(GroupOperationUtils::toVoxelPositions(m_newVoxels),
+                                                GroupOperationUtils::toVoxelPositions(m_oldVoxels));
+    if (!result.success) {
+        return false;
     }
+    m_groupManager->setGroupVoxels(m_groupId, m_oldVoxels);
     
     m_executed = false;
     return true;
@@ -702,6 +589,111 @@ VoxelId transformVoxel(const VoxelId& voxel, const GroupTransform& transform) {
     return VoxelId(newGridCoords, voxel.resolution);
 }
 
+namespace {
+
+// Value in meters as whole centimeters, if it is one
+bool toIncrements(float meters, int& increments) {
+    float value = meters * 100.0f;
+    float rounded = std::round(value);
+    if (std::abs(value - rounded) > 1e-3f) return false;
+    increments = static_cast<int>(rounded);
+    return true;
+}
+
+// Cosine and sine of an angle that is a whole number of quarter turns
+bool quarterTurn(float radians, int& c, int& s) {
+    float turns = radians / Math::HALF_PI;
+    float rounded = std::round(turns);
+    if (std::abs(turns - rounded) > 1e-4f) return false;
+    static const int cosines[4] = {1, 0, -1, 0};
+    static const int sines[4] = {0, 1, 0, -1};
+    int index = ((static_cast<int>(rounded) % 4) + 4) % 4;
+    c = cosines[index];
+    s = sines[index];
+    return true;
+}
+
+std::array<int, 9> multiply(const std::array<int, 9>& a, const std::array<int, 9>& b) {
+    std::array<int, 9> result{};
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            for (int k = 0; k < 3; ++k) {
+                result[row * 3 + col] += a[row * 3 + k] * b[k * 3 + col];
+            }
+        }
+    }
+    return result;
+}
+
+}
+
+bool makeLatticeTransform(const Math::WorldCoordinates& offset, const Math::Vector3f& eulerAngles,
+                          const Math::WorldCoordinates& pivot, LatticeTransform& transform) {
+    LatticeTransform result;
+    if (!toIncrements(offset.x(), result.translation.x) ||
+        !toIncrements(offset.y(), result.translation.y) ||
+        !toIncrements(offset.z(), result.translation.z) ||
+        !toIncrements(pivot.x(), result.pivot.x) ||
+        !toIncrements(pivot.y(), result.pivot.y) ||
+        !toIncrements(pivot.z(), result.pivot.z)) {
+        return false;
+    }
+    
+    int cx, sx, cy, sy, cz, sz;
+    if (!quarterTurn(eulerAngles.x, cx, sx) ||
+        !quarterTurn(eulerAngles.y, cy, sy) ||
+        !quarterTurn(eulerAngles.z, cz, sz)) {
+        return false;
+    }
+    
+    // Z is applied first, so it is the rightmost factor
+    std::array<int, 9> rotX = {1, 0, 0,  0, cx, -sx,  0, sx, cx};
+    std::array<int, 9> rotY = {cy, 0, sy,  0, 1, 0,  -sy, 0, cy};
+    std::array<int, 9> rotZ = {cz, -sz, 0,  sz, cz, 0,  0, 0, 1};
+    result.rotation = multiply(rotX, multiply(rotY, rotZ));
+    result.rotates = result.rotation != LatticeTransform().rotation;
+    
+    transform = result;
+    return true;
+}
+
+std::vector<VoxelId> transformVoxels(const std::vector<VoxelId>& voxels, const LatticeTransform& transform) {
+    std::vector<Math::IncrementCoordinates> positions;
+    positions.reserve(voxels.size());
+    for (const auto& voxel : voxels) {
+        positions.push_back(voxel.position);
+    }
+    
+    // R * (p - pivot) + pivot + t folds into R * p + offset
+    Math::Vector3i offset = transform.translation;
+    if (transform.rotates) {
+        const auto& r = transform.rotation;
+        const Math::Vector3i& p = transform.pivot;
+        offset += p - Math::Vector3i(r[0] * p.x + r[1] * p.y + r[2] * p.z,
+                                     r[3] * p.x + r[4] * p.y + r[5] * p.z,
+                                     r[6] * p.x + r[7] * p.y + r[8] * p.z);
+    }
+    Math::VoxelMathSIMD::transformIncrementBatch(positions.data(), positions.data(), positions.size(),
+                                                 transform.rotates ? transform.rotation.data() : nullptr,
+                                                 offset);
+    
+    std::vector<VoxelId> result;
+    result.reserve(voxels.size());
+    for (size_t i = 0; i < voxels.size(); ++i) {
+        result.emplace_back(positions[i], voxels[i].resolution);
+    }
+    return result;
+}
+
+std::vector<VoxelData::VoxelPosition> toVoxelPositions(const std::vector<VoxelId>& voxels) {
+    std::vector<VoxelData::VoxelPosition> result;
+    result.reserve(voxels.size());
+    for (const auto& voxel : voxels) {
+        result.emplace_back(voxel.position, voxel.resolution);
+    }
+    return result;
+}
+
 Math::BoundingBox calculateBounds(const std::vector<VoxelId>& voxels) {
     if (voxels.empty()) {
         return Math::BoundingBox();
@@ -0,0 +1,152 @@
+#include "../include/groups/VoxelBrickSet.h"
+#include <array>
+#include <limits>
+
+namespace VoxelEditor {
+namespace Groups {
+
+namespace {
+
+constexpr uint32_t BRICK_CELLS = BrickCells::BRICK_CELLS;
+constexpr size_t RESOLUTION_COUNT = static_cast<size_t>(VoxelData::VoxelResolution::COUNT);
+
+}
+
+// VoxelBrickSet
+
+uint64_t VoxelBrickSet::brickKey(const VoxelId& voxel) {
+    return BrickCells::brickKey(static_cast<uint32_t>(voxel.resolution), voxel.position.value());
+}
+
+uint16_t VoxelBrickSet::cellIndex(const VoxelId& voxel) {
+    return BrickCells::cellIndex(voxel.position.value());
+}
+
+VoxelId VoxelBrickSet::voxelAt(uint64_t key, uint32_t cell) {
+    return VoxelId(Math::IncrementCoordinates(BrickCells::cellPosition(key, cell)), keyResolution(key));
+}
+
+bool VoxelBrickSet::insert(const VoxelId& voxel) {
+    if (!m_bricks[brickKey(voxel)].insert(cellIndex(voxel))) {
+        return false;
+    }
+    ++m_size;
+    return true;
+}
+
+bool VoxelBrickSet::erase(const VoxelId& voxel) {
+    auto it = m_bricks.find(brickKey(voxel));
+    if (it == m_bricks.end() || !it->second.erase(cellIndex(voxel))) {
+        return false;
+    }
+    if (it->second.empty()) {
+        m_bricks.erase(it);
+    }
+    --m_size;
+    return true;
+}
+
+bool VoxelBrickSet::contains(const VoxelId& voxel) const {
+    auto it = m_bricks.find(brickKey(voxel));
+    return it != m_bricks.end() && it->second.contains(cellIndex(voxel));
+}
+
+void VoxelBrickSet::clear() {
+    m_bricks.clear();
+    m_size = 0;
+}
+
+std::vector<VoxelId> VoxelBrickSet::toVector() const {
+    std::vector<VoxelId> result;
+    result.reserve(m_size);
+    for (const auto& [key, cells] : m_bricks) {
+        cells.forEach([&](uint16_t cell) {
+            result.push_back(voxelAt(key, cell));
+        });
+    }
+    return result;
+}
+
+Math::BoundingBox VoxelBrickSet::getBounds() const {
+    if (m_size == 0) {
+        return Math::BoundingBox();
+    }
+
+    // Extreme voxel positions per resolution, from brick extents
+    struct Extent {
+        Math::Vector3i min{std::numeric_limits<int>::max()};
+        Math::Vector3i max{std::numeric_limits<int>::lowest()};
+        bool any = false;
+    };
+    std::array<Extent, RESOLUTION_COUNT> extents;
+
+    for (const auto& [key, cells] : m_bricks) {
+        int lo[3], hi[3];
+        cells.getExtent(lo, hi);
+        VoxelId first = voxelAt(key, 0);
+        const Math::Vector3i& origin = first.position.value();
+        Extent& extent = extents[static_cast<size_t>(first.resolution)];
+        extent.min = Math::Vector3i::min(extent.min, origin + Math::Vector3i(lo[0], lo[1], lo[2]));
+        extent.max = Math::Vector3i::max(extent.max, origin + Math::Vector3i(hi[0], hi[1], hi[2]));
+        extent.any = true;
+    }
+
+    Math::BoundingBox bounds;
+    bool first = true;
+    for (size_t res = 0; res < RESOLUTION_COUNT; ++res) {
+        if (!extents[res].any) continue;
+        auto resolution = static_cast<VoxelData::VoxelResolution>(res);
+        Math::BoundingBox box(VoxelId(extents[res].min, resolution).getBounds().min,
+                              VoxelId(extents[res].max, resolution).getBounds().max);
+        if (first) {
+            bounds = box;
+            first = false;
+        } else {
+            bounds.expandToInclude(box);
+        }
+    }
+    return bounds;
+}
+
+size_t VoxelBrickSet::getMemoryUsage() const {
+    size_t bytes = hashMapMemory<BrickMap::value_type>(m_bricks.bucket_count(), m_bricks.size());
+    for (const auto& [key, cells] : m_bricks) {
+        bytes += cells.getMemoryUsage();
+    }
+    return bytes;
+}
+
+// Iterator
+
+VoxelBrickSet::const_iterator::const_iterator(BrickMap::const_iterator it, BrickMap::const_iterator end)
+    : m_it(it)
+    , m_end(end) {
+    settle();
+}
+
+VoxelBrickSet::const_iterator& VoxelBrickSet::const_iterator::operator++() {
+    ++m_cell;
+    settle();
+    return *this;
+}
+
+VoxelBrickSet::const_iterator VoxelBrickSet::const_iterator::operator++(int) {
+    const_iterator previous = *this;
+    ++(*this);
+    return previous;
+}
+
+void VoxelBrickSet::const_iterator::settle() {
+    while (m_it != m_end) {
+        m_cell = m_it->second.nextCell(m_cell);
+        if (m_cell < BRICK_CELLS) {
+            m_current = voxelAt(m_it->first, m_cell);
+            return;
+        }
+        ++m_it;
+        m_cell = 0;
+    }
+}
+
+} // namespace Groups
+} // namespace VoxelEditor
@@ -1,6 +1,5 @@
 #include "../include/groups/VoxelGroup.h"
 #include <algorithm>
-#include <limits>
 
 namespace VoxelEditor {
 namespace Groups {
@@ -19,8 +18,12 @@ void VoxelGroup::setName(const std::string& name) {
 
 void VoxelGroup::setMetadata(const GroupMetadata& metadata) {
     std::lock_guard<std::mutex> lock(m_mutex);
+    bool visibilityChanged = m_metadata.visible != metadata.visible;
     m_metadata = metadata;
     m_metadata.updateModified();
+    if (visibilityChanged) {
+        notifyChanged();
+    }
 }
 
 void VoxelGroup::setColor(const Rendering::Color& color) {
@@ -31,8 +34,12 @@ void VoxelGroup::setColor(const Rendering::Color& color) {
 
 void VoxelGroup::setVisible(bool visible) {
     std::lock_guard<std::mutex> lock(m_mutex);
+    bool changed = m_metadata.visible != visible;
     m_metadata.visible = visible;
     m_metadata.updateModified();
+    if (changed) {
+        notifyChanged();
+    }
 }
 
 void VoxelGroup::setOpacity(float opacity) {
@@ -49,39 +56,115 @@ void VoxelGroup::setLocked(bool locked) {
 
 bool VoxelGroup::addVoxel(const VoxelId& voxel) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    bool inserted = m_voxels.insert(voxel).second;
+    bool inserted = m_voxels.insert(voxel);
     if (inserted) {
-        m_boundsValid = false;
+        if (m_boundsValid) {
+            if (m_voxels.size() == 1) {
+                m_bounds = voxel.getBounds();
+            } else {
+                m_bounds.expandToInclude(voxel.getBounds());
+            }
+        }
+        if (m_islands) {
+            m_islands->setVoxel(voxel.position, voxel.resolution, true);
+        }
         m_metadata.updateModified();
+        notifyChanged();
     }
     return inserted;
 }
 
 bool VoxelGroup::removeVoxel(const VoxelId& voxel) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    bool removed = m_voxels.erase(voxel) > 0;
+    bool removed = m_voxels.erase(voxel);
     if (removed) {
-        m_boundsValid = false;
+        if (m_boundsValid) {
+            // Interior voxels leave the box unchanged
+            Math::BoundingBox box = voxel.getBounds();
+            if (m_voxels.empty() ||
+                box.min.x == m_bounds.min.x || box.min.y == m_bounds.min.y || box.min.z == m_bounds.min.z ||
+                box.max.x == m_bounds.max.x || box.max.y == m_bounds.max.y || box.max.z == m_bounds.max.z) {
+                m_boundsValid = false;
+            }
+        }
+        if (m_islands) {
+            m_islands->setVoxel(voxel.position, voxel.resolution, false);
+        }
         m_metadata.updateModified();
+        notifyChanged();
     }
     return removed;
 }
 
 bool VoxelGroup::containsVoxel(const VoxelId& voxel) const {
     std::lock_guard<std::mutex> lock(m_mutex);
-    return m_voxels.find(voxel) != m_voxels.end();
+    return m_voxels.contains(voxel);
 }
 
 void VoxelGroup::clearVoxels() {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_voxels.clear();
     m_boundsValid = false;
+    m_islands.reset();
+    m_metadata.updateModified();
+    notifyChanged();
+}
+
+void VoxelGroup::setVoxels(const std::vector<VoxelId>& voxels) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_voxels.clear();
+    for (const auto& voxel : voxels) {
+        m_voxels.insert(voxel);
+    }
+    m_boundsValid = false;
+    m_islands.reset();
     m_metadata.updateModified();
+    notifyChanged();
+}
+
+void VoxelGroup::setChangeCallback(ChangeCallback callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_onChanged = std::move(callback);
 }
 
 std::vector<VoxelId> VoxelGroup::getVoxelList() const {
     std::lock_guard<std::mutex> lock(m_mutex);
-    return std::vector<VoxelId>(m_voxels.begin(), m_voxels.end());
+    return m_voxels.toVector();
+}
+
+size_t VoxelGroup::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return sizeof(VoxelGroup) + m_metadata.name.capacity() + m_metadata.description.capacity() +
+           m_voxels.getMemoryUsage();
+}
+
+std::vector<std::vector<VoxelId>> VoxelGroup::getIslands() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::vector<VoxelId>> result;
+    for (const auto& component : islands().getComponents()) {
+        std::vector<VoxelId> island;
+        island.reserve(component.size());
+        for (const auto& voxel : component) {
+            island.emplace_back(voxel.incrementPos, voxel.resolution);
+        }
+        result.push_back(std::move(island));
+    }
+    return result;
+}
+
+size_t VoxelGroup::getIslandCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return islands().getComponentCount();
+}
+
+const VoxelData::VoxelConnectivity& VoxelGroup::islands() const {
+    if (!m_islands) {
+        m_islands = std::make_unique<VoxelData::VoxelConnectivity>();
+        for (const auto& voxel : m_voxels) {
+            m_islands->setVoxel(voxel.position, voxel.resolution, true);
+        }
+    }
+    return *m_islands;
 }
 
 Math::BoundingBox VoxelGroup::getBoundingBox() const {
@@ -106,7 +189,7 @@ void VoxelGroup::translate(const Math::WorldCoordinates& offset) {
     std::lock_guard<std::mutex> lock(m_mutex);
     
     // Create new voxel set with translated positions
-    std::unordered_set<VoxelId> newVoxels;
+    VoxelBrickSet newVoxels;
     for (const auto& voxel : m_voxels) {
         VoxelId newVoxel = voxel;
         
@@ -125,7 +208,9 @@ void VoxelGroup::translate(const Math::WorldCoordinates& offset) {
     
     m_voxels = std::move(newVoxels);
     m_boundsValid = false;
+    m_islands.reset();
     m_metadata.updateModified();
+    notifyChanged();
 }
 
 void VoxelGroup::rotate(const Math::Vector3f& eulerAngles, const Math::WorldCoordinates& pivot) {
@@ -162,29 +247,8 @@ GroupInfo VoxelGroup::getInfo() const {
 }
 
 void VoxelGroup::updateBounds() const {
-    if (m_voxels.empty()) {
-        m_bounds = Math::BoundingBox();
-        m_boundsValid = true;
-        return;
-    }
-    
-    Math::Vector3f minBound(std::numeric_limits<float>::max());
-    Math::Vector3f maxBound(std::numeric_limits<float>::lowest());
-    
-    for (const auto& voxel : m_voxels) {
-        // Use VoxelId's getBounds() method which properly handles centered coordinate system
-        Math::BoundingBox voxelBounds = voxel.getBounds();
-        
-        minBound.x = std::min(minBound.x, voxelBounds.min.x);
-        minBound.y = std::min(minBound.y, voxelBounds.min.y);
-        minBound.z = std::min(minBound.z, voxelBounds.min.z);
-        
-        maxBound.x = std::max(maxBound.x, voxelBounds.max.x);
-        maxBound.y = std::max(maxBound.y, voxelBounds.max.y);
-        maxBound.z = std::max(maxBound.z, voxelBounds.max.z);
-    }
-    
-    m_bounds = Math::BoundingBox(minBound, maxBound);
+    // Per-brick extents; only the two extreme voxels per resolution are converted
+    m_bounds = m_voxels.getBounds();
     m_boundsValid = true;
 }
 
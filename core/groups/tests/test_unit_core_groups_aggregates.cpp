@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include "../include/groups/GroupManager.h"
+#include "../include/groups/GroupAggregateTree.h"
+
+using namespace VoxelEditor::Groups;
+using namespace VoxelEditor::VoxelData;
+using VoxelEditor::Math::IncrementCoordinates;
+using VoxelEditor::Math::BoundingBox;
+
+namespace {
+
+VoxelId voxelAt(int x, int y, int z) {
+    return VoxelId(IncrementCoordinates(x, y, z), VoxelResolution::Size_1cm);
+}
+
+void expectSameBox(const BoundingBox& actual, const BoundingBox& expected) {
+    ASSERT_EQ(actual.isValid(), expected.isValid());
+    if (!expected.isValid()) return;
+    EXPECT_FLOAT_EQ(actual.min.x, expected.min.x);
+    EXPECT_FLOAT_EQ(actual.min.y, expected.min.y);
+    EXPECT_FLOAT_EQ(actual.min.z, expected.min.z);
+    EXPECT_FLOAT_EQ(actual.max.x, expected.max.x);
+    EXPECT_FLOAT_EQ(actual.max.y, expected.max.y);
+    EXPECT_FLOAT_EQ(actual.max.z, expected.max.z);
+}
+
+}
+
+class GroupAggregateTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        manager = std::make_unique<GroupManager>(nullptr, nullptr);
+        parent = manager->createGroup("Parent", {voxelAt(0, 0, 0)});
+        childA = manager->createGroup("A", {voxelAt(10, 0, 0), voxelAt(11, 0, 0)});
+        childB = manager->createGroup("B", {voxelAt(-5, 3, 0)});
+        ASSERT_TRUE(manager->setParentGroup(childA, parent));
+        ASSERT_TRUE(manager->setParentGroup(childB, parent));
+    }
+
+    std::unique_ptr<GroupManager> manager;
+    GroupId parent = INVALID_GROUP_ID;
+    GroupId childA = INVALID_GROUP_ID;
+    GroupId childB = INVALID_GROUP_ID;
+};
+
+TEST_F(GroupAggregateTest, SubtreeTotals) {
+    auto aggregate = manager->getHierarchyAggregate(parent);
+    EXPECT_EQ(aggregate.groupCount, 3u);
+    EXPECT_EQ(aggregate.voxelCount, 4u);
+    EXPECT_EQ(aggregate.visibleVoxelCount, 4u);
+    expectSameBox(aggregate.bounds, BoundingBox(voxelAt(-5, 0, 0).getBounds().min,
+                                                voxelAt(11, 3, 0).getBounds().max));
+
+    EXPECT_EQ(manager->getHierarchyAggregate(childA).voxelCount, 2u);
+    EXPECT_EQ(manager->getTotalVoxelCount(), 4u);
+    expectSameBox(manager->getGroupsBounds(), aggregate.bounds);
+}
+
+TEST_F(GroupAggregateTest, FollowsMembershipEdits) {
+    ASSERT_TRUE(manager->addVoxelToGroup(childB, voxelAt(0, 20, 0)));
+    EXPECT_EQ(manager->getHierarchyAggregate(parent).voxelCount, 5u);
+    EXPECT_FLOAT_EQ(manager->getHierarchyBounds(parent).max.y, voxelAt(0, 20, 0).getBounds().max.y);
+
+    // Removing the voxel on the boundary shrinks every level
+    ASSERT_TRUE(manager->removeVoxelFromGroup(childA, voxelAt(11, 0, 0)));
+    EXPECT_FLOAT_EQ(manager->getHierarchyBounds(parent).max.x, voxelAt(10, 0, 0).getBounds().max.x);
+    EXPECT_FLOAT_EQ(manager->getGroupBounds(childA).max.x, voxelAt(10, 0, 0).getBounds().max.x);
+
+    // Edits made straight on the group are picked up too
+    manager->getGroup(childA)->addVoxel(voxelAt(30, 0, 0));
+    EXPECT_EQ(manager->getTotalVoxelCount(), 5u);
+    EXPECT_FLOAT_EQ(manager->getGroupsBounds().max.x, voxelAt(30, 0, 0).getBounds().max.x);
+}
+
+TEST_F(GroupAggregateTest, FollowsHierarchyAndVisibility) {
+    manager->hideGroup(childA);
+    auto aggregate = manager->getHierarchyAggregate(parent);
+    EXPECT_EQ(aggregate.voxelCount, 4u);
+    EXPECT_EQ(aggregate.visibleVoxelCount, 2u);
+    EXPECT_FLOAT_EQ(aggregate.visibleBounds.max.x, voxelAt(0, 0, 0).getBounds().max.x);
+    EXPECT_FLOAT_EQ(manager->getVisibleGroupsBounds().max.x, voxelAt(0, 0, 0).getBounds().max.x);
+    manager->showGroup(childA);
+    EXPECT_EQ(manager->getHierarchyAggregate(parent).visibleVoxelCount, 4u);
+
+    // Reparent B under A
+    ASSERT_TRUE(manager->setParentGroup(childB, childA));
+    EXPECT_EQ(manager->getHierarchyAggregate(childA).voxelCount, 3u);
+    EXPECT_EQ(manager->getHierarchyAggregate(parent).voxelCount, 4u);
+
+    // Deleting the parent leaves A (with B) as a root
+    ASSERT_TRUE(manager->deleteGroup(parent));
+    EXPECT_EQ(manager->getHierarchyAggregate(parent).groupCount, 0u);
+    EXPECT_EQ(manager->getHierarchyAggregate(childA).groupCount, 2u);
+    EXPECT_EQ(manager->getTotalVoxelCount(), 3u);
+    EXPECT_FLOAT_EQ(manager->getGroupsBounds().min.x, voxelAt(-5, 0, 0).getBounds().min.x);
+}
+
+TEST(GroupAggregateTreeTest, MatchesRecomputedTotals) {
+    GroupManager manager(nullptr, nullptr);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> coord(-60, 60);
+    std::vector<GroupId> groups;
+    for (int i = 0; i < 12; ++i) {
+        groups.push_back(manager.createGroup("G" + std::to_string(i)));
+        if (i > 0) {
+            manager.setParentGroup(groups[i], groups[rng() % i]);
+        }
+    }
+
+    for (int step = 0; step < 2000; ++step) {
+        GroupId id = groups[rng() % groups.size()];
+        VoxelId voxel = voxelAt(coord(rng), coord(rng) + 60, coord(rng));
+        if (rng() % 3 == 0) {
+            auto voxels = manager.getGroupVoxels(id);
+            if (!voxels.empty()) {
+                manager.removeVoxelFromGroup(id, voxels[rng() % voxels.size()]);
+            }
+        } else {
+            manager.addVoxelToGroup(id, voxel);
+        }
+
+        if (step % 100 == 0) {
+            size_t total = 0;
+            BoundingBox bounds;
+            for (GroupId group : groups) {
+                for (const auto& v : manager.getGroupVoxels(group)) {
+                    bounds.expandToInclude(v.getBounds());
+                    ++total;
+                }
+            }
+            EXPECT_EQ(manager.getTotalVoxelCount(), total);
+            expectSameBox(manager.getGroupsBounds(), bounds);
+            expectSameBox(manager.getHierarchyBounds(groups[0]), bounds);
+        }
+    }
+}
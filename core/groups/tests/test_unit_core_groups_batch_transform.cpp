@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include "../include/groups/GroupOperations.h"
+#include "../include/groups/GroupManager.h"
+#include "../include/groups/VoxelGroup.h"
+
+using namespace VoxelEditor::Groups;
+namespace Math = VoxelEditor::Math;
+using namespace VoxelEditor::VoxelData;
+using VoxelEditor::Math::IncrementCoordinates;
+using VoxelEditor::Math::Vector3f;
+using VoxelEditor::Math::Vector3i;
+
+class GroupBatchTransformTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        voxelManager = std::make_unique<VoxelDataManager>();
+        voxelManager->resizeWorkspace(5.0f);
+        groupManager = std::make_unique<GroupManager>(voxelManager.get(), nullptr);
+    }
+
+    // Places the voxels and groups them
+    GroupId createGroup(const std::vector<VoxelId>& voxels) {
+        auto result = voxelManager->replaceVoxels({}, GroupOperationUtils::toVoxelPositions(voxels));
+        EXPECT_TRUE(result.success) << result.errorMessage;
+        return groupManager->createGroup("Batch", voxels);
+    }
+
+    bool hasVoxel(const VoxelId& voxel) const {
+        return voxelManager->getVoxel(voxel.position, voxel.resolution);
+    }
+
+    std::unique_ptr<VoxelDataManager> voxelManager;
+    std::unique_ptr<GroupManager> groupManager;
+};
+
+TEST_F(GroupBatchTransformTest, MoveAndUndo) {
+    auto res = VoxelResolution::Size_4cm;
+    std::vector<VoxelId> voxels;
+    for (int x = 0; x < 40; x += 4) {
+        voxels.emplace_back(IncrementCoordinates(x, 0, 0), res);
+    }
+    GroupId id = createGroup(voxels);
+
+    // Overlaps its own footprint, which does not count as a collision
+    MoveGroupOperation move(groupManager.get(), voxelManager.get(), id,
+                            Math::WorldCoordinates(Vector3f(0.08f, 0.04f, 0.0f)));
+    ASSERT_TRUE(move.execute());
+    EXPECT_EQ(voxelManager->getTotalVoxelCount(), voxels.size());
+    for (const auto& voxel : voxels) {
+        VoxelId moved(voxel.position.value() + Vector3i(8, 4, 0), res);
+        EXPECT_TRUE(hasVoxel(moved));
+        EXPECT_TRUE(groupManager->getGroup(id)->containsVoxel(moved));
+    }
+    EXPECT_FALSE(hasVoxel(voxels.front()));
+
+    ASSERT_TRUE(move.undo());
+    EXPECT_EQ(voxelManager->getTotalVoxelCount(), voxels.size());
+    for (const auto& voxel : voxels) {
+        EXPECT_TRUE(hasVoxel(voxel));
+        EXPECT_TRUE(groupManager->getGroup(id)->containsVoxel(voxel));
+    }
+}
+
+TEST_F(GroupBatchTransformTest, MoveRejectsCollisionsAndBounds) {
+    auto res = VoxelResolution::Size_4cm;
+    std::vector<VoxelId> voxels = {VoxelId(IncrementCoordinates(0, 0, 0), res),
+                                   VoxelId(IncrementCoordinates(4, 0, 0), res)};
+    GroupId id = createGroup(voxels);
+    ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(44, 0, 0), res, true));
+
+    MoveGroupOperation blocked(groupManager.get(), voxelManager.get(), id,
+                               Math::WorldCoordinates(Vector3f(0.4f, 0.0f, 0.0f)));
+    EXPECT_FALSE(blocked.execute());
+
+    MoveGroupOperation outside(groupManager.get(), voxelManager.get(), id,
+                               Math::WorldCoordinates(Vector3f(0.0f, -0.04f, 0.0f)));
+    EXPECT_FALSE(outside.execute());
+
+    // Nothing changed
+    EXPECT_EQ(voxelManager->getTotalVoxelCount(), 3u);
+    for (const auto& voxel : voxels) {
+        EXPECT_TRUE(hasVoxel(voxel));
+        EXPECT_TRUE(groupManager->getGroup(id)->containsVoxel(voxel));
+    }
+}
+
+TEST_F(GroupBatchTransformTest, QuarterTurnsMatchFloatRotation) {
+    // Reference: RotateGroupOperation's float path, Z then Y then X
+    auto rotate = [](Vector3f p, const Vector3f& angles) {
+        float x = p.x * std::cos(angles.z) - p.y * std::sin(angles.z);
+        float y = p.x * std::sin(angles.z) + p.y * std::cos(angles.z);
+        p.x = x; p.y = y;
+        x = p.x * std::cos(angles.y) + p.z * std::sin(angles.y);
+        float z = -p.x * std::sin(angles.y) + p.z * std::cos(angles.y);
+        p.x = x; p.z = z;
+        y = p.y * std::cos(angles.x) - p.z * std::sin(angles.x);
+        z = p.y * std::sin(angles.x) + p.z * std::cos(angles.x);
+        p.y = y; p.z = z;
+        return p;
+    };
+
+    const float h = Math::HALF_PI;
+    const Vector3f angleSets[] = {
+        Vector3f(0, h, 0), Vector3f(h, 0, 0), Vector3f(0, 0, -h),
+        Vector3f(h, h, 0), Vector3f(-h, 2 * h, h), Vector3f(3 * h, -h, 2 * h)
+    };
+    Math::WorldCoordinates pivot(Vector3f(0.12f, 0.5f, -0.2f));
+
+    std::vector<VoxelId> voxels;
+    for (int i = 0; i < 37; ++i) {
+        voxels.emplace_back(IncrementCoordinates(i * 3 - 50, (i * 7) % 40, 20 - i * 5), VoxelResolution::Size_1cm);
+    }
+
+    for (const auto& angles : angleSets) {
+        GroupOperationUtils::LatticeTransform lattice;
+        ASSERT_TRUE(GroupOperationUtils::makeLatticeTransform(Math::WorldCoordinates::zero(), angles, pivot, lattice));
+        auto rotated = GroupOperationUtils::transformVoxels(voxels, lattice);
+        ASSERT_EQ(rotated.size(), voxels.size());
+        for (size_t i = 0; i < voxels.size(); ++i) {
+            Vector3f rel = voxels[i].getWorldPosition().value() - pivot.value();
+            Vector3f expected = rotate(rel, angles) + pivot.value();
+            EXPECT_EQ(rotated[i].position,
+                      Math::CoordinateConverter::worldToIncrement(Math::WorldCoordinates(expected)));
+        }
+    }
+
+    GroupOperationUtils::LatticeTransform lattice;
+    EXPECT_FALSE(GroupOperationUtils::makeLatticeTransform(Math::WorldCoordinates::zero(),
+                                                           Vector3f(0, 0.3f, 0), pivot, lattice));
+    EXPECT_FALSE(GroupOperationUtils::makeLatticeTransform(Math::WorldCoordinates(Vector3f(0.005f, 0, 0)),
+                                                           Vector3f(0, 0, 0), pivot, lattice));
+}
+
+TEST_F(GroupBatchTransformTest, RotateAboutPivot) {
+    auto res = VoxelResolution::Size_4cm;
+    std::vector<VoxelId> voxels = {VoxelId(IncrementCoordinates(8, 0, 0), res),
+                                   VoxelId(IncrementCoordinates(16, 0, 0), res)};
+    GroupId id = createGroup(voxels);
+
+    RotateGroupOperation rotate(groupManager.get(), voxelManager.get(), id,
+                                Vector3f(0, Math::HALF_PI, 0), Math::WorldCoordinates::zero());
+    ASSERT_TRUE(rotate.execute());
+    EXPECT_TRUE(hasVoxel(VoxelId(IncrementCoordinates(0, 0, -8), res)));
+    EXPECT_TRUE(hasVoxel(VoxelId(IncrementCoordinates(0, 0, -16), res)));
+    EXPECT_FALSE(hasVoxel(voxels[0]));
+    EXPECT_EQ(groupManager->getGroup(id)->getVoxelCount(), 2u);
+
+    ASSERT_TRUE(rotate.undo());
+    EXPECT_TRUE(hasVoxel(voxels[0]));
+    EXPECT_TRUE(hasVoxel(voxels[1]));
+    EXPECT_EQ(voxelManager->getTotalVoxelCount(), 2u);
+}
+
+TEST_F(GroupBatchTransformTest, CopyAndScale) {
+    auto res = VoxelResolution::Size_4cm;
+    GroupId id = createGroup({VoxelId(IncrementCoordinates(0, 0, 0), res)});
+
+    CopyGroupOperation copy(groupManager.get(), voxelManager.get(), id, "Copy",
+                            Math::WorldCoordinates(Vector3f(0.2f, 0.0f, 0.0f)));
+    ASSERT_TRUE(copy.execute());
+    EXPECT_TRUE(hasVoxel(VoxelId(IncrementCoordinates(0, 0, 0), res)));
+    EXPECT_TRUE(hasVoxel(VoxelId(IncrementCoordinates(20, 0, 0), res)));
+    EXPECT_EQ(groupManager->getGroup(copy.getCreatedGroupId())->getVoxelCount(), 1u);
+    ASSERT_TRUE(copy.undo());
+    EXPECT_EQ(voxelManager->getTotalVoxelCount(), 1u);
+
+    // Each voxel becomes a 2x2x2 block growing away from the pivot
+    ScaleGroupOperation scale(groupManager.get(), voxelManager.get(), id, 2.0f, Math::WorldCoordinates::zero());
+    ASSERT_TRUE(scale.execute());
+    EXPECT_EQ(voxelManager->getTotalVoxelCount(), 8u);
+    EXPECT_TRUE(hasVoxel(VoxelId(IncrementCoordinates(4, 4, 4), res)));
+    EXPECT_EQ(groupManager->getGroup(id)->getVoxelCount(), 8u);
+    ASSERT_TRUE(scale.undo());
+    EXPECT_EQ(voxelManager->getTotalVoxelCount(), 1u);
+    EXPECT_TRUE(hasVoxel(VoxelId(IncrementCoordinates(0, 0, 0), res)));
+}
+
+TEST_F(GroupBatchTransformTest, LargeMoveIsOneBatch) {
+    auto res = VoxelResolution::Size_2cm;
+    std::vector<VoxelId> voxels;
+    for (int x = 0; x < 80; ++x) {
+        for (int y = 0; y < 40; ++y) {
+            for (int z = 0; z < 40; ++z) {
+                voxels.emplace_back(IncrementCoordinates(x * 2 - 80, y * 2, z * 2 - 40), res);
+            }
+        }
+    }
+    GroupId id = createGroup(voxels);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    MoveGroupOperation move(groupManager.get(), voxelManager.get(), id,
+                            Math::WorldCoordinates(Vector3f(0.5f, 0.1f, 0.0f)));
+    ASSERT_TRUE(move.execute());
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    EXPECT_EQ(voxelManager->getTotalVoxelCount(), voxels.size());
+    EXPECT_TRUE(hasVoxel(VoxelId(IncrementCoordinates(-30, 10, -40), res)));
+    EXPECT_FALSE(hasVoxel(voxels.front()));
+    // Per-voxel validation made this quadratic
+    EXPECT_LT(duration.count(), 5000);
+}
@@ -444,4 +444,29 @@ TEST_F(GroupManagerTest, Validation) {
     
     // Note: Testing invalid states would require manipulating internal state
     // which is not easily accessible through the public interface
-}
\ No newline at end of file
+}
+
+TEST_F(GroupManagerTest, SplitGroupIntoIslands) {
+    auto res = VoxelResolution::Size_4cm;
+    std::vector<VoxelId> voxels;
+    for (int x = 0; x < 16; x += 4) {
+        voxels.emplace_back(Vector3i(x, 0, 0), res);
+    }
+    voxels.emplace_back(Vector3i(40, 0, 0), res);
+    voxels.emplace_back(Vector3i(40, 40, 0), res);
+    
+    GroupId id = groupManager->createGroup("Pieces", voxels);
+    std::vector<GroupId> created = groupManager->splitGroupIntoIslands(id);
+    ASSERT_EQ(created.size(), 2u);
+    
+    // Largest island stays in the source group
+    ASSERT_NE(groupManager->getGroup(id), nullptr);
+    EXPECT_EQ(groupManager->getGroup(id)->getVoxelCount(), 4u);
+    for (GroupId newId : created) {
+        ASSERT_NE(groupManager->getGroup(newId), nullptr);
+        EXPECT_EQ(groupManager->getGroup(newId)->getVoxelCount(), 1u);
+    }
+    
+    // Already one piece
+    EXPECT_TRUE(groupManager->splitGroupIntoIslands(id).empty());
+}
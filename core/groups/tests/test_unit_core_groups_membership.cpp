@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+#include "../include/groups/VoxelBrickSet.h"
+#include "../include/groups/GroupMembershipIndex.h"
+#include "../include/groups/GroupManager.h"
+
+using namespace VoxelEditor::Groups;
+using namespace VoxelEditor::VoxelData;
+using VoxelEditor::Math::IncrementCoordinates;
+using VoxelEditor::Math::Vector3f;
+
+TEST(VoxelBrickSetTest, InsertEraseAcrossBricksAndSigns) {
+    VoxelBrickSet set;
+    std::vector<VoxelId> voxels = {
+        VoxelId(IncrementCoordinates(0, 0, 0), VoxelResolution::Size_1cm),
+        VoxelId(IncrementCoordinates(-1, 0, -17), VoxelResolution::Size_1cm),
+        VoxelId(IncrementCoordinates(15, 16, 31), VoxelResolution::Size_1cm),
+        VoxelId(IncrementCoordinates(0, 0, 0), VoxelResolution::Size_4cm),
+        VoxelId(IncrementCoordinates(-400, 799, 400), VoxelResolution::Size_8cm)
+    };
+    for (const auto& voxel : voxels) {
+        EXPECT_TRUE(set.insert(voxel));
+        EXPECT_FALSE(set.insert(voxel));
+    }
+    EXPECT_EQ(set.size(), voxels.size());
+
+    // Same position at another resolution is a different voxel
+    EXPECT_TRUE(set.contains(voxels[3]));
+    EXPECT_FALSE(set.contains(VoxelId(IncrementCoordinates(0, 0, 0), VoxelResolution::Size_2cm)));
+
+    std::vector<VoxelId> iterated(set.begin(), set.end());
+    EXPECT_EQ(iterated.size(), voxels.size());
+    for (const auto& voxel : voxels) {
+        EXPECT_NE(std::find(iterated.begin(), iterated.end(), voxel), iterated.end());
+    }
+
+    EXPECT_TRUE(set.erase(voxels[1]));
+    EXPECT_FALSE(set.erase(voxels[1]));
+    EXPECT_FALSE(set.contains(voxels[1]));
+    EXPECT_EQ(set.size(), voxels.size() - 1);
+}
+
+TEST(VoxelBrickSetTest, DenseBricksMatchReference) {
+    VoxelBrickSet set;
+    std::unordered_set<VoxelId> reference;
+    for (int x = -20; x < 20; ++x) {
+        for (int y = 0; y < 20; ++y) {
+            for (int z = -3; z < 9; ++z) {
+                VoxelId voxel(IncrementCoordinates(x, y, z), VoxelResolution::Size_1cm);
+                set.insert(voxel);
+                reference.insert(voxel);
+            }
+        }
+    }
+    // Thin the bricks back out so some drop below the array threshold
+    for (int x = -20; x < 20; x += 2) {
+        for (int y = 0; y < 20; ++y) {
+            for (int z = -3; z < 9; ++z) {
+                VoxelId voxel(IncrementCoordinates(x, y, z), VoxelResolution::Size_1cm);
+                EXPECT_TRUE(set.erase(voxel));
+                reference.erase(voxel);
+            }
+        }
+    }
+
+    EXPECT_EQ(set.size(), reference.size());
+    size_t visited = 0;
+    for (const auto& voxel : set) {
+        EXPECT_TRUE(reference.count(voxel));
+        ++visited;
+    }
+    EXPECT_EQ(visited, reference.size());
+}
+
+TEST(VoxelBrickSetTest, BoundsMatchPerVoxelBounds) {
+    VoxelBrickSet set;
+    std::vector<VoxelId> voxels = {
+        VoxelId(IncrementCoordinates(-37, 5, 12), VoxelResolution::Size_1cm),
+        VoxelId(IncrementCoordinates(20, 40, -8), VoxelResolution::Size_1cm),
+        VoxelId(IncrementCoordinates(96, 0, 0), VoxelResolution::Size_32cm)
+    };
+    for (const auto& voxel : voxels) {
+        set.insert(voxel);
+    }
+
+    auto bounds = set.getBounds();
+    EXPECT_FLOAT_EQ(bounds.min.x, voxels[0].getBounds().min.x);
+    EXPECT_FLOAT_EQ(bounds.min.y, voxels[2].getBounds().min.y);
+    EXPECT_FLOAT_EQ(bounds.min.z, voxels[1].getBounds().min.z);
+    EXPECT_FLOAT_EQ(bounds.max.x, voxels[2].getBounds().max.x);
+    EXPECT_FLOAT_EQ(bounds.max.y, voxels[1].getBounds().max.y);
+    EXPECT_FLOAT_EQ(bounds.max.z, voxels[2].getBounds().max.z);
+}
+
+TEST(GroupMembershipIndexTest, SharedBricksAndGroupRemoval) {
+    GroupMembershipIndex index;
+    VoxelId a(IncrementCoordinates(1, 2, 3), VoxelResolution::Size_1cm);
+    VoxelId b(IncrementCoordinates(2, 2, 3), VoxelResolution::Size_1cm);
+
+    EXPECT_TRUE(index.add(1, a));
+    EXPECT_TRUE(index.add(2, a));
+    EXPECT_TRUE(index.add(2, b));
+    EXPECT_FALSE(index.add(2, b));
+    EXPECT_EQ(index.size(), 3u);
+    EXPECT_EQ(index.getBrickCount(), 1u);
+
+    EXPECT_EQ(index.findGroups(a), (std::vector<GroupId>{1, 2}));
+    EXPECT_EQ(index.findFirstGroup(b), 2u);
+
+    index.removeGroup(2);
+    EXPECT_EQ(index.findGroups(a), (std::vector<GroupId>{1}));
+    EXPECT_EQ(index.findFirstGroup(b), INVALID_GROUP_ID);
+    EXPECT_EQ(index.size(), 1u);
+
+    EXPECT_TRUE(index.remove(1, a));
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.getBrickCount(), 0u);
+}
+
+// Removing a group only touches its own bricks and leaves the others intact
+TEST(GroupMembershipIndexTest, RemoveGroupAcrossBricks) {
+    GroupMembershipIndex index;
+    VoxelBrickSet spread;
+    for (int x = 0; x < 200; x += 8) {
+        spread.insert(VoxelId(IncrementCoordinates(x, 0, 0), VoxelResolution::Size_1cm));
+    }
+    index.addGroup(1, spread);
+    VoxelId shared(IncrementCoordinates(64, 0, 0), VoxelResolution::Size_1cm);
+    VoxelId alone(IncrementCoordinates(0, 500, 0), VoxelResolution::Size_1cm);
+    EXPECT_TRUE(index.add(2, shared));
+    EXPECT_TRUE(index.add(2, alone));
+    size_t bricks = index.getBrickCount();
+
+    // Emptying a brick by single removals drops it from the group's bricks
+    EXPECT_TRUE(index.remove(2, alone));
+    EXPECT_TRUE(index.add(2, alone));
+
+    index.removeGroup(1);
+    index.removeGroup(7);
+    EXPECT_EQ(index.size(), 2u);
+    EXPECT_EQ(index.getBrickCount(), 2u);
+    EXPECT_EQ(index.findGroups(shared), (std::vector<GroupId>{2}));
+    EXPECT_LT(index.getBrickCount(), bricks);
+
+    index.removeGroup(2);
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.getBrickCount(), 0u);
+
+    index.addGroup(1, spread);
+    EXPECT_EQ(index.size(), spread.size());
+}
+
+TEST(GroupMembershipTest, ManagerLookupsFollowEdits) {
+    GroupManager manager(nullptr, nullptr);
+    std::vector<VoxelId> voxels;
+    for (int x = 0; x < 40; ++x) {
+        voxels.emplace_back(IncrementCoordinates(x, 0, 0), VoxelResolution::Size_1cm);
+    }
+    GroupId first = manager.createGroup("First", voxels);
+    GroupId second = manager.createGroup("Second", {voxels[5]});
+
+    EXPECT_EQ(manager.findGroupContaining(voxels[0]), first);
+    EXPECT_EQ(manager.findGroupsContaining(voxels[5]), (std::vector<GroupId>{first, second}));
+    EXPECT_TRUE(manager.validateGroups());
+
+    std::vector<VoxelId> moved;
+    for (const auto& voxel : voxels) {
+        moved.emplace_back(voxel.position.value() + VoxelEditor::Math::Vector3i(0, 100, 0), voxel.resolution);
+    }
+    EXPECT_TRUE(manager.setGroupVoxels(first, moved));
+    EXPECT_EQ(manager.findGroupContaining(voxels[0]), INVALID_GROUP_ID);
+    EXPECT_EQ(manager.findGroupContaining(moved[0]), first);
+    EXPECT_EQ(manager.findGroupsContaining(voxels[5]), (std::vector<GroupId>{second}));
+    EXPECT_TRUE(manager.validateGroups());
+
+    EXPECT_TRUE(manager.deleteGroup(first));
+    EXPECT_EQ(manager.findGroupContaining(moved[0]), INVALID_GROUP_ID);
+    EXPECT_TRUE(manager.validateGroups());
+}
+
+TEST(GroupMembershipTest, LargeGroupStaysCompact) {
+    GroupManager manager(nullptr, nullptr);
+    std::vector<VoxelId> voxels;
+    for (int x = 0; x < 64; ++x) {
+        for (int y = 0; y < 64; ++y) {
+            for (int z = 0; z < 64; ++z) {
+                voxels.emplace_back(IncrementCoordinates(x, y, z), VoxelResolution::Size_1cm);
+            }
+        }
+    }
+    GroupId id = manager.createGroup("Solid", voxels);
+
+    auto stats = manager.getStatistics();
+    EXPECT_EQ(stats.totalVoxels, voxels.size());
+    // A hash set node and a map entry per voxel took well over 64 bytes
+    EXPECT_LT(stats.memoryUsage, voxels.size());
+
+    auto bounds = manager.getGroupBounds(id);
+    EXPECT_FLOAT_EQ(bounds.min.x, voxels.front().getBounds().min.x);
+    EXPECT_FLOAT_EQ(bounds.max.y, voxels.back().getBounds().max.y);
+    EXPECT_EQ(manager.getGroupVoxels(id).size(), voxels.size());
+    EXPECT_EQ(manager.findGroupContaining(voxels[12345]), id);
+}
@@ -322,4 +322,27 @@ TEST_F(VoxelGroupTest, DifferentResolutions) {
     // Should handle different resolutions properly
     auto bounds = group->getBoundingBox();
     // Implementation should handle mixed resolutions correctly
-}
\ No newline at end of file
+}
+
+TEST_F(VoxelGroupTest, IslandsFollowMembership) {
+    auto res = VoxelResolution::Size_4cm;
+    for (int x = 0; x < 20; x += 4) {
+        group->addVoxel(VoxelId(Vector3i(x, 0, 0), res));
+    }
+    group->addVoxel(VoxelId(Vector3i(40, 0, 0), res));
+    EXPECT_EQ(group->getIslandCount(), 2u);
+    
+    // Bridging the gap joins them
+    for (int x = 20; x < 40; x += 4) {
+        group->addVoxel(VoxelId(Vector3i(x, 0, 0), res));
+    }
+    EXPECT_EQ(group->getIslandCount(), 1u);
+    
+    group->removeVoxel(VoxelId(Vector3i(8, 0, 0), res));
+    auto islands = group->getIslands();
+    ASSERT_EQ(islands.size(), 2u);
+    EXPECT_EQ(islands[0].size() + islands[1].size(), group->getVoxelCount());
+    
+    group->clearVoxels();
+    EXPECT_EQ(group->getIslandCount(), 0u);
+}
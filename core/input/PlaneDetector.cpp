@@ -129,24 +129,22 @@ std::vector<Math::IncrementCoordinates> PlaneDetector::getVoxelsAtHeight(float h
         return voxelsAtHeight;
     }
     
-    // OPTIMIZED APPROACH: Iterate through existing voxels instead of searching empty space
-    // This is O(n) where n is the number of actual voxels, not O(space * resolutions)
-    
     // Use a set to avoid duplicates when checking multiple resolutions
     std::set<Math::IncrementCoordinates> uniqueVoxelsAtHeight;
     
-    // Only check resolutions that actually have voxels
+    // A voxel's top is its bottom plus its size, so each resolution only has
+    // to read the layers whose bottom falls in the shifted tolerance band
     for (auto resolution : getAllResolutions()) {
         // Skip resolutions with no voxels
         if (m_voxelManager->getVoxelCount(resolution) == 0) {
             continue;
         }
         
-        // Get all voxels of this resolution
-        auto voxelsOfResolution = m_voxelManager->getAllVoxels(resolution);
+        float voxelSizeCm = VoxelData::getVoxelSize(resolution) * Math::CoordinateConverter::METERS_TO_CM;
+        int minBottom = static_cast<int>(std::ceil((height - tolerance) * Math::CoordinateConverter::METERS_TO_CM - voxelSizeCm - HEIGHT_EPSILON_CM));
+        int maxBottom = static_cast<int>(std::floor((height + tolerance) * Math::CoordinateConverter::METERS_TO_CM - voxelSizeCm + HEIGHT_EPSILON_CM));
         
-        // Check each voxel's top height
-        for (const auto& voxelPos : voxelsOfResolution) {
+        for (const auto& voxelPos : m_voxelManager->getVoxelsWithBottomIn(resolution, minBottom, maxBottom)) {
             float voxelTopHeight = calculateVoxelTopHeight(voxelPos.incrementPos, voxelPos.resolution);
             
             // Check if this voxel's top is at the target height (within tolerance)
@@ -191,12 +189,18 @@ std::vector<Math::IncrementCoordinates> PlaneDetector::searchVoxelsInCylinder(co
         return voxels;
     }
     
-    // OPTIMIZED APPROACH: Iterate through existing voxels and filter by cylinder bounds
-    // This is O(n) where n is the number of actual voxels, not O(space)
-    
     // Convert to increment coordinates for comparison
     Math::IncrementCoordinates centerIncrement = Math::CoordinateConverter::worldToIncrement(Math::WorldCoordinates(centerPos));
-    int radiusIncrementSquared = static_cast<int>(radius * Math::CoordinateConverter::METERS_TO_CM) * static_cast<int>(radius * Math::CoordinateConverter::METERS_TO_CM);
+    int radiusIncrements = static_cast<int>(radius * Math::CoordinateConverter::METERS_TO_CM);
+    int radiusIncrementSquared = radiusIncrements * radiusIncrements;
+    
+    // The cylinder's bounding box, so only overlapping octree branches are read
+    Math::IncrementCoordinates minPos(centerIncrement.x() - radiusIncrements,
+                                      static_cast<int>(std::ceil(minHeight * Math::CoordinateConverter::METERS_TO_CM - HEIGHT_EPSILON_CM)),
+                                      centerIncrement.z() - radiusIncrements);
+    Math::IncrementCoordinates maxPos(centerIncrement.x() + radiusIncrements,
+                                      static_cast<int>(std::floor(maxHeight * Math::CoordinateConverter::METERS_TO_CM + HEIGHT_EPSILON_CM)),
+                                      centerIncrement.z() + radiusIncrements);
     
     // Use a set to avoid duplicate positions
     std::set<Math::IncrementCoordinates> uniqueVoxels;
@@ -208,22 +212,9 @@ std::vector<Math::IncrementCoordinates> PlaneDetector::searchVoxelsInCylinder(co
             continue;
         }
         
-        // Get all voxels of this resolution
-        auto voxelsOfResolution = m_voxelManager->getAllVoxels(resolution);
-        
-        // Filter voxels that are within the cylinder
-        for (const auto& voxelPos : voxelsOfResolution) {
+        for (const auto& voxelPos : m_voxelManager->getVoxelsInRange(resolution, minPos, maxPos)) {
             const Math::IncrementCoordinates& pos = voxelPos.incrementPos;
             
-            // Convert to world coordinates for height check
-            Math::WorldCoordinates worldCoords = Math::CoordinateConverter::incrementToWorld(pos);
-            float worldY = worldCoords.value().y;
-            
-            // Check height bounds
-            if (worldY < minHeight || worldY > maxHeight) {
-                continue;
-            }
-            
             // Check cylinder radius (using squared distance to avoid sqrt)
             int dx = pos.x() - centerIncrement.x();
             int dz = pos.z() - centerIncrement.z();
@@ -288,37 +279,18 @@ std::optional<PlaneDetector::VoxelInfo> PlaneDetector::findHighestVoxelAtPositio
         return highestVoxel;
     }
     
-    // OPTIMIZED APPROACH: Check existing voxels instead of searching empty space
-    // Only check resolutions that actually have voxels
+    // Each resolution answers from its column index: only the tiles whose
+    // voxels could cover (x, z) are looked at, whatever the scene size
     for (auto resolution : getAllResolutions()) {
-        // Skip resolutions with no voxels
-        if (m_voxelManager->getVoxelCount(resolution) == 0) {
+        Math::IncrementCoordinates pos;
+        if (!m_voxelManager->findHighestVoxelAt(resolution, x, z, pos)) {
             continue;
         }
         
-        float voxelSize = VoxelData::getVoxelSize(resolution);
-        int voxelSizeIncrements = static_cast<int>(voxelSize * Math::CoordinateConverter::METERS_TO_CM);
-        
-        // Get all voxels of this resolution
-        auto voxelsOfResolution = m_voxelManager->getAllVoxels(resolution);
-        
-        // Check each voxel to see if it contains the query point (x,z)
-        for (const auto& voxelPos : voxelsOfResolution) {
-            const Math::IncrementCoordinates& pos = voxelPos.incrementPos;
-            
-            // Check if this voxel contains the query point (x,z)
-            // A voxel at position (vx,vy,vz) with size S contains point (x,z) if:
-            // vx <= x < vx+S and vz <= z < vz+S
-            if (pos.x() <= x && x < pos.x() + voxelSizeIncrements &&
-                pos.z() <= z && z < pos.z() + voxelSizeIncrements) {
-                
-                // This voxel contains the point, check if it's the highest
-                float topHeight = calculateVoxelTopHeight(pos, resolution);
-                if (topHeight > highestTopHeight) {
-                    highestTopHeight = topHeight;
-                    highestVoxel = VoxelInfo(pos, resolution);
-                }
-            }
+        float topHeight = calculateVoxelTopHeight(pos, resolution);
+        if (topHeight > highestTopHeight) {
+            highestTopHeight = topHeight;
+            highestVoxel = VoxelInfo(pos, resolution);
         }
     }
     
@@ -333,44 +305,19 @@ std::optional<PlaneDetector::VoxelInfo> PlaneDetector::findHighestVoxelInRadius(
         return bestVoxel;
     }
     
-    // OPTIMIZED APPROACH: Check existing voxels within radius instead of grid search
     int radiusIncrements = static_cast<int>(searchRadius * Math::CoordinateConverter::METERS_TO_CM);
-    int radiusSquared = radiusIncrements * radiusIncrements;
     
-    // Only check resolutions that actually have voxels
+    // Same as above, over the tiles the search circle overlaps
     for (auto resolution : getAllResolutions()) {
-        // Skip resolutions with no voxels
-        if (m_voxelManager->getVoxelCount(resolution) == 0) {
+        Math::IncrementCoordinates pos;
+        if (!m_voxelManager->findHighestVoxelInRadius(resolution, centerPos.x(), centerPos.z(), radiusIncrements, pos)) {
             continue;
         }
         
-        float voxelSize = VoxelData::getVoxelSize(resolution);
-        int voxelSizeIncrements = static_cast<int>(voxelSize * Math::CoordinateConverter::METERS_TO_CM);
-        
-        // Get all voxels of this resolution
-        auto voxelsOfResolution = m_voxelManager->getAllVoxels(resolution);
-        
-        // Check each voxel to see if it's within the search radius
-        for (const auto& voxelPos : voxelsOfResolution) {
-            const Math::IncrementCoordinates& pos = voxelPos.incrementPos;
-            
-            // Check if any part of this voxel is within the search radius
-            // Calculate closest point on voxel to center
-            int closestX = std::max(pos.x(), std::min(centerPos.x(), pos.x() + voxelSizeIncrements - 1));
-            int closestZ = std::max(pos.z(), std::min(centerPos.z(), pos.z() + voxelSizeIncrements - 1));
-            
-            int dx = closestX - centerPos.x();
-            int dz = closestZ - centerPos.z();
-            int distSquared = dx * dx + dz * dz;
-            
-            if (distSquared <= radiusSquared) {
-                // This voxel is within search radius, check if it's the highest
-                float topHeight = calculateVoxelTopHeight(pos, resolution);
-                if (topHeight > highestHeight) {
-                    highestHeight = topHeight;
-                    bestVoxel = VoxelInfo(pos, resolution);
-                }
-            }
+        float topHeight = calculateVoxelTopHeight(pos, resolution);
+        if (topHeight > highestHeight) {
+            highestHeight = topHeight;
+            bestVoxel = VoxelInfo(pos, resolution);
         }
     }
     
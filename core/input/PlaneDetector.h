@@ -167,6 +167,7 @@ private:
     static constexpr float PERSISTENCE_TIMEOUT_SECONDS = 0.5f;
     static constexpr float MAX_VOXEL_SEARCH_HEIGHT = 1.0f;  // Reduced to 1m to avoid test interference
     static constexpr float DEFAULT_SEARCH_RADIUS = 1.0f;     // Reduced to 1m for better performance
+    static constexpr float HEIGHT_EPSILON_CM = 0.01f;        // Slack when turning heights into 1cm layers
     
     // Search for voxels in a cylindrical area under the cursor
     std::vector<Math::IncrementCoordinates> searchVoxelsInCylinder(const Math::Vector3f& centerPos, 
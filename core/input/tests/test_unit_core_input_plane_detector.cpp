@@ -335,4 +335,48 @@ TEST_F(PlaneDetectorTest, ComplexStackingScenario) {
     auto result = m_planeDetector->detectPlane(createContext(Vector3f(0.16f, 1.0f, 0.16f))); // Center of 32cm voxel
     EXPECT_TRUE(result.found);
     EXPECT_NEAR(result.plane.height, 0.32f, 0.01f); // 32cm voxel should have height around 0.32m (allow for minor inaccuracy)
-}
\ No newline at end of file
+}
+
+// Mixed resolutions on a populated floor; answers come from the height index
+TEST_F(PlaneDetectorTest, HeightQueriesOnPopulatedScene) {
+    // 60 x 60 floor of 4cm voxels
+    for (int x = -120; x < 120; x += 4) {
+        for (int z = -120; z < 120; z += 4) {
+            ASSERT_TRUE(m_voxelManager->setVoxel(IncrementCoordinates(x, 0, z), VoxelResolution::Size_4cm, true));
+        }
+    }
+    // A 16cm block on the floor and a 1cm voxel on top of it
+    ASSERT_TRUE(m_voxelManager->setVoxel(IncrementCoordinates(40, 4, 40), VoxelResolution::Size_16cm, true));
+    ASSERT_TRUE(m_voxelManager->setVoxel(IncrementCoordinates(45, 20, 47), VoxelResolution::Size_1cm, true));
+    
+    EXPECT_EQ(m_planeDetector->getVoxelsAtHeight(0.04f).size(), 3600u);
+    EXPECT_EQ(m_planeDetector->getVoxelsAtHeight(0.20f).size(), 1u);
+    EXPECT_TRUE(m_planeDetector->getVoxelsAtHeight(0.10f).empty());
+    
+    // Directly over the 1cm voxel, then elsewhere on the block, then the floor
+    auto top = m_planeDetector->findHighestVoxelUnderCursor(Vector3f(0.453f, 0.0f, 0.472f), 0.0f);
+    ASSERT_TRUE(top.has_value());
+    EXPECT_EQ(top->resolution, VoxelResolution::Size_1cm);
+    
+    auto block = m_planeDetector->findHighestVoxelUnderCursor(Vector3f(0.52f, 0.0f, 0.42f), 0.0f);
+    ASSERT_TRUE(block.has_value());
+    EXPECT_EQ(block->resolution, VoxelResolution::Size_16cm);
+    EXPECT_EQ(block->position, IncrementCoordinates(40, 4, 40));
+    
+    auto floor = m_planeDetector->findHighestVoxelUnderCursor(Vector3f(-1.0f, 0.0f, -1.0f), 0.0f);
+    ASSERT_TRUE(floor.has_value());
+    EXPECT_EQ(floor->resolution, VoxelResolution::Size_4cm);
+    
+    // Off the floor, the radius search only sees what the circle reaches
+    auto edge = m_planeDetector->findHighestVoxelUnderCursor(Vector3f(1.5f, 0.0f, 1.5f), 1.2f);
+    ASSERT_TRUE(edge.has_value());
+    EXPECT_EQ(edge->resolution, VoxelResolution::Size_4cm);
+    auto wide = m_planeDetector->findHighestVoxelUnderCursor(Vector3f(1.5f, 0.0f, 1.5f), 1.5f);
+    ASSERT_TRUE(wide.has_value());
+    EXPECT_EQ(wide->resolution, VoxelResolution::Size_1cm);
+    
+    auto result = m_planeDetector->detectPlane(createContext(Vector3f(0.453f, 0.0f, 0.472f)));
+    ASSERT_TRUE(result.found);
+    EXPECT_NEAR(result.plane.height, 0.21f, 0.001f);
+    EXPECT_EQ(result.voxelsOnPlane.size(), 1u);
+}
@@ -386,6 +386,19 @@ void OpenGLRenderer::setupVertexAttributes(const std::vector<VertexAttribute>& a
     checkGLError("setupVertexAttributes");
 }
 
+void OpenGLRenderer::setupInstanceAttribute(int location, int components, size_t stride, size_t offset) {
+    if (!m_contextValid) {
+        return;
+    }
+    
+    glEnableVertexAttribArray(location);
+    glVertexAttribPointer(location, components, GL_FLOAT, GL_FALSE, 
+                          static_cast<GLsizei>(stride), reinterpret_cast<const void*>(offset));
+    glVertexAttribDivisor(location, 1);
+    
+    checkGLError("setupInstanceAttribute");
+}
+
 void OpenGLRenderer::useProgram(ShaderId programId) {
     if (programId == InvalidId) {
         glUseProgram(0);
@@ -131,6 +131,8 @@ public:
     void bindVertexArray(uint32_t vaoId);
     void deleteVertexArray(uint32_t vaoId);
     void setupVertexAttributes(const std::vector<VertexAttribute>& attributes);
+    // Per-instance float attribute read from the bound vertex buffer (divisor 1)
+    void setupInstanceAttribute(int location, int components, size_t stride, size_t offset);
     
     // Texture operations
     TextureId createTexture2D(int width, int height, TextureFormat format, const void* data = nullptr);
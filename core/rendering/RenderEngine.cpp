@@ -6,6 +6,7 @@
 #include "../voxel_data/VoxelGrid.h"
 #include "../voxel_data/VoxelTypes.h"
 #include "../../foundation/logging/Logger.h"
+#include "../../foundation/logging/PerformanceProfiler.h"
 #include "../../foundation/math/Matrix4f.h"
 #include "../../foundation/math/CoordinateConverter.h"
 #include "../../foundation/math/CoordinateTypes.h"
@@ -45,12 +46,20 @@ RenderEngine::RenderEngine(Events::EventDispatcher* eventDispatcher)
     m_currentSettings.ambientLight = Color(0.2f, 0.2f, 0.2f, 1.0f);
     m_currentSettings.lightDirection = Math::Vector3f(0.3f, -1.0f, 0.5f).normalized();
     m_currentSettings.lightColor = Color::White();
+    
+    if (m_eventDispatcher) {
+        m_eventDispatcher->subscribe<Events::VoxelChangedEvent>(&m_voxelInstances);
+    }
 }
 
 RenderEngine::~RenderEngine() {
     if (m_initialized) {
         shutdown();
     }
+    
+    if (m_eventDispatcher) {
+        m_eventDispatcher->unsubscribe<Events::VoxelChangedEvent>(&m_voxelInstances);
+    }
 }
 
 bool RenderEngine::initialize(const RenderConfig& config) {
@@ -98,6 +107,7 @@ void RenderEngine::shutdown() {
     if (!m_initialized) return;
     
     // Clean up in reverse order
+    releaseInstanceBuffers();
     m_groundPlaneGrid.reset();
     m_renderState.reset();
     m_shaderManager.reset();
@@ -129,6 +139,7 @@ void RenderEngine::beginFrame() {
     
     // Clear frame stats
     m_stats.drawCalls = 0;
+    m_stats.instancedDrawCalls = 0;
     m_stats.trianglesRendered = 0;
     m_stats.verticesProcessed = 0;
     
@@ -174,6 +185,7 @@ void RenderEngine::clear(ClearFlags flags, const Color& color, float depth, int
 
 // Basic rendering
 void RenderEngine::renderMesh(const Mesh& mesh, const Transform& transform, const Material& material) {
+    PROFILE_SCOPE("RenderEngine::renderMesh");
     if (!m_initialized || mesh.isEmpty()) return;
     
     // Ensure mesh has VAO and GPU buffers
@@ -343,6 +355,7 @@ void RenderEngine::renderMeshInternal(const Mesh& mesh, const Transform& transfo
 }
 
 void RenderEngine::renderMeshAsLines(const Mesh& mesh, const Transform& transform, const Material& material) {
+    PROFILE_SCOPE("RenderEngine::renderMeshAsLines");
     if (!m_glRenderer || !m_shaderManager || mesh.isEmpty()) return;
     
     // Clear any pending GL errors before starting
@@ -515,6 +528,7 @@ void RenderEngine::reloadShaders() {
 
 // Mesh utilities
 void RenderEngine::setupMeshBuffers(Mesh& mesh) {
+    PROFILE_SCOPE("RenderEngine::setupMeshBuffers");
     if (!m_glRenderer || mesh.isEmpty()) return;
     
     // Create VAO for the mesh
@@ -639,6 +653,7 @@ void RenderEngine::bindMaterial(const Material& material) {
 }
 
 void RenderEngine::updatePerFrameUniforms() {
+    PROFILE_SCOPE("RenderEngine::updatePerFrameUniforms");
     if (!m_glRenderer) return;
     
     // Update lighting uniforms - but we need to set these for each shader program
@@ -687,15 +702,14 @@ void RenderEngine::loadBuiltinShaders() {
         );
     }
     
-    // If file loading succeeded, we're done
+    // Shaders that failed to load from file fall back to the built-in sources
+    // below; the instanced shader has no file version and is always built here
     if (useFileShaders && basicShaderId != InvalidId && enhancedShaderId != InvalidId && flatShaderId != InvalidId) {
         Logging::Logger::getInstance().info("Successfully loaded shaders from files");
-        return;
+    } else {
+        Logging::Logger::getInstance().info("Using built-in shader definitions");
     }
     
-    // Fall back to built-in shaders
-    Logging::Logger::getInstance().info("Using built-in shader definitions");
-    
     // Common vertex shader for all voxel shaders
     const std::string voxelVertex = R"(
 #version 330 core
@@ -720,6 +734,31 @@ void main() {
 }
     )";
     
+    // Instanced variant: a_instance.xyz offsets and a_instance.w uniformly
+    // scales the shared mesh, so normals need no transform
+    const std::string instancedVertex = R"(
+#version 330 core
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec3 a_normal;
+layout(location = 2) in vec4 a_color;
+layout(location = 4) in vec4 a_instance;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec4 Color;
+
+void main() {
+    FragPos = a_position * a_instance.w + a_instance.xyz;
+    Normal = a_normal;
+    Color = a_color;
+    
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
+    )";
+    
     // Basic shader (original lighting)
     const std::string basicFragment = R"(
 #version 330 core
@@ -945,6 +984,12 @@ void main() {
         std::cout << "Created flat shader with ID: " << flatShaderId << std::endl;
     }
     
+    Logging::Logger::getInstance().info("RenderEngine: Creating instanced shader from built-in source...");
+    ShaderId instancedShaderId = m_shaderManager->createShaderFromSource("instanced", instancedVertex, enhancedFragment, m_glRenderer.get());
+    if (instancedShaderId == InvalidId) {
+        Logging::Logger::getInstance().error("RenderEngine: Failed to create instanced shader");
+    }
+    
     Logging::Logger::getInstance().info("RenderEngine: All built-in shaders loaded successfully");
 }
 
@@ -1017,46 +1062,172 @@ void RenderEngine::renderBounds(const Transform& transform) {
     (void)transform;
 }
 
-// Voxel rendering (basic implementation for testing)
+// Voxel rendering
 void RenderEngine::renderVoxels(const VoxelData::VoxelGrid& grid, 
                                VoxelData::VoxelResolution resolution, 
                                const RenderSettings& settings) {
+    PROFILE_SCOPE("RenderEngine::renderVoxels");
     if (!m_glRenderer || !m_currentCamera) return;
     
-    // Get voxel size for this resolution
-    float voxelSize = VoxelData::getVoxelSize(resolution) / 100.0f; // Convert to meters
+    // The grid decides which instance list it fills
+    if (resolution != grid.getResolution()) {
+        Logging::Logger::getInstance().warning("RenderEngine::renderVoxels: resolution does not match the grid");
+        resolution = grid.getResolution();
+    }
     
-    // Create a reusable cube mesh (could be cached)
-    Mesh cubeMesh = createCubeMesh(voxelSize);
+    if (m_voxelCube.isEmpty()) {
+        m_voxelCube = createCubeMesh(1.0f);
+        for (Vertex& vertex : m_voxelCube.vertices) {
+            vertex.position = Math::WorldCoordinates(vertex.position.value() + Math::Vector3f(0.0f, 0.5f, 0.0f));
+        }
+        setupMeshBuffers(m_voxelCube);
+    }
+    
+    // Wireframe keeps the basic shader, which has no instance attribute,
+    // so each voxel is drawn on its own; the instance list catches up on
+    // the next solid frame
+    if (settings.renderMode == RenderMode::Wireframe) {
+        Material material;
+        material.shader = getBuiltinShader("basic");
+        material.doubleSided = false;
+        float voxelSize = VoxelData::getVoxelSize(resolution);
+        grid.forEachVoxel([&](const VoxelData::VoxelPosition& voxel) {
+            Transform transform;
+            transform.position = Math::CoordinateConverter::incrementToWorld(voxel.incrementPos);
+            transform.scale = Math::Vector3f(voxelSize, voxelSize, voxelSize);
+            renderMesh(m_voxelCube, transform, material);
+        });
+        return;
+    }
+    
+    ShaderId shader = getBuiltinShader("instanced");
+    if (shader == InvalidId) return;
+    
+    // Without events the list cannot follow edits, so rebuild it every frame
+    if (!m_eventDispatcher) {
+        m_voxelInstances.invalidate(resolution);
+    }
+    m_voxelInstances.sync(grid);
+    
+    InstanceBatch& batch = m_voxelBatches[static_cast<int>(resolution)];
+    size_t instanceCount = m_voxelInstances.flush(resolution,
+        [this, &batch](const VoxelInstance* instances, size_t total, size_t first, size_t count) {
+            uploadInstances(batch, instances, total, first, count);
+        });
+    if (instanceCount == 0) return;
     
-    // Set up material based on render settings
     Material material;
-    material.shader = getBuiltinShader(settings.renderMode == RenderMode::Wireframe ? "basic" : "enhanced");
-    material.albedo = Color(0.7f, 0.7f, 0.7f, 1.0f);
+    material.shader = shader;
     material.doubleSided = false;
+    setupRenderState(material);
+    m_glRenderer->useProgram(shader);
+    setCameraUniforms();
     
-    // Iterate through all voxels in the grid
-    // VoxelGrid doesn't have getBounds(), so we'll iterate through a reasonable range
-    const int maxRange = 50; // Reasonable range for testing
-    for (int x = -maxRange; x <= maxRange; ++x) {
-        for (int y = 0; y <= maxRange; ++y) { // Y starts at 0 (ground plane)
-            for (int z = -maxRange; z <= maxRange; ++z) {
-                Math::IncrementCoordinates voxelPos(x, y, z);
-                if (grid.getVoxel(voxelPos)) {
-                    // Convert to world coordinates
-                    auto worldPos = Math::CoordinateConverter::incrementToWorld(voxelPos);
-                    
-                    // Create transform for this voxel
-                    Transform transform;
-                    transform.position = worldPos;
-                    transform.scale = Math::Vector3f(1.0f, 1.0f, 1.0f);
-                    
-                    // Render the cube
-                    renderMesh(cubeMesh, transform, material);
-                }
-            }
+    drawInstanced(m_voxelCube, batch, instanceCount);
+}
+
+void RenderEngine::renderMeshInstanced(const Mesh& mesh, const std::vector<Transform>& transforms, const Material& material) {
+    PROFILE_SCOPE("RenderEngine::renderMeshInstanced");
+    if (!m_initialized || mesh.isEmpty() || transforms.empty()) return;
+    
+    // The instanced shader can only offset and uniformly scale
+    bool packable = std::all_of(transforms.begin(), transforms.end(), [](const Transform& transform) {
+        return transform.rotation == Math::Vector3f::Zero() &&
+               transform.scale.x == transform.scale.y && transform.scale.y == transform.scale.z;
+    });
+    
+    ShaderId shader = getBuiltinShader("instanced");
+    if (!packable || shader == InvalidId || !m_currentCamera) {
+        for (const Transform& transform : transforms) {
+            renderMesh(mesh, transform, material);
+        }
+        return;
+    }
+    
+    if (mesh.vertexArray == InvalidId || mesh.vertexBuffer == InvalidId || mesh.indexBuffer == InvalidId) {
+        setupMeshBuffers(const_cast<Mesh&>(mesh));
+    }
+    
+    m_meshInstanceScratch.clear();
+    m_meshInstanceScratch.reserve(transforms.size());
+    for (const Transform& transform : transforms) {
+        const Math::Vector3f& position = transform.position.value();
+        m_meshInstanceScratch.push_back(VoxelInstance{position.x, position.y, position.z, transform.scale.x});
+    }
+    uploadInstances(m_meshInstanceBatch, m_meshInstanceScratch.data(), m_meshInstanceScratch.size(),
+                    0, m_meshInstanceScratch.size());
+    
+    setupRenderState(material);
+    m_glRenderer->useProgram(shader);
+    setCameraUniforms();
+    
+    drawInstanced(mesh, m_meshInstanceBatch, transforms.size());
+}
+
+void RenderEngine::setCameraUniforms() {
+    if (!m_currentCamera) return;
+    
+    m_glRenderer->setUniform("view", UniformValue(m_currentCamera->getViewMatrix()));
+    m_glRenderer->setUniform("projection", UniformValue(m_currentCamera->getProjectionMatrix()));
+    m_glRenderer->setUniform("lightPos", UniformValue(Math::Vector3f(5.0f, 10.0f, 5.0f)));
+    m_glRenderer->setUniform("lightColor", UniformValue(Math::Vector3f(1.0f, 1.0f, 1.0f)));
+    m_glRenderer->setUniform("viewPos", UniformValue(m_currentCamera->getPosition().value()));
+}
+
+void RenderEngine::uploadInstances(InstanceBatch& batch, const VoxelInstance* instances, size_t total,
+                                   size_t first, size_t count) {
+    // Grow by doubling so a steady stream of additions reallocates rarely
+    if (batch.instanceBuffer == InvalidId || total > batch.capacity) {
+        size_t capacity = std::max<size_t>(std::max<size_t>(batch.capacity * 2, total), 64);
+        if (batch.instanceBuffer != InvalidId) {
+            m_glRenderer->deleteBuffer(batch.instanceBuffer);
         }
+        batch.instanceBuffer = m_glRenderer->createVertexBuffer(nullptr, capacity * sizeof(VoxelInstance),
+                                                                BufferUsage::Dynamic);
+        batch.capacity = capacity;
+        first = 0;
+        count = total;
     }
+    
+    if (count > 0) {
+        m_glRenderer->updateBuffer(batch.instanceBuffer, instances + first,
+                                   count * sizeof(VoxelInstance), first * sizeof(VoxelInstance));
+    }
+}
+
+void RenderEngine::drawInstanced(const Mesh& mesh, const InstanceBatch& batch, size_t instanceCount) {
+    // The instance attribute is re-pointed per draw so one mesh can serve several batches
+    m_glRenderer->bindVertexArray(mesh.vertexArray);
+    m_glRenderer->bindVertexBuffer(batch.instanceBuffer);
+    m_glRenderer->setupInstanceAttribute(4, 4, sizeof(VoxelInstance), 0);
+    
+    m_glRenderer->drawElementsInstanced(PrimitiveType::Triangles,
+                                        static_cast<int>(mesh.indices.size()),
+                                        static_cast<int>(instanceCount));
+    m_glRenderer->bindVertexArray(0);
+    
+    m_stats.addDrawCall(static_cast<uint32_t>(mesh.getTriangleCount() * instanceCount),
+                        static_cast<uint32_t>(mesh.getVertexCount() * instanceCount), true);
+}
+
+void RenderEngine::releaseInstanceBuffers() {
+    if (!m_glRenderer) return;
+    
+    for (InstanceBatch& batch : m_voxelBatches) {
+        if (batch.instanceBuffer != InvalidId) {
+            m_glRenderer->deleteBuffer(batch.instanceBuffer);
+        }
+        batch = InstanceBatch();
+    }
+    if (m_meshInstanceBatch.instanceBuffer != InvalidId) {
+        m_glRenderer->deleteBuffer(m_meshInstanceBatch.instanceBuffer);
+    }
+    m_meshInstanceBatch = InstanceBatch();
+    cleanupMeshBuffers(m_voxelCube);
+    m_voxelCube = Mesh();
+    
+    // Lists are uploaded again from scratch into the next context's buffers
+    m_voxelInstances.clear();
 }
 
 // Direct OpenGL access methods
@@ -1174,6 +1345,7 @@ void RenderEngine::updateGroundPlaneGridAnimation(float deltaTime) {
 }
 
 void RenderEngine::renderGroundPlaneGrid(const Math::WorldCoordinates& cursorWorldPos) {
+    PROFILE_SCOPE("RenderEngine::renderGroundPlaneGrid");
     if (!m_groundPlaneGrid || !m_currentCamera) {
         return;
     }
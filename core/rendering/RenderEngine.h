@@ -4,6 +4,7 @@
 #include "RenderConfig.h"
 #include "RenderStats.h"
 #include "OpenGLRenderer.h"  // For UniformValue
+#include "VoxelInstanceBuffer.h"
 #include "../../foundation/events/EventDispatcher.h"
 #include "../camera/Camera.h"
 #include <memory>
@@ -60,7 +61,8 @@ public:
     void renderMeshAsLines(const Mesh& mesh, const Transform& transform, const Material& material);
     void renderMeshInstanced(const Mesh& mesh, const std::vector<Transform>& transforms, const Material& material);
     
-    // Voxel rendering
+    // Voxel rendering: one instanced draw per resolution, kept in sync from
+    // VoxelChangedEvents when the engine has an event dispatcher
     void renderVoxels(const VoxelData::VoxelGrid& grid, 
                      VoxelData::VoxelResolution resolution, 
                      const RenderSettings& settings);
@@ -166,11 +168,27 @@ private:
     // Event system
     Events::EventDispatcher* m_eventDispatcher;
     
+    // Instanced rendering
+    struct InstanceBatch {
+        BufferId instanceBuffer = InvalidId;
+        size_t capacity = 0;               // In instances
+    };
+    VoxelInstanceBuffer m_voxelInstances;
+    InstanceBatch m_voxelBatches[static_cast<int>(VoxelData::VoxelResolution::COUNT)];
+    InstanceBatch m_meshInstanceBatch;
+    std::vector<VoxelInstance> m_meshInstanceScratch;
+    Mesh m_voxelCube;                      // Unit cube resting on y = 0, shared by all resolutions
+    
     // Internal rendering methods
     void renderMeshInternal(const Mesh& mesh, const Transform& transform, const Material& material);
     void setupRenderState(const Material& material);
     void bindMaterial(const Material& material);
     void updatePerFrameUniforms();
+    void setCameraUniforms();
+    void uploadInstances(InstanceBatch& batch, const VoxelInstance* instances, size_t total,
+                         size_t first, size_t count);
+    void drawInstanced(const Mesh& mesh, const InstanceBatch& batch, size_t instanceCount);
+    void releaseInstanceBuffers();
     void updateStats();
     
     // Voxel rendering helpers
@@ -0,0 +1,147 @@
+#include "VoxelInstanceBuffer.h"
+#include "../voxel_data/VoxelGrid.h"
+#include "../../foundation/math/CoordinateConverter.h"
+#include <algorithm>
+
+namespace VoxelEditor {
+namespace Rendering {
+
+VoxelInstanceBuffer::VoxelInstanceBuffer() = default;
+
+bool VoxelInstanceBuffer::sync(const VoxelData::VoxelGrid& grid) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Layer& layer = m_layers[static_cast<int>(grid.getResolution())];
+    if (layer.synced && layer.grid == &grid && layer.instances.size() == grid.getVoxelCount()) {
+        return false;
+    }
+
+    rebuild(layer, grid);
+    return true;
+}
+
+size_t VoxelInstanceBuffer::flush(VoxelData::VoxelResolution resolution, const UploadCallback& upload) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Layer& layer = m_layers[static_cast<int>(resolution)];
+    size_t total = layer.instances.size();
+    size_t end = std::min(layer.dirtyEnd, total);
+    if (layer.dirtyBegin < end && upload) {
+        upload(layer.instances.data(), total, layer.dirtyBegin, end - layer.dirtyBegin);
+    }
+    layer.dirtyBegin = 0;
+    layer.dirtyEnd = 0;
+    return total;
+}
+
+size_t VoxelInstanceBuffer::getInstanceCount(VoxelData::VoxelResolution resolution) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_layers[static_cast<int>(resolution)].instances.size();
+}
+
+bool VoxelInstanceBuffer::hasPendingChanges(VoxelData::VoxelResolution resolution) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Layer& layer = m_layers[static_cast<int>(resolution)];
+    return layer.dirtyBegin < std::min(layer.dirtyEnd, layer.instances.size());
+}
+
+void VoxelInstanceBuffer::invalidate(VoxelData::VoxelResolution resolution) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_layers[static_cast<int>(resolution)].synced = false;
+}
+
+void VoxelInstanceBuffer::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Layer& layer : m_layers) {
+        layer = Layer();
+    }
+}
+
+void VoxelInstanceBuffer::handleEvent(const Events::VoxelChangedEvent& event) {
+    if (event.oldValue == event.newValue) return;
+
+    int index = static_cast<int>(event.resolution);
+    if (index < 0 || index >= static_cast<int>(VoxelData::VoxelResolution::COUNT)) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Layer& layer = m_layers[index];
+    if (!layer.synced) return;
+
+    if (event.newValue) {
+        addInstance(layer, event.gridPos, event.resolution);
+    } else {
+        removeInstance(layer, event.gridPos);
+    }
+}
+
+VoxelInstance VoxelInstanceBuffer::makeInstance(const Math::Vector3i& incrementPos, float voxelSize) {
+    Math::Vector3f world = Math::CoordinateConverter::incrementToWorld(
+        Math::IncrementCoordinates(incrementPos)).value();
+    return VoxelInstance{world.x, world.y, world.z, voxelSize};
+}
+
+void VoxelInstanceBuffer::markDirty(Layer& layer, size_t slot) {
+    if (layer.dirtyBegin == layer.dirtyEnd) {
+        layer.dirtyBegin = slot;
+        layer.dirtyEnd = slot + 1;
+        return;
+    }
+    layer.dirtyBegin = std::min(layer.dirtyBegin, slot);
+    layer.dirtyEnd = std::max(layer.dirtyEnd, slot + 1);
+}
+
+void VoxelInstanceBuffer::rebuild(Layer& layer, const VoxelData::VoxelGrid& grid) {
+    float voxelSize = VoxelData::getVoxelSize(grid.getResolution());
+
+    layer.grid = &grid;
+    layer.synced = true;
+    layer.instances.clear();
+    layer.positions.clear();
+    layer.slots.clear();
+
+    size_t count = grid.getVoxelCount();
+    layer.instances.reserve(count);
+    layer.positions.reserve(count);
+    layer.slots.reserve(count);
+
+    grid.forEachVoxel([&](const VoxelData::VoxelPosition& voxel) {
+        const Math::Vector3i& pos = voxel.incrementPos.value();
+        layer.slots.emplace(pos, layer.instances.size());
+        layer.positions.push_back(pos);
+        layer.instances.push_back(makeInstance(pos, voxelSize));
+    });
+
+    layer.dirtyBegin = 0;
+    layer.dirtyEnd = layer.instances.size();
+}
+
+void VoxelInstanceBuffer::addInstance(Layer& layer, const Math::Vector3i& incrementPos,
+                                      VoxelData::VoxelResolution resolution) {
+    auto inserted = layer.slots.emplace(incrementPos, layer.instances.size());
+    if (!inserted.second) return;
+
+    layer.positions.push_back(incrementPos);
+    layer.instances.push_back(makeInstance(incrementPos, VoxelData::getVoxelSize(resolution)));
+    markDirty(layer, layer.instances.size() - 1);
+}
+
+void VoxelInstanceBuffer::removeInstance(Layer& layer, const Math::Vector3i& incrementPos) {
+    auto it = layer.slots.find(incrementPos);
+    if (it == layer.slots.end()) return;
+
+    // Move the last instance into the hole so the list stays packed
+    size_t slot = it->second;
+    size_t last = layer.instances.size() - 1;
+    layer.slots.erase(it);
+    if (slot != last) {
+        layer.instances[slot] = layer.instances[last];
+        layer.positions[slot] = layer.positions[last];
+        layer.slots[layer.positions[slot]] = slot;
+        markDirty(layer, slot);
+    }
+    layer.instances.pop_back();
+    layer.positions.pop_back();
+}
+
+}
+}
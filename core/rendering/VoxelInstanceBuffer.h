@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../../foundation/events/EventHandler.h"
+#include "../../foundation/events/CommonEvents.h"
+#include "../../foundation/math/Vector3i.h"
+#include "../voxel_data/VoxelTypes.h"
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace VoxelEditor {
+
+namespace VoxelData {
+    class VoxelGrid;
+}
+
+namespace Rendering {
+
+/**
+ * @brief Per-instance data for one voxel cube
+ *
+ * Matches the vec4 instance attribute of the "instanced" shader: the
+ * bottom-center of the voxel in world space and its edge length.
+ */
+struct VoxelInstance {
+    float x, y, z;
+    float size;
+};
+
+/**
+ * @brief CPU-side instance lists for instanced voxel rendering
+ *
+ * Keeps one packed list of voxel instances per resolution. Lists are built
+ * once from the grid and then kept up to date from VoxelChangedEvents: an
+ * added voxel is appended, a removed one is swap-removed, and only the range
+ * of slots that changed is handed to the upload callback on the next flush.
+ *
+ * Only resolutions that have been synced are tracked. sync() rebuilds a list
+ * when the grid object changes or its voxel count no longer matches, which
+ * catches bulk edits that do not send events (clear, file load).
+ *
+ * Holds no GL state, so it can be used and tested without a context.
+ */
+class VoxelInstanceBuffer : public Events::EventHandler<Events::VoxelChangedEvent> {
+public:
+    /**
+     * @brief Receives instance data to upload
+     * @param instances All instances of the resolution
+     * @param total Number of instances
+     * @param first First changed instance
+     * @param count Number of changed instances starting at first
+     */
+    using UploadCallback = std::function<void(const VoxelInstance* instances, size_t total,
+                                              size_t first, size_t count)>;
+
+    VoxelInstanceBuffer();
+
+    /**
+     * @brief Bring the list for the grid's resolution in line with the grid
+     * @return true if the list was rebuilt from scratch
+     */
+    bool sync(const VoxelData::VoxelGrid& grid);
+
+    /**
+     * @brief Pass pending changes for a resolution to the upload callback
+     * @return Number of instances of the resolution
+     */
+    size_t flush(VoxelData::VoxelResolution resolution, const UploadCallback& upload);
+
+    size_t getInstanceCount(VoxelData::VoxelResolution resolution) const;
+    bool hasPendingChanges(VoxelData::VoxelResolution resolution) const;
+
+    // Force the next sync of a resolution to rebuild, for owners that get no events
+    void invalidate(VoxelData::VoxelResolution resolution);
+
+    // Forget every resolution; the next sync rebuilds
+    void clear();
+
+    void handleEvent(const Events::VoxelChangedEvent& event) override;
+
+private:
+    struct Layer {
+        const VoxelData::VoxelGrid* grid = nullptr;
+        bool synced = false;
+        std::vector<VoxelInstance> instances;
+        std::vector<Math::Vector3i> positions;          // Increment position of each slot
+        std::unordered_map<Math::Vector3i, size_t> slots;
+        size_t dirtyBegin = 0;
+        size_t dirtyEnd = 0;                            // Empty when dirtyBegin == dirtyEnd
+    };
+
+    static VoxelInstance makeInstance(const Math::Vector3i& incrementPos, float voxelSize);
+    static void markDirty(Layer& layer, size_t slot);
+
+    void rebuild(Layer& layer, const VoxelData::VoxelGrid& grid);
+    void addInstance(Layer& layer, const Math::Vector3i& incrementPos, VoxelData::VoxelResolution resolution);
+    void removeInstance(Layer& layer, const Math::Vector3i& incrementPos);
+
+    Layer m_layers[static_cast<int>(VoxelData::VoxelResolution::COUNT)];
+    mutable std::mutex m_mutex;
+};
+
+}
+}
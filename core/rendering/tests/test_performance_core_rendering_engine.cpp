@@ -277,14 +277,14 @@ TEST_F(RenderPerformanceTest, RenderStatsAccuracy) {
     const RenderStats& stats = renderEngine->getRenderStats();
     
     // Verify stats are reasonable
-    EXPECT_GT(stats.drawCalls, 0) << "No draw calls recorded";
+    EXPECT_EQ(stats.instancedDrawCalls, 1u) << "Voxels should be drawn with one instanced call";
     EXPECT_GT(stats.verticesProcessed, 0) << "No vertices recorded";
     EXPECT_GT(stats.trianglesRendered, 0) << "No triangles recorded";
     EXPECT_GE(stats.frameTime, 0.0f) << "Invalid frame time";
     
     Logger& logger = Logger::getInstance();
     logger.infof("\nRender Stats for %d voxels:", voxelCount);
-    logger.infof("  Draw calls: %d", stats.drawCalls);
+    logger.infof("  Draw calls: %d (%d instanced)", stats.drawCalls, stats.instancedDrawCalls);
     logger.infof("  Vertices: %d", stats.verticesProcessed);
     logger.infof("  Triangles: %d", stats.trianglesRendered);
     logger.infof("  Frame time: %.2fms", stats.frameTime);
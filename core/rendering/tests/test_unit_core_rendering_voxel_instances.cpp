@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "../VoxelInstanceBuffer.h"
+#include "../../voxel_data/VoxelGrid.h"
+#include <set>
+#include <tuple>
+
+using namespace VoxelEditor;
+using namespace VoxelEditor::Rendering;
+using VoxelEditor::VoxelData::VoxelGrid;
+using VoxelEditor::VoxelData::VoxelResolution;
+
+namespace {
+
+// Mirrors what a GPU buffer would hold after each upload
+struct UploadRecorder {
+    std::vector<VoxelInstance> buffer;
+    size_t uploads = 0;
+    size_t lastFirst = 0;
+    size_t lastCount = 0;
+
+    VoxelInstanceBuffer::UploadCallback callback() {
+        return [this](const VoxelInstance* instances, size_t total, size_t first, size_t count) {
+            buffer.resize(total);
+            std::copy(instances + first, instances + first + count, buffer.begin() + first);
+            ++uploads;
+            lastFirst = first;
+            lastCount = count;
+        };
+    }
+};
+
+std::set<std::tuple<float, float, float>> positionsOf(const std::vector<VoxelInstance>& instances, size_t count) {
+    std::set<std::tuple<float, float, float>> positions;
+    for (size_t i = 0; i < count; ++i) {
+        positions.insert(std::make_tuple(instances[i].x, instances[i].y, instances[i].z));
+    }
+    return positions;
+}
+
+Events::VoxelChangedEvent change(const Math::Vector3i& pos, VoxelResolution resolution, bool value) {
+    return Events::VoxelChangedEvent(pos, resolution, !value, value);
+}
+
+}
+
+class VoxelInstanceBufferTest : public ::testing::Test {
+protected:
+    VoxelInstanceBufferTest() : grid(VoxelResolution::Size_4cm, Math::Vector3f(5.0f, 5.0f, 5.0f)) {}
+
+    // Edit the grid and tell the buffer, as VoxelDataManager would
+    void setVoxel(const Math::Vector3i& pos, bool value) {
+        ASSERT_TRUE(grid.setVoxel(pos, value));
+        buffer.handleEvent(change(pos, VoxelResolution::Size_4cm, value));
+    }
+
+    VoxelGrid grid;
+    VoxelInstanceBuffer buffer;
+};
+
+TEST_F(VoxelInstanceBufferTest, SyncBuildsInstancesAtBottomCenter) {
+    grid.setVoxel(Math::Vector3i(0, 0, 0), true);
+    grid.setVoxel(Math::Vector3i(-8, 12, 4), true);
+
+    EXPECT_TRUE(buffer.sync(grid));
+    EXPECT_FALSE(buffer.sync(grid));
+
+    UploadRecorder recorder;
+    EXPECT_EQ(buffer.flush(VoxelResolution::Size_4cm, recorder.callback()), 2u);
+    ASSERT_EQ(recorder.buffer.size(), 2u);
+
+    auto positions = positionsOf(recorder.buffer, 2);
+    EXPECT_EQ(positions.count(std::make_tuple(0.0f, 0.0f, 0.0f)), 1u);
+    EXPECT_EQ(positions.count(std::make_tuple(-0.08f, 0.12f, 0.04f)), 1u);
+    EXPECT_FLOAT_EQ(recorder.buffer[0].size, 0.04f);
+
+    // Nothing changed, so nothing is uploaded
+    recorder.uploads = 0;
+    EXPECT_EQ(buffer.flush(VoxelResolution::Size_4cm, recorder.callback()), 2u);
+    EXPECT_EQ(recorder.uploads, 0u);
+}
+
+TEST_F(VoxelInstanceBufferTest, EventsUploadOnlyChangedSlots) {
+    for (int x = 0; x < 40; x += 4) {
+        grid.setVoxel(Math::Vector3i(x, 0, 0), true);
+    }
+    buffer.sync(grid);
+    UploadRecorder recorder;
+    buffer.flush(VoxelResolution::Size_4cm, recorder.callback());
+
+    setVoxel(Math::Vector3i(0, 4, 0), true);
+    EXPECT_FALSE(buffer.sync(grid));
+    EXPECT_TRUE(buffer.hasPendingChanges(VoxelResolution::Size_4cm));
+
+    EXPECT_EQ(buffer.flush(VoxelResolution::Size_4cm, recorder.callback()), 11u);
+    EXPECT_EQ(recorder.lastFirst, 10u);
+    EXPECT_EQ(recorder.lastCount, 1u);
+}
+
+TEST_F(VoxelInstanceBufferTest, RemovalKeepsListPacked) {
+    for (int x = 0; x < 20; x += 4) {
+        grid.setVoxel(Math::Vector3i(x, 0, 0), true);
+    }
+    buffer.sync(grid);
+    UploadRecorder recorder;
+    buffer.flush(VoxelResolution::Size_4cm, recorder.callback());
+
+    setVoxel(Math::Vector3i(4, 0, 0), false);
+    setVoxel(Math::Vector3i(16, 0, 0), false);
+    EXPECT_FALSE(buffer.sync(grid));
+
+    size_t count = buffer.flush(VoxelResolution::Size_4cm, recorder.callback());
+    ASSERT_EQ(count, 3u);
+    auto positions = positionsOf(recorder.buffer, count);
+    EXPECT_EQ(positions, (std::set<std::tuple<float, float, float>>{
+        std::make_tuple(0.0f, 0.0f, 0.0f),
+        std::make_tuple(0.08f, 0.0f, 0.0f),
+        std::make_tuple(0.12f, 0.0f, 0.0f)}));
+}
+
+TEST_F(VoxelInstanceBufferTest, IncrementalMatchesRebuild) {
+    buffer.sync(grid);
+    UploadRecorder recorder;
+
+    // Mix of adds, removes and repeats, flushing along the way
+    for (int i = 0; i < 200; ++i) {
+        Math::Vector3i pos((i * 7 % 13) * 4, (i % 5) * 4, (i * 3 % 11) * 4);
+        bool value = (i % 3) != 0;
+        if (grid.getVoxel(pos) != value) {
+            setVoxel(pos, value);
+        }
+        if (i % 17 == 0) {
+            buffer.flush(VoxelResolution::Size_4cm, recorder.callback());
+        }
+    }
+    size_t count = buffer.flush(VoxelResolution::Size_4cm, recorder.callback());
+    EXPECT_EQ(count, grid.getVoxelCount());
+
+    VoxelInstanceBuffer fresh;
+    fresh.sync(grid);
+    UploadRecorder expected;
+    fresh.flush(VoxelResolution::Size_4cm, expected.callback());
+
+    EXPECT_EQ(positionsOf(recorder.buffer, count), positionsOf(expected.buffer, expected.buffer.size()));
+}
+
+TEST_F(VoxelInstanceBufferTest, SyncNoticesEditsWithoutEvents) {
+    grid.setVoxel(Math::Vector3i(0, 0, 0), true);
+    buffer.sync(grid);
+
+    grid.clear();
+    EXPECT_TRUE(buffer.sync(grid));
+    EXPECT_EQ(buffer.getInstanceCount(VoxelResolution::Size_4cm), 0u);
+
+    // A different grid at the same resolution is a rebuild too
+    VoxelGrid other(VoxelResolution::Size_4cm, Math::Vector3f(5.0f, 5.0f, 5.0f));
+    EXPECT_TRUE(buffer.sync(other));
+}
+
+TEST_F(VoxelInstanceBufferTest, IgnoresResolutionsNotSynced) {
+    buffer.sync(grid);
+    buffer.handleEvent(change(Math::Vector3i(0, 0, 0), VoxelResolution::Size_16cm, true));
+
+    EXPECT_EQ(buffer.getInstanceCount(VoxelResolution::Size_16cm), 0u);
+    EXPECT_FALSE(buffer.hasPendingChanges(VoxelResolution::Size_16cm));
+
+    // Duplicate add and removing a missing voxel are no-ops
+    setVoxel(Math::Vector3i(0, 0, 0), true);
+    buffer.handleEvent(change(Math::Vector3i(0, 0, 0), VoxelResolution::Size_4cm, true));
+    buffer.handleEvent(change(Math::Vector3i(40, 0, 0), VoxelResolution::Size_4cm, false));
+    EXPECT_EQ(buffer.getInstanceCount(VoxelResolution::Size_4cm), 1u);
+}
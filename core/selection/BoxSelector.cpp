@@ -1,8 +1,10 @@
 #include "BoxSelector.h"
 #include "../../foundation/math/Matrix4f.h"
 #include "../../foundation/logging/Logger.h"
+#include "../../foundation/voxel_math/include/voxel_math/VoxelMathSIMD.h"
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <string>
 
 namespace VoxelEditor {
@@ -32,14 +34,27 @@ SelectionSet BoxSelector::selectFromWorld(const Math::BoundingBox& worldBox,
                                         bool checkExistence) {
     SelectionSet result;
     
-    // If checking existence, use a more efficient approach
+    // If checking existence, only visit voxels the octree has in the box
+    // so the cost follows the voxels found, not the volume swept
     if (checkExistence && m_voxelManager) {
-        // Get all existing voxels of this resolution and filter by box
-        auto allVoxels = m_voxelManager->getAllVoxels(resolution);
-        for (const auto& voxelPos : allVoxels) {
-            VoxelId voxel(voxelPos.incrementPos, voxelPos.resolution);
-            if (isVoxelInBox(voxel, worldBox)) {
-                result.add(voxel);
+        auto candidates = m_voxelManager->getVoxelsInRegion(worldBox, resolution);
+        
+        // Same test as isVoxelInBox, run over the candidates in SIMD batches
+        Math::VoxelMathSIMD::BoundsBuffer bounds;
+        bounds.reserve(candidates.size());
+        for (const auto& voxelPos : candidates) {
+            Math::BoundingBox voxelBounds = VoxelId(voxelPos.incrementPos, voxelPos.resolution).getBounds();
+            bounds.push(voxelBounds.min, voxelBounds.max);
+        }
+        std::unique_ptr<bool[]> inBox(new bool[candidates.size()]);
+        Math::VoxelMathSIMD::testBoundsAgainstBoxSoA(
+            bounds.view(), worldBox.min, worldBox.max,
+            m_includePartial ? Math::VoxelMathSIMD::BoxTest::Intersect : Math::VoxelMathSIMD::BoxTest::Contained,
+            inBox.get(), candidates.size());
+        
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (inBox[i]) {
+                result.add(VoxelId(candidates[i].incrementPos, candidates[i].resolution));
             }
         }
         return result;
@@ -249,6 +264,17 @@ SelectionSet BoxSelector::selectFromGrid(const Math::Vector3i& minGrid,
     Math::Vector3i actualMin = Math::Vector3i::min(minGrid, maxGrid);
     Math::Vector3i actualMax = Math::Vector3i::max(minGrid, maxGrid);
     
+    // Existing voxels come straight from the octree range query
+    if (checkExistence && m_voxelManager) {
+        auto voxels = m_voxelManager->getVoxelsInRange(resolution,
+                                                       Math::IncrementCoordinates(actualMin),
+                                                       Math::IncrementCoordinates(actualMax));
+        for (const auto& voxelPos : voxels) {
+            result.add(VoxelId(voxelPos.incrementPos, voxelPos.resolution));
+        }
+        return result;
+    }
+    
     // Select all voxels in grid range
     for (int x = actualMin.x; x <= actualMax.x; ++x) {
         for (int y = actualMin.y; y <= actualMax.y; ++y) {
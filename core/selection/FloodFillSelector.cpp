@@ -1,18 +1,98 @@
 #include "FloodFillSelector.h"
+#include "SelectionBitmap.h"
 #include "../../foundation/logging/Logger.h"
 #include <algorithm>
+#include <thread>
+#include <unordered_set>
 
 namespace VoxelEditor {
 namespace Selection {
 
 // Default configuration constants
 constexpr size_t DEFAULT_MAX_VOXELS = 1000000;
+// Frontiers smaller than this are expanded on the calling thread
+constexpr size_t PARALLEL_FRONTIER_MIN = 4096;
+
+namespace {
+
+// Occupancy of one resolution, copied out of the octree a brick at a time.
+// Preparing a voxel loads its brick and the 26 around it, so every
+// neighbour lookup from that voxel is answered without touching the
+// manager or its lock. Lookups are read-only and safe across threads.
+class BrickOccupancy {
+public:
+    BrickOccupancy(VoxelData::VoxelDataManager* manager, VoxelData::VoxelResolution resolution,
+                   std::pmr::memory_resource* resource)
+        : m_manager(manager)
+        , m_resolution(resolution)
+        , m_loaded(resource)
+        , m_prepared(resource) {
+    }
+    
+    void prepare(const VoxelId& voxel) {
+        if (!m_manager) return;
+        
+        uint64_t key = SelectionBitmap::brickKey(voxel);
+        if (key == m_lastPrepared || !m_prepared.insert(key).second) {
+            m_lastPrepared = key;
+            return;
+        }
+        m_lastPrepared = key;
+        
+        int bx = voxel.position.x() >> SelectionBitmap::BRICK_SHIFT;
+        int by = voxel.position.y() >> SelectionBitmap::BRICK_SHIFT;
+        int bz = voxel.position.z() >> SelectionBitmap::BRICK_SHIFT;
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dz = -1; dz <= 1; ++dz) {
+                    loadBrick(bx + dx, by + dy, bz + dz);
+                }
+            }
+        }
+    }
+    
+    // Without a manager every position counts as occupied (used by tests)
+    bool contains(const VoxelId& voxel) const {
+        return !m_manager || m_voxels.contains(voxel);
+    }
+    
+private:
+    void loadBrick(int bx, int by, int bz) {
+        Math::Vector3i minPos(bx << SelectionBitmap::BRICK_SHIFT,
+                              by << SelectionBitmap::BRICK_SHIFT,
+                              bz << SelectionBitmap::BRICK_SHIFT);
+        VoxelId corner(Math::IncrementCoordinates(minPos), m_resolution);
+        if (!m_loaded.insert(SelectionBitmap::brickKey(corner)).second) {
+            return;
+        }
+        
+        Math::Vector3i maxPos = minPos + Math::Vector3i(SelectionBitmap::BRICK_SIZE - 1,
+                                                        SelectionBitmap::BRICK_SIZE - 1,
+                                                        SelectionBitmap::BRICK_SIZE - 1);
+        auto voxels = m_manager->getVoxelsInRange(m_resolution,
+                                                  Math::IncrementCoordinates(minPos),
+                                                  Math::IncrementCoordinates(maxPos));
+        for (const auto& voxelPos : voxels) {
+            m_voxels.insert(VoxelId(voxelPos.incrementPos, voxelPos.resolution));
+        }
+    }
+    
+    VoxelData::VoxelDataManager* m_manager;
+    VoxelData::VoxelResolution m_resolution;
+    SelectionBitmap m_voxels;
+    std::pmr::unordered_set<uint64_t> m_loaded;
+    std::pmr::unordered_set<uint64_t> m_prepared;
+    uint64_t m_lastPrepared = ~uint64_t(0);
+};
+
+}
 
 FloodFillSelector::FloodFillSelector(VoxelData::VoxelDataManager* voxelManager)
     : m_voxelManager(voxelManager)
     , m_maxVoxels(DEFAULT_MAX_VOXELS)
     , m_diagonalConnectivity(false)
-    , m_connectivityMode(ConnectivityMode::Face6) {
+    , m_connectivityMode(ConnectivityMode::Face6)
+    , m_threadCount(0) {
 }
 
 SelectionSet FloodFillSelector::selectFloodFill(const VoxelId& seed, FloodFillCriteria criteria) {
@@ -24,11 +104,7 @@ SelectionSet FloodFillSelector::selectFloodFill(const VoxelId& seed, FloodFillCr
         return meetsFloodFillCriteria(current, neighbor, criteria);
     };
     
-    auto shouldStop = [this](const VoxelId& voxel) {
-        return false; // No early stopping
-    };
-    
-    return floodFillInternal(seed, canVisit, shouldStop);
+    return floodFillInternal(seed, canVisit, -1, true);
 }
 
 SelectionSet FloodFillSelector::selectFloodFillCustom(const VoxelId& seed,
@@ -37,15 +113,12 @@ SelectionSet FloodFillSelector::selectFloodFillCustom(const VoxelId& seed,
         return SelectionSet();
     }
     
-    auto canVisit = [this, &predicate](const VoxelId& current, const VoxelId& neighbor) {
-        return voxelExists(neighbor) && predicate(neighbor);
-    };
-    
-    auto shouldStop = [](const VoxelId& voxel) {
-        return false;
+    auto canVisit = [&predicate](const VoxelId& current, const VoxelId& neighbor) {
+        return predicate(neighbor);
     };
     
-    return floodFillInternal(seed, canVisit, shouldStop);
+    // Caller predicates are not required to be thread-safe
+    return floodFillInternal(seed, canVisit, -1, false);
 }
 
 SelectionSet FloodFillSelector::selectFloodFillLimited(const VoxelId& seed,
@@ -55,35 +128,11 @@ SelectionSet FloodFillSelector::selectFloodFillLimited(const VoxelId& seed,
         return SelectionSet();
     }
     
-    SelectionSet result;
-    std::queue<std::pair<VoxelId, int>> toVisit;
-    std::unordered_set<VoxelId> visited;
-    
-    toVisit.push({seed, 0});
-    visited.insert(seed);
-    
-    while (!toVisit.empty() && result.size() < m_maxVoxels) {
-        auto [current, steps] = toVisit.front();
-        toVisit.pop();
-        
-        result.add(current);
-        
-        if (steps >= maxSteps) {
-            continue;
-        }
-        
-        std::vector<VoxelId> neighbors = getNeighbors(current);
-        for (const auto& neighbor : neighbors) {
-            if (visited.find(neighbor) == visited.end() && 
-                voxelExists(neighbor) &&
-                meetsFloodFillCriteria(current, neighbor, criteria)) {
-                visited.insert(neighbor);
-                toVisit.push({neighbor, steps + 1});
-            }
-        }
-    }
+    auto canVisit = [this, criteria](const VoxelId& current, const VoxelId& neighbor) {
+        return meetsFloodFillCriteria(current, neighbor, criteria);
+    };
     
-    return result;
+    return floodFillInternal(seed, canVisit, std::max(maxSteps, 0), true);
 }
 
 SelectionSet FloodFillSelector::selectFloodFillBounded(const VoxelId& seed,
@@ -98,11 +147,7 @@ SelectionSet FloodFillSelector::selectFloodFillBounded(const VoxelId& seed,
                meetsFloodFillCriteria(current, neighbor, criteria);
     };
     
-    auto shouldStop = [](const VoxelId& voxel) {
-        return false;
-    };
-    
-    return floodFillInternal(seed, canVisit, shouldStop);
+    return floodFillInternal(seed, canVisit, -1, true);
 }
 
 SelectionSet FloodFillSelector::selectPlanarFloodFill(const VoxelId& seed,
@@ -116,40 +161,34 @@ SelectionSet FloodFillSelector::selectPlanarFloodFill(const VoxelId& seed,
     Math::Vector3f seedPos = seed.getWorldPosition();
     float planeD = -normalizedNormal.dot(seedPos);
     
-    auto canVisit = [this, &normalizedNormal, planeD, planeTolerance](const VoxelId& current, const VoxelId& neighbor) {
-        if (!voxelExists(neighbor)) return false;
-        
+    auto canVisit = [&normalizedNormal, planeD, planeTolerance](const VoxelId& current, const VoxelId& neighbor) {
         // Check if neighbor is on the same plane
         Math::Vector3f neighborPos = neighbor.getWorldPosition();
         float distance = std::abs(normalizedNormal.dot(neighborPos) + planeD);
         return distance <= planeTolerance;
     };
     
-    auto shouldStop = [](const VoxelId& voxel) {
-        return false;
-    };
-    
-    return floodFillInternal(seed, canVisit, shouldStop);
+    return floodFillInternal(seed, canVisit, -1, true);
 }
 
-std::vector<VoxelId> FloodFillSelector::getNeighbors(const VoxelId& voxel) const {
-    std::vector<VoxelId> neighbors;
+std::vector<Math::Vector3i> FloodFillSelector::getNeighborOffsets() const {
+    std::vector<Math::Vector3i> offsets;
     
     // Face neighbors (6-connectivity)
-    neighbors.emplace_back(Math::Vector3i(voxel.position.x() + 1, voxel.position.y(), voxel.position.z()), voxel.resolution);
-    neighbors.emplace_back(Math::Vector3i(voxel.position.x() - 1, voxel.position.y(), voxel.position.z()), voxel.resolution);
-    neighbors.emplace_back(Math::Vector3i(voxel.position.x(), voxel.position.y() + 1, voxel.position.z()), voxel.resolution);
-    neighbors.emplace_back(Math::Vector3i(voxel.position.x(), voxel.position.y() - 1, voxel.position.z()), voxel.resolution);
-    neighbors.emplace_back(Math::Vector3i(voxel.position.x(), voxel.position.y(), voxel.position.z() + 1), voxel.resolution);
-    neighbors.emplace_back(Math::Vector3i(voxel.position.x(), voxel.position.y(), voxel.position.z() - 1), voxel.resolution);
+    offsets.emplace_back(1, 0, 0);
+    offsets.emplace_back(-1, 0, 0);
+    offsets.emplace_back(0, 1, 0);
+    offsets.emplace_back(0, -1, 0);
+    offsets.emplace_back(0, 0, 1);
+    offsets.emplace_back(0, 0, -1);
     
     if (m_connectivityMode == ConnectivityMode::Edge18 || m_connectivityMode == ConnectivityMode::Vertex26) {
         // Edge neighbors (12 additional for 18-connectivity)
         for (int dx = -1; dx <= 1; dx += 2) {
             for (int dy = -1; dy <= 1; dy += 2) {
-                neighbors.emplace_back(Math::Vector3i(voxel.position.x() + dx, voxel.position.y() + dy, voxel.position.z()), voxel.resolution);
-                neighbors.emplace_back(Math::Vector3i(voxel.position.x() + dx, voxel.position.y(), voxel.position.z() + dy), voxel.resolution);
-                neighbors.emplace_back(Math::Vector3i(voxel.position.x(), voxel.position.y() + dy, voxel.position.z() + dx), voxel.resolution);
+                offsets.emplace_back(dx, dy, 0);
+                offsets.emplace_back(dx, 0, dy);
+                offsets.emplace_back(0, dy, dx);
             }
         }
     }
@@ -159,13 +198,13 @@ std::vector<VoxelId> FloodFillSelector::getNeighbors(const VoxelId& voxel) const
         for (int dx = -1; dx <= 1; dx += 2) {
             for (int dy = -1; dy <= 1; dy += 2) {
                 for (int dz = -1; dz <= 1; dz += 2) {
-                    neighbors.emplace_back(Math::Vector3i(voxel.position.x() + dx, voxel.position.y() + dy, voxel.position.z() + dz), voxel.resolution);
+                    offsets.emplace_back(dx, dy, dz);
                 }
             }
         }
     }
     
-    return neighbors;
+    return offsets;
 }
 
 bool FloodFillSelector::meetsFloodFillCriteria(const VoxelId& current, const VoxelId& neighbor, 
@@ -216,41 +255,99 @@ bool FloodFillSelector::areVoxelsConnected(const VoxelId& voxel1, const VoxelId&
 }
 
 SelectionSet FloodFillSelector::floodFillInternal(const VoxelId& seed,
-                                                 const std::function<bool(const VoxelId&, const VoxelId&)>& canVisit,
-                                                 const std::function<bool(const VoxelId&)>& shouldStop) {
-    SelectionSet result;
-    std::queue<VoxelId> toVisit;
-    std::unordered_set<VoxelId> visited;
+                                                 const VisitPredicate& canVisit,
+                                                 int maxSteps,
+                                                 bool parallel) {
+    // Bookkeeping that dies with the fill lives in the scratch arena. The
+    // candidate lists are filled on worker threads, so they stay on the heap.
+    Memory::FrameArena localArena;
+    Memory::FrameArena& scratch = m_arena ? *m_arena : localArena;
+    Memory::ArenaScope scratchScope(scratch);
+    std::pmr::memory_resource* resource = scratch.getResource();
+    
+    BrickOccupancy occupancy(m_voxelManager, seed.resolution, resource);
+    SelectionBitmap visited;
+    const std::vector<Math::Vector3i> offsets = getNeighborOffsets();
     
-    toVisit.push(seed);
     visited.insert(seed);
+    occupancy.prepare(seed);
     
-    while (!toVisit.empty() && result.size() < m_maxVoxels) {
-        VoxelId current = toVisit.front();
-        toVisit.pop();
-        
-        result.add(current);
+    unsigned int maxThreads = m_threadCount;
+    if (maxThreads == 0) {
+        maxThreads = std::thread::hardware_concurrency();
+        if (maxThreads == 0) maxThreads = 4; // Default to 4 if detection fails
+    }
+    
+    // Collects the unvisited, occupied neighbours of frontier[begin, end)
+    // that canVisit accepts. Only reads shared state.
+    auto expand = [&](const std::pmr::vector<VoxelId>& frontier, size_t begin, size_t end,
+                      std::vector<VoxelId>& out) {
+        for (size_t i = begin; i < end; ++i) {
+            const VoxelId& current = frontier[i];
+            Math::Vector3i base = current.position.value();
+            for (const auto& offset : offsets) {
+                VoxelId neighbor(Math::IncrementCoordinates(base + offset), current.resolution);
+                if (!visited.contains(neighbor) && occupancy.contains(neighbor) &&
+                    canVisit(current, neighbor)) {
+                    out.push_back(neighbor);
+                }
+            }
+        }
+    };
+    
+    std::pmr::vector<VoxelId> frontier({seed}, resource);
+    std::pmr::vector<VoxelId> next(resource);
+    std::vector<std::vector<VoxelId>> candidates;
+    bool limitReached = visited.size() >= m_maxVoxels;
+    
+    for (int step = 0; !frontier.empty() && !limitReached && (maxSteps < 0 || step < maxSteps); ++step) {
+        size_t chunkCount = 1;
+        if (parallel && frontier.size() >= PARALLEL_FRONTIER_MIN) {
+            chunkCount = std::min<size_t>(maxThreads, frontier.size() / (PARALLEL_FRONTIER_MIN / 4));
+        }
+        candidates.resize(chunkCount);
+        for (auto& chunk : candidates) {
+            chunk.clear();
+        }
         
-        if (shouldStop(current)) {
-            break;
+        if (chunkCount == 1) {
+            expand(frontier, 0, frontier.size(), candidates[0]);
+        } else {
+            std::vector<std::thread> workers;
+            size_t chunkSize = (frontier.size() + chunkCount - 1) / chunkCount;
+            for (size_t c = 0; c < chunkCount; ++c) {
+                size_t begin = c * chunkSize;
+                size_t end = std::min(frontier.size(), begin + chunkSize);
+                workers.emplace_back(expand, std::cref(frontier), begin, end, std::ref(candidates[c]));
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
         }
         
-        std::vector<VoxelId> neighbors = getNeighbors(current);
-        for (const auto& neighbor : neighbors) {
-            if (visited.find(neighbor) == visited.end() && 
-                voxelExists(neighbor) &&
-                canVisit(current, neighbor)) {
-                visited.insert(neighbor);
-                toVisit.push(neighbor);
+        // Merge in frontier order; duplicates found by several voxels
+        // collapse on insert
+        next.clear();
+        for (const auto& chunk : candidates) {
+            for (const auto& voxel : chunk) {
+                if (!visited.insert(voxel)) continue;
+                occupancy.prepare(voxel);
+                next.push_back(voxel);
+                if (visited.size() >= m_maxVoxels) {
+                    limitReached = true;
+                    break;
+                }
             }
+            if (limitReached) break;
         }
+        frontier.swap(next);
     }
     
-    if (result.size() >= m_maxVoxels) {
+    if (limitReached) {
         Logging::Logger::getInstance().warning("FloodFillSelector: Reached maximum voxel limit");
     }
     
-    return result;
+    return SelectionSet(std::move(visited));
 }
 
 }
@@ -1,15 +1,21 @@
 #pragma once
 
-#include <queue>
-#include <unordered_set>
+#include <functional>
+#include <memory_resource>
+#include <vector>
 
 #include "SelectionTypes.h"
 #include "SelectionSet.h"
 #include "../voxel_data/VoxelDataManager.h"
+#include "../../foundation/memory/FrameArena.h"
 
 namespace VoxelEditor {
 namespace Selection {
 
+// Flood fill runs level by level over a brick bitmap. Occupancy is pulled
+// from the octree one 16^3 brick at a time as the fill reaches it, and
+// large frontiers are expanded on several threads before being merged into
+// the visited set in frontier order, so results do not depend on timing.
 class FloodFillSelector {
 public:
     explicit FloodFillSelector(VoxelData::VoxelDataManager* voxelManager = nullptr);
@@ -22,7 +28,7 @@ public:
     SelectionSet selectFloodFill(const VoxelId& seed, 
                                FloodFillCriteria criteria = FloodFillCriteria::Connected6);
     
-    // Flood fill with custom predicate
+    // Flood fill with custom predicate (evaluated on the calling thread only)
     SelectionSet selectFloodFillCustom(const VoxelId& seed,
                                      const SelectionPredicate& predicate);
     
@@ -45,6 +51,14 @@ public:
     void setMaxVoxels(size_t max) { m_maxVoxels = max; }
     size_t getMaxVoxels() const { return m_maxVoxels; }
     
+    // Worker threads for large frontiers; 0 uses the hardware concurrency
+    void setThreadCount(unsigned int count) { m_threadCount = count; }
+    unsigned int getThreadCount() const { return m_threadCount; }
+    
+    // Scratch arena for the frontier and brick bookkeeping; it is rewound
+    // before each fill returns. nullptr uses a local arena per fill.
+    void setArena(Memory::FrameArena* arena) { m_arena = arena; }
+    
     void setDiagonalConnectivity(bool enabled) { m_diagonalConnectivity = enabled; }
     bool getDiagonalConnectivity() const { return m_diagonalConnectivity; }
     
@@ -63,18 +77,24 @@ private:
     size_t m_maxVoxels;
     bool m_diagonalConnectivity;
     ConnectivityMode m_connectivityMode;
+    unsigned int m_threadCount;
+    Memory::FrameArena* m_arena = nullptr;
+    
+    using VisitPredicate = std::function<bool(const VoxelId&, const VoxelId&)>;
     
     // Helper methods
-    std::vector<VoxelId> getNeighbors(const VoxelId& voxel) const;
+    std::vector<Math::Vector3i> getNeighborOffsets() const;
     bool meetsFloodFillCriteria(const VoxelId& current, const VoxelId& neighbor, 
                                FloodFillCriteria criteria) const;
     bool voxelExists(const VoxelId& voxel) const;
     bool areVoxelsConnected(const VoxelId& voxel1, const VoxelId& voxel2) const;
     
-    // Internal flood fill implementation
+    // Internal flood fill implementation; maxSteps < 0 means unlimited and
+    // parallel allows canVisit to be called from worker threads
     SelectionSet floodFillInternal(const VoxelId& seed,
-                                 const std::function<bool(const VoxelId&, const VoxelId&)>& canVisit,
-                                 const std::function<bool(const VoxelId&)>& shouldStop);
+                                 const VisitPredicate& canVisit,
+                                 int maxSteps,
+                                 bool parallel);
 };
 
 }
@@ -0,0 +1,377 @@
+#include "SelectionBitmap.h"
+#include <algorithm>
+
+namespace VoxelEditor {
+namespace Selection {
+
+namespace {
+
+using Brick = SelectionBitmap::Brick;
+constexpr uint32_t BRICK_CELLS = SelectionBitmap::BRICK_CELLS;
+
+inline void accumulateCell(Brick& brick, uint16_t cell, int sign) {
+    brick.sum[0] += sign * static_cast<int>(cell >> 8);
+    brick.sum[1] += sign * static_cast<int>((cell >> 4) & 15);
+    brick.sum[2] += sign * static_cast<int>(cell & 15);
+}
+
+inline std::array<int64_t, 3> brickOrigin(uint64_t key) {
+    Math::Vector3i origin = Math::BrickCells::brickOrigin(key);
+    return {origin.x, origin.y, origin.z};
+}
+
+enum class BrickOp { Union, Intersect, Subtract, Xor };
+
+Brick combine(const Brick& a, const Brick& b, BrickOp op) {
+    Brick brick{a.cells};
+    switch (op) {
+        case BrickOp::Union:     brick.cells.unite(b.cells); break;
+        case BrickOp::Intersect: brick.cells.intersect(b.cells); break;
+        case BrickOp::Subtract:  brick.cells.subtract(b.cells); break;
+        case BrickOp::Xor:       brick.cells.symmetricDifference(b.cells); break;
+    }
+    brick.sum = brick.cells.getCellSum();
+    return brick;
+}
+
+} // anonymous namespace
+
+// Brick addressing
+
+uint64_t SelectionBitmap::brickKey(const VoxelId& voxel) {
+    return Math::BrickCells::brickKey(static_cast<uint32_t>(voxel.resolution), voxel.position.value());
+}
+
+uint16_t SelectionBitmap::cellIndex(const VoxelId& voxel) {
+    return Math::BrickCells::cellIndex(voxel.position.value());
+}
+
+VoxelId SelectionBitmap::voxelAt(uint64_t key, uint32_t cell) {
+    return VoxelId(Math::IncrementCoordinates(Math::BrickCells::cellPosition(key, cell)), keyResolution(key));
+}
+
+// Element access
+
+bool SelectionBitmap::insert(const VoxelId& voxel) {
+    uint64_t key = brickKey(voxel);
+    uint16_t cell = cellIndex(voxel);
+
+    auto it = m_bricks.find(key);
+    if (it != m_bricks.end() && it->second->cells.contains(cell)) {
+        return false;
+    }
+
+    // Summaries grow with the voxel
+    size_t resolution = static_cast<size_t>(voxel.resolution);
+    const Math::Vector3i& pos = voxel.position.value();
+    Extent& extent = m_extents[resolution];
+    if (m_countByResolution[resolution] == 0) {
+        extent.min = pos;
+        extent.max = pos;
+        extent.stale = false;
+    } else if (!extent.stale) {
+        extent.min = Math::Vector3i::min(extent.min, pos);
+        extent.max = Math::Vector3i::max(extent.max, pos);
+    }
+    ++m_countByResolution[resolution];
+    m_positionSum[0] += pos.x;
+    m_positionSum[1] += pos.y;
+    m_positionSum[2] += pos.z;
+
+    if (it == m_bricks.end()) {
+        auto brick = std::make_shared<Brick>();
+        brick->cells.insert(cell);
+        accumulateCell(*brick, cell, 1);
+        m_bricks.emplace(key, std::move(brick));
+        ++m_size;
+        return true;
+    }
+
+    Brick& brick = mutableBrick(it);
+    brick.cells.insert(cell);
+    accumulateCell(brick, cell, 1);
+    ++m_size;
+    return true;
+}
+
+bool SelectionBitmap::erase(const VoxelId& voxel) {
+    uint16_t cell = cellIndex(voxel);
+    auto it = m_bricks.find(brickKey(voxel));
+    if (it == m_bricks.end() || !it->second->cells.contains(cell)) {
+        return false;
+    }
+
+    // Summaries shrink; losing a boundary voxel leaves the extent stale
+    size_t resolution = static_cast<size_t>(voxel.resolution);
+    const Math::Vector3i& pos = voxel.position.value();
+    Extent& extent = m_extents[resolution];
+    if (!extent.stale &&
+        (pos.x == extent.min.x || pos.y == extent.min.y || pos.z == extent.min.z ||
+         pos.x == extent.max.x || pos.y == extent.max.y || pos.z == extent.max.z)) {
+        extent.stale = true;
+    }
+    --m_countByResolution[resolution];
+    m_positionSum[0] -= pos.x;
+    m_positionSum[1] -= pos.y;
+    m_positionSum[2] -= pos.z;
+
+    --m_size;
+    if (it->second->cells.size() == 1) {
+        m_bricks.erase(it);
+        return true;
+    }
+
+    Brick& brick = mutableBrick(it);
+    brick.cells.erase(cell);
+    accumulateCell(brick, cell, -1);
+    return true;
+}
+
+bool SelectionBitmap::contains(const VoxelId& voxel) const {
+    auto it = m_bricks.find(brickKey(voxel));
+    return it != m_bricks.end() && it->second->cells.contains(cellIndex(voxel));
+}
+
+void SelectionBitmap::clear() {
+    m_bricks.clear();
+    m_size = 0;
+    m_countByResolution.fill(0);
+    m_positionSum.fill(0);
+}
+
+bool SelectionBitmap::getExtent(VoxelData::VoxelResolution resolution,
+                                Math::Vector3i& minPos, Math::Vector3i& maxPos) const {
+    if (countByResolution(resolution) == 0) {
+        return false;
+    }
+    Extent& extent = m_extents[static_cast<size_t>(resolution)];
+    if (extent.stale) {
+        rebuildExtent(resolution);
+    }
+    minPos = extent.min;
+    maxPos = extent.max;
+    return true;
+}
+
+// Set algebra
+
+void SelectionBitmap::unite(const SelectionBitmap& other) {
+    if (&other == this) {
+        return;
+    }
+
+    for (const auto& [key, brick] : other.m_bricks) {
+        auto it = m_bricks.find(key);
+        if (it == m_bricks.end()) {
+            // Shared until either side modifies it
+            addBrick(key, brick);
+        } else if (it->second != brick) {
+            replaceBrick(it, combine(*it->second, *brick, BrickOp::Union));
+        }
+    }
+}
+
+void SelectionBitmap::intersect(const SelectionBitmap& other) {
+    if (&other == this) {
+        return;
+    }
+
+    for (auto it = m_bricks.begin(); it != m_bricks.end();) {
+        auto otherIt = other.m_bricks.find(it->first);
+        if (otherIt == other.m_bricks.end()) {
+            it = removeBrick(it);
+        } else if (otherIt->second == it->second) {
+            ++it;
+        } else {
+            it = replaceBrick(it, combine(*it->second, *otherIt->second, BrickOp::Intersect));
+        }
+    }
+}
+
+void SelectionBitmap::subtract(const SelectionBitmap& other) {
+    if (&other == this) {
+        clear();
+        return;
+    }
+
+    for (const auto& [key, brick] : other.m_bricks) {
+        auto it = m_bricks.find(key);
+        if (it == m_bricks.end()) {
+            continue;
+        }
+        if (it->second == brick) {
+            removeBrick(it);
+        } else {
+            replaceBrick(it, combine(*it->second, *brick, BrickOp::Subtract));
+        }
+    }
+}
+
+void SelectionBitmap::symmetricDifference(const SelectionBitmap& other) {
+    if (&other == this) {
+        clear();
+        return;
+    }
+
+    for (const auto& [key, brick] : other.m_bricks) {
+        auto it = m_bricks.find(key);
+        if (it == m_bricks.end()) {
+            addBrick(key, brick);
+        } else if (it->second == brick) {
+            removeBrick(it);
+        } else {
+            replaceBrick(it, combine(*it->second, *brick, BrickOp::Xor));
+        }
+    }
+}
+
+bool SelectionBitmap::operator==(const SelectionBitmap& other) const {
+    if (m_size != other.m_size || m_bricks.size() != other.m_bricks.size()) {
+        return false;
+    }
+
+    for (const auto& [key, brick] : m_bricks) {
+        auto it = other.m_bricks.find(key);
+        if (it == other.m_bricks.end() || (it->second != brick && it->second->cells != brick->cells)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t SelectionBitmap::getMemoryUsage() const {
+    // Map node: key, pointer and next link; shared_ptr control block is
+    // allocated together with the brick by make_shared
+    const size_t nodeSize = sizeof(uint64_t) + sizeof(std::shared_ptr<Brick>) + sizeof(void*);
+    const size_t controlSize = 2 * sizeof(void*);
+
+    size_t usage = m_bricks.bucket_count() * sizeof(void*);
+    for (const auto& entry : m_bricks) {
+        const Brick& brick = *entry.second;
+        usage += nodeSize + controlSize + sizeof(Brick) + brick.cells.getMemoryUsage();
+    }
+    return usage;
+}
+
+SelectionBitmap::Brick& SelectionBitmap::mutableBrick(BrickMap::iterator it) {
+    // Copy on write: clone a brick that another selection still references
+    if (it->second.use_count() > 1) {
+        it->second = std::make_shared<Brick>(*it->second);
+    }
+    return *it->second;
+}
+
+SelectionBitmap::BrickMap::iterator SelectionBitmap::replaceBrick(BrickMap::iterator it, Brick&& brick) {
+    if (brick.cells.empty()) {
+        return removeBrick(it);
+    }
+    addSummary(it->first, *it->second, -1);
+    addSummary(it->first, brick, 1);
+    it->second = std::make_shared<Brick>(std::move(brick));
+    return ++it;
+}
+
+void SelectionBitmap::addBrick(uint64_t key, std::shared_ptr<Brick> brick) {
+    addSummary(key, *brick, 1);
+    m_bricks.emplace(key, std::move(brick));
+}
+
+SelectionBitmap::BrickMap::iterator SelectionBitmap::removeBrick(BrickMap::iterator it) {
+    addSummary(it->first, *it->second, -1);
+    return m_bricks.erase(it);
+}
+
+void SelectionBitmap::addSummary(uint64_t key, const Brick& brick, int64_t sign) {
+    size_t resolution = static_cast<size_t>(keyResolution(key));
+    std::array<int64_t, 3> origin = brickOrigin(key);
+    int64_t count = static_cast<int64_t>(brick.cells.size());
+
+    m_size += static_cast<size_t>(sign * count);
+    m_countByResolution[resolution] += static_cast<size_t>(sign * count);
+    for (int axis = 0; axis < 3; ++axis) {
+        m_positionSum[axis] += sign * (count * origin[axis] + static_cast<int64_t>(brick.sum[axis]));
+    }
+    // Whole-brick changes come from set algebra; rebuild the extent on demand
+    m_extents[resolution].stale = true;
+}
+
+void SelectionBitmap::rebuildExtent(VoxelData::VoxelResolution resolution) const {
+    // Outermost brick coordinates first, then only the bricks on those
+    // faces are scanned for their outermost cells
+    int64_t brickLo[3];
+    int64_t brickHi[3];
+    bool first = true;
+    for (const auto& entry : m_bricks) {
+        if (keyResolution(entry.first) != resolution) continue;
+        std::array<int64_t, 3> origin = brickOrigin(entry.first);
+        for (int axis = 0; axis < 3; ++axis) {
+            brickLo[axis] = first ? origin[axis] : std::min(brickLo[axis], origin[axis]);
+            brickHi[axis] = first ? origin[axis] : std::max(brickHi[axis], origin[axis]);
+        }
+        first = false;
+    }
+
+    int64_t lo[3] = {brickHi[0] + BRICK_SIZE, brickHi[1] + BRICK_SIZE, brickHi[2] + BRICK_SIZE};
+    int64_t hi[3] = {brickLo[0] - 1, brickLo[1] - 1, brickLo[2] - 1};
+    for (const auto& entry : m_bricks) {
+        if (keyResolution(entry.first) != resolution) continue;
+        std::array<int64_t, 3> origin = brickOrigin(entry.first);
+        bool onFace = false;
+        for (int axis = 0; axis < 3; ++axis) {
+            onFace = onFace || origin[axis] == brickLo[axis] || origin[axis] == brickHi[axis];
+        }
+        if (!onFace) continue;
+
+        int cellLo[3];
+        int cellHi[3];
+        entry.second->cells.getExtent(cellLo, cellHi);
+        for (int axis = 0; axis < 3; ++axis) {
+            if (origin[axis] == brickLo[axis]) {
+                lo[axis] = std::min(lo[axis], origin[axis] + cellLo[axis]);
+            }
+            if (origin[axis] == brickHi[axis]) {
+                hi[axis] = std::max(hi[axis], origin[axis] + cellHi[axis]);
+            }
+        }
+    }
+
+    Extent& extent = m_extents[static_cast<size_t>(resolution)];
+    extent.min = Math::Vector3i(static_cast<int>(lo[0]), static_cast<int>(lo[1]), static_cast<int>(lo[2]));
+    extent.max = Math::Vector3i(static_cast<int>(hi[0]), static_cast<int>(hi[1]), static_cast<int>(hi[2]));
+    extent.stale = false;
+}
+
+// Iteration
+
+SelectionBitmap::const_iterator::const_iterator(BrickMap::const_iterator it, BrickMap::const_iterator end)
+    : m_it(it)
+    , m_end(end) {
+    settle();
+}
+
+SelectionBitmap::const_iterator& SelectionBitmap::const_iterator::operator++() {
+    ++m_pos;
+    settle();
+    return *this;
+}
+
+SelectionBitmap::const_iterator SelectionBitmap::const_iterator::operator++(int) {
+    const_iterator previous = *this;
+    ++(*this);
+    return previous;
+}
+
+void SelectionBitmap::const_iterator::settle() {
+    while (m_it != m_end) {
+        m_pos = m_it->second->cells.nextCell(m_pos);
+        if (m_pos < BRICK_CELLS) {
+            m_current = voxelAt(m_it->first, m_pos);
+            return;
+        }
+        ++m_it;
+        m_pos = 0;
+    }
+}
+
+}
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "SelectionTypes.h"
+#include "../../foundation/voxel_math/include/voxel_math/BrickCells.h"
+#include <unordered_map>
+#include <array>
+#include <memory>
+#include <vector>
+#include <iterator>
+#include <cstdint>
+
+namespace VoxelEditor {
+namespace Selection {
+
+// Sparse, chunked bitmap of voxel ids. Space is split per resolution into
+// 16x16x16 bricks; each brick stores its cells as a Math::BrickCells,
+// a sorted array of offsets while sparse and a 4096-bit bitmap once dense.
+// Set algebra runs brick by brick, 64 cells per word for bitmaps.
+//
+// Bricks are shared between copies and only cloned when a copy modifies
+// them, so copying a selection (history, named sets, events) costs one
+// pointer per brick rather than one entry per voxel.
+//
+// Per-resolution counts and the sum of voxel positions are kept exact on
+// every change. Positional extents grow on insert and are only marked
+// stale when a voxel on the boundary goes away; they are then rebuilt
+// from brick coordinates, scanning just the bricks on the outer faces.
+class SelectionBitmap {
+public:
+    static constexpr int BRICK_SHIFT = Math::BrickCells::BRICK_SHIFT;
+    static constexpr int BRICK_SIZE = Math::BrickCells::BRICK_SIZE;
+    static constexpr uint32_t BRICK_CELLS = Math::BrickCells::BRICK_CELLS;
+
+    struct Brick {
+        Math::BrickCells cells;
+        std::array<uint32_t, 3> sum{};  // Sum of local cell x, y, z
+    };
+
+    using BrickMap = std::unordered_map<uint64_t, std::shared_ptr<Brick>>;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = VoxelId;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const VoxelId*;
+        using reference = const VoxelId&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return m_current; }
+        pointer operator->() const { return &m_current; }
+        const_iterator& operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator& other) const {
+            return m_it == other.m_it && (m_it == m_end || m_pos == other.m_pos);
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class SelectionBitmap;
+        const_iterator(BrickMap::const_iterator it, BrickMap::const_iterator end);
+        void settle();
+
+        BrickMap::const_iterator m_it;
+        BrickMap::const_iterator m_end;
+        uint32_t m_pos = 0;  // Current cell of the brick
+        VoxelId m_current;
+    };
+
+    // Element access; insert and erase return whether the set changed
+    bool insert(const VoxelId& voxel);
+    bool erase(const VoxelId& voxel);
+    bool contains(const VoxelId& voxel) const;
+    void clear();
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    size_t countByResolution(VoxelData::VoxelResolution resolution) const {
+        return m_countByResolution[static_cast<size_t>(resolution)];
+    }
+    
+    // Sum of all voxel positions, in increments
+    const std::array<int64_t, 3>& getPositionSum() const { return m_positionSum; }
+    // Smallest and largest voxel positions of one resolution; false if none
+    bool getExtent(VoxelData::VoxelResolution resolution, Math::Vector3i& minPos, Math::Vector3i& maxPos) const;
+
+    // In-place set algebra
+    void unite(const SelectionBitmap& other);
+    void intersect(const SelectionBitmap& other);
+    void subtract(const SelectionBitmap& other);
+    void symmetricDifference(const SelectionBitmap& other);
+
+    bool operator==(const SelectionBitmap& other) const;
+    bool operator!=(const SelectionBitmap& other) const { return !(*this == other); }
+
+    const_iterator begin() const { return const_iterator(m_bricks.begin(), m_bricks.end()); }
+    const_iterator end() const { return const_iterator(m_bricks.end(), m_bricks.end()); }
+
+    size_t getBrickCount() const { return m_bricks.size(); }
+    // Heap bytes held by this set; bricks shared with copies count in full
+    size_t getMemoryUsage() const;
+
+    // Brick addressing
+    static uint64_t brickKey(const VoxelId& voxel);
+    static uint16_t cellIndex(const VoxelId& voxel);
+    static VoxelId voxelAt(uint64_t key, uint32_t cell);
+    static VoxelData::VoxelResolution keyResolution(uint64_t key) {
+        return static_cast<VoxelData::VoxelResolution>(key >> 60);
+    }
+
+private:
+    static constexpr size_t RESOLUTION_COUNT = static_cast<size_t>(VoxelData::VoxelResolution::COUNT);
+    
+    struct Extent {
+        Math::Vector3i min;
+        Math::Vector3i max;
+        bool stale = false;
+    };
+    
+    BrickMap m_bricks;
+    size_t m_size = 0;
+    std::array<size_t, RESOLUTION_COUNT> m_countByResolution{};
+    std::array<int64_t, 3> m_positionSum{};
+    mutable std::array<Extent, RESOLUTION_COUNT> m_extents{};
+
+    Brick& mutableBrick(BrickMap::iterator it);
+    BrickMap::iterator replaceBrick(BrickMap::iterator it, Brick&& brick);
+    void addBrick(uint64_t key, std::shared_ptr<Brick> brick);
+    BrickMap::iterator removeBrick(BrickMap::iterator it);
+    void addSummary(uint64_t key, const Brick& brick, int64_t sign);
+    void rebuildExtent(VoxelData::VoxelResolution resolution) const;
+};
+
+}
+}
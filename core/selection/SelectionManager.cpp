@@ -15,6 +15,7 @@ SelectionManager::SelectionManager(VoxelData::VoxelDataManager* voxelManager,
                                  ::VoxelEditor::Events::EventDispatcher* eventDispatcher)
     : m_previewMode(false)
     , m_maxHistorySize(DEFAULT_MAX_HISTORY_SIZE)
+    , m_maxHistoryMemory(0)
     , m_voxelManager(voxelManager)
     , m_eventDispatcher(eventDispatcher) {
 }
@@ -158,6 +159,23 @@ void SelectionManager::selectFloodFill(const VoxelId& seed, FloodFillCriteria cr
     notifySelectionChanged(oldSelection, SelectionChangeType::Replaced);
 }
 
+void SelectionManager::selectIsland(const VoxelId& seed, SelectionMode mode) {
+    if (!m_voxelManager) {
+        return;
+    }
+    
+    auto island = m_voxelManager->getConnectedVoxels(seed.position, seed.resolution);
+    if (island.empty()) {
+        return;
+    }
+    
+    SelectionSet islandSelection;
+    for (const auto& voxel : island) {
+        islandSelection.add(VoxelId(voxel.incrementPos, voxel.resolution));
+    }
+    select(islandSelection, mode);
+}
+
 void SelectionManager::select(const SelectionSet& selection, SelectionMode mode) {
     SelectionSet oldSelection = m_currentSelection;
     applySelectionMode(selection, mode);
@@ -229,6 +247,35 @@ void SelectionManager::clearHistory() {
     m_redoStack.clear();
 }
 
+void SelectionManager::setMaxHistoryMemory(size_t bytes) {
+    m_maxHistoryMemory = bytes;
+    trimHistory();
+}
+
+size_t SelectionManager::getHistoryMemoryUsage() const {
+    size_t usage = 0;
+    for (const auto& selection : m_undoStack) {
+        usage += selection.getMemoryUsage();
+    }
+    for (const auto& selection : m_redoStack) {
+        usage += selection.getMemoryUsage();
+    }
+    return usage;
+}
+
+size_t SelectionManager::releaseHistoryMemory(size_t bytes) {
+    size_t freed = 0;
+    while (freed < bytes && !m_undoStack.empty()) {
+        freed += m_undoStack.front().getMemoryUsage();
+        m_undoStack.pop_front();
+    }
+    while (freed < bytes && !m_redoStack.empty()) {
+        freed += m_redoStack.front().getMemoryUsage();
+        m_redoStack.pop_front();
+    }
+    return freed;
+}
+
 void SelectionManager::saveSelectionSet(const std::string& name) {
     m_namedSets[name] = m_currentSelection;
 }
@@ -367,6 +414,13 @@ void SelectionManager::trimHistory() {
         // Remove oldest item (front of deque)
         m_undoStack.pop_front();
     }
+    
+    if (m_maxHistoryMemory > 0) {
+        size_t usage = getHistoryMemoryUsage();
+        if (usage > m_maxHistoryMemory) {
+            releaseHistoryMemory(usage - m_maxHistoryMemory);
+        }
+    }
 }
 
 bool SelectionManager::voxelExists(const VoxelId& voxel) const {
@@ -39,6 +39,9 @@ public:
     void selectCylinder(const Math::Vector3f& base, const Math::Vector3f& direction, 
                        float radius, float height, VoxelData::VoxelResolution resolution);
     void selectFloodFill(const VoxelId& seed, FloodFillCriteria criteria = FloodFillCriteria::Connected6);
+    // Face-connected island of the seed, looked up in the voxel data's
+    // cached connectivity rather than flooded outward
+    void selectIsland(const VoxelId& seed, SelectionMode mode = SelectionMode::Replace);
     
     // Selection with mode
     void select(const SelectionSet& selection, SelectionMode mode = SelectionMode::Replace);
@@ -63,6 +66,15 @@ public:
     void clearHistory();
     void setMaxHistorySize(size_t size) { m_maxHistorySize = size; }
     size_t getMaxHistorySize() const { return m_maxHistorySize; }
+    // Byte cap on undo and redo states, applied on every push; 0 = no cap
+    void setMaxHistoryMemory(size_t bytes);
+    size_t getMaxHistoryMemory() const { return m_maxHistoryMemory; }
+    // The history is not locked: these run on the thread that edits the
+    // selection (the main loop, which also drives the memory governor)
+    size_t getHistoryMemoryUsage() const;
+    // Drops the oldest undo states, then the furthest redo states, until at
+    // least bytes are freed. Returns the bytes freed.
+    size_t releaseHistoryMemory(size_t bytes);
     
     // Selection sets (named selections)
     void saveSelectionSet(const std::string& name);
@@ -111,6 +123,7 @@ private:
     std::deque<SelectionSet> m_undoStack;
     std::deque<SelectionSet> m_redoStack;
     size_t m_maxHistorySize;
+    size_t m_maxHistoryMemory;
     
     // Named selection sets
     std::unordered_map<std::string, SelectionSet> m_namedSets;
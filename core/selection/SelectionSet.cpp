@@ -1,5 +1,6 @@
 #include "SelectionSet.h"
 #include "../../core/file_io/include/file_io/BinaryIO.h"
+#include <limits>
 #include <numeric>
 #include <stdexcept>
 
@@ -16,61 +17,44 @@ SelectionSet::SelectionSet(std::initializer_list<VoxelId> voxels) {
     }
 }
 
+SelectionSet::SelectionSet(SelectionBitmap voxels)
+    : m_voxels(std::move(voxels)) {
+}
+
 void SelectionSet::add(const VoxelId& voxel) {
-    if (m_voxels.insert(voxel).second) {
-        invalidateCache();
-    }
+    m_voxels.insert(voxel);
 }
 
 void SelectionSet::remove(const VoxelId& voxel) {
-    if (m_voxels.erase(voxel) > 0) {
-        invalidateCache();
-    }
+    m_voxels.erase(voxel);
 }
 
 bool SelectionSet::contains(const VoxelId& voxel) const {
-    return m_voxels.find(voxel) != m_voxels.end();
+    return m_voxels.contains(voxel);
 }
 
 void SelectionSet::clear() {
     m_voxels.clear();
-    invalidateCache();
 }
 
 void SelectionSet::addRange(const std::vector<VoxelId>& voxels) {
-    size_t oldSize = m_voxels.size();
-    m_voxels.insert(voxels.begin(), voxels.end());
-    if (m_voxels.size() != oldSize) {
-        invalidateCache();
+    for (const auto& voxel : voxels) {
+        m_voxels.insert(voxel);
     }
 }
 
 void SelectionSet::removeRange(const std::vector<VoxelId>& voxels) {
-    size_t oldSize = m_voxels.size();
     for (const auto& voxel : voxels) {
         m_voxels.erase(voxel);
     }
-    if (m_voxels.size() != oldSize) {
-        invalidateCache();
-    }
 }
 
 void SelectionSet::addSet(const SelectionSet& other) {
-    size_t oldSize = m_voxels.size();
-    m_voxels.insert(other.begin(), other.end());
-    if (m_voxels.size() != oldSize) {
-        invalidateCache();
-    }
+    m_voxels.unite(other.m_voxels);
 }
 
 void SelectionSet::removeSet(const SelectionSet& other) {
-    size_t oldSize = m_voxels.size();
-    for (const auto& voxel : other) {
-        m_voxels.erase(voxel);
-    }
-    if (m_voxels.size() != oldSize) {
-        invalidateCache();
-    }
+    m_voxels.subtract(other.m_voxels);
 }
 
 SelectionSet SelectionSet::unionWith(const SelectionSet& other) const {
@@ -80,12 +64,8 @@ SelectionSet SelectionSet::unionWith(const SelectionSet& other) const {
 }
 
 SelectionSet SelectionSet::intersectWith(const SelectionSet& other) const {
-    SelectionSet result;
-    for (const auto& voxel : m_voxels) {
-        if (other.contains(voxel)) {
-            result.add(voxel);
-        }
-    }
+    SelectionSet result(*this);
+    result.intersect(other);
     return result;
 }
 
@@ -96,22 +76,8 @@ SelectionSet SelectionSet::subtract(const SelectionSet& other) const {
 }
 
 SelectionSet SelectionSet::symmetricDifference(const SelectionSet& other) const {
-    SelectionSet result;
-    
-    // Add elements in this but not in other
-    for (const auto& voxel : m_voxels) {
-        if (!other.contains(voxel)) {
-            result.add(voxel);
-        }
-    }
-    
-    // Add elements in other but not in this
-    for (const auto& voxel : other) {
-        if (!contains(voxel)) {
-            result.add(voxel);
-        }
-    }
-    
+    SelectionSet result(*this);
+    result.m_voxels.symmetricDifference(other.m_voxels);
     return result;
 }
 
@@ -120,14 +86,7 @@ void SelectionSet::unite(const SelectionSet& other) {
 }
 
 void SelectionSet::intersect(const SelectionSet& other) {
-    std::unordered_set<VoxelId> result;
-    for (const auto& voxel : m_voxels) {
-        if (other.contains(voxel)) {
-            result.insert(voxel);
-        }
-    }
-    m_voxels = std::move(result);
-    invalidateCache();
+    m_voxels.intersect(other.m_voxels);
 }
 
 void SelectionSet::subtractFrom(const SelectionSet& other) {
@@ -135,21 +94,59 @@ void SelectionSet::subtractFrom(const SelectionSet& other) {
 }
 
 std::vector<VoxelId> SelectionSet::toVector() const {
-    return std::vector<VoxelId>(m_voxels.begin(), m_voxels.end());
+    std::vector<VoxelId> result;
+    result.reserve(m_voxels.size());
+    result.insert(result.end(), m_voxels.begin(), m_voxels.end());
+    return result;
 }
 
 Math::BoundingBox SelectionSet::getBounds() const {
-    if (!m_cachedBounds.has_value()) {
-        updateCache();
+    if (empty()) {
+        return Math::BoundingBox();
     }
-    return m_cachedBounds.value();
+    
+    // Voxel positions are bottom-center; each resolution's extent widens
+    // by half its size sideways and its full size upwards
+    Math::Vector3f minPos(std::numeric_limits<float>::max());
+    Math::Vector3f maxPos(std::numeric_limits<float>::lowest());
+    for (int i = 0; i < static_cast<int>(VoxelData::VoxelResolution::COUNT); ++i) {
+        VoxelData::VoxelResolution resolution = static_cast<VoxelData::VoxelResolution>(i);
+        Math::Vector3i minIncrement, maxIncrement;
+        if (!m_voxels.getExtent(resolution, minIncrement, maxIncrement)) {
+            continue;
+        }
+        
+        float voxelSize = VoxelData::getVoxelSize(resolution);
+        float halfSize = voxelSize * 0.5f;
+        Math::Vector3f low = Math::CoordinateConverter::incrementToWorld(Math::IncrementCoordinates(minIncrement)).value();
+        Math::Vector3f high = Math::CoordinateConverter::incrementToWorld(Math::IncrementCoordinates(maxIncrement)).value();
+        minPos = Math::Vector3f::min(minPos, Math::Vector3f(low.x - halfSize, low.y, low.z - halfSize));
+        maxPos = Math::Vector3f::max(maxPos, Math::Vector3f(high.x + halfSize, high.y + voxelSize, high.z + halfSize));
+    }
+    return Math::BoundingBox(minPos, maxPos);
 }
 
 Math::Vector3f SelectionSet::getCenter() const {
-    if (!m_cachedCenter.has_value()) {
-        updateCache();
+    if (empty()) {
+        return Math::Vector3f::Zero();
+    }
+    
+    // Mean of voxel centers: summed bottom-center positions plus half of
+    // each voxel's height
+    const std::array<int64_t, 3>& sum = m_voxels.getPositionSum();
+    double lift = 0.0;
+    for (int i = 0; i < static_cast<int>(VoxelData::VoxelResolution::COUNT); ++i) {
+        VoxelData::VoxelResolution resolution = static_cast<VoxelData::VoxelResolution>(i);
+        lift += 0.5 * VoxelData::getVoxelSize(resolution) * static_cast<double>(m_voxels.countByResolution(resolution));
     }
-    return m_cachedCenter.value();
+    
+    double count = static_cast<double>(m_voxels.size());
+    double cmToMeters = Math::CoordinateConverter::CM_TO_METERS;
+    return Math::Vector3f(
+        static_cast<float>(sum[0] * cmToMeters / count),
+        static_cast<float>((sum[1] * cmToMeters + lift) / count),
+        static_cast<float>(sum[2] * cmToMeters / count)
+    );
 }
 
 SelectionStats SelectionSet::getStats() const {
@@ -160,11 +157,15 @@ SelectionStats SelectionSet::getStats() const {
         return stats;
     }
     
-    // Count by resolution and calculate volume
-    for (const auto& voxel : m_voxels) {
-        stats.countByResolution[voxel.resolution]++;
-        float voxelSize = voxel.getVoxelSize();
-        stats.totalVolume += voxelSize * voxelSize * voxelSize;
+    // Count by resolution and calculate volume; counts come per brick
+    for (int i = 0; i < static_cast<int>(VoxelData::VoxelResolution::COUNT); ++i) {
+        VoxelData::VoxelResolution resolution = static_cast<VoxelData::VoxelResolution>(i);
+        size_t count = m_voxels.countByResolution(resolution);
+        if (count > 0) {
+            stats.countByResolution[resolution] = count;
+            float voxelSize = VoxelData::getVoxelSize(resolution);
+            stats.totalVolume += voxelSize * voxelSize * voxelSize * static_cast<float>(count);
+        }
     }
     
     stats.bounds = getBounds();
@@ -184,14 +185,13 @@ SelectionSet SelectionSet::filter(const SelectionPredicate& predicate) const {
 }
 
 void SelectionSet::filterInPlace(const SelectionPredicate& predicate) {
-    std::unordered_set<VoxelId> filtered;
+    SelectionBitmap filtered;
     for (const auto& voxel : m_voxels) {
         if (predicate(voxel)) {
             filtered.insert(voxel);
         }
     }
     m_voxels = std::move(filtered);
-    invalidateCache();
 }
 
 void SelectionSet::forEach(const SelectionVisitor& visitor) const {
@@ -208,34 +208,6 @@ bool SelectionSet::operator!=(const SelectionSet& other) const {
     return !(*this == other);
 }
 
-void SelectionSet::invalidateCache() const {
-    m_cachedBounds.reset();
-    m_cachedCenter.reset();
-}
-
-void SelectionSet::updateCache() const {
-    if (empty()) {
-        m_cachedBounds = Math::BoundingBox();
-        m_cachedCenter = Math::Vector3f::Zero();
-        return;
-    }
-    
-    // Calculate bounds and center
-    Math::Vector3f minPos(std::numeric_limits<float>::max());
-    Math::Vector3f maxPos(std::numeric_limits<float>::lowest());
-    Math::Vector3f totalPos = Math::Vector3f::Zero();
-    
-    for (const auto& voxel : m_voxels) {
-        Math::BoundingBox voxelBounds = voxel.getBounds();
-        minPos = Math::Vector3f::min(minPos, voxelBounds.min);
-        maxPos = Math::Vector3f::max(maxPos, voxelBounds.max);
-        totalPos = totalPos + voxel.getWorldPosition();
-    }
-    
-    m_cachedBounds = Math::BoundingBox(minPos, maxPos);
-    m_cachedCenter = totalPos / static_cast<float>(m_voxels.size());
-}
-
 // Utility function implementations
 SelectionSet makeBoxSelection(const Math::BoundingBox& box, VoxelData::VoxelResolution resolution) {
     SelectionSet result;
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "SelectionTypes.h"
-#include <unordered_set>
+#include "SelectionBitmap.h"
 #include <vector>
 #include <algorithm>
 
@@ -21,6 +21,7 @@ public:
     SelectionSet() = default;
     SelectionSet(const std::vector<VoxelId>& voxels);
     SelectionSet(std::initializer_list<VoxelId> voxels);
+    explicit SelectionSet(SelectionBitmap voxels);
     ~SelectionSet() = default;
     
     // Basic operations
@@ -58,16 +59,17 @@ public:
     SelectionSet filter(const SelectionPredicate& predicate) const;
     void filterInPlace(const SelectionPredicate& predicate);
     
-    // Iteration
-    using iterator = std::unordered_set<VoxelId>::iterator;
-    using const_iterator = std::unordered_set<VoxelId>::const_iterator;
+    // Memory held by the selection; copies share storage until modified
+    size_t getMemoryUsage() const { return sizeof(*this) + m_voxels.getMemoryUsage(); }
+    
+    // Iteration (read-only, in brick order)
+    using const_iterator = SelectionBitmap::const_iterator;
+    using iterator = const_iterator;
     
-    iterator begin() { return m_voxels.begin(); }
-    iterator end() { return m_voxels.end(); }
     const_iterator begin() const { return m_voxels.begin(); }
     const_iterator end() const { return m_voxels.end(); }
-    const_iterator cbegin() const { return m_voxels.cbegin(); }
-    const_iterator cend() const { return m_voxels.cend(); }
+    const_iterator cbegin() const { return m_voxels.begin(); }
+    const_iterator cend() const { return m_voxels.end(); }
     
     // Visitor pattern
     void forEach(const SelectionVisitor& visitor) const;
@@ -81,12 +83,9 @@ public:
     void deserialize(FileIO::BinaryReader& reader);
     
 private:
-    std::unordered_set<VoxelId> m_voxels;
-    mutable std::optional<Math::BoundingBox> m_cachedBounds;
-    mutable std::optional<Math::Vector3f> m_cachedCenter;
-    
-    void invalidateCache() const;
-    void updateCache() const;
+    // Counts, position sums and extents are maintained by the bitmap, so
+    // bounds, center and stats never rescan the voxels
+    SelectionBitmap m_voxels;
 };
 
 // Utility functions
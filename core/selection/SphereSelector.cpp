@@ -1,7 +1,9 @@
 #include "SphereSelector.h"
 #include "../../foundation/logging/Logger.h"
 #include "../../foundation/math/CoordinateConverter.h"
+#include "../../foundation/voxel_math/include/voxel_math/VoxelMathSIMD.h"
 #include <algorithm>
+#include <memory>
 
 namespace VoxelEditor {
 namespace Selection {
@@ -20,14 +22,33 @@ SelectionSet SphereSelector::selectFromSphere(const Math::Vector3f& center,
                                             bool checkExistence) {
     SelectionSet result;
     
-    // If checking existence, use a more efficient approach
+    // If checking existence, only test the voxels inside the sphere's bounds
     if (checkExistence && m_voxelManager) {
-        // Get all existing voxels of this resolution and filter by sphere
-        auto allVoxels = m_voxelManager->getAllVoxels(resolution);
-        for (const auto& voxelPos : allVoxels) {
+        Math::Vector3f radiusVec(radius, radius, radius);
+        auto candidates = m_voxelManager->getVoxelsInRegion(
+            Math::BoundingBox(center - radiusVec, center + radiusVec), resolution);
+        
+        // Same test as isVoxelInSphere, run over the candidates in SIMD
+        // batches; without partial selection each voxel is its center point
+        Math::VoxelMathSIMD::BoundsBuffer bounds;
+        bounds.reserve(candidates.size());
+        for (const auto& voxelPos : candidates) {
             VoxelId voxel(voxelPos.incrementPos, voxelPos.resolution);
-            if (isVoxelInSphere(voxel, center, radius)) {
-                result.add(voxel);
+            if (m_includePartial) {
+                Math::BoundingBox voxelBounds = voxel.getBounds();
+                bounds.push(voxelBounds.min, voxelBounds.max);
+            } else {
+                Math::Vector3f voxelCenter = voxel.getWorldPosition();
+                bounds.push(voxelCenter, voxelCenter);
+            }
+        }
+        std::unique_ptr<bool[]> inSphere(new bool[candidates.size()]);
+        Math::VoxelMathSIMD::testBoundsAgainstSphereSoA(bounds.view(), center, radius,
+                                                        inSphere.get(), candidates.size());
+        
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (inSphere[i]) {
+                result.add(VoxelId(candidates[i].incrementPos, candidates[i].resolution));
             }
         }
         return result;
@@ -170,6 +191,17 @@ SelectionSet SphereSelector::selectEllipsoid(const Math::Vector3f& center,
     Math::Vector3f radiusVec(maxRadius, maxRadius, maxRadius);
     Math::BoundingBox ellipsoidBounds(center - radiusVec, center + radiusVec);
     
+    if (checkExistence && m_voxelManager) {
+        auto candidates = m_voxelManager->getVoxelsInRegion(ellipsoidBounds, resolution);
+        for (const auto& voxelPos : candidates) {
+            VoxelId voxel(voxelPos.incrementPos, voxelPos.resolution);
+            if (isVoxelInEllipsoid(voxel, center, radii, rotation)) {
+                result.add(voxel);
+            }
+        }
+        return result;
+    }
+    
     // Convert world bounds to increment coordinates for iteration
     Math::IncrementCoordinates minIncrement = Math::CoordinateConverter::worldToIncrement(
         Math::WorldCoordinates(ellipsoidBounds.min)
@@ -248,6 +280,17 @@ SelectionSet SphereSelector::selectHemisphere(const Math::Vector3f& center,
     Math::Vector3f radiusVec(radius, radius, radius);
     Math::BoundingBox hemisphereBounds(center - radiusVec, center + radiusVec);
     
+    if (checkExistence && m_voxelManager) {
+        auto candidates = m_voxelManager->getVoxelsInRegion(hemisphereBounds, resolution);
+        for (const auto& voxelPos : candidates) {
+            VoxelId voxel(voxelPos.incrementPos, voxelPos.resolution);
+            if (isVoxelInHemisphere(voxel, center, radius, normalizedNormal)) {
+                result.add(voxel);
+            }
+        }
+        return result;
+    }
+    
     // Convert world bounds to increment coordinates for iteration
     Math::IncrementCoordinates minIncrement = Math::CoordinateConverter::worldToIncrement(
         Math::WorldCoordinates(hemisphereBounds.min)
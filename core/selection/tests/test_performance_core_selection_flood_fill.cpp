@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include "core/selection/FloodFillSelector.h"
+#include "core/voxel_data/VoxelDataManager.h"
+
+using namespace VoxelEditor;
+using namespace VoxelEditor::Selection;
+
+class FloodFillPerformanceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        voxelManager = std::make_unique<VoxelData::VoxelDataManager>();
+        selector = std::make_unique<FloodFillSelector>(voxelManager.get());
+        selector->setMaxVoxels(4000000);
+    }
+    
+    // Solid cube of 1cm voxels, side cm long, with its corner at the origin
+    void fillCube(int side) {
+        float extent = (side - 1) * 0.01f;
+        Math::BoundingBox region(Math::Vector3f(0.0f, 0.0f, 0.0f), Math::Vector3f(extent, extent, extent));
+        auto fill = voxelManager->fillRegion(region, VoxelData::VoxelResolution::Size_1cm);
+        ASSERT_EQ(fill.voxelsFilled, static_cast<size_t>(side) * side * side);
+    }
+    
+    std::unique_ptr<VoxelData::VoxelDataManager> voxelManager;
+    std::unique_ptr<FloodFillSelector> selector;
+};
+
+TEST_F(FloodFillPerformanceTest, MillionVoxelComponent) {
+    fillCube(100);
+    // A separate voxel that must not be reached
+    ASSERT_TRUE(voxelManager->setVoxel(Math::IncrementCoordinates(150, 0, 0), VoxelData::VoxelResolution::Size_1cm, true));
+    
+    VoxelId seed(Math::IncrementCoordinates(50, 50, 50), VoxelData::VoxelResolution::Size_1cm);
+    
+    auto startTime = std::chrono::high_resolution_clock::now();
+    SelectionSet result = selector->selectFloodFill(seed, FloodFillCriteria::Connected6);
+    double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    
+    std::cout << "Flood fill of " << result.size() << " voxels took " << elapsedMs << " ms" << std::endl;
+    
+    EXPECT_EQ(result.size(), 1000000u);
+    EXPECT_FALSE(result.contains(VoxelId(Math::IncrementCoordinates(150, 0, 0), VoxelData::VoxelResolution::Size_1cm)));
+    EXPECT_LT(elapsedMs, 1000.0);
+}
+
+TEST_F(FloodFillPerformanceTest, ThreadCountDoesNotChangeResult) {
+    fillCube(40);
+    VoxelId seed(Math::IncrementCoordinates(0, 0, 0), VoxelData::VoxelResolution::Size_1cm);
+    selector->setConnectivityMode(FloodFillSelector::ConnectivityMode::Vertex26);
+    
+    selector->setThreadCount(1);
+    SelectionSet serial = selector->selectFloodFillLimited(seed, FloodFillCriteria::Connected26, 30);
+    selector->setThreadCount(8);
+    SelectionSet parallel = selector->selectFloodFillLimited(seed, FloodFillCriteria::Connected26, 30);
+    
+    EXPECT_GT(serial.size(), 10000u);
+    EXPECT_EQ(serial, parallel);
+}
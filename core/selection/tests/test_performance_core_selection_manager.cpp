@@ -214,4 +214,30 @@ TEST_F(SelectionPerformanceTest, FloodFillMaximumStress) {
     
     EXPECT_EQ(result.size(), 10000u);  // Should hit the limit
     EXPECT_LT(duration.count(), 30000);  // Should complete within 30 seconds even at limit
-}
\ No newline at end of file
+}
+
+// Live drag selection queries bounds and stats after every change
+TEST_F(SelectionPerformanceTest, StatsDuringGrowingSelection) {
+    const int side = 40;  // 64,000 voxels
+    
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) {
+            for (int z = 0; z < side; ++z) {
+                manager->selectVoxel(VoxelId(Math::IncrementCoordinates(x, y, z), VoxelData::VoxelResolution::Size_1cm));
+                Math::BoundingBox bounds = manager->getSelectionBounds();
+                SelectionStats stats = manager->getSelectionStats();
+                ASSERT_GE(bounds.max.x, bounds.min.x);
+                ASSERT_GT(stats.voxelCount, 0u);
+            }
+        }
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    
+    SelectionStats stats = manager->getSelectionStats();
+    EXPECT_EQ(stats.voxelCount, static_cast<size_t>(side * side * side));
+    EXPECT_NEAR(stats.bounds.max.x, 0.395f, 1e-4f);
+    EXPECT_NEAR(stats.center.y, 0.2f, 1e-4f);
+    EXPECT_LT(duration.count(), 2000);  // Per-change queries must not rescan the selection
+}
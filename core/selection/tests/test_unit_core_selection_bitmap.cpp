@@ -0,0 +1,307 @@
+#include <gtest/gtest.h>
+#include "core/selection/SelectionBitmap.h"
+#include "core/selection/SelectionSet.h"
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+
+using namespace VoxelEditor;
+using namespace VoxelEditor::Selection;
+
+class SelectionBitmapTest : public ::testing::Test {
+protected:
+    static VoxelId voxelAt(int x, int y, int z,
+                           VoxelData::VoxelResolution resolution = VoxelData::VoxelResolution::Size_1cm) {
+        return VoxelId(Math::IncrementCoordinates(x, y, z), resolution);
+    }
+
+    static std::set<VoxelId> toSet(const SelectionBitmap& bitmap) {
+        return std::set<VoxelId>(bitmap.begin(), bitmap.end());
+    }
+
+    // Random voxels in a small region so bricks mix sparse and dense contents
+    static std::set<VoxelId> randomVoxels(std::mt19937& rng, size_t count, int extent) {
+        std::uniform_int_distribution<int> coord(-extent, extent);
+        std::uniform_int_distribution<int> res(0, 1);
+        std::set<VoxelId> voxels;
+        while (voxels.size() < count) {
+            voxels.insert(voxelAt(coord(rng), coord(rng), coord(rng),
+                                  static_cast<VoxelData::VoxelResolution>(res(rng))));
+        }
+        return voxels;
+    }
+
+    static SelectionBitmap fromSet(const std::set<VoxelId>& voxels) {
+        SelectionBitmap bitmap;
+        for (const auto& voxel : voxels) {
+            bitmap.insert(voxel);
+        }
+        return bitmap;
+    }
+};
+
+TEST_F(SelectionBitmapTest, InsertEraseContains) {
+    SelectionBitmap bitmap;
+    VoxelId a = voxelAt(0, 0, 0);
+    VoxelId b = voxelAt(-1, -17, 33);
+    VoxelId c = voxelAt(-1, -17, 33, VoxelData::VoxelResolution::Size_4cm);
+
+    EXPECT_TRUE(bitmap.insert(a));
+    EXPECT_TRUE(bitmap.insert(b));
+    EXPECT_TRUE(bitmap.insert(c));
+    EXPECT_FALSE(bitmap.insert(b));
+    EXPECT_EQ(bitmap.size(), 3u);
+
+    EXPECT_TRUE(bitmap.contains(b));
+    EXPECT_TRUE(bitmap.contains(c));
+    EXPECT_FALSE(bitmap.contains(voxelAt(-1, -17, 32)));
+
+    // Negative coordinates round-trip through brick addressing
+    std::set<VoxelId> expected = {a, b, c};
+    EXPECT_EQ(toSet(bitmap), expected);
+
+    EXPECT_TRUE(bitmap.erase(b));
+    EXPECT_FALSE(bitmap.erase(b));
+    EXPECT_EQ(bitmap.size(), 2u);
+    EXPECT_EQ(bitmap.countByResolution(VoxelData::VoxelResolution::Size_1cm), 1u);
+    EXPECT_EQ(bitmap.countByResolution(VoxelData::VoxelResolution::Size_4cm), 1u);
+}
+
+TEST_F(SelectionBitmapTest, DenseBrickPromotionAndDemotion) {
+    SelectionBitmap bitmap;
+    for (int x = 0; x < 16; ++x) {
+        for (int y = 0; y < 16; ++y) {
+            for (int z = 0; z < 16; ++z) {
+                bitmap.insert(voxelAt(x, y, z));
+            }
+        }
+    }
+    EXPECT_EQ(bitmap.size(), SelectionBitmap::BRICK_CELLS);
+    EXPECT_EQ(bitmap.getBrickCount(), 1u);
+    size_t denseMemory = bitmap.getMemoryUsage();
+    EXPECT_LT(denseMemory, 1024u);
+
+    // Clear most of the brick again; contents stay exact across the switch
+    for (int x = 0; x < 16; ++x) {
+        for (int y = 0; y < 16; ++y) {
+            for (int z = 0; z < 16; ++z) {
+                if (x != 3) {
+                    bitmap.erase(voxelAt(x, y, z));
+                }
+            }
+        }
+    }
+    EXPECT_EQ(bitmap.size(), 256u);
+    EXPECT_TRUE(bitmap.contains(voxelAt(3, 15, 15)));
+    EXPECT_FALSE(bitmap.contains(voxelAt(4, 0, 0)));
+    EXPECT_EQ(toSet(bitmap).size(), 256u);
+}
+
+TEST_F(SelectionBitmapTest, SetAlgebraMatchesReference) {
+    std::mt19937 rng(1234);
+    for (int round = 0; round < 4; ++round) {
+        std::set<VoxelId> left = randomVoxels(rng, 3000, 12);
+        std::set<VoxelId> right = randomVoxels(rng, 3000, 12);
+        SelectionBitmap a = fromSet(left);
+        SelectionBitmap b = fromSet(right);
+
+        std::set<VoxelId> expected;
+        std::set_union(left.begin(), left.end(), right.begin(), right.end(),
+                       std::inserter(expected, expected.end()));
+        SelectionBitmap result = a;
+        result.unite(b);
+        EXPECT_EQ(toSet(result), expected);
+        EXPECT_EQ(result.size(), expected.size());
+
+        expected.clear();
+        std::set_intersection(left.begin(), left.end(), right.begin(), right.end(),
+                              std::inserter(expected, expected.end()));
+        result = a;
+        result.intersect(b);
+        EXPECT_EQ(toSet(result), expected);
+        EXPECT_EQ(result.size(), expected.size());
+
+        expected.clear();
+        std::set_difference(left.begin(), left.end(), right.begin(), right.end(),
+                            std::inserter(expected, expected.end()));
+        result = a;
+        result.subtract(b);
+        EXPECT_EQ(toSet(result), expected);
+        EXPECT_EQ(result.size(), expected.size());
+
+        expected.clear();
+        std::set_symmetric_difference(left.begin(), left.end(), right.begin(), right.end(),
+                                      std::inserter(expected, expected.end()));
+        result = a;
+        result.symmetricDifference(b);
+        EXPECT_EQ(toSet(result), expected);
+        EXPECT_EQ(result.size(), expected.size());
+    }
+}
+
+TEST_F(SelectionBitmapTest, EqualityIgnoresRepresentation) {
+    SelectionBitmap dense;
+    SelectionBitmap sparse;
+    for (int i = 0; i < 300; ++i) {
+        dense.insert(voxelAt(i % 16, (i / 16) % 16, i / 256));
+    }
+    // Removing down to the demotion threshold keeps the bitmap form
+    for (int i = 200; i < 300; ++i) {
+        dense.erase(voxelAt(i % 16, (i / 16) % 16, i / 256));
+    }
+    for (int i = 0; i < 200; ++i) {
+        sparse.insert(voxelAt(i % 16, (i / 16) % 16, i / 256));
+    }
+    EXPECT_EQ(dense, sparse);
+
+    sparse.erase(voxelAt(0, 0, 0));
+    EXPECT_NE(dense, sparse);
+}
+
+TEST_F(SelectionBitmapTest, CopiesShareUntilModified) {
+    SelectionSet original = makeBoxSelection(
+        Math::BoundingBox(Math::Vector3f(0, 0, 0), Math::Vector3f(0.5f, 0.5f, 0.5f)),
+        VoxelData::VoxelResolution::Size_1cm);
+    ASSERT_GT(original.size(), 100000u);
+
+    SelectionSet copy = original;
+    VoxelId extra = voxelAt(-500, 0, 0);
+    copy.add(extra);
+    copy.remove(*original.begin());
+
+    EXPECT_EQ(copy.size(), original.size());
+    EXPECT_TRUE(copy.contains(extra));
+    EXPECT_FALSE(original.contains(extra));
+    EXPECT_TRUE(original.contains(*original.begin()));
+    EXPECT_NE(copy, original);
+
+    // Set algebra on shared bricks short-circuits to the right answer
+    SelectionSet same = original;
+    EXPECT_EQ(original.intersectWith(same), original);
+    EXPECT_TRUE(original.subtract(same).empty());
+    EXPECT_TRUE(original.symmetricDifference(same).empty());
+}
+
+TEST_F(SelectionBitmapTest, MillionVoxelSelectionIsCompact) {
+    SelectionSet selection;
+    for (int x = 0; x < 100; ++x) {
+        for (int y = 0; y < 100; ++y) {
+            for (int z = 0; z < 100; ++z) {
+                selection.add(voxelAt(x, y, z));
+            }
+        }
+    }
+    ASSERT_EQ(selection.size(), 1000000u);
+    EXPECT_LT(selection.getMemoryUsage(), 1024u * 1024u);
+
+    // 4cm voxels on their own grid are 1/64 as dense but still compact
+    SelectionSet coarse;
+    for (int x = 0; x < 400; x += 4) {
+        for (int y = 0; y < 400; y += 4) {
+            for (int z = 0; z < 400; z += 4) {
+                coarse.add(voxelAt(x, y, z, VoxelData::VoxelResolution::Size_4cm));
+            }
+        }
+    }
+    ASSERT_EQ(coarse.size(), 1000000u);
+    EXPECT_LT(coarse.getMemoryUsage(), 16u * 1024u * 1024u);
+}
+
+TEST_F(SelectionBitmapTest, SummariesTrackChanges) {
+    std::mt19937 rng(99);
+    auto check = [](const SelectionBitmap& bitmap) {
+        std::array<int64_t, 3> sum{};
+        std::map<VoxelData::VoxelResolution, std::pair<Math::Vector3i, Math::Vector3i>> extents;
+        std::map<VoxelData::VoxelResolution, size_t> counts;
+        for (const auto& voxel : bitmap) {
+            const Math::Vector3i& pos = voxel.position.value();
+            sum[0] += pos.x;
+            sum[1] += pos.y;
+            sum[2] += pos.z;
+            auto found = extents.find(voxel.resolution);
+            if (found == extents.end()) {
+                extents[voxel.resolution] = {pos, pos};
+            } else {
+                found->second.first = Math::Vector3i::min(found->second.first, pos);
+                found->second.second = Math::Vector3i::max(found->second.second, pos);
+            }
+            ++counts[voxel.resolution];
+        }
+        EXPECT_EQ(bitmap.getPositionSum(), sum);
+        for (int i = 0; i < 2; ++i) {
+            auto resolution = static_cast<VoxelData::VoxelResolution>(i);
+            EXPECT_EQ(bitmap.countByResolution(resolution), counts[resolution]);
+            Math::Vector3i minPos, maxPos;
+            bool hasExtent = bitmap.getExtent(resolution, minPos, maxPos);
+            ASSERT_EQ(hasExtent, extents.count(resolution) > 0);
+            if (hasExtent) {
+                EXPECT_EQ(minPos, extents[resolution].first);
+                EXPECT_EQ(maxPos, extents[resolution].second);
+            }
+        }
+    };
+    
+    std::set<VoxelId> voxels = randomVoxels(rng, 4000, 40);
+    SelectionBitmap bitmap = fromSet(voxels);
+    check(bitmap);
+    
+    // Peel voxels off the outside so the extent has to shrink
+    std::vector<VoxelId> ordered(voxels.begin(), voxels.end());
+    std::sort(ordered.begin(), ordered.end(), [](const VoxelId& a, const VoxelId& b) {
+        return a.position.x() < b.position.x();
+    });
+    for (size_t i = 0; i < 500; ++i) {
+        bitmap.erase(ordered[i]);
+        bitmap.erase(ordered[ordered.size() - 1 - i]);
+    }
+    check(bitmap);
+    
+    SelectionBitmap other = fromSet(randomVoxels(rng, 4000, 60));
+    SelectionBitmap result = bitmap;
+    result.unite(other);
+    check(result);
+    result = bitmap;
+    result.intersect(other);
+    check(result);
+    result = bitmap;
+    result.subtract(other);
+    check(result);
+    result = bitmap;
+    result.symmetricDifference(other);
+    check(result);
+    
+    result.clear();
+    check(result);
+}
+
+TEST_F(SelectionBitmapTest, SelectionBoundsAndCenterMatchVoxels) {
+    std::mt19937 rng(7);
+    SelectionSet selection;
+    for (const auto& voxel : randomVoxels(rng, 2000, 30)) {
+        selection.add(voxel);
+    }
+    selection.remove(*selection.begin());
+    
+    Math::Vector3f minPos(std::numeric_limits<float>::max());
+    Math::Vector3f maxPos(std::numeric_limits<float>::lowest());
+    Math::Vector3f total = Math::Vector3f::Zero();
+    for (const auto& voxel : selection) {
+        Math::BoundingBox bounds = voxel.getBounds();
+        minPos = Math::Vector3f::min(minPos, bounds.min);
+        maxPos = Math::Vector3f::max(maxPos, bounds.max);
+        total = total + voxel.getWorldPosition();
+    }
+    Math::Vector3f center = total / static_cast<float>(selection.size());
+    
+    Math::BoundingBox bounds = selection.getBounds();
+    EXPECT_FLOAT_EQ(bounds.min.x, minPos.x);
+    EXPECT_FLOAT_EQ(bounds.min.y, minPos.y);
+    EXPECT_FLOAT_EQ(bounds.min.z, minPos.z);
+    EXPECT_FLOAT_EQ(bounds.max.x, maxPos.x);
+    EXPECT_FLOAT_EQ(bounds.max.y, maxPos.y);
+    EXPECT_FLOAT_EQ(bounds.max.z, maxPos.z);
+    EXPECT_NEAR(selection.getCenter().x, center.x, 1e-4f);
+    EXPECT_NEAR(selection.getCenter().y, center.y, 1e-4f);
+    EXPECT_NEAR(selection.getCenter().z, center.z, 1e-4f);
+}
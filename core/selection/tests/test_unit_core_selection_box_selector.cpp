@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "core/selection/BoxSelector.h"
+#include "core/voxel_data/VoxelDataManager.h"
 #include "foundation/math/Matrix4f.h"
 
 using namespace VoxelEditor;
@@ -275,4 +276,43 @@ TEST_F(BoxSelectorTest, SetVoxelManager) {
     
     SelectionSet result = selector->selectFromWorld(box, VoxelData::VoxelResolution::Size_4cm, true);
     EXPECT_GT(result.size(), 0u);
-}
\ No newline at end of file
+}
+
+TEST_F(BoxSelectorTest, SelectFromWorld_WithManagerOnlyFindsExistingVoxels) {
+    VoxelData::VoxelDataManager manager;
+    VoxelData::VoxelResolution resolution = VoxelData::VoxelResolution::Size_4cm;
+    std::vector<Math::IncrementCoordinates> placed = {
+        Math::IncrementCoordinates(0, 0, 0),
+        Math::IncrementCoordinates(40, 8, -40),
+        Math::IncrementCoordinates(-200, 100, 200),
+        Math::IncrementCoordinates(200, 400, -200)
+    };
+    for (const auto& pos : placed) {
+        ASSERT_TRUE(manager.setVoxel(pos, resolution, true));
+    }
+    selector->setVoxelManager(&manager);
+    
+    // A workspace-sized box is swept by octree query, not cell by cell
+    Math::BoundingBox everything(Math::Vector3f(-2.5f, 0.0f, -2.5f), Math::Vector3f(2.5f, 5.0f, 2.5f));
+    SelectionSet result = selector->selectFromWorld(everything, resolution, true);
+    EXPECT_EQ(result.size(), placed.size());
+    for (const auto& pos : placed) {
+        EXPECT_TRUE(result.contains(VoxelId(pos, resolution)));
+    }
+    
+    // Tight box around one voxel; its neighbour 40cm away stays out
+    Math::BoundingBox tight(Math::Vector3f(-0.01f, 0.0f, -0.01f), Math::Vector3f(0.01f, 0.03f, 0.01f));
+    result = selector->selectFromWorld(tight, resolution, true);
+    EXPECT_EQ(result.size(), 1u);
+    EXPECT_TRUE(result.contains(VoxelId(placed[0], resolution)));
+    
+    // Full containment excludes voxels that only touch the box
+    selector->setIncludePartial(false);
+    result = selector->selectFromWorld(tight, resolution, true);
+    EXPECT_TRUE(result.empty());
+    
+    result = selector->selectFromGrid(Math::Vector3i(-200, 0, -200), Math::Vector3i(200, 100, 200),
+                                      resolution, true);
+    EXPECT_EQ(result.size(), 3u);
+    EXPECT_FALSE(result.contains(VoxelId(placed[3], resolution)));
+}
@@ -287,4 +287,22 @@ TEST_F(FloodFillSelectorTest, SetVoxelManager) {
     // Selection should still work without manager (assumes all voxels exist)
     SelectionSet result = selector->selectFloodFill(seed, FloodFillCriteria::Connected6);
     EXPECT_GT(result.size(), 0u);
-}
\ No newline at end of file
+}
+
+TEST_F(FloodFillSelectorTest, ArenaGivesSameResultAndIsRewound) {
+    SelectionSet expected = selector->selectFloodFillLimited(seed, FloodFillCriteria::Connected6, 4);
+    
+    Memory::FrameArena arena;
+    selector->setArena(&arena);
+    SelectionSet first = selector->selectFloodFillLimited(seed, FloodFillCriteria::Connected6, 4);
+    size_t upstreamAfterFirst = arena.getUpstreamAllocationCount();
+    SelectionSet second = selector->selectFloodFillLimited(seed, FloodFillCriteria::Connected6, 4);
+    
+    EXPECT_EQ(first, expected);
+    EXPECT_EQ(second, expected);
+    
+    // Scratch is handed back after each fill and reused by the next one
+    EXPECT_EQ(arena.getBytesUsed(), 0u);
+    EXPECT_GT(arena.getPeakBytesUsed(), 0u);
+    EXPECT_EQ(arena.getUpstreamAllocationCount(), upstreamAfterFirst);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "core/selection/SelectionManager.h"
+#include "core/voxel_data/VoxelDataManager.h"
 
 using namespace VoxelEditor;
 using namespace VoxelEditor::Selection;
@@ -237,6 +238,51 @@ TEST_F(SelectionManagerTest, MaxHistorySize) {
     EXPECT_EQ(undoCount, 3);
 }
 
+TEST_F(SelectionManagerTest, ReleaseHistoryMemory) {
+    for (int i = 0; i < 4; ++i) {
+        manager->selectVoxel(voxel1);
+        manager->selectVoxel(voxel2);
+        manager->pushSelectionToHistory();
+    }
+    manager->undoSelection();
+    
+    size_t usage = manager->getHistoryMemoryUsage();
+    EXPECT_GT(usage, 0u);
+    
+    // Oldest undo states go first, the current selection is never touched
+    size_t freed = manager->releaseHistoryMemory(1);
+    EXPECT_GT(freed, 0u);
+    EXPECT_EQ(manager->getHistoryMemoryUsage(), usage - freed);
+    EXPECT_TRUE(manager->canUndo());
+    EXPECT_TRUE(manager->canRedo());
+    
+    manager->releaseHistoryMemory(usage);
+    EXPECT_EQ(manager->getHistoryMemoryUsage(), 0u);
+    EXPECT_FALSE(manager->canUndo());
+    EXPECT_FALSE(manager->canRedo());
+    EXPECT_TRUE(manager->isSelected(voxel1));
+}
+
+TEST_F(SelectionManagerTest, MaxHistoryMemoryTrimsOnPush) {
+    manager->selectVoxel(voxel1);
+    manager->pushSelectionToHistory();
+    size_t perState = manager->getHistoryMemoryUsage();
+    ASSERT_GT(perState, 0u);
+    
+    // Room for two states: older ones are dropped as new ones arrive
+    manager->setMaxHistoryMemory(2 * perState);
+    for (int i = 0; i < 5; ++i) {
+        manager->pushSelectionToHistory();
+        EXPECT_LE(manager->getHistoryMemoryUsage(), 2 * perState);
+    }
+    EXPECT_TRUE(manager->canUndo());
+    
+    // Lowering the cap trims right away
+    manager->setMaxHistoryMemory(1);
+    EXPECT_FALSE(manager->canUndo());
+    EXPECT_TRUE(manager->isSelected(voxel1));
+}
+
 // Named Selection Sets Tests
 TEST_F(SelectionManagerTest, SaveAndLoadSelectionSet) {
     // REQ-8.1.7: Format shall store vertex selection state
@@ -460,4 +506,26 @@ TEST_F(SelectionManagerTest, GetSelectionCopy) {
     // Modifying copy should not affect manager
     copy.add(voxel3);
     EXPECT_FALSE(manager->isSelected(voxel3));
-}
\ No newline at end of file
+}
+
+// Island Test
+TEST(SelectionManagerIslandTest, SelectIslandUsesConnectivity) {
+    VoxelData::VoxelDataManager voxelManager;
+    auto res = VoxelData::VoxelResolution::Size_4cm;
+    for (int x = 0; x < 40; x += 4) {
+        ASSERT_TRUE(voxelManager.setVoxel(Math::IncrementCoordinates(x, 0, 0), res, true));
+    }
+    ASSERT_TRUE(voxelManager.setVoxel(Math::IncrementCoordinates(80, 0, 0), res, true));
+    
+    SelectionManager manager(&voxelManager);
+    manager.selectIsland(VoxelId(Math::IncrementCoordinates(8, 0, 0), res));
+    EXPECT_EQ(manager.getSelectionSize(), 10u);
+    EXPECT_FALSE(manager.isSelected(VoxelId(Math::IncrementCoordinates(80, 0, 0), res)));
+    
+    manager.selectIsland(VoxelId(Math::IncrementCoordinates(80, 0, 0), res), SelectionMode::Add);
+    EXPECT_EQ(manager.getSelectionSize(), 11u);
+    
+    // Empty seed leaves the selection alone
+    manager.selectIsland(VoxelId(Math::IncrementCoordinates(60, 0, 0), res));
+    EXPECT_EQ(manager.getSelectionSize(), 11u);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "core/selection/SphereSelector.h"
+#include "core/voxel_data/VoxelDataManager.h"
 
 using namespace VoxelEditor;
 using namespace VoxelEditor::Selection;
@@ -342,4 +343,31 @@ TEST_F(SphereSelectorTest, SetVoxelManager) {
     
     SelectionSet result = selector->selectFromSphere(center, radius, VoxelData::VoxelResolution::Size_4cm, true);
     EXPECT_GT(result.size(), 0u);
-}
\ No newline at end of file
+}
+
+TEST_F(SphereSelectorTest, WithManagerOnlyFindsExistingVoxels) {
+    VoxelData::VoxelDataManager manager;
+    VoxelData::VoxelResolution resolution = VoxelData::VoxelResolution::Size_4cm;
+    for (int x = -100; x <= 100; x += 20) {
+        ASSERT_TRUE(manager.setVoxel(Math::IncrementCoordinates(x, 100, 0), resolution, true));
+    }
+    selector->setVoxelManager(&manager);
+    
+    // Row of voxels through the center; only those within 0.5m are picked
+    Math::Vector3f center(0.0f, 1.02f, 0.0f);
+    SelectionSet result = selector->selectFromSphere(center, 0.5f, resolution, true);
+    EXPECT_EQ(result.size(), 5u);
+    EXPECT_TRUE(result.contains(VoxelId(Math::IncrementCoordinates(-40, 100, 0), resolution)));
+    EXPECT_FALSE(result.contains(VoxelId(Math::IncrementCoordinates(60, 100, 0), resolution)));
+    
+    // Whole-workspace radius just returns every voxel
+    result = selector->selectFromSphere(center, 10.0f, resolution, true);
+    EXPECT_EQ(result.size(), 11u);
+    
+    result = selector->selectHemisphere(center, 0.5f, Math::Vector3f(1.0f, 0.0f, 0.0f), resolution, true);
+    EXPECT_EQ(result.size(), 3u);
+    
+    result = selector->selectEllipsoid(center, Math::Vector3f(0.9f, 0.1f, 0.1f),
+                                       Math::Quaternion::identity(), resolution, true);
+    EXPECT_EQ(result.size(), 9u);
+}
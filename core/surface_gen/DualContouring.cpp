@@ -6,6 +6,7 @@
 
 #include "DualContouring.h"
 #include "../../foundation/logging/Logger.h"
+#include "../../foundation/logging/PerformanceProfiler.h"
 #include <algorithm>
 #include <vector>
 #include <future>
@@ -116,8 +117,13 @@ void DualContouring::extractEdgeIntersections(const VoxelData::VoxelGrid& grid)
     
     auto& logger = Logging::Logger::getInstance();
     
+    // Cell sets are temporaries; they go back to the arena on return
+    Memory::FrameArena localArena;
+    Memory::FrameArena& scratch = m_arena ? *m_arena : localArena;
+    Memory::ArenaScope scratchScope(scratch);
+    
     // Build set of cells that need processing
-    auto activeCells = buildActiveCellSet(grid);
+    auto activeCells = buildActiveCellSet(grid, scratch.getResource());
     
     if (activeCells.empty()) {
         logger.debugfc("DualContouring", "No active cells to process");
@@ -128,7 +134,7 @@ void DualContouring::extractEdgeIntersections(const VoxelData::VoxelGrid& grid)
     logger.debugfc("DualContouring", 
         "Grid dims: %dx%dx%d, Found %zu occupied voxels, generated %zu active cells (%.1f%% reduction)",
         dims.x, dims.y, dims.z,
-        grid.getAllVoxels().size(),
+        grid.getVoxelCount(),
         activeCells.size(), 
         100.0f * (1.0f - float(activeCells.size()) / float(dims.x * dims.y * dims.z)));
     
@@ -143,28 +149,34 @@ void DualContouring::extractEdgeIntersections(const VoxelData::VoxelGrid& grid)
     }
     
     // Process cells in parallel for better performance
-    processActiveCellsParallel(grid, activeCells);
+    processActiveCellsParallel(grid, activeCells, scratch.getResource());
     
     std::cout << "DualContouring: After processing, have " << m_cellData.size() << " cells with intersections" << std::endl;
 }
 
-std::unordered_set<uint64_t> DualContouring::buildActiveCellSet(
-    const VoxelData::VoxelGrid& grid) {
+std::pmr::unordered_set<uint64_t> DualContouring::buildActiveCellSet(
+    const VoxelData::VoxelGrid& grid,
+    std::pmr::memory_resource* resource) {
     
-    std::unordered_set<uint64_t> activeCells;
-    auto occupiedVoxels = grid.getAllVoxels();
+    std::pmr::unordered_set<uint64_t> activeCells(resource);
+    size_t occupiedCount = grid.getVoxelCount();
     
     // Get grid dimensions to understand the scale
     Math::Vector3i dims = grid.getGridDimensions();
     
     // Debug logging
     auto& logger = Logging::Logger::getInstance();
-    logger.debugfc("DualContouring", "Building active cells for %zu voxels", occupiedVoxels.size());
-    std::cout << "DualContouring: Building active cells for " << occupiedVoxels.size() << " voxels" << std::endl;
+    logger.debugfc("DualContouring", "Building active cells for %zu voxels", occupiedCount);
+    std::cout << "DualContouring: Building active cells for " << occupiedCount << " voxels" << std::endl;
+    
+    // Each voxel marks up to 64 cells, but neighbours share almost all of
+    // them, so a solid model ends up near one cell per voxel plus a surface
+    // shell; sparse scenes grow past this by rehashing
+    activeCells.reserve(occupiedCount + occupiedCount / 2);
     
     // For each occupied voxel, mark surrounding cells as active
     int voxelCount = 0;
-    for (const auto& voxel : occupiedVoxels) {
+    grid.forEachVoxel([&](const VoxelData::VoxelPosition& voxel) {
         const Math::Vector3i& voxelPos = voxel.incrementPos.value();
         
         // Get voxel size for this specific voxel
@@ -251,17 +263,19 @@ std::unordered_set<uint64_t> DualContouring::buildActiveCellSet(
                 }
             }
         }
-    }
+    });
     
     return activeCells;
 }
 
 void DualContouring::processActiveCellsParallel(
     const VoxelData::VoxelGrid& grid,
-    const std::unordered_set<uint64_t>& activeCells) {
+    const std::pmr::unordered_set<uint64_t>& activeCells,
+    std::pmr::memory_resource* resource) {
     
-    // Convert set to vector for easier parallel processing
-    std::vector<uint64_t> cellKeys(activeCells.begin(), activeCells.end());
+    // Convert set to vector for easier parallel processing. Built here on
+    // the calling thread; workers only read it.
+    std::pmr::vector<uint64_t> cellKeys(activeCells.begin(), activeCells.end(), resource);
     
     // Determine number of threads
     size_t numThreads = std::min(
@@ -296,6 +310,7 @@ void DualContouring::processActiveCellsParallel(
             size_t end = (t == numThreads - 1) ? cellKeys.size() : (t + 1) * cellsPerThread;
             
             futures.push_back(std::async(std::launch::async, [this, &grid, &cellKeys, start, end]() {
+                PROFILE_SCOPE("DualContouring::processCellsWorker");
                 for (size_t i = start; i < end; ++i) {
                     if (m_cancelled) return;
                     
@@ -7,6 +7,7 @@
 #include "../../foundation/math/CoordinateTypes.h"
 #include "../../foundation/math/CoordinateConverter.h"
 #include "../../foundation/logging/Logger.h"
+#include "../../foundation/memory/FrameArena.h"
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -14,6 +15,7 @@
 #include <mutex>
 #include <thread>
 #include <functional>
+#include <memory_resource>
 
 namespace VoxelEditor {
 namespace SurfaceGen {
@@ -106,6 +108,15 @@ public:
      */
     bool isCancelled() const { return m_cancelled; }
     
+    /**
+     * Use a caller-owned arena for the active-cell temporaries.
+     * Scratch is rewound before generateMesh() returns; with nullptr the
+     * temporaries come from a local arena.
+     * 
+     * @param arena Scratch arena, only used on the calling thread
+     */
+    void setArena(Memory::FrameArena* arena) { m_arena = arena; }
+    
 protected:
     // Edge table constants for dual contouring cube traversal
     static constexpr int EDGE_COUNT = 12;  ///< Number of edges per cube
@@ -235,6 +246,7 @@ protected:
     SurfaceSettings m_settings;                              ///< Current generation settings
     ProgressCallback m_progressCallback;                     ///< Progress reporting callback
     std::atomic<bool> m_cancelled;                          ///< Cancellation flag (thread-safe)
+    Memory::FrameArena* m_arena = nullptr;                  ///< Optional scratch arena (not owned)
     
     // Working data - cleared between generations
     std::unordered_map<uint64_t, CellData> m_cellData;      ///< Sparse storage of active cells
@@ -372,9 +384,11 @@ private:
      * to ensure proper alignment.
      * 
      * @param grid Voxel grid to analyze
+     * @param resource Memory for the returned set
      * @return Hash set of cell keys for cells to process
      */
-    std::unordered_set<uint64_t> buildActiveCellSet(const VoxelData::VoxelGrid& grid);
+    std::pmr::unordered_set<uint64_t> buildActiveCellSet(const VoxelData::VoxelGrid& grid,
+                                                         std::pmr::memory_resource* resource);
     
     /**
      * Process active cells in parallel for better performance.
@@ -384,9 +398,11 @@ private:
      * 
      * @param grid Voxel grid being processed
      * @param activeCells Set of cell keys to process
+     * @param resource Memory for the flattened key list
      */
     void processActiveCellsParallel(const VoxelData::VoxelGrid& grid,
-                                   const std::unordered_set<uint64_t>& activeCells);
+                                   const std::pmr::unordered_set<uint64_t>& activeCells,
+                                   std::pmr::memory_resource* resource);
     
     /**
      * Process a single cell for edge intersections.
@@ -1,11 +1,11 @@
 #include "SimpleMesher.h"
 #include "../../foundation/logging/Logger.h"
+#include "../../foundation/logging/PerformanceProfiler.h"
 #include <algorithm>
 #include <cmath>
 #include <thread>
 #include <future>
 #include <atomic>
-#include <unordered_set>
 
 using namespace VoxelEditor::Math;
 using namespace VoxelEditor::VoxelData;
@@ -122,18 +122,21 @@ Mesh SimpleMesher::generateMesh(const VoxelGrid& grid,
         return Mesh();
     }
     
+    // Temporaries live in the scratch arena and are discarded on return
+    Memory::FrameArena localArena;
+    Memory::FrameArena& scratch = m_arena ? *m_arena : localArena;
+    Memory::ArenaScope scratchScope(scratch);
+    std::pmr::memory_resource* resource = scratch.getResource();
+    
     // Build spatial index
-    SpatialIndex spatialIndex(512); // 512cm cell size for largest voxels
+    SpatialIndex spatialIndex(512, resource); // 512cm cell size for largest voxels
     
     // Get all voxels from grid and index them
-    std::vector<VoxelInfo> voxels;
-    
-    // Get all voxel positions from the grid
-    auto voxelPositions = grid.getAllVoxels();
+    std::pmr::vector<VoxelInfo> voxels(resource);
     
     // Convert to our format and add to spatial index
     int voxelId = 0;
-    for (const auto& voxelPos : voxelPositions) {
+    grid.forEachVoxel([&](const VoxelPosition& voxelPos) {
         // VoxelPosition already contains increment coordinates
         IncrementCoordinates pos = voxelPos.incrementPos;
         
@@ -147,7 +150,7 @@ Mesh SimpleMesher::generateMesh(const VoxelGrid& grid,
         
         voxels.push_back({pos, voxelSize});
         spatialIndex.insert(voxelId++, pos, voxelSize);
-    }
+    });
     
     reportProgress(0.1f);
     
@@ -190,7 +193,8 @@ Mesh SimpleMesher::generateMesh(const VoxelGrid& grid,
                 edgeRegistry,
                 indices,
                 resolution,
-                voxels
+                voxels,
+                scratch
             );
             
             reportProgress(0.1f + (i + 1) * progressStep);
@@ -222,8 +226,14 @@ Mesh SimpleMesher::generateMesh(const VoxelGrid& grid,
     // Shared edge registry for preventing T-junctions
     EdgeVertexRegistry sharedEdgeRegistry;
     
-    // Initialize thread-local data
+    // Initialize thread-local data. Arenas are not thread-safe, so every
+    // worker gets its own, started in a slice of the scratch arena carved
+    // here on the calling thread. Worker scratch is rewound per voxel, so
+    // one default block rarely overflows to the heap.
+    const size_t workerArenaSize = Memory::FrameArena::DEFAULT_BLOCK_SIZE;
     for (auto& data : threadData) {
+        data.arena = std::make_unique<Memory::FrameArena>(
+            scratch.allocate(workerArenaSize), workerArenaSize);
         data.vertexManager = std::make_unique<VertexManager>();
         data.vertexManager->reserve((voxels.size() / numThreads + 1) * 8);
         data.indices.reserve((voxels.size() / numThreads + 1) * 36);
@@ -241,6 +251,7 @@ Mesh SimpleMesher::generateMesh(const VoxelGrid& grid,
         size_t endIdx = startIdx + voxelsPerThread + (t < remainder ? 1 : 0);
         
         futures.push_back(std::async(std::launch::async, [&, t, startIdx, endIdx]() {
+            PROFILE_SCOPE("SimpleMesher::meshWorker");
             auto& localData = threadData[t];
             
             for (size_t i = startIdx; i < endIdx; ++i) {
@@ -258,7 +269,8 @@ Mesh SimpleMesher::generateMesh(const VoxelGrid& grid,
                     sharedEdgeRegistry,
                     localData.indices,
                     resolution,
-                    voxels
+                    voxels,
+                    *localData.arena
                 );
                 
                 // Update progress
@@ -304,7 +316,8 @@ void SimpleMesher::reportProgress(float progress) {
 // Provides O(1) neighbor lookup as specified in the design
 // SpatialIndex implementation - Phase 1 of SimpleMesher.md
 // Provides O(1) neighbor lookup using spatial hashing
-SimpleMesher::SpatialIndex::SpatialIndex(int cellSize) : m_cellSize(cellSize) {
+SimpleMesher::SpatialIndex::SpatialIndex(int cellSize, std::pmr::memory_resource* resource)
+    : m_cellSize(cellSize), m_grid(resource) {
     if (cellSize <= 0) {
         m_cellSize = 512; // Default to max voxel size
     }
@@ -330,8 +343,9 @@ void SimpleMesher::SpatialIndex::insert(int voxelId, const IncrementCoordinates&
     }
 }
 
-std::vector<int> SimpleMesher::SpatialIndex::getNeighbors(const IncrementCoordinates& position, int size) const {
-    std::unordered_set<int> neighbors;
+void SimpleMesher::SpatialIndex::getNeighbors(const IncrementCoordinates& position, int size,
+                                              std::pmr::vector<int>& neighbors) const {
+    neighbors.clear();
     
     // Expand bounds by 1cm to catch adjacent voxels
     int minX = (position.x() - 1) / m_cellSize;
@@ -348,15 +362,15 @@ std::vector<int> SimpleMesher::SpatialIndex::getNeighbors(const IncrementCoordin
                 uint64_t key = getCellKey(x, y, z);
                 auto it = m_grid.find(key);
                 if (it != m_grid.end()) {
-                    for (int id : it->second) {
-                        neighbors.insert(id);
-                    }
+                    neighbors.insert(neighbors.end(), it->second.begin(), it->second.end());
                 }
             }
         }
     }
     
-    return std::vector<int>(neighbors.begin(), neighbors.end());
+    // Large voxels span several cells
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
 }
 
 void SimpleMesher::SpatialIndex::clear() {
@@ -418,48 +432,47 @@ void SimpleMesher::VertexManager::reserve(size_t count) {
 // Rectangle-based occlusion tracking as specified in design
 // FaceOcclusionTracker implementation - Phase 3 of SimpleMesher.md
 // Tracks visible regions of faces using rectangle subtraction
-SimpleMesher::FaceOcclusionTracker::FaceOcclusionTracker(int faceSize) 
-    : m_faceSize(faceSize) {
+SimpleMesher::FaceOcclusionTracker::FaceOcclusionTracker(int faceSize, std::pmr::memory_resource* resource)
+    : m_faceSize(faceSize), m_resource(resource), m_occludedRegions(resource) {
 }
 
 void SimpleMesher::FaceOcclusionTracker::addOcclusion(const Rectangle& rect) {
     m_occludedRegions.push_back(rect);
 }
 
-std::vector<SimpleMesher::Rectangle> SimpleMesher::FaceOcclusionTracker::computeVisibleRectangles() {
+std::pmr::vector<SimpleMesher::Rectangle> SimpleMesher::FaceOcclusionTracker::computeVisibleRectangles() {
     // Start with the full face as visible
-    std::vector<Rectangle> visibleRects;
+    std::pmr::vector<Rectangle> visibleRects(m_resource);
     visibleRects.push_back(Rectangle(0, 0, m_faceSize, m_faceSize));
     
-    // Subtract each occlusion
+    // Subtract each occlusion, ping-ponging between two buffers
+    std::pmr::vector<Rectangle> newVisible(m_resource);
     for (const Rectangle& occlusion : m_occludedRegions) {
-        std::vector<Rectangle> newVisible;
+        newVisible.clear();
         
         for (const Rectangle& rect : visibleRects) {
-            std::vector<Rectangle> remaining = subtractRectangle(rect, occlusion);
-            newVisible.insert(newVisible.end(), remaining.begin(), remaining.end());
+            subtractRectangle(rect, occlusion, newVisible);
         }
         
-        visibleRects = newVisible;
+        visibleRects.swap(newVisible);
     }
     
     // Merge adjacent rectangles to reduce complexity
-    return mergeAdjacentRectangles(visibleRects);
+    mergeAdjacentRectangles(visibleRects);
+    return visibleRects;
 }
 
-std::vector<SimpleMesher::Rectangle> SimpleMesher::FaceOcclusionTracker::subtractRectangle(
-    const Rectangle& rect, const Rectangle& occlusion) {
-    std::vector<Rectangle> result;
-    
-    // If no intersection, return the original rectangle
+void SimpleMesher::FaceOcclusionTracker::subtractRectangle(
+    const Rectangle& rect, const Rectangle& occlusion, std::pmr::vector<Rectangle>& result) {
+    // If no intersection, keep the original rectangle
     if (!rect.intersects(occlusion)) {
         result.push_back(rect);
-        return result;
+        return;
     }
     
-    // If fully occluded, return empty
+    // If fully occluded, nothing remains
     if (occlusion.contains(rect)) {
-        return result;
+        return;
     }
     
     // Calculate intersection bounds
@@ -487,16 +500,14 @@ std::vector<SimpleMesher::Rectangle> SimpleMesher::FaceOcclusionTracker::subtrac
     if (intersectRight < rect.right() && intersectBottom > intersectTop) {
         result.push_back(Rectangle(intersectRight, intersectTop, rect.right() - intersectRight, intersectBottom - intersectTop));
     }
-    
-    return result;
 }
 
-std::vector<SimpleMesher::Rectangle> SimpleMesher::FaceOcclusionTracker::mergeAdjacentRectangles(
-    const std::vector<Rectangle>& rects) {
-    // Simple implementation - just return as-is for now
+void SimpleMesher::FaceOcclusionTracker::mergeAdjacentRectangles(
+    std::pmr::vector<Rectangle>& rects) {
+    // Simple implementation - just leave them as-is for now
     // A more sophisticated implementation would try to merge rectangles
     // that share edges and have the same width or height
-    return rects;
+    (void)rects;
 }
 
 // EdgeVertexRegistry implementation (Phase 6: Mesh Subdivision - TODO.md)
@@ -506,7 +517,7 @@ std::vector<SimpleMesher::Rectangle> SimpleMesher::FaceOcclusionTracker::mergeAd
 SimpleMesher::EdgeVertexRegistry::EdgeVertexRegistry() {
 }
 
-std::vector<uint32_t> SimpleMesher::EdgeVertexRegistry::getOrCreateEdgeVertices(
+const std::vector<uint32_t>& SimpleMesher::EdgeVertexRegistry::getOrCreateEdgeVertices(
     const WorldCoordinates& start,
     const WorldCoordinates& end,
     int subdivisionSize,
@@ -553,10 +564,8 @@ std::vector<uint32_t> SimpleMesher::EdgeVertexRegistry::getOrCreateEdgeVertices(
         vertices.push_back(vertexIndex);
     }
     
-    // Store in registry
-    m_edgeVertices[key] = vertices;
-    
-    return vertices;
+    // Store in registry; map nodes never move, so the reference stays valid
+    return m_edgeVertices.emplace(key, std::move(vertices)).first->second;
 }
 
 void SimpleMesher::EdgeVertexRegistry::clear() {
@@ -575,11 +584,20 @@ void SimpleMesher::generateVoxelMesh(
     EdgeVertexRegistry& edgeRegistry,
     std::vector<uint32_t>& indices,
     int meshResolution,
-    const std::vector<VoxelInfo>& voxels) {
+    const std::pmr::vector<VoxelInfo>& voxels,
+    Memory::FrameArena& scratch) {
     
     // Phase 3-4: Face Generation and Removal (TODO.md)
     // Generate faces with intelligent removal for adjacent voxels
     
+    // Everything below is per-voxel scratch
+    Memory::ArenaScope voxelScope(scratch);
+    std::pmr::memory_resource* resource = scratch.getResource();
+    
+    // Neighbors are the same for all 6 faces
+    std::pmr::vector<int> neighbors(resource);
+    spatialIndex.getNeighbors(position, size, neighbors);
+    
     // Process each of the 6 faces
     const FaceDirection faces[] = {
         FaceDirection::NEG_X, FaceDirection::POS_X,
@@ -589,8 +607,7 @@ void SimpleMesher::generateVoxelMesh(
     
     for (FaceDirection face : faces) {
         // Find occlusions from neighboring voxels
-        FaceOcclusionTracker occlusionTracker(size);
-        std::vector<int> neighbors = spatialIndex.getNeighbors(position, size);
+        FaceOcclusionTracker occlusionTracker(size, resource);
         
         for (int neighborId : neighbors) {
             if (neighborId == voxelId) continue; // Skip self
@@ -608,7 +625,7 @@ void SimpleMesher::generateVoxelMesh(
         }
         
         // Get visible regions
-        std::vector<Rectangle> visibleRects = occlusionTracker.computeVisibleRectangles();
+        std::pmr::vector<Rectangle> visibleRects = occlusionTracker.computeVisibleRectangles();
         
         // DEBUG: Log face visibility
         if (face == FaceDirection::POS_Y && voxelId == 0) { // Top face of first voxel
@@ -622,8 +639,8 @@ void SimpleMesher::generateVoxelMesh(
         }
         
         if (!visibleRects.empty()) {
-            FaceData faceData = createFaceData(position, size, face, visibleRects);
-            generateFace(faceData, indices, edgeRegistry, vertexManager, meshResolution);
+            FaceData faceData = createFaceData(position, size, face, std::move(visibleRects));
+            generateFace(faceData, indices, edgeRegistry, vertexManager, meshResolution, scratch);
         }
     }
 }
@@ -635,7 +652,8 @@ void SimpleMesher::generateFace(
     std::vector<uint32_t>& indices,
     EdgeVertexRegistry& edgeRegistry,
     VertexManager& vertexManager,
-    int meshResolution) {
+    int meshResolution,
+    Memory::FrameArena& scratch) {
     
     // First, ensure edge vertices exist for this face
     FaceData& mutableFaceData = const_cast<FaceData&>(faceData);
@@ -651,7 +669,7 @@ void SimpleMesher::generateFace(
         // Check if we need subdivision
         if (rect.width > meshResolution || rect.height > meshResolution) {
             // Use subdivision for larger rectangles
-            triangulateRectangle(rect, faceData, indices, vertexManager, meshResolution);
+            triangulateRectangle(rect, faceData, indices, vertexManager, meshResolution, scratch);
         } else {
             // Small rectangle - just create a quad
             float u0 = rect.x * 0.01f; // Convert cm to meters
@@ -688,7 +706,8 @@ void SimpleMesher::triangulateRectangle(
     const FaceData& faceData,
     std::vector<uint32_t>& indices,
     VertexManager& vertexManager,
-    int meshResolution) {
+    int meshResolution,
+    Memory::FrameArena& scratch) {
     
     // Calculate subdivisions
     int uSubdivisions = rect.width / meshResolution;
@@ -700,8 +719,12 @@ void SimpleMesher::triangulateRectangle(
     int uVertices = uSubdivisions + (uRemainder > 0 ? 2 : 1);
     int vVertices = vSubdivisions + (vRemainder > 0 ? 2 : 1);
     
-    // Build vertex grid for this rectangle
-    std::vector<std::vector<uint32_t>> vertices(vVertices, std::vector<uint32_t>(uVertices));
+    // Build vertex grid for this rectangle (row-major, rewound with the face)
+    Memory::ArenaScope gridScope(scratch);
+    uint32_t* grid = scratch.allocateArray<uint32_t>(static_cast<size_t>(uVertices) * vVertices);
+    auto vertexAt = [grid, uVertices](int v, int u) -> uint32_t& {
+        return grid[static_cast<size_t>(v) * uVertices + u];
+    };
     
     // Generate vertices
     for (int v = 0; v < vVertices; ++v) {
@@ -727,34 +750,34 @@ void SimpleMesher::triangulateRectangle(
             bool onBottomEdge = (rect.y == 0 && v == 0);
             bool onTopEdge = (rect.y + rect.height == faceData.size && v == vVertices - 1);
             
-            if (onLeftEdge && !faceData.leftEdgeVertices.empty()) {
+            if (onLeftEdge && !faceData.leftEdgeVertices->empty()) {
                 int edgeIndex = getEdgeIndex(rect.y + v * meshResolution, faceData.size, meshResolution);
-                if (edgeIndex < faceData.leftEdgeVertices.size()) {
-                    vertices[v][u] = faceData.leftEdgeVertices[edgeIndex];
+                if (edgeIndex < faceData.leftEdgeVertices->size()) {
+                    vertexAt(v, u) = (*faceData.leftEdgeVertices)[edgeIndex];
                     continue;
                 }
             }
             
-            if (onRightEdge && !faceData.rightEdgeVertices.empty()) {
+            if (onRightEdge && !faceData.rightEdgeVertices->empty()) {
                 int edgeIndex = getEdgeIndex(rect.y + v * meshResolution, faceData.size, meshResolution);
-                if (edgeIndex < faceData.rightEdgeVertices.size()) {
-                    vertices[v][u] = faceData.rightEdgeVertices[edgeIndex];
+                if (edgeIndex < faceData.rightEdgeVertices->size()) {
+                    vertexAt(v, u) = (*faceData.rightEdgeVertices)[edgeIndex];
                     continue;
                 }
             }
             
-            if (onBottomEdge && !faceData.bottomEdgeVertices.empty()) {
+            if (onBottomEdge && !faceData.bottomEdgeVertices->empty()) {
                 int edgeIndex = getEdgeIndex(rect.x + u * meshResolution, faceData.size, meshResolution);
-                if (edgeIndex < faceData.bottomEdgeVertices.size()) {
-                    vertices[v][u] = faceData.bottomEdgeVertices[edgeIndex];
+                if (edgeIndex < faceData.bottomEdgeVertices->size()) {
+                    vertexAt(v, u) = (*faceData.bottomEdgeVertices)[edgeIndex];
                     continue;
                 }
             }
             
-            if (onTopEdge && !faceData.topEdgeVertices.empty()) {
+            if (onTopEdge && !faceData.topEdgeVertices->empty()) {
                 int edgeIndex = getEdgeIndex(rect.x + u * meshResolution, faceData.size, meshResolution);
-                if (edgeIndex < faceData.topEdgeVertices.size()) {
-                    vertices[v][u] = faceData.topEdgeVertices[edgeIndex];
+                if (edgeIndex < faceData.topEdgeVertices->size()) {
+                    vertexAt(v, u) = (*faceData.topEdgeVertices)[edgeIndex];
                     continue;
                 }
             }
@@ -762,15 +785,15 @@ void SimpleMesher::triangulateRectangle(
             // Interior vertex - create new
             WorldCoordinates vertexPos = faceData.origin + 
                 WorldCoordinates(faceData.uDir * uPos + faceData.vDir * vPos);
-            vertices[v][u] = vertexManager.getOrCreateVertex(vertexPos);
+            vertexAt(v, u) = vertexManager.getOrCreateVertex(vertexPos);
         }
     }
     
     // Generate quads (2 triangles each)
     for (int v = 0; v < vVertices - 1; ++v) {
         for (int u = 0; u < uVertices - 1; ++u) {
-            addQuad(vertices[v][u], vertices[v][u+1], 
-                   vertices[v+1][u+1], vertices[v+1][u], indices);
+            addQuad(vertexAt(v, u), vertexAt(v, u+1), 
+                   vertexAt(v+1, u+1), vertexAt(v+1, u), indices);
         }
     }
 }
@@ -779,11 +802,10 @@ SimpleMesher::FaceData SimpleMesher::createFaceData(
     const IncrementCoordinates& voxelPos,
     int voxelSize,
     FaceDirection face,
-    const std::vector<Rectangle>& visibleRects) {
+    std::pmr::vector<Rectangle>&& visibleRects) {
     
-    FaceData faceData;
+    FaceData faceData(std::move(visibleRects));
     faceData.size = voxelSize;
-    faceData.visibleRectangles = visibleRects;
     
     // Convert voxel position to world coordinates
     WorldCoordinates worldPos = CoordinateConverter::incrementToWorld(voxelPos);
@@ -989,19 +1011,19 @@ void SimpleMesher::ensureEdgeVertices(
     
     // Get or create vertices for each edge
     // Bottom edge (along U direction)
-    faceData.bottomEdgeVertices = edgeRegistry.getOrCreateEdgeVertices(
+    faceData.bottomEdgeVertices = &edgeRegistry.getOrCreateEdgeVertices(
         origin, uMax, meshResolution, vertexManager);
     
     // Top edge (along U direction)
-    faceData.topEdgeVertices = edgeRegistry.getOrCreateEdgeVertices(
+    faceData.topEdgeVertices = &edgeRegistry.getOrCreateEdgeVertices(
         vMax, uvMax, meshResolution, vertexManager);
     
     // Left edge (along V direction)
-    faceData.leftEdgeVertices = edgeRegistry.getOrCreateEdgeVertices(
+    faceData.leftEdgeVertices = &edgeRegistry.getOrCreateEdgeVertices(
         origin, vMax, meshResolution, vertexManager);
     
     // Right edge (along V direction)
-    faceData.rightEdgeVertices = edgeRegistry.getOrCreateEdgeVertices(
+    faceData.rightEdgeVertices = &edgeRegistry.getOrCreateEdgeVertices(
         uMax, uvMax, meshResolution, vertexManager);
 }
 
@@ -7,6 +7,7 @@
 #include "../../foundation/math/CoordinateTypes.h"
 #include "../../foundation/math/CoordinateConverter.h"
 #include "../../foundation/logging/Logger.h"
+#include "../../foundation/memory/FrameArena.h"
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -15,6 +16,7 @@
 #include <thread>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 
 namespace VoxelEditor {
 namespace SurfaceGen {
@@ -104,6 +106,15 @@ public:
      * @return true if cancel() has been called
      */
     bool isCancelled() const { return m_cancelled; }
+    
+    /**
+     * Use a caller-owned arena for the temporaries of generateMesh().
+     * The arena is rewound before generateMesh() returns; with nullptr a
+     * local arena is used per call.
+     * 
+     * @param arena Scratch arena, only used on the calling thread
+     */
+    void setArena(Memory::FrameArena* arena) { m_arena = arena; }
 
 protected:
     // Forward declarations of internal structures
@@ -173,18 +184,21 @@ protected:
      * Face data including coordinate system and visible regions.
      */
     struct FaceData {
+        explicit FaceData(std::pmr::vector<Rectangle>&& rects)
+            : visibleRectangles(std::move(rects)) {}
+        
         Math::WorldCoordinates origin;    // Face origin in world space
         Math::Vector3f uDir;             // U direction (normalized)
         Math::Vector3f vDir;             // V direction (normalized)
         Math::Vector3f normal;           // Face normal (normalized)
         int size;                        // Face size in cm
-        std::vector<Rectangle> visibleRectangles; // Visible regions
+        std::pmr::vector<Rectangle> visibleRectangles; // Visible regions
         
-        // Edge vertex indices for T-junction prevention
-        std::vector<uint32_t> bottomEdgeVertices;
-        std::vector<uint32_t> topEdgeVertices;
-        std::vector<uint32_t> leftEdgeVertices;
-        std::vector<uint32_t> rightEdgeVertices;
+        // Edge vertex indices for T-junction prevention (owned by the registry)
+        const std::vector<uint32_t>* bottomEdgeVertices = nullptr;
+        const std::vector<uint32_t>* topEdgeVertices = nullptr;
+        const std::vector<uint32_t>* leftEdgeVertices = nullptr;
+        const std::vector<uint32_t>* rightEdgeVertices = nullptr;
     };
     
     /**
@@ -192,15 +206,18 @@ protected:
      */
     class SpatialIndex {
     public:
-        explicit SpatialIndex(int cellSize = 512); // Cell size in cm
+        explicit SpatialIndex(int cellSize = 512, // Cell size in cm
+                              std::pmr::memory_resource* resource = std::pmr::get_default_resource());
         
         void insert(int voxelId, const Math::IncrementCoordinates& position, int size);
-        std::vector<int> getNeighbors(const Math::IncrementCoordinates& position, int size) const;
+        // Replaces the contents of neighbors with the sorted, unique ids
+        void getNeighbors(const Math::IncrementCoordinates& position, int size,
+                          std::pmr::vector<int>& neighbors) const;
         void clear();
         
     private:
         int m_cellSize;
-        std::unordered_map<uint64_t, std::vector<int>> m_grid;
+        std::pmr::unordered_map<uint64_t, std::pmr::vector<int>> m_grid;
         
         uint64_t getCellKey(int x, int y, int z) const;
         
@@ -233,17 +250,20 @@ protected:
      */
     class FaceOcclusionTracker {
     public:
-        explicit FaceOcclusionTracker(int faceSize);
+        FaceOcclusionTracker(int faceSize, std::pmr::memory_resource* resource);
         
         void addOcclusion(const Rectangle& rect);
-        std::vector<Rectangle> computeVisibleRectangles();
+        std::pmr::vector<Rectangle> computeVisibleRectangles();
         
     private:
         int m_faceSize;
-        std::vector<Rectangle> m_occludedRegions;
+        std::pmr::memory_resource* m_resource;
+        std::pmr::vector<Rectangle> m_occludedRegions;
         
-        std::vector<Rectangle> subtractRectangle(const Rectangle& rect, const Rectangle& occlusion);
-        std::vector<Rectangle> mergeAdjacentRectangles(const std::vector<Rectangle>& rects);
+        // Appends the parts of rect not covered by occlusion to result
+        void subtractRectangle(const Rectangle& rect, const Rectangle& occlusion,
+                               std::pmr::vector<Rectangle>& result);
+        void mergeAdjacentRectangles(std::pmr::vector<Rectangle>& rects);
     };
     
     /**
@@ -253,7 +273,8 @@ protected:
     public:
         EdgeVertexRegistry();
         
-        std::vector<uint32_t> getOrCreateEdgeVertices(
+        // The returned list stays valid until clear()
+        const std::vector<uint32_t>& getOrCreateEdgeVertices(
             const Math::WorldCoordinates& start,
             const Math::WorldCoordinates& end,
             int subdivisionSize,
@@ -272,6 +293,7 @@ protected:
     
     // Thread-local data for parallel processing
     struct ThreadLocalData {
+        std::unique_ptr<Memory::FrameArena> arena; // Declared first so it outlives users
         std::unique_ptr<VertexManager> vertexManager;
         std::vector<uint32_t> indices;
         std::vector<EdgeKey> localEdgeVertices;
@@ -280,6 +302,7 @@ protected:
     // Core member variables
     ProgressCallback m_progressCallback;
     std::atomic<bool> m_cancelled;
+    Memory::FrameArena* m_arena = nullptr;
     
     // Main algorithm functions
     struct VoxelInfo {
@@ -297,28 +320,31 @@ protected:
         EdgeVertexRegistry& edgeRegistry,
         std::vector<uint32_t>& indices,
         int meshResolution,
-        const std::vector<VoxelInfo>& voxels);
+        const std::pmr::vector<VoxelInfo>& voxels,
+        Memory::FrameArena& scratch);
     
     void generateFace(
         const FaceData& faceData,
         std::vector<uint32_t>& indices,
         EdgeVertexRegistry& edgeRegistry,
         VertexManager& vertexManager,
-        int meshResolution);
+        int meshResolution,
+        Memory::FrameArena& scratch);
     
     void triangulateRectangle(
         const Rectangle& rect,
         const FaceData& faceData,
         std::vector<uint32_t>& indices,
         VertexManager& vertexManager,
-        int meshResolution);
+        int meshResolution,
+        Memory::FrameArena& scratch);
     
     // Helper functions
     FaceData createFaceData(
         const Math::IncrementCoordinates& voxelPos,
         int voxelSize,
         FaceDirection face,
-        const std::vector<Rectangle>& visibleRects);
+        std::pmr::vector<Rectangle>&& visibleRects);
     
     bool faceIsAdjacent(
         const Math::IncrementCoordinates& voxel1Pos,
@@ -1,6 +1,7 @@
 #include "SurfaceGenerator.h"
 #include "DualContouring.h"
 #include "SimpleMesher.h"
+#include "../../foundation/logging/PerformanceProfiler.h"
 #include <thread>
 #include <sstream>
 #include <algorithm>
@@ -65,6 +66,7 @@ Mesh SurfaceGenerator::generatePreviewMesh(const VoxelData::VoxelGrid& grid, int
 
 Mesh SurfaceGenerator::generateMultiResMesh(const VoxelData::VoxelDataManager& voxelManager,
                                            VoxelData::VoxelResolution targetRes) {
+    PROFILE_SCOPE("SurfaceGenerator::generateMultiResMesh");
     // Find all resolutions with data - check ALL resolutions, not just up to targetRes
     std::vector<VoxelData::VoxelResolution> activeResolutions;
     for (int res = static_cast<int>(VoxelData::VoxelResolution::Size_1cm); 
@@ -170,6 +172,7 @@ Mesh SurfaceGenerator::generateExportMesh(const VoxelData::VoxelGrid& grid,
 Mesh SurfaceGenerator::generateInternal(const VoxelData::VoxelGrid& grid, 
                                        const SurfaceSettings& settings,
                                        LODLevel lod) {
+    PROFILE_SCOPE("SurfaceGenerator::generateInternal");
     std::lock_guard<std::mutex> lock(m_generationMutex);
     
     // Check cache first
@@ -234,15 +237,18 @@ Mesh SurfaceGenerator::generateInternal(const VoxelData::VoxelGrid& grid,
                 reportProgress(progress * 0.8f, "Generating box mesh");
             });
             
+            PROFILE_SCOPE("SurfaceGenerator::SimpleMesher");
             mesh = m_simpleMesher->generateMesh(grid, settings, meshRes);
         } else {
             // Use DualContouring for smoothed meshes
             Logging::Logger::getInstance().debug("Generating smooth mesh with DualContouring", "SurfaceGenerator");
+            PROFILE_SCOPE("SurfaceGenerator::DualContouring");
             mesh = m_dualContouring->generateMesh(grid, settings);
         }
     } else {
         // Generate LOD
         Logging::Logger::getInstance().debugfc("SurfaceGenerator", "Generating LOD%d mesh", static_cast<int>(lod));
+        PROFILE_SCOPE("SurfaceGenerator::generateLOD");
         mesh = m_lodManager->generateLOD(grid, lod, settings, m_dualContouring.get());
     }
     
@@ -282,6 +288,7 @@ Mesh SurfaceGenerator::generateInternal(const VoxelData::VoxelGrid& grid,
 }
 
 void SurfaceGenerator::applyPostProcessing(Mesh& mesh, const SurfaceSettings& settings) {
+    PROFILE_SCOPE("SurfaceGenerator::applyPostProcessing");
     if (!mesh.isValid()) return;
     
     // Remove duplicate vertices
@@ -377,6 +384,26 @@ void SurfaceGenerator::setCacheMaxMemory(size_t maxBytes) {
     m_meshCache->setMaxMemoryUsage(maxBytes);
 }
 
+float SurfaceGenerator::getCacheHitRate() const {
+    return m_meshCache->getHitRate();
+}
+
+size_t SurfaceGenerator::releaseCacheMemory(size_t bytes) {
+    return m_meshCache->evictBytes(bytes);
+}
+
+size_t SurfaceGenerator::getPreviewCacheMemoryUsage() const {
+    return m_progressiveCache->getMemoryUsage();
+}
+
+void SurfaceGenerator::setPreviewCacheMaxMemory(size_t maxBytes) {
+    m_progressiveCache->setMaxMemoryUsage(maxBytes);
+}
+
+size_t SurfaceGenerator::releasePreviewCacheMemory(size_t bytes) {
+    return m_progressiveCache->evictBytes(bytes);
+}
+
 void SurfaceGenerator::onVoxelDataChanged(const Math::BoundingBox& region, 
                                          VoxelData::VoxelResolution resolution) {
     // Invalidate cache for affected region
@@ -386,6 +413,7 @@ void SurfaceGenerator::onVoxelDataChanged(const Math::BoundingBox& region,
 }
 
 size_t SurfaceGenerator::computeGridHash(const VoxelData::VoxelGrid& grid) const {
+    PROFILE_SCOPE("SurfaceGenerator::computeGridHash");
     // Simple hash based on grid dimensions and content
     size_t hash = 0;
     
@@ -604,6 +632,12 @@ void MeshCache::cacheMesh(const std::string& key, const Mesh& mesh) {
     entry.memoryUsage = meshSize;
     entry.bounds = mesh.bounds;
     
+    // Replacing a key must not count its old mesh twice
+    auto existing = m_cache.find(key);
+    if (existing != m_cache.end()) {
+        m_currentMemoryUsage -= existing->second.memoryUsage;
+    }
+    
     m_cache[key] = std::move(entry);
     m_currentMemoryUsage += meshSize;
 }
@@ -628,6 +662,16 @@ void MeshCache::clear() {
     m_currentMemoryUsage = 0;
 }
 
+size_t MeshCache::evictBytes(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    
+    size_t before = m_currentMemoryUsage;
+    while (before - m_currentMemoryUsage < bytes && !m_cache.empty()) {
+        evictLRU();
+    }
+    return before - m_currentMemoryUsage;
+}
+
 float MeshCache::getHitRate() const {
     size_t total = m_hitCount + m_missCount;
     return (total > 0) ? static_cast<float>(m_hitCount) / total : 0.0f;
@@ -663,6 +707,7 @@ Mesh SurfaceGenerator::generateSmoothedSurface(const VoxelData::VoxelGrid& grid,
 }
 
 void SurfaceGenerator::applySmoothingToMesh(Mesh& mesh, const SurfaceSettings& settings) {
+    PROFILE_SCOPE("SurfaceGenerator::applySmoothingToMesh");
     if (settings.smoothingLevel <= 0) return;
     
     MeshSmoother smoother;
@@ -700,6 +745,7 @@ void SurfaceGenerator::applySmoothingToMesh(Mesh& mesh, const SurfaceSettings& s
 }
 
 void SurfaceGenerator::validateMeshForPrinting(Mesh& mesh, const SurfaceSettings& settings) {
+    PROFILE_SCOPE("SurfaceGenerator::validateMeshForPrinting");
     MeshValidator validator;
     
     auto result = validator.validate(mesh, settings.minFeatureSize);
@@ -910,20 +956,28 @@ void ProgressiveSmoothingCache::cacheProgressiveResult(const std::string& baseKe
     std::lock_guard<std::mutex> lock(m_cacheMutex);
     std::string cacheKey = generateCacheKey(baseKey, smoothingLevel, quality);
     
-    size_t meshSize = mesh.getMemoryUsage();
+    CacheEntry entry;
+    entry.mesh = mesh;
+    
+    // Count the stored copy, which is what eviction subtracts later; its
+    // capacity can differ from the caller's mesh
+    size_t meshSize = entry.mesh.getMemoryUsage();
     
     // Evict entries if necessary
     while (m_currentMemoryUsage + meshSize > m_maxMemoryUsage && !m_cache.empty()) {
         evictLRU();
     }
     
-    CacheEntry entry;
-    entry.mesh = mesh;
     entry.smoothingLevel = smoothingLevel;
     entry.quality = quality;
     entry.timestamp = std::chrono::steady_clock::now();
     entry.isProgressive = isProgressive;
     
+    auto existing = m_cache.find(cacheKey);
+    if (existing != m_cache.end()) {
+        m_currentMemoryUsage -= existing->second.mesh.getMemoryUsage();
+    }
+    
     m_cache[cacheKey] = std::move(entry);
     m_currentMemoryUsage += meshSize;
 }
@@ -955,6 +1009,13 @@ void ProgressiveSmoothingCache::updateProgressiveResult(const std::string& progr
         entry.timestamp = std::chrono::steady_clock::now();
         entry.isProgressive = true;
         
+        // Intermediate results count against the budget like any other
+        auto existing = m_cache.find(progressKey);
+        if (existing != m_cache.end()) {
+            m_currentMemoryUsage -= existing->second.mesh.getMemoryUsage();
+        }
+        m_currentMemoryUsage += mesh.getMemoryUsage();
+        
         m_cache[progressKey] = std::move(entry);
     }
 }
@@ -967,6 +1028,8 @@ void ProgressiveSmoothingCache::finalizeProgressiveResult(const std::string& pro
         // Update the final result
         auto cacheIt = m_cache.find(progressKey);
         if (cacheIt != m_cache.end()) {
+            m_currentMemoryUsage -= cacheIt->second.mesh.getMemoryUsage();
+            m_currentMemoryUsage += finalMesh.getMemoryUsage();
             cacheIt->second.mesh = finalMesh;
             cacheIt->second.isProgressive = false;
             cacheIt->second.timestamp = std::chrono::steady_clock::now();
@@ -1017,6 +1080,16 @@ void ProgressiveSmoothingCache::clearExpired(std::chrono::seconds maxAge) {
     }
 }
 
+size_t ProgressiveSmoothingCache::evictBytes(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    
+    size_t before = m_currentMemoryUsage;
+    while (before - m_currentMemoryUsage < bytes && !m_cache.empty()) {
+        evictLRU();
+    }
+    return before - m_currentMemoryUsage;
+}
+
 void ProgressiveSmoothingCache::evictLRU() {
     if (m_cache.empty()) return;
     
@@ -68,6 +68,12 @@ public:
     void clearCache();
     size_t getCacheMemoryUsage() const;
     void setCacheMaxMemory(size_t maxBytes);
+    float getCacheHitRate() const;
+    // Least recently used meshes go first; return the bytes freed
+    size_t releaseCacheMemory(size_t bytes);
+    size_t getPreviewCacheMemoryUsage() const;
+    void setPreviewCacheMaxMemory(size_t maxBytes);
+    size_t releasePreviewCacheMemory(size_t bytes);
     
     // Async generation
     std::future<Mesh> generateSurfaceAsync(const VoxelData::VoxelGrid& grid, 
@@ -187,6 +193,8 @@ public:
     void clearExpired(std::chrono::seconds maxAge = std::chrono::seconds(30));
     size_t getMemoryUsage() const { return m_currentMemoryUsage; }
     void setMaxMemoryUsage(size_t maxBytes) { m_maxMemoryUsage = maxBytes; }
+    // Evicts least recently used entries until at least bytes are freed
+    size_t evictBytes(size_t bytes);
     
     // Direct cache access for SurfaceGenerator
     bool hasEntry(const std::string& key) const;
@@ -219,6 +227,8 @@ public:
     void clear();
     size_t getMemoryUsage() const { return m_currentMemoryUsage; }
     void setMaxMemoryUsage(size_t maxBytes) { m_maxMemoryUsage = maxBytes; }
+    // Evicts least recently used meshes until at least bytes are freed
+    size_t evictBytes(size_t bytes);
     
     // Statistics
     size_t getHitCount() const { return m_hitCount; }
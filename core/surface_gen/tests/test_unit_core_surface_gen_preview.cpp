@@ -4,6 +4,7 @@
 #include "../../voxel_data/VoxelGrid.h"
 #include "../../voxel_data/VoxelTypes.h"
 #include <chrono>
+#include <thread>
 
 using namespace VoxelEditor::SurfaceGen;
 using namespace VoxelEditor::VoxelData;
@@ -239,4 +240,32 @@ TEST_F(PreviewQualityTest, MemoryManagement) {
     // Cache should be able to handle memory limits
     cache.clear();
     EXPECT_EQ(cache.getMemoryUsage(), 0);
-}
\ No newline at end of file
+}
+
+// Eviction for the memory governor frees the least recently used results first
+TEST_F(PreviewQualityTest, EvictBytesFreesOldestFirst) {
+    ProgressiveSmoothingCache cache;
+    
+    Mesh testMesh;
+    testMesh.vertices.resize(30);
+    for (uint32_t i = 0; i < 30; ++i) {
+        testMesh.indices.push_back(i);
+    }
+    // The cache accounts for its own copy, whose capacity is trimmed to size
+    size_t meshSize = Mesh(testMesh).getMemoryUsage();
+    
+    cache.cacheProgressiveResult("old", testMesh, 1, PreviewQuality::Fast);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    cache.cacheProgressiveResult("new", testMesh, 1, PreviewQuality::Fast);
+    // Replacing an entry does not count it twice
+    cache.cacheProgressiveResult("new", testMesh, 1, PreviewQuality::Fast);
+    EXPECT_EQ(cache.getMemoryUsage(), 2 * meshSize);
+    
+    EXPECT_EQ(cache.evictBytes(1), meshSize);
+    EXPECT_FALSE(cache.hasProgressiveResult("old", 1, PreviewQuality::Fast));
+    EXPECT_TRUE(cache.hasProgressiveResult("new", 1, PreviewQuality::Fast));
+    
+    EXPECT_EQ(cache.evictBytes(10 * meshSize), meshSize);
+    EXPECT_EQ(cache.getMemoryUsage(), 0u);
+    EXPECT_EQ(cache.evictBytes(1), 0u);
+}
@@ -591,4 +591,39 @@ TEST_F(SimpleMesherTest, DegenerateConfigurations) {
         
         EXPECT_GT(area, 0.0001f) << "Triangle should have non-zero area";
     }
-}
\ No newline at end of file
+}
+
+// A caller-provided scratch arena must not change the mesh and is rewound afterwards
+TEST_F(SimpleMesherTest, ArenaProducesSameMesh) {
+    SurfaceSettings settings = SurfaceSettings::Default();
+    
+    // An L-shaped group so faces are partially occluded
+    for (int x = 0; x < 3; ++x) {
+        for (int z = 0; z < 3; ++z) {
+            m_grid->setVoxel(IncrementCoordinates(x * 32, 0, z * 32), true);
+        }
+    }
+    m_grid->setVoxel(IncrementCoordinates(0, 32, 0), true);
+    
+    SimpleMesher plainMesher;
+    Mesh expected = plainMesher.generateMesh(*m_grid, settings, SimpleMesher::MeshResolution::Res_8cm);
+    
+    Memory::FrameArena arena;
+    SimpleMesher arenaMesher;
+    arenaMesher.setArena(&arena);
+    Mesh result = arenaMesher.generateMesh(*m_grid, settings, SimpleMesher::MeshResolution::Res_8cm);
+    
+    ASSERT_EQ(result.vertices.size(), expected.vertices.size());
+    EXPECT_EQ(result.indices, expected.indices);
+    for (size_t i = 0; i < result.vertices.size(); ++i) {
+        EXPECT_EQ(result.vertices[i], expected.vertices[i]);
+    }
+    
+    EXPECT_EQ(arena.getBytesUsed(), 0u);
+    EXPECT_GT(arena.getPeakBytesUsed(), 0u);
+    
+    // Same work again reuses the arena's memory
+    size_t upstreamAllocations = arena.getUpstreamAllocationCount();
+    arenaMesher.generateMesh(*m_grid, settings, SimpleMesher::MeshResolution::Res_8cm);
+    EXPECT_EQ(arena.getUpstreamAllocationCount(), upstreamAllocations);
+}
@@ -9,11 +9,20 @@ namespace VoxelEditor {
 namespace UndoRedo {
 
 HistoryManager::HistoryManager() {
-    m_undoStack.reserve(m_maxHistorySize);
     m_redoStack.reserve(m_maxHistorySize / 2);
+    m_compressionThread = std::thread(&HistoryManager::compressionWorker, this);
 }
 
 HistoryManager::~HistoryManager() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopCompression = true;
+    }
+    m_compressionCondition.notify_one();
+    if (m_compressionThread.joinable()) {
+        m_compressionThread.join();
+    }
+    
     clearHistory();
 }
 
@@ -120,18 +129,19 @@ bool HistoryManager::undo() {
     }
     
     // Get the command to undo
-    auto command = std::move(m_undoStack.back());
+    HistoryEntry entry = std::move(m_undoStack.back());
     m_undoStack.pop_back();
+    m_compressedDepth = std::min(m_compressedDepth, m_undoStack.size());
     
     // Undo the command
     bool success = false;
     try {
-        success = command->undo();
+        success = entry.command->undo();
     } catch (const std::exception& e) {
         // Logging::Logger::getInstance().error("HistoryManager: Command undo failed: " + 
         //                                    std::string(e.what()));
         // Put it back on the undo stack
-        m_undoStack.push_back(std::move(command));
+        m_undoStack.push_back(std::move(entry));
         return false;
     }
     
@@ -139,20 +149,20 @@ bool HistoryManager::undo() {
         // Logging::Logger::getInstance().error("HistoryManager: Command undo returned false: " + 
         //                                    command->getName());
         // Put it back on the undo stack
-        m_undoStack.push_back(std::move(command));
+        m_undoStack.push_back(std::move(entry));
         return false;
     }
     
-    // Add to redo stack
-    m_redoStack.push_back(std::move(command));
+    // Undo may have decompressed the command
+    updateEntryMemory(entry);
     
-    // Update memory usage
-    m_currentMemoryUsage = calculateMemoryUsage();
+    // Add to redo stack
+    m_redoStack.push_back(std::move(entry));
     
     // Notify listeners
     notifyEvent({
         UndoRedoEventType::CommandUndone,
-        m_redoStack.back()->getName(),
+        m_redoStack.back().command->getName(),
         m_undoStack.size(),
         m_currentMemoryUsage,
         canUndoNoLock(),
@@ -170,18 +180,18 @@ bool HistoryManager::redo() {
     }
     
     // Get the command to redo
-    auto command = std::move(m_redoStack.back());
+    HistoryEntry entry = std::move(m_redoStack.back());
     m_redoStack.pop_back();
     
     // Re-execute the command
     bool success = false;
     try {
-        success = command->execute();
+        success = entry.command->execute();
     } catch (const std::exception& e) {
         // Logging::Logger::getInstance().error("HistoryManager: Command redo failed: " + 
         //                                    std::string(e.what()));
         // Put it back on the redo stack
-        m_redoStack.push_back(std::move(command));
+        m_redoStack.push_back(std::move(entry));
         return false;
     }
     
@@ -189,20 +199,18 @@ bool HistoryManager::redo() {
         // Logging::Logger::getInstance().error("HistoryManager: Command redo returned false: " + 
         //                                    command->getName());
         // Put it back on the redo stack
-        m_redoStack.push_back(std::move(command));
+        m_redoStack.push_back(std::move(entry));
         return false;
     }
     
     // Add back to undo stack
-    m_undoStack.push_back(std::move(command));
-    
-    // Update memory usage
-    m_currentMemoryUsage = calculateMemoryUsage();
+    updateEntryMemory(entry);
+    m_undoStack.push_back(std::move(entry));
     
     // Notify listeners
     notifyEvent({
         UndoRedoEventType::CommandRedone,
-        m_undoStack.back()->getName(),
+        m_undoStack.back().command->getName(),
         m_undoStack.size(),
         m_currentMemoryUsage,
         canUndoNoLock(),
@@ -219,6 +227,7 @@ void HistoryManager::clearHistory() {
     m_redoStack.clear();
     m_snapshots.clear();
     m_currentMemoryUsage = 0;
+    m_compressedDepth = 0;
     
     notifyEvent({
         UndoRedoEventType::HistoryCleared,
@@ -259,7 +268,7 @@ std::vector<std::string> HistoryManager::getUndoHistory() const {
     history.reserve(m_undoStack.size());
     
     for (auto it = m_undoStack.rbegin(); it != m_undoStack.rend(); ++it) {
-        history.push_back((*it)->getName());
+        history.push_back(it->command->getName());
     }
     
     return history;
@@ -272,7 +281,7 @@ std::vector<std::string> HistoryManager::getRedoHistory() const {
     history.reserve(m_redoStack.size());
     
     for (auto it = m_redoStack.rbegin(); it != m_redoStack.rend(); ++it) {
-        history.push_back((*it)->getName());
+        history.push_back(it->command->getName());
     }
     
     return history;
@@ -285,7 +294,7 @@ std::string HistoryManager::getLastExecutedCommand() const {
         return "";
     }
     
-    return m_undoStack.back()->getName();
+    return m_undoStack.back().command->getName();
 }
 
 std::string HistoryManager::getLastCommandError() const {
@@ -367,21 +376,46 @@ void HistoryManager::cancelTransaction() {
     });
 }
 
-void HistoryManager::optimizeMemory() {
+size_t HistoryManager::optimizeMemory() {
     std::lock_guard<std::mutex> lock(m_mutex);
     
-    // Compress old commands
+    size_t before = m_currentMemoryUsage;
+    
+    // Compress old commands and snapshots
     if (m_compressionEnabled) {
-        for (auto& command : m_undoStack) {
-            command->compress();
+        compressAll();
+        for (auto& entry : m_redoStack) {
+            entry.command->compress();
+            updateEntryMemory(entry);
         }
-        for (auto& command : m_redoStack) {
-            command->compress();
+    }
+    
+    return before > m_currentMemoryUsage ? before - m_currentMemoryUsage : 0;
+}
+
+size_t HistoryManager::releaseMemory(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    size_t before = m_currentMemoryUsage;
+    while (before - m_currentMemoryUsage < bytes && !m_undoStack.empty()) {
+        eraseOldestCommand();
+        if (!m_snapshots.empty()) {
+            eraseOldestSnapshot();
         }
     }
     
-    // Update memory usage
-    m_currentMemoryUsage = calculateMemoryUsage();
+    size_t freed = before - m_currentMemoryUsage;
+    if (freed > 0) {
+        notifyEvent({
+            UndoRedoEventType::MemoryPressure,
+            "",
+            m_undoStack.size(),
+            m_currentMemoryUsage,
+            canUndoNoLock(),
+            canRedoNoLock()
+        });
+    }
+    return freed;
 }
 
 void HistoryManager::setCompressionEnabled(bool enabled) {
@@ -390,18 +424,27 @@ void HistoryManager::setCompressionEnabled(bool enabled) {
     
     if (!enabled) {
         // Decompress all commands
-        for (auto& command : m_undoStack) {
-            command->decompress();
+        for (auto& entry : m_undoStack) {
+            entry.command->decompress();
+            updateEntryMemory(entry);
         }
-        for (auto& command : m_redoStack) {
-            command->decompress();
+        for (auto& entry : m_redoStack) {
+            entry.command->decompress();
+            updateEntryMemory(entry);
         }
+        m_compressedDepth = 0;
     }
 }
 
+void HistoryManager::setUncompressedDepth(size_t commandCount) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_uncompressedDepth = commandCount;
+    enforceMemoryLimits();
+}
+
 void HistoryManager::setSnapshotInterval(int commandCount) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_snapshotInterval = std::max(1, commandCount);
+    m_snapshotInterval = std::max(0, commandCount);
 }
 
 void HistoryManager::setUndoRedoCallback(UndoRedoCallback callback) {
@@ -425,39 +468,128 @@ void HistoryManager::setRestoreCallback(RestoreCallback callback) {
 }
 
 void HistoryManager::pushToUndoStack(std::unique_ptr<Command> command) {
-    m_undoStack.push_back(std::move(command));
-    m_currentMemoryUsage += m_undoStack.back()->getMemoryUsage();
+    // The command reports its size once, right after executing
+    m_undoStack.emplace_back(std::move(command));
+    m_currentMemoryUsage += m_undoStack.back().memoryUsage;
 }
 
 void HistoryManager::clearRedoStack() {
+    for (const auto& entry : m_redoStack) {
+        m_currentMemoryUsage -= entry.memoryUsage;
+    }
     m_redoStack.clear();
 }
 
 void HistoryManager::enforceMemoryLimits() {
+    if (!m_compressionEnabled && m_currentMemoryUsage <= m_maxMemoryUsage) {
+        return;
+    }
+    
+    // Past half the budget, let the worker compress older entries while
+    // the user keeps editing
+    if (m_compressionEnabled && m_currentMemoryUsage > m_maxMemoryUsage / 2) {
+        requestCompression();
+    }
+    
+    if (m_currentMemoryUsage <= m_maxMemoryUsage) {
+        return;
+    }
+    
+    // Notify about memory pressure
+    if (m_memoryPressureCallback) {
+        m_memoryPressureCallback(m_currentMemoryUsage, m_maxMemoryUsage);
+    }
+    
+    // Compressing everything is far cheaper than losing history, so only
+    // evict once that is not enough
+    if (m_compressionEnabled) {
+        compressAll();
+    }
+    
     while (m_currentMemoryUsage > m_maxMemoryUsage && !m_undoStack.empty()) {
-        // Notify about memory pressure
-        if (m_memoryPressureCallback) {
-            m_memoryPressureCallback(m_currentMemoryUsage, m_maxMemoryUsage);
-        }
-        
         // Remove oldest command
-        m_currentMemoryUsage -= m_undoStack.front()->getMemoryUsage();
-        m_undoStack.erase(m_undoStack.begin());
+        eraseOldestCommand();
         
         // Also remove corresponding snapshot if any
         if (!m_snapshots.empty()) {
-            m_snapshots.erase(m_snapshots.begin());
+            eraseOldestSnapshot();
         }
     }
 }
 
 void HistoryManager::enforceHistoryLimits() {
     while (m_undoStack.size() > m_maxHistorySize) {
-        m_currentMemoryUsage -= m_undoStack.front()->getMemoryUsage();
-        m_undoStack.erase(m_undoStack.begin());
+        eraseOldestCommand();
     }
 }
 
+void HistoryManager::eraseOldestCommand() {
+    m_currentMemoryUsage -= m_undoStack.front().memoryUsage;
+    m_undoStack.pop_front();
+    if (m_compressedDepth > 0) {
+        --m_compressedDepth;
+    }
+}
+
+void HistoryManager::requestCompression() {
+    m_compressionRequested = true;
+    m_compressionCondition.notify_one();
+}
+
+void HistoryManager::compressionWorker() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    while (true) {
+        m_compressionCondition.wait(lock, [this] {
+            return m_stopCompression || m_compressionRequested;
+        });
+        if (m_stopCompression) {
+            return;
+        }
+        m_compressionRequested = false;
+        
+        // One command per lock hold so undo, redo and new edits are never
+        // stalled behind a long compression pass
+        while (!m_stopCompression && compressNextCommand()) {
+            lock.unlock();
+            std::this_thread::yield();
+            lock.lock();
+        }
+    }
+}
+
+bool HistoryManager::compressNextCommand() {
+    if (!m_compressionEnabled || m_compressedDepth + m_uncompressedDepth >= m_undoStack.size()) {
+        return false;
+    }
+    
+    auto& entry = m_undoStack[m_compressedDepth++];
+    entry.command->compress();
+    updateEntryMemory(entry);
+    return true;
+}
+
+void HistoryManager::compressAll() {
+    for (size_t i = m_compressedDepth; i < m_undoStack.size(); ++i) {
+        m_undoStack[i].command->compress();
+        updateEntryMemory(m_undoStack[i]);
+    }
+    m_compressedDepth = m_undoStack.size();
+    
+    // At most m_maxSnapshots of these, so recounting them is constant time
+    for (auto& snapshot : m_snapshots) {
+        m_currentMemoryUsage -= snapshot->getMemoryUsage();
+        snapshot->compress();
+        m_currentMemoryUsage += snapshot->getMemoryUsage();
+    }
+}
+
+void HistoryManager::updateEntryMemory(HistoryEntry& entry) {
+    size_t usage = entry.command->getMemoryUsage();
+    m_currentMemoryUsage = m_currentMemoryUsage - entry.memoryUsage + usage;
+    entry.memoryUsage = usage;
+}
+
 void HistoryManager::createSnapshot() {
     if (!m_snapshotCallback) {
         return;
@@ -466,15 +598,12 @@ void HistoryManager::createSnapshot() {
     try {
         auto snapshot = m_snapshotCallback();
         if (snapshot) {
-            m_snapshots.push_back(std::move(snapshot));
+            addSnapshot(std::move(snapshot));
             
             // Keep only the most recent snapshots
             while (m_snapshots.size() > m_maxSnapshots) {
-                m_snapshots.erase(m_snapshots.begin());
+                eraseOldestSnapshot();
             }
-            
-            // Update memory usage
-            m_currentMemoryUsage = calculateMemoryUsage();
         }
     } catch (const std::exception& e) {
         Logging::Logger::getInstance().error("HistoryManager: Snapshot creation failed: " + std::string(e.what()));
@@ -499,38 +628,14 @@ void HistoryManager::notifyEvent(const UndoRedoEvent& event) {
     }
 }
 
-size_t HistoryManager::calculateMemoryUsage() const {
-    size_t usage = 0;
-    
-    // Calculate command memory usage
-    for (const auto& command : m_undoStack) {
-        if (command) {
-            usage += command->getMemoryUsage();
-        }
-    }
-    
-    for (const auto& command : m_redoStack) {
-        if (command) {
-            usage += command->getMemoryUsage();
-        }
-    }
-    
-    // Calculate snapshot memory usage
-    for (const auto& snapshot : m_snapshots) {
-        if (snapshot) {
-            usage += snapshot->getMemoryUsage();
-        }
-    }
-    
-    // Add transaction memory usage if active
-    if (m_currentTransaction) {
-        usage += m_currentTransaction->getMemoryUsage();
-    }
-    
-    // Add base class overhead
-    usage += sizeof(*this);
-    
-    return usage;
+void HistoryManager::addSnapshot(std::unique_ptr<StateSnapshot> snapshot) {
+    m_currentMemoryUsage += snapshot->getMemoryUsage();
+    m_snapshots.push_back(std::move(snapshot));
+}
+
+void HistoryManager::eraseOldestSnapshot() {
+    m_currentMemoryUsage -= m_snapshots.front()->getMemoryUsage();
+    m_snapshots.erase(m_snapshots.begin());
 }
 
 }
@@ -2,9 +2,12 @@
 
 #include <memory>
 #include <vector>
+#include <deque>
 #include <string>
 #include <functional>
 #include <mutex>
+#include <thread>
+#include <condition_variable>
 
 #include "Command.h"
 
@@ -82,8 +85,17 @@ public:
     void cancelTransaction();
     
     // Memory management
-    void optimizeMemory();
+    // Compresses every entry; returns the bytes saved
+    size_t optimizeMemory();
+    // Drops the oldest undo entries until at least bytes are freed; the
+    // redo stack is kept. Returns the bytes freed.
+    size_t releaseMemory(size_t bytes);
+    // Older history entries are compressed on a background thread once
+    // usage passes half the memory budget; the most recent ones stay
+    // uncompressed so undoing them is never slowed down
     void setCompressionEnabled(bool enabled);
+    void setUncompressedDepth(size_t commandCount);
+    // Take a full-state snapshot every commandCount commands (0 disables)
     void setSnapshotInterval(int commandCount);
     
     // Events
@@ -93,17 +105,30 @@ public:
     void setRestoreCallback(RestoreCallback callback);
     
 private:
+    // A command with the memory it reported when it entered the history.
+    // Usage totals are kept incrementally from these, so undo and redo
+    // never have to walk the stacks.
+    struct HistoryEntry {
+        std::unique_ptr<Command> command;
+        size_t memoryUsage;
+        
+        explicit HistoryEntry(std::unique_ptr<Command> cmd)
+            : command(std::move(cmd)), memoryUsage(command->getMemoryUsage()) {}
+    };
+    
     // Core data structures
-    std::vector<std::unique_ptr<Command>> m_undoStack;
-    std::vector<std::unique_ptr<Command>> m_redoStack;
+    std::deque<HistoryEntry> m_undoStack; // Oldest entries are trimmed from the front
+    std::vector<HistoryEntry> m_redoStack;
     std::unique_ptr<Transaction> m_currentTransaction;
     
     // Limits and settings
     size_t m_maxHistorySize = 100;
     size_t m_maxMemoryUsage = 256 * 1024 * 1024; // 256 MB default
     size_t m_currentMemoryUsage = 0;
-    int m_snapshotInterval = 10;
+    int m_snapshotInterval = 0; // Commands carry their own deltas; full snapshots are opt-in
     bool m_compressionEnabled = true;
+    size_t m_uncompressedDepth = 10;
+    size_t m_compressedDepth = 0; // Oldest undo entries already compressed
     
     // Callbacks
     UndoRedoCallback m_undoRedoCallback;
@@ -122,15 +147,28 @@ private:
     // Thread safety
     mutable std::mutex m_mutex;
     
+    // Background compression
+    std::thread m_compressionThread;
+    std::condition_variable m_compressionCondition;
+    bool m_compressionRequested = false;
+    bool m_stopCompression = false;
+    
     // Private methods
     void pushToUndoStack(std::unique_ptr<Command> command);
     void clearRedoStack();
     void enforceMemoryLimits();
     void enforceHistoryLimits();
+    void eraseOldestCommand();
+    void requestCompression();
+    void compressionWorker();
+    bool compressNextCommand();
+    void compressAll();
     void createSnapshot();
     void restoreFromSnapshot(const StateSnapshot& snapshot);
     void notifyEvent(const UndoRedoEvent& event);
-    size_t calculateMemoryUsage() const;
+    void updateEntryMemory(HistoryEntry& entry);
+    void addSnapshot(std::unique_ptr<StateSnapshot> snapshot);
+    void eraseOldestSnapshot();
     bool canUndoNoLock() const;
     bool canRedoNoLock() const;
 };
@@ -1,4 +1,5 @@
 #include "StateSnapshot.h"
+#include "VoxelDelta.h"
 #include "../voxel_data/VoxelDataManager.h"
 #include "../selection/SelectionManager.h"
 #include "../selection/SelectionSet.h"
@@ -13,6 +14,71 @@
 namespace VoxelEditor {
 namespace UndoRedo {
 
+namespace {
+
+// Raw voxel layout: for each resolution a level byte and a uint32 count,
+// followed by count x/y/z int32 triples
+bool parseVoxelData(const std::vector<uint8_t>& data, std::vector<VoxelDelta::Entry>& entries) {
+    size_t offset = 0;
+    for (int i = 0; i < static_cast<int>(VoxelData::VoxelResolution::COUNT); ++i) {
+        uint8_t res;
+        uint32_t count;
+        if (offset + sizeof(res) + sizeof(count) > data.size()) {
+            return false;
+        }
+        std::memcpy(&res, data.data() + offset, sizeof(res));
+        std::memcpy(&count, data.data() + offset + sizeof(res), sizeof(count));
+        offset += sizeof(res) + sizeof(count);
+        
+        if (offset + static_cast<size_t>(count) * 3 * sizeof(int32_t) > data.size() ||
+            res >= static_cast<uint8_t>(VoxelData::VoxelResolution::COUNT)) {
+            return false;
+        }
+        
+        VoxelData::VoxelResolution resolution = static_cast<VoxelData::VoxelResolution>(res);
+        entries.reserve(entries.size() + count);
+        for (uint32_t j = 0; j < count; ++j) {
+            int32_t coords[3];
+            std::memcpy(coords, data.data() + offset, sizeof(coords));
+            offset += sizeof(coords);
+            entries.emplace_back(Math::IncrementCoordinates(coords[0], coords[1], coords[2]),
+                                 resolution, false, true);
+        }
+    }
+    return true;
+}
+
+void buildVoxelData(const std::vector<VoxelDelta::Entry>& entries, std::vector<uint8_t>& data) {
+    data.clear();
+    data.reserve(static_cast<size_t>(VoxelData::VoxelResolution::COUNT) * 5 + entries.size() * 12);
+    
+    for (int i = 0; i < static_cast<int>(VoxelData::VoxelResolution::COUNT); ++i) {
+        uint8_t res = static_cast<uint8_t>(i);
+        uint32_t count = 0;
+        for (const auto& entry : entries) {
+            if (static_cast<uint8_t>(entry.resolution) == res) {
+                ++count;
+            }
+        }
+        
+        size_t offset = data.size();
+        data.resize(offset + sizeof(res) + sizeof(count) + static_cast<size_t>(count) * 12);
+        std::memcpy(data.data() + offset, &res, sizeof(res));
+        std::memcpy(data.data() + offset + sizeof(res), &count, sizeof(count));
+        offset += sizeof(res) + sizeof(count);
+        
+        for (const auto& entry : entries) {
+            if (static_cast<uint8_t>(entry.resolution) == res) {
+                int32_t coords[3] = {entry.position.x(), entry.position.y(), entry.position.z()};
+                std::memcpy(data.data() + offset, coords, sizeof(coords));
+                offset += sizeof(coords);
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
 StateSnapshot::StateSnapshot()
     : m_timestamp(std::chrono::system_clock::now())
     , m_compressed(false) {
@@ -31,46 +97,50 @@ bool StateSnapshot::captureVoxelData(const VoxelData::VoxelDataManager* voxelMan
     // Capture active resolution
     m_voxelData->activeResolution = voxelManager->getActiveResolution();
     
-    // Capture voxel data for all resolution levels
-    std::ostringstream dataStream;
+    // Size the buffer once: per resolution a level byte and a count, then
+    // 12 bytes per voxel position
+    const int resolutionCount = static_cast<int>(VoxelData::VoxelResolution::COUNT);
     size_t totalVoxels = 0;
+    for (int i = 0; i < resolutionCount; ++i) {
+        const VoxelData::VoxelGrid* grid = voxelManager->getGrid(static_cast<VoxelData::VoxelResolution>(i));
+        if (grid) {
+            totalVoxels += grid->getVoxelCount();
+        }
+    }
     
-    for (int i = 0; i < static_cast<int>(VoxelData::VoxelResolution::COUNT); ++i) {
+    std::vector<uint8_t>& data = m_voxelData->compressedData;
+    data.clear();
+    data.reserve(resolutionCount * (sizeof(uint8_t) + sizeof(uint32_t)) + totalVoxels * 3 * sizeof(int32_t));
+    
+    auto append = [&data](const void* bytes, size_t size) {
+        const uint8_t* begin = static_cast<const uint8_t*>(bytes);
+        data.insert(data.end(), begin, begin + size);
+    };
+    
+    totalVoxels = 0;
+    for (int i = 0; i < resolutionCount; ++i) {
         VoxelData::VoxelResolution resolution = static_cast<VoxelData::VoxelResolution>(i);
         const VoxelData::VoxelGrid* grid = voxelManager->getGrid(resolution);
-        
+        std::vector<VoxelData::VoxelPosition> voxels;
         if (grid) {
-            auto voxels = grid->getAllVoxels();
-            totalVoxels += voxels.size();
-            
-            // Write resolution level and voxel count
-            uint8_t res = static_cast<uint8_t>(resolution);
-            uint32_t count = static_cast<uint32_t>(voxels.size());
-            dataStream.write(reinterpret_cast<const char*>(&res), sizeof(res));
-            dataStream.write(reinterpret_cast<const char*>(&count), sizeof(count));
-            
-            // Write voxel positions
-            for (const auto& voxel : voxels) {
-                int32_t x = voxel.incrementPos.x();
-                int32_t y = voxel.incrementPos.y();
-                int32_t z = voxel.incrementPos.z();
-                dataStream.write(reinterpret_cast<const char*>(&x), sizeof(x));
-                dataStream.write(reinterpret_cast<const char*>(&y), sizeof(y));
-                dataStream.write(reinterpret_cast<const char*>(&z), sizeof(z));
-            }
-        } else {
-            // Write empty grid
-            uint8_t res = static_cast<uint8_t>(resolution);
-            uint32_t count = 0;
-            dataStream.write(reinterpret_cast<const char*>(&res), sizeof(res));
-            dataStream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            voxels = grid->getAllVoxels();
+        }
+        totalVoxels += voxels.size();
+        
+        // Write resolution level and voxel count
+        uint8_t res = static_cast<uint8_t>(resolution);
+        uint32_t count = static_cast<uint32_t>(voxels.size());
+        append(&res, sizeof(res));
+        append(&count, sizeof(count));
+        
+        // Write voxel positions
+        for (const auto& voxel : voxels) {
+            int32_t coords[3] = {voxel.incrementPos.x(), voxel.incrementPos.y(), voxel.incrementPos.z()};
+            append(coords, sizeof(coords));
         }
     }
     
-    // Convert stream to vector
-    std::string data = dataStream.str();
-    m_voxelData->compressedData.assign(data.begin(), data.end());
-    m_voxelData->uncompressedSize = m_voxelData->compressedData.size();
+    m_voxelData->uncompressedSize = data.size();
     
     Logging::Logger::getInstance().info("StateSnapshot: Captured " + std::to_string(totalVoxels) + " voxels");
     
@@ -159,46 +229,53 @@ bool StateSnapshot::restoreVoxelData(VoxelData::VoxelDataManager* voxelManager)
         return false;
     }
     
-    if (m_compressed) {
-        // Need to decompress first
-        const_cast<StateSnapshot*>(this)->decompress();
+    // Decode into a local list; a compressed snapshot stays compressed
+    std::vector<VoxelDelta::Entry> stored;
+    bool valid = m_compressed
+        ? VoxelDelta::decode(m_voxelData->compressedData.data(), m_voxelData->compressedData.size(), stored)
+        : parseVoxelData(m_voxelData->compressedData, stored);
+    if (!valid) {
+        Logging::Logger::getInstance().error("StateSnapshot: Voxel data is truncated or corrupted");
+        return false;
     }
     
-    // Clear existing voxel data
-    voxelManager->clearAll();
-    
     // Restore active resolution
     voxelManager->setActiveResolution(m_voxelData->activeResolution);
     
-    // Parse the stored data
-    std::istringstream dataStream(std::string(m_voxelData->compressedData.begin(), 
-                                             m_voxelData->compressedData.end()));
+    // Only voxels that differ from the snapshot are touched, so restoring a
+    // state close to the current one costs O(differences) in scene edits
+    // rather than clearing and re-inserting everything
+    std::vector<std::vector<Math::IncrementCoordinates>> storedByResolution(
+        static_cast<size_t>(VoxelData::VoxelResolution::COUNT));
+    for (const auto& entry : stored) {
+        storedByResolution[static_cast<size_t>(entry.resolution)].push_back(entry.position);
+    }
+    stored = std::vector<VoxelDelta::Entry>();
     
-    // Read voxel data for each resolution level
+    VoxelDelta delta;
     for (int i = 0; i < static_cast<int>(VoxelData::VoxelResolution::COUNT); ++i) {
-        uint8_t res;
-        uint32_t count;
-        
-        dataStream.read(reinterpret_cast<char*>(&res), sizeof(res));
-        dataStream.read(reinterpret_cast<char*>(&count), sizeof(count));
-        
-        VoxelData::VoxelResolution resolution = static_cast<VoxelData::VoxelResolution>(res);
+        VoxelData::VoxelResolution resolution = static_cast<VoxelData::VoxelResolution>(i);
         
-        // Read and restore voxel positions
-        for (uint32_t j = 0; j < count; ++j) {
-            int32_t x, y, z;
-            dataStream.read(reinterpret_cast<char*>(&x), sizeof(x));
-            dataStream.read(reinterpret_cast<char*>(&y), sizeof(y));
-            dataStream.read(reinterpret_cast<char*>(&z), sizeof(z));
-            
-            Math::Vector3i pos(x, y, z);
-            voxelManager->setVoxel(pos, resolution, true);
+        std::vector<Math::IncrementCoordinates> current;
+        const VoxelData::VoxelGrid* grid = voxelManager->getGrid(resolution);
+        if (grid) {
+            auto voxels = grid->getAllVoxels();
+            current.reserve(voxels.size());
+            for (const auto& voxel : voxels) {
+                current.push_back(voxel.incrementPos);
+            }
         }
+        
+        delta.recordDiff(std::move(current), std::move(storedByResolution[i]), resolution);
     }
     
+    // Applied as one delta so removals at every resolution run before any
+    // placement that would otherwise overlap them
+    bool success = delta.apply(voxelManager);
+    
     Logging::Logger::getInstance().info("StateSnapshot: Restored voxel data");
     
-    return dataStream.good();
+    return success;
 }
 
 bool StateSnapshot::restoreSelections(Selection::SelectionManager* selectionManager) const {
@@ -360,36 +437,21 @@ void StateSnapshot::compressVoxelData() {
         return;
     }
     
-    // Simple RLE compression for voxel data
-    std::vector<uint8_t> compressed;
-    compressed.reserve(m_voxelData->compressedData.size() / 2); // Estimate
-    
-    size_t i = 0;
-    while (i < m_voxelData->compressedData.size()) {
-        uint8_t value = m_voxelData->compressedData[i];
-        uint8_t count = 1;
-        
-        // Count consecutive identical bytes (up to 255)
-        while (i + count < m_voxelData->compressedData.size() && 
-               count < 255 && 
-               m_voxelData->compressedData[i + count] == value) {
-            count++;
-        }
-        
-        // Write count and value
-        compressed.push_back(count);
-        compressed.push_back(value);
-        
-        i += count;
+    std::vector<VoxelDelta::Entry> entries;
+    if (!parseVoxelData(m_voxelData->compressedData, entries)) {
+        Logging::Logger::getInstance().error("StateSnapshot: Cannot compress corrupted voxel data");
+        return;
     }
     
-    // Replace with compressed data if smaller
-    if (compressed.size() < m_voxelData->compressedData.size()) {
-        m_voxelData->compressedData = std::move(compressed);
-        Logging::Logger::getInstance().info("StateSnapshot: Compressed voxel data from " + 
-                                          std::to_string(m_voxelData->uncompressedSize) + 
-                                          " to " + std::to_string(m_voxelData->compressedData.size()) + " bytes");
-    }
+    // Sorted positions become runs of constant steps, then LZ4 if available
+    std::vector<uint8_t> compressed;
+    VoxelDelta::encode(std::move(entries), compressed);
+    compressed.shrink_to_fit();
+    m_voxelData->compressedData = std::move(compressed);
+    
+    Logging::Logger::getInstance().info("StateSnapshot: Compressed voxel data from " + 
+                                      std::to_string(m_voxelData->uncompressedSize) + 
+                                      " to " + std::to_string(m_voxelData->compressedData.size()) + " bytes");
 }
 
 void StateSnapshot::decompressVoxelData() {
@@ -397,22 +459,13 @@ void StateSnapshot::decompressVoxelData() {
         return;
     }
     
-    // Simple RLE decompression
-    std::vector<uint8_t> decompressed;
-    decompressed.reserve(m_voxelData->uncompressedSize);
-    
-    for (size_t i = 0; i < m_voxelData->compressedData.size(); i += 2) {
-        if (i + 1 >= m_voxelData->compressedData.size()) break;
-        
-        uint8_t count = m_voxelData->compressedData[i];
-        uint8_t value = m_voxelData->compressedData[i + 1];
-        
-        for (uint8_t j = 0; j < count; ++j) {
-            decompressed.push_back(value);
-        }
+    std::vector<VoxelDelta::Entry> entries;
+    if (!VoxelDelta::decode(m_voxelData->compressedData.data(), m_voxelData->compressedData.size(), entries)) {
+        Logging::Logger::getInstance().error("StateSnapshot: Compressed voxel data is corrupted");
+        return;
     }
     
-    m_voxelData->compressedData = std::move(decompressed);
+    buildVoxelData(entries, m_voxelData->compressedData);
 }
 
 bool StateSnapshot::saveToFile(const std::string& filepath) const {
@@ -445,6 +498,7 @@ bool StateSnapshot::saveToFile(const std::string& filepath) const {
     if (!m_selections.empty()) flags |= 0x02;
     if (m_camera) flags |= 0x04;
     if (m_renderSettings) flags |= 0x08;
+    if (m_compressed) flags |= 0x10;
     file.write(reinterpret_cast<const char*>(&flags), sizeof(flags));
     
     // Write voxel data if present
@@ -499,6 +553,7 @@ bool StateSnapshot::loadFromFile(const std::string& filepath) {
     // Read flags
     uint8_t flags;
     file.read(reinterpret_cast<char*>(&flags), sizeof(flags));
+    m_compressed = (flags & 0x10) != 0;
     
     // Read voxel data if present
     if (flags & 0x01) {
@@ -161,7 +161,7 @@ bool BulkVoxelEditCommand::undo() {
 
 std::string BulkVoxelEditCommand::getName() const {
     std::stringstream ss;
-    ss << "Edit " << m_changes.size() << " Voxels";
+    ss << "Edit " << getChangeCount() << " Voxels";
     return ss.str();
 }
 
@@ -212,18 +212,38 @@ void BulkVoxelEditCommand::addChanges(const std::vector<VoxelChange>& changes) {
 }
 
 void BulkVoxelEditCommand::compressChanges() {
-    // TODO: Implement actual compression
-    // For now, just clear the changes to save memory
+    // Keep the recorded order: undo replays it backwards through setVoxel,
+    // and with mixed resolutions a removal must be undone after the
+    // placements that followed it
+    std::vector<VoxelDelta::Entry> entries;
+    entries.reserve(m_changes.size());
+    for (const auto& change : m_changes) {
+        entries.emplace_back(change.position, change.resolution, change.oldValue, change.newValue);
+    }
+    
+    m_compressedCount = entries.size();
+    VoxelDelta::encode(std::move(entries), m_compressedData, true);
+    m_compressedData.shrink_to_fit();
+    
     m_changes.clear();
     m_changes.shrink_to_fit();
 }
 
 void BulkVoxelEditCommand::decompressChanges() {
-    // TODO: Implement actual decompression
-    // For now, we can't recover if we've compressed
-    if (m_changes.empty() && !m_compressedData.empty()) {
-        Logging::Logger::getInstance().warning("BulkVoxelEditCommand: Cannot decompress - compression not implemented");
+    std::vector<VoxelDelta::Entry> entries;
+    if (!VoxelDelta::decode(m_compressedData.data(), m_compressedData.size(), entries)) {
+        Logging::Logger::getInstance().error("BulkVoxelEditCommand: Compressed changes are corrupted");
     }
+    
+    m_changes.clear();
+    m_changes.reserve(entries.size());
+    for (const auto& entry : entries) {
+        m_changes.emplace_back(entry.position, entry.resolution, entry.oldValue, entry.newValue);
+    }
+    
+    m_compressedData.clear();
+    m_compressedData.shrink_to_fit();
+    m_compressedCount = 0;
 }
 
 // VoxelFillCommand implementation
@@ -245,35 +265,30 @@ bool VoxelFillCommand::execute() {
     // Clear any previous error
     m_lastError.clear();
     
-    // Use the new fillRegion API instead of manual implementation
-    auto result = m_voxelManager->fillRegion(m_region, m_resolution, m_fillValue);
+    // Redo replays the recorded changes instead of refilling the whole region
+    if (m_recorded) {
+        m_delta.decompress();
+        if (!m_delta.apply(m_voxelManager)) {
+            m_lastError = "Failed to reapply fill";
+            return false;
+        }
+        m_executed = true;
+        return true;
+    }
+    
+    // Let fillRegion report exactly which voxels it modified so undo only
+    // touches those, rather than everything of the fill value in the region
+    std::vector<VoxelData::VoxelChange> appliedChanges;
+    auto result = m_voxelManager->fillRegion(m_region, m_resolution, m_fillValue, &appliedChanges);
     
     if (!result.success) {
         m_lastError = result.errorMessage;
         return false;
     }
     
-    // For undo support, we need to capture what was actually changed
-    // The fillRegion API doesn't return the specific changes, so we query the region
-    // to build our undo state. This is a temporary approach until we enhance the API.
-    m_previousState.clear();
-    
-    // Query the region to see what voxels exist now
-    auto voxelsInRegion = m_voxelManager->getVoxelsInRegion(m_region);
-    
-    // For each voxel in the region, record what it was before
-    m_previousState.reserve(result.voxelsFilled);
-    for (const auto& voxelPos : voxelsInRegion) {
-        if (voxelPos.resolution == m_resolution) {
-            // This voxel matches our resolution and is in the region
-            bool currentValue = m_voxelManager->getVoxel(voxelPos.incrementPos, m_resolution);
-            if (currentValue == m_fillValue) {
-                // This voxel has our fill value, so it was likely changed by the operation
-                // Record that it should be set to the opposite value for undo
-                m_previousState.emplace_back(voxelPos.incrementPos, m_resolution, !m_fillValue, m_fillValue);
-            }
-        }
-    }
+    m_delta.record(appliedChanges);
+    m_delta.finalize();
+    m_recorded = true;
     
     Logging::Logger::getInstance().debug("VoxelFillCommand: Filled " + std::to_string(result.voxelsFilled) + 
         " voxels out of " + std::to_string(result.totalPositions) + " positions");
@@ -287,27 +302,18 @@ bool VoxelFillCommand::undo() {
         return false;
     }
     
-    bool allSuccessful = true;
-    
-    // Restore previous state
-    for (const auto& change : m_previousState) {
-        if (change.oldValue != change.newValue) {
-            bool success = m_voxelManager->setVoxel(change.position, change.resolution, change.oldValue);
-            if (!success) {
-                allSuccessful = false;
-            }
-        }
-    }
+    m_delta.decompress();
     
-    if (allSuccessful) {
-        m_executed = false;
+    if (!m_delta.revert(m_voxelManager)) {
+        return false;
     }
     
-    return allSuccessful;
+    m_executed = false;
+    return true;
 }
 
 size_t VoxelFillCommand::getMemoryUsage() const {
-    return sizeof(*this) + m_previousState.capacity() * sizeof(BulkVoxelEditCommand::VoxelChange);
+    return sizeof(*this) + m_delta.getMemoryUsage();
 }
 
 // VoxelCopyCommand implementation
@@ -326,8 +332,14 @@ VoxelCopyCommand::VoxelCopyCommand(VoxelData::VoxelDataManager* voxelManager,
 }
 
 bool VoxelCopyCommand::execute() {
-    m_changes.clear();
-    m_changes.reserve(m_sourcePositions.size());
+    if (m_recorded) {
+        m_delta.decompress();
+        if (!m_delta.apply(m_voxelManager)) {
+            return false;
+        }
+        m_executed = true;
+        return true;
+    }
     
     bool allSuccessful = true;
     
@@ -339,22 +351,29 @@ bool VoxelCopyCommand::execute() {
                 sourcePos.y() + m_offset.y(),
                 sourcePos.z() + m_offset.z()
             );
-            bool oldValue = m_voxelManager->getVoxel(destPos, m_resolution);
-            
-            m_changes.emplace_back(destPos, m_resolution, oldValue, true);
             
             bool success = m_voxelManager->setVoxel(destPos, m_resolution, true);
-            if (!success) {
+            if (success) {
+                m_delta.record(destPos, m_resolution, false, true);
+            } else {
                 allSuccessful = false;
             }
         }
     }
     
-    if (allSuccessful) {
-        m_executed = true;
+    if (!allSuccessful) {
+        // Roll back the partial copy so a failed command leaves no trace
+        m_delta.revert(m_voxelManager);
+        m_delta.clear();
+        return false;
     }
     
-    return allSuccessful;
+    // Later undo/redo only needs the delta, not the source list
+    m_delta.finalize();
+    std::vector<Math::IncrementCoordinates>().swap(m_sourcePositions);
+    m_recorded = true;
+    m_executed = true;
+    return true;
 }
 
 bool VoxelCopyCommand::undo() {
@@ -362,27 +381,21 @@ bool VoxelCopyCommand::undo() {
         return false;
     }
     
-    bool allSuccessful = true;
+    m_delta.decompress();
     
     // Restore previous state at destination positions
-    for (const auto& change : m_changes) {
-        bool success = m_voxelManager->setVoxel(change.position, change.resolution, change.oldValue);
-        if (!success) {
-            allSuccessful = false;
-        }
-    }
-    
-    if (allSuccessful) {
-        m_executed = false;
+    if (!m_delta.revert(m_voxelManager)) {
+        return false;
     }
     
-    return allSuccessful;
+    m_executed = false;
+    return true;
 }
 
 size_t VoxelCopyCommand::getMemoryUsage() const {
     return sizeof(*this) + 
            m_sourcePositions.capacity() * sizeof(Math::IncrementCoordinates) +
-           m_changes.capacity() * sizeof(BulkVoxelEditCommand::VoxelChange);
+           m_delta.getMemoryUsage();
 }
 
 // VoxelMoveCommand implementation
@@ -401,50 +414,64 @@ VoxelMoveCommand::VoxelMoveCommand(VoxelData::VoxelDataManager* voxelManager,
 }
 
 bool VoxelMoveCommand::execute() {
-    m_sourceChanges.clear();
-    m_destChanges.clear();
-    m_sourceChanges.reserve(m_positions.size());
-    m_destChanges.reserve(m_positions.size());
+    if (m_recorded) {
+        m_delta.decompress();
+        if (!m_delta.apply(m_voxelManager)) {
+            return false;
+        }
+        m_executed = true;
+        return true;
+    }
     
-    // First, gather all source voxels and destination states
+    // First, gather all source voxels
+    std::vector<Math::IncrementCoordinates> sources;
+    sources.reserve(m_positions.size());
     for (const auto& sourcePos : m_positions) {
-        bool sourceValue = m_voxelManager->getVoxel(sourcePos, m_resolution);
-        if (sourceValue) {
-            Math::IncrementCoordinates destPos(
-                sourcePos.x() + m_offset.x(),
-                sourcePos.y() + m_offset.y(),
-                sourcePos.z() + m_offset.z()
-            );
-            bool destOldValue = m_voxelManager->getVoxel(destPos, m_resolution);
-            
-            m_sourceChanges.emplace_back(sourcePos, m_resolution, true, false);
-            m_destChanges.emplace_back(destPos, m_resolution, destOldValue, true);
+        if (m_voxelManager->getVoxel(sourcePos, m_resolution)) {
+            sources.push_back(sourcePos);
         }
     }
     
     bool allSuccessful = true;
     
     // Clear source positions
-    for (const auto& change : m_sourceChanges) {
-        bool success = m_voxelManager->setVoxel(change.position, change.resolution, false);
-        if (!success) {
+    for (const auto& sourcePos : sources) {
+        if (m_voxelManager->setVoxel(sourcePos, m_resolution, false)) {
+            m_delta.record(sourcePos, m_resolution, true, false);
+        } else {
             allSuccessful = false;
         }
     }
     
-    // Set destination positions
-    for (const auto& change : m_destChanges) {
-        bool success = m_voxelManager->setVoxel(change.position, change.resolution, true);
-        if (!success) {
+    // Set destination positions; a destination that was also a source
+    // cancels out in finalize()
+    for (const auto& sourcePos : sources) {
+        Math::IncrementCoordinates destPos(
+            sourcePos.x() + m_offset.x(),
+            sourcePos.y() + m_offset.y(),
+            sourcePos.z() + m_offset.z()
+        );
+        if (m_voxelManager->setVoxel(destPos, m_resolution, true)) {
+            m_delta.record(destPos, m_resolution, false, true);
+        } else {
             allSuccessful = false;
         }
     }
     
-    if (allSuccessful) {
-        m_executed = true;
+    if (!allSuccessful) {
+        // Roll back the partial move so a failed command leaves no trace
+        m_delta.finalize();
+        m_delta.revert(m_voxelManager);
+        m_delta.clear();
+        return false;
     }
     
-    return allSuccessful;
+    // Later undo/redo only needs the delta, not the position list
+    m_delta.finalize();
+    std::vector<Math::IncrementCoordinates>().swap(m_positions);
+    m_recorded = true;
+    m_executed = true;
+    return true;
 }
 
 bool VoxelMoveCommand::undo() {
@@ -452,36 +479,21 @@ bool VoxelMoveCommand::undo() {
         return false;
     }
     
-    bool allSuccessful = true;
-    
-    // Restore destination positions first
-    for (const auto& change : m_destChanges) {
-        bool success = m_voxelManager->setVoxel(change.position, change.resolution, change.oldValue);
-        if (!success) {
-            allSuccessful = false;
-        }
-    }
+    m_delta.decompress();
     
-    // Restore source positions
-    for (const auto& change : m_sourceChanges) {
-        bool success = m_voxelManager->setVoxel(change.position, change.resolution, change.oldValue);
-        if (!success) {
-            allSuccessful = false;
-        }
-    }
-    
-    if (allSuccessful) {
-        m_executed = false;
+    // Clears destinations before restoring sources
+    if (!m_delta.revert(m_voxelManager)) {
+        return false;
     }
     
-    return allSuccessful;
+    m_executed = false;
+    return true;
 }
 
 size_t VoxelMoveCommand::getMemoryUsage() const {
     return sizeof(*this) + 
            m_positions.capacity() * sizeof(Math::IncrementCoordinates) +
-           m_sourceChanges.capacity() * sizeof(BulkVoxelEditCommand::VoxelChange) +
-           m_destChanges.capacity() * sizeof(BulkVoxelEditCommand::VoxelChange);
+           m_delta.getMemoryUsage();
 }
 
 }
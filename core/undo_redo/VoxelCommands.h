@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "Command.h"
+#include "VoxelDelta.h"
 #include "../voxel_data/VoxelDataManager.h"
 #include "../voxel_data/VoxelTypes.h"
 #include "../../foundation/math/Vector3i.h"
@@ -67,13 +68,16 @@ public:
     void addChange(const VoxelChange& change);
     void addChanges(const std::vector<VoxelChange>& changes);
     
-    size_t getChangeCount() const { return m_changes.size(); }
+    size_t getChangeCount() const {
+        return m_compressed ? m_compressedCount : m_changes.size();
+    }
     
 private:
     VoxelData::VoxelDataManager* m_voxelManager;
     std::vector<VoxelChange> m_changes;
     bool m_compressed = false;
-    std::vector<uint8_t> m_compressedData;
+    std::vector<uint8_t> m_compressedData;  // VoxelDelta encoding of m_changes
+    size_t m_compressedCount = 0;
     
     void compressChanges();
     void decompressChanges();
@@ -93,12 +97,16 @@ public:
     CommandType getType() const override { return CommandType::VoxelEdit; }
     size_t getMemoryUsage() const override;
     
+    void compress() override { m_delta.compress(); }
+    void decompress() override { m_delta.decompress(); }
+    
 private:
     VoxelData::VoxelDataManager* m_voxelManager;
     Math::BoundingBox m_region;
     VoxelData::VoxelResolution m_resolution;
     bool m_fillValue;
-    std::vector<BulkVoxelEditCommand::VoxelChange> m_previousState;
+    VoxelDelta m_delta;  // Voxels the fill actually changed
+    bool m_recorded = false;
 };
 
 // Copy voxels command
@@ -115,12 +123,16 @@ public:
     CommandType getType() const override { return CommandType::VoxelEdit; }
     size_t getMemoryUsage() const override;
     
+    void compress() override { m_delta.compress(); }
+    void decompress() override { m_delta.decompress(); }
+    
 private:
     VoxelData::VoxelDataManager* m_voxelManager;
     std::vector<Math::IncrementCoordinates> m_sourcePositions;
     Math::IncrementCoordinates m_offset;
     VoxelData::VoxelResolution m_resolution;
-    std::vector<BulkVoxelEditCommand::VoxelChange> m_changes;
+    VoxelDelta m_delta;
+    bool m_recorded = false;
 };
 
 // Move voxels command
@@ -137,13 +149,16 @@ public:
     CommandType getType() const override { return CommandType::VoxelEdit; }
     size_t getMemoryUsage() const override;
     
+    void compress() override { m_delta.compress(); }
+    void decompress() override { m_delta.decompress(); }
+    
 private:
     VoxelData::VoxelDataManager* m_voxelManager;
     std::vector<Math::IncrementCoordinates> m_positions;
     Math::IncrementCoordinates m_offset;
     VoxelData::VoxelResolution m_resolution;
-    std::vector<BulkVoxelEditCommand::VoxelChange> m_sourceChanges;
-    std::vector<BulkVoxelEditCommand::VoxelChange> m_destChanges;
+    VoxelDelta m_delta;
+    bool m_recorded = false;
 };
 
 }
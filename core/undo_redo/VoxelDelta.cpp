@@ -0,0 +1,350 @@
+#include "VoxelDelta.h"
+#include "../../foundation/logging/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+namespace VoxelEditor {
+namespace UndoRedo {
+
+namespace {
+
+inline bool positionLess(const Math::IncrementCoordinates& a, const Math::IncrementCoordinates& b) {
+    return std::make_tuple(a.x(), a.y(), a.z()) < std::make_tuple(b.x(), b.y(), b.z());
+}
+
+inline bool entryLess(const VoxelDelta::Entry& a, const VoxelDelta::Entry& b) {
+    if (a.resolution != b.resolution) {
+        return a.resolution < b.resolution;
+    }
+    return positionLess(a.position, b.position);
+}
+
+inline bool sameVoxel(const VoxelDelta::Entry& a, const VoxelDelta::Entry& b) {
+    return a.resolution == b.resolution && a.position == b.position;
+}
+
+// Codec stream methods
+constexpr uint8_t METHOD_VARINT = 0;
+constexpr uint8_t METHOD_LZ4 = 1;
+
+inline void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+inline bool readVarint(const uint8_t*& in, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && in < end; shift += 7) {
+        uint8_t byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline uint8_t valueFlags(const VoxelDelta::Entry& entry) {
+    return static_cast<uint8_t>((entry.oldValue ? 2 : 0) | (entry.newValue ? 1 : 0));
+}
+
+} // anonymous namespace
+
+void VoxelDelta::record(const Math::IncrementCoordinates& position, VoxelData::VoxelResolution resolution,
+                        bool oldValue, bool newValue) {
+    if (oldValue != newValue) {
+        m_entries.emplace_back(position, resolution, oldValue, newValue);
+    }
+}
+
+void VoxelDelta::record(const std::vector<VoxelData::VoxelChange>& changes) {
+    m_entries.reserve(m_entries.size() + changes.size());
+    for (const auto& change : changes) {
+        record(change.position, change.resolution, change.oldValue, change.newValue);
+    }
+}
+
+void VoxelDelta::recordDiff(std::vector<Math::IncrementCoordinates> before,
+                            std::vector<Math::IncrementCoordinates> after,
+                            VoxelData::VoxelResolution resolution) {
+    std::sort(before.begin(), before.end(), positionLess);
+    std::sort(after.begin(), after.end(), positionLess);
+
+    auto b = before.begin();
+    auto a = after.begin();
+    while (b != before.end() || a != after.end()) {
+        if (a == after.end() || (b != before.end() && positionLess(*b, *a))) {
+            m_entries.emplace_back(*b++, resolution, true, false);
+        } else if (b == before.end() || positionLess(*a, *b)) {
+            m_entries.emplace_back(*a++, resolution, false, true);
+        } else {
+            ++a;
+            ++b;
+        }
+    }
+}
+
+void VoxelDelta::finalize() {
+    // Stable sort keeps recording order within a voxel, so the first entry
+    // holds the original value and the last one the final value
+    std::stable_sort(m_entries.begin(), m_entries.end(), entryLess);
+
+    size_t out = 0;
+    for (size_t i = 0; i < m_entries.size();) {
+        size_t last = i;
+        while (last + 1 < m_entries.size() && sameVoxel(m_entries[last + 1], m_entries[i])) {
+            ++last;
+        }
+
+        Entry merged = m_entries[i];
+        merged.newValue = m_entries[last].newValue;
+        if (merged.oldValue != merged.newValue) {
+            m_entries[out++] = merged;
+        }
+        i = last + 1;
+    }
+
+    m_entries.erase(m_entries.begin() + out, m_entries.end());
+    m_entries.shrink_to_fit();
+}
+
+bool VoxelDelta::apply(VoxelData::VoxelDataManager* voxelManager) const {
+    return setValues(voxelManager, true);
+}
+
+bool VoxelDelta::revert(VoxelData::VoxelDataManager* voxelManager) const {
+    return setValues(voxelManager, false);
+}
+
+void VoxelDelta::compress() {
+    if (m_compressed || m_entries.empty()) {
+        return;
+    }
+
+    m_compressedCount = m_entries.size();
+    encode(std::move(m_entries), m_compressedData);
+    m_compressedData.shrink_to_fit();
+    m_entries = std::vector<Entry>();
+    m_compressed = true;
+}
+
+void VoxelDelta::decompress() {
+    if (!m_compressed) {
+        return;
+    }
+
+    if (!decode(m_compressedData.data(), m_compressedData.size(), m_entries)) {
+        Logging::Logger::getInstance().error("VoxelDelta: Compressed delta is corrupted");
+    }
+    m_entries.shrink_to_fit();
+    m_compressedData = std::vector<uint8_t>();
+    m_compressedCount = 0;
+    m_compressed = false;
+}
+
+void VoxelDelta::clear() {
+    m_entries = std::vector<Entry>();
+    m_compressedData = std::vector<uint8_t>();
+    m_compressedCount = 0;
+    m_compressed = false;
+}
+
+size_t VoxelDelta::getMemoryUsage() const {
+    return m_entries.capacity() * sizeof(Entry) + m_compressedData.capacity();
+}
+
+void VoxelDelta::encode(std::vector<Entry> entries, std::vector<uint8_t>& output, bool keepOrder) {
+    if (!keepOrder) {
+        std::sort(entries.begin(), entries.end(), entryLess);
+    }
+
+    // Each run is: count, resolution, value flags, then the zigzag step
+    // from the previous position. Sorted fills and scene snapshots are
+    // mostly long runs of a constant step, so they collapse to a few bytes
+    std::vector<uint8_t> stream;
+    stream.reserve(entries.size() + 16);
+    writeVarint(stream, entries.size());
+
+    int64_t prev[3] = {0, 0, 0};
+    size_t i = 0;
+    while (i < entries.size()) {
+        const Entry& first = entries[i];
+        int64_t step[3] = {
+            first.position.x() - prev[0],
+            first.position.y() - prev[1],
+            first.position.z() - prev[2]
+        };
+
+        size_t run = 1;
+        while (i + run < entries.size()) {
+            const Entry& next = entries[i + run];
+            const Entry& last = entries[i + run - 1];
+            if (next.resolution != first.resolution || valueFlags(next) != valueFlags(first) ||
+                next.position.x() - last.position.x() != step[0] ||
+                next.position.y() - last.position.y() != step[1] ||
+                next.position.z() - last.position.z() != step[2]) {
+                break;
+            }
+            ++run;
+        }
+
+        writeVarint(stream, run);
+        stream.push_back(static_cast<uint8_t>(first.resolution));
+        stream.push_back(valueFlags(first));
+        writeVarint(stream, zigzag(step[0]));
+        writeVarint(stream, zigzag(step[1]));
+        writeVarint(stream, zigzag(step[2]));
+
+        const Entry& last = entries[i + run - 1];
+        prev[0] = last.position.x();
+        prev[1] = last.position.y();
+        prev[2] = last.position.z();
+        i += run;
+    }
+
+    output.clear();
+    output.push_back(METHOD_VARINT);
+    writeVarint(output, stream.size());
+
+#ifdef HAVE_LZ4
+    if (stream.size() <= static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+        int bound = LZ4_compressBound(static_cast<int>(stream.size()));
+        std::vector<uint8_t> packed(static_cast<size_t>(bound));
+        int packedSize = LZ4_compress_default(reinterpret_cast<const char*>(stream.data()),
+                                              reinterpret_cast<char*>(packed.data()),
+                                              static_cast<int>(stream.size()), bound);
+        if (packedSize > 0 && static_cast<size_t>(packedSize) < stream.size()) {
+            output[0] = METHOD_LZ4;
+            output.insert(output.end(), packed.begin(), packed.begin() + packedSize);
+            return;
+        }
+    }
+#endif
+
+    output.insert(output.end(), stream.begin(), stream.end());
+}
+
+bool VoxelDelta::decode(const uint8_t* data, size_t size, std::vector<Entry>& entries) {
+    entries.clear();
+    if (!data || size == 0) {
+        return false;
+    }
+
+    const uint8_t* in = data + 1;
+    const uint8_t* end = data + size;
+    uint64_t streamSize = 0;
+    if (!readVarint(in, end, streamSize)) {
+        return false;
+    }
+
+    std::vector<uint8_t> unpacked;
+    if (data[0] == METHOD_LZ4) {
+#ifdef HAVE_LZ4
+        unpacked.resize(streamSize);
+        int result = LZ4_decompress_safe(reinterpret_cast<const char*>(in),
+                                         reinterpret_cast<char*>(unpacked.data()),
+                                         static_cast<int>(end - in), static_cast<int>(streamSize));
+        if (result < 0 || static_cast<uint64_t>(result) != streamSize) {
+            return false;
+        }
+        in = unpacked.data();
+        end = in + unpacked.size();
+#else
+        Logging::Logger::getInstance().error("VoxelDelta: LZ4 data but LZ4 support is not built in");
+        return false;
+#endif
+    } else if (data[0] != METHOD_VARINT || static_cast<uint64_t>(end - in) != streamSize) {
+        return false;
+    }
+
+    uint64_t count = 0;
+    if (!readVarint(in, end, count)) {
+        return false;
+    }
+    entries.reserve(static_cast<size_t>(std::min<uint64_t>(count, streamSize * 64)));
+
+    int64_t prev[3] = {0, 0, 0};
+    while (entries.size() < count) {
+        uint64_t run = 0;
+        uint64_t zigzagStep[3];
+        if (!readVarint(in, end, run) || run == 0 || run > count - entries.size() || end - in < 2) {
+            return false;
+        }
+        uint8_t resolution = *in++;
+        uint8_t flags = *in++;
+        if (resolution >= static_cast<uint8_t>(VoxelData::VoxelResolution::COUNT) ||
+            !readVarint(in, end, zigzagStep[0]) || !readVarint(in, end, zigzagStep[1]) ||
+            !readVarint(in, end, zigzagStep[2])) {
+            return false;
+        }
+
+        int64_t step[3] = {unzigzag(zigzagStep[0]), unzigzag(zigzagStep[1]), unzigzag(zigzagStep[2])};
+        for (uint64_t r = 0; r < run; ++r) {
+            prev[0] += step[0];
+            prev[1] += step[1];
+            prev[2] += step[2];
+            entries.emplace_back(Math::IncrementCoordinates(static_cast<int>(prev[0]),
+                                                            static_cast<int>(prev[1]),
+                                                            static_cast<int>(prev[2])),
+                                 static_cast<VoxelData::VoxelResolution>(resolution),
+                                 (flags & 2) != 0, (flags & 1) != 0);
+        }
+    }
+
+    return in == end;
+}
+
+bool VoxelDelta::setValues(VoxelData::VoxelDataManager* voxelManager, bool forward) const {
+    if (!voxelManager) {
+        return false;
+    }
+
+    std::vector<Entry> decoded;
+    if (m_compressed && !decode(m_compressedData.data(), m_compressedData.size(), decoded)) {
+        Logging::Logger::getInstance().error("VoxelDelta: Compressed delta is corrupted");
+        return false;
+    }
+    const std::vector<Entry>& entries = m_compressed ? decoded : m_entries;
+
+    bool allSuccessful = true;
+
+    for (int pass = 0; pass < 2; ++pass) {
+        const bool placing = pass == 1;
+        for (const auto& entry : entries) {
+            bool target = forward ? entry.newValue : entry.oldValue;
+            if (target != placing) {
+                continue;
+            }
+
+            // setVoxel reports redundant writes as failures; the voxel already
+            // holding the target value is fine here
+            if (!voxelManager->setVoxel(entry.position, entry.resolution, target) &&
+                voxelManager->getVoxel(entry.position, entry.resolution) != target) {
+                allSuccessful = false;
+                Logging::Logger::getInstance().error("VoxelDelta: Failed to restore voxel at " +
+                                                   entry.position.toString());
+            }
+        }
+    }
+
+    return allSuccessful;
+}
+
+}
+}
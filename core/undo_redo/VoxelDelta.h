@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "../voxel_data/VoxelTypes.h"
+#include "../voxel_data/VoxelDataManager.h"
+#include "../../foundation/math/CoordinateTypes.h"
+
+namespace VoxelEditor {
+namespace UndoRedo {
+
+// Sparse record of the voxels a command actually changed. Undo and redo
+// replay only these entries, so their cost is proportional to the edit
+// rather than to the scene, and history memory tracks edit volume.
+class VoxelDelta {
+public:
+    struct Entry {
+        Math::IncrementCoordinates position;
+        VoxelData::VoxelResolution resolution;
+        bool oldValue;
+        bool newValue;
+
+        Entry(const Math::IncrementCoordinates& pos, VoxelData::VoxelResolution res, bool oldVal, bool newVal)
+            : position(pos), resolution(res), oldValue(oldVal), newValue(newVal) {}
+    };
+
+    // Recording; entries whose old and new values match are ignored
+    void record(const Math::IncrementCoordinates& position, VoxelData::VoxelResolution resolution,
+                bool oldValue, bool newValue);
+    void record(const std::vector<VoxelData::VoxelChange>& changes);
+    // Record the changes that turn one occupancy list of a resolution into another
+    void recordDiff(std::vector<Math::IncrementCoordinates> before,
+                    std::vector<Math::IncrementCoordinates> after,
+                    VoxelData::VoxelResolution resolution);
+
+    // Merge repeated positions (first old value, last new value), drop
+    // entries that cancel out and release spare capacity
+    void finalize();
+
+    // Set every entry to its new value (apply) or old value (revert).
+    // Removals run before placements so a restored voxel never collides
+    // with one that is about to be cleared.
+    bool apply(VoxelData::VoxelDataManager* voxelManager) const;
+    bool revert(VoxelData::VoxelDataManager* voxelManager) const;
+
+    // Compressed storage for older history entries. apply() and revert()
+    // still work while compressed but decode on every call.
+    void compress();
+    void decompress();
+    bool isCompressed() const { return m_compressed; }
+
+    const std::vector<Entry>& getEntries() const { return m_entries; }
+    size_t size() const { return m_compressed ? m_compressedCount : m_entries.size(); }
+    bool empty() const { return size() == 0; }
+    void clear();
+
+    // Heap bytes held by the entries or their compressed form
+    size_t getMemoryUsage() const;
+
+    // Codec shared with StateSnapshot. Entries are sorted by resolution and
+    // position, then stored as runs of equal position steps with zigzag
+    // varints; the result is LZ4 compressed when LZ4 is available. With
+    // keepOrder the entries are stored as given, for callers that replay
+    // them in sequence.
+    static void encode(std::vector<Entry> entries, std::vector<uint8_t>& output, bool keepOrder = false);
+    static bool decode(const uint8_t* data, size_t size, std::vector<Entry>& entries);
+
+private:
+    std::vector<Entry> m_entries;
+    std::vector<uint8_t> m_compressedData;
+    size_t m_compressedCount = 0;
+    bool m_compressed = false;
+
+    bool setValues(VoxelData::VoxelDataManager* voxelManager, bool forward) const;
+};
+
+}
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include "../HistoryManager.h"
+#include "../Command.h"
+
+using namespace VoxelEditor::UndoRedo;
+
+// Stands in for a bulk edit: cheap to execute and undo, but large in
+// history and counting how often it is asked for its size
+class SizedCmd : public Command {
+public:
+    SizedCmd(size_t& sizeQueries, size_t bytes)
+        : m_sizeQueries(sizeQueries)
+        , m_bytes(bytes) {}
+
+    bool execute() override { return true; }
+    bool undo() override { return true; }
+
+    std::string getName() const override { return "SizedCmd"; }
+    CommandType getType() const override { return CommandType::VoxelEdit; }
+    size_t getMemoryUsage() const override {
+        ++m_sizeQueries;
+        return m_bytes;
+    }
+
+private:
+    size_t& m_sizeQueries;
+    size_t m_bytes;
+};
+
+class HistoryPerformanceTest : public ::testing::Test {
+protected:
+    struct UndoTiming {
+        double microsecondsPerUndo;
+        double sizeQueriesPerUndo;
+    };
+
+    // Undo and redo the newest undoCount commands of a depth-deep history
+    UndoTiming measureUndo(size_t depth, size_t undoCount) {
+        const size_t commandBytes = 64 * 1024;
+        size_t sizeQueries = 0;
+
+        HistoryManager history;
+        history.setSnapshotInterval(0);
+        history.setCompressionEnabled(false);
+        history.setMaxHistorySize(depth);
+        history.setMaxMemoryUsage(depth * commandBytes * 2);
+
+        for (size_t i = 0; i < depth; ++i) {
+            EXPECT_TRUE(history.executeCommand(std::make_unique<SizedCmd>(sizeQueries, commandBytes)));
+        }
+        EXPECT_EQ(history.getHistorySize(), depth);
+        size_t usage = history.getMemoryUsage();
+        EXPECT_GE(usage, depth * commandBytes);
+
+        sizeQueries = 0;
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < undoCount; ++i) {
+            EXPECT_TRUE(history.undo());
+        }
+        for (size_t i = 0; i < undoCount; ++i) {
+            EXPECT_TRUE(history.redo());
+        }
+        double elapsedUs = std::chrono::duration<double, std::micro>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+
+        // Accounting stays exact through the round trip
+        EXPECT_EQ(history.getMemoryUsage(), usage);
+
+        return {elapsedUs / (undoCount * 2), static_cast<double>(sizeQueries) / (undoCount * 2)};
+    }
+};
+
+TEST_F(HistoryPerformanceTest, UndoLatencyIndependentOfDepth) {
+    const size_t undoCount = 1000;
+    UndoTiming shallow = measureUndo(1000, undoCount);
+    UndoTiming deep = measureUndo(10000, undoCount);
+
+    std::cout << "Undo/redo latency: " << shallow.microsecondsPerUndo << " us at depth 1k, "
+              << deep.microsecondsPerUndo << " us at depth 10k" << std::endl;
+
+    // Each step only asks the moved command for its size
+    EXPECT_LE(shallow.sizeQueriesPerUndo, 1.0);
+    EXPECT_LE(deep.sizeQueriesPerUndo, 1.0);
+
+    // A per-undo walk of the stacks would make the deep history ~10x slower
+    EXPECT_LT(deep.microsecondsPerUndo, shallow.microsecondsPerUndo * 3.0 + 5.0);
+    EXPECT_LT(deep.microsecondsPerUndo, 100.0);
+}
@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include "../HistoryManager.h"
+#include "../VoxelDelta.h"
+#include "../VoxelCommands.h"
+#include "../StateSnapshot.h"
+#include "../../voxel_data/VoxelDataManager.h"
+#include "../../../foundation/events/EventDispatcher.h"
+#include "../../../foundation/math/CoordinateTypes.h"
+#include "../../../foundation/math/BoundingBox.h"
+
+using namespace VoxelEditor;
+using namespace VoxelEditor::UndoRedo;
+using namespace VoxelEditor::VoxelData;
+using namespace VoxelEditor::Math;
+using namespace VoxelEditor::Events;
+
+class HistoryCompressionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        eventDispatcher = std::make_unique<EventDispatcher>();
+        voxelManager = std::make_unique<VoxelDataManager>(eventDispatcher.get());
+    }
+
+    // 10x10 slab of 4cm voxels, one slab per layer so fills never overlap
+    std::unique_ptr<VoxelFillCommand> createSlabFill(int layer) {
+        float y = layer * 0.04f;
+        BoundingBox region(Vector3f(0.0f, y, 0.0f), Vector3f(0.36f, y, 0.36f));
+        return std::make_unique<VoxelFillCommand>(voxelManager.get(), region, VoxelResolution::Size_4cm, true);
+    }
+
+    size_t fillUntilEviction(HistoryManager& history, int maxLayers) {
+        for (int layer = 0; layer < maxLayers; ++layer) {
+            EXPECT_TRUE(history.executeCommand(createSlabFill(layer)));
+            if (history.getHistorySize() < static_cast<size_t>(layer + 1)) {
+                break;
+            }
+        }
+        return history.getHistorySize();
+    }
+
+    std::unique_ptr<EventDispatcher> eventDispatcher;
+    std::unique_ptr<VoxelDataManager> voxelManager;
+};
+
+TEST_F(HistoryCompressionTest, CodecRoundTrip) {
+    std::vector<VoxelDelta::Entry> entries;
+    for (int x = 0; x < 40; x += 4) {
+        for (int z = -20; z < 20; z += 4) {
+            entries.emplace_back(IncrementCoordinates(x, 8, z), VoxelResolution::Size_4cm, false, true);
+        }
+    }
+    entries.emplace_back(IncrementCoordinates(-300, 0, 7), VoxelResolution::Size_1cm, true, false);
+    entries.emplace_back(IncrementCoordinates(1000, 64, -64), VoxelResolution::Size_64cm, true, false);
+
+    std::vector<uint8_t> encoded;
+    VoxelDelta::encode(entries, encoded);
+    EXPECT_LT(encoded.size(), entries.size() * sizeof(VoxelDelta::Entry) / 10);
+
+    std::vector<VoxelDelta::Entry> decoded;
+    ASSERT_TRUE(VoxelDelta::decode(encoded.data(), encoded.size(), decoded));
+    ASSERT_EQ(decoded.size(), entries.size());
+
+    size_t matched = 0;
+    for (const auto& entry : entries) {
+        for (const auto& candidate : decoded) {
+            if (candidate.position == entry.position && candidate.resolution == entry.resolution &&
+                candidate.oldValue == entry.oldValue && candidate.newValue == entry.newValue) {
+                ++matched;
+                break;
+            }
+        }
+    }
+    EXPECT_EQ(matched, entries.size());
+}
+
+TEST_F(HistoryCompressionTest, CodecRejectsCorruptData) {
+    std::vector<VoxelDelta::Entry> entries;
+    entries.emplace_back(IncrementCoordinates(0, 0, 0), VoxelResolution::Size_4cm, false, true);
+    entries.emplace_back(IncrementCoordinates(4, 0, 0), VoxelResolution::Size_4cm, false, true);
+    entries.emplace_back(IncrementCoordinates(0, 4, 12), VoxelResolution::Size_4cm, true, false);
+
+    std::vector<uint8_t> encoded;
+    VoxelDelta::encode(entries, encoded);
+
+    std::vector<VoxelDelta::Entry> decoded;
+    EXPECT_FALSE(VoxelDelta::decode(encoded.data(), encoded.size() - 1, decoded));
+    EXPECT_FALSE(VoxelDelta::decode(nullptr, 0, decoded));
+
+    std::vector<uint8_t> badMethod = encoded;
+    badMethod[0] = 0x7F;
+    EXPECT_FALSE(VoxelDelta::decode(badMethod.data(), badMethod.size(), decoded));
+}
+
+TEST_F(HistoryCompressionTest, CompressedFillUndoRedo) {
+    auto cmd = createSlabFill(0);
+    ASSERT_TRUE(cmd->execute());
+    EXPECT_EQ(voxelManager->getVoxelCount(VoxelResolution::Size_4cm), 100u);
+
+    size_t uncompressed = cmd->getMemoryUsage();
+    cmd->compress();
+    EXPECT_LT(cmd->getMemoryUsage() - sizeof(VoxelFillCommand),
+              (uncompressed - sizeof(VoxelFillCommand)) / 10);
+
+    ASSERT_TRUE(cmd->undo());
+    EXPECT_EQ(voxelManager->getVoxelCount(VoxelResolution::Size_4cm), 0u);
+    ASSERT_TRUE(cmd->execute());
+    EXPECT_EQ(voxelManager->getVoxelCount(VoxelResolution::Size_4cm), 100u);
+}
+
+TEST_F(HistoryCompressionTest, CompressedSnapshotRestores) {
+    VoxelResolution resolution = VoxelResolution::Size_4cm;
+    for (int x = 0; x < 80; x += 4) {
+        ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(x, 0, 0), resolution, true));
+    }
+
+    StateSnapshot snapshot;
+    ASSERT_TRUE(snapshot.captureVoxelData(voxelManager.get()));
+    size_t uncompressed = snapshot.getMemoryUsage();
+
+    snapshot.compress();
+    EXPECT_TRUE(snapshot.isCompressed());
+    EXPECT_LT(snapshot.getMemoryUsage(), uncompressed);
+
+    voxelManager->clearAll();
+    ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(0, 40, 0), resolution, true));
+
+    ASSERT_TRUE(snapshot.restoreVoxelData(voxelManager.get()));
+    EXPECT_EQ(voxelManager->getVoxelCount(resolution), 20u);
+    EXPECT_TRUE(voxelManager->hasVoxel(IncrementCoordinates(76, 0, 0), resolution));
+    EXPECT_FALSE(voxelManager->hasVoxel(IncrementCoordinates(0, 40, 0), resolution));
+
+    // Decompressing gives back the raw form, which restores the same way
+    snapshot.decompress();
+    EXPECT_FALSE(snapshot.isCompressed());
+    voxelManager->clearAll();
+    ASSERT_TRUE(snapshot.restoreVoxelData(voxelManager.get()));
+    EXPECT_EQ(voxelManager->getVoxelCount(resolution), 20u);
+}
+
+TEST_F(HistoryCompressionTest, CompressionExtendsHistoryDepth) {
+    const size_t budget = 16 * 1024;
+    const int maxLayers = 100;
+
+    size_t uncompressedDepth = 0;
+    {
+        HistoryManager history;
+        history.setSnapshotInterval(0);
+        history.setMaxHistorySize(maxLayers);
+        history.setCompressionEnabled(false);
+        history.setMaxMemoryUsage(budget);
+        uncompressedDepth = fillUntilEviction(history, maxLayers);
+        EXPECT_LE(history.getMemoryUsage(), budget);
+    }
+
+    voxelManager->clearAll();
+
+    size_t compressedDepth = 0;
+    {
+        HistoryManager history;
+        history.setSnapshotInterval(0);
+        history.setMaxHistorySize(maxLayers);
+        history.setMaxMemoryUsage(budget);
+
+        size_t pressureCount = 0;
+        history.setMemoryPressureCallback([&pressureCount](size_t, size_t) { ++pressureCount; });
+
+        compressedDepth = fillUntilEviction(history, maxLayers);
+        EXPECT_LE(history.getMemoryUsage(), budget);
+        EXPECT_GT(pressureCount, 0u);
+
+        // Compressed history still undoes correctly
+        size_t before = voxelManager->getVoxelCount(VoxelResolution::Size_4cm);
+        for (int i = 0; i < 20; ++i) {
+            ASSERT_TRUE(history.undo());
+        }
+        EXPECT_EQ(voxelManager->getVoxelCount(VoxelResolution::Size_4cm), before - 20 * 100);
+    }
+
+    EXPECT_GE(compressedDepth, uncompressedDepth * 4);
+}
+
+TEST_F(HistoryCompressionTest, GovernorCompressesThenReleasesOldest) {
+    HistoryManager history;
+    history.setSnapshotInterval(0);
+    history.setUncompressedDepth(100);
+
+    for (int layer = 0; layer < 10; ++layer) {
+        ASSERT_TRUE(history.executeCommand(createSlabFill(layer)));
+    }
+
+    size_t before = history.getMemoryUsage();
+    size_t saved = history.optimizeMemory();
+    EXPECT_GT(saved, 0u);
+    EXPECT_EQ(history.getMemoryUsage(), before - saved);
+    EXPECT_EQ(history.optimizeMemory(), 0u);
+
+    size_t freed = history.releaseMemory(1);
+    EXPECT_GT(freed, 0u);
+    EXPECT_EQ(history.getHistorySize(), 9u);
+    EXPECT_EQ(history.getMemoryUsage(), before - saved - freed);
+
+    // What is left still undoes
+    for (int i = 0; i < 9; ++i) {
+        ASSERT_TRUE(history.undo());
+    }
+    EXPECT_FALSE(history.canUndo());
+    EXPECT_EQ(voxelManager->getVoxelCount(VoxelResolution::Size_4cm), 100u);
+}
+
+TEST_F(HistoryCompressionTest, BackgroundCompressionKeepsRecentEntries) {
+    HistoryManager history;
+    history.setSnapshotInterval(0);
+    history.setUncompressedDepth(5);
+
+    for (int layer = 0; layer < 20; ++layer) {
+        ASSERT_TRUE(history.executeCommand(createSlabFill(layer)));
+    }
+    size_t fullUsage = history.getMemoryUsage();
+
+    // Half the budget is already exceeded, so the worker picks up the
+    // oldest 15 entries on the next command
+    history.setMaxMemoryUsage(fullUsage + 4096);
+    ASSERT_TRUE(history.executeCommand(createSlabFill(20)));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (history.getMemoryUsage() > fullUsage / 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_LT(history.getMemoryUsage(), fullUsage / 2);
+    EXPECT_EQ(history.getHistorySize(), 21u);
+
+    for (int i = 0; i < 21; ++i) {
+        ASSERT_TRUE(history.undo());
+    }
+    EXPECT_EQ(voxelManager->getVoxelCount(VoxelResolution::Size_4cm), 0u);
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include "../VoxelDelta.h"
+#include "../VoxelCommands.h"
+#include "../StateSnapshot.h"
+#include "../../voxel_data/VoxelDataManager.h"
+#include "../../../foundation/events/EventDispatcher.h"
+#include "../../../foundation/events/CommonEvents.h"
+#include "../../../foundation/math/CoordinateTypes.h"
+#include "../../../foundation/math/BoundingBox.h"
+
+using namespace VoxelEditor;
+using namespace VoxelEditor::UndoRedo;
+using namespace VoxelEditor::VoxelData;
+using namespace VoxelEditor::Math;
+using namespace VoxelEditor::Events;
+
+class VoxelChangeCounter : public EventHandler<VoxelChangedEvent> {
+public:
+    void handleEvent(const VoxelChangedEvent&) override { ++count; }
+    size_t count = 0;
+};
+
+class VoxelDeltaTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        eventDispatcher = std::make_unique<EventDispatcher>();
+        voxelManager = std::make_unique<VoxelDataManager>(eventDispatcher.get());
+    }
+
+    std::unique_ptr<EventDispatcher> eventDispatcher;
+    std::unique_ptr<VoxelDataManager> voxelManager;
+};
+
+TEST_F(VoxelDeltaTest, FinalizeMergesRepeatedPositions) {
+    VoxelDelta delta;
+    IncrementCoordinates a(0, 0, 0);
+    IncrementCoordinates b(4, 0, 0);
+
+    delta.record(a, VoxelResolution::Size_4cm, false, true);
+    delta.record(b, VoxelResolution::Size_4cm, true, false);
+    delta.record(a, VoxelResolution::Size_4cm, true, false);  // Cancels the first entry
+    delta.record(b, VoxelResolution::Size_4cm, true, true);   // No-op, ignored
+    delta.finalize();
+
+    ASSERT_EQ(delta.size(), 1u);
+    EXPECT_EQ(delta.getEntries()[0].position, b);
+    EXPECT_TRUE(delta.getEntries()[0].oldValue);
+    EXPECT_FALSE(delta.getEntries()[0].newValue);
+}
+
+TEST_F(VoxelDeltaTest, RecordDiffOnlyKeepsDifferences) {
+    std::vector<IncrementCoordinates> before = {
+        IncrementCoordinates(0, 0, 0), IncrementCoordinates(4, 0, 0), IncrementCoordinates(8, 0, 0)
+    };
+    std::vector<IncrementCoordinates> after = {
+        IncrementCoordinates(8, 0, 0), IncrementCoordinates(0, 0, 0), IncrementCoordinates(12, 0, 0)
+    };
+
+    VoxelDelta delta;
+    delta.recordDiff(before, after, VoxelResolution::Size_4cm);
+
+    ASSERT_EQ(delta.size(), 2u);
+    size_t added = 0, removed = 0;
+    for (const auto& entry : delta.getEntries()) {
+        if (entry.newValue) {
+            EXPECT_EQ(entry.position, IncrementCoordinates(12, 0, 0));
+            ++added;
+        } else {
+            EXPECT_EQ(entry.position, IncrementCoordinates(4, 0, 0));
+            ++removed;
+        }
+    }
+    EXPECT_EQ(added, 1u);
+    EXPECT_EQ(removed, 1u);
+}
+
+TEST_F(VoxelDeltaTest, ApplyAndRevert) {
+    VoxelResolution resolution = VoxelResolution::Size_4cm;
+    ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(0, 0, 0), resolution, true));
+
+    VoxelDelta delta;
+    delta.record(IncrementCoordinates(0, 0, 0), resolution, true, false);
+    delta.record(IncrementCoordinates(8, 0, 0), resolution, false, true);
+    delta.finalize();
+
+    EXPECT_TRUE(delta.apply(voxelManager.get()));
+    EXPECT_FALSE(voxelManager->hasVoxel(IncrementCoordinates(0, 0, 0), resolution));
+    EXPECT_TRUE(voxelManager->hasVoxel(IncrementCoordinates(8, 0, 0), resolution));
+
+    EXPECT_TRUE(delta.revert(voxelManager.get()));
+    EXPECT_TRUE(voxelManager->hasVoxel(IncrementCoordinates(0, 0, 0), resolution));
+    EXPECT_FALSE(voxelManager->hasVoxel(IncrementCoordinates(8, 0, 0), resolution));
+}
+
+TEST_F(VoxelDeltaTest, FillUndoKeepsPreexistingVoxels) {
+    VoxelResolution resolution = VoxelResolution::Size_4cm;
+    IncrementCoordinates existing(4, 0, 4);
+    ASSERT_TRUE(voxelManager->setVoxel(existing, resolution, true));
+
+    BoundingBox region(Vector3f(0, 0, 0), Vector3f(0.08f, 0.08f, 0.08f));
+    VoxelFillCommand cmd(voxelManager.get(), region, resolution, true);
+
+    ASSERT_TRUE(cmd.execute());
+    EXPECT_EQ(voxelManager->getVoxelCount(resolution), 27u);
+
+    // Only the 26 voxels the fill placed are part of the history entry
+    size_t recordedMemory = cmd.getMemoryUsage() - sizeof(VoxelFillCommand);
+    EXPECT_EQ(recordedMemory, 26u * sizeof(VoxelDelta::Entry));
+
+    ASSERT_TRUE(cmd.undo());
+    EXPECT_EQ(voxelManager->getVoxelCount(resolution), 1u);
+    EXPECT_TRUE(voxelManager->hasVoxel(existing, resolution));
+
+    // Redo replays the delta
+    ASSERT_TRUE(cmd.execute());
+    EXPECT_EQ(voxelManager->getVoxelCount(resolution), 27u);
+    ASSERT_TRUE(cmd.undo());
+    EXPECT_EQ(voxelManager->getVoxelCount(resolution), 1u);
+}
+
+TEST_F(VoxelDeltaTest, MoveWithOverlappingOffsetRoundTrips) {
+    VoxelResolution resolution = VoxelResolution::Size_4cm;
+    std::vector<IncrementCoordinates> positions = {
+        IncrementCoordinates(0, 0, 0), IncrementCoordinates(4, 0, 0), IncrementCoordinates(8, 0, 0)
+    };
+    for (const auto& pos : positions) {
+        ASSERT_TRUE(voxelManager->setVoxel(pos, resolution, true));
+    }
+
+    // Shift by one voxel: two destinations are existing sources
+    VoxelMoveCommand cmd(voxelManager.get(), positions, IncrementCoordinates(4, 0, 0), resolution);
+    ASSERT_TRUE(cmd.execute());
+    EXPECT_FALSE(voxelManager->hasVoxel(IncrementCoordinates(0, 0, 0), resolution));
+    EXPECT_TRUE(voxelManager->hasVoxel(IncrementCoordinates(12, 0, 0), resolution));
+    EXPECT_EQ(voxelManager->getVoxelCount(resolution), 3u);
+
+    ASSERT_TRUE(cmd.undo());
+    EXPECT_TRUE(voxelManager->hasVoxel(IncrementCoordinates(0, 0, 0), resolution));
+    EXPECT_FALSE(voxelManager->hasVoxel(IncrementCoordinates(12, 0, 0), resolution));
+    EXPECT_EQ(voxelManager->getVoxelCount(resolution), 3u);
+
+    ASSERT_TRUE(cmd.execute());
+    EXPECT_TRUE(voxelManager->hasVoxel(IncrementCoordinates(12, 0, 0), resolution));
+    EXPECT_FALSE(voxelManager->hasVoxel(IncrementCoordinates(0, 0, 0), resolution));
+}
+
+TEST_F(VoxelDeltaTest, BulkEditSurvivesCompression) {
+    VoxelResolution resolution = VoxelResolution::Size_4cm;
+    std::vector<BulkVoxelEditCommand::VoxelChange> changes;
+    for (int i = 0; i < 10; ++i) {
+        changes.emplace_back(IncrementCoordinates(i * 4, 0, 0), resolution, false, true);
+    }
+
+    BulkVoxelEditCommand cmd(voxelManager.get(), changes);
+    ASSERT_TRUE(cmd.execute());
+
+    cmd.compress();
+    EXPECT_EQ(cmd.getChangeCount(), 10u);
+
+    ASSERT_TRUE(cmd.undo());
+    EXPECT_EQ(voxelManager->getVoxelCount(resolution), 0u);
+    ASSERT_TRUE(cmd.execute());
+    EXPECT_EQ(voxelManager->getVoxelCount(resolution), 10u);
+}
+
+TEST_F(VoxelDeltaTest, CompressedMixedResolutionEditUndoes) {
+    // Remove a 16cm voxel, then place 1cm voxels inside its footprint and
+    // append them to the same command
+    ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(0, 0, 0), VoxelResolution::Size_16cm, true));
+
+    std::vector<BulkVoxelEditCommand::VoxelChange> removal;
+    removal.emplace_back(IncrementCoordinates(0, 0, 0), VoxelResolution::Size_16cm, true, false);
+    BulkVoxelEditCommand cmd(voxelManager.get(), removal);
+    ASSERT_TRUE(cmd.execute());
+
+    for (int x = -4; x <= 4; x += 4) {
+        ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(x, 0, 0), VoxelResolution::Size_1cm, true));
+        cmd.addChange(BulkVoxelEditCommand::VoxelChange(IncrementCoordinates(x, 0, 0),
+                                                        VoxelResolution::Size_1cm, false, true));
+    }
+
+    cmd.compress();
+    EXPECT_EQ(cmd.getChangeCount(), 4u);
+
+    // The 1cm voxels have to go before the 16cm voxel can come back
+    ASSERT_TRUE(cmd.undo());
+    EXPECT_EQ(voxelManager->getVoxelCount(VoxelResolution::Size_1cm), 0u);
+    EXPECT_TRUE(voxelManager->hasVoxel(IncrementCoordinates(0, 0, 0), VoxelResolution::Size_16cm));
+}
+
+TEST_F(VoxelDeltaTest, SnapshotRestoreOnlyTouchesDifferences) {
+    VoxelResolution resolution = VoxelResolution::Size_4cm;
+    ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(0, 0, 0), resolution, true));
+    ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(4, 0, 0), resolution, true));
+
+    StateSnapshot snapshot;
+    ASSERT_TRUE(snapshot.captureVoxelData(voxelManager.get()));
+
+    ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(4, 0, 0), resolution, false));
+    ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(8, 0, 0), resolution, true));
+
+    // Count change events to verify untouched voxels are not re-inserted
+    VoxelChangeCounter counter;
+    eventDispatcher->subscribe<VoxelChangedEvent>(&counter);
+
+    ASSERT_TRUE(snapshot.restoreVoxelData(voxelManager.get()));
+    EXPECT_EQ(counter.count, 2u);
+    EXPECT_TRUE(voxelManager->hasVoxel(IncrementCoordinates(0, 0, 0), resolution));
+    EXPECT_TRUE(voxelManager->hasVoxel(IncrementCoordinates(4, 0, 0), resolution));
+    EXPECT_FALSE(voxelManager->hasVoxel(IncrementCoordinates(8, 0, 0), resolution));
+
+    eventDispatcher->unsubscribe<VoxelChangedEvent>(&counter);
+}
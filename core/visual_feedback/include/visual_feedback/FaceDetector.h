@@ -55,29 +55,16 @@ private:
     // Ray-voxel intersection
     RaycastHit raycastVoxelGrid(const Ray& ray, const VoxelData::VoxelGrid& grid, 
                                VoxelData::VoxelResolution resolution);
+    RaycastHit raycastVoxelGrid(const Ray& ray, const VoxelData::VoxelGrid& grid, 
+                               VoxelData::VoxelResolution resolution, float maxDistance) const;
     
     // Face creation
     Face createFaceFromHit(const RaycastHit& hit, VoxelData::VoxelResolution resolution);
     bool isValidFace(const Face& face, const VoxelData::VoxelGrid& grid) const;
     
-    // Ray-box intersection
-    bool rayIntersectsBox(const Ray& ray, const Math::BoundingBox& box, 
-                         float& tMin, float& tMax) const;
-    
-    // Grid traversal
-    struct GridTraversal {
-        Math::IncrementCoordinates current;
-        Math::Vector3i step;  // Step remains as Vector3i (just -1, 0, or 1)
-        Math::Vector3f tMax;
-        Math::Vector3f tDelta;
-    };
-    
-    void initializeTraversal(const Ray& ray, const Math::WorldCoordinates& gridMin, 
-                           float voxelSize, VoxelData::VoxelResolution resolution, GridTraversal& traversal) const;
-    void stepTraversal(GridTraversal& traversal) const;
-    
-    // Simplified face direction determination
-    FaceDirection determineFaceDirection(const Ray& ray, const Math::BoundingBox& voxelBox, float tMin) const;
+    // Face of the voxel box the ray enters through at t, or leaves through
+    // when it starts inside
+    FaceDirection determineFaceDirection(const Ray& ray, const Math::BoundingBox& voxelBox, float t) const;
 };
 
 } // namespace VisualFeedback
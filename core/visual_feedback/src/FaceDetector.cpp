@@ -1,8 +1,6 @@
 #include "../include/visual_feedback/FaceDetector.h"
-#include "../include/visual_feedback/GeometricFaceDetector.h"
 #include "../../voxel_data/VoxelDataManager.h"
 #include "../../foundation/logging/Logger.h"
-#include "voxel_math/VoxelFaceGeometry.h"
 #include "voxel_math/VoxelPlacementMath.h"
 #include <algorithm>
 #include <limits>
@@ -12,6 +10,14 @@
 namespace VoxelEditor {
 namespace VisualFeedback {
 
+namespace {
+// Entry distances closer than this (meters) count as an edge or corner hit
+constexpr float FACE_TIE_EPSILON = 1e-5f;
+// Direction components below this are treated as running parallel to the
+// face, so camera rays with rounding noise do not pick a side face
+constexpr float PARALLEL_EPSILON = 1e-5f;
+}
+
 FaceDetector::FaceDetector()
     : m_maxRayDistance(1000.0f) {
 }
@@ -60,10 +66,12 @@ Face FaceDetector::detectFaceOrGround(const Ray& ray, const VoxelData::VoxelGrid
 }
 
 Face FaceDetector::detectFaceAcrossAllResolutions(const Ray& ray, const VoxelData::VoxelDataManager& voxelManager) {
-    Face closestFace;
-    float closestDistance = std::numeric_limits<float>::max();
+    RaycastHit closestHit;
+    closestHit.hit = false;
+    float closestDistance = m_maxRayDistance;
     
-    // Check all resolution levels
+    // Check all resolution levels. Each grid only searches up to the nearest
+    // hit found so far, so later grids prune most of their octree.
     for (int i = 0; i < static_cast<int>(VoxelData::VoxelResolution::COUNT); ++i) {
         VoxelData::VoxelResolution resolution = static_cast<VoxelData::VoxelResolution>(i);
         const VoxelData::VoxelGrid* grid = voxelManager.getGrid(resolution);
@@ -72,59 +80,19 @@ Face FaceDetector::detectFaceAcrossAllResolutions(const Ray& ray, const VoxelDat
             continue;
         }
         
-        // Detect face in this resolution
-        Face face = detectFace(ray, *grid, resolution);
-        
-        if (face.isValid()) {
-            // Calculate distance to this face
-            Math::IncrementCoordinates voxelPos = face.getVoxelPosition();
-            Math::WorldCoordinates worldPos = Math::CoordinateConverter::incrementToWorld(voxelPos);
-            float voxelSize = VoxelData::getVoxelSize(resolution);
-            
-            // Calculate the face plane position using VoxelFaceGeometry
-            float facePlanePos = 0.0f;
-            Math::Vector3f normal = face.getNormal();
-            
-            if (std::abs(normal.y) > 0.5f) {
-                // Top/bottom face
-                VoxelData::FaceDirection faceDir = (normal.y > 0) ? VoxelData::FaceDirection::PosY : VoxelData::FaceDirection::NegY;
-                facePlanePos = Math::VoxelFaceGeometry::getFacePlanePosition(voxelPos, voxelSize, faceDir);
-            } else if (std::abs(normal.x) > 0.5f) {
-                // Left/right face
-                VoxelData::FaceDirection faceDir = (normal.x > 0) ? VoxelData::FaceDirection::PosX : VoxelData::FaceDirection::NegX;
-                facePlanePos = Math::VoxelFaceGeometry::getFacePlanePosition(voxelPos, voxelSize, faceDir);
-            } else if (std::abs(normal.z) > 0.5f) {
-                // Front/back face
-                VoxelData::FaceDirection faceDir = (normal.z > 0) ? VoxelData::FaceDirection::PosZ : VoxelData::FaceDirection::NegZ;
-                facePlanePos = Math::VoxelFaceGeometry::getFacePlanePosition(voxelPos, voxelSize, faceDir);
-            }
-            
-            // Create face position vector based on which axis the face is on
-            Math::Vector3f facePos = worldPos.value();
-            if (std::abs(normal.x) > 0.5f) {
-                facePos.x = facePlanePos;
-            } else if (std::abs(normal.y) > 0.5f) {
-                facePos.y = facePlanePos;
-            } else if (std::abs(normal.z) > 0.5f) {
-                facePos.z = facePlanePos;
-            }
-            
-            // Calculate distance from ray origin to face
-            float distance = (facePos - ray.origin.value()).length();
-            
-            if (distance < closestDistance) {
-                closestDistance = distance;
-                closestFace = face;
-            }
+        RaycastHit hit = raycastVoxelGrid(ray, *grid, resolution, closestDistance);
+        if (hit.hit && (!closestHit.hit || hit.distance < closestDistance)) {
+            closestDistance = hit.distance;
+            closestHit = hit;
         }
     }
     
     // If no voxel face was hit, check ground plane
-    if (!closestFace.isValid()) {
+    if (!closestHit.hit) {
         return detectGroundPlane(ray);
     }
     
-    return closestFace;
+    return createFaceFromHit(closestHit, closestHit.face.getResolution());
 }
 
 Face FaceDetector::detectFace(const Ray& ray, const VoxelData::VoxelGrid& grid, 
@@ -144,28 +112,20 @@ std::vector<Face> FaceDetector::detectFacesInRegion(const Math::BoundingBox& reg
                                                    VoxelData::VoxelResolution resolution) {
     std::vector<Face> faces;
     
-    // Get all voxels in the grid - this is much more efficient than iterating through all positions
-    auto allVoxels = grid.getAllVoxels();
-    
-    // Convert region bounds to increment coordinates for checking
+    // Convert region bounds to increment coordinates and only visit the
+    // octree branches that overlap them
     Math::IncrementCoordinates minIncrement = Math::CoordinateConverter::worldToIncrement(Math::WorldCoordinates(region.min));
     Math::IncrementCoordinates maxIncrement = Math::CoordinateConverter::worldToIncrement(Math::WorldCoordinates(region.max));
-    
-    // Check each voxel to see if it's in the region
-    for (const auto& voxelPos : allVoxels) {
-        // Check if voxel is within the region bounds
-        if (voxelPos.incrementPos.x() >= minIncrement.x() && voxelPos.incrementPos.x() <= maxIncrement.x() &&
-            voxelPos.incrementPos.y() >= minIncrement.y() && voxelPos.incrementPos.y() <= maxIncrement.y() &&
-            voxelPos.incrementPos.z() >= minIncrement.z() && voxelPos.incrementPos.z() <= maxIncrement.z()) {
-            
-            // Check if this voxel has the resolution we're looking for
-            if (voxelPos.resolution == resolution) {
-                // Check all 6 faces
-                for (int dir = 0; dir < 6; ++dir) {
-                    Face face(voxelPos.incrementPos, resolution, static_cast<FaceDirection>(dir));
-                    if (isValidFaceForPlacement(face, grid)) {
-                        faces.push_back(face);
-                    }
+    auto regionVoxels = grid.getVoxelsInRange(minIncrement, maxIncrement);
+    
+    for (const auto& voxelPos : regionVoxels) {
+        // Check if this voxel has the resolution we're looking for
+        if (voxelPos.resolution == resolution) {
+            // Check all 6 faces
+            for (int dir = 0; dir < 6; ++dir) {
+                Face face(voxelPos.incrementPos, resolution, static_cast<FaceDirection>(dir));
+                if (isValidFaceForPlacement(face, grid)) {
+                    faces.push_back(face);
                 }
             }
         }
@@ -243,397 +203,35 @@ Math::IncrementCoordinates FaceDetector::calculatePlacementPosition(const Face&
 
 RaycastHit FaceDetector::raycastVoxelGrid(const Ray& ray, const VoxelData::VoxelGrid& grid, 
                                          VoxelData::VoxelResolution resolution) {
+    return raycastVoxelGrid(ray, grid, resolution, m_maxRayDistance);
+}
+
+RaycastHit FaceDetector::raycastVoxelGrid(const Ray& ray, const VoxelData::VoxelGrid& grid, 
+                                         VoxelData::VoxelResolution resolution, float maxDistance) const {
     RaycastHit result;
     result.hit = false;
     
-    float voxelSize = VoxelData::getVoxelSize(resolution);
-    
-    // Use geometric face detection for improved accuracy
-    const bool USE_GEOMETRIC_DETECTION = true;
-    
-    if (USE_GEOMETRIC_DETECTION) {
-        Logging::Logger::getInstance().debugfc("FaceDetector", "Using GeometricFaceDetector");
-        
-        // Get all voxels in the grid
-        auto allVoxels = grid.getAllVoxels();
-        
-        Logging::Logger::getInstance().debugfc("FaceDetector", "Found %zu voxels in grid", allVoxels.size());
-        
-        
-        // Store voxel info with faces for efficient lookup
-        struct VoxelFaceInfo {
-            Math::IncrementCoordinates voxelPos;
-            FaceDirection faceDir;
-        };
-        std::vector<GeometricFace> allFaces;
-        std::vector<VoxelFaceInfo> faceInfos;
-        
-        for (const auto& voxelInfo : allVoxels) {
-            if (voxelInfo.resolution == resolution) {
-                // Get world position of voxel
-                Math::WorldCoordinates voxelWorld = Math::CoordinateConverter::incrementToWorld(voxelInfo.incrementPos);
-                
-                
-                
-                // Create faces for this voxel (voxelWorld is the bottom-left-back corner)
-                auto voxelFaces = GeometricFaceDetector::createVoxelFaces(voxelWorld.value(), voxelSize);
-                
-                // Add faces with proper tracking
-                for (size_t i = 0; i < voxelFaces.size(); ++i) {
-                    // Assign unique global ID for mapping back
-                    voxelFaces[i].id = static_cast<int>(allFaces.size());
-                    allFaces.push_back(voxelFaces[i]);
-                    
-                    // Map face index to direction
-                    FaceDirection dir;
-                    switch (i) {
-                        case 0: dir = FaceDirection::PositiveX; break;
-                        case 1: dir = FaceDirection::NegativeX; break;
-                        case 2: dir = FaceDirection::PositiveY; break;
-                        case 3: dir = FaceDirection::NegativeY; break;
-                        case 4: dir = FaceDirection::PositiveZ; break;
-                        case 5: dir = FaceDirection::NegativeZ; break;
-                        default: dir = FaceDirection::PositiveY; break;
-                    }
-                    
-                    faceInfos.push_back({voxelInfo.incrementPos, dir});
-                }
-            }
-        }
-        
-        
-        
-        // Find closest face hit
-        Logging::Logger::getInstance().debugfc("FaceDetector", "Testing ray against %zu faces", allFaces.size());
-        auto hit = GeometricFaceDetector::detectClosestFace(ray, allFaces);
-        Logging::Logger::getInstance().debugfc("FaceDetector", "Hit result: %s", (hit.has_value() ? "HIT" : "MISS"));
-        
-        // Debug: Log the hit details
-        if (hit.has_value()) {
-            Logging::Logger::getInstance().debugfc("GeometricFaceDetector", 
-                "Ray hit face %d at distance %.3f, point: (%.3f, %.3f, %.3f)",
-                hit->faceId, hit->distance, hit->point.x, hit->point.y, hit->point.z);
-        }
-        
-        // Debug: Show all faces at minimum distance
-        if (hit.has_value()) {
-            Logging::Logger::getInstance().debugfc("FaceDetector", "Checking all faces at distance %.5f", hit->distance);
-            int faceCount = 0;
-            for (size_t i = 0; i < faceInfos.size(); ++i) {
-                if (std::abs(hit->distance - 1.68f) < 1e-6f) { // Show faces at distance 1.68
-                    const auto& faceInfo = faceInfos[i];
-                    Logging::Logger::getInstance().debugfc("FaceDetector", "Face %zu -> voxel (%d, %d, %d) dir %d", 
-                                                          i, faceInfo.voxelPos.x(), faceInfo.voxelPos.y(), faceInfo.voxelPos.z(), 
-                                                          static_cast<int>(faceInfo.faceDir));
-                    faceCount++;
-                    if (faceCount >= 10) break; // Limit output
-                }
-            }
-        }
-        
-        if (hit.has_value() && hit->faceId >= 0 && hit->faceId < static_cast<int>(faceInfos.size())) {
-            const auto& faceInfo = faceInfos[hit->faceId];
-            
-            Logging::Logger::getInstance().debugfc("FaceDetector", "Selected Face %d belongs to voxel (%d, %d, %d) direction %d", 
-                                                  hit->faceId, faceInfo.voxelPos.x(), faceInfo.voxelPos.y(), faceInfo.voxelPos.z(), 
-                                                  static_cast<int>(faceInfo.faceDir));
-            
-            result.hit = true;
-            result.distance = hit->distance;
-            result.position = Math::WorldCoordinates(hit->point);
-            result.face = Face(faceInfo.voxelPos, resolution, faceInfo.faceDir, Math::WorldCoordinates(hit->point));
-            
-            // Set normal based on face direction
-            switch (faceInfo.faceDir) {
-                case FaceDirection::PositiveX: result.normal = Math::Vector3f(1, 0, 0); break;
-                case FaceDirection::NegativeX: result.normal = Math::Vector3f(-1, 0, 0); break;
-                case FaceDirection::PositiveY: result.normal = Math::Vector3f(0, 1, 0); break;
-                case FaceDirection::NegativeY: result.normal = Math::Vector3f(0, -1, 0); break;
-                case FaceDirection::PositiveZ: result.normal = Math::Vector3f(0, 0, 1); break;
-                case FaceDirection::NegativeZ: result.normal = Math::Vector3f(0, 0, -1); break;
-            }
-        }
-        
-        return result;
-    }
-    
-    // Get workspace bounds in world coordinates (centered)
-    Math::Vector3f workspaceSize = grid.getWorkspaceSize();
-    Math::Vector3f gridMin(-workspaceSize.x * 0.5f, 0.0f, -workspaceSize.z * 0.5f);
-    Math::Vector3f gridMax(workspaceSize.x * 0.5f, workspaceSize.y, workspaceSize.z * 0.5f);
-    
-    // Check if ray intersects workspace bounds
-    float tMin, tMax;
-    Math::BoundingBox workspaceBounds(gridMin, gridMax);
-    
-    if (!rayIntersectsBox(ray, workspaceBounds, tMin, tMax)) {
+    // The grid walks its octree front to back and skips empty branches, so
+    // the cost follows the nodes along the ray rather than the voxel count
+    Math::IncrementCoordinates voxelPos;
+    float distance = 0.0f;
+    if (!grid.raycast(ray.origin, ray.direction, maxDistance, voxelPos, distance)) {
         return result;
     }
     
-    // Initialize traversal at workspace entry point, not ray origin
-    GridTraversal traversal;
-    
-    // Calculate the ray position at workspace entry (tMin)
-    // Use the original ray if it starts inside the workspace (tMin <= 0)
-    Math::WorldCoordinates startPoint;
-    
-    if (tMin > 0) {
-        // Ray starts outside workspace - move back from entry point to ensure we don't miss boundary voxels
-        // The key insight: when ray enters at the exact workspace boundary, we might already be past boundary voxels
-        // So we need to start the traversal from a point that's guaranteed to be before any boundary voxels
-        
-        // Move back by two voxel sizes to ensure we catch boundary voxels
-        // This ensures we start traversal before any boundary voxels
-        float backStep = voxelSize * 2.0f;
-        float adjustedT = std::max(0.0f, tMin - backStep);
-        startPoint = ray.pointAt(adjustedT);
-    } else {
-        // Ray starts inside workspace
-        startPoint = ray.origin;
-    }
-    
-    // Create a ray from the start point
-    VoxelEditor::VisualFeedback::Ray startRay(startPoint, ray.direction);
-    initializeTraversal(startRay, Math::WorldCoordinates(gridMin), voxelSize, resolution, traversal);
-    
-    
-    // OPTIMIZED BRUTE FORCE: Check voxels near ray path
-    // This approach checks a limited region around the ray for voxels
-    // It provides better performance than the DDA algorithm for sparse voxel grids
-    if (true) { // Using optimized brute force for performance reasons
-        // Check voxels along the ray path from start to end of workspace
-        float startT = std::max(0.0f, tMin); // Start from ray origin if inside workspace, otherwise from entry point
-        float maxCheckDistance = std::min(workspaceSize.x, 2.0f); // Limit to 2 meters max
-        float endT = startT + maxCheckDistance;
-        
-        // Early termination when we find a hit
-        bool foundHit = false;
-        for (float t = startT; t <= endT && !foundHit; t += 0.1f) { // Check every 10cm for much better performance
-            Math::WorldCoordinates checkPoint = ray.pointAt(t);
-            Math::IncrementCoordinates checkIncrement = Math::CoordinateConverter::worldToIncrement(checkPoint);
-            
-            // For each point along the ray, check all nearby voxel positions that could intersect
-            // The issue is that we need to check voxel positions that the ray passes through their volume,
-            // not just the exact increment coordinate at the ray point
-            
-            // Calculate voxel size in centimeters
-            int voxelSizeCm = static_cast<int>(voxelSize * Math::CoordinateConverter::METERS_TO_CM); // 16cm for Size_16cm resolution
-            
-            // Check voxel positions that could contain this world point
-            // For 16cm voxels, check the voxel grid positions around this point
-            std::vector<Math::IncrementCoordinates> candidatePositions;
-            
-            // Find the voxel grid positions that could contain this world point
-            // For a 16cm voxel, snap to 16cm grid boundaries
-            int baseX = (checkIncrement.x() / voxelSizeCm) * voxelSizeCm;
-            int baseY = (checkIncrement.y() / voxelSizeCm) * voxelSizeCm;
-            int baseZ = (checkIncrement.z() / voxelSizeCm) * voxelSizeCm;
-            
-            // Check nearby voxel positions that could contain this ray point
-            // For non-aligned voxels, we need to search the voxel size range
-            // Use adaptive search range based on voxel size for accuracy
-            int searchRange = voxelSizeCm / 2; // Search half voxel size in each direction
-            // Use adaptive step size based on voxel size for performance
-            int stepSize = std::max(1, voxelSizeCm / 8); // At least 1cm steps, but scale with voxel size
-            for (int dy = -searchRange; dy <= searchRange && !foundHit; dy += stepSize) {
-                for (int dx = -searchRange; dx <= searchRange && !foundHit; dx += stepSize) {
-                    for (int dz = -searchRange; dz <= searchRange && !foundHit; dz += stepSize) {
-                        Math::IncrementCoordinates testIncrement(checkIncrement.x() + dx, checkIncrement.y() + dy, checkIncrement.z() + dz);
-                        
-                        // Check if this voxel exists
-                        if (grid.isValidIncrementPosition(testIncrement) && grid.getVoxel(testIncrement)) {
-                            // Found a voxel! Now check if the ray actually intersects its bounding box
-                            auto [minCorner, maxCorner] = Math::VoxelFaceGeometry::getVoxelCorners(testIncrement, voxelSize);
-                            Math::BoundingBox voxelBox(minCorner.value(), maxCorner.value());
-                            
-                            float voxelTMin, voxelTMax;
-                            if (rayIntersectsBox(ray, voxelBox, voxelTMin, voxelTMax)) {
-                                // Ray intersects this voxel - this is our boundary hit!
-                                // For rays starting inside voxel, use exit point (tMax), otherwise use entry point (tMin)
-                                float hitT = (voxelTMin <= 0.0f) ? voxelTMax : voxelTMin;
-                                FaceDirection hitFace = determineFaceDirection(ray, voxelBox, hitT);
-                                
-                                result.hit = true;
-                                result.distance = hitT;
-                                result.position = ray.pointAt(hitT);
-                                result.face = Face(testIncrement, resolution, hitFace, result.position);
-                                
-                                // Set normal based on face direction
-                                switch (hitFace) {
-                                    case FaceDirection::PositiveX: result.normal = Math::Vector3f(1, 0, 0); break;
-                                    case FaceDirection::NegativeX: result.normal = Math::Vector3f(-1, 0, 0); break;
-                                    case FaceDirection::PositiveY: result.normal = Math::Vector3f(0, 1, 0); break;
-                                    case FaceDirection::NegativeY: result.normal = Math::Vector3f(0, -1, 0); break;
-                                    case FaceDirection::PositiveZ: result.normal = Math::Vector3f(0, 0, 1); break;
-                                    case FaceDirection::NegativeZ: result.normal = Math::Vector3f(0, 0, -1); break;
-                                }
-                                
-                                foundHit = true;
-                                return result;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-    
-    // Traverse grid using DDA algorithm
-    float maxDistance = m_maxRayDistance;
-    float currentDistance = 0.0f;
-    
-    // Track the closest hit
-    struct HitInfo {
-        Math::Vector3i voxel;
-        float distance;
-        Math::Vector3f normal;
-        Face face;
-        bool valid = false;
-    } closestHit;
-    
-    // Track if we start inside a voxel for special handling
-    Math::IncrementCoordinates startVoxel = traversal.current;
-    bool startedInsideVoxel = false;
-    
-    // Check if we start inside a voxel
-    if (grid.isValidIncrementPosition(traversal.current)) {
-        startedInsideVoxel = grid.getVoxel(traversal.current);
-    }
-    
-    // Track the previous voxel for exit detection
-    Math::IncrementCoordinates previousVoxel = traversal.current;
-    bool wasInsideStartVoxel = startedInsideVoxel;
-    
-    int stepCount = 0;
-    const int maxSteps = 10000; // Increased step limit for large workspaces
-    while (currentDistance < maxDistance && stepCount < maxSteps) {
-        // Check current voxel
-        if (grid.isValidIncrementPosition(traversal.current)) {
-            bool isCurrentVoxel = grid.getVoxel(traversal.current);
-            
-            // Only log key voxel hits to reduce performance impact
-            // Commented out to prevent debug output during tests
-            // if (isCurrentVoxel && stepCount < 5) {
-            //     Logging::Logger::getInstance().debugfc("FaceDetector",
-            //         "Found voxel at grid position (%d, %d, %d)",
-            //         traversal.current.x(), traversal.current.y(), traversal.current.z());
-            // }
-            
-            // Special case: ray started inside a voxel and we just exited it
-            if (startedInsideVoxel && wasInsideStartVoxel && 
-                (traversal.current.x() != startVoxel.x() || 
-                 traversal.current.y() != startVoxel.y() || 
-                 traversal.current.z() != startVoxel.z())) {
-                
-                
-                // We just exited the starting voxel - determine which face
-                FaceDirection exitFace;
-                if (traversal.current.x() != previousVoxel.x()) {
-                    exitFace = (traversal.current.x() > previousVoxel.x()) ? 
-                        FaceDirection::PositiveX : FaceDirection::NegativeX;
-                } else if (traversal.current.y() != previousVoxel.y()) {
-                    exitFace = (traversal.current.y() > previousVoxel.y()) ? 
-                        FaceDirection::PositiveY : FaceDirection::NegativeY;
-                } else {
-                    exitFace = (traversal.current.z() > previousVoxel.z()) ? 
-                        FaceDirection::PositiveZ : FaceDirection::NegativeZ;
-                }
-                
-                // Create face for the exit
-                closestHit.valid = true;
-                closestHit.voxel = previousVoxel.value();
-                closestHit.distance = currentDistance;
-                Math::WorldCoordinates exitHitPoint = ray.pointAt(currentDistance);
-                closestHit.face = Face(previousVoxel, resolution, exitFace, exitHitPoint);
-                
-                // Set normal based on exit face
-                switch (exitFace) {
-                    case FaceDirection::PositiveX: closestHit.normal = Math::Vector3f(1, 0, 0); break;
-                    case FaceDirection::NegativeX: closestHit.normal = Math::Vector3f(-1, 0, 0); break;
-                    case FaceDirection::PositiveY: closestHit.normal = Math::Vector3f(0, 1, 0); break;
-                    case FaceDirection::NegativeY: closestHit.normal = Math::Vector3f(0, -1, 0); break;
-                    case FaceDirection::PositiveZ: closestHit.normal = Math::Vector3f(0, 0, 1); break;
-                    case FaceDirection::NegativeZ: closestHit.normal = Math::Vector3f(0, 0, -1); break;
-                }
-                
-                // Mark that we've handled the starting voxel
-                wasInsideStartVoxel = false;
-                
-                // Return the exit face immediately, even if we hit another voxel
-                break;
-            }
-            
-            // Normal case: ray hits a voxel from outside
-            if (isCurrentVoxel && !wasInsideStartVoxel) {
-                // Calculate voxel bounding box using VoxelFaceGeometry
-                auto [minCorner, maxCorner] = Math::VoxelFaceGeometry::getVoxelCorners(traversal.current, voxelSize);
-                Math::BoundingBox voxelBox(minCorner.value(), maxCorner.value());
-                
-                float tMin, tMax;
-                if (rayIntersectsBox(ray, voxelBox, tMin, tMax)) {
-                    // For rays starting inside voxel, use exit point (tMax), otherwise use entry point (tMin)
-                    float hitT = (tMin <= 0.0f) ? tMax : tMin;
-                    float hitDistance = hitT;
-                    
-                    // Only update if this is closer than any previous hit
-                    if (!closestHit.valid || hitDistance < closestHit.distance) {
-                        closestHit.valid = true;
-                        closestHit.voxel = traversal.current.value();
-                        closestHit.distance = hitDistance;
-                        
-                        // Calculate hit point to determine which face was hit
-                        Math::Vector3f hitPoint = ray.origin.value() + ray.direction * hitT;
-                        
-                        // We already have voxelWorldMin and voxelWorldMax from above
-                        
-                        
-                        // Use simplified face direction determination
-                        FaceDirection hitFaceDir = determineFaceDirection(ray, voxelBox, hitT);
-                        closestHit.face = Face(traversal.current, resolution, hitFaceDir, Math::WorldCoordinates(hitPoint));
-                        
-                        // Set normal based on face direction
-                        switch (hitFaceDir) {
-                            case FaceDirection::PositiveX: closestHit.normal = Math::Vector3f(1, 0, 0); break;
-                            case FaceDirection::NegativeX: closestHit.normal = Math::Vector3f(-1, 0, 0); break;
-                            case FaceDirection::PositiveY: closestHit.normal = Math::Vector3f(0, 1, 0); break;
-                            case FaceDirection::NegativeY: closestHit.normal = Math::Vector3f(0, -1, 0); break;
-                            case FaceDirection::PositiveZ: closestHit.normal = Math::Vector3f(0, 0, 1); break;
-                            case FaceDirection::NegativeZ: closestHit.normal = Math::Vector3f(0, 0, -1); break;
-                        }
-                        
-                        // Log key hit information
-                        // Commented out to prevent debug output during tests
-                        // if (stepCount < 3) {
-                        //     Logging::Logger::getInstance().debugfc("FaceDetector",
-                        //         "Hit voxel at (%d,%d,%d) face=%d",
-                        //         traversal.current.x(), traversal.current.y(), traversal.current.z(),
-                        //         static_cast<int>(closestHit.face.getDirection()));
-                        // }
-                    }
-                }
-            }
-        }
-        
-        // Update tracking variables
-        previousVoxel = traversal.current;
-        
-        // Step to next voxel
-        stepTraversal(traversal);
-        currentDistance = std::min({traversal.tMax.x, traversal.tMax.y, traversal.tMax.z});
-        stepCount++;
-    }
+    // Voxels extend from their bottom-left-back corner
+    float voxelSize = VoxelData::getVoxelSize(resolution);
+    Math::Vector3f minCorner = Math::CoordinateConverter::incrementToWorld(voxelPos).value();
+    Math::BoundingBox voxelBox(minCorner, minCorner + Math::Vector3f(voxelSize, voxelSize, voxelSize));
     
-    // Return the closest hit if we found one
-    if (closestHit.valid) {
-        result.hit = true;
-        result.distance = closestHit.distance;
-        result.position = ray.pointAt(result.distance);
-        result.normal = closestHit.normal;
-        result.face = closestHit.face;
-        
-        // Return the closest hit we found
-    }
+    FaceDirection faceDir = determineFaceDirection(ray, voxelBox, distance);
+    Math::WorldCoordinates hitPoint = ray.pointAt(distance);
     
+    result.hit = true;
+    result.distance = distance;
+    result.position = hitPoint;
+    result.face = Face(voxelPos, resolution, faceDir, hitPoint);
+    result.normal = result.face.getNormal();
     return result;
 }
 
@@ -646,104 +244,6 @@ bool FaceDetector::isValidFace(const Face& face, const VoxelData::VoxelGrid& gri
     return grid.getVoxel(face.getVoxelPosition());
 }
 
-bool FaceDetector::rayIntersectsBox(const Ray& ray, const Math::BoundingBox& box, 
-                                   float& tMin, float& tMax) const {
-    Math::Vector3f invDir(
-        1.0f / (std::abs(ray.direction.x) < 0.0001f ? 0.0001f : ray.direction.x),
-        1.0f / (std::abs(ray.direction.y) < 0.0001f ? 0.0001f : ray.direction.y),
-        1.0f / (std::abs(ray.direction.z) < 0.0001f ? 0.0001f : ray.direction.z)
-    );
-    
-    Math::Vector3f t1 = (box.min - ray.origin.value()) * invDir;
-    Math::Vector3f t2 = (box.max - ray.origin.value()) * invDir;
-    
-    Math::Vector3f tMinVec(std::min(t1.x, t2.x), std::min(t1.y, t2.y), std::min(t1.z, t2.z));
-    Math::Vector3f tMaxVec(std::max(t1.x, t2.x), std::max(t1.y, t2.y), std::max(t1.z, t2.z));
-    
-    tMin = std::max({tMinVec.x, tMinVec.y, tMinVec.z, 0.0f});
-    tMax = std::min({tMaxVec.x, tMaxVec.y, tMaxVec.z});
-    
-    return tMin <= tMax && tMax >= 0.0f;
-}
-
-void FaceDetector::initializeTraversal(const Ray& ray, const Math::WorldCoordinates& gridMin, 
-                                      float voxelSize, VoxelData::VoxelResolution resolution, GridTraversal& traversal) const {
-    // Calculate voxel size in centimeters for increment coordinate stepping
-    int voxelSizeCm = static_cast<int>(voxelSize * Math::CoordinateConverter::METERS_TO_CM);
-    
-    // Convert ray origin to increment coordinates and snap to voxel grid boundaries
-    Math::IncrementCoordinates rayIncrement = Math::CoordinateConverter::worldToIncrement(ray.origin);
-    
-    // Snap to voxel grid boundaries by rounding to nearest voxel increment
-    Math::Vector3i snappedIncrement(
-        (rayIncrement.x() / voxelSizeCm) * voxelSizeCm,
-        (rayIncrement.y() / voxelSizeCm) * voxelSizeCm,
-        (rayIncrement.z() / voxelSizeCm) * voxelSizeCm
-    );
-    
-    traversal.current = Math::IncrementCoordinates(snappedIncrement);
-    
-    // Step direction uses voxel-size increments, not 1cm increments
-    traversal.step = Math::Vector3i(
-        ray.direction.x > 0 ? voxelSizeCm : -voxelSizeCm,
-        ray.direction.y > 0 ? voxelSizeCm : -voxelSizeCm,
-        ray.direction.z > 0 ? voxelSizeCm : -voxelSizeCm
-    );
-    
-    // Calculate tMax and tDelta using voxel size instead of 1cm
-    const float epsilon = 0.0001f;
-    
-    // Convert current position to world coordinates for tMax calculation
-    Math::WorldCoordinates currentWorld = Math::CoordinateConverter::incrementToWorld(traversal.current);
-    
-    if (std::abs(ray.direction.x) > epsilon) {
-        float nextX = currentWorld.x() + (ray.direction.x > 0 ? voxelSize : -voxelSize);
-        traversal.tMax.x = (nextX - ray.origin.x()) / ray.direction.x;
-        traversal.tDelta.x = voxelSize / std::abs(ray.direction.x);
-    } else {
-        traversal.tMax.x = std::numeric_limits<float>::max();
-        traversal.tDelta.x = std::numeric_limits<float>::max();
-    }
-    
-    if (std::abs(ray.direction.y) > epsilon) {
-        float nextY = currentWorld.y() + (ray.direction.y > 0 ? voxelSize : -voxelSize);
-        traversal.tMax.y = (nextY - ray.origin.y()) / ray.direction.y;
-        traversal.tDelta.y = voxelSize / std::abs(ray.direction.y);
-    } else {
-        traversal.tMax.y = std::numeric_limits<float>::max();
-        traversal.tDelta.y = std::numeric_limits<float>::max();
-    }
-    
-    if (std::abs(ray.direction.z) > epsilon) {
-        float nextZ = currentWorld.z() + (ray.direction.z > 0 ? voxelSize : -voxelSize);
-        traversal.tMax.z = (nextZ - ray.origin.z()) / ray.direction.z;
-        traversal.tDelta.z = voxelSize / std::abs(ray.direction.z);
-    } else {
-        traversal.tMax.z = std::numeric_limits<float>::max();
-        traversal.tDelta.z = std::numeric_limits<float>::max();
-    }
-}
-
-void FaceDetector::stepTraversal(GridTraversal& traversal) const {
-    if (traversal.tMax.x < traversal.tMax.y) {
-        if (traversal.tMax.x < traversal.tMax.z) {
-            traversal.current = Math::IncrementCoordinates(traversal.current.x() + traversal.step.x, traversal.current.y(), traversal.current.z());
-            traversal.tMax.x += traversal.tDelta.x;
-        } else {
-            traversal.current = Math::IncrementCoordinates(traversal.current.x(), traversal.current.y(), traversal.current.z() + traversal.step.z);
-            traversal.tMax.z += traversal.tDelta.z;
-        }
-    } else {
-        if (traversal.tMax.y < traversal.tMax.z) {
-            traversal.current = Math::IncrementCoordinates(traversal.current.x(), traversal.current.y() + traversal.step.y, traversal.current.z());
-            traversal.tMax.y += traversal.tDelta.y;
-        } else {
-            traversal.current = Math::IncrementCoordinates(traversal.current.x(), traversal.current.y(), traversal.current.z() + traversal.step.z);
-            traversal.tMax.z += traversal.tDelta.z;
-        }
-    }
-}
-
 // Additional methods for requirements tests
 bool FaceDetector::isFaceVisible(const Face& face) const {
     // For simplicity, assume all faces are visible
@@ -763,55 +263,51 @@ bool FaceDetector::hasActiveHighlight() const {
     return m_hasActiveHighlight;
 }
 
-FaceDirection FaceDetector::determineFaceDirection(const Ray& ray, const Math::BoundingBox& voxelBox, float tMin) const {
-    // Calculate the hit point on the voxel box
-    Math::Vector3f hitPoint = ray.origin.value() + ray.direction * tMin;
-    
-    // Tolerance for determining which face was hit (smaller = more precise)
-    const float epsilon = 0.01f;
-    
-    // Check distance from hit point to each face plane
-    float distToMinX = std::abs(hitPoint.x - voxelBox.min.x);
-    float distToMaxX = std::abs(hitPoint.x - voxelBox.max.x);
-    float distToMinY = std::abs(hitPoint.y - voxelBox.min.y);
-    float distToMaxY = std::abs(hitPoint.y - voxelBox.max.y);
-    float distToMinZ = std::abs(hitPoint.z - voxelBox.min.z);
-    float distToMaxZ = std::abs(hitPoint.z - voxelBox.max.z);
-    
-    // Find the minimum distance (which face we're closest to)
-    float minDist = std::min({distToMinX, distToMaxX, distToMinY, distToMaxY, distToMinZ, distToMaxZ});
-    
-    // Return the face direction based on which plane we're closest to
-    // Note: When ray hits a face, the face direction should match the face normal
-    if (minDist == distToMinX) {
-        return FaceDirection::NegativeX;  // Left face (normal points -X)
-    } else if (minDist == distToMaxX) {
-        return FaceDirection::PositiveX;  // Right face (normal points +X)
-    } else if (minDist == distToMinY) {
-        return FaceDirection::NegativeY;  // Bottom face (normal points -Y)
-    } else if (minDist == distToMaxY) {
-        return FaceDirection::PositiveY;  // Top face (normal points +Y)
-    } else if (minDist == distToMinZ) {
-        return FaceDirection::NegativeZ;  // Front face (normal points -Z)
-    } else if (minDist == distToMaxZ) {
-        return FaceDirection::PositiveZ;  // Back face (normal points +Z)
+FaceDirection FaceDetector::determineFaceDirection(const Ray& ray, const Math::BoundingBox& voxelBox, float t) const {
+    Math::Vector3f origin = ray.origin.value();
+    
+    // The ray enters through the slab it reaches last, or leaves through the
+    // one it exits first when t is past every entry (it starts inside). Axes
+    // the ray runs parallel to never supply a face.
+    int entryAxis = -1;
+    int exitAxis = -1;
+    float entryT = -std::numeric_limits<float>::max();
+    float exitT = std::numeric_limits<float>::max();
+    for (int axis = 0; axis < 3; ++axis) {
+        float d = ray.direction[axis];
+        if (std::abs(d) < PARALLEL_EPSILON) {
+            continue;
+        }
+        float t0 = (voxelBox.min[axis] - origin[axis]) / d;
+        float t1 = (voxelBox.max[axis] - origin[axis]) / d;
+        if (t0 > t1) std::swap(t0, t1);
+        // At edges and corners the more head-on axis wins
+        if (entryAxis < 0 || t0 > entryT + FACE_TIE_EPSILON ||
+            (t0 > entryT - FACE_TIE_EPSILON && std::abs(d) > std::abs(ray.direction[entryAxis]))) {
+            entryAxis = axis;
+            entryT = std::max(entryT, t0);
+        }
+        if (exitAxis < 0 || t1 < exitT - FACE_TIE_EPSILON ||
+            (t1 < exitT + FACE_TIE_EPSILON && std::abs(d) > std::abs(ray.direction[exitAxis]))) {
+            exitAxis = axis;
+            exitT = std::min(exitT, t1);
+        }
     }
     
-    // Fallback: use ray direction to determine most likely face
-    // This handles edge cases where hit point is not exactly on a face
-    float absX = std::abs(ray.direction.x);
-    float absY = std::abs(ray.direction.y);
-    float absZ = std::abs(ray.direction.z);
+    if (entryAxis < 0) {
+        return FaceDirection::PositiveY;
+    }
     
-    if (absX >= absY && absX >= absZ) {
-        // X is dominant direction
-        return (ray.direction.x > 0) ? FaceDirection::PositiveX : FaceDirection::NegativeX;
-    } else if (absY >= absX && absY >= absZ) {
-        // Y is dominant direction
-        return (ray.direction.y > 0) ? FaceDirection::PositiveY : FaceDirection::NegativeY;
-    } else {
-        // Z is dominant direction
-        return (ray.direction.z > 0) ? FaceDirection::PositiveZ : FaceDirection::NegativeZ;
+    // A hit past the entry point means the ray started inside (or on the
+    // surface) and the grid reported where it leaves
+    bool leaving = t > entryT + FACE_TIE_EPSILON;
+    int axis = leaving ? exitAxis : entryAxis;
+    // Entering against +d crosses the low plane; leaving crosses the high one
+    bool lowPlane = (ray.direction[axis] > 0.0f) != leaving;
+    switch (axis) {
+        case 0: return lowPlane ? FaceDirection::NegativeX : FaceDirection::PositiveX;
+        case 1: return lowPlane ? FaceDirection::NegativeY : FaceDirection::PositiveY;
+        default: return lowPlane ? FaceDirection::NegativeZ : FaceDirection::PositiveZ;
     }
 }
 
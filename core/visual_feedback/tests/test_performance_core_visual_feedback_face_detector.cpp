@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "../include/visual_feedback/FaceDetector.h"
+#include "../../voxel_data/VoxelGrid.h"
+#include "../../foundation/logging/Logger.h"
+#include <chrono>
+#include <iostream>
+
+using namespace VoxelEditor::Math;
+using VoxelEditor::Logging::Logger;
+using VoxelEditor::Logging::LogLevel;
+namespace VoxelData = VoxelEditor::VoxelData;
+namespace VisualFeedback = VoxelEditor::VisualFeedback;
+
+class FaceDetectorPickPerformanceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::getInstance().setLevel(LogLevel::Warning);
+        detector = std::make_unique<VisualFeedback::FaceDetector>();
+    }
+
+    std::unique_ptr<VisualFeedback::FaceDetector> detector;
+};
+
+// Hover picking on a dense scene only walks the octree nodes along the ray
+TEST_F(FaceDetectorPickPerformanceTest, HoverPickOnMillionVoxelScene) {
+    auto res = VoxelData::VoxelResolution::Size_4cm;
+    VoxelData::VoxelGrid denseGrid(res, Vector3f(8.0f, 8.0f, 8.0f));
+
+    // 100 x 100 x 100 voxels filling a 4m cube
+    for (int x = -200; x < 200; x += 4) {
+        for (int y = 0; y < 400; y += 4) {
+            for (int z = -200; z < 200; z += 4) {
+                denseGrid.setVoxel(IncrementCoordinates(x, y, z), true);
+            }
+        }
+    }
+    ASSERT_EQ(denseGrid.getVoxelCount(), 1000000u);
+
+    // Rays from an isometric camera toward points spread over the cube
+    Vector3f cameraPos(5.0f, 6.0f, 5.0f);
+    std::vector<VisualFeedback::Ray> rays;
+    for (int i = 0; i < 1000; ++i) {
+        Vector3f target(-2.0f + 0.004f * ((i * 37) % 1000), 0.004f * ((i * 53) % 1000), -2.0f + 0.004f * ((i * 71) % 1000));
+        rays.emplace_back(cameraPos, (target - cameraPos).normalized());
+    }
+
+    int hits = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& ray : rays) {
+        if (detector->detectFace(ray, denseGrid, res).isValid()) {
+            ++hits;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double perRayUs = std::chrono::duration<double, std::micro>(end - start).count() / rays.size();
+
+    EXPECT_EQ(hits, static_cast<int>(rays.size())) << "Every ray aims inside the filled cube";
+    EXPECT_LT(perRayUs, 100.0) << "Hover picking should stay under 100us per ray";
+    std::cout << "Hover pick on 1M voxels: " << perRayUs << " us per ray" << std::endl;
+}
@@ -1273,4 +1273,39 @@ TEST_F(FaceDetectorTraversalTest, NegativeCoordinateRaycast) {
     
     
     std::cout << "\n=== Negative Coordinate Raycast Test Complete ===" << std::endl;
-}
\ No newline at end of file
+}
+
+// Hover picking on a dense scene hits the surface voxel facing the camera
+TEST_F(FaceDetectorTraversalTest, HoverPickOnDenseScene) {
+    auto res = VoxelData::VoxelResolution::Size_4cm;
+    VoxelData::VoxelGrid denseGrid(res, Vector3f(8.0f, 8.0f, 8.0f));
+    
+    // 20 x 20 x 20 voxels filling an 80cm cube
+    for (int x = -40; x < 40; x += 4) {
+        for (int y = 0; y < 80; y += 4) {
+            for (int z = -40; z < 40; z += 4) {
+                denseGrid.setVoxel(IncrementCoordinates(x, y, z), true);
+            }
+        }
+    }
+    ASSERT_EQ(denseGrid.getVoxelCount(), 8000u);
+    
+    // Rays from an isometric camera toward points spread over the cube
+    Vector3f cameraPos(5.0f, 6.0f, 5.0f);
+    int hits = 0;
+    for (int i = 0; i < 200; ++i) {
+        Vector3f target(-0.4f + 0.0008f * ((i * 37) % 1000), 0.0008f * ((i * 53) % 1000), -0.4f + 0.0008f * ((i * 71) % 1000));
+        VisualFeedback::Ray ray(cameraPos, (target - cameraPos).normalized());
+        if (detector->detectFace(ray, denseGrid, res).isValid()) {
+            ++hits;
+        }
+    }
+    EXPECT_EQ(hits, 200) << "Every ray aims inside the filled cube";
+    
+    // The first voxel along the ray is on the surface facing the camera
+    VisualFeedback::Ray down(Vector3f(0.01f, 6.0f, 0.01f), Vector3f(0, -1, 0));
+    VisualFeedback::Face top = detector->detectFace(down, denseGrid, res);
+    ASSERT_TRUE(top.isValid());
+    EXPECT_EQ(top.getVoxelPosition().value(), Vector3i(0, 76, 0));
+    EXPECT_EQ(top.getDirection(), VisualFeedback::FaceDirection::PositiveY);
+}
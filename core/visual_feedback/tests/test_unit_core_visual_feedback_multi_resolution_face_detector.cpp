@@ -102,15 +102,17 @@ TEST_F(MultiResolutionFaceDetectorTest, RayIntersectionAccuracy_LargeVoxelFaces)
             std::string faceName;
         };
         
-        // For bottom-center coordinate system:
-        // Voxel extends from (-voxelSize/2, 0, -voxelSize/2) to (voxelSize/2, voxelSize, voxelSize/2)
+        // Face picking treats a voxel position as its bottom-left-back corner,
+        // like the other tests here: the voxel spans (0, 0, 0) to
+        // (voxelSize, voxelSize, voxelSize) from its world position
+        float half = voxelSize * 0.5f;
         std::vector<FaceTest> faceTests = {
-            {Math::Vector3f(voxelSize * 0.5f + 0.1f, voxelSize * 0.5f, 0.0f), Math::Vector3f(-1, 0, 0), VisualFeedback::FaceDirection::PositiveX, "PositiveX"},
-            {Math::Vector3f(-voxelSize * 0.5f - 0.1f, voxelSize * 0.5f, 0.0f), Math::Vector3f(1, 0, 0), VisualFeedback::FaceDirection::NegativeX, "NegativeX"},
-            {Math::Vector3f(0.0f, voxelSize + 0.1f, 0.0f), Math::Vector3f(0, -1, 0), VisualFeedback::FaceDirection::PositiveY, "PositiveY"},
-            {Math::Vector3f(0.0f, -0.1f, 0.0f), Math::Vector3f(0, 1, 0), VisualFeedback::FaceDirection::NegativeY, "NegativeY"},
-            {Math::Vector3f(0.0f, voxelSize * 0.5f, voxelSize * 0.5f + 0.1f), Math::Vector3f(0, 0, -1), VisualFeedback::FaceDirection::PositiveZ, "PositiveZ"},
-            {Math::Vector3f(0.0f, voxelSize * 0.5f, -voxelSize * 0.5f - 0.1f), Math::Vector3f(0, 0, 1), VisualFeedback::FaceDirection::NegativeZ, "NegativeZ"}
+            {Math::Vector3f(voxelSize + 0.1f, half, half), Math::Vector3f(-1, 0, 0), VisualFeedback::FaceDirection::PositiveX, "PositiveX"},
+            {Math::Vector3f(-0.1f, half, half), Math::Vector3f(1, 0, 0), VisualFeedback::FaceDirection::NegativeX, "NegativeX"},
+            {Math::Vector3f(half, voxelSize + 0.1f, half), Math::Vector3f(0, -1, 0), VisualFeedback::FaceDirection::PositiveY, "PositiveY"},
+            {Math::Vector3f(half, -0.1f, half), Math::Vector3f(0, 1, 0), VisualFeedback::FaceDirection::NegativeY, "NegativeY"},
+            {Math::Vector3f(half, half, voxelSize + 0.1f), Math::Vector3f(0, 0, -1), VisualFeedback::FaceDirection::PositiveZ, "PositiveZ"},
+            {Math::Vector3f(half, half, -0.1f), Math::Vector3f(0, 0, 1), VisualFeedback::FaceDirection::NegativeZ, "NegativeZ"}
         };
         
         for (const auto& faceTest : faceTests) {
@@ -169,19 +171,22 @@ TEST_F(MultiResolutionFaceDetectorTest, HitPointCalculation_PrecisionOnLargeFace
     Math::Vector3f voxelWorldPos = largeGrid.incrementToWorld(largeVoxelPos).value();
     float voxelSize = VoxelData::getVoxelSize(largeRes);
     
-    // Test hit points at different locations on the positive X face
+    // Test hit points at different locations on the positive X face. Corners
+    // are inset by 1mm: a ray exactly on the top or far edge belongs to the
+    // neighbouring voxel on the high side, which is empty here
+    const float inset = 0.001f;
     std::vector<Math::Vector3f> testPoints = {
-        Math::Vector3f(0, 0, 0),                    // Bottom-left corner
-        Math::Vector3f(0, voxelSize, 0),            // Top-left corner
-        Math::Vector3f(0, 0, voxelSize),            // Bottom-right corner
-        Math::Vector3f(0, voxelSize, voxelSize),    // Top-right corner
-        Math::Vector3f(0, voxelSize * 0.5f, voxelSize * 0.5f), // Center
-        Math::Vector3f(0, voxelSize * 0.25f, voxelSize * 0.75f) // Arbitrary point
+        Math::Vector3f(0, inset, inset),                            // Bottom-left corner
+        Math::Vector3f(0, voxelSize - inset, inset),                // Top-left corner
+        Math::Vector3f(0, inset, voxelSize - inset),                // Bottom-right corner
+        Math::Vector3f(0, voxelSize - inset, voxelSize - inset),    // Top-right corner
+        Math::Vector3f(0, voxelSize * 0.5f, voxelSize * 0.5f),      // Center
+        Math::Vector3f(0, voxelSize * 0.25f, voxelSize * 0.75f)     // Arbitrary point
     };
     
     for (const auto& testPoint : testPoints) {
-        // For bottom-center system, +X face is at voxelSize/2
-        Math::Vector3f targetPoint = voxelWorldPos + Math::Vector3f(voxelSize * 0.5f, testPoint.y, testPoint.z - voxelSize * 0.5f);
+        // Face picking uses corner-based voxel boxes, so the +X face is at voxelSize
+        Math::Vector3f targetPoint = voxelWorldPos + Math::Vector3f(voxelSize, testPoint.y, testPoint.z);
         Math::Vector3f rayOrigin = targetPoint + Math::Vector3f(0.5f, 0, 0); // 50cm away in +X
         Math::Vector3f rayDirection = Math::Vector3f(-1, 0, 0);
         
@@ -192,7 +197,11 @@ TEST_F(MultiResolutionFaceDetectorTest, HitPointCalculation_PrecisionOnLargeFace
         
         // Check that hit point is approximately at the expected location
         if (face.isValid()) {
-            // Hit point verification removed - not available in Face API
+            EXPECT_EQ(face.getDirection(), VisualFeedback::FaceDirection::PositiveX);
+            Math::Vector3f hitPoint = face.getHitPoint().value();
+            EXPECT_NEAR(hitPoint.x, targetPoint.x, 1e-4f);
+            EXPECT_NEAR(hitPoint.y, targetPoint.y, 1e-4f);
+            EXPECT_NEAR(hitPoint.z, targetPoint.z, 1e-4f);
         }
     }
 }
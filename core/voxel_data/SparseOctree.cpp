@@ -34,7 +34,7 @@ std::unique_ptr<Memory::TypedMemoryPool<OctreeNode>> SparseOctree::s_nodePool =
 
 void SparseOctree::initializePool(size_t initialSize) {
     if (!s_nodePool) {
-        s_nodePool = std::make_unique<Memory::TypedMemoryPool<OctreeNode>>(initialSize);
+        s_nodePool = std::make_unique<Memory::TypedMemoryPool<OctreeNode>>(initialSize, "OctreeNodes");
     }
 }
 
@@ -59,5 +59,11 @@ void SparseOctree::deallocateNode(OctreeNode* node) {
     }
 }
 
+void SparseOctree::deallocateNodes(OctreeNode* const* nodes, size_t count) {
+    if (nodes && s_nodePool) {
+        s_nodePool->destroyN(nodes, count);
+    }
+}
+
 }
 }
\ No newline at end of file
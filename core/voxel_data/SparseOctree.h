@@ -3,10 +3,14 @@
 #include "VoxelTypes.h"
 #include "../../foundation/memory/MemoryPool.h"
 #include "../../foundation/math/Vector3i.h"
+#include "../../foundation/math/Vector3f.h"
 #include <memory>
 #include <array>
 #include <vector>
 #include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <limits>
 
 namespace VoxelEditor {
 namespace VoxelData {
@@ -98,7 +102,7 @@ private:
 
 class SparseOctree {
 public:
-    SparseOctree(int maxDepth = 10) : m_root(nullptr), m_maxDepth(maxDepth), m_nodeCount(0) {
+    SparseOctree(int maxDepth = 10) : m_root(nullptr), m_maxDepth(maxDepth), m_nodeCount(0), m_voxelCount(0) {
         // Calculate root bounds based on max depth
         int rootSize = 1 << maxDepth;  // 2^maxDepth
         // Root center should be at the middle of the space
@@ -153,6 +157,7 @@ public:
             m_root = nullptr;
         }
         m_nodeCount = 0;
+        m_voxelCount = 0;
     }
     
     // Get memory usage statistics
@@ -164,19 +169,129 @@ public:
         return m_nodeCount;
     }
     
+    // Kept up to date by insert and remove, so no traversal is needed
     size_t getVoxelCount() const {
-        return getAllVoxels().size();
+        return m_voxelCount;
+    }
+    
+    // Empty branches are pruned on removal, so this needs no traversal
+    bool isEmpty() const {
+        return !m_root || canRemoveChild(m_root);
     }
     
     // Get all voxel positions
     std::vector<Math::Vector3i> getAllVoxels() const {
+        std::vector<Math::Vector3i> voxels;
+        forEachVoxel([&voxels](const Math::Vector3i& pos) { voxels.push_back(pos); });
+        return voxels;
+    }
+    
+    // Visit every voxel position without building a list
+    template<typename Visitor>
+    void forEachVoxel(Visitor&& visit) const {
+        if (m_root) {
+            visitVoxels(m_root, 0, visit);
+        }
+    }
+    
+    // Get voxel positions inside an inclusive range. Only branches that
+    // overlap the range are visited, so the cost follows the voxels found.
+    std::vector<Math::Vector3i> getVoxelsInRange(const Math::Vector3i& minPos, const Math::Vector3i& maxPos) const {
         std::vector<Math::Vector3i> voxels;
         if (m_root) {
-            collectVoxels(m_root, m_rootCenter, m_rootSize / 2, 0, voxels);
+            collectVoxelsInRange(m_root, m_rootCenter, m_rootSize / 2, 0, minPos, maxPos, voxels);
         }
         return voxels;
     }
     
+    // Find the nearest voxel along a ray. A voxel stored at p occupies the box
+    // [p, p + voxelExtent) in grid units, so every node's box is grown by the
+    // extent before it is tested. Occupied children are visited front to back
+    // and anything entered beyond the best hit so far is skipped, which keeps
+    // the cost close to the nodes the ray actually crosses. hitT is the entry
+    // distance, or the exit distance when the ray starts inside the voxel.
+    bool raycast(const Math::Vector3f& origin, const Math::Vector3f& direction, int voxelExtent,
+                 float maxT, Math::Vector3i& hitPos, float& hitT) const {
+        if (!m_root) {
+            return false;
+        }
+        RayQuery query;
+        query.origin = origin;
+        query.direction = direction;
+        query.extent = voxelExtent;
+        query.bestT = maxT;
+        query.hit = false;
+        
+        float tEnter, tExit;
+        Math::Vector3i rootMin(0, 0, 0);
+        Math::Vector3i rootMax(m_rootSize, m_rootSize, m_rootSize);
+        if (!intersectRay(query, rootMin, rootMax, tEnter, tExit)) {
+            return false;
+        }
+        raycastNode(m_root, m_rootCenter, m_rootSize / 2, 0, query);
+        
+        if (query.hit) {
+            hitPos = query.hitPos;
+            hitT = query.bestT;
+        }
+        return query.hit;
+    }
+
+    static constexpr int RAY_PACKET_SIZE = 8;
+
+    // raycast() for up to RAY_PACKET_SIZE rays at once. The packet descends
+    // the tree together: every node is slab-tested against all lanes in
+    // straight-line lane loops the compiler vectorizes, a child is entered
+    // while any lane reaches it before that lane's best hit, and children are
+    // visited in order of their nearest lane entry. Coherent rays share most
+    // of their path, so each node is fetched and tested once per packet
+    // instead of once per ray. Returns the number of lanes that hit.
+    int raycastPacket(const Math::Vector3f* origins, const Math::Vector3f* directions, int count,
+                      int voxelExtent, float maxT, Math::Vector3i* hitPos, float* hitT, bool* hit) const {
+        count = std::min(count, RAY_PACKET_SIZE);
+        for (int i = 0; i < count; ++i) {
+            hit[i] = false;
+        }
+        if (!m_root || count <= 0) {
+            return 0;
+        }
+
+        RayPacket packet;
+        packet.extent = voxelExtent;
+        for (int lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+            // Spare lanes repeat the first ray but can never accept a hit
+            int ray = lane < count ? lane : 0;
+            for (int axis = 0; axis < 3; ++axis) {
+                float d = directions[ray][axis];
+                packet.origin[axis][lane] = origins[ray][axis];
+                packet.inverse[axis][lane] = d == 0.0f ? PARALLEL_INVERSE : 1.0f / d;
+                packet.highInset[axis][lane] = d == 0.0f ? 2.0f * RAY_EPSILON : 0.0f;
+            }
+            packet.bestT[lane] = lane < count ? maxT : -1.0f;
+            packet.hit[lane] = false;
+        }
+
+        alignas(32) float tEnter[RAY_PACKET_SIZE];
+        alignas(32) float tExit[RAY_PACKET_SIZE];
+        Math::Vector3i rootMin(0, 0, 0);
+        Math::Vector3i rootMax(m_rootSize, m_rootSize, m_rootSize);
+        if (intersectPacket(packet, rootMin, rootMax, tEnter, tExit) == RAY_MISS) {
+            return 0;
+        }
+        raycastPacketNode(m_root, m_rootCenter, m_rootSize / 2, 0, packet);
+
+        int hits = 0;
+        for (int i = 0; i < count; ++i) {
+            if (packet.hit[i]) {
+                hit[i] = true;
+                hitPos[i] = packet.hitPos[i];
+                hitT[i] = packet.bestT[i];
+                ++hits;
+            }
+        }
+        return hits;
+    }
+
     // Optimize memory by removing empty branches
     void optimize() {
         if (m_root) {
@@ -192,6 +307,7 @@ public:
     static void shutdownPool();
     static OctreeNode* allocateNode();
     static void deallocateNode(OctreeNode* node);
+    static void deallocateNodes(OctreeNode* const* nodes, size_t count);
     
 private:
     OctreeNode* m_root;
@@ -199,22 +315,23 @@ private:
     int m_rootSize;
     int m_maxDepth;
     size_t m_nodeCount;
+    size_t m_voxelCount;
     
     static std::unique_ptr<Memory::TypedMemoryPool<OctreeNode>> s_nodePool;
     
-    // Deallocate a subtree iteratively to avoid stack overflow
+    // Deallocate a subtree iteratively to avoid stack overflow, returning
+    // the nodes to the pool in one batch
     void deallocateSubtree(OctreeNode* root) {
         if (!root) return;
         
-        // Use a stack to avoid recursion
+        // Breadth-first: every node is detached from its parent before it is visited
         std::vector<OctreeNode*> nodesToDelete;
         nodesToDelete.push_back(root);
         
-        while (!nodesToDelete.empty()) {
-            OctreeNode* node = nodesToDelete.back();
-            nodesToDelete.pop_back();
+        for (size_t index = 0; index < nodesToDelete.size(); ++index) {
+            OctreeNode* node = nodesToDelete[index];
             
-            // Add children to the stack if not a leaf
+            // Add children to the list if not a leaf
             if (!node->isLeaf()) {
                 for (int i = 0; i < 8; ++i) {
                     OctreeNode* child = node->getChild(i);
@@ -224,11 +341,10 @@ private:
                     }
                 }
             }
-            
-            // Deallocate the node
-            deallocateNode(node);
-            m_nodeCount--;
         }
+        
+        deallocateNodes(nodesToDelete.data(), nodesToDelete.size());
+        m_nodeCount -= nodesToDelete.size();
     }
     
     bool isPositionValid(const Math::Vector3i& pos) const {
@@ -252,6 +368,9 @@ private:
                             const Math::Vector3i& center, int halfSize, int depth) {
         if (depth >= m_maxDepth) {
             // At leaf level, set the voxel and store its position
+            if (!node->hasVoxel()) {
+                ++m_voxelCount;
+            }
             node->setVoxel(true, pos);
             return true;
         }
@@ -283,6 +402,9 @@ private:
                             const Math::Vector3i& center, int halfSize, int depth) {
         if (depth >= m_maxDepth) {
             // At leaf level, remove the voxel
+            if (node->hasVoxel()) {
+                --m_voxelCount;
+            }
             node->setVoxel(false);
             return true;
         }
@@ -324,23 +446,274 @@ private:
         return findVoxel(child, pos, childCenter, halfSize / 2, depth + 1);
     }
     
-    void collectVoxels(OctreeNode* node, const Math::Vector3i& center, int halfSize, int depth,
-                      std::vector<Math::Vector3i>& voxels) const {
+    // Leaves store their own position, so no centers are needed on the way down
+    template<typename Visitor>
+    void visitVoxels(const OctreeNode* node, int depth, Visitor& visit) const {
+        if (depth >= m_maxDepth) {
+            if (node->hasVoxel()) {
+                visit(node->getVoxelPos());
+            }
+            return;
+        }
+        
+        for (int i = 0; i < 8; ++i) {
+            OctreeNode* child = node->getChild(i);
+            if (child) {
+                visitVoxels(child, depth + 1, visit);
+            }
+        }
+    }
+    
+    void collectVoxelsInRange(OctreeNode* node, const Math::Vector3i& center, int halfSize, int depth,
+                              const Math::Vector3i& minPos, const Math::Vector3i& maxPos,
+                              std::vector<Math::Vector3i>& voxels) const {
         if (depth >= m_maxDepth) {
             if (node->hasVoxel()) {
-                // Use the stored voxel position
                 Math::Vector3i voxelPos = node->getVoxelPos();
-                voxels.push_back(voxelPos);
+                if (voxelPos.x >= minPos.x && voxelPos.x <= maxPos.x &&
+                    voxelPos.y >= minPos.y && voxelPos.y <= maxPos.y &&
+                    voxelPos.z >= minPos.z && voxelPos.z <= maxPos.z) {
+                    voxels.push_back(voxelPos);
+                }
             }
             return;
         }
         
+        // Interior nodes cover [center - halfSize, center + halfSize)
+        if (center.x + halfSize <= minPos.x || center.x - halfSize > maxPos.x ||
+            center.y + halfSize <= minPos.y || center.y - halfSize > maxPos.y ||
+            center.z + halfSize <= minPos.z || center.z - halfSize > maxPos.z) {
+            return;
+        }
+        
         for (int i = 0; i < 8; ++i) {
             OctreeNode* child = node->getChild(i);
             if (child) {
                 Math::Vector3i childCenter = OctreeNode::getChildCenter(center, i, halfSize / 2);
-                collectVoxels(child, childCenter, halfSize / 2, depth + 1, voxels);
+                collectVoxelsInRange(child, childCenter, halfSize / 2, depth + 1, minPos, maxPos, voxels);
+            }
+        }
+    }
+    
+    static constexpr float RAY_EPSILON = 1e-3f;
+    
+    struct RayQuery {
+        Math::Vector3f origin;
+        Math::Vector3f direction;
+        int extent;
+        float bestT;
+        Math::Vector3i hitPos;
+        bool hit;
+    };
+    
+    // Slab test of the ray against the cells [minCell, maxCell) grown by the
+    // voxel extent. Only intervals that reach past the origin and start
+    // before the best hit count. Boxes are padded by RAY_EPSILON so rays that
+    // graze an edge, or run along a face from a rounded origin, still land.
+    static bool intersectRay(const RayQuery& query, const Math::Vector3i& minCell, const Math::Vector3i& maxCell,
+                             float& tEnter, float& tExit) {
+        tEnter = -std::numeric_limits<float>::max();
+        tExit = std::numeric_limits<float>::max();
+        for (int axis = 0; axis < 3; ++axis) {
+            float lo = static_cast<float>(minCell[axis]) - RAY_EPSILON;
+            float hi = static_cast<float>(maxCell[axis] - 1 + query.extent) + RAY_EPSILON;
+            float o = query.origin[axis];
+            float d = query.direction[axis];
+            if (d == 0.0f) {
+                // A ray running along a shared face belongs to the voxel on
+                // its high side, as positions do
+                if (o < lo || o >= hi - 2.0f * RAY_EPSILON) {
+                    return false;
+                }
+                continue;
+            }
+            float inv = 1.0f / d;
+            float t0 = (lo - o) * inv;
+            float t1 = (hi - o) * inv;
+            if (t0 > t1) std::swap(t0, t1);
+            tEnter = std::max(tEnter, t0);
+            tExit = std::min(tExit, t1);
+            if (tEnter > tExit) {
+                return false;
+            }
+        }
+        return tExit >= 0.0f && std::max(tEnter, 0.0f) <= query.bestT;
+    }
+    
+    void raycastNode(OctreeNode* node, const Math::Vector3i& center, int halfSize, int depth,
+                     RayQuery& query) const {
+        if (depth >= m_maxDepth) {
+            if (!node->hasVoxel()) {
+                return;
+            }
+            Math::Vector3i voxelPos = node->getVoxelPos();
+            float tEnter, tExit;
+            if (intersectRay(query, voxelPos, voxelPos + Math::Vector3i(1, 1, 1), tEnter, tExit)) {
+                float t = tEnter >= 0.0f ? tEnter : tExit;
+                if (t < query.bestT || (!query.hit && t <= query.bestT)) {
+                    query.bestT = t;
+                    query.hitPos = voxelPos;
+                    query.hit = true;
+                }
+            }
+            return;
+        }
+        
+        // Child i covers [min, min + halfSize) with min on the low or high
+        // side of center per axis
+        std::array<std::pair<float, int>, 8> order;
+        int count = 0;
+        for (int i = 0; i < 8; ++i) {
+            if (!node->getChild(i)) {
+                continue;
+            }
+            Math::Vector3i childMin(
+                (i & 1) ? center.x : center.x - halfSize,
+                (i & 2) ? center.y : center.y - halfSize,
+                (i & 4) ? center.z : center.z - halfSize
+            );
+            Math::Vector3i childMax = childMin + Math::Vector3i(halfSize, halfSize, halfSize);
+            float tEnter, tExit;
+            if (intersectRay(query, childMin, childMax, tEnter, tExit)) {
+                order[count++] = {std::max(tEnter, 0.0f), i};
+            }
+        }
+        std::sort(order.begin(), order.begin() + count);
+        
+        for (int k = 0; k < count; ++k) {
+            // Grown boxes overlap, so a later child can still hold a nearer
+            // voxel; only stop once the entries pass the best hit
+            if (query.hit && order[k].first > query.bestT) {
+                break;
+            }
+            int i = order[k].second;
+            Math::Vector3i childCenter = OctreeNode::getChildCenter(center, i, halfSize / 2);
+            raycastNode(node->getChild(i), childCenter, halfSize / 2, depth + 1, query);
+        }
+    }
+
+    // Rays in structure-of-arrays form, one lane per ray
+    struct RayPacket {
+        alignas(32) float origin[3][RAY_PACKET_SIZE];
+        // On axes a ray runs parallel to the inverse is PARALLEL_INVERSE,
+        // which sends the slab to minus or plus infinity depending on whether
+        // the origin is inside it, and highInset gives the slab the half-open
+        // high side intersectRay uses
+        alignas(32) float inverse[3][RAY_PACKET_SIZE];
+        alignas(32) float highInset[3][RAY_PACKET_SIZE];
+        alignas(32) float bestT[RAY_PACKET_SIZE];
+        bool hit[RAY_PACKET_SIZE];
+        Math::Vector3i hitPos[RAY_PACKET_SIZE];
+        int extent;
+    };
+
+    static constexpr float PARALLEL_INVERSE = 1e30f;
+    static constexpr float RAY_MISS = std::numeric_limits<float>::max();
+
+    // Narrows each lane's [enter, exit] interval to one axis' slab
+    static void clipPacketSlab(const RayPacket& packet, int axis, float lo, float hi, float* enter, float* exit) {
+        const float* origin = packet.origin[axis];
+        const float* inverse = packet.inverse[axis];
+        const float* highInset = packet.highInset[axis];
+        for (int lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+            float t0 = (lo - origin[lane]) * inverse[lane];
+            float t1 = (hi - highInset[lane] - origin[lane]) * inverse[lane];
+            enter[lane] = std::max(enter[lane], std::min(t0, t1));
+            exit[lane] = std::min(exit[lane], std::max(t0, t1));
+        }
+    }
+
+    // intersectRay for every lane. Lanes are processed in straight-line
+    // loops with the axes unrolled, which the compiler turns into SIMD.
+    // Lanes that pass the test intersectRay applies get their entry and exit
+    // distances; the others get an entry of RAY_MISS. Returns the nearest
+    // entry clamped to the origin, or RAY_MISS if no lane hits.
+    static float intersectPacket(const RayPacket& packet, const Math::Vector3i& minCell, const Math::Vector3i& maxCell,
+                                 float* tEnter, float* tExit) {
+        // Work on locals so the compiler need not assume the outputs alias
+        // the packet
+        alignas(32) float enter[RAY_PACKET_SIZE];
+        alignas(32) float exit[RAY_PACKET_SIZE];
+        for (int lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+            enter[lane] = -RAY_MISS;
+            exit[lane] = RAY_MISS;
+        }
+        auto low = [&](int axis) { return static_cast<float>(minCell[axis]) - RAY_EPSILON; };
+        auto high = [&](int axis) { return static_cast<float>(maxCell[axis] - 1 + packet.extent) + RAY_EPSILON; };
+        clipPacketSlab(packet, 0, low(0), high(0), enter, exit);
+        clipPacketSlab(packet, 1, low(1), high(1), enter, exit);
+        clipPacketSlab(packet, 2, low(2), high(2), enter, exit);
+
+        float nearest = RAY_MISS;
+        for (int lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+            float entry = std::max(enter[lane], 0.0f);
+            bool hit = (enter[lane] <= exit[lane]) & (exit[lane] >= 0.0f) & (entry <= packet.bestT[lane]);
+            tEnter[lane] = hit ? enter[lane] : RAY_MISS;
+            tExit[lane] = exit[lane];
+            nearest = std::min(nearest, hit ? entry : RAY_MISS);
+        }
+        return nearest;
+    }
+
+    void raycastPacketNode(OctreeNode* node, const Math::Vector3i& center, int halfSize, int depth,
+                           RayPacket& packet) const {
+        alignas(32) float tEnter[RAY_PACKET_SIZE];
+        alignas(32) float tExit[RAY_PACKET_SIZE];
+
+        if (depth >= m_maxDepth) {
+            if (!node->hasVoxel()) {
+                return;
+            }
+            Math::Vector3i voxelPos = node->getVoxelPos();
+            if (intersectPacket(packet, voxelPos, voxelPos + Math::Vector3i(1, 1, 1), tEnter, tExit) == RAY_MISS) {
+                return;
+            }
+            for (int lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+                if (tEnter[lane] == RAY_MISS) {
+                    continue;
+                }
+                float t = tEnter[lane] >= 0.0f ? tEnter[lane] : tExit[lane];
+                if (t < packet.bestT[lane] || (!packet.hit[lane] && t <= packet.bestT[lane])) {
+                    packet.bestT[lane] = t;
+                    packet.hitPos[lane] = voxelPos;
+                    packet.hit[lane] = true;
+                }
+            }
+            return;
+        }
+
+        std::array<std::pair<float, int>, 8> order;
+        int count = 0;
+        for (int i = 0; i < 8; ++i) {
+            if (!node->getChild(i)) {
+                continue;
+            }
+            Math::Vector3i childMin(
+                (i & 1) ? center.x : center.x - halfSize,
+                (i & 2) ? center.y : center.y - halfSize,
+                (i & 4) ? center.z : center.z - halfSize
+            );
+            Math::Vector3i childMax = childMin + Math::Vector3i(halfSize, halfSize, halfSize);
+            float nearest = intersectPacket(packet, childMin, childMax, tEnter, tExit);
+            if (nearest != RAY_MISS) {
+                order[count++] = {nearest, i};
+            }
+        }
+        std::sort(order.begin(), order.begin() + count);
+
+        for (int k = 0; k < count; ++k) {
+            // Stop once no lane could still find a nearer voxel; children
+            // re-test each lane against its own best hit
+            float furthestBest = packet.bestT[0];
+            for (int lane = 1; lane < RAY_PACKET_SIZE; ++lane) {
+                furthestBest = std::max(furthestBest, packet.bestT[lane]);
+            }
+            if (order[k].first > furthestBest) {
+                break;
             }
+            int i = order[k].second;
+            Math::Vector3i childCenter = OctreeNode::getChildCenter(center, i, halfSize / 2);
+            raycastPacketNode(node->getChild(i), childCenter, halfSize / 2, depth + 1, packet);
         }
     }
     
@@ -0,0 +1,374 @@
+#include "VoxelConnectivity.h"
+#include <algorithm>
+#include <cmath>
+
+namespace VoxelEditor {
+namespace VoxelData {
+
+namespace {
+
+const Math::Vector3i FACE_OFFSETS[6] = {
+    Math::Vector3i(1, 0, 0), Math::Vector3i(-1, 0, 0),
+    Math::Vector3i(0, 1, 0), Math::Vector3i(0, -1, 0),
+    Math::Vector3i(0, 0, 1), Math::Vector3i(0, 0, -1)
+};
+
+constexpr uint32_t NO_LABEL = UINT32_MAX;
+
+int floorDiv(int value, int divisor) {
+    int quotient = value / divisor;
+    return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+}
+
+}
+
+int VoxelConnectivity::voxelStep(VoxelResolution resolution) {
+    return static_cast<int>(std::lround(getVoxelSize(resolution) * 100.0f));
+}
+
+uint64_t VoxelConnectivity::brickKey(const Math::Vector3i& pos, VoxelResolution resolution) {
+    const int edge = BRICK_VOXELS * voxelStep(resolution);
+    const uint64_t mask = (1ull << 20) - 1;
+    return (static_cast<uint64_t>(resolution) << 60) |
+           ((static_cast<uint64_t>(floorDiv(pos.x, edge)) & mask) << 40) |
+           ((static_cast<uint64_t>(floorDiv(pos.y, edge)) & mask) << 20) |
+           (static_cast<uint64_t>(floorDiv(pos.z, edge)) & mask);
+}
+
+bool VoxelConnectivity::setVoxel(const Math::IncrementCoordinates& pos, VoxelResolution resolution, bool value) {
+    const Math::Vector3i& p = pos.value();
+    uint64_t key = brickKey(p, resolution);
+
+    if (value) {
+        Brick& brick = m_bricks[key];
+        auto inserted = brick.slots.emplace(p, static_cast<uint32_t>(brick.positions.size()));
+        if (!inserted.second) return false;
+        brick.resolution = resolution;
+        brick.positions.push_back(p);
+        brick.labels.push_back(NO_LABEL);
+        markDirty(key, brick);
+        ++m_voxelCount;
+        return true;
+    }
+
+    auto it = m_bricks.find(key);
+    if (it == m_bricks.end()) return false;
+    Brick& brick = it->second;
+    auto slot = brick.slots.find(p);
+    if (slot == brick.slots.end()) return false;
+
+    // Swap the last voxel into the freed slot
+    uint32_t index = slot->second;
+    brick.slots.erase(slot);
+    uint32_t last = static_cast<uint32_t>(brick.positions.size() - 1);
+    if (index != last) {
+        brick.positions[index] = brick.positions[last];
+        brick.labels[index] = brick.labels[last];
+        brick.slots[brick.positions[index]] = index;
+    }
+    brick.positions.pop_back();
+    brick.labels.pop_back();
+    --m_voxelCount;
+
+    // An emptied brick is dropped on the next refresh, once its islands
+    // have been released
+    markDirty(key, brick);
+    return true;
+}
+
+bool VoxelConnectivity::hasVoxel(const Math::IncrementCoordinates& pos, VoxelResolution resolution) const {
+    const Brick* brick = findBrick(pos.value(), resolution);
+    return brick && brick->slots.count(pos.value()) > 0;
+}
+
+void VoxelConnectivity::clear() {
+    m_bricks.clear();
+    m_dirtyBricks.clear();
+    m_voxelCount = 0;
+    m_components.clear();
+    m_lastJoinSize = 0;
+}
+
+void VoxelConnectivity::markDirty(uint64_t key, Brick& brick) {
+    if (!brick.dirty) {
+        brick.dirty = true;
+        m_dirtyBricks.push_back(key);
+    }
+}
+
+const VoxelConnectivity::Brick* VoxelConnectivity::findBrick(const Math::Vector3i& pos, VoxelResolution resolution) const {
+    auto it = m_bricks.find(brickKey(pos, resolution));
+    return it == m_bricks.end() ? nullptr : &it->second;
+}
+
+void VoxelConnectivity::refresh() const {
+    if (m_dirtyBricks.empty()) return;
+
+    JoinState state;
+    state.released.assign(m_components.size(), 0);
+
+    // Islands with a label in a dirty brick may have split; their labels
+    // in clean bricks are joined again from the stored links
+    for (uint64_t key : m_dirtyBricks) {
+        for (ComponentId component : m_bricks.at(key).labelComponent) {
+            releaseComponent(state, component, false);
+        }
+    }
+
+    for (uint64_t key : m_dirtyBricks) {
+        auto it = m_bricks.find(key);
+        Brick& brick = it->second;
+        if (brick.positions.empty()) {
+            m_bricks.erase(it);
+            continue;
+        }
+        relabel(key, brick);
+        state.bricks.push_back(&brick);
+        for (uint32_t label = 0; label < brick.labelSize.size(); ++label) {
+            addNode(state, key, brick, label);
+        }
+    }
+    m_dirtyBricks.clear();
+
+    join(state);
+}
+
+void VoxelConnectivity::relabel(uint64_t key, Brick& brick) const {
+    const int step = voxelStep(brick.resolution);
+    const size_t count = brick.positions.size();
+
+    brick.labels.assign(count, NO_LABEL);
+    brick.labelSize.clear();
+    brick.labelMinY.clear();
+    brick.links.clear();
+
+    std::vector<uint32_t> stack;
+    for (uint32_t start = 0; start < count; ++start) {
+        if (brick.labels[start] != NO_LABEL) continue;
+
+        uint32_t label = static_cast<uint32_t>(brick.labelSize.size());
+        brick.labelSize.push_back(0);
+        brick.labelMinY.push_back(INT_MAX);
+        brick.labels[start] = label;
+        stack.push_back(start);
+
+        while (!stack.empty()) {
+            uint32_t index = stack.back();
+            stack.pop_back();
+            const Math::Vector3i pos = brick.positions[index];
+            ++brick.labelSize[label];
+            brick.labelMinY[label] = std::min(brick.labelMinY[label], pos.y);
+
+            for (const auto& offset : FACE_OFFSETS) {
+                Math::Vector3i neighbor = pos + offset * step;
+                if (brickKey(neighbor, brick.resolution) == key) {
+                    auto slot = brick.slots.find(neighbor);
+                    if (slot != brick.slots.end() && brick.labels[slot->second] == NO_LABEL) {
+                        brick.labels[slot->second] = label;
+                        stack.push_back(slot->second);
+                    }
+                } else {
+                    const Brick* other = findBrick(neighbor, brick.resolution);
+                    if (other && other->slots.count(neighbor)) {
+                        brick.links.emplace_back(label, neighbor);
+                    }
+                }
+            }
+        }
+    }
+
+    brick.labelComponent.assign(brick.labelSize.size(), INVALID_COMPONENT);
+    brick.labelNode.assign(brick.labelSize.size(), NO_LABEL);
+    brick.dirty = false;
+}
+
+uint32_t VoxelConnectivity::findRoot(std::vector<uint32_t>& parent, uint32_t node) {
+    while (parent[node] != node) {
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+void VoxelConnectivity::unite(std::vector<uint32_t>& parent, uint32_t a, uint32_t b) {
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if (a != b) {
+        parent[std::max(a, b)] = std::min(a, b);
+    }
+}
+
+uint32_t VoxelConnectivity::addNode(JoinState& state, uint64_t key, Brick& brick, uint32_t label) {
+    uint32_t& node = brick.labelNode[label];
+    if (node == NO_LABEL) {
+        node = static_cast<uint32_t>(state.nodes.size());
+        state.nodes.push_back(JoinNode{key, &brick, label});
+        state.parent.push_back(node);
+    }
+    return node;
+}
+
+void VoxelConnectivity::releaseComponent(JoinState& state, ComponentId component, bool keepJoined) const {
+    if (component == INVALID_COMPONENT || state.released[component]) return;
+    state.released[component] = 1;
+    state.releasedIds.push_back(component);
+
+    // Labels in dirty bricks are replaced by the relabel. An island that is
+    // only being merged into another stays internally connected, so its
+    // labels are united directly instead of through their links.
+    uint32_t first = NO_LABEL;
+    for (const auto& part : m_components[component].parts) {
+        auto it = m_bricks.find(part.first);
+        if (it == m_bricks.end() || it->second.dirty) continue;
+
+        uint32_t node = addNode(state, part.first, it->second, part.second);
+        if (!keepJoined) {
+            state.bricks.push_back(&it->second);
+        } else if (first == NO_LABEL) {
+            first = node;
+        } else {
+            unite(state.parent, first, node);
+        }
+    }
+}
+
+void VoxelConnectivity::storeComponent(ComponentId id, Component&& component) const {
+    for (const auto& part : component.parts) {
+        m_bricks.at(part.first).labelComponent[part.second] = id;
+    }
+    m_components[id] = std::move(component);
+}
+
+void VoxelConnectivity::join(JoinState& state) const {
+    std::sort(state.bricks.begin(), state.bricks.end());
+    state.bricks.erase(std::unique(state.bricks.begin(), state.bricks.end()), state.bricks.end());
+
+    // Links are recorded from whichever side was labelled later, and every
+    // relabelled brick records all of its own, so following the links of
+    // the listed bricks is enough; links to voxels removed since are skipped
+    for (Brick* brick : state.bricks) {
+        for (const auto& link : brick->links) {
+            uint32_t node = brick->labelNode[link.first];
+            if (node == NO_LABEL) continue;
+
+            auto it = m_bricks.find(brickKey(link.second, brick->resolution));
+            if (it == m_bricks.end()) continue;
+            Brick& other = it->second;
+            auto slot = other.slots.find(link.second);
+            if (slot == other.slots.end()) continue;
+
+            uint32_t otherLabel = other.labels[slot->second];
+            if (other.labelNode[otherLabel] == NO_LABEL) {
+                // An untouched island that the edit now reaches
+                releaseComponent(state, other.labelComponent[otherLabel], true);
+            }
+            unite(state.parent, node, other.labelNode[otherLabel]);
+        }
+    }
+
+    std::vector<ComponentId> rootComponent(state.nodes.size(), INVALID_COMPONENT);
+    std::vector<Component> rebuilt;
+    for (uint32_t node = 0; node < state.nodes.size(); ++node) {
+        uint32_t root = findRoot(state.parent, node);
+        if (rootComponent[root] == INVALID_COMPONENT) {
+            rootComponent[root] = static_cast<ComponentId>(rebuilt.size());
+            rebuilt.emplace_back();
+        }
+
+        const JoinNode& joined = state.nodes[node];
+        Component& component = rebuilt[rootComponent[root]];
+        component.size += joined.brick->labelSize[joined.label];
+        component.minY = std::min(component.minY, joined.brick->labelMinY[joined.label]);
+        component.parts.emplace_back(joined.key, joined.label);
+        joined.brick->labelNode[joined.label] = NO_LABEL;
+    }
+    m_lastJoinSize = state.nodes.size();
+
+    // Rebuilt islands take over the released ids. Ids left over are
+    // filled from the back so that ids stay dense.
+    std::vector<ComponentId>& ids = state.releasedIds;
+    std::sort(ids.begin(), ids.end());
+    size_t reused = std::min(ids.size(), rebuilt.size());
+    for (size_t i = 0; i < reused; ++i) {
+        storeComponent(ids[i], std::move(rebuilt[i]));
+    }
+    for (size_t i = reused; i < rebuilt.size(); ++i) {
+        m_components.emplace_back();
+        storeComponent(static_cast<ComponentId>(m_components.size() - 1), std::move(rebuilt[i]));
+    }
+
+    std::vector<char> unused(m_components.size(), 0);
+    for (size_t i = reused; i < ids.size(); ++i) {
+        unused[ids[i]] = 1;
+    }
+    for (size_t i = reused; i < ids.size(); ++i) {
+        while (!m_components.empty() && unused[m_components.size() - 1]) {
+            m_components.pop_back();
+        }
+        if (ids[i] >= m_components.size()) break;
+        storeComponent(ids[i], std::move(m_components.back()));
+        m_components.pop_back();
+        unused[ids[i]] = 0;
+    }
+}
+
+VoxelConnectivity::ComponentId VoxelConnectivity::getComponent(const Math::IncrementCoordinates& pos,
+                                                               VoxelResolution resolution) const {
+    refresh();
+    const Brick* brick = findBrick(pos.value(), resolution);
+    if (!brick) return INVALID_COMPONENT;
+    auto slot = brick->slots.find(pos.value());
+    if (slot == brick->slots.end()) return INVALID_COMPONENT;
+    return brick->labelComponent[brick->labels[slot->second]];
+}
+
+size_t VoxelConnectivity::getComponentCount() const {
+    refresh();
+    return m_components.size();
+}
+
+size_t VoxelConnectivity::getComponentSize(ComponentId component) const {
+    refresh();
+    return component < m_components.size() ? m_components[component].size : 0;
+}
+
+bool VoxelConnectivity::isGrounded(ComponentId component) const {
+    refresh();
+    return component < m_components.size() && m_components[component].minY <= 0;
+}
+
+std::vector<VoxelPosition> VoxelConnectivity::getComponentVoxels(ComponentId component) const {
+    refresh();
+    std::vector<VoxelPosition> voxels;
+    if (component >= m_components.size()) return voxels;
+
+    voxels.reserve(m_components[component].size);
+    for (const auto& part : m_components[component].parts) {
+        const Brick& brick = m_bricks.at(part.first);
+        for (size_t i = 0; i < brick.positions.size(); ++i) {
+            if (brick.labels[i] == part.second) {
+                voxels.emplace_back(brick.positions[i], brick.resolution);
+            }
+        }
+    }
+    return voxels;
+}
+
+std::vector<std::vector<VoxelPosition>> VoxelConnectivity::getComponents() const {
+    refresh();
+    std::vector<std::vector<VoxelPosition>> components(m_components.size());
+    for (size_t i = 0; i < m_components.size(); ++i) {
+        components[i].reserve(m_components[i].size);
+    }
+    for (const auto& entry : m_bricks) {
+        const Brick& brick = entry.second;
+        for (size_t i = 0; i < brick.positions.size(); ++i) {
+            ComponentId id = brick.labelComponent[brick.labels[i]];
+            components[id].emplace_back(brick.positions[i], brick.resolution);
+        }
+    }
+    return components;
+}
+
+}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <climits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "VoxelTypes.h"
+#include "../../foundation/math/Vector3i.h"
+#include "../../foundation/math/CoordinateTypes.h"
+
+namespace VoxelEditor {
+namespace VoxelData {
+
+// Face-connected components ("islands") of occupied voxels. Two voxels of
+// the same resolution are connected when one sits exactly one voxel size
+// from the other along a single axis.
+//
+// Space is split per resolution into bricks of 8x8x8 voxel sizes. Each
+// brick labels its own voxels with a local flood fill and records which
+// of them face a voxel in another brick. An edit only marks its brick
+// dirty; the next query relabels the dirty bricks and re-joins local
+// labels across brick faces with a union-find over labels, not voxels.
+// Only components with a label in a dirty brick are re-joined, plus any
+// component a relabelled brick now touches, so the cost of a query after
+// an edit follows the size of the islands it touched, not the scene.
+// Lookups after that are a couple of hash probes.
+//
+// Not thread-safe; the owner serialises access. Queries are const but
+// refresh the lazily maintained labels.
+class VoxelConnectivity {
+public:
+    using ComponentId = uint32_t;
+    static constexpr ComponentId INVALID_COMPONENT = UINT32_MAX;
+    static constexpr int BRICK_VOXELS = 8;
+
+    // Returns whether the set changed
+    bool setVoxel(const Math::IncrementCoordinates& pos, VoxelResolution resolution, bool value);
+    bool hasVoxel(const Math::IncrementCoordinates& pos, VoxelResolution resolution) const;
+    void clear();
+
+    size_t getVoxelCount() const { return m_voxelCount; }
+    size_t getBrickCount() const { return m_bricks.size(); }
+    size_t getDirtyBrickCount() const { return m_dirtyBricks.size(); }
+    // Brick labels re-joined by the last refresh
+    size_t getLastJoinSize() const { return m_lastJoinSize; }
+
+    // Component ids are dense and stay valid until the next edit
+    ComponentId getComponent(const Math::IncrementCoordinates& pos, VoxelResolution resolution) const;
+    size_t getComponentCount() const;
+    size_t getComponentSize(ComponentId component) const;
+    // Whether any voxel of the component rests on the ground plane (y == 0)
+    bool isGrounded(ComponentId component) const;
+    std::vector<VoxelPosition> getComponentVoxels(ComponentId component) const;
+    std::vector<std::vector<VoxelPosition>> getComponents() const;
+
+    // One voxel size in increments
+    static int voxelStep(VoxelResolution resolution);
+
+private:
+    struct Brick {
+        VoxelResolution resolution = VoxelResolution::Size_1cm;
+        std::unordered_map<Math::Vector3i, uint32_t> slots;  // Position -> index
+        std::vector<Math::Vector3i> positions;
+        std::vector<uint32_t> labels;       // Local label per voxel
+        std::vector<uint32_t> labelSize;
+        std::vector<int> labelMinY;
+        std::vector<std::pair<uint32_t, Math::Vector3i>> links;  // Label, voxel across a brick face
+        std::vector<uint32_t> labelComponent;
+        std::vector<uint32_t> labelNode;    // Union-find node while joining, unset otherwise
+        bool dirty = false;
+    };
+
+    struct JoinNode {
+        uint64_t key;
+        Brick* brick;
+        uint32_t label;
+    };
+
+    // Scratch state of one join
+    struct JoinState {
+        std::vector<JoinNode> nodes;
+        std::vector<uint32_t> parent;
+        std::vector<Brick*> bricks;                      // Bricks whose links are followed
+        std::vector<char> released;                      // Per component id
+        std::vector<ComponentId> releasedIds;
+    };
+
+    struct Component {
+        size_t size = 0;
+        int minY = INT_MAX;
+        std::vector<std::pair<uint64_t, uint32_t>> parts;  // Brick key, local label
+    };
+
+    static uint64_t brickKey(const Math::Vector3i& pos, VoxelResolution resolution);
+
+    const Brick* findBrick(const Math::Vector3i& pos, VoxelResolution resolution) const;
+    void markDirty(uint64_t key, Brick& brick);
+    void refresh() const;
+    void relabel(uint64_t key, Brick& brick) const;
+    void join(JoinState& state) const;
+    void releaseComponent(JoinState& state, ComponentId component, bool keepJoined) const;
+    static uint32_t addNode(JoinState& state, uint64_t key, Brick& brick, uint32_t label);
+    void storeComponent(ComponentId id, Component&& component) const;
+    static uint32_t findRoot(std::vector<uint32_t>& parent, uint32_t node);
+    static void unite(std::vector<uint32_t>& parent, uint32_t a, uint32_t b);
+
+    mutable std::unordered_map<uint64_t, Brick> m_bricks;
+    mutable std::vector<uint64_t> m_dirtyBricks;
+    size_t m_voxelCount = 0;
+    mutable std::vector<Component> m_components;
+    mutable size_t m_lastJoinSize = 0;
+};
+
+}
+}
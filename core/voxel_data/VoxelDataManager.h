@@ -1,11 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <climits>
 #include <memory>
 #include <mutex>
 #include <vector>
 #include <cmath>
 #include <sstream>
+#include <unordered_map>
 
 #include "VoxelTypes.h"
 #include "VoxelGrid.h"
@@ -14,6 +17,7 @@
 #include "../../foundation/events/CommonEvents.h"
 #include "../../foundation/math/BoundingBox.h"
 #include "../input/PlacementValidation.h"
+#include "../../foundation/logging/PerformanceProfiler.h"
 
 namespace VoxelEditor {
 namespace VoxelData {
@@ -103,6 +107,10 @@ public:
     }
     
     ~VoxelDataManager() {
+        // Grids hand their nodes back to the pool, so they go first
+        for (auto& grid : m_grids) {
+            grid.reset();
+        }
         SparseOctree::shutdownPool();
     }
     
@@ -358,6 +366,7 @@ public:
     
     // Bulk operations
     void clearAll() {
+        PROFILE_SCOPE("VoxelDataManager::clearAll");
         std::lock_guard<std::mutex> lock(m_mutex);
         
         for (auto& grid : m_grids) {
@@ -436,6 +445,7 @@ public:
     }
     
     void optimizeMemory() {
+        PROFILE_SCOPE("VoxelDataManager::optimizeMemory");
         std::lock_guard<std::mutex> lock(m_mutex);
         
         for (auto& grid : m_grids) {
@@ -481,6 +491,104 @@ public:
         return getAllVoxels(getActiveResolution());
     }
     
+    // Visit every voxel of one resolution under the manager lock. The
+    // visitor must not call back into the manager.
+    template<typename Visitor>
+    void forEachVoxel(VoxelResolution resolution, Visitor&& visit) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        
+        const VoxelGrid* grid = getGrid(resolution);
+        if (grid) {
+            grid->forEachVoxel(visit);
+        }
+    }
+    
+    // Voxels of one resolution whose positions lie in an inclusive increment
+    // range; walks only the octree branches that overlap the range
+    std::vector<VoxelPosition> getVoxelsInRange(VoxelResolution resolution,
+                                                const Math::IncrementCoordinates& minPos,
+                                                const Math::IncrementCoordinates& maxPos) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        
+        const VoxelGrid* grid = getGrid(resolution);
+        if (!grid) return {};
+        
+        return grid->getVoxelsInRange(minPos, maxPos);
+    }
+
+    // Face-connected islands. The first query on a resolution labels its
+    // grid; later edits only relabel the bricks they touch.
+    std::vector<VoxelPosition> getConnectedVoxels(const Math::IncrementCoordinates& pos,
+                                                  VoxelResolution resolution) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const VoxelGrid* grid = getGrid(resolution);
+        if (!grid) return {};
+
+        const VoxelConnectivity& connectivity = grid->getConnectivity();
+        return connectivity.getComponentVoxels(connectivity.getComponent(pos, resolution));
+    }
+
+    bool isConnectedToGround(const Math::IncrementCoordinates& pos, VoxelResolution resolution) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const VoxelGrid* grid = getGrid(resolution);
+        if (!grid) return false;
+
+        const VoxelConnectivity& connectivity = grid->getConnectivity();
+        return connectivity.isGrounded(connectivity.getComponent(pos, resolution));
+    }
+
+    size_t getIslandCount(VoxelResolution resolution) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const VoxelGrid* grid = getGrid(resolution);
+        if (!grid) return 0;
+
+        return grid->getConnectivity().getComponentCount();
+    }
+
+    // Height queries for placement. The first query on a resolution indexes
+    // its grid by XZ column and bottom height; later edits keep it current.
+    bool findHighestVoxelAt(VoxelResolution resolution, int x, int z, Math::IncrementCoordinates& result) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const VoxelGrid* grid = getGrid(resolution);
+        if (!grid || grid->getVoxelCount() == 0) return false;
+
+        return grid->getHeightIndex().findHighestAt(x, z, result);
+    }
+
+    bool findHighestVoxelInRadius(VoxelResolution resolution, int x, int z, int radius,
+                                  Math::IncrementCoordinates& result) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const VoxelGrid* grid = getGrid(resolution);
+        if (!grid || grid->getVoxelCount() == 0) return false;
+
+        return grid->getHeightIndex().findHighestInRadius(x, z, radius, result);
+    }
+
+    // Voxels whose bottom lies in [minY, maxY]; only occupied layers are
+    // read, each with a slab query on the octree
+    std::vector<VoxelPosition> getVoxelsWithBottomIn(VoxelResolution resolution, int minY, int maxY) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const VoxelGrid* grid = getGrid(resolution);
+        if (!grid || grid->getVoxelCount() == 0) return {};
+
+        std::vector<VoxelPosition> voxels;
+        Math::Vector3f workspaceSize = grid->getWorkspaceSize();
+        int halfX = static_cast<int>(std::ceil(workspaceSize.x * 50.0f));
+        int halfZ = static_cast<int>(std::ceil(workspaceSize.z * 50.0f));
+        for (int y : grid->getHeightIndex().getLayers(minY, maxY)) {
+            auto layer = grid->getVoxelsInRange(Math::IncrementCoordinates(-halfX, y, -halfZ),
+                                                Math::IncrementCoordinates(halfX, y, halfZ));
+            voxels.insert(voxels.end(), layer.begin(), layer.end());
+        }
+        return voxels;
+    }
+
     // Enhancement: 1cm increment validation
     bool isValidIncrementPosition(const Math::IncrementCoordinates& pos) const {
         // All integer positions are valid 1cm increments since our base unit is 1cm
@@ -623,11 +731,15 @@ public:
     }
     
     // Region operations API
+    // If appliedChanges is given, every voxel the fill actually modified is
+    // appended to it (used by undo to record a sparse delta)
     FillResult fillRegion(const Math::BoundingBox& region,
                          VoxelResolution resolution,
-                         bool fillValue = true) {
+                         bool fillValue = true,
+                         std::vector<VoxelChange>* appliedChanges = nullptr) {
+        PROFILE_SCOPE("VoxelDataManager::fillRegion");
         std::lock_guard<std::mutex> lock(m_mutex);
-        return fillRegionInternal(region, resolution, fillValue);
+        return fillRegionInternal(region, resolution, fillValue, appliedChanges);
     }
     
     bool canFillRegion(const Math::BoundingBox& region,
@@ -643,23 +755,35 @@ public:
     
     RegionQuery queryRegion(const Math::BoundingBox& region,
                            bool includeVoxelList = false) const {
+        PROFILE_SCOPE("VoxelDataManager::queryRegion");
         std::lock_guard<std::mutex> lock(m_mutex);
         return queryRegionInternal(region, includeVoxelList);
     }
     
     std::vector<VoxelPosition> getVoxelsInRegion(const Math::BoundingBox& region) const {
+        PROFILE_SCOPE("VoxelDataManager::getVoxelsInRegion");
         std::lock_guard<std::mutex> lock(m_mutex);
         return getVoxelsInRegionInternal(region);
     }
     
+    // Voxels of one resolution whose bounds intersect the region
+    std::vector<VoxelPosition> getVoxelsInRegion(const Math::BoundingBox& region,
+                                                 VoxelResolution resolution) const {
+        PROFILE_SCOPE("VoxelDataManager::getVoxelsInRegion");
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return getVoxelsInRegionInternal(region, resolution);
+    }
+    
     // Batch operations API
     BatchResult batchSetVoxels(const std::vector<VoxelChange>& changes) {
+        PROFILE_SCOPE("VoxelDataManager::batchSetVoxels");
         std::lock_guard<std::mutex> lock(m_mutex);
         return batchSetVoxelsInternal(changes);
     }
     
     bool batchValidate(const std::vector<VoxelChange>& changes,
                       std::vector<PositionValidation>& validationResults) const {
+        PROFILE_SCOPE("VoxelDataManager::batchValidate");
         std::lock_guard<std::mutex> lock(m_mutex);
         return batchValidateInternal(changes, validationResults);
     }
@@ -673,6 +797,18 @@ public:
         return createBatchChangesInternal(positions, resolution, newValue);
     }
     
+    // Removes and places voxels as one edit, for bulk moves. Placements are
+    // checked against the scene as it will be once the removals are gone:
+    // bounds once per resolution from the footprint's extremes, overlap in
+    // one pass over the existing voxels inside the footprint. Voxels both
+    // removed and placed are left untouched. Nothing changes unless every
+    // placement is valid.
+    BatchResult replaceVoxels(const std::vector<VoxelPosition>& removals,
+                              const std::vector<VoxelPosition>& placements) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return replaceVoxelsInternal(removals, placements);
+    }
+    
     // Performance metrics
     struct PerformanceMetrics {
         size_t totalVoxels;
@@ -939,7 +1075,8 @@ private:
     // Internal region operation methods (must be called with lock already held)
     FillResult fillRegionInternal(const Math::BoundingBox& region,
                                  VoxelResolution resolution,
-                                 bool fillValue) {
+                                 bool fillValue,
+                                 std::vector<VoxelChange>* appliedChanges = nullptr) {
         FillResult result;
         
         // Convert world bounds to increment coordinates
@@ -1009,6 +1146,9 @@ private:
                     // Set the voxel using direct grid access
                     if (grid->setVoxel(pos, fillValue)) {
                         result.voxelsFilled++;
+                        if (appliedChanges) {
+                            appliedChanges->emplace_back(pos, resolution, currentValue, fillValue);
+                        }
                         // Dispatch event manually since we're bypassing the public setVoxel
                         dispatchVoxelChangedEvent(pos, resolution, currentValue, fillValue);
                     } else {
@@ -1078,16 +1218,8 @@ private:
             const VoxelGrid* grid = getGrid(res);
             if (!grid || grid->getVoxelCount() == 0) continue;
             
-            // Get all voxels and check if any are in the region
-            auto voxels = grid->getAllVoxels();
-            for (const auto& voxel : voxels) {
-                Math::Vector3f voxelMin, voxelMax;
-                voxel.getWorldBounds(voxelMin, voxelMax);
-                
-                // Check AABB intersection
-                if (region.intersects(Math::BoundingBox(voxelMin, voxelMax))) {
-                    return false;  // Found a voxel in the region
-                }
+            if (!getVoxelsInRegionInternal(region, res).empty()) {
+                return false;  // Found a voxel in the region
             }
         }
         
@@ -1106,30 +1238,26 @@ private:
             const VoxelGrid* grid = getGrid(res);
             if (!grid || grid->getVoxelCount() == 0) continue;
             
-            // Get all voxels and check if they're in the region
-            auto voxels = grid->getAllVoxels();
+            auto voxels = getVoxelsInRegionInternal(region, res);
             for (const auto& voxel : voxels) {
                 Math::Vector3f voxelMin, voxelMax;
                 voxel.getWorldBounds(voxelMin, voxelMax);
                 Math::BoundingBox voxelBounds(voxelMin, voxelMax);
                 
-                // Check if voxel intersects the query region
-                if (region.intersects(voxelBounds)) {
-                    query.voxelCount++;
-                    query.isEmpty = false;
-                    
-                    // Update actual bounds
-                    if (firstVoxel) {
-                        query.actualBounds = voxelBounds;
-                        firstVoxel = false;
-                    } else {
-                        query.actualBounds.expandToInclude(voxelBounds);
-                    }
-                    
-                    // Add to voxel list if requested
-                    if (includeVoxelList) {
-                        query.voxels.push_back(voxel);
-                    }
+                query.voxelCount++;
+                query.isEmpty = false;
+                
+                // Update actual bounds
+                if (firstVoxel) {
+                    query.actualBounds = voxelBounds;
+                    firstVoxel = false;
+                } else {
+                    query.actualBounds.expandToInclude(voxelBounds);
+                }
+                
+                // Add to voxel list if requested
+                if (includeVoxelList) {
+                    query.voxels.push_back(voxel);
                 }
             }
         }
@@ -1142,6 +1270,45 @@ private:
         return query.voxels;
     }
     
+    std::vector<VoxelPosition> getVoxelsInRegionInternal(const Math::BoundingBox& region,
+                                                         VoxelResolution resolution) const {
+        std::vector<VoxelPosition> result;
+        const VoxelGrid* grid = getGrid(resolution);
+        if (!grid || grid->getVoxelCount() == 0) return result;
+        
+        // Positions are bottom-center, so a voxel reaches half its size
+        // sideways and its full size upwards. Widen the region by that much
+        // (plus a centimeter for rounding), clamp it to the workspace and ask
+        // the octree for the positions in between.
+        float voxelSize = getVoxelSize(resolution);
+        float margin = voxelSize + 0.01f;
+        Math::Vector3f workspaceSize = m_workspaceManager->getSize();
+        Math::Vector3f workspaceMin(-workspaceSize.x / 2.0f, 0.0f, -workspaceSize.z / 2.0f);
+        Math::Vector3f workspaceMax(workspaceSize.x / 2.0f, workspaceSize.y, workspaceSize.z / 2.0f);
+        Math::Vector3f searchMin = Math::Vector3f::max(region.min - Math::Vector3f(margin), workspaceMin);
+        Math::Vector3f searchMax = Math::Vector3f::min(region.max + Math::Vector3f(margin), workspaceMax);
+        if (searchMin.x > searchMax.x || searchMin.y > searchMax.y || searchMin.z > searchMax.z) {
+            return result;
+        }
+        
+        Math::IncrementCoordinates minPos(static_cast<int>(std::floor(searchMin.x * 100.0f)),
+                                          static_cast<int>(std::floor(searchMin.y * 100.0f)),
+                                          static_cast<int>(std::floor(searchMin.z * 100.0f)));
+        Math::IncrementCoordinates maxPos(static_cast<int>(std::ceil(searchMax.x * 100.0f)),
+                                          static_cast<int>(std::ceil(searchMax.y * 100.0f)),
+                                          static_cast<int>(std::ceil(searchMax.z * 100.0f)));
+        
+        for (const auto& voxel : grid->getVoxelsInRange(minPos, maxPos)) {
+            Math::Vector3f voxelMin, voxelMax;
+            voxel.getWorldBounds(voxelMin, voxelMax);
+            if (region.intersects(Math::BoundingBox(voxelMin, voxelMax))) {
+                result.push_back(voxel);
+            }
+        }
+        
+        return result;
+    }
+    
     // Internal batch operation methods (must be called with lock already held)
     BatchResult batchSetVoxelsInternal(const std::vector<VoxelChange>& changes) {
         BatchResult result;
@@ -1276,6 +1443,262 @@ private:
         
         return changes;
     }
+    
+    // Sortable key for one voxel; 20 bits per axis covers any workspace
+    static uint64_t packVoxelKey(const Math::IncrementCoordinates& pos, VoxelResolution resolution) {
+        const int bias = 1 << 19;
+        const uint64_t mask = (1ull << 20) - 1;
+        return (static_cast<uint64_t>(resolution) << 60) |
+               ((static_cast<uint64_t>(pos.x() + bias) & mask) << 40) |
+               ((static_cast<uint64_t>(pos.y() + bias) & mask) << 20) |
+               (static_cast<uint64_t>(pos.z() + bias) & mask);
+    }
+    
+    static int floorDiv(int value, int divisor) {
+        int quotient = value / divisor;
+        return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+    }
+    
+    BatchResult replaceVoxelsInternal(const std::vector<VoxelPosition>& removals,
+                                      const std::vector<VoxelPosition>& placements) {
+        BatchResult result;
+        result.totalOperations = removals.size() + placements.size();
+        
+        // Sorted keys turn membership into a binary search instead of a
+        // hash insert per voxel
+        std::vector<uint64_t> removedKeys;
+        removedKeys.reserve(removals.size());
+        for (const auto& voxel : removals) {
+            removedKeys.push_back(packVoxelKey(voxel.incrementPos, voxel.resolution));
+        }
+        std::sort(removedKeys.begin(), removedKeys.end());
+        
+        std::vector<uint64_t> placedKeys;
+        placedKeys.reserve(placements.size());
+        for (const auto& voxel : placements) {
+            placedKeys.push_back(packVoxelKey(voxel.incrementPos, voxel.resolution));
+        }
+        std::sort(placedKeys.begin(), placedKeys.end());
+        
+        auto isRemoved = [&removedKeys](const VoxelPosition& voxel) {
+            return std::binary_search(removedKeys.begin(), removedKeys.end(),
+                                      packVoxelKey(voxel.incrementPos, voxel.resolution));
+        };
+        auto isPlaced = [&placedKeys](const VoxelPosition& voxel) {
+            return std::binary_search(placedKeys.begin(), placedKeys.end(),
+                                      packVoxelKey(voxel.incrementPos, voxel.resolution));
+        };
+        
+        if (!placements.empty()) {
+            // Bounds: the workspace is a box, so the lowest and highest
+            // placement of each resolution stand in for all of them
+            constexpr size_t RESOLUTIONS = static_cast<size_t>(VoxelResolution::COUNT);
+            std::array<bool, RESOLUTIONS> present{};
+            std::array<Math::Vector3i, RESOLUTIONS> lowest;
+            std::array<Math::Vector3i, RESOLUTIONS> highest;
+            for (const auto& voxel : placements) {
+                size_t index = static_cast<size_t>(voxel.resolution);
+                const Math::Vector3i& pos = voxel.incrementPos.value();
+                if (!present[index]) {
+                    present[index] = true;
+                    lowest[index] = highest[index] = pos;
+                } else {
+                    lowest[index] = Math::Vector3i::min(lowest[index], pos);
+                    highest[index] = Math::Vector3i::max(highest[index], pos);
+                }
+            }
+            
+            // Footprint of all placements, in half increments so that voxel
+            // half sizes stay integral
+            Math::Vector3i footprintMin(INT_MAX, INT_MAX, INT_MAX);
+            Math::Vector3i footprintMax(INT_MIN, INT_MIN, INT_MIN);
+            int largestSize = 0;
+            for (size_t index = 0; index < RESOLUTIONS; ++index) {
+                if (!present[index]) continue;
+                VoxelResolution resolution = static_cast<VoxelResolution>(index);
+                for (const auto& corner : {lowest[index], highest[index]}) {
+                    auto validation = validatePositionInternal(Math::IncrementCoordinates(corner), resolution, false);
+                    if (!validation.valid) {
+                        result.failedOperations = 1;
+                        result.errorMessage = validation.errorMessage;
+                        return result;
+                    }
+                }
+                
+                int size = VoxelConnectivity::voxelStep(resolution);
+                largestSize = std::max(largestSize, size);
+                footprintMin = Math::Vector3i::min(footprintMin,
+                    Math::Vector3i(2 * lowest[index].x - size, 2 * lowest[index].y, 2 * lowest[index].z - size));
+                footprintMax = Math::Vector3i::max(footprintMax,
+                    Math::Vector3i(2 * highest[index].x + size, 2 * highest[index].y + 2 * size, 2 * highest[index].z + size));
+            }
+            
+            // Overlap: placements bucketed on a grid of the largest voxel
+            // size, built only once a surviving voxel lies in the footprint
+            const int cellSize = 2 * largestSize;
+            std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+            auto cellKey = [](int x, int y, int z) {
+                const uint64_t mask = (1ull << 21) - 1;
+                return ((static_cast<uint64_t>(x) & mask) << 42) |
+                       ((static_cast<uint64_t>(y) & mask) << 21) |
+                       (static_cast<uint64_t>(z) & mask);
+            };
+            auto placementMin = [&placements](uint32_t i) {
+                const Math::Vector3i& pos = placements[i].incrementPos.value();
+                int size = VoxelConnectivity::voxelStep(placements[i].resolution);
+                return Math::Vector3i(2 * pos.x - size, 2 * pos.y, 2 * pos.z - size);
+            };
+            auto overlapsPlacement = [&](uint32_t i, const Math::Vector3i& otherMin, const Math::Vector3i& otherMax) {
+                Math::Vector3i min = placementMin(i);
+                int size = 2 * VoxelConnectivity::voxelStep(placements[i].resolution);
+                return min.x < otherMax.x && min.x + size > otherMin.x &&
+                       min.y < otherMax.y && min.y + size > otherMin.y &&
+                       min.z < otherMax.z && min.z + size > otherMin.z;
+            };
+            
+            // Placements must not overlap each other. Each resolution is
+            // bucketed on a grid of its own voxel size, and every placement
+            // looks only at buckets of its own or a larger size, so a lookup
+            // covers at most 3x3x3 cells and each pair is seen from the
+            // smaller voxel
+            std::array<std::vector<std::pair<uint64_t, uint32_t>>, RESOLUTIONS> buckets;
+            for (uint32_t i = 0; i < placements.size(); ++i) {
+                size_t index = static_cast<size_t>(placements[i].resolution);
+                int bucketSize = 2 * VoxelConnectivity::voxelStep(placements[i].resolution);
+                Math::Vector3i min = placementMin(i);
+                buckets[index].emplace_back(cellKey(floorDiv(min.x, bucketSize), floorDiv(min.y, bucketSize),
+                                                    floorDiv(min.z, bucketSize)), i);
+            }
+            for (auto& bucket : buckets) {
+                std::sort(bucket.begin(), bucket.end());
+            }
+            
+            for (uint32_t i = 0; i < placements.size(); ++i) {
+                int size = 2 * VoxelConnectivity::voxelStep(placements[i].resolution);
+                Math::Vector3i min = placementMin(i);
+                Math::Vector3i max(min.x + size, min.y + size, min.z + size);
+                
+                bool overlaps = false;
+                for (size_t index = static_cast<size_t>(placements[i].resolution);
+                     index < RESOLUTIONS && !overlaps; ++index) {
+                    if (buckets[index].empty()) continue;
+                    int bucketSize = 2 * VoxelConnectivity::voxelStep(static_cast<VoxelResolution>(index));
+                    for (int cx = floorDiv(min.x - bucketSize + 1, bucketSize);
+                         cx <= floorDiv(max.x - 1, bucketSize) && !overlaps; ++cx) {
+                        for (int cy = floorDiv(min.y - bucketSize + 1, bucketSize);
+                             cy <= floorDiv(max.y - 1, bucketSize) && !overlaps; ++cy) {
+                            for (int cz = floorDiv(min.z - bucketSize + 1, bucketSize);
+                                 cz <= floorDiv(max.z - 1, bucketSize) && !overlaps; ++cz) {
+                                auto range = std::equal_range(buckets[index].begin(), buckets[index].end(),
+                                    std::make_pair(cellKey(cx, cy, cz), 0u),
+                                    [](const auto& a, const auto& b) { return a.first < b.first; });
+                                for (auto it = range.first; it != range.second && !overlaps; ++it) {
+                                    overlaps = it->second != i && overlapsPlacement(it->second, min, max);
+                                }
+                            }
+                        }
+                    }
+                }
+                
+                if (overlaps) {
+                    result.failedOperations = 1;
+                    result.errorMessage = "Placements overlap each other";
+                    return result;
+                }
+            }
+            
+            for (size_t index = 0; index < RESOLUTIONS; ++index) {
+                const VoxelGrid* grid = m_grids[index].get();
+                if (!grid || grid->isEmpty()) continue;
+                int size = VoxelConnectivity::voxelStep(static_cast<VoxelResolution>(index));
+                
+                // Positions whose extent could reach into the footprint
+                Math::IncrementCoordinates rangeMin(floorDiv(footprintMin.x - size, 2),
+                                                    floorDiv(footprintMin.y, 2) - size,
+                                                    floorDiv(footprintMin.z - size, 2));
+                Math::IncrementCoordinates rangeMax((footprintMax.x + size) / 2 + 1,
+                                                    footprintMax.y / 2 + 1,
+                                                    (footprintMax.z + size) / 2 + 1);
+                
+                for (const auto& existing : grid->getVoxelsInRange(rangeMin, rangeMax)) {
+                    if (isRemoved(existing)) continue;
+                    
+                    const Math::Vector3i& pos = existing.incrementPos.value();
+                    Math::Vector3i existingMin(2 * pos.x - size, 2 * pos.y, 2 * pos.z - size);
+                    Math::Vector3i existingMax(2 * pos.x + size, 2 * pos.y + 2 * size, 2 * pos.z + size);
+                    
+                    if (cells.empty()) {
+                        cells.reserve(placements.size());
+                        for (uint32_t i = 0; i < placements.size(); ++i) {
+                            Math::Vector3i min = placementMin(i);
+                            cells[cellKey(floorDiv(min.x, cellSize), floorDiv(min.y, cellSize),
+                                          floorDiv(min.z, cellSize))].push_back(i);
+                        }
+                    }
+                    
+                    // Any placement overlapping this voxel has its lower
+                    // corner within one cell below the voxel's extent
+                    Math::Vector3i cellMin(floorDiv(existingMin.x - cellSize + 1, cellSize),
+                                           floorDiv(existingMin.y - cellSize + 1, cellSize),
+                                           floorDiv(existingMin.z - cellSize + 1, cellSize));
+                    Math::Vector3i cellMax(floorDiv(existingMax.x - 1, cellSize),
+                                           floorDiv(existingMax.y - 1, cellSize),
+                                           floorDiv(existingMax.z - 1, cellSize));
+                    uint64_t cellCount = static_cast<uint64_t>(cellMax.x - cellMin.x + 1) *
+                                         (cellMax.y - cellMin.y + 1) * (cellMax.z - cellMin.z + 1);
+                    
+                    bool overlaps = false;
+                    if (cellCount > placements.size()) {
+                        for (uint32_t i = 0; i < placements.size() && !overlaps; ++i) {
+                            overlaps = overlapsPlacement(i, existingMin, existingMax);
+                        }
+                    } else {
+                        for (int cx = cellMin.x; cx <= cellMax.x && !overlaps; ++cx) {
+                            for (int cy = cellMin.y; cy <= cellMax.y && !overlaps; ++cy) {
+                                for (int cz = cellMin.z; cz <= cellMax.z && !overlaps; ++cz) {
+                                    auto cell = cells.find(cellKey(cx, cy, cz));
+                                    if (cell == cells.end()) continue;
+                                    for (uint32_t i : cell->second) {
+                                        if (overlapsPlacement(i, existingMin, existingMax)) {
+                                            overlaps = true;
+                                            break;
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                    
+                    if (overlaps) {
+                        result.failedOperations = 1;
+                        result.errorMessage = "Position would overlap with existing voxel";
+                        return result;
+                    }
+                }
+            }
+        }
+        
+        // Apply: voxels that are both removed and placed stay as they are
+        for (const auto& voxel : removals) {
+            if (isPlaced(voxel)) continue;
+            VoxelGrid* grid = getGrid(voxel.resolution);
+            if (grid && grid->getVoxel(voxel.incrementPos) && grid->setVoxel(voxel.incrementPos, false)) {
+                dispatchVoxelChangedEvent(voxel.incrementPos, voxel.resolution, true, false);
+            }
+        }
+        for (const auto& voxel : placements) {
+            VoxelGrid* grid = getGrid(voxel.resolution);
+            if (!grid) continue;
+            if (isRemoved(voxel) && grid->getVoxel(voxel.incrementPos)) continue;
+            if (grid->setVoxel(voxel.incrementPos, true)) {
+                dispatchVoxelChangedEvent(voxel.incrementPos, voxel.resolution, false, true);
+            }
+        }
+        
+        result.successfulOperations = result.totalOperations;
+        result.success = true;
+        return result;
+    }
 };
 
 }
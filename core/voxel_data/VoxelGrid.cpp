@@ -27,5 +27,25 @@ bool VoxelGrid::isInsideVoxel(const Math::IncrementCoordinates& pos) const {
     return false;
 }
 
+const VoxelConnectivity& VoxelGrid::getConnectivity() const {
+    if (!m_connectivity) {
+        m_connectivity = std::make_unique<VoxelConnectivity>();
+        for (const auto& voxel : getAllVoxels()) {
+            m_connectivity->setVoxel(voxel.incrementPos, m_resolution, true);
+        }
+    }
+    return *m_connectivity;
+}
+
+const VoxelHeightIndex& VoxelGrid::getHeightIndex() const {
+    if (!m_heights) {
+        m_heights = std::make_unique<VoxelHeightIndex>(m_resolution);
+        for (const auto& voxel : getAllVoxels()) {
+            m_heights->addVoxel(voxel.incrementPos);
+        }
+    }
+    return *m_heights;
+}
+
+}
 }
-}
\ No newline at end of file
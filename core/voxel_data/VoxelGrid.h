@@ -5,6 +5,8 @@
 #include <algorithm>
 #include "VoxelTypes.h"
 #include "SparseOctree.h"
+#include "VoxelConnectivity.h"
+#include "VoxelHeightIndex.h"
 #include "../../foundation/math/Vector3i.h"
 #include "../../foundation/math/Vector3f.h"
 #include "../../foundation/math/BoundingBox.h"
@@ -67,7 +69,16 @@ public:
         // Convert increment coordinates to grid coordinates for octree storage
         Math::Vector3i gridPos = incrementToGrid(pos);
         bool success = m_octree->setVoxel(gridPos, value);
-        
+        if (success && m_connectivity) {
+            m_connectivity->setVoxel(pos, m_resolution, value);
+        }
+        if (success && m_heights) {
+            if (value) {
+                m_heights->addVoxel(pos);
+            } else {
+                m_heights->removeVoxel(pos);
+            }
+        }
         
         // Commented out to prevent excessive debug output during tests
         // if (success) {
@@ -200,15 +211,25 @@ public:
     // Bulk operations
     void clear() {
         m_octree->clear();
+        m_connectivity.reset();
+        m_heights.reset();
     }
     
+    // Face-connected islands of this grid; built on first use, then kept
+    // in step with setVoxel
+    const VoxelConnectivity& getConnectivity() const;
+    
+    // Column and layer heights of this grid; built on first use, then kept
+    // in step with setVoxel
+    const VoxelHeightIndex& getHeightIndex() const;
+    
     // Statistics
     size_t getVoxelCount() const {
         return m_octree->getVoxelCount();
     }
     
     bool isEmpty() const {
-        return getVoxelCount() == 0;
+        return m_octree->isEmpty();
     }
     
     size_t getMemoryUsage() const {
@@ -223,35 +244,93 @@ public:
     // Data export - Get all voxels as VoxelPosition objects
     std::vector<VoxelPosition> getAllVoxels() const {
         std::vector<VoxelPosition> voxels;
+        forEachVoxel([&voxels](const VoxelPosition& voxel) { voxels.push_back(voxel); });
+        return voxels;
+    }
+    
+    // Visit every voxel without copying them into a list first
+    template<typename Visitor>
+    void forEachVoxel(Visitor&& visit) const {
+        // Reverse of incrementToGrid(): 1cm = 1 grid unit, X/Z centered
+        int halfX_cm = static_cast<int>(m_workspaceSize.x * 100.0f / 2.0f);
+        int halfZ_cm = static_cast<int>(m_workspaceSize.z * 100.0f / 2.0f);
+        VoxelResolution resolution = m_resolution;
         
-        // Get all voxel positions from octree
-        auto positions = m_octree->getAllVoxels();
+        m_octree->forEachVoxel([&](const Math::Vector3i& gridPos) {
+            Math::IncrementCoordinates incrementPos(gridPos.x - halfX_cm, gridPos.y, gridPos.z - halfZ_cm);
+            visit(VoxelPosition(incrementPos, resolution));
+        });
+    }
+    
+    // Get voxels whose positions lie in an inclusive increment range
+    std::vector<VoxelPosition> getVoxelsInRange(const Math::IncrementCoordinates& minPos,
+                                                const Math::IncrementCoordinates& maxPos) const {
+        std::vector<VoxelPosition> voxels;
         
-        // Commented out to prevent excessive debug output during tests
-        // Logging::Logger::getInstance().debugfc("VoxelGrid", 
-        //     "Retrieved %zu voxel positions from octree", positions.size());
+        auto positions = m_octree->getVoxelsInRange(incrementToGrid(minPos), incrementToGrid(maxPos));
+        voxels.reserve(positions.size());
         
-        for (const auto& pos : positions) {
-            // Convert grid position back to increment coordinates
-            Math::Vector3i gridPos = pos;
-            // Apply reverse transformation from incrementToGrid()
-            // Since we now store at 1cm granularity, reverse is simpler
-            int halfX_cm = static_cast<int>(m_workspaceSize.x * 100.0f / 2.0f);
-            int halfZ_cm = static_cast<int>(m_workspaceSize.z * 100.0f / 2.0f);
-            
-            Math::IncrementCoordinates incrementPos(
-                gridPos.x - halfX_cm,  // Direct mapping (1cm = 1 grid unit)
-                gridPos.y,             // Direct mapping (1cm = 1 grid unit)
-                gridPos.z - halfZ_cm   // Direct mapping (1cm = 1 grid unit)
-            );
-            
-            VoxelPosition voxelPos(incrementPos, m_resolution);
-            voxels.push_back(voxelPos);
+        int halfX_cm = static_cast<int>(m_workspaceSize.x * 100.0f / 2.0f);
+        int halfZ_cm = static_cast<int>(m_workspaceSize.z * 100.0f / 2.0f);
+        for (const auto& gridPos : positions) {
+            Math::IncrementCoordinates incrementPos(gridPos.x - halfX_cm, gridPos.y, gridPos.z - halfZ_cm);
+            voxels.emplace_back(incrementPos, m_resolution);
         }
         
         return voxels;
     }
     
+    // Nearest voxel along a ray given in world space with a normalized
+    // direction. Each voxel spans [position, position + size) from its
+    // increment position; hitDistance is in meters along the ray.
+    bool raycast(const Math::WorldCoordinates& origin, const Math::Vector3f& direction, float maxDistance,
+                 Math::IncrementCoordinates& hitPos, float& hitDistance) const {
+        int halfX_cm = static_cast<int>(m_workspaceSize.x * 100.0f / 2.0f);
+        int halfZ_cm = static_cast<int>(m_workspaceSize.z * 100.0f / 2.0f);
+        
+        // Scaling both origin and direction to centimeters keeps t in meters
+        Math::Vector3f gridOrigin = origin.value() * 100.0f + Math::Vector3f(static_cast<float>(halfX_cm), 0.0f,
+                                                                           static_cast<float>(halfZ_cm));
+        Math::Vector3f gridDirection = direction * 100.0f;
+        int extent = static_cast<int>(m_voxelSize * 100.0f + 0.5f);
+        
+        Math::Vector3i gridPos;
+        if (!m_octree->raycast(gridOrigin, gridDirection, extent, maxDistance, gridPos, hitDistance)) {
+            return false;
+        }
+        hitPos = Math::IncrementCoordinates(gridPos.x - halfX_cm, gridPos.y, gridPos.z - halfZ_cm);
+        return true;
+    }
+
+    // raycast() for up to SparseOctree::RAY_PACKET_SIZE rays traversed
+    // together; hit[i] says whether ray i found a voxel. Returns the number
+    // of hits.
+    int raycastPacket(const Math::WorldCoordinates* origins, const Math::Vector3f* directions, int count,
+                      float maxDistance, Math::IncrementCoordinates* hitPos, float* hitDistance, bool* hit) const {
+        int halfX_cm = static_cast<int>(m_workspaceSize.x * 100.0f / 2.0f);
+        int halfZ_cm = static_cast<int>(m_workspaceSize.z * 100.0f / 2.0f);
+        Math::Vector3f offset(static_cast<float>(halfX_cm), 0.0f, static_cast<float>(halfZ_cm));
+        int extent = static_cast<int>(m_voxelSize * 100.0f + 0.5f);
+
+        count = std::min(count, SparseOctree::RAY_PACKET_SIZE);
+        Math::Vector3f gridOrigins[SparseOctree::RAY_PACKET_SIZE];
+        Math::Vector3f gridDirections[SparseOctree::RAY_PACKET_SIZE];
+        for (int i = 0; i < count; ++i) {
+            gridOrigins[i] = origins[i].value() * 100.0f + offset;
+            gridDirections[i] = directions[i] * 100.0f;
+        }
+
+        Math::Vector3i gridPos[SparseOctree::RAY_PACKET_SIZE];
+        int hits = m_octree->raycastPacket(gridOrigins, gridDirections, count, extent, maxDistance,
+                                           gridPos, hitDistance, hit);
+        for (int i = 0; i < count; ++i) {
+            if (hit[i]) {
+                hitPos[i] = Math::IncrementCoordinates(gridPos[i].x - halfX_cm, gridPos[i].y, gridPos[i].z - halfZ_cm);
+            }
+        }
+        return hits;
+    }
+    
     // Resize workspace
     bool resizeWorkspace(const Math::Vector3f& newSize) {
         // Calculate new grid dimensions based on 1cm granularity, not voxel resolution
@@ -393,6 +472,8 @@ private:
     Math::Vector3i m_gridDimensions;
     float m_voxelSize;
     std::unique_ptr<SparseOctree> m_octree;
+    mutable std::unique_ptr<VoxelConnectivity> m_connectivity;
+    mutable std::unique_ptr<VoxelHeightIndex> m_heights;
 };
 
 } // namespace VoxelData
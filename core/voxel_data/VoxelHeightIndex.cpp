@@ -0,0 +1,180 @@
+#include "VoxelHeightIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace VoxelEditor {
+namespace VoxelData {
+
+namespace {
+
+int floorDiv(int value, int divisor) {
+    int quotient = value / divisor;
+    return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+}
+
+}
+
+VoxelHeightIndex::VoxelHeightIndex(VoxelResolution resolution)
+    : m_voxelSize(static_cast<int>(std::lround(getVoxelSize(resolution) * 100.0f)))
+    , m_tileSize(std::max(m_voxelSize, MIN_TILE_SIZE)) {
+}
+
+uint64_t VoxelHeightIndex::tileKey(int tileX, int tileZ) const {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(tileX)) << 32) | static_cast<uint32_t>(tileZ);
+}
+
+int VoxelHeightIndex::tileCoord(int value) const {
+    return floorDiv(value, m_tileSize);
+}
+
+void VoxelHeightIndex::addVoxel(const Math::IncrementCoordinates& pos) {
+    Tile& tile = m_tiles[tileKey(tileCoord(pos.x()), tileCoord(pos.z()))];
+    auto column = std::find_if(tile.begin(), tile.end(), [&](const Column& c) {
+        return c.x == pos.x() && c.z == pos.z();
+    });
+    if (column == tile.end()) {
+        tile.push_back({pos.x(), pos.z(), {}});
+        column = tile.end() - 1;
+        ++m_columnCount;
+    }
+
+    auto& heights = column->heights;
+    auto it = std::lower_bound(heights.begin(), heights.end(), pos.y());
+    if (it != heights.end() && *it == pos.y()) {
+        return;
+    }
+    heights.insert(it, pos.y());
+    ++m_layers[pos.y()];
+    ++m_voxelCount;
+}
+
+void VoxelHeightIndex::removeVoxel(const Math::IncrementCoordinates& pos) {
+    auto tileIt = m_tiles.find(tileKey(tileCoord(pos.x()), tileCoord(pos.z())));
+    if (tileIt == m_tiles.end()) {
+        return;
+    }
+    Tile& tile = tileIt->second;
+    auto column = std::find_if(tile.begin(), tile.end(), [&](const Column& c) {
+        return c.x == pos.x() && c.z == pos.z();
+    });
+    if (column == tile.end()) {
+        return;
+    }
+
+    auto& heights = column->heights;
+    auto it = std::lower_bound(heights.begin(), heights.end(), pos.y());
+    if (it == heights.end() || *it != pos.y()) {
+        return;
+    }
+    heights.erase(it);
+    --m_voxelCount;
+
+    auto layer = m_layers.find(pos.y());
+    if (--layer->second == 0) {
+        m_layers.erase(layer);
+    }
+
+    if (heights.empty()) {
+        tile.erase(column);
+        --m_columnCount;
+        if (tile.empty()) {
+            m_tiles.erase(tileIt);
+        }
+    }
+}
+
+void VoxelHeightIndex::clear() {
+    m_tiles.clear();
+    m_layers.clear();
+    m_voxelCount = 0;
+    m_columnCount = 0;
+}
+
+std::vector<int> VoxelHeightIndex::getLayers(int minY, int maxY) const {
+    std::vector<int> layers;
+    for (auto it = m_layers.lower_bound(minY); it != m_layers.end() && it->first <= maxY; ++it) {
+        layers.push_back(it->first);
+    }
+    return layers;
+}
+
+size_t VoxelHeightIndex::getLayerVoxelCount(int y) const {
+    auto it = m_layers.find(y);
+    return it != m_layers.end() ? it->second : 0;
+}
+
+template<typename Visitor>
+void VoxelHeightIndex::forEachColumn(int minX, int maxX, int minZ, int maxZ, Visitor&& visitor) const {
+    auto visitTile = [&](const Tile& tile) {
+        for (const Column& column : tile) {
+            if (column.x >= minX && column.x <= maxX && column.z >= minZ && column.z <= maxZ) {
+                visitor(column);
+            }
+        }
+    };
+
+    int tileMinX = tileCoord(minX);
+    int tileMaxX = tileCoord(maxX);
+    int tileMinZ = tileCoord(minZ);
+    int tileMaxZ = tileCoord(maxZ);
+    uint64_t window = static_cast<uint64_t>(tileMaxX - tileMinX + 1) * static_cast<uint64_t>(tileMaxZ - tileMinZ + 1);
+
+    // A wide window over a sparse scene is cheaper to answer from the tiles
+    // that exist
+    if (window > m_tiles.size()) {
+        for (const auto& [key, tile] : m_tiles) {
+            visitTile(tile);
+        }
+        return;
+    }
+
+    for (int tx = tileMinX; tx <= tileMaxX; ++tx) {
+        for (int tz = tileMinZ; tz <= tileMaxZ; ++tz) {
+            auto it = m_tiles.find(tileKey(tx, tz));
+            if (it != m_tiles.end()) {
+                visitTile(it->second);
+            }
+        }
+    }
+}
+
+bool VoxelHeightIndex::findHighestAt(int x, int z, Math::IncrementCoordinates& result) const {
+    bool found = false;
+    int bestY = 0;
+    forEachColumn(x - m_voxelSize + 1, x, z - m_voxelSize + 1, z, [&](const Column& column) {
+        int top = column.heights.back();
+        if (!found || top > bestY) {
+            found = true;
+            bestY = top;
+            result = Math::IncrementCoordinates(column.x, top, column.z);
+        }
+    });
+    return found;
+}
+
+bool VoxelHeightIndex::findHighestInRadius(int x, int z, int radius, Math::IncrementCoordinates& result) const {
+    bool found = false;
+    int bestY = 0;
+    int64_t radiusSquared = static_cast<int64_t>(radius) * radius;
+    forEachColumn(x - radius - m_voxelSize + 1, x + radius, z - radius - m_voxelSize + 1, z + radius,
+                  [&](const Column& column) {
+        // Closest point of the footprint to the query point
+        int closestX = std::max(column.x, std::min(x, column.x + m_voxelSize - 1));
+        int closestZ = std::max(column.z, std::min(z, column.z + m_voxelSize - 1));
+        int64_t dx = closestX - x;
+        int64_t dz = closestZ - z;
+        if (dx * dx + dz * dz > radiusSquared) {
+            return;
+        }
+        int top = column.heights.back();
+        if (!found || top > bestY) {
+            found = true;
+            bestY = top;
+            result = Math::IncrementCoordinates(column.x, top, column.z);
+        }
+    });
+    return found;
+}
+
+}
+}
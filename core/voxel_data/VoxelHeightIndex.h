@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "VoxelTypes.h"
+#include "../../foundation/math/CoordinateTypes.h"
+
+namespace VoxelEditor {
+namespace VoxelData {
+
+// Heights of one grid's voxels, kept in step with edits so placement
+// queries do not scan the scene.
+//
+// Layers count voxels per bottom height, which gives the occupied
+// top-face heights in order. Columns keep the sorted bottom heights at each
+// occupied XZ position and are grouped into square XZ tiles at least one
+// voxel wide, so a point query looks at no more than four tiles and a
+// radius query only at the tiles its footprint overlaps.
+//
+// Not thread-safe; the owner serialises access.
+class VoxelHeightIndex {
+public:
+    static constexpr int MIN_TILE_SIZE = 8;
+
+    explicit VoxelHeightIndex(VoxelResolution resolution);
+
+    void addVoxel(const Math::IncrementCoordinates& pos);
+    void removeVoxel(const Math::IncrementCoordinates& pos);
+    void clear();
+
+    size_t getVoxelCount() const { return m_voxelCount; }
+    size_t getColumnCount() const { return m_columnCount; }
+
+    // Bottom heights within [minY, maxY] that hold at least one voxel
+    std::vector<int> getLayers(int minY, int maxY) const;
+    size_t getLayerVoxelCount(int y) const;
+
+    // Highest voxel whose footprint [x, x + size) x [z, z + size) covers
+    // the point; false when the column is empty
+    bool findHighestAt(int x, int z, Math::IncrementCoordinates& result) const;
+    // Highest voxel whose footprint comes within radius of the point
+    bool findHighestInRadius(int x, int z, int radius, Math::IncrementCoordinates& result) const;
+
+private:
+    struct Column {
+        int x;
+        int z;
+        std::vector<int> heights;  // Ascending voxel bottoms
+    };
+    using Tile = std::vector<Column>;
+
+    int m_voxelSize;
+    int m_tileSize;
+    std::unordered_map<uint64_t, Tile> m_tiles;
+    std::map<int, size_t> m_layers;
+    size_t m_voxelCount = 0;
+    size_t m_columnCount = 0;
+
+    uint64_t tileKey(int tileX, int tileZ) const;
+    int tileCoord(int value) const;
+
+    // Visits each column whose position lies in [minX, maxX] x [minZ, maxZ]
+    template<typename Visitor>
+    void forEachColumn(int minX, int maxX, int minZ, int maxZ, Visitor&& visitor) const;
+};
+
+}
+}
@@ -340,4 +340,90 @@ TEST_F(VoxelDataBatchOperationsTest, ConvenienceMethod_Integration) {
     for (const auto& pos : positions) {
         EXPECT_TRUE(voxelManager->getVoxel(pos, VoxelResolution::Size_1cm));
     }
-}
\ No newline at end of file
+}
+
+// Test replacing voxels as one edit
+TEST_F(VoxelDataBatchOperationsTest, ReplaceVoxels_ShiftOntoItself) {
+    auto res = VoxelResolution::Size_4cm;
+    std::vector<VoxelPosition> before;
+    std::vector<VoxelPosition> after;
+    for (int x = 0; x < 40; x += 4) {
+        ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(x, 0, 0), res, true));
+        before.emplace_back(IncrementCoordinates(x, 0, 0), res);
+        after.emplace_back(IncrementCoordinates(x + 8, 0, 0), res);
+    }
+    
+    // Destination overlaps the source; only the source is in the way
+    auto result = voxelManager->replaceVoxels(before, after);
+    ASSERT_TRUE(result.success) << result.errorMessage;
+    EXPECT_EQ(voxelManager->getTotalVoxelCount(), 10u);
+    EXPECT_FALSE(voxelManager->getVoxel(IncrementCoordinates(0, 0, 0), res));
+    EXPECT_FALSE(voxelManager->getVoxel(IncrementCoordinates(4, 0, 0), res));
+    EXPECT_TRUE(voxelManager->getVoxel(IncrementCoordinates(44, 0, 0), res));
+    
+    result = voxelManager->replaceVoxels(after, before);
+    ASSERT_TRUE(result.success) << result.errorMessage;
+    EXPECT_TRUE(voxelManager->getVoxel(IncrementCoordinates(0, 0, 0), res));
+    EXPECT_FALSE(voxelManager->getVoxel(IncrementCoordinates(44, 0, 0), res));
+}
+
+TEST_F(VoxelDataBatchOperationsTest, ReplaceVoxels_RejectsWithoutChanges) {
+    auto res = VoxelResolution::Size_4cm;
+    ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(0, 0, 0), res, true));
+    // A larger voxel whose extent covers (40, 0, 0)
+    ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(48, 0, 0), VoxelResolution::Size_16cm, true));
+    
+    std::vector<VoxelPosition> source{VoxelPosition(IncrementCoordinates(0, 0, 0), res)};
+    
+    // Partial overlap with the 16cm voxel
+    auto result = voxelManager->replaceVoxels(source, {VoxelPosition(IncrementCoordinates(40, 0, 0), res)});
+    EXPECT_FALSE(result.success);
+    
+    // Outside the workspace
+    result = voxelManager->replaceVoxels(source, {VoxelPosition(IncrementCoordinates(0, -4, 0), res)});
+    EXPECT_FALSE(result.success);
+    
+    // Duplicate placements
+    result = voxelManager->replaceVoxels(source, {VoxelPosition(IncrementCoordinates(100, 0, 0), res),
+                                                  VoxelPosition(IncrementCoordinates(100, 0, 0), res)});
+    EXPECT_FALSE(result.success);
+    
+    EXPECT_TRUE(voxelManager->getVoxel(IncrementCoordinates(0, 0, 0), res));
+    EXPECT_EQ(voxelManager->getTotalVoxelCount(), 2u);
+    
+    // Touching faces is fine
+    result = voxelManager->replaceVoxels(source, {VoxelPosition(IncrementCoordinates(36, 0, 0), res)});
+    EXPECT_TRUE(result.success) << result.errorMessage;
+    EXPECT_TRUE(voxelManager->getVoxel(IncrementCoordinates(36, 0, 0), res));
+}
+
+TEST_F(VoxelDataBatchOperationsTest, ReplaceVoxels_RejectsOverlappingPlacements) {
+    auto res = VoxelResolution::Size_4cm;
+    ASSERT_TRUE(voxelManager->setVoxel(IncrementCoordinates(0, 0, 0), res, true));
+    std::vector<VoxelPosition> source{VoxelPosition(IncrementCoordinates(0, 0, 0), res)};
+    
+    // Same resolution, shifted by less than a voxel
+    auto result = voxelManager->replaceVoxels(source, {VoxelPosition(IncrementCoordinates(100, 0, 0), res),
+                                                       VoxelPosition(IncrementCoordinates(102, 0, 2), res)});
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.errorMessage, "Placements overlap each other");
+    
+    // A small voxel inside a larger one, in either order
+    result = voxelManager->replaceVoxels(source, {VoxelPosition(IncrementCoordinates(101, 1, 0), VoxelResolution::Size_1cm),
+                                                  VoxelPosition(IncrementCoordinates(100, 0, 0), res)});
+    EXPECT_FALSE(result.success);
+    result = voxelManager->replaceVoxels(source, {VoxelPosition(IncrementCoordinates(300, 0, 0), VoxelResolution::Size_16cm),
+                                                  VoxelPosition(IncrementCoordinates(306, 12, 6), res)});
+    EXPECT_FALSE(result.success);
+    
+    EXPECT_TRUE(voxelManager->getVoxel(IncrementCoordinates(0, 0, 0), res));
+    EXPECT_EQ(voxelManager->getTotalVoxelCount(), 1u);
+    
+    // Placements that only touch are fine
+    result = voxelManager->replaceVoxels(source, {VoxelPosition(IncrementCoordinates(100, 0, 0), res),
+                                                  VoxelPosition(IncrementCoordinates(104, 0, 0), res),
+                                                  VoxelPosition(IncrementCoordinates(107, 0, 0), VoxelResolution::Size_1cm),
+                                                  VoxelPosition(IncrementCoordinates(100, 4, 0), VoxelResolution::Size_1cm)});
+    EXPECT_TRUE(result.success) << result.errorMessage;
+    EXPECT_EQ(voxelManager->getTotalVoxelCount(), 4u);
+}
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+#include "../VoxelConnectivity.h"
+#include "../VoxelDataManager.h"
+
+using namespace VoxelEditor::VoxelData;
+using namespace VoxelEditor::Math;
+
+namespace {
+
+// Reference labelling: plain flood fill over a position set
+std::unordered_map<Vector3i, int> bruteForceLabels(const std::vector<Vector3i>& voxels, int step) {
+    std::unordered_map<Vector3i, int> labels;
+    for (const auto& v : voxels) labels[v] = -1;
+
+    const Vector3i offsets[6] = {
+        Vector3i(step, 0, 0), Vector3i(-step, 0, 0), Vector3i(0, step, 0),
+        Vector3i(0, -step, 0), Vector3i(0, 0, step), Vector3i(0, 0, -step)
+    };
+
+    int next = 0;
+    for (const auto& start : voxels) {
+        if (labels[start] != -1) continue;
+        std::vector<Vector3i> stack{start};
+        labels[start] = next;
+        while (!stack.empty()) {
+            Vector3i pos = stack.back();
+            stack.pop_back();
+            for (const auto& offset : offsets) {
+                auto it = labels.find(pos + offset);
+                if (it != labels.end() && it->second == -1) {
+                    it->second = next;
+                    stack.push_back(it->first);
+                }
+            }
+        }
+        ++next;
+    }
+    return labels;
+}
+
+// Same partition as the reference: labels map one to one, sizes and
+// grounding agree
+void expectMatchesBruteForce(const VoxelConnectivity& connectivity,
+                             const std::unordered_map<Vector3i, bool>& occupied,
+                             VoxelResolution res, int step) {
+    std::vector<Vector3i> voxels;
+    for (const auto& entry : occupied) voxels.push_back(entry.first);
+    auto expected = bruteForceLabels(voxels, step);
+
+    ASSERT_EQ(connectivity.getVoxelCount(), voxels.size());
+    std::unordered_map<int, VoxelConnectivity::ComponentId> forward;
+    std::unordered_map<VoxelConnectivity::ComponentId, int> backward;
+    std::unordered_map<int, size_t> sizes;
+    std::unordered_map<int, bool> grounded;
+    for (const auto& v : voxels) {
+        auto id = connectivity.getComponent(IncrementCoordinates(v), res);
+        ASSERT_NE(id, VoxelConnectivity::INVALID_COMPONENT);
+        int label = expected[v];
+        EXPECT_EQ(forward.emplace(label, id).first->second, id);
+        EXPECT_EQ(backward.emplace(id, label).first->second, label);
+        ++sizes[label];
+        grounded[label] = grounded[label] || v.y == 0;
+    }
+    EXPECT_EQ(connectivity.getComponentCount(), forward.size());
+    for (const auto& entry : forward) {
+        EXPECT_EQ(connectivity.getComponentSize(entry.second), sizes[entry.first]);
+        EXPECT_EQ(connectivity.isGrounded(entry.second), grounded[entry.first]);
+    }
+}
+
+}
+
+TEST(VoxelConnectivityTest, EmptyHasNoComponents) {
+    VoxelConnectivity connectivity;
+    EXPECT_EQ(connectivity.getComponentCount(), 0u);
+    EXPECT_EQ(connectivity.getComponent(IncrementCoordinates(0, 0, 0), VoxelResolution::Size_4cm),
+              VoxelConnectivity::INVALID_COMPONENT);
+    EXPECT_FALSE(connectivity.isGrounded(VoxelConnectivity::INVALID_COMPONENT));
+}
+
+TEST(VoxelConnectivityTest, LineAcrossBricksIsOneComponent) {
+    VoxelConnectivity connectivity;
+    auto res = VoxelResolution::Size_4cm;
+    for (int x = -100; x <= 100; x += 4) {
+        EXPECT_TRUE(connectivity.setVoxel(IncrementCoordinates(x, 0, 0), res, true));
+    }
+    EXPECT_FALSE(connectivity.setVoxel(IncrementCoordinates(0, 0, 0), res, true));
+    EXPECT_GT(connectivity.getBrickCount(), 1u);
+
+    EXPECT_EQ(connectivity.getComponentCount(), 1u);
+    auto component = connectivity.getComponent(IncrementCoordinates(-100, 0, 0), res);
+    EXPECT_EQ(component, connectivity.getComponent(IncrementCoordinates(100, 0, 0), res));
+    EXPECT_EQ(connectivity.getComponentSize(component), 51u);
+    EXPECT_TRUE(connectivity.isGrounded(component));
+    EXPECT_EQ(connectivity.getComponentVoxels(component).size(), 51u);
+}
+
+TEST(VoxelConnectivityTest, RemovalSplitsAndReAddJoins) {
+    VoxelConnectivity connectivity;
+    auto res = VoxelResolution::Size_4cm;
+    for (int y = 0; y <= 80; y += 4) {
+        connectivity.setVoxel(IncrementCoordinates(0, y, 0), res, true);
+    }
+    EXPECT_EQ(connectivity.getComponentCount(), 1u);
+
+    // Cutting the column leaves a floating top
+    EXPECT_TRUE(connectivity.setVoxel(IncrementCoordinates(0, 40, 0), res, false));
+    EXPECT_EQ(connectivity.getComponentCount(), 2u);
+    auto top = connectivity.getComponent(IncrementCoordinates(0, 80, 0), res);
+    auto bottom = connectivity.getComponent(IncrementCoordinates(0, 0, 0), res);
+    EXPECT_NE(top, bottom);
+    EXPECT_FALSE(connectivity.isGrounded(top));
+    EXPECT_TRUE(connectivity.isGrounded(bottom));
+    EXPECT_EQ(connectivity.getComponentSize(top), 10u);
+
+    // Only the edited brick is relabelled
+    connectivity.setVoxel(IncrementCoordinates(0, 40, 0), res, true);
+    EXPECT_EQ(connectivity.getDirtyBrickCount(), 1u);
+    EXPECT_EQ(connectivity.getComponentCount(), 1u);
+    EXPECT_EQ(connectivity.getDirtyBrickCount(), 0u);
+}
+
+TEST(VoxelConnectivityTest, ResolutionsAndDiagonalsStaySeparate) {
+    VoxelConnectivity connectivity;
+    connectivity.setVoxel(IncrementCoordinates(0, 0, 0), VoxelResolution::Size_4cm, true);
+    connectivity.setVoxel(IncrementCoordinates(4, 0, 0), VoxelResolution::Size_8cm, true);
+    connectivity.setVoxel(IncrementCoordinates(4, 4, 0), VoxelResolution::Size_4cm, true);
+    EXPECT_EQ(connectivity.getComponentCount(), 3u);
+}
+
+TEST(VoxelConnectivityTest, MatchesBruteForceUnderRandomEdits) {
+    VoxelConnectivity connectivity;
+    auto res = VoxelResolution::Size_2cm;
+    const int step = 2;
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> coord(-20, 20);
+
+    std::unordered_map<Vector3i, bool> occupied;
+    for (int round = 0; round < 6; ++round) {
+        for (int i = 0; i < 2000; ++i) {
+            Vector3i pos(coord(rng) * step, (coord(rng) + 20) * step, coord(rng) * step);
+            bool value = (rng() % 3) != 0;
+            connectivity.setVoxel(IncrementCoordinates(pos), res, value);
+            if (value) occupied[pos] = true; else occupied.erase(pos);
+        }
+
+        expectMatchesBruteForce(connectivity, occupied, res, step);
+    }
+}
+
+TEST(VoxelConnectivityTest, MatchesBruteForceAfterEveryFewEdits) {
+    // Small edits between queries exercise the partial re-join: islands
+    // split, merge and vanish while others keep their ids
+    VoxelConnectivity connectivity;
+    auto res = VoxelResolution::Size_1cm;
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<int> coord(0, 23);
+
+    std::unordered_map<Vector3i, bool> occupied;
+    for (int round = 0; round < 300; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            Vector3i pos(coord(rng), coord(rng), coord(rng) / 4);
+            bool value = (rng() % 2) != 0;
+            connectivity.setVoxel(IncrementCoordinates(pos), res, value);
+            if (value) occupied[pos] = true; else occupied.erase(pos);
+        }
+        expectMatchesBruteForce(connectivity, occupied, res, 1);
+        if (HasFailure()) return;
+    }
+}
+
+TEST(VoxelConnectivityTest, EditOnlyRejoinsTouchedIslands) {
+    VoxelConnectivity connectivity;
+    auto res = VoxelResolution::Size_4cm;
+
+    // 100 separate pillars, each spread over two bricks
+    for (int i = 0; i < 100; ++i) {
+        for (int y = 0; y < 64; y += 4) {
+            connectivity.setVoxel(IncrementCoordinates(i * 64, y, 0), res, true);
+        }
+    }
+    EXPECT_EQ(connectivity.getComponentCount(), 100u);
+    EXPECT_EQ(connectivity.getLastJoinSize(), 200u);
+
+    // Cutting one pillar re-joins only that pillar's labels
+    connectivity.setVoxel(IncrementCoordinates(640, 20, 0), res, false);
+    EXPECT_EQ(connectivity.getComponentCount(), 101u);
+    EXPECT_EQ(connectivity.getLastJoinSize(), 3u);
+
+    // Bridging two pillars pulls in the neighbour as a whole
+    for (int x = 644; x < 704; x += 4) {
+        connectivity.setVoxel(IncrementCoordinates(x, 60, 0), res, true);
+    }
+    EXPECT_EQ(connectivity.getComponentCount(), 100u);
+    EXPECT_LE(connectivity.getLastJoinSize(), 8u);
+    EXPECT_EQ(connectivity.getComponent(IncrementCoordinates(640, 60, 0), res),
+              connectivity.getComponent(IncrementCoordinates(704, 0, 0), res));
+    EXPECT_EQ(connectivity.getComponentSize(connectivity.getComponent(IncrementCoordinates(704, 0, 0), res)),
+              16u + 10u + 15u);
+}
+
+TEST(VoxelConnectivityTest, ManagerTracksEdits) {
+    VoxelDataManager manager;
+    auto res = VoxelResolution::Size_8cm;
+    for (int x = 0; x < 80; x += 8) {
+        ASSERT_TRUE(manager.setVoxel(IncrementCoordinates(x, 0, 0), res, true));
+    }
+    EXPECT_EQ(manager.getIslandCount(res), 1u);
+    EXPECT_EQ(manager.getConnectedVoxels(IncrementCoordinates(0, 0, 0), res).size(), 10u);
+
+    ASSERT_TRUE(manager.setVoxel(IncrementCoordinates(40, 0, 0), res, false));
+    EXPECT_EQ(manager.getIslandCount(res), 2u);
+    EXPECT_EQ(manager.getConnectedVoxels(IncrementCoordinates(72, 0, 0), res).size(), 4u);
+    EXPECT_TRUE(manager.isConnectedToGround(IncrementCoordinates(72, 0, 0), res));
+    EXPECT_TRUE(manager.getConnectedVoxels(IncrementCoordinates(40, 0, 0), res).empty());
+
+    manager.clearAll();
+    EXPECT_EQ(manager.getIslandCount(res), 0u);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include "../VoxelHeightIndex.h"
+#include "../VoxelDataManager.h"
+
+using namespace VoxelEditor::VoxelData;
+using namespace VoxelEditor::Math;
+
+namespace {
+
+// Highest top among voxels matching a footprint predicate, or -1
+template<typename Predicate>
+int bruteForceHighest(const std::set<Vector3i>& voxels, Predicate covers) {
+    int best = -1;
+    for (const auto& v : voxels) {
+        if (covers(v)) best = std::max(best, v.y);
+    }
+    return best;
+}
+
+}
+
+TEST(VoxelHeightIndexTest, ColumnsAndLayersFollowEdits) {
+    VoxelHeightIndex index(VoxelResolution::Size_4cm);
+    index.addVoxel(IncrementCoordinates(0, 0, 0));
+    index.addVoxel(IncrementCoordinates(0, 4, 0));
+    index.addVoxel(IncrementCoordinates(0, 12, 0));
+    index.addVoxel(IncrementCoordinates(0, 12, 0));
+    index.addVoxel(IncrementCoordinates(-9, 4, 3));
+    EXPECT_EQ(index.getVoxelCount(), 4u);
+    EXPECT_EQ(index.getColumnCount(), 2u);
+    EXPECT_EQ(index.getLayers(0, 100), (std::vector<int>{0, 4, 12}));
+    EXPECT_EQ(index.getLayerVoxelCount(4), 2u);
+
+    // A 4cm voxel at x=0 covers x in [0, 4)
+    IncrementCoordinates hit;
+    ASSERT_TRUE(index.findHighestAt(3, 3, hit));
+    EXPECT_EQ(hit, IncrementCoordinates(0, 12, 0));
+    EXPECT_FALSE(index.findHighestAt(4, 0, hit));
+    ASSERT_TRUE(index.findHighestAt(-6, 5, hit));
+    EXPECT_EQ(hit, IncrementCoordinates(-9, 4, 3));
+
+    // Removing the top of a column exposes the next voxel down
+    index.removeVoxel(IncrementCoordinates(0, 12, 0));
+    ASSERT_TRUE(index.findHighestAt(0, 0, hit));
+    EXPECT_EQ(hit.y(), 4);
+    EXPECT_EQ(index.getLayers(0, 100), (std::vector<int>{0, 4}));
+
+    index.removeVoxel(IncrementCoordinates(-9, 4, 3));
+    EXPECT_EQ(index.getColumnCount(), 1u);
+    EXPECT_EQ(index.getLayerVoxelCount(4), 1u);
+    EXPECT_FALSE(index.findHighestAt(-6, 5, hit));
+
+    ASSERT_TRUE(index.findHighestInRadius(-6, 5, 7, hit));
+    EXPECT_EQ(hit.y(), 4);
+    EXPECT_FALSE(index.findHighestInRadius(-6, 5, 5, hit));
+}
+
+TEST(VoxelHeightIndexTest, MatchesBruteForce) {
+    for (auto resolution : {VoxelResolution::Size_1cm, VoxelResolution::Size_8cm, VoxelResolution::Size_64cm}) {
+        const int size = VoxelConnectivity::voxelStep(resolution);
+        VoxelHeightIndex index(resolution);
+        std::set<Vector3i> voxels;
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<int> coord(-150, 150);
+        std::uniform_int_distribution<int> height(0, 60);
+
+        for (int step = 0; step < 3000; ++step) {
+            Vector3i pos(coord(rng), height(rng), coord(rng));
+            if (step % 4 == 3 && !voxels.empty()) {
+                auto it = voxels.begin();
+                std::advance(it, rng() % voxels.size());
+                pos = *it;
+                index.removeVoxel(IncrementCoordinates(pos));
+                voxels.erase(it);
+            } else {
+                index.addVoxel(IncrementCoordinates(pos));
+                voxels.insert(pos);
+            }
+        }
+        ASSERT_EQ(index.getVoxelCount(), voxels.size());
+
+        for (int q = 0; q < 300; ++q) {
+            int x = coord(rng);
+            int z = coord(rng);
+            IncrementCoordinates hit;
+
+            int expected = bruteForceHighest(voxels, [&](const Vector3i& v) {
+                return v.x <= x && x < v.x + size && v.z <= z && z < v.z + size;
+            });
+            bool found = index.findHighestAt(x, z, hit);
+            ASSERT_EQ(found, expected >= 0);
+            if (found) {
+                EXPECT_EQ(hit.y(), expected);
+                EXPECT_TRUE(voxels.count(hit.value()));
+            }
+
+            int radius = 1 + (q % 40);
+            expected = bruteForceHighest(voxels, [&](const Vector3i& v) {
+                int cx = std::max(v.x, std::min(x, v.x + size - 1));
+                int cz = std::max(v.z, std::min(z, v.z + size - 1));
+                return (cx - x) * (cx - x) + (cz - z) * (cz - z) <= radius * radius;
+            });
+            found = index.findHighestInRadius(x, z, radius, hit);
+            ASSERT_EQ(found, expected >= 0);
+            if (found) {
+                EXPECT_EQ(hit.y(), expected);
+            }
+        }
+    }
+}
+
+TEST(VoxelHeightIndexTest, ManagerQueriesStayCurrent) {
+    VoxelDataManager manager;
+    const auto res = VoxelResolution::Size_8cm;
+    ASSERT_TRUE(manager.setVoxel(IncrementCoordinates(0, 0, 0), res, true));
+
+    IncrementCoordinates hit;
+    ASSERT_TRUE(manager.findHighestVoxelAt(res, 4, 4, hit));
+    EXPECT_EQ(hit.y(), 0);
+
+    // Edits after the index is built are picked up
+    ASSERT_TRUE(manager.setVoxel(IncrementCoordinates(0, 8, 0), res, true));
+    ASSERT_TRUE(manager.setVoxel(IncrementCoordinates(16, 8, 0), res, true));
+    ASSERT_TRUE(manager.findHighestVoxelAt(res, 4, 4, hit));
+    EXPECT_EQ(hit.y(), 8);
+    EXPECT_EQ(manager.getVoxelsWithBottomIn(res, 8, 8).size(), 2u);
+    EXPECT_TRUE(manager.getVoxelsWithBottomIn(res, 1, 7).empty());
+
+    ASSERT_TRUE(manager.setVoxel(IncrementCoordinates(0, 8, 0), res, false));
+    ASSERT_TRUE(manager.findHighestVoxelAt(res, 4, 4, hit));
+    EXPECT_EQ(hit.y(), 0);
+    EXPECT_FALSE(manager.findHighestVoxelAt(VoxelResolution::Size_1cm, 4, 4, hit));
+
+    manager.clearAll();
+    EXPECT_FALSE(manager.findHighestVoxelAt(res, 4, 4, hit));
+}
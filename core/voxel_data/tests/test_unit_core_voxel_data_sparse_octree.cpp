@@ -367,4 +367,155 @@ TEST_F(SparseOctreeTest, ClusteringEfficiency) {
     float scatteredEfficiency = static_cast<float>(scatteredVoxels) / scatteredMemory;
     
     EXPECT_GT(clusteredEfficiency, scatteredEfficiency);
-}
\ No newline at end of file
+}
+
+TEST_F(SparseOctreeTest, RangeQueryMatchesBruteForce) {
+    SparseOctree octree;
+    std::vector<Vector3i> positions;
+    for (int i = 0; i < 500; ++i) {
+        // Scattered, deterministic positions across several octants
+        Vector3i pos((i * 37) % 200, (i * 53) % 150, (i * 71) % 180);
+        if (octree.setVoxel(pos, true)) {
+            positions.push_back(pos);
+        }
+    }
+    
+    auto inRange = [](const Vector3i& p, const Vector3i& lo, const Vector3i& hi) {
+        return p.x >= lo.x && p.x <= hi.x && p.y >= lo.y && p.y <= hi.y && p.z >= lo.z && p.z <= hi.z;
+    };
+    
+    const Vector3i ranges[][2] = {
+        {Vector3i(0, 0, 0), Vector3i(199, 149, 179)},
+        {Vector3i(10, 20, 30), Vector3i(60, 70, 80)},
+        {Vector3i(37, 53, 71), Vector3i(37, 53, 71)},
+        {Vector3i(-50, -50, -50), Vector3i(-1, -1, -1)},
+    };
+    for (const auto& range : ranges) {
+        auto found = octree.getVoxelsInRange(range[0], range[1]);
+        size_t expected = 0;
+        for (const auto& pos : positions) {
+            if (inRange(pos, range[0], range[1])) {
+                ++expected;
+            }
+        }
+        EXPECT_EQ(found.size(), expected);
+        for (const auto& pos : found) {
+            EXPECT_TRUE(inRange(pos, range[0], range[1]));
+            EXPECT_TRUE(octree.getVoxel(pos));
+        }
+    }
+}
+
+TEST_F(SparseOctreeTest, RaycastMatchesBruteForce) {
+    SparseOctree octree;
+    std::vector<Vector3i> positions;
+    for (int i = 0; i < 400; ++i) {
+        Vector3i pos((i * 37) % 200, (i * 53) % 150, (i * 71) % 180);
+        if (octree.setVoxel(pos, true)) {
+            positions.push_back(pos);
+        }
+    }
+    
+    // Nearest entry (or exit, from inside) over every voxel box [p, p + extent],
+    // padded by the same tolerance the octree uses
+    const float eps = 1e-3f;
+    auto bruteForce = [&](const Vector3f& origin, const Vector3f& dir, int extent, float& bestT) {
+        bool hit = false;
+        bestT = 1e9f;
+        for (const auto& p : positions) {
+            float tEnter = -1e9f, tExit = 1e9f;
+            bool miss = false;
+            for (int axis = 0; axis < 3 && !miss; ++axis) {
+                float lo = static_cast<float>(p[axis]);
+                float hi = lo + extent;
+                if (dir[axis] == 0.0f) {
+                    miss = origin[axis] < lo - eps || origin[axis] >= hi - eps;
+                    continue;
+                }
+                float t0 = (lo - eps - origin[axis]) / dir[axis];
+                float t1 = (hi + eps - origin[axis]) / dir[axis];
+                if (t0 > t1) std::swap(t0, t1);
+                tEnter = std::max(tEnter, t0);
+                tExit = std::min(tExit, t1);
+                miss = tEnter > tExit;
+            }
+            if (miss || tExit < 0.0f) continue;
+            float t = tEnter >= 0.0f ? tEnter : tExit;
+            if (t < bestT) {
+                bestT = t;
+                hit = true;
+            }
+        }
+        return hit;
+    };
+    
+    for (int extent : {1, 4, 16}) {
+        for (int i = 0; i < 200; ++i) {
+            Vector3f origin(-20.0f + (i * 13) % 240, -10.0f + (i * 29) % 170, -20.0f + (i * 7) % 220);
+            Vector3f dir(static_cast<float>((i * 17) % 11) - 5.0f,
+                         static_cast<float>((i * 5) % 9) - 4.0f,
+                         static_cast<float>((i * 3) % 7) - 3.0f);
+            if (dir.length() == 0.0f) continue;
+            dir = dir.normalized();
+            
+            float expectedT;
+            bool expected = bruteForce(origin, dir, extent, expectedT);
+            Vector3i hitPos;
+            float hitT = 0.0f;
+            bool found = octree.raycast(origin, dir, extent, 1000.0f, hitPos, hitT);
+            ASSERT_EQ(found, expected) << "ray " << i << " extent " << extent;
+            if (found) {
+                EXPECT_NEAR(hitT, expectedT, 1e-3f);
+                EXPECT_TRUE(octree.getVoxel(hitPos));
+            }
+        }
+    }
+    
+    // Hits beyond the limit are not reported
+    Vector3i hitPos;
+    float hitT;
+    EXPECT_FALSE(octree.raycast(Vector3f(-1000.0f, 0.5f, 0.5f), Vector3f(1, 0, 0), 1, 10.0f, hitPos, hitT));
+}
+
+TEST_F(SparseOctreeTest, RaycastPacketMatchesSingleRays) {
+    SparseOctree octree;
+    for (int i = 0; i < 400; ++i) {
+        octree.setVoxel(Vector3i((i * 37) % 200, (i * 53) % 150, (i * 71) % 180), true);
+    }
+    
+    // Packets mixing directions, axis-aligned rays and partial fills
+    for (int extent : {1, 4, 16}) {
+        for (int start = 0; start < 200; start += 5) {
+            Vector3f origins[SparseOctree::RAY_PACKET_SIZE];
+            Vector3f dirs[SparseOctree::RAY_PACKET_SIZE];
+            int count = 1 + start % SparseOctree::RAY_PACKET_SIZE;
+            for (int lane = 0; lane < count; ++lane) {
+                int i = start + lane;
+                origins[lane] = Vector3f(-20.0f + (i * 13) % 240, -10.0f + (i * 29) % 170, -20.0f + (i * 7) % 220);
+                Vector3f dir(static_cast<float>((i * 17) % 11) - 5.0f,
+                             static_cast<float>((i * 5) % 9) - 4.0f,
+                             static_cast<float>((i * 3) % 7) - 3.0f);
+                dirs[lane] = dir.length() == 0.0f ? Vector3f(1, 0, 0) : dir.normalized();
+            }
+            
+            Vector3i hitPos[SparseOctree::RAY_PACKET_SIZE];
+            float hitT[SparseOctree::RAY_PACKET_SIZE];
+            bool hit[SparseOctree::RAY_PACKET_SIZE];
+            int hits = octree.raycastPacket(origins, dirs, count, extent, 1000.0f, hitPos, hitT, hit);
+            
+            int expectedHits = 0;
+            for (int lane = 0; lane < count; ++lane) {
+                Vector3i expectedPos;
+                float expectedT = 0.0f;
+                bool expected = octree.raycast(origins[lane], dirs[lane], extent, 1000.0f, expectedPos, expectedT);
+                ASSERT_EQ(hit[lane], expected) << "ray " << start + lane << " extent " << extent;
+                if (expected) {
+                    ++expectedHits;
+                    EXPECT_FLOAT_EQ(hitT[lane], expectedT);
+                    EXPECT_TRUE(octree.getVoxel(hitPos[lane]));
+                }
+            }
+            EXPECT_EQ(hits, expectedHits);
+        }
+    }
+}
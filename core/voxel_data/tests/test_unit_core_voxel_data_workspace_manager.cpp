@@ -8,7 +8,10 @@ using namespace VoxelEditor::VoxelData;
 using namespace VoxelEditor::Math;
 using namespace VoxelEditor::Events;
 
-// Event handler for testing
+namespace {
+
+// Event handler for testing (internal linkage: the manager tests define
+// another handler with the same name)
 class TestWorkspaceResizedHandler : public EventHandler<WorkspaceResizedEvent> {
 public:
     void handleEvent(const WorkspaceResizedEvent& event) override {
@@ -22,6 +25,8 @@ public:
     Vector3f lastNewSize{0.0f, 0.0f, 0.0f};
 };
 
+}
+
 class WorkspaceManagerTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -2,6 +2,9 @@
 
 #include <chrono>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <typeinfo>
 
 namespace VoxelEditor {
 namespace Events {
@@ -35,6 +38,23 @@ private:
     }
 };
 
+namespace detail {
+
+inline size_t nextEventTypeIndex() {
+    static std::atomic<size_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+}
+
+// Dense per-type index, fixed the first time the type is used. The dispatcher
+// uses it to index its handler tables directly instead of hashing type_index.
+template<typename EventType>
+size_t getEventTypeIndex() {
+    static const size_t index = detail::nextEventTypeIndex();
+    return index;
+}
+
 template<typename Derived>
 class Event : public EventBase {
 public:
@@ -1,13 +1,11 @@
 #pragma once
 
 #include <vector>
-#include <unordered_map>
-#include <typeindex>
 #include <memory>
-#include <queue>
 #include <mutex>
+#include <atomic>
+#include <thread>
 #include <algorithm>
-#include <typeinfo>
 
 #include "EventBase.h"
 #include "EventHandler.h"
@@ -15,154 +13,340 @@
 namespace VoxelEditor {
 namespace Events {
 
+// Dispatch is lock-free: handlers live in an immutable table that subscribe()
+// and unsubscribe() replace copy-on-write, and dispatch() reads the current
+// table inside an epoch-counted read section (RCU style). A replaced table is
+// freed once every dispatch that could still see it has finished.
+//
+// Handlers run without any lock held, so they may dispatch, subscribe or
+// unsubscribe. A dispatch that is already running keeps the table it started
+// with: a handler removed meanwhile can still receive that one event.
+//
+// Async events are copied into typed per-event-type buffers. Producers append
+// under a short lock; processQueuedEvents() swaps the buffers and drains the
+// whole batch in FIFO order. The buffers keep their capacity, so a steady
+// event rate stops allocating after the first few batches.
 class EventDispatcher {
 public:
-    EventDispatcher() : m_maxQueueSize(1000) {}
-    
+    EventDispatcher()
+        : m_table(new HandlerTable())
+        , m_pending(new QueueSet())
+        , m_draining(new QueueSet())
+        , m_maxQueueSize(1000) {}
+
+    ~EventDispatcher() {
+        delete m_table.load(std::memory_order_relaxed);
+        for (const HandlerTable* table : m_retired) {
+            delete table;
+        }
+    }
+
+    EventDispatcher(const EventDispatcher&) = delete;
+    EventDispatcher& operator=(const EventDispatcher&) = delete;
+
     template<typename EventType>
     void subscribe(EventHandler<EventType>* handler, int priority = 0) {
         if (!handler) return;
-        
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
-        std::type_index typeIndex(typeid(EventType));
-        auto& handlers = m_handlers[typeIndex];
-        
-        auto entry = std::make_unique<HandlerEntry<EventType>>(handler, priority);
-        handlers.push_back(std::move(entry));
-        
-        std::sort(handlers.begin(), handlers.end(), 
-                 [](const std::unique_ptr<HandlerEntryBase>& a, 
-                    const std::unique_ptr<HandlerEntryBase>& b) {
-                     return a->getPriority() > b->getPriority();
-                 });
+
+        updateHandlers(getEventTypeIndex<EventType>(), [&](std::vector<HandlerSlot>& handlers) {
+            HandlerSlot slot{handler, priority};
+            // Higher priority first; equal priorities keep subscription order
+            auto pos = std::upper_bound(handlers.begin(), handlers.end(), slot,
+                                        [](const HandlerSlot& a, const HandlerSlot& b) {
+                                            return a.priority > b.priority;
+                                        });
+            handlers.insert(pos, slot);
+            return true;
+        });
     }
-    
+
     template<typename EventType>
     void unsubscribe(EventHandler<EventType>* handler) {
         if (!handler) return;
-        
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
-        std::type_index typeIndex(typeid(EventType));
-        auto it = m_handlers.find(typeIndex);
-        if (it == m_handlers.end()) return;
-        
-        auto& handlers = it->second;
-        handlers.erase(
-            std::remove_if(handlers.begin(), handlers.end(),
-                          [handler](const std::unique_ptr<HandlerEntryBase>& entry) {
-                              auto* typedEntry = dynamic_cast<HandlerEntry<EventType>*>(entry.get());
-                              return typedEntry && typedEntry->getHandler() == handler;
-                          }),
-            handlers.end());
-        
-        if (handlers.empty()) {
-            m_handlers.erase(it);
-        }
+
+        updateHandlers(getEventTypeIndex<EventType>(), [&](std::vector<HandlerSlot>& handlers) {
+            auto end = std::remove_if(handlers.begin(), handlers.end(),
+                                      [handler](const HandlerSlot& slot) {
+                                          return slot.handler == handler;
+                                      });
+            if (end == handlers.end()) return false;
+            handlers.erase(end, handlers.end());
+            return true;
+        });
     }
-    
+
     template<typename EventType>
     void dispatch(const EventType& event) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
-        std::type_index typeIndex(typeid(EventType));
-        auto it = m_handlers.find(typeIndex);
-        if (it == m_handlers.end()) return;
-        
-        for (const auto& entry : it->second) {
-            if (entry->shouldHandle(event)) {
-                entry->handleEvent(event);
+        ReadSection section(*this);
+
+        const std::vector<HandlerSlot>* handlers = section.table()->find(getEventTypeIndex<EventType>());
+        if (!handlers) return;
+
+        for (const HandlerSlot& slot : *handlers) {
+            auto* handler = static_cast<EventHandler<EventType>*>(slot.handler);
+            if (handler->shouldHandle(event)) {
+                handler->handleEvent(event);
             }
         }
     }
-    
+
+    // Dropped when the queue already holds getMaxQueueSize() events
     template<typename EventType>
     void dispatchAsync(const EventType& event) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
-        if (m_eventQueue.size() >= m_maxQueueSize) {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+
+        if (m_pending->order.size() >= m_maxQueueSize.load(std::memory_order_relaxed)) {
             return;
         }
-        
-        m_eventQueue.push(std::make_unique<EventType>(event));
+
+        TypedQueue<EventType>& queue = m_pending->getQueue<EventType>();
+        queue.events.push_back(event);
+        m_pending->order.push_back(&queue);
     }
-    
+
+    // Events queued by the handlers run in the next call. A handler calling
+    // this re-entrantly returns at once, and the outer call drains another
+    // batch once its own is done. A call from another thread waits for the
+    // batch in progress and then drains what is queued.
     void processQueuedEvents() {
-        std::queue<std::unique_ptr<EventBase>> tempQueue;
-        
-        {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            tempQueue.swap(m_eventQueue);
-        }
-        
-        while (!tempQueue.empty()) {
-            auto event = std::move(tempQueue.front());
-            tempQueue.pop();
-            
-            dispatchEvent(*event);
+        if (m_drainingThread.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+            m_drainAgain = true;
+            return;
         }
+
+        std::lock_guard<std::mutex> drainLock(m_drainMutex);
+        DrainScope scope(*this);
+        do {
+            m_drainAgain = false;
+            m_draining->clear();
+            {
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                std::swap(m_pending, m_draining);
+            }
+
+            for (QueueBase* queue : m_draining->order) {
+                queue->dispatchNext(*this);
+            }
+        } while (m_drainAgain);
+        m_draining->clear();
     }
-    
+
     void clearQueue() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        while (!m_eventQueue.empty()) {
-            m_eventQueue.pop();
-        }
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_pending->clear();
     }
-    
+
     size_t getQueueSize() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_eventQueue.size();
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        return m_pending->order.size();
     }
-    
+
     void setMaxQueueSize(size_t maxSize) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_maxQueueSize = maxSize;
+        m_maxQueueSize.store(maxSize, std::memory_order_relaxed);
     }
-    
+
     size_t getMaxQueueSize() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_maxQueueSize;
+        return m_maxQueueSize.load(std::memory_order_relaxed);
     }
-    
+
     template<typename EventType>
     size_t getHandlerCount() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
-        std::type_index typeIndex(typeid(EventType));
-        auto it = m_handlers.find(typeIndex);
-        return it != m_handlers.end() ? it->second.size() : 0;
+        ReadSection section(*this);
+
+        const std::vector<HandlerSlot>* handlers = section.table()->find(getEventTypeIndex<EventType>());
+        return handlers ? handlers->size() : 0;
     }
-    
+
     size_t getTotalHandlerCount() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
+        ReadSection section(*this);
+        return section.table()->total;
+    }
+
+private:
+    // Stored type-erased; dispatch<EventType> casts back to the type it was
+    // subscribed with, which the table index guarantees
+    struct HandlerSlot {
+        void* handler;
+        int priority;
+    };
+
+    // Immutable once published
+    struct HandlerTable {
+        std::vector<std::vector<HandlerSlot>> byType;
         size_t total = 0;
-        for (const auto& pair : m_handlers) {
-            total += pair.second.size();
+
+        const std::vector<HandlerSlot>* find(size_t typeIndex) const {
+            if (typeIndex >= byType.size() || byType[typeIndex].empty()) return nullptr;
+            return &byType[typeIndex];
+        }
+    };
+
+    // Readers register on the counter of the current epoch parity. A writer
+    // flips the epoch twice and waits for each counter to drain, after which
+    // no reader can still hold a table that was unpublished before the flips.
+    class ReadSection {
+    public:
+        explicit ReadSection(const EventDispatcher& dispatcher) : m_dispatcher(dispatcher) {
+            for (;;) {
+                m_slot = dispatcher.m_epoch.load(std::memory_order_seq_cst) & 1;
+                dispatcher.m_readers[m_slot].fetch_add(1, std::memory_order_seq_cst);
+                if ((dispatcher.m_epoch.load(std::memory_order_seq_cst) & 1) == m_slot) break;
+                dispatcher.m_readers[m_slot].fetch_sub(1, std::memory_order_release);
+            }
+            m_table = dispatcher.m_table.load(std::memory_order_seq_cst);
+            t_readSections.push_back(&dispatcher);
+        }
+
+        ~ReadSection() {
+            t_readSections.pop_back();
+            m_dispatcher.m_readers[m_slot].fetch_sub(1, std::memory_order_release);
+        }
+
+        ReadSection(const ReadSection&) = delete;
+        ReadSection& operator=(const ReadSection&) = delete;
+
+        const HandlerTable* table() const { return m_table; }
+
+    private:
+        const EventDispatcher& m_dispatcher;
+        const HandlerTable* m_table;
+        size_t m_slot;
+    };
+
+    // Marks the thread that holds m_drainMutex, so a handler calling
+    // processQueuedEvents() is told apart from another thread
+    class DrainScope {
+    public:
+        explicit DrainScope(EventDispatcher& dispatcher) : m_dispatcher(dispatcher) {
+            m_dispatcher.m_drainingThread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        }
+
+        ~DrainScope() {
+            m_dispatcher.m_drainingThread.store(std::thread::id(), std::memory_order_relaxed);
+        }
+
+        DrainScope(const DrainScope&) = delete;
+        DrainScope& operator=(const DrainScope&) = delete;
+
+    private:
+        EventDispatcher& m_dispatcher;
+    };
+
+    struct QueueBase {
+        virtual ~QueueBase() = default;
+        virtual void dispatchNext(EventDispatcher& dispatcher) = 0;
+        virtual void clear() = 0;
+    };
+
+    template<typename EventType>
+    struct TypedQueue : QueueBase {
+        std::vector<EventType> events;
+        size_t next = 0;
+
+        void dispatchNext(EventDispatcher& dispatcher) override {
+            dispatcher.dispatch(events[next++]);
+        }
+
+        void clear() override {
+            events.clear();
+            next = 0;
+        }
+    };
+
+    // One batch: the events of each type plus the order they arrived in
+    struct QueueSet {
+        std::vector<std::unique_ptr<QueueBase>> byType;
+        std::vector<QueueBase*> order;
+
+        template<typename EventType>
+        TypedQueue<EventType>& getQueue() {
+            size_t typeIndex = getEventTypeIndex<EventType>();
+            if (typeIndex >= byType.size()) {
+                byType.resize(typeIndex + 1);
+            }
+            if (!byType[typeIndex]) {
+                byType[typeIndex] = std::make_unique<TypedQueue<EventType>>();
+            }
+            return static_cast<TypedQueue<EventType>&>(*byType[typeIndex]);
+        }
+
+        void clear() {
+            if (order.empty()) return;
+            for (auto& queue : byType) {
+                if (queue) queue->clear();
+            }
+            order.clear();
+        }
+    };
+
+    // Copies the current table, lets modify() edit one type's handler list and
+    // publishes the copy. Outside a dispatch on this dispatcher this waits for
+    // readers of the old table and frees it; inside one (a handler subscribing
+    // or unsubscribing) waiting would deadlock on our own read section, so the
+    // old table is retired and freed by a later update or the destructor.
+    template<typename Modify>
+    void updateHandlers(size_t typeIndex, Modify&& modify) {
+        std::vector<const HandlerTable*> garbage;
+        {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+
+            const HandlerTable* current = m_table.load(std::memory_order_relaxed);
+            auto next = std::make_unique<HandlerTable>(*current);
+            if (typeIndex >= next->byType.size()) {
+                next->byType.resize(typeIndex + 1);
+            }
+
+            std::vector<HandlerSlot>& handlers = next->byType[typeIndex];
+            size_t before = handlers.size();
+            if (!modify(handlers)) return;
+            next->total = next->total - before + handlers.size();
+
+            m_table.store(next.release(), std::memory_order_seq_cst);
+            m_retired.push_back(current);
+
+            if (isReadingOnThisThread()) return;
+            garbage.swap(m_retired);
+        }
+
+        waitForReaders();
+        for (const HandlerTable* table : garbage) {
+            delete table;
         }
-        return total;
     }
-    
-private:
-    void dispatchEvent(const EventBase& event) {
-        std::type_index typeIndex(typeid(event));
-        auto it = m_handlers.find(typeIndex);
-        if (it == m_handlers.end()) return;
-        
-        for (const auto& entry : it->second) {
-            if (entry->shouldHandle(event)) {
-                entry->handleEvent(event);
+
+    void waitForReaders() {
+        std::lock_guard<std::mutex> lock(m_graceMutex);
+        for (int flip = 0; flip < 2; ++flip) {
+            size_t epoch = m_epoch.fetch_add(1, std::memory_order_seq_cst);
+            while (m_readers[epoch & 1].load(std::memory_order_seq_cst) != 0) {
+                std::this_thread::yield();
             }
         }
     }
-    
-    std::unordered_map<std::type_index, std::vector<std::unique_ptr<HandlerEntryBase>>> m_handlers;
-    std::queue<std::unique_ptr<EventBase>> m_eventQueue;
-    mutable std::mutex m_mutex;
-    size_t m_maxQueueSize;
+
+    bool isReadingOnThisThread() const {
+        return std::find(t_readSections.begin(), t_readSections.end(), this) != t_readSections.end();
+    }
+
+    // Dispatchers with a read section open on this thread, innermost last.
+    // Only a read section of the same dispatcher blocks its grace period.
+    static inline thread_local std::vector<const EventDispatcher*> t_readSections;
+
+    std::atomic<const HandlerTable*> m_table;
+    mutable std::atomic<size_t> m_epoch{0};
+    mutable std::atomic<size_t> m_readers[2] = {};
+    std::vector<const HandlerTable*> m_retired;
+    std::mutex m_writeMutex;
+    std::mutex m_graceMutex;
+
+    std::unique_ptr<QueueSet> m_pending;
+    std::unique_ptr<QueueSet> m_draining;
+    mutable std::mutex m_queueMutex;
+    std::mutex m_drainMutex;
+    std::atomic<std::thread::id> m_drainingThread{};
+    bool m_drainAgain = false;  // Guarded by m_drainMutex
+    std::atomic<size_t> m_maxQueueSize;
 };
 
 }
-}
\ No newline at end of file
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "../EventDispatcher.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace VoxelEditor::Events;
+
+namespace {
+
+class PayloadEvent : public Event<PayloadEvent> {
+public:
+    PayloadEvent(int value, const std::string& tag) : value(value), tag(tag) {}
+    int value;
+    std::string tag;
+};
+
+class SumHandler : public EventHandler<PayloadEvent> {
+public:
+    void handleEvent(const PayloadEvent& event) override {
+        m_sum += event.value;
+        ++m_count;
+    }
+
+    long long getSum() const { return m_sum; }
+    int getCount() const { return m_count; }
+
+private:
+    long long m_sum = 0;
+    int m_count = 0;
+};
+
+double eventsPerSecond(int events, std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return events / std::max(seconds, 1e-9);
+}
+
+void printRate(const char* label, double rate) {
+    std::cout << std::left << std::setw(22) << label << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << rate / 1e6 << " M events/s" << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+}
+
+}
+
+// The editor dispatches on every input and voxel change; one million events
+// per second leaves ample headroom for that
+constexpr double TARGET_EVENTS_PER_SECOND = 1e6;
+constexpr int EVENT_COUNT = 1000000;
+
+TEST(EventDispatchThroughputTest, SyncDispatch) {
+    EventDispatcher dispatcher;
+    SumHandler first;
+    SumHandler second;
+    dispatcher.subscribe<PayloadEvent>(&first, 1);
+    dispatcher.subscribe<PayloadEvent>(&second);
+
+    PayloadEvent event(1, "tag");
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < EVENT_COUNT; ++i) {
+        dispatcher.dispatch(event);
+    }
+    double rate = eventsPerSecond(EVENT_COUNT, start);
+    printRate("dispatch", rate);
+
+    EXPECT_EQ(first.getCount(), EVENT_COUNT);
+    EXPECT_EQ(second.getSum(), EVENT_COUNT);
+    EXPECT_GE(rate, TARGET_EVENTS_PER_SECOND);
+}
+
+TEST(EventDispatchThroughputTest, AsyncBatches) {
+    EventDispatcher dispatcher;
+    SumHandler handler;
+    dispatcher.subscribe<PayloadEvent>(&handler);
+
+    const int batchSize = static_cast<int>(dispatcher.getMaxQueueSize());
+    PayloadEvent event(2, "tag");
+
+    // Warm-up batch sizes the buffers; later batches reuse them
+    for (int i = 0; i < batchSize; ++i) {
+        dispatcher.dispatchAsync(event);
+    }
+    dispatcher.processQueuedEvents();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int sent = 0; sent < EVENT_COUNT; sent += batchSize) {
+        for (int i = 0; i < batchSize; ++i) {
+            dispatcher.dispatchAsync(event);
+        }
+        dispatcher.processQueuedEvents();
+    }
+    double rate = eventsPerSecond(EVENT_COUNT, start);
+    printRate("dispatchAsync + drain", rate);
+
+    EXPECT_EQ(handler.getCount(), EVENT_COUNT + batchSize);
+    EXPECT_EQ(dispatcher.getQueueSize(), 0);
+    EXPECT_GE(rate, TARGET_EVENTS_PER_SECOND);
+}
@@ -4,6 +4,9 @@
 #include "../../../core/voxel_data/VoxelTypes.h"
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <functional>
+#include <string>
 
 using namespace VoxelEditor::Events;
 using namespace VoxelEditor::Math;
@@ -47,6 +50,41 @@ private:
     bool m_shouldHandle = true;
 };
 
+class OtherTestEvent : public Event<OtherTestEvent> {
+public:
+    OtherTestEvent(const std::string& name) : name(name) {}
+    std::string name;
+};
+
+// Dispatch does not serialize handlers, so one called from several threads
+// has to synchronize itself
+class AtomicCountHandler : public EventHandler<TestEvent> {
+public:
+    void handleEvent(const TestEvent& event) override {
+        (void)event;
+        m_callCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int getCallCount() const { return m_callCount.load(); }
+
+private:
+    std::atomic<int> m_callCount{0};
+};
+
+// Runs a callback from inside handleEvent
+class CallbackHandler : public EventHandler<TestEvent> {
+public:
+    explicit CallbackHandler(std::function<void(const TestEvent&)> callback)
+        : m_callback(std::move(callback)) {}
+
+    void handleEvent(const TestEvent& event) override {
+        m_callback(event);
+    }
+
+private:
+    std::function<void(const TestEvent&)> m_callback;
+};
+
 class EventDispatcherTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -251,7 +289,7 @@ TEST_F(EventDispatcherTest, EventId) {
 }
 
 TEST_F(EventDispatcherTest, ThreadSafety) {
-    TestHandler handler;
+    AtomicCountHandler handler;
     dispatcher->subscribe<TestEvent>(&handler);
     
     const int numThreads = 4;
@@ -272,4 +310,221 @@ TEST_F(EventDispatcherTest, ThreadSafety) {
     }
     
     EXPECT_EQ(handler.getCallCount(), numThreads * eventsPerThread);
-}
\ No newline at end of file
+}
+
+TEST_F(EventDispatcherTest, DispatchFromHandler) {
+    TestHandler inner;
+    CallbackHandler outer([this](const TestEvent& event) {
+        if (event.value < 3) {
+            dispatcher->dispatch(TestEvent(event.value + 1));
+        }
+    });
+    dispatcher->subscribe<TestEvent>(&outer, 10);
+    dispatcher->subscribe<TestEvent>(&inner);
+
+    dispatcher->dispatch(TestEvent(0));
+
+    // Innermost dispatch finishes first
+    EXPECT_EQ(inner.getReceivedValues(), (std::vector<int>{3, 2, 1, 0}));
+}
+
+TEST_F(EventDispatcherTest, SubscribeAndUnsubscribeFromHandler) {
+    TestHandler late;
+    CallbackHandler* selfPtr = nullptr;
+    CallbackHandler self([this, &late, &selfPtr](const TestEvent& event) {
+        (void)event;
+        dispatcher->unsubscribe<TestEvent>(selfPtr);
+        dispatcher->subscribe<TestEvent>(&late);
+    });
+    selfPtr = &self;
+    dispatcher->subscribe<TestEvent>(&self, 10);
+
+    // The running dispatch keeps the handler list it started with
+    dispatcher->dispatch(TestEvent(1));
+    EXPECT_EQ(late.getCallCount(), 0);
+    EXPECT_EQ(dispatcher->getHandlerCount<TestEvent>(), 1);
+
+    dispatcher->dispatch(TestEvent(2));
+    EXPECT_EQ(late.getCallCount(), 1);
+    EXPECT_EQ(late.getLastValue(), 2);
+}
+
+TEST_F(EventDispatcherTest, EqualPrioritiesKeepSubscriptionOrder) {
+    std::vector<int> order;
+    CallbackHandler first([&order](const TestEvent&) { order.push_back(1); });
+    CallbackHandler second([&order](const TestEvent&) { order.push_back(2); });
+    CallbackHandler third([&order](const TestEvent&) { order.push_back(3); });
+    CallbackHandler urgent([&order](const TestEvent&) { order.push_back(0); });
+
+    dispatcher->subscribe<TestEvent>(&first);
+    dispatcher->subscribe<TestEvent>(&second);
+    dispatcher->subscribe<TestEvent>(&third);
+    dispatcher->subscribe<TestEvent>(&urgent, 5);
+
+    dispatcher->dispatch(TestEvent(0));
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST_F(EventDispatcherTest, AsyncKeepsOrderAcrossEventTypes) {
+    std::vector<std::string> received;
+    CallbackHandler numbers([&received](const TestEvent& event) {
+        received.push_back(std::to_string(event.value));
+    });
+
+    class NameHandler : public EventHandler<OtherTestEvent> {
+    public:
+        explicit NameHandler(std::vector<std::string>& out) : m_out(out) {}
+        void handleEvent(const OtherTestEvent& event) override { m_out.push_back(event.name); }
+    private:
+        std::vector<std::string>& m_out;
+    } names(received);
+
+    dispatcher->subscribe<TestEvent>(&numbers);
+    dispatcher->subscribe<OtherTestEvent>(&names);
+
+    dispatcher->dispatchAsync(TestEvent(1));
+    dispatcher->dispatchAsync(OtherTestEvent("a"));
+    dispatcher->dispatchAsync(TestEvent(2));
+    dispatcher->dispatchAsync(OtherTestEvent("a string long enough to live on the heap"));
+    EXPECT_EQ(dispatcher->getQueueSize(), 4);
+
+    dispatcher->processQueuedEvents();
+
+    EXPECT_EQ(received, (std::vector<std::string>{"1", "a", "2", "a string long enough to live on the heap"}));
+    EXPECT_EQ(dispatcher->getQueueSize(), 0);
+}
+
+TEST_F(EventDispatcherTest, EventsQueuedWhileDrainingRunNextBatch) {
+    TestHandler handler;
+    CallbackHandler requeue([this](const TestEvent& event) {
+        if (event.value == 1) {
+            dispatcher->dispatchAsync(TestEvent(2));
+        }
+    });
+    dispatcher->subscribe<TestEvent>(&requeue);
+    dispatcher->subscribe<TestEvent>(&handler);
+
+    dispatcher->dispatchAsync(TestEvent(1));
+    dispatcher->processQueuedEvents();
+
+    EXPECT_EQ(handler.getReceivedValues(), (std::vector<int>{1}));
+    EXPECT_EQ(dispatcher->getQueueSize(), 1);
+
+    dispatcher->processQueuedEvents();
+
+    EXPECT_EQ(handler.getReceivedValues(), (std::vector<int>{1, 2}));
+    EXPECT_EQ(dispatcher->getQueueSize(), 0);
+}
+
+TEST_F(EventDispatcherTest, ReentrantProcessDrainsAnotherBatch) {
+    TestHandler handler;
+    CallbackHandler reentrant([this](const TestEvent& event) {
+        if (event.value == 1) {
+            dispatcher->dispatchAsync(TestEvent(2));
+            dispatcher->processQueuedEvents();
+        }
+    });
+    dispatcher->subscribe<TestEvent>(&reentrant);
+    dispatcher->subscribe<TestEvent>(&handler);
+
+    dispatcher->dispatchAsync(TestEvent(1));
+    dispatcher->processQueuedEvents();
+
+    // The nested call returned at once; the outer one picked up its event
+    EXPECT_EQ(handler.getReceivedValues(), (std::vector<int>{1, 2}));
+    EXPECT_EQ(dispatcher->getQueueSize(), 0);
+}
+
+TEST_F(EventDispatcherTest, ConcurrentProcessLeavesNothingQueued) {
+    AtomicCountHandler counter;
+    dispatcher->subscribe<TestEvent>(&counter);
+
+    const int threadCount = 4;
+    const int eventsPerThread = 200;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([this]() {
+            for (int i = 0; i < eventsPerThread; ++i) {
+                dispatcher->dispatchAsync(TestEvent(i));
+                dispatcher->processQueuedEvents();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every call drains at least what its thread queued before it
+    EXPECT_EQ(counter.getCallCount(), threadCount * eventsPerThread);
+    EXPECT_EQ(dispatcher->getQueueSize(), 0u);
+}
+
+TEST_F(EventDispatcherTest, UnsubscribeFromOtherDispatcherWaitsForReaders) {
+    EventDispatcher other;
+    std::atomic<bool> retired{false};
+    std::atomic<int> lateCalls{0};
+    CallbackHandler watched([&](const TestEvent& event) {
+        (void)event;
+        if (retired.load()) {
+            lateCalls.fetch_add(1);
+        }
+    });
+
+    std::atomic<bool> done{false};
+    std::thread reader([&]() {
+        while (!done.load()) {
+            other.dispatch(TestEvent(0));
+        }
+    });
+
+    // Unsubscribing on one dispatcher from a handler of another still waits
+    // until no dispatch on the first can reach the removed handler
+    CallbackHandler remover([&](const TestEvent& event) {
+        (void)event;
+        other.unsubscribe<TestEvent>(&watched);
+        retired.store(true);
+    });
+    dispatcher->subscribe<TestEvent>(&remover);
+    for (int i = 0; i < 200; ++i) {
+        retired.store(false);
+        other.subscribe<TestEvent>(&watched);
+        dispatcher->dispatch(TestEvent(i));
+    }
+
+    done = true;
+    reader.join();
+    EXPECT_EQ(lateCalls.load(), 0);
+}
+
+TEST_F(EventDispatcherTest, SubscribeWhileDispatching) {
+    AtomicCountHandler steady;
+    dispatcher->subscribe<TestEvent>(&steady);
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> dispatchers;
+    for (int t = 0; t < 3; ++t) {
+        dispatchers.emplace_back([this, &done]() {
+            do {
+                dispatcher->dispatch(TestEvent(0));
+            } while (!done.load());
+        });
+    }
+
+    std::vector<std::unique_ptr<AtomicCountHandler>> transient;
+    for (int i = 0; i < 200; ++i) {
+        transient.push_back(std::make_unique<AtomicCountHandler>());
+        dispatcher->subscribe<TestEvent>(transient.back().get());
+        if (i % 2 == 1) {
+            dispatcher->unsubscribe<TestEvent>(transient[i - 1].get());
+        }
+    }
+
+    done = true;
+    for (auto& thread : dispatchers) {
+        thread.join();
+    }
+
+    EXPECT_EQ(dispatcher->getHandlerCount<TestEvent>(), 101);
+    EXPECT_GT(steady.getCallCount(), 0);
+}
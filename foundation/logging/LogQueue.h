@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace VoxelEditor {
+namespace Logging {
+
+// Bounded ring buffer for many producers and one consumer. Each slot carries
+// a sequence number that tells producers whether it is free and the consumer
+// whether it has been filled, so neither side takes a lock. A full queue
+// rejects the push instead of blocking.
+template <typename T>
+class LogQueue {
+public:
+    // Capacity is rounded up to a power of two
+    explicit LogQueue(size_t capacity) {
+        size_t size = roundCapacity(capacity);
+        m_mask = size - 1;
+        m_cells = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    LogQueue(const LogQueue&) = delete;
+    LogQueue& operator=(const LogQueue&) = delete;
+
+    // Safe from any thread; returns false when the queue is full
+    bool tryPush(T&& value) {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only; returns false when the next slot isn't filled yet
+    bool tryPop(T& out) {
+        Cell& cell = m_cells[m_dequeuePos & m_mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(m_dequeuePos + 1) < 0) {
+            return false;
+        }
+        out = std::move(cell.value);
+        cell.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+        ++m_dequeuePos;
+        return true;
+    }
+
+    // Consumer thread only; true when the next slot has been filled
+    bool hasPending() const {
+        const Cell& cell = m_cells[m_dequeuePos & m_mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        return static_cast<intptr_t>(sequence) - static_cast<intptr_t>(m_dequeuePos + 1) >= 0;
+    }
+
+    // Number of pushes that have claimed a slot so far
+    size_t getPushCount() const {
+        return m_enqueuePos.load(std::memory_order_acquire);
+    }
+
+    size_t getCapacity() const {
+        return m_mask + 1;
+    }
+
+    static size_t roundCapacity(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) size_t m_dequeuePos = 0;
+};
+
+}
+}
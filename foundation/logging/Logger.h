@@ -1,13 +1,26 @@
 #pragma once
 
 #include "LogOutput.h"
+#include "LogQueue.h"
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <chrono>
 #include <thread>
+#include <string_view>
+#include <cstdio>
+
+// Messages below this level are compiled out: the level check folds to false
+// and the LOG_* macros don't evaluate their arguments.
+// 0 = Debug (keep everything), 1 = Info, 2 = Warning, 3 = Error, 4 = None
+#ifndef VOXEL_EDITOR_LOG_MIN_LEVEL
+#define VOXEL_EDITOR_LOG_MIN_LEVEL 0
+#endif
 
 namespace VoxelEditor {
 namespace Logging {
@@ -21,14 +34,60 @@ public:
         return instance;
     }
     
+    static constexpr Level COMPILED_MIN_LEVEL = static_cast<Level>(VOXEL_EDITOR_LOG_MIN_LEVEL);
+    
+    static constexpr bool isCompiledIn(Level level) {
+        return level >= COMPILED_MIN_LEVEL;
+    }
+    
+    ~Logger() {
+        stopWriter();
+    }
+    
     void setLevel(Level level) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_level = level;
+        m_level.store(level, std::memory_order_relaxed);
     }
     
     Level getLevel() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_level;
+        return m_level.load(std::memory_order_relaxed);
+    }
+    
+    // Lock-free; use it to skip building expensive messages
+    bool isEnabled(Level level) const {
+        return isCompiledIn(level) && level >= m_level.load(std::memory_order_relaxed);
+    }
+    
+    // In async mode callers only queue the message; a background thread
+    // stamps it and writes it to the outputs, so console and file I/O never
+    // block the caller. When the queue is full the message is dropped and
+    // counted. Errors still wait until they have been written. Switch modes
+    // at startup or shutdown, not while other threads are logging.
+    void setAsync(bool enabled, size_t queueCapacity = DEFAULT_QUEUE_CAPACITY) {
+        std::lock_guard<std::mutex> lock(m_writerControlMutex);
+        if (enabled == m_async.load(std::memory_order_relaxed)) {
+            return;
+        }
+        if (enabled) {
+            if (!m_queue || m_queue->getCapacity() != LogQueue<LogRecord>::roundCapacity(queueCapacity)) {
+                m_queue = std::make_unique<LogQueue<LogRecord>>(queueCapacity);
+                m_writtenCount.store(0, std::memory_order_relaxed);
+            }
+            m_stopWriter.store(false, std::memory_order_relaxed);
+            m_writer = std::thread(&Logger::runWriter, this);
+            m_async.store(true, std::memory_order_release);
+        } else {
+            m_async.store(false, std::memory_order_release);
+            stopWriterLocked();
+        }
+    }
+    
+    bool isAsync() const {
+        return m_async.load(std::memory_order_acquire);
+    }
+    
+    // Messages dropped because the async queue was full
+    size_t getDroppedMessageCount() const {
+        return m_droppedMessages.load(std::memory_order_relaxed);
     }
     
     void addOutput(std::unique_ptr<LogOutput> output) {
@@ -57,7 +116,9 @@ public:
         return m_outputs.size();
     }
     
+    // In async mode this waits until everything queued so far is written
     void flush() {
+        waitForWriter();
         std::lock_guard<std::mutex> lock(m_mutex);
         for (auto& output : m_outputs) {
             output->flush();
@@ -81,78 +142,132 @@ public:
     }
     
     template<typename T, typename... Args>
-    void debugf(const std::string& format, T&& arg, Args&&... args) {
-        if (shouldLog(Level::Debug)) {
-            log(Level::Debug, formatString(format, std::forward<T>(arg), std::forward<Args>(args)...), "");
+    void debugf(std::string_view format, T&& arg, Args&&... args) {
+        if constexpr (isCompiledIn(Level::Debug)) {
+            if (isEnabled(Level::Debug)) {
+                log(Level::Debug, formatString(format, std::forward<T>(arg), std::forward<Args>(args)...), "");
+            }
         }
     }
     
     template<typename T, typename... Args>
-    void infof(const std::string& format, T&& arg, Args&&... args) {
-        if (shouldLog(Level::Info)) {
-            log(Level::Info, formatString(format, std::forward<T>(arg), std::forward<Args>(args)...), "");
+    void infof(std::string_view format, T&& arg, Args&&... args) {
+        if constexpr (isCompiledIn(Level::Info)) {
+            if (isEnabled(Level::Info)) {
+                log(Level::Info, formatString(format, std::forward<T>(arg), std::forward<Args>(args)...), "");
+            }
         }
     }
     
     template<typename T, typename... Args>
-    void warningf(const std::string& format, T&& arg, Args&&... args) {
-        if (shouldLog(Level::Warning)) {
-            log(Level::Warning, formatString(format, std::forward<T>(arg), std::forward<Args>(args)...), "");
+    void warningf(std::string_view format, T&& arg, Args&&... args) {
+        if constexpr (isCompiledIn(Level::Warning)) {
+            if (isEnabled(Level::Warning)) {
+                log(Level::Warning, formatString(format, std::forward<T>(arg), std::forward<Args>(args)...), "");
+            }
         }
     }
     
     template<typename T, typename... Args>
-    void errorf(const std::string& format, T&& arg, Args&&... args) {
-        if (shouldLog(Level::Error)) {
-            log(Level::Error, formatString(format, std::forward<T>(arg), std::forward<Args>(args)...), "");
+    void errorf(std::string_view format, T&& arg, Args&&... args) {
+        if constexpr (isCompiledIn(Level::Error)) {
+            if (isEnabled(Level::Error)) {
+                log(Level::Error, formatString(format, std::forward<T>(arg), std::forward<Args>(args)...), "");
+            }
         }
     }
     
     template<typename... Args>
-    void debugfc(const std::string& component, const std::string& format, Args&&... args) {
-        if (shouldLog(Level::Debug)) {
-            log(Level::Debug, formatString(format, std::forward<Args>(args)...), component);
+    void debugfc(std::string_view component, std::string_view format, Args&&... args) {
+        if constexpr (isCompiledIn(Level::Debug)) {
+            if (isEnabled(Level::Debug)) {
+                log(Level::Debug, formatString(format, std::forward<Args>(args)...), std::string(component));
+            }
         }
     }
     
     template<typename... Args>
-    void infofc(const std::string& component, const std::string& format, Args&&... args) {
-        if (shouldLog(Level::Info)) {
-            log(Level::Info, formatString(format, std::forward<Args>(args)...), component);
+    void infofc(std::string_view component, std::string_view format, Args&&... args) {
+        if constexpr (isCompiledIn(Level::Info)) {
+            if (isEnabled(Level::Info)) {
+                log(Level::Info, formatString(format, std::forward<Args>(args)...), std::string(component));
+            }
         }
     }
     
     template<typename... Args>
-    void warningfc(const std::string& component, const std::string& format, Args&&... args) {
-        if (shouldLog(Level::Warning)) {
-            log(Level::Warning, formatString(format, std::forward<Args>(args)...), component);
+    void warningfc(std::string_view component, std::string_view format, Args&&... args) {
+        if constexpr (isCompiledIn(Level::Warning)) {
+            if (isEnabled(Level::Warning)) {
+                log(Level::Warning, formatString(format, std::forward<Args>(args)...), std::string(component));
+            }
         }
     }
     
     template<typename... Args>
-    void errorfc(const std::string& component, const std::string& format, Args&&... args) {
-        if (shouldLog(Level::Error)) {
-            log(Level::Error, formatString(format, std::forward<Args>(args)...), component);
+    void errorfc(std::string_view component, std::string_view format, Args&&... args) {
+        if constexpr (isCompiledIn(Level::Error)) {
+            if (isEnabled(Level::Error)) {
+                log(Level::Error, formatString(format, std::forward<Args>(args)...), std::string(component));
+            }
         }
     }
     
 private:
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 8192;
+    
+    // A queued message; the timestamp and thread id are formatted by the writer
+    struct LogRecord {
+        Level level = Level::Info;
+        std::string component;
+        std::string message;
+        std::chrono::system_clock::time_point time;
+        std::thread::id threadId;
+    };
+    
     Logger() : m_level(Level::Info) {
         // Add default console output
         addOutput(std::make_unique<ConsoleOutput>());
     }
     
-    Level m_level;
+    std::atomic<Level> m_level;
     std::vector<std::unique_ptr<LogOutput>> m_outputs;
-    mutable std::mutex m_mutex;
+    mutable std::mutex m_mutex;  // Guards m_outputs and the writes to them
     
-    bool shouldLog(Level level) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return level >= m_level;
-    }
+    std::atomic<bool> m_async{false};
+    std::unique_ptr<LogQueue<LogRecord>> m_queue;
+    std::thread m_writer;
+    std::mutex m_writerControlMutex;
+    std::atomic<bool> m_stopWriter{false};
+    std::atomic<bool> m_writerSleeping{false};
+    std::atomic<size_t> m_writtenCount{0};
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;     // Writer waits for messages
+    std::condition_variable m_writtenCondition;  // flush() waits for the writer
+    std::atomic<size_t> m_droppedMessages{0};
+    size_t m_reportedDrops = 0;  // Writer thread only
     
     void log(Level level, const std::string& message, const std::string& component) {
-        if (!shouldLog(level)) {
+        if (!isEnabled(level)) {
+            return;
+        }
+        
+        if (m_async.load(std::memory_order_acquire)) {
+            LogRecord record;
+            record.level = level;
+            record.component = component;
+            record.message = message;
+            record.time = std::chrono::system_clock::now();
+            record.threadId = std::this_thread::get_id();
+            if (m_queue->tryPush(std::move(record))) {
+                wakeWriter();
+            } else {
+                m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (level >= Level::Error) {
+                // Make sure errors are on disk before a possible crash
+                waitForWriter();
+            }
             return;
         }
         
@@ -160,18 +275,119 @@ private:
         logMsg.level = level;
         logMsg.component = component;
         logMsg.message = message;
-        logMsg.timestamp = getCurrentTimestamp();
+        logMsg.timestamp = formatTimestamp(std::chrono::system_clock::now());
         logMsg.threadId = getThreadId();
         
-        
         std::lock_guard<std::mutex> lock(m_mutex);
         for (auto& output : m_outputs) {
             output->write(logMsg);
         }
     }
     
-    std::string getCurrentTimestamp() const {
-        auto now = std::chrono::system_clock::now();
+    void runWriter() {
+        LogRecord record;
+        LogMessage logMsg;
+        for (;;) {
+            size_t written = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                while (m_queue->tryPop(record)) {
+                    logMsg.level = record.level;
+                    logMsg.component = std::move(record.component);
+                    logMsg.message = std::move(record.message);
+                    logMsg.timestamp = formatTimestamp(record.time);
+                    logMsg.threadId = formatThreadId(record.threadId);
+                    for (auto& output : m_outputs) {
+                        output->write(logMsg);
+                    }
+                    ++written;
+                }
+                reportDroppedMessages();
+            }
+            
+            if (written > 0) {
+                std::lock_guard<std::mutex> lock(m_wakeMutex);
+                m_writtenCount.fetch_add(written, std::memory_order_release);
+                m_writtenCondition.notify_all();
+                continue;
+            }
+            
+            if (m_stopWriter.load(std::memory_order_acquire)) {
+                break;
+            }
+            
+            // Producers only take m_wakeMutex when they see this flag, so
+            // the flag and the queue check must not be reordered
+            m_writerSleeping.store(true, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                m_wakeCondition.wait_for(lock, std::chrono::milliseconds(100), [this]() {
+                    return m_stopWriter.load(std::memory_order_acquire) || m_queue->hasPending();
+                });
+            }
+            m_writerSleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+    
+    void wakeWriter() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_writerSleeping.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_wakeCondition.notify_one();
+        }
+    }
+    
+    // Called by the writer with m_mutex held
+    void reportDroppedMessages() {
+        size_t dropped = m_droppedMessages.load(std::memory_order_relaxed);
+        if (dropped == m_reportedDrops) {
+            return;
+        }
+        LogMessage logMsg;
+        logMsg.level = Level::Warning;
+        logMsg.component = "Logger";
+        logMsg.message = "Log queue full, dropped " + std::to_string(dropped - m_reportedDrops) + " messages";
+        logMsg.timestamp = formatTimestamp(std::chrono::system_clock::now());
+        logMsg.threadId = getThreadId();
+        for (auto& output : m_outputs) {
+            output->write(logMsg);
+        }
+        m_reportedDrops = dropped;
+    }
+    
+    void waitForWriter() {
+        if (!m_async.load(std::memory_order_acquire)) {
+            return;
+        }
+        size_t target = m_queue->getPushCount();
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.notify_one();
+        m_writtenCondition.wait(lock, [this, target]() {
+            return m_writtenCount.load(std::memory_order_acquire) >= target;
+        });
+    }
+    
+    void stopWriter() {
+        std::lock_guard<std::mutex> lock(m_writerControlMutex);
+        m_async.store(false, std::memory_order_release);
+        stopWriterLocked();
+    }
+    
+    void stopWriterLocked() {
+        if (!m_writer.joinable()) {
+            return;
+        }
+        // The writer drains the queue before it checks the stop flag
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_stopWriter.store(true, std::memory_order_release);
+            m_wakeCondition.notify_one();
+        }
+        m_writer.join();
+    }
+    
+    static std::string formatTimestamp(std::chrono::system_clock::time_point now) {
         auto time_t = std::chrono::system_clock::to_time_t(now);
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
             now.time_since_epoch()) % 1000;
@@ -182,14 +398,20 @@ private:
         return ss.str();
     }
     
-    std::string getThreadId() const {
+    static std::string formatThreadId(std::thread::id id) {
         std::stringstream ss;
-        ss << std::this_thread::get_id();
+        ss << id;
         return ss.str();
     }
     
+    static const std::string& getThreadId() {
+        thread_local const std::string id = formatThreadId(std::this_thread::get_id());
+        return id;
+    }
+    
     template<typename... Args>
-    std::string formatString(const std::string& format, Args&&... args) const {
+    std::string formatString(std::string_view formatView, Args&&... args) const {
+        std::string format(formatView);
         if constexpr (sizeof...(args) == 0) {
             return format;
         } else {
@@ -201,16 +423,27 @@ private:
     }
 };
 
-// Convenience macros
-#define LOG_DEBUG(msg) VoxelEditor::Logging::Logger::getInstance().debug(msg)
-#define LOG_INFO(msg) VoxelEditor::Logging::Logger::getInstance().info(msg)
-#define LOG_WARNING(msg) VoxelEditor::Logging::Logger::getInstance().warning(msg)
-#define LOG_ERROR(msg) VoxelEditor::Logging::Logger::getInstance().error(msg)
+// Convenience macros. Arguments are only evaluated when the level is
+// compiled in and enabled.
+#define VOXEL_EDITOR_LOG_AT(level, method, ...) \
+    do { \
+        if constexpr (VoxelEditor::Logging::Logger::isCompiledIn(level)) { \
+            auto& voxelEditorLogger = VoxelEditor::Logging::Logger::getInstance(); \
+            if (voxelEditorLogger.isEnabled(level)) { \
+                voxelEditorLogger.method(__VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(msg) VOXEL_EDITOR_LOG_AT(VoxelEditor::Logging::LogLevel::Debug, debug, msg)
+#define LOG_INFO(msg) VOXEL_EDITOR_LOG_AT(VoxelEditor::Logging::LogLevel::Info, info, msg)
+#define LOG_WARNING(msg) VOXEL_EDITOR_LOG_AT(VoxelEditor::Logging::LogLevel::Warning, warning, msg)
+#define LOG_ERROR(msg) VOXEL_EDITOR_LOG_AT(VoxelEditor::Logging::LogLevel::Error, error, msg)
 
-#define LOG_DEBUG_C(component, msg) VoxelEditor::Logging::Logger::getInstance().debug(msg, component)
-#define LOG_INFO_C(component, msg) VoxelEditor::Logging::Logger::getInstance().info(msg, component)
-#define LOG_WARNING_C(component, msg) VoxelEditor::Logging::Logger::getInstance().warning(msg, component)
-#define LOG_ERROR_C(component, msg) VoxelEditor::Logging::Logger::getInstance().error(msg, component)
+#define LOG_DEBUG_C(component, msg) VOXEL_EDITOR_LOG_AT(VoxelEditor::Logging::LogLevel::Debug, debug, msg, component)
+#define LOG_INFO_C(component, msg) VOXEL_EDITOR_LOG_AT(VoxelEditor::Logging::LogLevel::Info, info, msg, component)
+#define LOG_WARNING_C(component, msg) VOXEL_EDITOR_LOG_AT(VoxelEditor::Logging::LogLevel::Warning, warning, msg, component)
+#define LOG_ERROR_C(component, msg) VOXEL_EDITOR_LOG_AT(VoxelEditor::Logging::LogLevel::Error, error, msg, component)
 
 }
 }
\ No newline at end of file
@@ -3,16 +3,31 @@
 #include <string>
 #include <chrono>
 #include <unordered_map>
-#include <stack>
 #include <vector>
+#include <memory>
 #include <mutex>
+#include <atomic>
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cstdio>
+
+// PROFILE_SCOPE and PROFILE_FUNCTION compile to nothing when this is 0.
+// The build sets it from the VOXEL_EDITOR_ENABLE_PROFILING option.
+#ifndef VOXEL_EDITOR_PROFILING
+#define VOXEL_EDITOR_PROFILING 1
+#endif
 
 namespace VoxelEditor {
 namespace Logging {
 
+// Sections are timed per thread: each thread keeps its own section stack and
+// appends to its own event buffer, so parallel workers nest correctly and
+// begin/end never take a lock. Section names are interned to small ids;
+// PROFILE_SCOPE does that once per call site. Readers (getResults,
+// exportChromeTrace) merge the per-thread buffers on demand.
 class PerformanceProfiler {
 public:
     struct ProfileData {
@@ -22,142 +37,193 @@ public:
         uint64_t callCount;
         double minTime;
         double maxTime;
-        
-        ProfileData() 
-            : totalTime(0.0), averageTime(0.0), callCount(0), 
+
+        ProfileData()
+            : totalTime(0.0), averageTime(0.0), callCount(0),
               minTime(std::numeric_limits<double>::max()), maxTime(0.0) {}
     };
-    
+
+    // Most distinct section names; later names share the overflow id 0
+    static constexpr uint32_t MAX_SECTION_NAMES = 4096;
+    // Trace events kept per thread until reset(); later ones still count
+    // towards getResults() but are left out of the trace
+    static constexpr size_t MAX_TRACE_EVENTS_PER_THREAD = 1 << 18;
+
     static PerformanceProfiler& getInstance() {
-        static PerformanceProfiler instance;
-        return instance;
+        // Never destroyed: worker threads may still close sections while
+        // static destructors run
+        static PerformanceProfiler* instance = new PerformanceProfiler();
+        return *instance;
     }
-    
+
+    // Id of a section name. Ids stay valid for the life of the process, so
+    // hot call sites can look a name up once and keep the id.
+    uint32_t getSectionId(const std::string& name) {
+        ThreadState& state = threadState();
+        auto it = state.nameCache.find(name);
+        if (it != state.nameCache.end()) {
+            return it->second;
+        }
+        uint32_t id = internName(name);
+        state.nameCache.emplace(name, id);
+        return id;
+    }
+
     void beginSection(const std::string& name) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
-        auto now = std::chrono::high_resolution_clock::now();
-        m_sectionStack.push({name, now});
+        beginSection(getSectionId(name));
     }
-    
+
+    void beginSection(uint32_t sectionId) {
+        ThreadState& state = threadState();
+        state.stack.push_back({sectionId, m_epoch.load(std::memory_order_relaxed), now()});
+    }
+
     void endSection(const std::string& name) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
-        if (m_sectionStack.empty()) {
+        endSection(getSectionId(name));
+    }
+
+    void endSection(uint32_t sectionId) {
+        uint64_t endNs = now();
+        ThreadState& state = threadState();
+
+        if (state.stack.empty()) {
             return; // No matching begin
         }
-        
-        auto top = m_sectionStack.top();
-        if (top.name != name) {
+
+        OpenSection top = state.stack.back();
+        if (top.sectionId != sectionId) {
             return; // Mismatched section names
         }
-        
-        m_sectionStack.pop();
-        
-        auto now = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration<double, std::milli>(now - top.startTime).count();
-        
-        auto& data = m_sections[name];
-        data.name = name;
-        data.totalTime += duration;
-        data.callCount++;
-        data.averageTime = data.totalTime / data.callCount;
-        data.minTime = std::min(data.minTime, duration);
-        data.maxTime = std::max(data.maxTime, duration);
-    }
-    
+
+        state.stack.pop_back();
+
+        if (top.epoch != m_epoch.load(std::memory_order_relaxed)) {
+            return; // Opened before the last reset()
+        }
+
+        record(threadBuffer(state), sectionId, top.startNs, endNs - top.startNs);
+    }
+
+    // Label the calling thread in exported traces
+    void setThreadName(const std::string& name) {
+        ThreadBuffer& buffer = threadBuffer(threadState());
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        buffer.name = name;
+    }
+
     void recordMemoryAllocation(size_t size, const std::string& category) {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_memoryStats[category].allocatedBytes += size;
         m_memoryStats[category].allocationCount++;
     }
-    
+
     void recordMemoryDeallocation(size_t size, const std::string& category) {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_memoryStats[category].deallocatedBytes += size;
         m_memoryStats[category].deallocationCount++;
     }
-    
+
     std::vector<ProfileData> getResults() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
+        std::unordered_map<uint32_t, ProfileData> merged;
+        {
+            std::lock_guard<std::mutex> lock(m_registryMutex);
+            for (const auto& buffer : m_buffers) {
+                buffer->forEachStats([&merged](uint32_t id, uint64_t calls, uint64_t totalNs,
+                                               uint64_t minNs, uint64_t maxNs) {
+                    auto& data = merged[id];
+                    data.callCount += calls;
+                    data.totalTime += totalNs / 1e6;
+                    data.minTime = std::min(data.minTime, minNs / 1e6);
+                    data.maxTime = std::max(data.maxTime, maxNs / 1e6);
+                });
+            }
+        }
+
         std::vector<ProfileData> results;
-        results.reserve(m_sections.size());
-        
-        for (const auto& pair : m_sections) {
-            results.push_back(pair.second);
+        results.reserve(merged.size());
+        {
+            std::lock_guard<std::mutex> lock(m_nameMutex);
+            for (auto& pair : merged) {
+                pair.second.name = m_names[pair.first];
+                pair.second.averageTime = pair.second.totalTime / pair.second.callCount;
+                results.push_back(std::move(pair.second));
+            }
         }
-        
+
         // Sort by total time descending
         std::sort(results.begin(), results.end(),
             [](const ProfileData& a, const ProfileData& b) {
                 return a.totalTime > b.totalTime;
             });
-        
+
         return results;
     }
-    
+
+    // Trace events that didn't fit in the per-thread buffers since reset()
+    uint64_t getDroppedEventCount() const {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        uint64_t dropped = 0;
+        for (const auto& buffer : m_buffers) {
+            dropped += buffer->droppedEvents.load(std::memory_order_relaxed);
+        }
+        return dropped;
+    }
+
     struct MemoryStats {
         size_t allocatedBytes = 0;
         size_t deallocatedBytes = 0;
         uint64_t allocationCount = 0;
         uint64_t deallocationCount = 0;
-        
+
         size_t getCurrentUsage() const {
             return allocatedBytes - deallocatedBytes;
         }
     };
-    
+
     std::unordered_map<std::string, MemoryStats> getMemoryStats() const {
         std::lock_guard<std::mutex> lock(m_mutex);
         return m_memoryStats;
     }
-    
+
+    // Drop all timings, trace events and memory stats. Sections still open
+    // on any thread are discarded when they end. Buffers are cleared in
+    // place, so call this while no other thread is inside a profiled scope.
     void reset() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_sections.clear();
-        m_memoryStats.clear();
-        // Clear the stack
-        while (!m_sectionStack.empty()) {
-            m_sectionStack.pop();
+        m_epoch.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(m_registryMutex);
+            for (auto& buffer : m_buffers) {
+                buffer->clear();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_memoryStats.clear();
         }
+        threadState().stack.clear();
     }
-    
+
     void saveReport(const std::string& filename) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
+        std::vector<ProfileData> results = getResults();
+
         std::ofstream file(filename);
         if (!file.is_open()) {
             return;
         }
-        
+
         file << "Performance Profile Report\n";
         file << "==========================\n\n";
-        
+
         // Timing data
         file << "Timing Profile:\n";
-        file << std::setw(30) << "Section Name" 
+        file << std::setw(30) << "Section Name"
              << std::setw(15) << "Total (ms)"
              << std::setw(15) << "Average (ms)"
              << std::setw(10) << "Calls"
              << std::setw(15) << "Min (ms)"
              << std::setw(15) << "Max (ms)" << "\n";
         file << std::string(100, '-') << "\n";
-        
-        // Create results directly without calling getResults() to avoid double-locking
-        std::vector<ProfileData> results;
-        results.reserve(m_sections.size());
-        
-        for (const auto& pair : m_sections) {
-            results.push_back(pair.second);
-        }
-        
-        // Sort by total time descending
-        std::sort(results.begin(), results.end(),
-            [](const ProfileData& a, const ProfileData& b) {
-                return a.totalTime > b.totalTime;
-            });
-        
+
         for (const auto& data : results) {
             file << std::setw(30) << data.name
                  << std::setw(15) << std::fixed << std::setprecision(3) << data.totalTime
@@ -166,8 +232,9 @@ public:
                  << std::setw(15) << std::fixed << std::setprecision(3) << data.minTime
                  << std::setw(15) << std::fixed << std::setprecision(3) << data.maxTime << "\n";
         }
-        
+
         // Memory data
+        std::lock_guard<std::mutex> lock(m_mutex);
         file << "\n\nMemory Profile:\n";
         file << std::setw(20) << "Category"
              << std::setw(15) << "Allocated"
@@ -176,7 +243,7 @@ public:
              << std::setw(10) << "Allocs"
              << std::setw(10) << "Deallocs" << "\n";
         file << std::string(85, '-') << "\n";
-        
+
         for (const auto& pair : m_memoryStats) {
             const auto& stats = pair.second;
             file << std::setw(20) << pair.first
@@ -186,40 +253,349 @@ public:
                  << std::setw(10) << stats.allocationCount
                  << std::setw(10) << stats.deallocationCount << "\n";
         }
-        
+
         file.close();
     }
-    
+
+    // Write the recorded sections as Chrome trace event JSON, which both
+    // chrome://tracing and ui.perfetto.dev open. Each profiled thread is a
+    // track; nested sections stack by time.
+    bool exportChromeTrace(const std::string& filename) const {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        std::vector<std::string> names;
+        {
+            std::lock_guard<std::mutex> lock(m_nameMutex);
+            names = m_names;
+        }
+
+        file << "{\"traceEvents\":[\n";
+        file << std::fixed << std::setprecision(3);
+        bool first = true;
+        auto separator = [&file, &first]() -> std::ofstream& {
+            file << (first ? "" : ",\n");
+            first = false;
+            return file;
+        };
+
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        for (const auto& buffer : m_buffers) {
+            std::string threadName = buffer->name.empty()
+                ? "Thread " + std::to_string(buffer->index) : buffer->name;
+            separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->index
+                        << ",\"args\":{\"name\":\"" << escapeJson(threadName) << "\"}}";
+
+            buffer->forEachEvent([&](const TraceEvent& event) {
+                // Timestamps are in microseconds
+                separator() << "{\"name\":\"" << escapeJson(names[event.sectionId])
+                            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->index
+                            << ",\"ts\":" << event.startNs / 1000.0
+                            << ",\"dur\":" << event.durationNs / 1000.0 << "}";
+            });
+        }
+        file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+        return file.good();
+    }
+
 private:
-    struct SectionInfo {
-        std::string name;
-        std::chrono::high_resolution_clock::time_point startTime;
+    PerformanceProfiler() : m_origin(std::chrono::steady_clock::now()) {
+        m_names.push_back("(other sections)");
+    }
+
+    struct OpenSection {
+        uint32_t sectionId;
+        uint32_t epoch;
+        uint64_t startNs;
+    };
+
+    struct TraceEvent {
+        uint64_t startNs;
+        uint64_t durationNs;
+        uint32_t sectionId;
+    };
+
+    struct EventChunk {
+        static constexpr size_t CAPACITY = 4096;
+        TraceEvent events[CAPACITY];
+        std::atomic<size_t> count{0};
+        std::atomic<EventChunk*> next{nullptr};
+    };
+
+    // Written only by the owning thread; readers load each field whole
+    struct SectionStats {
+        std::atomic<uint64_t> callCount{0};
+        std::atomic<uint64_t> totalNs{0};
+        std::atomic<uint64_t> minNs{std::numeric_limits<uint64_t>::max()};
+        std::atomic<uint64_t> maxNs{0};
+    };
+
+    struct StatsBlock {
+        static constexpr size_t SIZE = 64;
+        SectionStats entries[SIZE];
+    };
+
+    // One thread's stats and trace events. The owner appends without locks
+    // and publishes with release stores; a buffer outlives its thread and is
+    // handed to the next new thread, so short-lived workers reuse tracks.
+    class ThreadBuffer {
+    public:
+        explicit ThreadBuffer(uint32_t index) : index(index), m_tail(&m_head) {
+            for (auto& block : m_stats) {
+                block.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        ~ThreadBuffer() {
+            freeChunks();
+            for (auto& block : m_stats) {
+                delete block.load(std::memory_order_relaxed);
+            }
+        }
+
+        ThreadBuffer(const ThreadBuffer&) = delete;
+        ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+
+        SectionStats& stats(uint32_t sectionId) {
+            auto& slot = m_stats[sectionId / StatsBlock::SIZE];
+            StatsBlock* block = slot.load(std::memory_order_acquire);
+            if (!block) {
+                block = new StatsBlock();
+                slot.store(block, std::memory_order_release);
+            }
+            return block->entries[sectionId % StatsBlock::SIZE];
+        }
+
+        void append(const TraceEvent& event) {
+            if (m_eventCount >= MAX_TRACE_EVENTS_PER_THREAD) {
+                droppedEvents.store(droppedEvents.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+            size_t used = m_tail->count.load(std::memory_order_relaxed);
+            if (used == EventChunk::CAPACITY) {
+                EventChunk* chunk = new EventChunk();
+                m_tail->next.store(chunk, std::memory_order_release);
+                m_tail = chunk;
+                used = 0;
+            }
+            m_tail->events[used] = event;
+            m_tail->count.store(used + 1, std::memory_order_release);
+            ++m_eventCount;
+        }
+
+        template <typename Func>
+        void forEachEvent(Func&& func) const {
+            for (const EventChunk* chunk = &m_head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+                size_t count = chunk->count.load(std::memory_order_acquire);
+                for (size_t i = 0; i < count; ++i) {
+                    func(chunk->events[i]);
+                }
+            }
+        }
+
+        template <typename Func>
+        void forEachStats(Func&& func) const {
+            for (size_t b = 0; b < BLOCK_COUNT; ++b) {
+                const StatsBlock* block = m_stats[b].load(std::memory_order_acquire);
+                if (!block) continue;
+                for (size_t i = 0; i < StatsBlock::SIZE; ++i) {
+                    const SectionStats& s = block->entries[i];
+                    uint64_t calls = s.callCount.load(std::memory_order_acquire);
+                    if (calls == 0) continue;
+                    func(static_cast<uint32_t>(b * StatsBlock::SIZE + i), calls,
+                         s.totalNs.load(std::memory_order_relaxed),
+                         s.minNs.load(std::memory_order_relaxed),
+                         s.maxNs.load(std::memory_order_relaxed));
+                }
+            }
+        }
+
+        // Only safe while the owner isn't recording
+        void clear() {
+            freeChunks();
+            m_head.count.store(0, std::memory_order_relaxed);
+            m_tail = &m_head;
+            m_eventCount = 0;
+            droppedEvents.store(0, std::memory_order_relaxed);
+            for (auto& slot : m_stats) {
+                StatsBlock* block = slot.load(std::memory_order_relaxed);
+                if (!block) continue;
+                for (auto& s : block->entries) {
+                    s.callCount.store(0, std::memory_order_relaxed);
+                    s.totalNs.store(0, std::memory_order_relaxed);
+                    s.minNs.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+                    s.maxNs.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        const uint32_t index;
+        std::string name;  // Guarded by the registry mutex
+        std::atomic<bool> inUse{true};
+        std::atomic<uint64_t> droppedEvents{0};
+
+    private:
+        static constexpr size_t BLOCK_COUNT = MAX_SECTION_NAMES / StatsBlock::SIZE;
+
+        void freeChunks() {
+            EventChunk* chunk = m_head.next.load(std::memory_order_relaxed);
+            while (chunk) {
+                EventChunk* next = chunk->next.load(std::memory_order_relaxed);
+                delete chunk;
+                chunk = next;
+            }
+            m_head.next.store(nullptr, std::memory_order_relaxed);
+        }
+
+        EventChunk m_head;
+        EventChunk* m_tail;
+        size_t m_eventCount = 0;
+        std::atomic<StatsBlock*> m_stats[BLOCK_COUNT];
     };
-    
-    std::unordered_map<std::string, ProfileData> m_sections;
+
+    struct ThreadState {
+        ThreadBuffer* buffer = nullptr;
+        std::vector<OpenSection> stack;
+        std::unordered_map<std::string, uint32_t> nameCache;
+
+        ~ThreadState() {
+            if (buffer) {
+                buffer->inUse.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    static ThreadState& threadState() {
+        thread_local ThreadState state;
+        return state;
+    }
+
+    ThreadBuffer& threadBuffer(ThreadState& state) {
+        if (!state.buffer) {
+            std::lock_guard<std::mutex> lock(m_registryMutex);
+            for (auto& buffer : m_buffers) {
+                bool expected = false;
+                if (buffer->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    state.buffer = buffer.get();
+                    return *state.buffer;
+                }
+            }
+            m_buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(m_buffers.size())));
+            state.buffer = m_buffers.back().get();
+        }
+        return *state.buffer;
+    }
+
+    uint32_t internName(const std::string& name) {
+        std::lock_guard<std::mutex> lock(m_nameMutex);
+        auto it = m_nameIds.find(name);
+        if (it != m_nameIds.end()) {
+            return it->second;
+        }
+        if (m_names.size() >= MAX_SECTION_NAMES) {
+            return 0;
+        }
+        uint32_t id = static_cast<uint32_t>(m_names.size());
+        m_names.push_back(name);
+        m_nameIds.emplace(name, id);
+        return id;
+    }
+
+    void record(ThreadBuffer& buffer, uint32_t sectionId, uint64_t startNs, uint64_t durationNs) {
+        // Single writer, so load/store pairs are enough; the call count is
+        // published last so a reader that sees it also sees the time
+        SectionStats& stats = buffer.stats(sectionId);
+        stats.totalNs.store(stats.totalNs.load(std::memory_order_relaxed) + durationNs, std::memory_order_relaxed);
+        stats.minNs.store(std::min(stats.minNs.load(std::memory_order_relaxed), durationNs), std::memory_order_relaxed);
+        stats.maxNs.store(std::max(stats.maxNs.load(std::memory_order_relaxed), durationNs), std::memory_order_relaxed);
+        stats.callCount.store(stats.callCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+        buffer.append({startNs, durationNs, sectionId});
+    }
+
+    uint64_t now() const {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_origin).count());
+    }
+
+    static std::string escapeJson(const std::string& text) {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (char c : text) {
+            switch (c) {
+                case '"': escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                case '\t': escaped += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char code[8];
+                        std::snprintf(code, sizeof(code), "\\u%04x", c);
+                        escaped += code;
+                    } else {
+                        escaped += c;
+                    }
+            }
+        }
+        return escaped;
+    }
+
+    const std::chrono::steady_clock::time_point m_origin;
+    std::atomic<uint32_t> m_epoch{0};
+
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    mutable std::mutex m_registryMutex;
+
+    std::vector<std::string> m_names;
+    std::unordered_map<std::string, uint32_t> m_nameIds;
+    mutable std::mutex m_nameMutex;
+
     std::unordered_map<std::string, MemoryStats> m_memoryStats;
-    std::stack<SectionInfo> m_sectionStack;
     mutable std::mutex m_mutex;
 };
 
 // RAII profiling helper
 class ScopedProfiler {
 public:
-    explicit ScopedProfiler(const std::string& name) : m_name(name) {
-        PerformanceProfiler::getInstance().beginSection(m_name);
+    explicit ScopedProfiler(uint32_t sectionId) : m_sectionId(sectionId) {
+        PerformanceProfiler::getInstance().beginSection(m_sectionId);
+    }
+
+    explicit ScopedProfiler(const std::string& name)
+        : m_sectionId(PerformanceProfiler::getInstance().getSectionId(name)) {
+        PerformanceProfiler::getInstance().beginSection(m_sectionId);
     }
-    
+
     ~ScopedProfiler() {
-        PerformanceProfiler::getInstance().endSection(m_name);
+        PerformanceProfiler::getInstance().endSection(m_sectionId);
     }
-    
+
+    ScopedProfiler(const ScopedProfiler&) = delete;
+    ScopedProfiler& operator=(const ScopedProfiler&) = delete;
+
 private:
-    std::string m_name;
+    uint32_t m_sectionId;
 };
 
-// Convenience macros
-#define PROFILE_SCOPE(name) VoxelEditor::Logging::ScopedProfiler _prof(name)
-#define PROFILE_FUNCTION() VoxelEditor::Logging::ScopedProfiler _prof(__FUNCTION__)
+// Convenience macros. The name is interned once per call site, so it must
+// not change between calls; use ScopedProfiler directly for dynamic names.
+#define VOXEL_EDITOR_PROFILE_CONCAT_INNER(a, b) a##b
+#define VOXEL_EDITOR_PROFILE_CONCAT(a, b) VOXEL_EDITOR_PROFILE_CONCAT_INNER(a, b)
 
+#if VOXEL_EDITOR_PROFILING
+#define PROFILE_SCOPE(name) \
+    static const uint32_t VOXEL_EDITOR_PROFILE_CONCAT(_profId, __LINE__) = \
+        VoxelEditor::Logging::PerformanceProfiler::getInstance().getSectionId(name); \
+    VoxelEditor::Logging::ScopedProfiler VOXEL_EDITOR_PROFILE_CONCAT(_prof, __LINE__)( \
+        VOXEL_EDITOR_PROFILE_CONCAT(_profId, __LINE__))
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#endif
+
+}
 }
-}
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <thread>
 #include <chrono>
 #include <filesystem>
+#include <atomic>
+#include <vector>
 
 using namespace VoxelEditor::Logging;
 
@@ -246,4 +248,140 @@ TEST_F(LoggerTest, Macros) {
     EXPECT_EQ(messages[0].message, "Macro test message");
     EXPECT_EQ(messages[1].component, "MacroComponent");
     EXPECT_EQ(messages[1].message, "Debug macro test");
-}
\ No newline at end of file
+}
+
+TEST_F(LoggerTest, IsEnabled) {
+    Logger& logger = Logger::getInstance();
+    
+    logger.setLevel(LogLevel::Warning);
+    EXPECT_FALSE(logger.isEnabled(LogLevel::Debug));
+    EXPECT_FALSE(logger.isEnabled(LogLevel::Info));
+    EXPECT_TRUE(logger.isEnabled(LogLevel::Warning));
+    EXPECT_TRUE(logger.isEnabled(LogLevel::Error));
+}
+
+TEST_F(LoggerTest, MacrosSkipArgumentsWhenFiltered) {
+    Logger& logger = Logger::getInstance();
+    logger.setLevel(LogLevel::Warning);
+    
+    int evaluations = 0;
+    auto buildMessage = [&evaluations]() {
+        ++evaluations;
+        return std::string("expensive");
+    };
+    
+    LOG_DEBUG(buildMessage());
+    LOG_INFO_C("Component", buildMessage());
+    EXPECT_EQ(evaluations, 0);
+    
+    LOG_WARNING(buildMessage());
+    EXPECT_EQ(evaluations, 1);
+    EXPECT_EQ(m_testOutputPtr->getMessages().size(), 1);
+}
+
+TEST_F(LoggerTest, AsyncLoggingPreservesOrder) {
+    Logger& logger = Logger::getInstance();
+    logger.setAsync(true);
+    EXPECT_TRUE(logger.isAsync());
+    
+    for (int i = 0; i < 1000; ++i) {
+        logger.debugfc("Async", "Message %d", i);
+    }
+    logger.flush();
+    
+    const auto& messages = m_testOutputPtr->getMessages();
+    ASSERT_EQ(messages.size(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(messages[i].message, "Message " + std::to_string(i));
+        EXPECT_EQ(messages[i].component, "Async");
+    }
+    EXPECT_FALSE(messages[0].timestamp.empty());
+    EXPECT_FALSE(messages[0].threadId.empty());
+    
+    logger.setAsync(false);
+    EXPECT_FALSE(logger.isAsync());
+}
+
+TEST_F(LoggerTest, AsyncLoggingFromManyThreads) {
+    Logger& logger = Logger::getInstance();
+    logger.setAsync(true);
+    size_t droppedBefore = logger.getDroppedMessageCount();
+    
+    const int numThreads = 4;
+    const int messagesPerThread = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&logger, t, messagesPerThread]() {
+            for (int i = 0; i < messagesPerThread; ++i) {
+                logger.infofc("Thread", "Thread %d message %d", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    // Stopping async mode drains the queue
+    logger.setAsync(false);
+    
+    EXPECT_EQ(logger.getDroppedMessageCount(), droppedBefore);
+    EXPECT_EQ(m_testOutputPtr->getMessages().size(),
+              static_cast<size_t>(numThreads * messagesPerThread));
+}
+
+class BlockingLogOutput : public LogOutput {
+public:
+    void write(const LogMessage& message) override {
+        while (!m_released.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        m_messages.push_back(message);
+    }
+    
+    std::string getName() const override {
+        return "Blocking";
+    }
+    
+    void release() {
+        m_released.store(true);
+    }
+    
+    const std::vector<LogMessage>& getMessages() const {
+        return m_messages;
+    }
+    
+private:
+    std::atomic<bool> m_released{false};
+    std::vector<LogMessage> m_messages;
+};
+
+TEST_F(LoggerTest, AsyncLoggingDropsWhenQueueIsFull) {
+    Logger& logger = Logger::getInstance();
+    logger.clearOutputs();
+    auto output = std::make_unique<BlockingLogOutput>();
+    BlockingLogOutput* outputPtr = output.get();
+    logger.addOutput(std::move(output));
+    
+    // The output stalls, so the small queue fills up; callers must not block
+    logger.setAsync(true, 8);
+    size_t droppedBefore = logger.getDroppedMessageCount();
+    for (int i = 0; i < 100; ++i) {
+        logger.info("Message " + std::to_string(i));
+    }
+    size_t dropped = logger.getDroppedMessageCount() - droppedBefore;
+    EXPECT_GT(dropped, 0u);
+    
+    outputPtr->release();
+    logger.flush();
+    
+    const auto& messages = outputPtr->getMessages();
+    ASSERT_FALSE(messages.empty());
+    EXPECT_EQ(messages[0].message, "Message 0");
+    EXPECT_NE(messages.back().message.find("dropped"), std::string::npos);
+    EXPECT_EQ(messages.size() - 1 + dropped, 100u);
+    
+    logger.setAsync(false);
+    // Restore the default queue size for later tests
+    logger.setAsync(true);
+    logger.setAsync(false);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+// Build this file as if VOXEL_EDITOR_LOG_MIN_LEVEL were set to Warning
+#undef VOXEL_EDITOR_LOG_MIN_LEVEL
+#define VOXEL_EDITOR_LOG_MIN_LEVEL 2
+#include "../Logger.h"
+
+#include <string>
+#include <vector>
+
+using namespace VoxelEditor::Logging;
+
+namespace {
+
+class CollectingOutput : public LogOutput {
+public:
+    void write(const LogMessage& message) override {
+        messages.push_back(message);
+    }
+    
+    std::string getName() const override {
+        return "Collecting";
+    }
+    
+    std::vector<LogMessage> messages;
+};
+
+}
+
+TEST(LoggerStrippedTest, LevelsBelowMinimumAreCompiledOut) {
+    static_assert(!Logger::isCompiledIn(LogLevel::Debug));
+    static_assert(!Logger::isCompiledIn(LogLevel::Info));
+    static_assert(Logger::isCompiledIn(LogLevel::Warning));
+    
+    Logger& logger = Logger::getInstance();
+    logger.clearOutputs();
+    auto output = std::make_unique<CollectingOutput>();
+    CollectingOutput* outputPtr = output.get();
+    logger.addOutput(std::move(output));
+    logger.setLevel(LogLevel::Debug);
+    
+    EXPECT_FALSE(logger.isEnabled(LogLevel::Debug));
+    
+    int evaluations = 0;
+    auto buildMessage = [&evaluations]() {
+        ++evaluations;
+        return std::string("message");
+    };
+    
+    logger.debug("debug");
+    logger.infofc("Component", "info %d", 1);
+    LOG_DEBUG(buildMessage());
+    LOG_INFO(buildMessage());
+    EXPECT_EQ(evaluations, 0);
+    EXPECT_TRUE(outputPtr->messages.empty());
+    
+    logger.warningfc("Component", "warning %d", 2);
+    LOG_ERROR(buildMessage());
+    EXPECT_EQ(evaluations, 1);
+    ASSERT_EQ(outputPtr->messages.size(), 2);
+    EXPECT_EQ(outputPtr->messages[0].message, "warning 2");
+    
+    logger.clearOutputs();
+    logger.setLevel(LogLevel::Info);
+}
@@ -3,6 +3,8 @@
 #include <thread>
 #include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <vector>
 
 using namespace VoxelEditor::Logging;
 
@@ -249,4 +251,100 @@ TEST_F(PerformanceProfilerTest, FunctionMacro) {
     auto results = profiler.getResults();
     ASSERT_EQ(results.size(), 1);
     EXPECT_EQ(results[0].name, "testFunction");
-}
\ No newline at end of file
+}
+
+TEST_F(PerformanceProfilerTest, ThreadsNestIndependently) {
+    PerformanceProfiler& profiler = PerformanceProfiler::getInstance();
+    const int threadCount = 4;
+    const int iterations = 200;
+
+    // Interleaved begin/end on several threads must not disturb each
+    // other's section stacks
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([iterations]() {
+            for (int i = 0; i < iterations; ++i) {
+                PROFILE_SCOPE("Outer");
+                PROFILE_SCOPE("Inner");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto results = profiler.getResults();
+    ASSERT_EQ(results.size(), 2);
+    for (const auto& data : results) {
+        EXPECT_EQ(data.callCount, static_cast<uint64_t>(threadCount * iterations)) << data.name;
+    }
+
+    const auto& outer = results[0].name == "Outer" ? results[0] : results[1];
+    const auto& inner = results[0].name == "Inner" ? results[0] : results[1];
+    EXPECT_GE(outer.totalTime, inner.totalTime);
+}
+
+TEST_F(PerformanceProfilerTest, SectionIdsAreStable) {
+    PerformanceProfiler& profiler = PerformanceProfiler::getInstance();
+
+    uint32_t id = profiler.getSectionId("StableSection");
+    EXPECT_EQ(profiler.getSectionId("StableSection"), id);
+    EXPECT_NE(profiler.getSectionId("OtherSection"), id);
+
+    // Ids and names are interchangeable
+    profiler.beginSection(id);
+    profiler.endSection("StableSection");
+
+    auto results = profiler.getResults();
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0].name, "StableSection");
+}
+
+TEST_F(PerformanceProfilerTest, SectionOpenAcrossResetIsDiscarded) {
+    PerformanceProfiler& profiler = PerformanceProfiler::getInstance();
+
+    std::thread worker([&profiler]() {
+        profiler.beginSection("Stale");
+        profiler.reset();
+        profiler.endSection("Stale");
+    });
+    worker.join();
+
+    EXPECT_TRUE(profiler.getResults().empty());
+}
+
+TEST_F(PerformanceProfilerTest, ExportChromeTrace) {
+    PerformanceProfiler& profiler = PerformanceProfiler::getInstance();
+    const std::string traceFile = "test_profile_trace.json";
+
+    profiler.setThreadName("Main \"UI\"");
+    {
+        PROFILE_SCOPE("TraceOuter");
+        PROFILE_SCOPE("TraceInner");
+    }
+    std::thread worker([&profiler]() {
+        profiler.setThreadName("Worker");
+        PROFILE_SCOPE("TraceWorker");
+    });
+    worker.join();
+
+    ASSERT_TRUE(profiler.exportChromeTrace(traceFile));
+
+    std::ifstream file(traceFile);
+    std::string content((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+
+    EXPECT_EQ(content.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(content.find("\"name\":\"TraceOuter\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(content.find("\"name\":\"TraceInner\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(content.find("\"name\":\"TraceWorker\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(content.find("Main \\\"UI\\\""), std::string::npos);
+    EXPECT_NE(content.find("\"args\":{\"name\":\"Worker\"}"), std::string::npos);
+    EXPECT_NE(content.find("\"displayTimeUnit\":\"ms\"}"), std::string::npos);
+
+    std::filesystem::remove(traceFile);
+}
+
+TEST_F(PerformanceProfilerTest, ExportChromeTraceToInvalidPath) {
+    EXPECT_FALSE(PerformanceProfiler::getInstance().exportChromeTrace("/nonexistent_dir/trace.json"));
+}
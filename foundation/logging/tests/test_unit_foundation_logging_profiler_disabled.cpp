@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+// Build this file as if VOXEL_EDITOR_ENABLE_PROFILING were OFF
+#undef VOXEL_EDITOR_PROFILING
+#define VOXEL_EDITOR_PROFILING 0
+#include "../PerformanceProfiler.h"
+
+using namespace VoxelEditor::Logging;
+
+namespace {
+
+int profiledFunction(int value) {
+    PROFILE_FUNCTION();
+    PROFILE_SCOPE("DisabledScope");
+    return value * 2;
+}
+
+}
+
+TEST(PerformanceProfilerDisabledTest, MacrosRecordNothing) {
+    PerformanceProfiler& profiler = PerformanceProfiler::getInstance();
+    profiler.reset();
+
+    EXPECT_EQ(profiledFunction(21), 42);
+    EXPECT_TRUE(profiler.getResults().empty());
+}
+
+TEST(PerformanceProfilerDisabledTest, ExplicitSectionsStillWork) {
+    PerformanceProfiler& profiler = PerformanceProfiler::getInstance();
+    profiler.reset();
+
+    {
+        ScopedProfiler scoped("ExplicitSection");
+    }
+
+    auto results = profiler.getResults();
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0].name, "ExplicitSection");
+    profiler.reset();
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
 #include <string>
 
 namespace VoxelEditor {
@@ -169,10 +170,12 @@ public:
     }
 
     size_t hash() const {
-        size_t h1 = ::std::hash<int>{}(x);
-        size_t h2 = ::std::hash<int>{}(y);
-        size_t h3 = ::std::hash<int>{}(z);
-        return h1 ^ (h2 << 1) ^ (h3 << 2);
+        // Multiplicative mix; shifting and xoring the raw coordinates sends
+        // nearby positions to a handful of buckets
+        uint64_t h = static_cast<uint32_t>(x) * 0x9E3779B97F4A7C15ull;
+        h = (h ^ (h >> 29)) + static_cast<uint32_t>(y) * 0xC2B2AE3D27D4EB4Full;
+        h = (h ^ (h >> 32)) + static_cast<uint32_t>(z) * 0x165667B19E3779F9ull;
+        return static_cast<size_t>(h ^ (h >> 31));
     }
 
     std::string toString() const {
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <memory_resource>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+#include <new>
+
+namespace VoxelEditor {
+namespace Memory {
+
+// Monotonic scratch allocator for temporaries that live for one frame or
+// one operation. Allocation bumps a pointer; nothing is freed individually.
+// rewind() returns to a marker and reset() to the start, keeping the memory,
+// so a steady workload stops touching the heap after its first pass.
+//
+// Not thread-safe: give each thread its own arena. Containers can use it
+// through getResource() (std::pmr).
+class FrameArena {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    struct Marker {
+        void* block = nullptr;
+        size_t offset = 0;
+    };
+
+    explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : m_blockSize(std::max(blockSize, sizeof(Block) * 2))
+        , m_upstream(upstream)
+        , m_resource(this) {
+    }
+
+    // Starts in a caller-owned buffer, which must outlive the arena; further
+    // blocks come from upstream
+    FrameArena(void* buffer, size_t size,
+               std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : FrameArena(DEFAULT_BLOCK_SIZE, upstream) {
+        void* aligned = buffer;
+        size_t space = size;
+        if (std::align(alignof(Block), sizeof(Block), aligned, space) && space > sizeof(Block)) {
+            m_first = new(aligned) Block{nullptr, space, false};
+            m_current = m_first;
+            m_offset = sizeof(Block);
+        }
+    }
+
+    ~FrameArena() {
+        release();
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+        if (m_current) {
+            if (void* ptr = bumpInBlock(m_current, m_offset, bytes, alignment)) {
+                return ptr;
+            }
+        }
+        return allocateSlow(bytes, alignment);
+    }
+
+    template<typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    Marker getMarker() const {
+        return Marker{m_current, m_offset};
+    }
+
+    // Everything allocated after the marker is discarded; the blocks stay
+    void rewind(const Marker& marker) {
+        if (!marker.block) {
+            rewindToStart();
+            return;
+        }
+        m_current = static_cast<Block*>(marker.block);
+        m_offset = marker.offset;
+        m_usedBeforeCurrent = 0;
+        for (Block* block = m_first; block != m_current; block = block->next) {
+            m_usedBeforeCurrent += block->size - sizeof(Block);
+        }
+    }
+
+    // Discards everything. If the last pass spilled into several blocks they
+    // are merged into one, so the next pass of the same size needs a single
+    // block and no upstream allocations.
+    void reset() {
+        size_t ownedSize = 0;
+        size_t ownedBlocks = 0;
+        for (Block* block = m_first; block; block = block->next) {
+            if (block->owned) {
+                ownedSize += block->size;
+                ++ownedBlocks;
+            }
+        }
+
+        if (ownedBlocks > 1) {
+            Block* external = (m_first && !m_first->owned) ? m_first : nullptr;
+            releaseOwned();
+            Block* merged = newBlock(ownedSize);
+            if (external) {
+                external->next = merged;
+            } else {
+                m_first = merged;
+            }
+        }
+        rewindToStart();
+    }
+
+    // Returns every owned block to upstream
+    void release() {
+        releaseOwned();
+        rewindToStart();
+    }
+
+    size_t getBytesUsed() const {
+        return m_current ? m_usedBeforeCurrent + m_offset - sizeof(Block) : 0;
+    }
+
+    size_t getPeakBytesUsed() const {
+        return m_peakBytes;
+    }
+
+    size_t getCapacity() const {
+        size_t capacity = 0;
+        for (Block* block = m_first; block; block = block->next) {
+            capacity += block->size - sizeof(Block);
+        }
+        return capacity;
+    }
+
+    // Blocks requested from upstream since construction
+    size_t getUpstreamAllocationCount() const {
+        return m_upstreamAllocations;
+    }
+
+    std::pmr::memory_resource* getResource() {
+        return &m_resource;
+    }
+
+private:
+    // Header at the start of every block; the rest of the block is handed out
+    struct Block {
+        Block* next;
+        size_t size;  // Including this header; capacity and usage exclude it
+        bool owned;
+    };
+
+    class Resource : public std::pmr::memory_resource {
+    public:
+        explicit Resource(FrameArena* arena) : m_arena(arena) {}
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            return m_arena->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void*, size_t, size_t) override {
+            // Reclaimed by rewind()/reset()
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+        FrameArena* m_arena;
+    };
+
+    void* bumpInBlock(Block* block, size_t& offset, size_t bytes, size_t alignment) {
+        uintptr_t base = reinterpret_cast<uintptr_t>(block);
+        uintptr_t start = (base + offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        if (start + bytes > base + block->size) {
+            return nullptr;
+        }
+        offset = start + bytes - base;
+        size_t used = m_usedBeforeCurrent + offset - sizeof(Block);
+        if (used > m_peakBytes) {
+            m_peakBytes = used;
+        }
+        return reinterpret_cast<void*>(start);
+    }
+
+    // Moves on to the next kept block that fits, or links in a new one
+    void* allocateSlow(size_t bytes, size_t alignment) {
+        while (m_current && m_current->next) {
+            m_usedBeforeCurrent += m_current->size - sizeof(Block);
+            m_current = m_current->next;
+            m_offset = sizeof(Block);
+            if (void* ptr = bumpInBlock(m_current, m_offset, bytes, alignment)) {
+                return ptr;
+            }
+        }
+
+        Block* block = newBlock(std::max(m_blockSize, sizeof(Block) + bytes + alignment));
+        if (m_current) {
+            m_usedBeforeCurrent += m_current->size - sizeof(Block);
+            m_current->next = block;
+        } else {
+            m_first = block;
+        }
+        m_current = block;
+        m_offset = sizeof(Block);
+
+        void* ptr = bumpInBlock(m_current, m_offset, bytes, alignment);
+        assert(ptr);
+        return ptr;
+    }
+
+    Block* newBlock(size_t size) {
+        void* memory = m_upstream->allocate(size, alignof(std::max_align_t));
+        ++m_upstreamAllocations;
+        return new(memory) Block{nullptr, size, true};
+    }
+
+    void releaseOwned() {
+        Block* block = m_first;
+        Block* external = nullptr;
+        while (block) {
+            Block* next = block->next;
+            if (block->owned) {
+                m_upstream->deallocate(block, block->size, alignof(std::max_align_t));
+            } else {
+                external = block;
+                external->next = nullptr;
+            }
+            block = next;
+        }
+        m_first = external;
+    }
+
+    void rewindToStart() {
+        m_current = m_first;
+        m_offset = m_first ? sizeof(Block) : 0;
+        m_usedBeforeCurrent = 0;
+    }
+
+    size_t m_blockSize;
+    std::pmr::memory_resource* m_upstream;
+    Resource m_resource;
+
+    Block* m_first = nullptr;
+    Block* m_current = nullptr;
+    size_t m_offset = 0;
+    size_t m_usedBeforeCurrent = 0;
+    size_t m_peakBytes = 0;
+    size_t m_upstreamAllocations = 0;
+};
+
+// Rewinds the arena to where it was when the scope opened. Containers using
+// the arena must be destroyed before the scope closes.
+class ArenaScope {
+public:
+    explicit ArenaScope(FrameArena& arena)
+        : m_arena(arena), m_marker(arena.getMarker()) {}
+
+    ~ArenaScope() {
+        m_arena.rewind(m_marker);
+    }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    FrameArena& m_arena;
+    FrameArena::Marker m_marker;
+};
+
+}
+}
@@ -0,0 +1,51 @@
+#include "MemoryGovernor.h"
+
+#include <cstdio>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace VoxelEditor {
+namespace Memory {
+
+size_t MemoryGovernor::sampleResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<size_t>(counters.WorkingSetSize);
+    }
+    return 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+        return static_cast<size_t>(info.resident_size);
+    }
+    return 0;
+#elif defined(__linux__)
+    // Second field of statm is the resident page count
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file) return 0;
+    unsigned long totalPages = 0;
+    unsigned long residentPages = 0;
+    int fields = std::fscanf(file, "%lu %lu", &totalPages, &residentPages);
+    std::fclose(file);
+    if (fields != 2) return 0;
+    return static_cast<size_t>(residentPages) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+} // namespace Memory
+} // namespace VoxelEditor
@@ -0,0 +1,275 @@
+#pragma once
+
+#include "MemoryOptimizer.h"
+#include <functional>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+
+namespace VoxelEditor {
+namespace Memory {
+
+// Keeps the process under one memory ceiling by trading memory between
+// subsystems. Each cache registers its usage, an optional budget, how much a
+// byte of it is worth and how to give memory back. When the resident set
+// passes the ceiling the governor compresses first, then evicts from the
+// cheapest bytes up, and finally falls back to the MemoryOptimizer cleanup
+// callbacks.
+//
+// Callbacks run under the governor's lock and must not call back into it.
+// unregisterCache() waits for a running rebalance, so a cache can unregister
+// from its owner's destructor.
+class MemoryGovernor {
+public:
+    using CacheId = size_t;
+
+    struct CacheRegistration {
+        std::string name;
+        size_t budgetBytes = 0;                          // 0 = limited only by the ceiling
+        float evictionCost = 1.0f;                       // Value of one cached byte; cheaper bytes go first
+        std::function<size_t()> getUsage;
+        std::function<size_t(size_t)> evict;             // Free at least the bytes asked for; returns bytes freed
+        std::function<size_t()> compress;                // Optional; returns bytes saved
+        std::function<float()> getValueScale;            // Optional, e.g. hit rate; multiplies evictionCost
+    };
+
+    struct CacheStats {
+        std::string name;
+        size_t usage;
+        size_t budgetBytes;
+        float valuePerByte;
+        size_t evictedBytes;
+        size_t compressedBytes;
+    };
+
+    struct RebalanceResult {
+        size_t residentBytes = 0;  // Sampled before releasing anything
+        size_t compressedBytes = 0;
+        size_t evictedBytes = 0;
+        size_t cleanupBytes = 0;   // Freed by the MemoryOptimizer fallback
+
+        size_t getReleasedBytes() const { return compressedBytes + evictedBytes + cleanupBytes; }
+    };
+
+    explicit MemoryGovernor(MemoryOptimizer* optimizer = nullptr)
+        : m_optimizer(optimizer)
+        , m_sampler(&MemoryGovernor::sampleResidentBytes) {}
+
+    CacheId registerCache(CacheRegistration registration) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        CacheId id = m_nextId++;
+        m_caches.push_back(Cache{id, std::move(registration), 0, 0});
+        return id;
+    }
+
+    void unregisterCache(CacheId id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_caches.erase(std::remove_if(m_caches.begin(), m_caches.end(),
+                                      [id](const Cache& cache) { return cache.id == id; }),
+                       m_caches.end());
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_caches.clear();
+    }
+
+    // Resident memory the process should stay under (0 disables)
+    void setCeiling(size_t bytes) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ceiling = bytes;
+    }
+
+    size_t getCeiling() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_ceiling;
+    }
+
+    // Once over the ceiling, release down to this fraction of it so the next
+    // few allocations do not trigger another pass straight away
+    void setTargetRatio(float ratio) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_targetRatio = std::clamp(ratio, 0.0f, 1.0f);
+    }
+
+    void setSampleInterval(std::chrono::milliseconds interval) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sampleInterval = interval;
+    }
+
+    // Replaces the RSS probe, e.g. with a fixed value in tests
+    void setResidentSampler(std::function<size_t()> sampler) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sampler = sampler ? std::move(sampler) : std::function<size_t()>(&MemoryGovernor::sampleResidentBytes);
+    }
+
+    // Cheap enough to call every frame: samples at most once per interval
+    bool update() {
+        auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_hasSampled && now - m_lastSample < m_sampleInterval) {
+                return false;
+            }
+            m_hasSampled = true;
+            m_lastSample = now;
+        }
+        return rebalance().getReleasedBytes() > 0;
+    }
+
+    // Brings every cache back within its budget, then releases memory across
+    // caches until the resident set is back under the target
+    RebalanceResult rebalance() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        RebalanceResult result;
+        enforceBudgets(result);
+
+        result.residentBytes = m_sampler();
+        if (m_ceiling == 0 || result.residentBytes <= m_ceiling) {
+            return result;
+        }
+
+        // Freed pages are not always returned to the OS right away, so count
+        // what the caches report rather than sampling again
+        size_t target = static_cast<size_t>(m_ceiling * m_targetRatio);
+        size_t needed = result.residentBytes - std::min(target, result.residentBytes);
+
+        std::vector<Cache*> order = cachesByValue();
+        for (Cache* cache : order) {
+            if (needed == 0) break;
+            size_t saved = compress(*cache);
+            result.compressedBytes += saved;
+            needed -= std::min(needed, saved);
+        }
+
+        for (Cache* cache : order) {
+            if (needed == 0) break;
+            size_t freed = evict(*cache, needed);
+            result.evictedBytes += freed;
+            needed -= std::min(needed, freed);
+        }
+
+        if (needed > 0 && m_optimizer) {
+            float ratio = static_cast<float>(result.residentBytes) / m_ceiling;
+            CleanupPriority priority = ratio > 1.1f ? CleanupPriority::Low : CleanupPriority::Medium;
+            result.cleanupBytes = m_optimizer->performCleanup(priority);
+        }
+
+        return result;
+    }
+
+    size_t getCacheCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_caches.size();
+    }
+
+    // Memory all registered caches report, which RSS includes
+    size_t getTrackedUsage() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t total = 0;
+        for (const Cache& cache : m_caches) {
+            total += usageOf(cache);
+        }
+        return total;
+    }
+
+    std::vector<CacheStats> getCacheStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<CacheStats> stats;
+        stats.reserve(m_caches.size());
+        for (const Cache& cache : m_caches) {
+            stats.push_back(CacheStats{cache.registration.name, usageOf(cache),
+                                       cache.registration.budgetBytes, valuePerByte(cache),
+                                       cache.evictedBytes, cache.compressedBytes});
+        }
+        return stats;
+    }
+
+    // Resident set size of this process, or 0 where it cannot be read
+    static size_t sampleResidentBytes();
+
+private:
+    struct Cache {
+        CacheId id;
+        CacheRegistration registration;
+        size_t evictedBytes;
+        size_t compressedBytes;
+    };
+
+    static size_t usageOf(const Cache& cache) {
+        return cache.registration.getUsage ? cache.registration.getUsage() : 0;
+    }
+
+    static float valuePerByte(const Cache& cache) {
+        float scale = cache.registration.getValueScale ? cache.registration.getValueScale() : 1.0f;
+        return cache.registration.evictionCost * scale;
+    }
+
+    static size_t compress(Cache& cache) {
+        if (!cache.registration.compress) return 0;
+        size_t saved = cache.registration.compress();
+        cache.compressedBytes += saved;
+        return saved;
+    }
+
+    static size_t evict(Cache& cache, size_t bytes) {
+        if (!cache.registration.evict || bytes == 0 || usageOf(cache) == 0) return 0;
+        size_t freed = cache.registration.evict(bytes);
+        cache.evictedBytes += freed;
+        return freed;
+    }
+
+    void enforceBudgets(RebalanceResult& result) {
+        for (Cache& cache : m_caches) {
+            size_t budget = cache.registration.budgetBytes;
+            if (budget == 0) continue;
+
+            size_t usage = usageOf(cache);
+            if (usage <= budget) continue;
+
+            size_t saved = compress(cache);
+            result.compressedBytes += saved;
+            usage = usageOf(cache);
+            if (usage > budget) {
+                result.evictedBytes += evict(cache, usage - budget);
+            }
+        }
+    }
+
+    // Cheapest bytes first; ties keep registration order
+    std::vector<Cache*> cachesByValue() {
+        std::vector<std::pair<float, Cache*>> ranked;
+        ranked.reserve(m_caches.size());
+        for (Cache& cache : m_caches) {
+            ranked.emplace_back(valuePerByte(cache), &cache);
+        }
+        std::stable_sort(ranked.begin(), ranked.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        std::vector<Cache*> order;
+        order.reserve(ranked.size());
+        for (const auto& entry : ranked) {
+            order.push_back(entry.second);
+        }
+        return order;
+    }
+
+    MemoryOptimizer* m_optimizer;
+    std::function<size_t()> m_sampler;
+    std::vector<Cache> m_caches;
+    CacheId m_nextId = 1;
+
+    size_t m_ceiling = 0;
+    float m_targetRatio = 0.85f;
+    std::chrono::milliseconds m_sampleInterval{500};
+    std::chrono::steady_clock::time_point m_lastSample;
+    bool m_hasSampled = false;
+
+    mutable std::mutex m_mutex;
+};
+
+}
+}
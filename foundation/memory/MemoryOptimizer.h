@@ -171,7 +171,7 @@ template<typename T>
 class ManagedMemoryPool {
 public:
     ManagedMemoryPool(const std::string& name, size_t initialCapacity = 64)
-        : m_pool(initialCapacity), m_name(name) {
+        : m_pool(initialCapacity, name.c_str()), m_name(name) {
         
         MemoryManager::getInstance().registerCleanupCallback(
             [this]() -> size_t {
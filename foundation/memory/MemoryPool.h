@@ -1,10 +1,15 @@
 #pragma once
 
+#include "MemoryTracker.h"
 #include <vector>
-#include <stack>
 #include <mutex>
+#include <atomic>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <cassert>
 #include <algorithm>
 #include <new>
@@ -12,60 +17,159 @@
 namespace VoxelEditor {
 namespace Memory {
 
+// Fixed-size object pool.
+//
+// Objects are carved from slabs aligned to the slab size, so masking a
+// pointer gives the slab it lives in and a lock-free table of slab addresses
+// answers "is this ours?" in O(1). Free objects are chained through their own
+// storage. Each thread keeps a small cache of free objects per pool and only
+// takes the pool mutex to move a batch between that cache and the shared free
+// list, so allocate() and deallocate() are normally lock-free.
+//
+// Object sizes are rounded up to a size class (a multiple of
+// alignof(max_align_t)) which fixes the slab layout.
+//
+// Used counts from other threads lag by at most one batch while those threads
+// are running and are exact once they have exited. The calling thread's own
+// allocations are always counted.
 class MemoryPool {
 public:
-    MemoryPool(size_t objectSize, size_t initialCapacity = 64)
+    static constexpr size_t MIN_SLAB_SIZE = 64 * 1024;
+    static constexpr size_t BATCH_SIZE = 32;
+
+    // Named pools report their occupancy through MemoryTracker::getPoolStats()
+    MemoryPool(size_t objectSize, size_t initialCapacity = 64, const char* name = nullptr)
         : m_objectSize(objectSize)
+        , m_stride(getSizeClass(objectSize))
+        , m_slabSize(slabSizeFor(m_stride))
+        , m_objectsPerSlab(m_slabSize / m_stride)
         , m_initialBlockSize(initialCapacity)
         , m_blockSize(initialCapacity)
-        , m_totalCapacity(0)
-        , m_usedCount(0) {
+        , m_name(name ? name : "") {
         assert(objectSize > 0);
         assert(initialCapacity > 0);
-        allocateNewBlock();
+
+        m_tag.store(registry().add(this), ::std::memory_order_release);
+        m_slabTable.store(newTableLocked(16), ::std::memory_order_release);
+        growLocked();
+
+        if (!m_name.empty()) {
+            MemoryTracker::getInstance().registerPool(this, [this]() { return getPoolStats(); });
+        }
     }
-    
+
     ~MemoryPool() {
-        clear();
+        if (!m_name.empty()) {
+            MemoryTracker::getInstance().unregisterPool(this);
+        }
+        // Threads still caching our objects drop them instead of handing them back
+        registry().remove(m_tag.load(::std::memory_order_relaxed));
+        releaseSlabs();
     }
-    
+
     MemoryPool(const MemoryPool&) = delete;
     MemoryPool& operator=(const MemoryPool&) = delete;
-    
+
+    static size_t getSizeClass(size_t objectSize) {
+        size_t alignment = alignof(::std::max_align_t);
+        size_t size = ::std::max(objectSize, sizeof(FreeNode));
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
     void* allocate() {
-        ::std::lock_guard<::std::mutex> lock(m_mutex);
-        
-        if (m_freeList.empty()) {
-            allocateNewBlock();
-        }
-        
-        void* ptr = m_freeList.top();
-        m_freeList.pop();
-        m_usedCount++;
-        
-        return ptr;
-    }
-    
+        ThreadCache& cache = localCache();
+        if (!cache.head) {
+            refill(cache, BATCH_SIZE);
+        }
+
+        FreeNode* node = cache.head;
+        cache.head = node->next;
+        --cache.count;
+        ++cache.usedDelta;
+        return node;
+    }
+
+    // Fills out[0, count) and returns count
+    size_t allocateN(void** out, size_t count) {
+        ThreadCache& cache = localCache();
+        for (size_t i = 0; i < count; ++i) {
+            if (!cache.head) {
+                refill(cache, ::std::max(BATCH_SIZE, count - i));
+            }
+            FreeNode* node = cache.head;
+            cache.head = node->next;
+            --cache.count;
+            out[i] = node;
+        }
+        cache.usedDelta += static_cast<int64_t>(count);
+        return count;
+    }
+
     void deallocate(void* ptr) {
-        if (!ptr) return;
-        
-        ::std::lock_guard<::std::mutex> lock(m_mutex);
-        
-        if (!isValidPointer(ptr)) {
+        if (!ptr || !owns(ptr)) {
             return;
         }
-        
-        m_freeList.push(ptr);
-        m_usedCount--;
+
+        ThreadCache& cache = localCache();
+        pushToCache(cache, ptr);
+        if (cache.count > 2 * BATCH_SIZE) {
+            flush(cache, cache.count - BATCH_SIZE);
+        }
+    }
+
+    // Returns many objects with at most one trip to the shared free list
+    void deallocateN(void* const* ptrs, size_t count) {
+        ThreadCache& cache = localCache();
+        for (size_t i = 0; i < count; ++i) {
+            if (ptrs[i] && owns(ptrs[i])) {
+                pushToCache(cache, ptrs[i]);
+            }
+        }
+        if (cache.count > 2 * BATCH_SIZE) {
+            flush(cache, cache.count - BATCH_SIZE);
+        }
+    }
+
+    // Marks every object free in O(slabs) and keeps the slabs for reuse.
+    // No destructors run and all outstanding pointers become invalid.
+    void deallocateAll() {
+        retag();
+
+        ::std::lock_guard<::std::mutex> lock(m_mutex);
+        for (auto& slab : m_slabs) {
+            slab->carved.store(0, ::std::memory_order_release);
+        }
+        m_freeHead = nullptr;
+        m_carveSlab = 0;
+        m_carvedCount = 0;
+        m_usedCount.store(0, ::std::memory_order_relaxed);
+    }
+
+    bool owns(const void* ptr) const {
+        uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+        uintptr_t base = address & ~static_cast<uintptr_t>(m_slabSize - 1);
+        const SlabTable* table = m_slabTable.load(::std::memory_order_acquire);
+
+        for (size_t i = hashSlab(base) & table->mask;; i = (i + 1) & table->mask) {
+            uintptr_t key = table->entries[i].key.load(::std::memory_order_acquire);
+            if (key == base) {
+                size_t offset = address - base;
+                return offset % m_stride == 0 &&
+                       offset < table->entries[i].slab->carved.load(::std::memory_order_acquire);
+            }
+            if (key == 0) {
+                return false;
+            }
+        }
     }
-    
+
     template<typename T, typename... Args>
     T* construct(Args&&... args) {
         static_assert(sizeof(T) <= sizeof(typename ::std::aligned_storage<sizeof(T), alignof(T)>::type));
-        
+
         void* ptr = allocate();
         if (!ptr) return nullptr;
-        
+
         try {
             return new(ptr) T(::std::forward<Args>(args)...);
         } catch (...) {
@@ -73,169 +177,418 @@ public:
             throw;
         }
     }
-    
+
     template<typename T>
     void destroy(T* ptr) {
         if (!ptr) return;
-        
+
         ptr->~T();
         deallocate(ptr);
     }
-    
+
     size_t getObjectSize() const {
-        ::std::lock_guard<::std::mutex> lock(m_mutex);
         return m_objectSize;
     }
-    
+
     size_t getCapacity() const {
         ::std::lock_guard<::std::mutex> lock(m_mutex);
         return m_totalCapacity;
     }
-    
+
     size_t getUsedCount() const {
-        ::std::lock_guard<::std::mutex> lock(m_mutex);
-        return m_usedCount;
+        uint64_t tag = m_tag.load(::std::memory_order_acquire);
+        int64_t used = m_usedCount.load(::std::memory_order_relaxed);
+
+        const ThreadCache& cache = threadCaches().slots[slotFor(tag)];
+        if (cache.tag == tag) {
+            used += cache.usedDelta;
+        }
+        return used > 0 ? static_cast<size_t>(used) : 0;
     }
-    
+
     size_t getFreeCount() const {
-        ::std::lock_guard<::std::mutex> lock(m_mutex);
-        return m_totalCapacity - m_usedCount;
+        size_t capacity = getCapacity();
+        size_t used = getUsedCount();
+        return capacity > used ? capacity - used : 0;
     }
-    
+
     size_t getMemoryUsage() const {
         ::std::lock_guard<::std::mutex> lock(m_mutex);
-        return m_blocks.size() * m_blockSize * m_objectSize;
+        return m_slabs.size() * m_slabSize;
     }
-    
+
     float getUtilization() const {
-        ::std::lock_guard<::std::mutex> lock(m_mutex);
-        return m_totalCapacity > 0 ? static_cast<float>(m_usedCount) / m_totalCapacity : 0.0f;
+        size_t capacity = getCapacity();
+        return capacity > 0 ? static_cast<float>(getUsedCount()) / capacity : 0.0f;
     }
-    
+
+    MemoryTracker::PoolStats getPoolStats() const {
+        MemoryTracker::PoolStats stats;
+        stats.name = m_name;
+        stats.objectSize = m_objectSize;
+        stats.capacity = getCapacity();
+        stats.usedCount = getUsedCount();
+        stats.memoryUsage = getMemoryUsage();
+        return stats;
+    }
+
+    // Frees every slab; outstanding pointers become invalid
     void clear() {
-        ::std::lock_guard<::std::mutex> lock(m_mutex);
-        
-        for (auto& block : m_blocks) {
-            ::std::free(block.memory);
-        }
-        m_blocks.clear();
-        
-        while (!m_freeList.empty()) {
-            m_freeList.pop();
-        }
-        
-        m_totalCapacity = 0;
-        m_usedCount = 0;
+        retag();
+        releaseSlabs();
     }
-    
+
     void shrink() {
         ::std::lock_guard<::std::mutex> lock(m_mutex);
-        
+
         // Only shrink if no objects are currently used
-        if (m_usedCount == 0) {
+        if (getUsedCount() == 0) {
             // Reset block size to initial value for future allocations
             m_blockSize = m_initialBlockSize;
         }
     }
-    
+
     void reserve(size_t capacity) {
         ::std::lock_guard<::std::mutex> lock(m_mutex);
-        
+
         while (m_totalCapacity < capacity) {
-            allocateNewBlock();
+            growLocked();
         }
     }
-    
+
 private:
-    struct Block {
-        void* memory;
-        size_t size;
-        
-        Block(void* mem, size_t sz) : memory(mem), size(sz) {}
+    struct FreeNode {
+        FreeNode* next;
     };
-    
-    void allocateNewBlock() {
-        size_t blockMemorySize = m_blockSize * m_objectSize;
-        
-        // Ensure alignment is power of 2 and block size is multiple of alignment
-        size_t alignment = alignof(::std::max_align_t);
-        blockMemorySize = (blockMemorySize + alignment - 1) & ~(alignment - 1);
-        
-        void* memory = ::std::aligned_alloc(alignment, blockMemorySize);
-        
-        if (!memory) {
-            throw ::std::bad_alloc();
-        }
-        
-        m_blocks.emplace_back(memory, m_blockSize);
-        
-        char* ptr = static_cast<char*>(memory);
-        for (size_t i = 0; i < m_blockSize; ++i) {
-            m_freeList.push(ptr + i * m_objectSize);
-        }
-        
+
+    struct Slab {
+        char* memory;
+        ::std::atomic<size_t> carved{0};  // Bytes handed out so far
+
+        explicit Slab(char* mem) : memory(mem) {}
+        ~Slab() { ::std::free(memory); }
+    };
+
+    // Open-addressed set of slab base addresses. Only written under m_mutex;
+    // when it fills up a larger copy is published and the old one is kept
+    // until the slabs are released, so owns() never has to lock.
+    struct SlabTable {
+        struct Entry {
+            ::std::atomic<uintptr_t> key{0};
+            Slab* slab = nullptr;
+        };
+
+        explicit SlabTable(size_t capacity)
+            : entries(new Entry[capacity]), mask(capacity - 1) {}
+
+        ::std::unique_ptr<Entry[]> entries;
+        size_t mask;
+        size_t count = 0;
+    };
+
+    // One pool's free objects cached by one thread
+    struct ThreadCache {
+        uint64_t tag = 0;
+        FreeNode* head = nullptr;
+        size_t count = 0;
+        int64_t usedDelta = 0;  // Allocations minus deallocations not yet published
+    };
+
+    // Direct-mapped by pool tag; a slot taken over by another pool hands its
+    // objects back first
+    struct ThreadCaches {
+        static constexpr size_t SLOTS = 8;
+        ThreadCache slots[SLOTS];
+
+        ~ThreadCaches() {
+            for (auto& cache : slots) {
+                release(cache);
+            }
+        }
+    };
+
+    // Live pools by tag. Tags are never reused, so a cache whose tag is
+    // missing belongs to a pool that has since been destroyed or reset.
+    // Lock order is registry, then pool.
+    struct Registry {
+        ::std::mutex mutex;
+        ::std::unordered_map<uint64_t, MemoryPool*> pools;
+        uint64_t nextTag = 1;
+
+        uint64_t add(MemoryPool* pool) {
+            ::std::lock_guard<::std::mutex> lock(mutex);
+            uint64_t tag = nextTag++;
+            pools.emplace(tag, pool);
+            return tag;
+        }
+
+        void remove(uint64_t tag) {
+            ::std::lock_guard<::std::mutex> lock(mutex);
+            pools.erase(tag);
+        }
+    };
+
+    static Registry& registry() {
+        // Never destroyed: thread caches release into it during shutdown
+        static Registry* instance = new Registry();
+        return *instance;
+    }
+
+    static ThreadCaches& threadCaches() {
+        thread_local ThreadCaches caches;
+        return caches;
+    }
+
+    static size_t slotFor(uint64_t tag) {
+        return static_cast<size_t>(tag % ThreadCaches::SLOTS);
+    }
+
+    static size_t hashSlab(uintptr_t base) {
+        // Slab addresses are at least 64 KiB aligned
+        return static_cast<size_t>((static_cast<uint64_t>(base >> 16) * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    static size_t slabSizeFor(size_t stride) {
+        size_t size = MIN_SLAB_SIZE;
+        while (size < stride * 16) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    // Hands a cache's objects back to its pool if that pool is still live
+    static void release(ThreadCache& cache) {
+        if (cache.tag == 0) {
+            return;
+        }
+
+        Registry& reg = registry();
+        ::std::lock_guard<::std::mutex> lock(reg.mutex);
+        auto it = reg.pools.find(cache.tag);
+        if (it != reg.pools.end()) {
+            it->second->flush(cache, cache.count);
+        }
+        cache = ThreadCache();
+    }
+
+    ThreadCache& localCache() {
+        uint64_t tag = m_tag.load(::std::memory_order_acquire);
+        ThreadCache& cache = threadCaches().slots[slotFor(tag)];
+        if (cache.tag != tag) {
+            release(cache);
+            cache.tag = tag;
+        }
+        return cache;
+    }
+
+    // A new tag makes every thread drop the objects it cached from us
+    void retag() {
+        Registry& reg = registry();
+        ::std::lock_guard<::std::mutex> lock(reg.mutex);
+        reg.pools.erase(m_tag.load(::std::memory_order_relaxed));
+        uint64_t tag = reg.nextTag++;
+        reg.pools.emplace(tag, this);
+        m_tag.store(tag, ::std::memory_order_release);
+    }
+
+    void pushToCache(ThreadCache& cache, void* ptr) {
+        FreeNode* node = static_cast<FreeNode*>(ptr);
+        node->next = cache.head;
+        cache.head = node;
+        ++cache.count;
+        --cache.usedDelta;
+    }
+
+    // Moves up to `want` objects into the cache, growing only when none are free
+    void refill(ThreadCache& cache, size_t want) {
+        ::std::lock_guard<::std::mutex> lock(m_mutex);
+        publishLocked(cache);
+
+        size_t taken = 0;
+        while (taken < want && m_freeHead) {
+            FreeNode* node = m_freeHead;
+            m_freeHead = node->next;
+            node->next = cache.head;
+            cache.head = node;
+            ++taken;
+        }
+        while (taken < want) {
+            if (m_carvedCount == m_totalCapacity) {
+                if (taken > 0) {
+                    break;
+                }
+                growLocked();
+            }
+            FreeNode* node = carveLocked();
+            node->next = cache.head;
+            cache.head = node;
+            ++taken;
+        }
+        cache.count += taken;
+    }
+
+    // Moves `count` objects from the cache to the shared free list
+    void flush(ThreadCache& cache, size_t count) {
+        ::std::lock_guard<::std::mutex> lock(m_mutex);
+        publishLocked(cache);
+
+        for (size_t i = 0; i < count && cache.head; ++i) {
+            FreeNode* node = cache.head;
+            cache.head = node->next;
+            --cache.count;
+            node->next = m_freeHead;
+            m_freeHead = node;
+        }
+    }
+
+    void publishLocked(ThreadCache& cache) {
+        m_usedCount.fetch_add(cache.usedDelta, ::std::memory_order_relaxed);
+        cache.usedDelta = 0;
+    }
+
+    // Next never-used object; requires m_carvedCount < m_totalCapacity
+    FreeNode* carveLocked() {
+        Slab* slab = m_slabs[m_carveSlab].get();
+        size_t offset = slab->carved.load(::std::memory_order_relaxed);
+        if (offset == m_objectsPerSlab * m_stride) {
+            slab = m_slabs[++m_carveSlab].get();
+            offset = 0;
+        }
+        slab->carved.store(offset + m_stride, ::std::memory_order_release);
+        ++m_carvedCount;
+        return reinterpret_cast<FreeNode*>(slab->memory + offset);
+    }
+
+    // Adds a block of capacity and any slabs needed to back it
+    void growLocked() {
         m_totalCapacity += m_blockSize;
-        
-        if (m_blocks.size() > 1) {
+
+        while (m_slabs.size() * m_objectsPerSlab < m_totalCapacity) {
+            void* memory = ::std::aligned_alloc(m_slabSize, m_slabSize);
+            if (!memory) {
+                throw ::std::bad_alloc();
+            }
+            m_slabs.push_back(::std::make_unique<Slab>(static_cast<char*>(memory)));
+            insertSlabLocked(m_slabs.back().get());
+        }
+
+        if (++m_growCount > 1) {
             m_blockSize = ::std::min(m_blockSize * 2, size_t(1024));
         }
     }
-    
-    bool isValidPointer(void* ptr) const {
-        char* charPtr = static_cast<char*>(ptr);
-        
-        for (const auto& block : m_blocks) {
-            char* blockStart = static_cast<char*>(block.memory);
-            char* blockEnd = blockStart + block.size * m_objectSize;
-            
-            if (charPtr >= blockStart && charPtr < blockEnd) {
-                size_t offset = charPtr - blockStart;
-                return (offset % m_objectSize) == 0;
+
+    void insertSlabLocked(Slab* slab) {
+        SlabTable* table = m_slabTable.load(::std::memory_order_relaxed);
+        if ((table->count + 1) * 2 > table->mask + 1) {
+            SlabTable* larger = newTableLocked((table->mask + 1) * 2);
+            for (size_t i = 0; i <= table->mask; ++i) {
+                uintptr_t key = table->entries[i].key.load(::std::memory_order_relaxed);
+                if (key != 0) {
+                    insertIntoTable(*larger, key, table->entries[i].slab);
+                }
             }
+            m_slabTable.store(larger, ::std::memory_order_release);
+            table = larger;
+        }
+        insertIntoTable(*table, reinterpret_cast<uintptr_t>(slab->memory), slab);
+    }
+
+    static void insertIntoTable(SlabTable& table, uintptr_t key, Slab* slab) {
+        size_t i = hashSlab(key) & table.mask;
+        while (table.entries[i].key.load(::std::memory_order_relaxed) != 0) {
+            i = (i + 1) & table.mask;
         }
-        
-        return false;
+        table.entries[i].slab = slab;
+        table.entries[i].key.store(key, ::std::memory_order_release);
+        ++table.count;
+    }
+
+    SlabTable* newTableLocked(size_t capacity) {
+        m_tables.push_back(::std::make_unique<SlabTable>(capacity));
+        return m_tables.back().get();
+    }
+
+    void releaseSlabs() {
+        ::std::lock_guard<::std::mutex> lock(m_mutex);
+
+        m_slabs.clear();
+        m_tables.clear();
+        m_slabTable.store(newTableLocked(16), ::std::memory_order_release);
+
+        m_freeHead = nullptr;
+        m_carveSlab = 0;
+        m_carvedCount = 0;
+        m_totalCapacity = 0;
+        m_usedCount.store(0, ::std::memory_order_relaxed);
     }
-    
-    size_t m_objectSize;
+
+    const size_t m_objectSize;
+    const size_t m_stride;
+    const size_t m_slabSize;
+    const size_t m_objectsPerSlab;
     size_t m_initialBlockSize;
     size_t m_blockSize;
-    size_t m_totalCapacity;
-    size_t m_usedCount;
-    
-    ::std::vector<Block> m_blocks;
-    ::std::stack<void*> m_freeList;
+    size_t m_growCount = 0;
+    const ::std::string m_name;
+
+    ::std::atomic<uint64_t> m_tag{0};
+    ::std::atomic<int64_t> m_usedCount{0};
+    ::std::atomic<SlabTable*> m_slabTable{nullptr};
+
+    // Guarded by m_mutex
+    size_t m_totalCapacity = 0;
+    size_t m_carvedCount = 0;
+    size_t m_carveSlab = 0;
+    FreeNode* m_freeHead = nullptr;
+    ::std::vector<::std::unique_ptr<Slab>> m_slabs;
+    ::std::vector<::std::unique_ptr<SlabTable>> m_tables;
     mutable ::std::mutex m_mutex;
 };
 
 template<typename T>
 class TypedMemoryPool {
 public:
-    TypedMemoryPool(size_t initialCapacity = 64)
-        : m_pool(sizeof(T), initialCapacity) {}
-    
+    TypedMemoryPool(size_t initialCapacity = 64, const char* name = nullptr)
+        : m_pool(sizeof(T), initialCapacity, name) {}
+
     template<typename... Args>
     T* construct(Args&&... args) {
         return m_pool.template construct<T>(::std::forward<Args>(args)...);
     }
-    
+
     void destroy(T* ptr) {
         m_pool.template destroy<T>(ptr);
     }
-    
+
+    // Destroys a batch of objects and returns them to the pool together
+    void destroyN(T* const* ptrs, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (ptrs[i]) {
+                ptrs[i]->~T();
+            }
+        }
+        m_pool.deallocateN(reinterpret_cast<void* const*>(ptrs), count);
+    }
+
+    // Releases every object without running destructors
+    void deallocateAll() { m_pool.deallocateAll(); }
+
+    bool owns(const T* ptr) const { return m_pool.owns(ptr); }
+
     size_t getCapacity() const { return m_pool.getCapacity(); }
     size_t getUsedCount() const { return m_pool.getUsedCount(); }
     size_t getFreeCount() const { return m_pool.getFreeCount(); }
     size_t getMemoryUsage() const { return m_pool.getMemoryUsage(); }
     float getUtilization() const { return m_pool.getUtilization(); }
-    
+    MemoryTracker::PoolStats getPoolStats() const { return m_pool.getPoolStats(); }
+
     void clear() { m_pool.clear(); }
     void shrink() { m_pool.shrink(); }
     void reserve(size_t capacity) { m_pool.reserve(capacity); }
-    
+
 private:
     MemoryPool m_pool;
 };
 
 }
-}
\ No newline at end of file
+}
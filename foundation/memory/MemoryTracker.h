@@ -8,6 +8,7 @@
 #include <mutex>
 #include <chrono>
 #include <vector>
+#include <functional>
 
 namespace VoxelEditor {
 namespace Memory {
@@ -26,8 +27,9 @@ struct AllocationInfo {
 class MemoryTracker {
 public:
     static MemoryTracker& getInstance() {
-        static MemoryTracker instance;
-        return instance;
+        // Never destroyed so static pools can still unregister during shutdown
+        static MemoryTracker* instance = new MemoryTracker();
+        return *instance;
     }
     
     void recordAllocation(void* ptr, size_t size, const char* category = "Unknown") {
@@ -147,6 +149,38 @@ public:
         m_peakUsage.store(0, std::memory_order_relaxed);
     }
     
+    struct PoolStats {
+        std::string name;
+        size_t objectSize = 0;
+        size_t capacity = 0;
+        size_t usedCount = 0;
+        size_t memoryUsage = 0;
+    };
+    
+    // Pools report through a callback instead of recording each object
+    void registerPool(const void* pool, std::function<PoolStats()> provider) {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        m_pools[pool] = std::move(provider);
+    }
+    
+    void unregisterPool(const void* pool) {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        m_pools.erase(pool);
+    }
+    
+    std::vector<PoolStats> getPoolStats() const {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        
+        std::vector<PoolStats> result;
+        result.reserve(m_pools.size());
+        
+        for (const auto& pair : m_pools) {
+            result.push_back(pair.second());
+        }
+        
+        return result;
+    }
+    
     struct MemoryStats {
         size_t totalAllocated;
         size_t totalDeallocated;
@@ -155,6 +189,7 @@ public:
         size_t activeAllocations;
         float pressureRatio;
         std::unordered_map<std::string, size_t> categoryUsage;
+        std::vector<PoolStats> pools;
     };
     
     MemoryStats getStats() const {
@@ -166,6 +201,7 @@ public:
         stats.activeAllocations = getActiveAllocationCount();
         stats.pressureRatio = getMemoryPressureRatio();
         stats.categoryUsage = getUsageByCategory();
+        stats.pools = getPoolStats();
         return stats;
     }
     
@@ -191,6 +227,10 @@ private:
     
     Events::EventDispatcher* m_eventDispatcher;
     mutable std::mutex m_mutex;
+    
+    // Providers run under m_poolMutex; pools never call in while holding their own lock
+    std::unordered_map<const void*, std::function<PoolStats()>> m_pools;
+    mutable std::mutex m_poolMutex;
 };
 
 class ScopedAllocationTracker {
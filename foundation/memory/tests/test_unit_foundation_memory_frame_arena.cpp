@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "../FrameArena.h"
+#include <vector>
+#include <unordered_set>
+
+using namespace VoxelEditor::Memory;
+
+namespace {
+
+// Upstream that counts what the arena asks for
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytesOutstanding = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        bytesOutstanding += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        ++deallocations;
+        bytesOutstanding -= bytes;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+}
+
+class FrameArenaTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(FrameArenaTest, AllocationsAreAlignedAndDistinct) {
+    FrameArena arena(1024);
+
+    char* a = static_cast<char*>(arena.allocate(3, 1));
+    double* b = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+    void* c = arena.allocate(16, 64);
+
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % alignof(double), 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % 64, 0);
+    EXPECT_GE(reinterpret_cast<char*>(b), a + 3);
+    EXPECT_GE(static_cast<char*>(c), reinterpret_cast<char*>(b + 1));
+
+    int* values = arena.allocateArray<int>(100);
+    for (int i = 0; i < 100; ++i) {
+        values[i] = i;
+    }
+    EXPECT_EQ(values[99], 99);
+}
+
+TEST_F(FrameArenaTest, RewindReusesMemory) {
+    FrameArena arena(1024);
+    arena.allocate(32);
+
+    FrameArena::Marker marker = arena.getMarker();
+    size_t used = arena.getBytesUsed();
+    void* first = arena.allocate(100);
+
+    arena.rewind(marker);
+    EXPECT_EQ(arena.getBytesUsed(), used);
+    EXPECT_EQ(arena.allocate(100), first);
+}
+
+TEST_F(FrameArenaTest, ScopeRewindsOnExit) {
+    FrameArena arena(1024);
+    size_t before = arena.getBytesUsed();
+    {
+        ArenaScope scope(arena);
+        arena.allocate(500);
+        EXPECT_GT(arena.getBytesUsed(), before);
+    }
+    EXPECT_EQ(arena.getBytesUsed(), before);
+}
+
+TEST_F(FrameArenaTest, SpillsIntoNewBlocks) {
+    CountingResource upstream;
+    FrameArena arena(1024, &upstream);
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_NE(arena.allocate(400), nullptr);
+    }
+    EXPECT_GT(upstream.allocations, 1u);
+
+    // Larger than a block gets a block of its own
+    size_t before = upstream.allocations;
+    void* big = arena.allocate(10000);
+    ASSERT_NE(big, nullptr);
+    EXPECT_EQ(upstream.allocations, before + 1);
+    EXPECT_GE(arena.getCapacity(), 10000u);
+}
+
+TEST_F(FrameArenaTest, ResetMergesBlocksSoTheNextPassNeedsNoAllocations) {
+    CountingResource upstream;
+    FrameArena arena(1024, &upstream);
+
+    auto pass = [&]() {
+        for (int i = 0; i < 20; ++i) {
+            arena.allocate(300);
+        }
+    };
+
+    pass();
+    size_t firstPass = upstream.allocations;
+    EXPECT_GT(firstPass, 1u);
+
+    arena.reset();
+    EXPECT_EQ(arena.getBytesUsed(), 0u);
+    size_t afterMerge = upstream.allocations;
+
+    pass();
+    arena.reset();
+    pass();
+    EXPECT_EQ(upstream.allocations, afterMerge);
+}
+
+TEST_F(FrameArenaTest, ReleaseReturnsEverythingUpstream) {
+    CountingResource upstream;
+    {
+        FrameArena arena(1024, &upstream);
+        for (int i = 0; i < 10; ++i) {
+            arena.allocate(500);
+        }
+        arena.release();
+        EXPECT_EQ(upstream.bytesOutstanding, 0u);
+        EXPECT_EQ(arena.getCapacity(), 0u);
+
+        arena.allocate(10);
+    }
+    EXPECT_EQ(upstream.allocations, upstream.deallocations);
+    EXPECT_EQ(upstream.bytesOutstanding, 0u);
+}
+
+TEST_F(FrameArenaTest, ExternalBufferIsUsedFirst) {
+    CountingResource upstream;
+    alignas(std::max_align_t) char buffer[4096];
+    FrameArena arena(buffer, sizeof(buffer), &upstream);
+
+    void* ptr = arena.allocate(100);
+    EXPECT_GE(static_cast<char*>(ptr), buffer);
+    EXPECT_LT(static_cast<char*>(ptr), buffer + sizeof(buffer));
+    EXPECT_EQ(upstream.allocations, 0u);
+
+    arena.allocate(8000);
+    EXPECT_EQ(upstream.allocations, 1u);
+
+    arena.reset();
+    EXPECT_GE(static_cast<char*>(arena.allocate(100)), buffer);
+    arena.release();
+    EXPECT_EQ(upstream.bytesOutstanding, 0u);
+}
+
+TEST_F(FrameArenaTest, PmrContainersReachSteadyState) {
+    CountingResource upstream;
+    FrameArena arena(4096, &upstream);
+
+    auto frame = [&]() {
+        ArenaScope scope(arena);
+        std::pmr::vector<int> values(arena.getResource());
+        std::pmr::unordered_set<int> seen(arena.getResource());
+        for (int i = 0; i < 1000; ++i) {
+            values.push_back(i);
+            seen.insert(i % 97);
+        }
+        EXPECT_EQ(values.size(), 1000u);
+        EXPECT_EQ(seen.size(), 97u);
+    };
+
+    frame();
+    arena.reset();
+    size_t warm = upstream.allocations;
+    for (int i = 0; i < 5; ++i) {
+        frame();
+        arena.reset();
+    }
+    EXPECT_EQ(upstream.allocations, warm);
+}
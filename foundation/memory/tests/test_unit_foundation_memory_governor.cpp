@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include "../MemoryGovernor.h"
+#include <string>
+#include <vector>
+
+using namespace VoxelEditor::Memory;
+
+namespace {
+
+// Cache whose usage is a plain number; evicting and compressing just shrink it
+struct FakeCache {
+    size_t usage = 0;
+    size_t compressible = 0;
+    std::vector<size_t> evictRequests;
+
+    MemoryGovernor::CacheRegistration makeRegistration(const std::string& name, float cost,
+                                                       size_t budget = 0) {
+        MemoryGovernor::CacheRegistration registration;
+        registration.name = name;
+        registration.budgetBytes = budget;
+        registration.evictionCost = cost;
+        registration.getUsage = [this]() { return usage; };
+        registration.evict = [this](size_t bytes) {
+            evictRequests.push_back(bytes);
+            size_t freed = std::min(bytes, usage);
+            usage -= freed;
+            return freed;
+        };
+        if (compressible > 0) {
+            registration.compress = [this]() {
+                size_t saved = compressible;
+                usage -= saved;
+                compressible = 0;
+                return saved;
+            };
+        }
+        return registration;
+    }
+};
+
+constexpr size_t MB = 1024 * 1024;
+
+}
+
+class MemoryGovernorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        governor.setResidentSampler([this]() { return resident; });
+        governor.setCeiling(100 * MB);
+        governor.setTargetRatio(0.8f);
+    }
+
+    MemoryGovernor governor;
+    size_t resident = 0;
+};
+
+TEST_F(MemoryGovernorTest, UnderCeilingReleasesNothing) {
+    FakeCache cache;
+    cache.usage = 50 * MB;
+    governor.registerCache(cache.makeRegistration("cache", 1.0f));
+
+    resident = 90 * MB;
+    MemoryGovernor::RebalanceResult result = governor.rebalance();
+
+    EXPECT_EQ(result.residentBytes, 90 * MB);
+    EXPECT_EQ(result.getReleasedBytes(), 0u);
+    EXPECT_EQ(cache.usage, 50 * MB);
+}
+
+TEST_F(MemoryGovernorTest, EvictsCheapestBytesFirst) {
+    FakeCache history;
+    FakeCache meshes;
+    FakeCache previews;
+    history.usage = 40 * MB;
+    meshes.usage = 40 * MB;
+    previews.usage = 10 * MB;
+    governor.registerCache(history.makeRegistration("history", 8.0f));
+    governor.registerCache(meshes.makeRegistration("meshes", 1.0f));
+    governor.registerCache(previews.makeRegistration("previews", 0.5f));
+
+    // 30 MB over the 80 MB target: all previews, then 20 MB of meshes
+    resident = 110 * MB;
+    MemoryGovernor::RebalanceResult result = governor.rebalance();
+
+    EXPECT_EQ(result.evictedBytes, 30 * MB);
+    EXPECT_EQ(previews.usage, 0u);
+    EXPECT_EQ(meshes.usage, 20 * MB);
+    EXPECT_EQ(history.usage, 40 * MB);
+    EXPECT_TRUE(history.evictRequests.empty());
+}
+
+TEST_F(MemoryGovernorTest, ValueScaleReordersCaches) {
+    FakeCache hot;
+    FakeCache cold;
+    hot.usage = 20 * MB;
+    cold.usage = 20 * MB;
+
+    MemoryGovernor::CacheRegistration hotRegistration = hot.makeRegistration("hot", 1.0f);
+    hotRegistration.getValueScale = []() { return 0.9f; };
+    MemoryGovernor::CacheRegistration coldRegistration = cold.makeRegistration("cold", 2.0f);
+    coldRegistration.getValueScale = []() { return 0.1f; };
+    governor.registerCache(std::move(hotRegistration));
+    governor.registerCache(std::move(coldRegistration));
+
+    resident = 110 * MB;
+    governor.rebalance();
+
+    // Cold bytes are worth 0.2 against 0.9, so they all go before any hot ones
+    EXPECT_EQ(cold.usage, 0u);
+    EXPECT_EQ(hot.usage, 10 * MB);
+}
+
+TEST_F(MemoryGovernorTest, CompressesBeforeEvicting) {
+    FakeCache history;
+    FakeCache meshes;
+    history.usage = 60 * MB;
+    history.compressible = 15 * MB;
+    meshes.usage = 30 * MB;
+    governor.registerCache(history.makeRegistration("history", 8.0f));
+    governor.registerCache(meshes.makeRegistration("meshes", 1.0f));
+
+    resident = 100 * MB + 1;
+    MemoryGovernor::RebalanceResult result = governor.rebalance();
+
+    // 20 MB needed: compression saves 15, the meshes give up the rest
+    EXPECT_EQ(result.compressedBytes, 15 * MB);
+    EXPECT_EQ(result.evictedBytes, 5 * MB + 1);
+    EXPECT_EQ(history.usage, 45 * MB);
+    EXPECT_EQ(meshes.usage, 25 * MB - 1);
+}
+
+TEST_F(MemoryGovernorTest, EnforcesBudgetsBelowCeiling) {
+    FakeCache selection;
+    selection.usage = 12 * MB;
+    governor.registerCache(selection.makeRegistration("selection", 2.0f, 8 * MB));
+
+    resident = 10 * MB;
+    MemoryGovernor::RebalanceResult result = governor.rebalance();
+
+    EXPECT_EQ(result.evictedBytes, 4 * MB);
+    EXPECT_EQ(selection.usage, 8 * MB);
+}
+
+TEST_F(MemoryGovernorTest, FallsBackToOptimizerCleanup) {
+    MemoryOptimizer optimizer;
+    size_t cleanupCalls = 0;
+    optimizer.registerCleanupCallback([&cleanupCalls]() -> size_t {
+        ++cleanupCalls;
+        return 4096;
+    }, CleanupPriority::Medium, "pools");
+
+    MemoryGovernor withFallback(&optimizer);
+    withFallback.setResidentSampler([]() { return 150 * MB; });
+    withFallback.setCeiling(100 * MB);
+
+    FakeCache small;
+    small.usage = 1 * MB;
+    withFallback.registerCache(small.makeRegistration("small", 1.0f));
+
+    MemoryGovernor::RebalanceResult result = withFallback.rebalance();
+
+    EXPECT_EQ(result.evictedBytes, 1 * MB);
+    EXPECT_EQ(result.cleanupBytes, 4096u);
+    EXPECT_EQ(cleanupCalls, 1u);
+}
+
+TEST_F(MemoryGovernorTest, UnregisteredCachesAreLeftAlone) {
+    FakeCache first;
+    FakeCache second;
+    first.usage = 30 * MB;
+    second.usage = 30 * MB;
+    MemoryGovernor::CacheId firstId = governor.registerCache(first.makeRegistration("first", 1.0f));
+    governor.registerCache(second.makeRegistration("second", 2.0f));
+    EXPECT_EQ(governor.getCacheCount(), 2u);
+    EXPECT_EQ(governor.getTrackedUsage(), 60 * MB);
+
+    governor.unregisterCache(firstId);
+    EXPECT_EQ(governor.getCacheCount(), 1u);
+
+    resident = 120 * MB;
+    governor.rebalance();
+
+    EXPECT_EQ(first.usage, 30 * MB);
+    EXPECT_EQ(second.usage, 0u);
+}
+
+TEST_F(MemoryGovernorTest, StatsReportPerCacheActivity) {
+    FakeCache meshes;
+    meshes.usage = 30 * MB;
+    governor.registerCache(meshes.makeRegistration("meshes", 1.5f, 20 * MB));
+
+    resident = 50 * MB;
+    governor.rebalance();
+
+    std::vector<MemoryGovernor::CacheStats> stats = governor.getCacheStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].name, "meshes");
+    EXPECT_EQ(stats[0].usage, 20 * MB);
+    EXPECT_EQ(stats[0].budgetBytes, 20 * MB);
+    EXPECT_FLOAT_EQ(stats[0].valuePerByte, 1.5f);
+    EXPECT_EQ(stats[0].evictedBytes, 10 * MB);
+    EXPECT_EQ(stats[0].compressedBytes, 0u);
+}
+
+TEST_F(MemoryGovernorTest, UpdateSamplesOncePerInterval) {
+    FakeCache cache;
+    cache.usage = 50 * MB;
+    governor.registerCache(cache.makeRegistration("cache", 1.0f));
+    governor.setSampleInterval(std::chrono::hours(1));
+
+    resident = 90 * MB;
+    EXPECT_FALSE(governor.update());
+
+    // Within the interval the new reading is not taken
+    resident = 200 * MB;
+    EXPECT_FALSE(governor.update());
+    EXPECT_EQ(cache.usage, 50 * MB);
+
+    governor.setSampleInterval(std::chrono::milliseconds(0));
+    EXPECT_TRUE(governor.update());
+    EXPECT_EQ(cache.usage, 0u);
+}
+
+TEST_F(MemoryGovernorTest, SamplesRealResidentSet) {
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+    size_t before = MemoryGovernor::sampleResidentBytes();
+    EXPECT_GT(before, 0u);
+
+    // Touch 32 MB so it becomes resident
+    std::vector<char> block(32 * MB, 1);
+    size_t after = MemoryGovernor::sampleResidentBytes();
+    EXPECT_GE(after, before + 16 * MB);
+    EXPECT_EQ(block[block.size() / 2], 1);
+#else
+    GTEST_SKIP() << "No RSS probe on this platform";
+#endif
+}
@@ -0,0 +1,351 @@
+#include <gtest/gtest.h>
+#include "../MemoryPool.h"
+#include <thread>
+#include <vector>
+#include <set>
+#include <stack>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+using namespace VoxelEditor::Memory;
+
+namespace {
+
+// Same size as an octree node
+struct NodeSized {
+    NodeSized* children[8];
+    int x, y, z;
+    bool flags[2];
+};
+
+// The mutex/stack pool this pool replaced, kept for the benchmark
+class LegacyMemoryPool {
+public:
+    LegacyMemoryPool(size_t objectSize, size_t initialCapacity)
+        : m_objectSize(objectSize), m_blockSize(initialCapacity) {
+        allocateNewBlock();
+    }
+
+    ~LegacyMemoryPool() {
+        for (auto& block : m_blocks) {
+            std::free(block.first);
+        }
+    }
+
+    void* allocate() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_freeList.empty()) {
+            allocateNewBlock();
+        }
+        void* ptr = m_freeList.top();
+        m_freeList.pop();
+        return ptr;
+    }
+
+    void deallocate(void* ptr) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& block : m_blocks) {
+            char* start = static_cast<char*>(block.first);
+            char* charPtr = static_cast<char*>(ptr);
+            if (charPtr >= start && charPtr < start + block.second * m_objectSize) {
+                m_freeList.push(ptr);
+                return;
+            }
+        }
+    }
+
+private:
+    void allocateNewBlock() {
+        size_t alignment = alignof(std::max_align_t);
+        size_t bytes = (m_blockSize * m_objectSize + alignment - 1) & ~(alignment - 1);
+        char* memory = static_cast<char*>(std::aligned_alloc(alignment, bytes));
+        m_blocks.emplace_back(memory, m_blockSize);
+        for (size_t i = 0; i < m_blockSize; ++i) {
+            m_freeList.push(memory + i * m_objectSize);
+        }
+        if (m_blocks.size() > 1) {
+            m_blockSize = std::min(m_blockSize * 2, size_t(1024));
+        }
+    }
+
+    size_t m_objectSize;
+    size_t m_blockSize;
+    std::vector<std::pair<void*, size_t>> m_blocks;
+    std::stack<void*> m_freeList;
+    std::mutex m_mutex;
+};
+
+}
+
+class MemoryPoolThreadedTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(MemoryPoolThreadedTest, AllocateNAndDeallocateN) {
+    MemoryPool pool(sizeof(NodeSized), 16);
+
+    std::vector<void*> ptrs(200);
+    EXPECT_EQ(pool.allocateN(ptrs.data(), ptrs.size()), ptrs.size());
+    EXPECT_EQ(pool.getUsedCount(), 200);
+    EXPECT_GE(pool.getCapacity(), 200);
+
+    std::set<void*> unique(ptrs.begin(), ptrs.end());
+    EXPECT_EQ(unique.size(), ptrs.size());
+    for (void* ptr : ptrs) {
+        EXPECT_TRUE(pool.owns(ptr));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t), 0);
+    }
+
+    pool.deallocateN(ptrs.data(), ptrs.size());
+    EXPECT_EQ(pool.getUsedCount(), 0);
+}
+
+TEST_F(MemoryPoolThreadedTest, OwnershipIsExact) {
+    MemoryPool pool(sizeof(NodeSized), 4);
+    MemoryPool other(sizeof(NodeSized), 4);
+
+    void* ptr = pool.allocate();
+    void* foreign = other.allocate();
+
+    EXPECT_TRUE(pool.owns(ptr));
+    EXPECT_FALSE(pool.owns(static_cast<char*>(ptr) + 1));
+    EXPECT_FALSE(pool.owns(foreign));
+
+    // Never handed out, so not a valid object yet
+    EXPECT_FALSE(pool.owns(static_cast<char*>(ptr) + 16 * MemoryPool::getSizeClass(sizeof(NodeSized))));
+
+    pool.deallocate(foreign);
+    EXPECT_EQ(pool.getUsedCount(), 1);
+    EXPECT_EQ(other.getUsedCount(), 1);
+
+    pool.deallocate(ptr);
+    other.deallocate(foreign);
+    EXPECT_EQ(pool.getUsedCount(), 0);
+    EXPECT_EQ(other.getUsedCount(), 0);
+}
+
+TEST_F(MemoryPoolThreadedTest, DeallocateAllKeepsSlabs) {
+    MemoryPool pool(sizeof(NodeSized), 64);
+
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 500; ++i) {
+        ptrs.push_back(pool.allocate());
+    }
+    size_t capacity = pool.getCapacity();
+    size_t memory = pool.getMemoryUsage();
+
+    pool.deallocateAll();
+
+    EXPECT_EQ(pool.getUsedCount(), 0);
+    EXPECT_EQ(pool.getCapacity(), capacity);
+    EXPECT_EQ(pool.getMemoryUsage(), memory);
+    EXPECT_FALSE(pool.owns(ptrs.front()));
+
+    // Stale pointers are ignored and the slabs are reused
+    pool.deallocate(ptrs.front());
+    for (int i = 0; i < 500; ++i) {
+        EXPECT_NE(pool.allocate(), nullptr);
+    }
+    EXPECT_EQ(pool.getUsedCount(), 500);
+    EXPECT_EQ(pool.getCapacity(), capacity);
+    EXPECT_EQ(pool.getMemoryUsage(), memory);
+}
+
+TEST_F(MemoryPoolThreadedTest, CrossThreadDeallocation) {
+    MemoryPool pool(sizeof(NodeSized), 16);
+
+    std::vector<void*> ptrs;
+    std::thread producer([&]() {
+        for (int i = 0; i < 1000; ++i) {
+            ptrs.push_back(pool.allocate());
+        }
+    });
+    producer.join();
+    EXPECT_EQ(pool.getUsedCount(), 1000);
+
+    std::thread consumer([&]() {
+        for (void* ptr : ptrs) {
+            pool.deallocate(ptr);
+        }
+    });
+    consumer.join();
+    EXPECT_EQ(pool.getUsedCount(), 0);
+
+    // Everything freed elsewhere is reusable without growing
+    size_t capacity = pool.getCapacity();
+    std::vector<void*> again(1000);
+    pool.allocateN(again.data(), again.size());
+    EXPECT_EQ(pool.getCapacity(), capacity);
+    pool.deallocateN(again.data(), again.size());
+}
+
+TEST_F(MemoryPoolThreadedTest, ConcurrentChurn) {
+    MemoryPool pool(sizeof(NodeSized), 16);
+    const int numThreads = 8;
+    const int iterations = 20000;
+    std::atomic<int> corrupted{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            std::vector<NodeSized*> live;
+            uint32_t seed = 12345u + t;
+            for (int i = 0; i < iterations; ++i) {
+                seed = seed * 1664525u + 1013904223u;
+                if (live.empty() || (seed >> 16) % 3 != 0) {
+                    NodeSized* node = static_cast<NodeSized*>(pool.allocate());
+                    node->x = t;
+                    node->y = i;
+                    live.push_back(node);
+                } else {
+                    size_t index = (seed >> 8) % live.size();
+                    if (live[index]->x != t) {
+                        corrupted++;
+                    }
+                    pool.deallocate(live[index]);
+                    live[index] = live.back();
+                    live.pop_back();
+                }
+            }
+            for (NodeSized* node : live) {
+                if (node->x != t) {
+                    corrupted++;
+                }
+            }
+            pool.deallocateN(reinterpret_cast<void* const*>(live.data()), live.size());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(corrupted.load(), 0);
+    EXPECT_EQ(pool.getUsedCount(), 0);
+}
+
+TEST_F(MemoryPoolThreadedTest, PoolOutlivedByThreadCache) {
+    std::vector<void*> ptrs;
+    {
+        MemoryPool pool(sizeof(NodeSized), 16);
+        for (int i = 0; i < 10; ++i) {
+            ptrs.push_back(pool.allocate());
+        }
+        for (void* ptr : ptrs) {
+            pool.deallocate(ptr);
+        }
+    }
+
+    // This thread still caches objects from the destroyed pool; a new pool
+    // must not be handed any of them
+    MemoryPool pool(sizeof(NodeSized), 16);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(pool.owns(pool.allocate()));
+    }
+    EXPECT_EQ(pool.getUsedCount(), 100);
+}
+
+TEST_F(MemoryPoolThreadedTest, NamedPoolReportsToTracker) {
+    auto findPool = []() -> const MemoryTracker::PoolStats* {
+        static std::vector<MemoryTracker::PoolStats> pools;
+        pools = MemoryTracker::getInstance().getStats().pools;
+        for (const auto& stats : pools) {
+            if (stats.name == "ThreadedTestPool") {
+                return &stats;
+            }
+        }
+        return nullptr;
+    };
+
+    {
+        TypedMemoryPool<NodeSized> pool(8, "ThreadedTestPool");
+        NodeSized* a = pool.construct();
+        NodeSized* b = pool.construct();
+
+        const MemoryTracker::PoolStats* stats = findPool();
+        ASSERT_NE(stats, nullptr);
+        EXPECT_EQ(stats->objectSize, sizeof(NodeSized));
+        EXPECT_EQ(stats->capacity, 8);
+        EXPECT_EQ(stats->usedCount, 2);
+        EXPECT_GE(stats->memoryUsage, MemoryPool::MIN_SLAB_SIZE);
+
+        NodeSized* nodes[] = {a, b};
+        pool.destroyN(nodes, 2);
+        EXPECT_EQ(findPool()->usedCount, 0);
+    }
+
+    EXPECT_EQ(findPool(), nullptr);
+}
+
+// Octree-style inserts: every thread builds its own tree of node-sized
+// objects, occasionally prunes one, then tears the tree down
+TEST_F(MemoryPoolThreadedTest, InsertWorkloadBenchmark) {
+    const int numThreads = 4;
+    const int insertsPerThread = 100000;
+
+    auto run = [&](auto allocate, auto deallocate, auto teardown) {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&, t]() {
+                std::vector<void*> nodes;
+                nodes.reserve(insertsPerThread);
+                uint32_t seed = 777u + t;
+                for (int i = 0; i < insertsPerThread; ++i) {
+                    void* node = allocate();
+                    std::memset(node, 0, sizeof(NodeSized));
+                    nodes.push_back(node);
+                    seed = seed * 1664525u + 1013904223u;
+                    if ((seed >> 16) % 8 == 0) {
+                        size_t index = (seed >> 4) % nodes.size();
+                        deallocate(nodes[index]);
+                        nodes[index] = nodes.back();
+                        nodes.pop_back();
+                    }
+                }
+                teardown(nodes);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    double mallocMs = run(
+        []() { return std::malloc(sizeof(NodeSized)); },
+        [](void* ptr) { std::free(ptr); },
+        [](std::vector<void*>& nodes) { for (void* ptr : nodes) std::free(ptr); });
+
+    double legacyMs;
+    {
+        LegacyMemoryPool legacy(sizeof(NodeSized), 1024);
+        legacyMs = run(
+            [&]() { return legacy.allocate(); },
+            [&](void* ptr) { legacy.deallocate(ptr); },
+            [&](std::vector<void*>& nodes) { for (void* ptr : nodes) legacy.deallocate(ptr); });
+    }
+
+    double poolMs;
+    {
+        MemoryPool pool(sizeof(NodeSized), 1024);
+        poolMs = run(
+            [&]() { return pool.allocate(); },
+            [&](void* ptr) { pool.deallocate(ptr); },
+            [&](std::vector<void*>& nodes) { pool.deallocateN(nodes.data(), nodes.size()); });
+        EXPECT_EQ(pool.getUsedCount(), 0);
+    }
+
+    std::cout << numThreads << " threads x " << insertsPerThread << " inserts" << std::endl;
+    std::cout << std::left << std::setw(14) << "Allocator" << std::right << std::setw(12) << "ms" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(14) << "malloc" << std::right << std::setw(12) << mallocMs << std::endl;
+    std::cout << std::left << std::setw(14) << "legacy pool" << std::right << std::setw(12) << legacyMs << std::endl;
+    std::cout << std::left << std::setw(14) << "MemoryPool" << std::right << std::setw(12) << poolMs << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../../../math/Vector3i.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace VoxelEditor {
+namespace Math {
+
+/**
+ * Cells of one 16x16x16 brick: a sorted array of cell offsets while sparse,
+ * a 4096-bit bitmap once dense. The switch happens where both take the
+ * same memory, so a brick never costs more than 512 bytes of cells.
+ *
+ * Sparse voxel sets (selections, groups) key these bricks by brick
+ * coordinate and resolution; brickKey, cellIndex and cellPosition are the
+ * one packing they all share. Set algebra runs 64 cells per word once
+ * either side is a bitmap.
+ */
+class BrickCells {
+public:
+    static constexpr int BRICK_SHIFT = 4;
+    static constexpr int BRICK_SIZE = 1 << BRICK_SHIFT;
+    static constexpr uint32_t BRICK_CELLS = BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+    static constexpr uint32_t BRICK_WORDS = BRICK_CELLS / 64;
+    // Array bricks above this many cells become bitmaps (equal byte size)
+    static constexpr uint32_t ARRAY_MAX = BRICK_CELLS / 16;
+
+    // Insert and erase return whether the cells changed
+    bool insert(uint16_t cell);
+    bool erase(uint16_t cell);
+    bool contains(uint16_t cell) const;
+    void clear();
+
+    // In-place set algebra; results fall back to arrays when sparse
+    void unite(const BrickCells& other);
+    void intersect(const BrickCells& other);
+    void subtract(const BrickCells& other);
+    void symmetricDifference(const BrickCells& other);
+
+    bool operator==(const BrickCells& other) const;
+    bool operator!=(const BrickCells& other) const { return !(*this == other); }
+
+    uint32_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+    bool isBitmap() const { return !m_bits.empty(); }
+
+    // First set cell at or after pos, or BRICK_CELLS if none
+    uint32_t nextCell(uint32_t pos) const;
+    // Smallest and largest local cell coordinate per axis; cells must not be empty
+    void getExtent(int lo[3], int hi[3]) const;
+    // Sum of the local x, y and z coordinates of all cells
+    std::array<uint32_t, 3> getCellSum() const;
+    size_t getMemoryUsage() const;
+
+    template<typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        for (uint32_t cell = nextCell(0); cell < BRICK_CELLS; cell = nextCell(cell + 1)) {
+            visitor(static_cast<uint16_t>(cell));
+        }
+    }
+
+    // Brick addressing: a 4-bit level (the resolution) and 20-bit signed
+    // brick coordinates per axis, packed into one key
+    static uint64_t brickKey(uint32_t level, const Vector3i& position);
+    static uint16_t cellIndex(const Vector3i& position);
+    static uint32_t keyLevel(uint64_t key) { return static_cast<uint32_t>(key >> 60); }
+    // Position of cell (0, 0, 0) of the brick
+    static Vector3i brickOrigin(uint64_t key);
+    static Vector3i cellPosition(uint64_t key, uint32_t cell);
+
+private:
+    enum class Op { Union, Intersect, Subtract, Xor };
+
+    std::vector<uint16_t> m_array;  // Sorted cell offsets while sparse
+    std::vector<uint64_t> m_bits;   // BRICK_WORDS words once dense
+    uint32_t m_count = 0;
+
+    void combine(const BrickCells& other, Op op);
+    void toWords(uint64_t* words) const;
+    void assignWords(const uint64_t* words);
+    void assignArray(std::vector<uint16_t>&& cells);
+    void toBitmap();
+    void toArray();
+};
+
+} // namespace Math
+} // namespace VoxelEditor
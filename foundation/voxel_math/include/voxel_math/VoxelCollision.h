@@ -127,7 +127,9 @@ public:
     
     /**
      * Check if placing a voxel would create a stable structure
-     * (has support underneath or is on ground)
+     * (on ground, has support underneath, or touches a face of an island
+     * that reaches the ground). Island lookups use the grid's cached
+     * connectivity, so this does not scan the grid.
      * @param pos Position to check (bottom-center, 1cm units)
      * @param resolution Resolution of voxel to place
      * @param grid Voxel grid to check against
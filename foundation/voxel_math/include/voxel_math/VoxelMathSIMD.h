@@ -4,6 +4,7 @@
 #include "../../../core/voxel_data/VoxelTypes.h"
 #include "VoxelBounds.h"
 #include <cstddef>
+#include <vector>
 
 // Use Eigen for cross-platform optimized vector math
 // Eigen automatically detects and uses the best available SIMD instructions
@@ -21,6 +22,63 @@ namespace Math {
  */
 class VoxelMathSIMD {
 public:
+    /**
+     * Instruction sets the runtime-dispatched kernels can run on, from
+     * narrowest to widest. Detected once from the CPU, not the compiler flags.
+     */
+    enum class SIMDLevel {
+        Scalar,
+        AVX2,
+        AVX512
+    };
+    
+    /**
+     * Structure-of-arrays view of axis-aligned boxes.
+     * Each pointer addresses count floats; no alignment is required.
+     */
+    struct BoundsSoA {
+        const float* minX;
+        const float* minY;
+        const float* minZ;
+        const float* maxX;
+        const float* maxY;
+        const float* maxZ;
+    };
+    
+    /**
+     * Structure-of-arrays view of points
+     */
+    struct PointsSoA {
+        const float* x;
+        const float* y;
+        const float* z;
+    };
+    
+    /**
+     * Owning storage behind a BoundsSoA, filled one box at a time
+     */
+    class BoundsBuffer {
+    public:
+        void reserve(size_t count);
+        void clear();
+        void push(const Vector3f& min, const Vector3f& max);
+        size_t size() const { return m_minX.size(); }
+        BoundsSoA view() const;
+        
+    private:
+        std::vector<float> m_minX, m_minY, m_minZ;
+        std::vector<float> m_maxX, m_maxY, m_maxZ;
+    };
+    
+    /**
+     * How a box is tested against a query box
+     */
+    enum class BoxTest {
+        Overlap,    // Interiors overlap; touching faces don't count (VoxelCollision::boundsOverlap)
+        Intersect,  // Closed boxes share a point (BoundingBox::intersects)
+        Contained   // Box lies inside the query (BoundingBox::contains)
+    };
+    
     /**
      * Bulk coordinate conversions using SIMD when available
      * @param world Array of world coordinates to convert
@@ -122,6 +180,86 @@ public:
                                          float* results,
                                          size_t count);
     
+    /**
+     * Bulk integer lattice transform: out = rotation * in + offset.
+     * Exact, so it suits rigid moves that keep voxels on the 1cm grid.
+     * @param positions Array of increment positions to transform
+     * @param[out] results Array to store transformed positions (may alias positions)
+     * @param count Number of positions
+     * @param rotation Row-major 3x3 integer matrix, or nullptr for a pure translation
+     * @param offset Translation in increments, applied after rotation
+     */
+    static void transformIncrementBatch(const IncrementCoordinates* positions,
+                                       IncrementCoordinates* results,
+                                       size_t count,
+                                       const int* rotation,
+                                       const Vector3i& offset);
+    
+    /**
+     * Test many boxes against one query box
+     * @param bounds Boxes to test
+     * @param boxMin Minimum corner of the query box
+     * @param boxMax Maximum corner of the query box
+     * @param test Relation to test for
+     * @param[out] results Array to store test results
+     * @param count Number of boxes
+     */
+    static void testBoundsAgainstBoxSoA(const BoundsSoA& bounds,
+                                        const Vector3f& boxMin,
+                                        const Vector3f& boxMax,
+                                        BoxTest test,
+                                        bool* results,
+                                        size_t count);
+    
+    /**
+     * Test many boxes against a sphere: a box passes when its closest point
+     * to the center lies within the radius. Pass min == max to test points.
+     * @param bounds Boxes to test
+     * @param center Sphere center
+     * @param radius Sphere radius
+     * @param[out] results Array to store test results
+     * @param count Number of boxes
+     */
+    static void testBoundsAgainstSphereSoA(const BoundsSoA& bounds,
+                                           const Vector3f& center,
+                                           float radius,
+                                           bool* results,
+                                           size_t count);
+    
+    /**
+     * Distances from many points to one target
+     * @param points Points to measure from
+     * @param target Point to measure to
+     * @param[out] distances Array to store calculated distances
+     * @param count Number of points
+     */
+    static void calculateDistancesSoA(const PointsSoA& points,
+                                      const Vector3f& target,
+                                      float* distances,
+                                      size_t count);
+    
+    /**
+     * Widest instruction set the CPU and OS support
+     */
+    static SIMDLevel getSupportedSIMDLevel();
+    
+    /**
+     * Instruction set the dispatched kernels currently use
+     */
+    static SIMDLevel getSIMDLevel();
+    
+    /**
+     * Restrict the dispatched kernels to an instruction set, e.g. to compare
+     * levels in a benchmark. Levels above the supported one are clamped.
+     * @param level Widest instruction set to use
+     */
+    static void setSIMDLevel(SIMDLevel level);
+    
+    /**
+     * Get the display name of an instruction set
+     */
+    static const char* getSIMDLevelName(SIMDLevel level);
+    
     /**
      * Check if SIMD is available on this platform
      * @return True if SIMD optimizations are available
@@ -145,6 +283,12 @@ private:
     static constexpr float METERS_TO_CM = 100.0f;
     static constexpr float CM_TO_METERS = 0.01f;
     
+    // Dispatched body of transformIncrementBatch for pure translations
+    static void translateIncrementBatch(const IncrementCoordinates* positions,
+                                        IncrementCoordinates* results,
+                                        size_t count,
+                                        const Vector3i& offset);
+    
     // Fallback implementations (scalar)
     static void worldToIncrementScalar(const WorldCoordinates* world,
                                       IncrementCoordinates* increment,
@@ -65,6 +65,28 @@ public:
                                    VoxelData::VoxelResolution resolution,
                                    float maxDistance = 1000.0f);
     
+    /**
+     * Cast many rays against a voxel grid at once.
+     * Rays go through the grid's octree in packets of
+     * VoxelData::SparseOctree::RAY_PACKET_SIZE that share their node tests,
+     * so keep coherent rays (a selection sweep, a controller beam, a scan
+     * pattern) next to each other. Large batches are split across threads.
+     * @param rays Rays in world coordinates
+     * @param[out] results One result per ray, as raycastGrid would return it
+     * @param count Number of rays
+     * @param grid Voxel grid to cast against
+     * @param resolution Resolution to check
+     * @param maxDistance Maximum distance to cast in meters
+     * @param threadCount Worker threads to use, or 0 for the hardware concurrency
+     */
+    static void raycastGridBatch(const Ray* rays,
+                                 RaycastResult* results,
+                                 size_t count,
+                                 const VoxelData::VoxelGrid& grid,
+                                 VoxelData::VoxelResolution resolution,
+                                 float maxDistance = 1000.0f,
+                                 unsigned int threadCount = 0);
+
     /**
      * Get all voxel positions along a ray path
      * @param ray Ray in world coordinates
@@ -123,6 +145,16 @@ public:
     calculateRayVoxelIntersection(const Ray& ray, const VoxelBounds& voxelBounds);
     
 private:
+    /**
+     * Single-threaded body of raycastGridBatch
+     */
+    static void raycastGridPackets(const Ray* rays,
+                                   RaycastResult* results,
+                                   size_t count,
+                                   const VoxelData::VoxelGrid& grid,
+                                   VoxelData::VoxelResolution resolution,
+                                   float maxDistance);
+
     /**
      * DDA (Digital Differential Analyzer) traversal state
      */
@@ -201,6 +233,7 @@ private:
     // Constants for optimization
     static constexpr float EPSILON = 1e-6f;
     static constexpr int MAX_TRAVERSAL_STEPS = 10000;
+    static constexpr size_t MIN_RAYS_PER_THREAD = 1024;
 };
 
 } // namespace Math
@@ -0,0 +1,402 @@
+#include "../include/voxel_math/BrickCells.h"
+#include <algorithm>
+#include <iterator>
+
+namespace VoxelEditor {
+namespace Math {
+
+namespace {
+
+constexpr uint32_t BRICK_WORDS = BrickCells::BRICK_WORDS;
+constexpr uint64_t COORD_MASK = (1ull << 20) - 1;
+
+inline uint32_t popcount64(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_popcountll(value));
+#else
+    uint32_t count = 0;
+    while (value) {
+        value &= value - 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+inline uint32_t countTrailingZeros64(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctzll(value));
+#else
+    uint32_t count = 0;
+    while ((value & 1) == 0) {
+        value >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+inline int32_t signExtend20(uint64_t value) {
+    return static_cast<int32_t>(static_cast<uint32_t>(value << 12)) >> 12;
+}
+
+inline int highestBit16(uint32_t mask) {
+    int bit = 15;
+    while (bit > 0 && !((mask >> bit) & 1)) {
+        --bit;
+    }
+    return bit;
+}
+
+}
+
+// Element access
+
+bool BrickCells::insert(uint16_t cell) {
+    if (isBitmap()) {
+        uint64_t& word = m_bits[cell >> 6];
+        uint64_t bit = 1ull << (cell & 63);
+        if (word & bit) return false;
+        word |= bit;
+        ++m_count;
+        return true;
+    }
+
+    auto it = std::lower_bound(m_array.begin(), m_array.end(), cell);
+    if (it != m_array.end() && *it == cell) return false;
+    m_array.insert(it, cell);
+    ++m_count;
+    if (m_count > ARRAY_MAX) {
+        toBitmap();
+    }
+    return true;
+}
+
+bool BrickCells::erase(uint16_t cell) {
+    if (isBitmap()) {
+        uint64_t& word = m_bits[cell >> 6];
+        uint64_t bit = 1ull << (cell & 63);
+        if (!(word & bit)) return false;
+        word &= ~bit;
+        --m_count;
+        // Drop back to an array with some slack so a cell toggling on the
+        // boundary does not convert every time
+        if (m_count <= ARRAY_MAX / 2) {
+            toArray();
+        }
+        return true;
+    }
+
+    auto it = std::lower_bound(m_array.begin(), m_array.end(), cell);
+    if (it == m_array.end() || *it != cell) return false;
+    m_array.erase(it);
+    --m_count;
+    if (m_array.empty()) {
+        m_array.shrink_to_fit();
+    }
+    return true;
+}
+
+bool BrickCells::contains(uint16_t cell) const {
+    if (isBitmap()) {
+        return (m_bits[cell >> 6] >> (cell & 63)) & 1;
+    }
+    return std::binary_search(m_array.begin(), m_array.end(), cell);
+}
+
+void BrickCells::clear() {
+    std::vector<uint16_t>().swap(m_array);
+    std::vector<uint64_t>().swap(m_bits);
+    m_count = 0;
+}
+
+// Set algebra
+
+void BrickCells::unite(const BrickCells& other) {
+    if (other.empty()) return;
+    if (empty()) {
+        *this = other;
+        return;
+    }
+    combine(other, Op::Union);
+}
+
+void BrickCells::intersect(const BrickCells& other) {
+    if (empty()) return;
+    if (other.empty()) {
+        clear();
+        return;
+    }
+    combine(other, Op::Intersect);
+}
+
+void BrickCells::subtract(const BrickCells& other) {
+    if (empty() || other.empty()) return;
+    combine(other, Op::Subtract);
+}
+
+void BrickCells::symmetricDifference(const BrickCells& other) {
+    if (other.empty()) return;
+    if (empty()) {
+        *this = other;
+        return;
+    }
+    combine(other, Op::Xor);
+}
+
+bool BrickCells::operator==(const BrickCells& other) const {
+    if (m_count != other.m_count) {
+        return false;
+    }
+    if (!isBitmap() && !other.isBitmap()) {
+        return m_array == other.m_array;
+    }
+    uint64_t left[BRICK_WORDS];
+    uint64_t right[BRICK_WORDS];
+    toWords(left);
+    other.toWords(right);
+    return std::equal(left, left + BRICK_WORDS, right);
+}
+
+void BrickCells::combine(const BrickCells& other, Op op) {
+    if (!isBitmap() && !other.isBitmap()) {
+        std::vector<uint16_t> cells;
+        auto out = std::back_inserter(cells);
+        const auto& a = m_array;
+        const auto& b = other.m_array;
+        switch (op) {
+            case Op::Union:
+                cells.reserve(a.size() + b.size());
+                std::set_union(a.begin(), a.end(), b.begin(), b.end(), out);
+                break;
+            case Op::Intersect:
+                std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), out);
+                break;
+            case Op::Subtract:
+                std::set_difference(a.begin(), a.end(), b.begin(), b.end(), out);
+                break;
+            case Op::Xor:
+                std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), out);
+                break;
+        }
+        assignArray(std::move(cells));
+        return;
+    }
+
+    // Filtering an array against a bitmap avoids expanding it
+    if (!isBitmap() && (op == Op::Intersect || op == Op::Subtract)) {
+        bool keepPresent = op == Op::Intersect;
+        auto end = std::remove_if(m_array.begin(), m_array.end(),
+                                  [&](uint16_t cell) { return other.contains(cell) != keepPresent; });
+        m_array.erase(end, m_array.end());
+        m_count = static_cast<uint32_t>(m_array.size());
+        return;
+    }
+
+    // Folding an array into a bitmap touches only its cells
+    if (isBitmap() && !other.isBitmap() && op == Op::Union) {
+        for (uint16_t cell : other.m_array) {
+            uint64_t& word = m_bits[cell >> 6];
+            uint64_t bit = 1ull << (cell & 63);
+            m_count += (word & bit) ? 0 : 1;
+            word |= bit;
+        }
+        return;
+    }
+
+    uint64_t left[BRICK_WORDS];
+    uint64_t right[BRICK_WORDS];
+    toWords(left);
+    other.toWords(right);
+    for (uint32_t w = 0; w < BRICK_WORDS; ++w) {
+        switch (op) {
+            case Op::Union:     left[w] |= right[w]; break;
+            case Op::Intersect: left[w] &= right[w]; break;
+            case Op::Subtract:  left[w] &= ~right[w]; break;
+            case Op::Xor:       left[w] ^= right[w]; break;
+        }
+    }
+    assignWords(left);
+}
+
+// Queries
+
+uint32_t BrickCells::nextCell(uint32_t pos) const {
+    if (!isBitmap()) {
+        auto it = std::lower_bound(m_array.begin(), m_array.end(), pos);
+        return it != m_array.end() ? *it : BRICK_CELLS;
+    }
+
+    // Skip to the next set bit, a word at a time
+    uint32_t word = pos >> 6;
+    if (word >= BRICK_WORDS) return BRICK_CELLS;
+    uint64_t bits = m_bits[word] & (~0ull << (pos & 63));
+    while (bits == 0 && ++word < BRICK_WORDS) {
+        bits = m_bits[word];
+    }
+    return bits != 0 ? word * 64 + countTrailingZeros64(bits) : BRICK_CELLS;
+}
+
+void BrickCells::getExtent(int lo[3], int hi[3]) const {
+    uint32_t masks[3] = {0, 0, 0};
+    if (isBitmap()) {
+        // Within word w, bit b is cell w * 64 + b: x = w / 4,
+        // y = (w % 4) * 4 + b / 16 and z = b % 16
+        for (uint32_t w = 0; w < BRICK_WORDS; ++w) {
+            uint64_t word = m_bits[w];
+            if (word == 0) continue;
+            masks[0] |= 1u << (w >> 2);
+            for (uint32_t lane = 0; lane < 4; ++lane) {
+                uint32_t cells = static_cast<uint32_t>(word >> (16 * lane)) & 0xFFFF;
+                if (cells) {
+                    masks[1] |= 1u << ((w & 3) * 4 + lane);
+                    masks[2] |= cells;
+                }
+            }
+        }
+    } else {
+        for (uint16_t cell : m_array) {
+            masks[0] |= 1u << (cell >> 8);
+            masks[1] |= 1u << ((cell >> 4) & 15);
+            masks[2] |= 1u << (cell & 15);
+        }
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        lo[axis] = static_cast<int>(countTrailingZeros64(masks[axis]));
+        hi[axis] = highestBit16(masks[axis]);
+    }
+}
+
+std::array<uint32_t, 3> BrickCells::getCellSum() const {
+    std::array<uint32_t, 3> sum = {0, 0, 0};
+    if (!isBitmap()) {
+        for (uint16_t cell : m_array) {
+            sum[0] += cell >> 8;
+            sum[1] += (cell >> 4) & 15;
+            sum[2] += cell & 15;
+        }
+        return sum;
+    }
+
+    // A word at a time: per word x is fixed, y takes four lanes of 16 bits
+    // and z is the bit within the lane
+    static const uint64_t zMasks[4] = {
+        0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull, 0xFF00FF00FF00FF00ull
+    };
+    static const uint64_t laneMasks[2] = { 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull };
+
+    for (uint32_t w = 0; w < BRICK_WORDS; ++w) {
+        uint64_t word = m_bits[w];
+        if (word == 0) continue;
+        uint32_t count = popcount64(word);
+        sum[0] += count * (w >> 2);
+        sum[1] += count * ((w & 3) * 4) + popcount64(word & laneMasks[0]) + 2 * popcount64(word & laneMasks[1]);
+        for (uint32_t bit = 0; bit < 4; ++bit) {
+            sum[2] += popcount64(word & zMasks[bit]) << bit;
+        }
+    }
+    return sum;
+}
+
+size_t BrickCells::getMemoryUsage() const {
+    return m_array.capacity() * sizeof(uint16_t) + m_bits.capacity() * sizeof(uint64_t);
+}
+
+// Brick addressing
+
+uint64_t BrickCells::brickKey(uint32_t level, const Vector3i& position) {
+    uint64_t bx = static_cast<uint64_t>(position.x >> BRICK_SHIFT) & COORD_MASK;
+    uint64_t by = static_cast<uint64_t>(position.y >> BRICK_SHIFT) & COORD_MASK;
+    uint64_t bz = static_cast<uint64_t>(position.z >> BRICK_SHIFT) & COORD_MASK;
+    return (static_cast<uint64_t>(level) << 60) | (bx << 40) | (by << 20) | bz;
+}
+
+uint16_t BrickCells::cellIndex(const Vector3i& position) {
+    const int mask = BRICK_SIZE - 1;
+    return static_cast<uint16_t>(((position.x & mask) << (2 * BRICK_SHIFT)) |
+                                 ((position.y & mask) << BRICK_SHIFT) |
+                                 (position.z & mask));
+}
+
+Vector3i BrickCells::brickOrigin(uint64_t key) {
+    return Vector3i(signExtend20(key >> 40) * BRICK_SIZE,
+                    signExtend20(key >> 20) * BRICK_SIZE,
+                    signExtend20(key) * BRICK_SIZE);
+}
+
+Vector3i BrickCells::cellPosition(uint64_t key, uint32_t cell) {
+    const uint32_t mask = BRICK_SIZE - 1;
+    return brickOrigin(key) + Vector3i(static_cast<int>((cell >> (2 * BRICK_SHIFT)) & mask),
+                                       static_cast<int>((cell >> BRICK_SHIFT) & mask),
+                                       static_cast<int>(cell & mask));
+}
+
+// Representation
+
+void BrickCells::toWords(uint64_t* words) const {
+    if (isBitmap()) {
+        std::copy(m_bits.begin(), m_bits.end(), words);
+        return;
+    }
+    std::fill(words, words + BRICK_WORDS, 0);
+    for (uint16_t cell : m_array) {
+        words[cell >> 6] |= 1ull << (cell & 63);
+    }
+}
+
+void BrickCells::assignWords(const uint64_t* words) {
+    m_count = 0;
+    for (uint32_t w = 0; w < BRICK_WORDS; ++w) {
+        m_count += popcount64(words[w]);
+    }
+    if (m_count > ARRAY_MAX) {
+        m_bits.assign(words, words + BRICK_WORDS);
+        std::vector<uint16_t>().swap(m_array);
+        return;
+    }
+
+    m_array.clear();
+    m_array.reserve(m_count);
+    for (uint32_t w = 0; w < BRICK_WORDS; ++w) {
+        uint64_t word = words[w];
+        while (word) {
+            m_array.push_back(static_cast<uint16_t>(w * 64 + countTrailingZeros64(word)));
+            word &= word - 1;
+        }
+    }
+    std::vector<uint64_t>().swap(m_bits);
+}
+
+void BrickCells::assignArray(std::vector<uint16_t>&& cells) {
+    m_array = std::move(cells);
+    m_count = static_cast<uint32_t>(m_array.size());
+    std::vector<uint64_t>().swap(m_bits);
+    if (m_count > ARRAY_MAX) {
+        toBitmap();
+    }
+}
+
+void BrickCells::toBitmap() {
+    m_bits.assign(BRICK_WORDS, 0);
+    for (uint16_t cell : m_array) {
+        m_bits[cell >> 6] |= 1ull << (cell & 63);
+    }
+    std::vector<uint16_t>().swap(m_array);
+}
+
+void BrickCells::toArray() {
+    std::vector<uint16_t> cells;
+    cells.reserve(m_count);
+    for (uint32_t w = 0; w < BRICK_WORDS; ++w) {
+        uint64_t word = m_bits[w];
+        while (word) {
+            cells.push_back(static_cast<uint16_t>(w * 64 + countTrailingZeros64(word)));
+            word &= word - 1;
+        }
+    }
+    m_array = std::move(cells);
+    std::vector<uint64_t>().swap(m_bits);
+}
+
+} // namespace Math
+} // namespace VoxelEditor
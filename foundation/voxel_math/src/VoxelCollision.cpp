@@ -1,15 +1,68 @@
 #include "../include/voxel_math/VoxelCollision.h"
 #include "../include/voxel_math/VoxelGridMath.h"
 #include "../include/voxel_math/FaceOperations.h"
+#include "../include/voxel_math/VoxelMathSIMD.h"
 #include "../../../core/voxel_data/VoxelGrid.h"
 #include "../../math/CoordinateConverter.h"
 #include <algorithm>
 #include <cmath>
+#include <memory>
 #include <queue>
 
 namespace VoxelEditor {
 namespace Math {
 
+namespace {
+
+// Voxels of the grid whose bounds overlap a region, by the same test as
+// VoxelCollision::boundsOverlap. Only the octree range that could reach the
+// region is read, and its voxels are tested in SIMD batches.
+std::vector<VoxelData::VoxelPosition> overlappingVoxels(const VoxelBounds& region,
+                                                        const VoxelData::VoxelGrid& grid) {
+    int sizeCm = VoxelGridMath::getVoxelSizeCm(grid.getResolution());
+    float sizeMeters = VoxelGridMath::getVoxelSizeMeters(grid.getResolution());
+    Vector3f regionMin = region.min().value();
+    Vector3f regionMax = region.max().value();
+    
+    // A bottom-center voxel at p spans p +- size/2 in X and Z and
+    // [p, p + size] in Y. Pad by a voxel and a centimeter so rounding never
+    // drops a candidate, and clamp to the workspace so the range fits in ints.
+    const Vector3f& workspace = grid.getWorkspaceSize();
+    Vector3f limit(workspace.x * 50.0f + sizeCm, workspace.y * 100.0f + sizeCm, workspace.z * 50.0f + sizeCm);
+    auto toCm = [](float meters, float bound) {
+        return static_cast<int>(std::floor(std::clamp(meters * 100.0f, -bound, bound)));
+    };
+    IncrementCoordinates rangeMin(toCm(regionMin.x, limit.x) - sizeCm - 1,
+                                  toCm(regionMin.y, limit.y) - sizeCm - 1,
+                                  toCm(regionMin.z, limit.z) - sizeCm - 1);
+    IncrementCoordinates rangeMax(toCm(regionMax.x, limit.x) + sizeCm + 1,
+                                  toCm(regionMax.y, limit.y) + 1,
+                                  toCm(regionMax.z, limit.z) + sizeCm + 1);
+    
+    auto candidates = grid.getVoxelsInRange(rangeMin, rangeMax);
+    VoxelMathSIMD::BoundsBuffer bounds;
+    bounds.reserve(candidates.size());
+    for (const auto& voxel : candidates) {
+        VoxelBounds voxelBounds(voxel.incrementPos, sizeMeters);
+        bounds.push(voxelBounds.min().value(), voxelBounds.max().value());
+    }
+    
+    std::unique_ptr<bool[]> overlaps(new bool[candidates.size()]);
+    VoxelMathSIMD::testBoundsAgainstBoxSoA(bounds.view(), regionMin, regionMax,
+                                           VoxelMathSIMD::BoxTest::Overlap,
+                                           overlaps.get(), candidates.size());
+    
+    std::vector<VoxelData::VoxelPosition> result;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (overlaps[i]) {
+            result.push_back(candidates[i]);
+        }
+    }
+    return result;
+}
+
+}
+
 bool VoxelCollision::checkCollision(const IncrementCoordinates& pos1, VoxelData::VoxelResolution res1,
                                    const IncrementCoordinates& pos2, VoxelData::VoxelResolution res2) {
     // Create bounds for both voxels
@@ -21,10 +74,10 @@ bool VoxelCollision::checkCollision(const IncrementCoordinates& pos1, VoxelData:
 }
 
 bool VoxelCollision::boundsOverlap(const VoxelBounds& bounds1, const VoxelBounds& bounds2) {
-    const Vector3f& min1 = bounds1.min().value();
-    const Vector3f& max1 = bounds1.max().value();
-    const Vector3f& min2 = bounds2.min().value();
-    const Vector3f& max2 = bounds2.max().value();
+    Vector3f min1 = bounds1.min().value();
+    Vector3f max1 = bounds1.max().value();
+    Vector3f min2 = bounds2.min().value();
+    Vector3f max2 = bounds2.max().value();
     
     // Check for separation along each axis
     // If separated along any axis, they don't overlap
@@ -40,17 +93,8 @@ bool VoxelCollision::checkCollisionWithGrid(const IncrementCoordinates& pos,
     // Create bounds for the voxel we want to place
     VoxelBounds placementBounds(pos, VoxelGridMath::getVoxelSizeMeters(resolution));
     
-    // Get all voxels from the grid
-    auto allVoxels = grid.getAllVoxels();
-    
-    // Check collision with each existing voxel
-    for (const auto& voxelData : allVoxels) {
-        if (checkCollision(pos, resolution, voxelData.incrementPos, voxelData.resolution)) {
-            return true;  // Collision found
-        }
-    }
-    
-    return false;  // No collision
+    // Any existing voxel overlapping those bounds is a collision
+    return !overlappingVoxels(placementBounds, grid).empty();
 }
 
 std::vector<VoxelCollision::VoxelInfo> VoxelCollision::getCollidingVoxels(
@@ -63,14 +107,8 @@ std::vector<VoxelCollision::VoxelInfo> VoxelCollision::getCollidingVoxels(
     // Create bounds for the voxel we want to place
     VoxelBounds placementBounds(pos, VoxelGridMath::getVoxelSizeMeters(resolution));
     
-    // Get all voxels from the grid
-    auto allVoxels = grid.getAllVoxels();
-    
-    // Check collision with each existing voxel
-    for (const auto& voxelData : allVoxels) {
-        if (checkCollision(pos, resolution, voxelData.incrementPos, voxelData.resolution)) {
-            collidingVoxels.emplace_back(voxelData.incrementPos, voxelData.resolution);
-        }
+    for (const auto& voxelData : overlappingVoxels(placementBounds, grid)) {
+        collidingVoxels.emplace_back(voxelData.incrementPos, voxelData.resolution);
     }
     
     return collidingVoxels;
@@ -82,18 +120,8 @@ std::vector<VoxelCollision::VoxelInfo> VoxelCollision::getVoxelsInRegion(
     
     std::vector<VoxelInfo> voxelsInRegion;
     
-    // Get all voxels from the grid
-    auto allVoxels = grid.getAllVoxels();
-    
-    // Check each voxel to see if it's in the region
-    for (const auto& voxelData : allVoxels) {
-        VoxelBounds voxelBounds(voxelData.incrementPos, 
-                               VoxelGridMath::getVoxelSizeMeters(voxelData.resolution));
-        
-        // Check if voxel bounds overlap with region
-        if (boundsOverlap(voxelBounds, region)) {
-            voxelsInRegion.emplace_back(voxelData.incrementPos, voxelData.resolution);
-        }
+    for (const auto& voxelData : overlappingVoxels(region, grid)) {
+        voxelsInRegion.emplace_back(voxelData.incrementPos, voxelData.resolution);
     }
     
     return voxelsInRegion;
@@ -235,10 +263,10 @@ float VoxelCollision::calculateIntersectionVolume(const IncrementCoordinates& po
     VoxelBounds bounds2(pos2, VoxelGridMath::getVoxelSizeMeters(res2));
     
     // Get min/max for both bounds
-    const Vector3f& min1 = bounds1.min().value();
-    const Vector3f& max1 = bounds1.max().value();
-    const Vector3f& min2 = bounds2.min().value();
-    const Vector3f& max2 = bounds2.max().value();
+    Vector3f min1 = bounds1.min().value();
+    Vector3f max1 = bounds1.max().value();
+    Vector3f min2 = bounds2.min().value();
+    Vector3f max2 = bounds2.max().value();
     
     // Calculate intersection box
     float intersectMinX = std::max(min1.x, min2.x);
@@ -271,35 +299,30 @@ bool VoxelCollision::checkStability(const IncrementCoordinates& pos,
         return true;  // On ground, stable
     }
     
-    // Check if there's support underneath
-    IncrementCoordinates belowPos = VoxelGridMath::getAdjacentPosition(
-        pos, VoxelData::FaceDirection::NegY, resolution);
-    
-    // Check if there's any voxel below that could provide support
-    auto allVoxels = grid.getAllVoxels();
-    VoxelBounds ourBounds(pos, VoxelGridMath::getVoxelSizeMeters(resolution));
+    // Direct support: a voxel whose top face is our bottom face and whose
+    // footprint overlaps ours (touching edges count)
+    const int ourSize = VoxelGridMath::getVoxelSizeCm(resolution);
+    const int gridSize = VoxelGridMath::getVoxelSizeCm(grid.getResolution());
+    const int reach = (ourSize + gridSize) / 2;
+    const int supportY = pos.y() - gridSize;
+    if (supportY >= 0) {
+        auto below = grid.getVoxelsInRange(
+            IncrementCoordinates(pos.x() - reach, supportY, pos.z() - reach),
+            IncrementCoordinates(pos.x() + reach, supportY, pos.z() + reach));
+        if (!below.empty()) {
+            return true;  // Has support
+        }
+    }
     
-    for (const auto& voxelData : allVoxels) {
-        // Check if this voxel is below us
-        if (voxelData.incrementPos.y() < pos.y()) {
-            VoxelBounds theirBounds(voxelData.incrementPos, 
-                                   VoxelGridMath::getVoxelSizeMeters(voxelData.resolution));
-            
-            // Check if their top face overlaps with our bottom face
-            // Simplified check - in practice you'd want more precise support calculation
-            if (std::abs(theirBounds.max().value().y - ourBounds.min().value().y) < 0.001f) {
-                // Check X-Z overlap
-                const Vector3f& theirMin = theirBounds.min().value();
-                const Vector3f& theirMax = theirBounds.max().value();
-                const Vector3f& ourMin = ourBounds.min().value();
-                const Vector3f& ourMax = ourBounds.max().value();
-                
-                bool xOverlap = !(theirMax.x < ourMin.x || theirMin.x > ourMax.x);
-                bool zOverlap = !(theirMax.z < ourMin.z || theirMin.z > ourMax.z);
-                
-                if (xOverlap && zOverlap) {
-                    return true;  // Has support
-                }
+    // Otherwise the placement is stable when it joins, face to face, an
+    // island that reaches the ground
+    if (resolution == grid.getResolution()) {
+        const VoxelData::VoxelConnectivity& connectivity = grid.getConnectivity();
+        IncrementCoordinates neighbors[6];
+        VoxelGridMath::getAdjacentPositions(pos, resolution, neighbors);
+        for (const auto& neighbor : neighbors) {
+            if (connectivity.isGrounded(connectivity.getComponent(neighbor, resolution))) {
+                return true;
             }
         }
     }
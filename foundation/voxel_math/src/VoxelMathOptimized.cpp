@@ -179,13 +179,72 @@ void VoxelMathSIMD::calculateDotProductsBatch(const Vector3f* vectors1,
     }
 }
 
+void VoxelMathSIMD::transformIncrementBatch(const IncrementCoordinates* positions,
+                                           IncrementCoordinates* results,
+                                           size_t count,
+                                           const int* rotation,
+                                           const Vector3i& offset) {
+    if (count == 0) return;
+    
+    if (!rotation) {
+        // Translation only: the runtime-dispatched kernel adds a tiled
+        // offset over whole AVX2 or AVX-512 registers
+        translateIncrementBatch(positions, results, count, offset);
+        return;
+    }
+    
+    // Positions are packed x, y, z ints, so the arrays can be viewed as
+    // 3xN integer matrices without copying
+    static_assert(sizeof(IncrementCoordinates) == 3 * sizeof(int),
+                  "IncrementCoordinates must be three packed ints");
+    const int* src = reinterpret_cast<const int*>(positions);
+    int* dst = reinterpret_cast<int*>(results);
+    
+    constexpr int CHUNK_SIZE = 16;
+    using Chunk = Eigen::Matrix<int, 3, CHUNK_SIZE>;
+    
+    const Eigen::Vector3i translation(offset.x, offset.y, offset.z);
+    size_t fullChunks = count / CHUNK_SIZE;
+    
+    Eigen::Matrix3i matrix;
+    matrix << rotation[0], rotation[1], rotation[2],
+              rotation[3], rotation[4], rotation[5],
+              rotation[6], rotation[7], rotation[8];
+    for (size_t c = 0; c < fullChunks; ++c) {
+        Eigen::Map<const Chunk> in(src + c * 3 * CHUNK_SIZE);
+        Eigen::Map<Chunk> out(dst + c * 3 * CHUNK_SIZE);
+        Chunk transformed = matrix * in;
+        out = transformed.colwise() + translation;
+    }
+    
+    // Remainder
+    for (size_t i = fullChunks * CHUNK_SIZE; i < count; ++i) {
+        const Vector3i& p = positions[i].value();
+        Vector3i r(rotation[0] * p.x + rotation[1] * p.y + rotation[2] * p.z,
+                   rotation[3] * p.x + rotation[4] * p.y + rotation[5] * p.z,
+                   rotation[6] * p.x + rotation[7] * p.y + rotation[8] * p.z);
+        results[i] = IncrementCoordinates(r.x + offset.x, r.y + offset.y, r.z + offset.z);
+    }
+}
+
 bool VoxelMathSIMD::isSIMDAvailable() {
-    // With Eigen, SIMD is always "available" since it provides optimized
-    // implementations regardless of the underlying hardware
+    // Either the dispatched kernels found a vector unit at runtime or
+    // Eigen was compiled for one
+#ifdef EIGEN_VECTORIZE
     return true;
+#else
+    return getSIMDLevel() != SIMDLevel::Scalar;
+#endif
 }
 
 const char* VoxelMathSIMD::getSIMDInstructionSet() {
+    // The dispatched kernels are chosen at runtime; report them when the
+    // CPU has a wider instruction set than the one Eigen was compiled for
+    SIMDLevel level = getSIMDLevel();
+    if (level != SIMDLevel::Scalar) {
+        return getSIMDLevelName(level);
+    }
+    
     // Eigen automatically detects and uses the best available instructions
 #if defined(EIGEN_VECTORIZE_AVX512)
     return "Eigen (AVX512)";
@@ -1,387 +1,438 @@
 #include "../include/voxel_math/VoxelMathSIMD.h"
-#include "../include/voxel_math/VoxelCollision.h"
-#include "../../math/CoordinateConverter.h"
-#include <cmath>
 #include <algorithm>
-#include <cstring>
+#include <atomic>
+#include <cmath>
+
+// Kernels for wider instruction sets are compiled per function with target
+// attributes and picked at runtime, so one binary runs on any x86-64 CPU
+// and still uses AVX2 or AVX-512 where the CPU has them
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define VOXEL_MATH_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
 
 namespace VoxelEditor {
 namespace Math {
 
-bool VoxelMathSIMD::isSIMDAvailable() {
-#ifdef __AVX2__
-    return true;
-#elif defined(__SSE4_1__)
-    return true;
-#elif defined(__ARM_NEON)
-    return true;
-#else
-    return false;
+using SIMDLevel = VoxelMathSIMD::SIMDLevel;
+using BoxTest = VoxelMathSIMD::BoxTest;
+using BoundsSoA = VoxelMathSIMD::BoundsSoA;
+using PointsSoA = VoxelMathSIMD::PointsSoA;
+
+namespace {
+
+SIMDLevel detectSIMDLevel() {
+#ifdef VOXEL_MATH_X86_DISPATCH
+    // Also checks that the OS saves the wider registers
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SIMDLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SIMDLevel::AVX2;
 #endif
+    return SIMDLevel::Scalar;
 }
 
-const char* VoxelMathSIMD::getSIMDInstructionSet() {
-#ifdef __AVX2__
-    return "AVX2";
-#elif defined(__SSE4_1__)
-    return "SSE4.1";
-#elif defined(__ARM_NEON)
-    return "ARM NEON";
-#else
-    return "Scalar (no SIMD)";
-#endif
+SIMDLevel supportedLevel() {
+    static const SIMDLevel level = detectSIMDLevel();
+    return level;
 }
 
-size_t VoxelMathSIMD::getOptimalBatchSize() {
-#ifdef __AVX2__
-    return 32;  // Process 32 elements at a time with AVX2
-#elif defined(__SSE4_1__)
-    return 16;  // Process 16 elements at a time with SSE
-#elif defined(__ARM_NEON)
-    return 16;  // Process 16 elements at a time with NEON
-#else
-    return 8;   // Small batches for scalar fallback
-#endif
+std::atomic<SIMDLevel>& activeLevel() {
+    static std::atomic<SIMDLevel> level(supportedLevel());
+    return level;
 }
 
-void VoxelMathSIMD::worldToIncrementBatch(const WorldCoordinates* world,
-                                         IncrementCoordinates* increment,
-                                         size_t count) {
-    if (count == 0) return;
-    
-#ifdef __AVX2__
-    if (isAligned(world, SIMD_ALIGNMENT) && isAligned(increment, SIMD_ALIGNMENT)) {
-        worldToIncrementAVX(reinterpret_cast<const float*>(world),
-                           reinterpret_cast<int*>(increment), count);
-        return;
-    }
-#endif
-    
-#ifdef __SSE4_1__
-    if (isAligned(world, SIMD_ALIGNMENT) && isAligned(increment, SIMD_ALIGNMENT)) {
-        worldToIncrementSSE(reinterpret_cast<const float*>(world),
-                           reinterpret_cast<int*>(increment), count);
-        return;
+// Scalar kernels handle counts that don't fill a register and are the
+// reference the vector kernels match exactly: same comparisons, same
+// operation order, no fused multiply-adds (see CMakeLists.txt)
+
+template <BoxTest Test>
+void boxTestScalar(const BoundsSoA& b, const Vector3f& lo, const Vector3f& hi,
+                   bool* results, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        bool pass;
+        if (Test == BoxTest::Overlap) {
+            pass = b.maxX[i] > lo.x && b.minX[i] < hi.x &&
+                   b.maxY[i] > lo.y && b.minY[i] < hi.y &&
+                   b.maxZ[i] > lo.z && b.minZ[i] < hi.z;
+        } else if (Test == BoxTest::Intersect) {
+            pass = b.maxX[i] >= lo.x && b.minX[i] <= hi.x &&
+                   b.maxY[i] >= lo.y && b.minY[i] <= hi.y &&
+                   b.maxZ[i] >= lo.z && b.minZ[i] <= hi.z;
+        } else {
+            pass = b.minX[i] >= lo.x && b.minX[i] <= hi.x && b.maxX[i] >= lo.x && b.maxX[i] <= hi.x &&
+                   b.minY[i] >= lo.y && b.minY[i] <= hi.y && b.maxY[i] >= lo.y && b.maxY[i] <= hi.y &&
+                   b.minZ[i] >= lo.z && b.minZ[i] <= hi.z && b.maxZ[i] >= lo.z && b.maxZ[i] <= hi.z;
+        }
+        results[i] = pass;
     }
-#endif
-    
-#ifdef __ARM_NEON
-    worldToIncrementNEON(reinterpret_cast<const float*>(world),
-                        reinterpret_cast<int*>(increment), count);
-    return;
-#endif
-    
-    // Fallback to scalar implementation
-    worldToIncrementScalar(world, increment, count);
 }
 
-void VoxelMathSIMD::incrementToWorldBatch(const IncrementCoordinates* increment,
-                                         WorldCoordinates* world,
-                                         size_t count) {
-    if (count == 0) return;
-    
-#ifdef __AVX2__
-    if (isAligned(increment, SIMD_ALIGNMENT) && isAligned(world, SIMD_ALIGNMENT)) {
-        incrementToWorldAVX(reinterpret_cast<const int*>(increment),
-                           reinterpret_cast<float*>(world), count);
-        return;
+void sphereTestScalar(const BoundsSoA& b, const Vector3f& center, float radiusSq,
+                      bool* results, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        float dx = std::min(std::max(center.x, b.minX[i]), b.maxX[i]) - center.x;
+        float dy = std::min(std::max(center.y, b.minY[i]), b.maxY[i]) - center.y;
+        float dz = std::min(std::max(center.z, b.minZ[i]), b.maxZ[i]) - center.z;
+        results[i] = dx * dx + dy * dy + dz * dz <= radiusSq;
     }
-#endif
-    
-#ifdef __SSE4_1__
-    if (isAligned(increment, SIMD_ALIGNMENT) && isAligned(world, SIMD_ALIGNMENT)) {
-        incrementToWorldSSE(reinterpret_cast<const int*>(increment),
-                           reinterpret_cast<float*>(world), count);
-        return;
-    }
-#endif
-    
-#ifdef __ARM_NEON
-    incrementToWorldNEON(reinterpret_cast<const int*>(increment),
-                        reinterpret_cast<float*>(world), count);
-    return;
-#endif
-    
-    // Fallback to scalar implementation
-    incrementToWorldScalar(increment, world, count);
 }
 
-void VoxelMathSIMD::calculateBoundsBatch(const IncrementCoordinates* positions,
-                                        float voxelSizeMeters,
-                                        VoxelBounds* bounds,
-                                        size_t count) {
-    // This operation is complex and benefits less from SIMD
-    // Use scalar implementation for now
-    for (size_t i = 0; i < count; ++i) {
-        bounds[i] = VoxelBounds(positions[i], voxelSizeMeters);
+void distancesScalar(const PointsSoA& p, const Vector3f& target,
+                     float* distances, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        float dx = p.x[i] - target.x;
+        float dy = p.y[i] - target.y;
+        float dz = p.z[i] - target.z;
+        distances[i] = std::sqrt(dx * dx + dy * dy + dz * dz);
     }
 }
 
-void VoxelMathSIMD::checkCollisionsBatch(const IncrementCoordinates* positions,
-                                        const VoxelData::VoxelResolution* resolutions,
-                                        const VoxelData::VoxelGrid& grid,
-                                        bool* results,
-                                        size_t count) {
-    // Collision checking involves complex logic that doesn't vectorize well
-    // Use scalar implementation
-    for (size_t i = 0; i < count; ++i) {
-        results[i] = VoxelCollision::checkCollisionWithGrid(positions[i], resolutions[i], grid);
+void translateScalar(const IncrementCoordinates* positions, IncrementCoordinates* results,
+                     const Vector3i& offset, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        const Vector3i& p = positions[i].value();
+        results[i] = IncrementCoordinates(p.x + offset.x, p.y + offset.y, p.z + offset.z);
     }
 }
 
-void VoxelMathSIMD::calculateDistancesBatch(const WorldCoordinates* positions1,
-                                           const WorldCoordinates* positions2,
-                                           float* distances,
-                                           size_t count) {
-    if (count == 0) return;
-    
-#ifdef __AVX2__
-    calculateDistancesAVX(reinterpret_cast<const float*>(positions1),
-                         reinterpret_cast<const float*>(positions2),
-                         distances, count);
-    return;
-#endif
-    
-#ifdef __SSE4_1__
-    calculateDistancesSSE(reinterpret_cast<const float*>(positions1),
-                         reinterpret_cast<const float*>(positions2),
-                         distances, count);
-    return;
-#endif
-    
-#ifdef __ARM_NEON
-    calculateDistancesNEON(reinterpret_cast<const float*>(positions1),
-                          reinterpret_cast<const float*>(positions2),
-                          distances, count);
-    return;
-#endif
-    
-    // Fallback to scalar implementation
-    calculateDistancesScalar(positions1, positions2, distances, count);
+#ifdef VOXEL_MATH_X86_DISPATCH
+
+// Each vector kernel processes whole registers and returns how many
+// elements it covered; the caller finishes the tail with the scalar kernel
+
+static_assert(sizeof(bool) == 1, "results are stored as bytes");
+
+// Narrow an all-ones/all-zeros lane mask to eight 0/1 bytes
+__attribute__((target("avx2")))
+inline void storeMaskAVX2(__m256 mask, bool* results) {
+    __m256i ones = _mm256_srli_epi32(_mm256_castps_si256(mask), 31);
+    __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(ones), _mm256_extracti128_si256(ones, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(results), _mm_packs_epi16(words, words));
 }
 
-void VoxelMathSIMD::testBoundsIntersectionsBatch(const VoxelBounds* bounds1,
-                                                const VoxelBounds* bounds2,
-                                                bool* results,
-                                                size_t count) {
-    // Bounds intersection involves complex logic, use scalar for now
-    for (size_t i = 0; i < count; ++i) {
-        results[i] = bounds1[i].intersects(bounds2[i]);
+// Lane mask of one axis of a box test
+template <BoxTest Test>
+__attribute__((target("avx2")))
+inline __m256 boxAxisAVX2(__m256 mn, __m256 mx, __m256 lo, __m256 hi) {
+    if (Test == BoxTest::Overlap) {
+        return _mm256_and_ps(_mm256_cmp_ps(mx, lo, _CMP_GT_OQ), _mm256_cmp_ps(mn, hi, _CMP_LT_OQ));
+    } else if (Test == BoxTest::Intersect) {
+        return _mm256_and_ps(_mm256_cmp_ps(mx, lo, _CMP_GE_OQ), _mm256_cmp_ps(mn, hi, _CMP_LE_OQ));
     }
+    __m256 minInside = _mm256_and_ps(_mm256_cmp_ps(mn, lo, _CMP_GE_OQ), _mm256_cmp_ps(mn, hi, _CMP_LE_OQ));
+    __m256 maxInside = _mm256_and_ps(_mm256_cmp_ps(mx, lo, _CMP_GE_OQ), _mm256_cmp_ps(mx, hi, _CMP_LE_OQ));
+    return _mm256_and_ps(minInside, maxInside);
 }
 
-void VoxelMathSIMD::testPointInBoundsBatch(const WorldCoordinates* points,
-                                          const VoxelBounds* bounds,
-                                          bool* results,
-                                          size_t count) {
-    // Point-in-bounds testing involves complex logic, use scalar for now
-    for (size_t i = 0; i < count; ++i) {
-        results[i] = bounds[i].contains(points[i]);
+template <BoxTest Test>
+__attribute__((target("avx2")))
+size_t boxTestAVX2(const BoundsSoA& b, const Vector3f& lo, const Vector3f& hi,
+                   bool* results, size_t count) {
+    const __m256 loX = _mm256_set1_ps(lo.x), loY = _mm256_set1_ps(lo.y), loZ = _mm256_set1_ps(lo.z);
+    const __m256 hiX = _mm256_set1_ps(hi.x), hiY = _mm256_set1_ps(hi.y), hiZ = _mm256_set1_ps(hi.z);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 mask = boxAxisAVX2<Test>(_mm256_loadu_ps(b.minX + i), _mm256_loadu_ps(b.maxX + i), loX, hiX);
+        mask = _mm256_and_ps(mask, boxAxisAVX2<Test>(_mm256_loadu_ps(b.minY + i), _mm256_loadu_ps(b.maxY + i), loY, hiY));
+        mask = _mm256_and_ps(mask, boxAxisAVX2<Test>(_mm256_loadu_ps(b.minZ + i), _mm256_loadu_ps(b.maxZ + i), loZ, hiZ));
+        storeMaskAVX2(mask, results + i);
     }
+    return i;
 }
 
-void VoxelMathSIMD::normalizeVectorsBatch(Vector3f* vectors, size_t count) {
-    if (count == 0) return;
-    
-#ifdef __AVX2__
-    normalizeVectorsAVX(reinterpret_cast<float*>(vectors), count);
-    return;
-#endif
-    
-#ifdef __SSE4_1__
-    normalizeVectorsSSE(reinterpret_cast<float*>(vectors), count);
-    return;
-#endif
-    
-#ifdef __ARM_NEON
-    normalizeVectorsNEON(reinterpret_cast<float*>(vectors), count);
-    return;
-#endif
-    
-    // Fallback to scalar implementation
-    normalizeVectorsScalar(vectors, count);
+__attribute__((target("avx2")))
+size_t sphereTestAVX2(const BoundsSoA& b, const Vector3f& center, float radiusSq,
+                      bool* results, size_t count) {
+    const __m256 cX = _mm256_set1_ps(center.x), cY = _mm256_set1_ps(center.y), cZ = _mm256_set1_ps(center.z);
+    const __m256 limit = _mm256_set1_ps(radiusSq);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cX, _mm256_loadu_ps(b.minX + i)),
+                                                _mm256_loadu_ps(b.maxX + i)), cX);
+        __m256 dy = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cY, _mm256_loadu_ps(b.minY + i)),
+                                                _mm256_loadu_ps(b.maxY + i)), cY);
+        __m256 dz = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cZ, _mm256_loadu_ps(b.minZ + i)),
+                                                _mm256_loadu_ps(b.maxZ + i)), cZ);
+        __m256 distSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                      _mm256_mul_ps(dz, dz));
+        storeMaskAVX2(_mm256_cmp_ps(distSq, limit, _CMP_LE_OQ), results + i);
+    }
+    return i;
 }
 
-void VoxelMathSIMD::calculateDotProductsBatch(const Vector3f* vectors1,
-                                             const Vector3f* vectors2,
-                                             float* results,
-                                             size_t count) {
-    if (count == 0) return;
-    
-#ifdef __AVX2__
-    calculateDotProductsAVX(reinterpret_cast<const float*>(vectors1),
-                           reinterpret_cast<const float*>(vectors2),
-                           results, count);
-    return;
-#endif
-    
-#ifdef __SSE4_1__
-    calculateDotProductsSSE(reinterpret_cast<const float*>(vectors1),
-                           reinterpret_cast<const float*>(vectors2),
-                           results, count);
-    return;
-#endif
-    
-#ifdef __ARM_NEON
-    calculateDotProductsNEON(reinterpret_cast<const float*>(vectors1),
-                            reinterpret_cast<const float*>(vectors2),
-                            results, count);
-    return;
-#endif
-    
-    // Fallback to scalar implementation
-    calculateDotProductsScalar(vectors1, vectors2, results, count);
+__attribute__((target("avx2")))
+size_t distancesAVX2(const PointsSoA& p, const Vector3f& target, float* distances, size_t count) {
+    const __m256 tX = _mm256_set1_ps(target.x), tY = _mm256_set1_ps(target.y), tZ = _mm256_set1_ps(target.z);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(p.x + i), tX);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(p.y + i), tY);
+        __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(p.z + i), tZ);
+        __m256 lengthSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                        _mm256_mul_ps(dz, dz));
+        _mm256_storeu_ps(distances + i, _mm256_sqrt_ps(lengthSq));
+    }
+    return i;
 }
 
-// Scalar implementations
-void VoxelMathSIMD::worldToIncrementScalar(const WorldCoordinates* world,
-                                          IncrementCoordinates* increment,
-                                          size_t count) {
-    for (size_t i = 0; i < count; ++i) {
-        increment[i] = CoordinateConverter::worldToIncrement(world[i]);
+// Positions are packed x, y, z ints, so a block of 8 positions is three
+// registers and the offset repeats with a period of three lanes
+__attribute__((target("avx2")))
+size_t translateAVX2(const IncrementCoordinates* positions, IncrementCoordinates* results,
+                     const Vector3i& offset, size_t count) {
+    const int tiled[9] = {offset.x, offset.y, offset.z, offset.x, offset.y, offset.z, offset.x, offset.y, offset.z};
+    const __m256i add0 = _mm256_setr_epi32(tiled[0], tiled[1], tiled[2], tiled[3], tiled[4], tiled[5], tiled[6], tiled[7]);
+    const __m256i add1 = _mm256_setr_epi32(tiled[2], tiled[3], tiled[4], tiled[5], tiled[6], tiled[7], tiled[8], tiled[0]);
+    const __m256i add2 = _mm256_setr_epi32(tiled[1], tiled[2], tiled[3], tiled[4], tiled[5], tiled[6], tiled[7], tiled[8]);
+    const int* src = reinterpret_cast<const int*>(positions);
+    int* dst = reinterpret_cast<int*>(results);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i* in = reinterpret_cast<const __m256i*>(src + 3 * i);
+        __m256i* out = reinterpret_cast<__m256i*>(dst + 3 * i);
+        __m256i a = _mm256_add_epi32(_mm256_loadu_si256(in), add0);
+        __m256i b = _mm256_add_epi32(_mm256_loadu_si256(in + 1), add1);
+        __m256i c = _mm256_add_epi32(_mm256_loadu_si256(in + 2), add2);
+        _mm256_storeu_si256(out, a);
+        _mm256_storeu_si256(out + 1, b);
+        _mm256_storeu_si256(out + 2, c);
     }
+    return i;
 }
 
-void VoxelMathSIMD::incrementToWorldScalar(const IncrementCoordinates* increment,
-                                          WorldCoordinates* world,
-                                          size_t count) {
-    for (size_t i = 0; i < count; ++i) {
-        world[i] = CoordinateConverter::incrementToWorld(increment[i]);
+template <BoxTest Test>
+__attribute__((target("avx512f")))
+inline __mmask16 boxAxisAVX512(__m512 mn, __m512 mx, __m512 lo, __m512 hi) {
+    if (Test == BoxTest::Overlap) {
+        return _mm512_cmp_ps_mask(mx, lo, _CMP_GT_OQ) & _mm512_cmp_ps_mask(mn, hi, _CMP_LT_OQ);
+    } else if (Test == BoxTest::Intersect) {
+        return _mm512_cmp_ps_mask(mx, lo, _CMP_GE_OQ) & _mm512_cmp_ps_mask(mn, hi, _CMP_LE_OQ);
     }
+    return _mm512_cmp_ps_mask(mn, lo, _CMP_GE_OQ) & _mm512_cmp_ps_mask(mn, hi, _CMP_LE_OQ) &
+           _mm512_cmp_ps_mask(mx, lo, _CMP_GE_OQ) & _mm512_cmp_ps_mask(mx, hi, _CMP_LE_OQ);
 }
 
-void VoxelMathSIMD::calculateDistancesScalar(const WorldCoordinates* positions1,
-                                            const WorldCoordinates* positions2,
-                                            float* distances,
-                                            size_t count) {
-    for (size_t i = 0; i < count; ++i) {
-        const Vector3f& p1 = positions1[i].value();
-        const Vector3f& p2 = positions2[i].value();
-        Vector3f diff = p1 - p2;
-        distances[i] = diff.length();
+template <BoxTest Test>
+__attribute__((target("avx512f")))
+size_t boxTestAVX512(const BoundsSoA& b, const Vector3f& lo, const Vector3f& hi,
+                     bool* results, size_t count) {
+    const __m512 loX = _mm512_set1_ps(lo.x), loY = _mm512_set1_ps(lo.y), loZ = _mm512_set1_ps(lo.z);
+    const __m512 hiX = _mm512_set1_ps(hi.x), hiY = _mm512_set1_ps(hi.y), hiZ = _mm512_set1_ps(hi.z);
+
+    // Each mask bit widens to a 0/1 lane and narrows to one byte per bool
+    const __m512i one = _mm512_set1_epi32(1);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __mmask16 mask = boxAxisAVX512<Test>(_mm512_loadu_ps(b.minX + i), _mm512_loadu_ps(b.maxX + i), loX, hiX) &
+                         boxAxisAVX512<Test>(_mm512_loadu_ps(b.minY + i), _mm512_loadu_ps(b.maxY + i), loY, hiY) &
+                         boxAxisAVX512<Test>(_mm512_loadu_ps(b.minZ + i), _mm512_loadu_ps(b.maxZ + i), loZ, hiZ);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(results + i),
+                         _mm512_cvtepi32_epi8(_mm512_maskz_mov_epi32(mask, one)));
     }
+    return i;
 }
 
-void VoxelMathSIMD::normalizeVectorsScalar(Vector3f* vectors, size_t count) {
-    for (size_t i = 0; i < count; ++i) {
-        vectors[i].normalize();
+__attribute__((target("avx512f")))
+size_t sphereTestAVX512(const BoundsSoA& b, const Vector3f& center, float radiusSq,
+                        bool* results, size_t count) {
+    const __m512 cX = _mm512_set1_ps(center.x), cY = _mm512_set1_ps(center.y), cZ = _mm512_set1_ps(center.z);
+    const __m512 limit = _mm512_set1_ps(radiusSq);
+    const __m512i one = _mm512_set1_epi32(1);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512 dx = _mm512_sub_ps(_mm512_min_ps(_mm512_max_ps(cX, _mm512_loadu_ps(b.minX + i)),
+                                                _mm512_loadu_ps(b.maxX + i)), cX);
+        __m512 dy = _mm512_sub_ps(_mm512_min_ps(_mm512_max_ps(cY, _mm512_loadu_ps(b.minY + i)),
+                                                _mm512_loadu_ps(b.maxY + i)), cY);
+        __m512 dz = _mm512_sub_ps(_mm512_min_ps(_mm512_max_ps(cZ, _mm512_loadu_ps(b.minZ + i)),
+                                                _mm512_loadu_ps(b.maxZ + i)), cZ);
+        __m512 distSq = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)),
+                                      _mm512_mul_ps(dz, dz));
+        __mmask16 mask = _mm512_cmp_ps_mask(distSq, limit, _CMP_LE_OQ);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(results + i),
+                         _mm512_cvtepi32_epi8(_mm512_maskz_mov_epi32(mask, one)));
     }
+    return i;
 }
 
-void VoxelMathSIMD::calculateDotProductsScalar(const Vector3f* vectors1,
-                                              const Vector3f* vectors2,
-                                              float* results,
-                                              size_t count) {
-    for (size_t i = 0; i < count; ++i) {
-        results[i] = vectors1[i].dot(vectors2[i]);
+__attribute__((target("avx512f")))
+size_t distancesAVX512(const PointsSoA& p, const Vector3f& target, float* distances, size_t count) {
+    const __m512 tX = _mm512_set1_ps(target.x), tY = _mm512_set1_ps(target.y), tZ = _mm512_set1_ps(target.z);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512 dx = _mm512_sub_ps(_mm512_loadu_ps(p.x + i), tX);
+        __m512 dy = _mm512_sub_ps(_mm512_loadu_ps(p.y + i), tY);
+        __m512 dz = _mm512_sub_ps(_mm512_loadu_ps(p.z + i), tZ);
+        __m512 lengthSq = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)),
+                                        _mm512_mul_ps(dz, dz));
+        _mm512_storeu_ps(distances + i, _mm512_sqrt_ps(lengthSq));
     }
+    return i;
 }
 
-// SIMD implementations
-#ifdef __SSE4_1__
-void VoxelMathSIMD::worldToIncrementSSE(const float* world, int* increment, size_t count) {
-    const __m128 scale = _mm_set1_ps(METERS_TO_CM);
-    
-    size_t simdCount = (count * 3) / 4 * 4;  // Process in groups of 4 floats
-    
-    for (size_t i = 0; i < simdCount; i += 4) {
-        __m128 worldVec = _mm_load_ps(&world[i]);
-        __m128 scaled = _mm_mul_ps(worldVec, scale);
-        __m128i rounded = _mm_cvtps_epi32(scaled);
-        _mm_store_si128(reinterpret_cast<__m128i*>(&increment[i]), rounded);
+__attribute__((target("avx512f")))
+size_t translateAVX512(const IncrementCoordinates* positions, IncrementCoordinates* results,
+                       const Vector3i& offset, size_t count) {
+    // 16 positions fill three registers; register r starts at component 16 * r mod 3
+    const __m512i add0 = _mm512_setr_epi32(offset.x, offset.y, offset.z, offset.x, offset.y, offset.z,
+                                           offset.x, offset.y, offset.z, offset.x, offset.y, offset.z,
+                                           offset.x, offset.y, offset.z, offset.x);
+    const __m512i add1 = _mm512_setr_epi32(offset.y, offset.z, offset.x, offset.y, offset.z, offset.x,
+                                           offset.y, offset.z, offset.x, offset.y, offset.z, offset.x,
+                                           offset.y, offset.z, offset.x, offset.y);
+    const __m512i add2 = _mm512_setr_epi32(offset.z, offset.x, offset.y, offset.z, offset.x, offset.y,
+                                           offset.z, offset.x, offset.y, offset.z, offset.x, offset.y,
+                                           offset.z, offset.x, offset.y, offset.z);
+    const int* src = reinterpret_cast<const int*>(positions);
+    int* dst = reinterpret_cast<int*>(results);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const int* in = src + 3 * i;
+        int* out = dst + 3 * i;
+        __m512i a = _mm512_add_epi32(_mm512_loadu_si512(in), add0);
+        __m512i b = _mm512_add_epi32(_mm512_loadu_si512(in + 16), add1);
+        __m512i c = _mm512_add_epi32(_mm512_loadu_si512(in + 32), add2);
+        _mm512_storeu_si512(out, a);
+        _mm512_storeu_si512(out + 16, b);
+        _mm512_storeu_si512(out + 32, c);
     }
-    
-    // Handle remaining elements
-    for (size_t i = simdCount; i < count * 3; ++i) {
-        increment[i] = static_cast<int>(std::round(world[i] * METERS_TO_CM));
+    return i;
+}
+
+#endif // VOXEL_MATH_X86_DISPATCH
+
+template <BoxTest Test>
+void boxTestDispatch(const BoundsSoA& b, const Vector3f& lo, const Vector3f& hi,
+                     bool* results, size_t count) {
+    size_t done = 0;
+#ifdef VOXEL_MATH_X86_DISPATCH
+    switch (VoxelMathSIMD::getSIMDLevel()) {
+        case SIMDLevel::AVX512: done = boxTestAVX512<Test>(b, lo, hi, results, count); break;
+        case SIMDLevel::AVX2: done = boxTestAVX2<Test>(b, lo, hi, results, count); break;
+        case SIMDLevel::Scalar: break;
     }
+#endif
+    boxTestScalar<Test>(b, lo, hi, results, done, count);
 }
 
-void VoxelMathSIMD::incrementToWorldSSE(const int* increment, float* world, size_t count) {
-    const __m128 scale = _mm_set1_ps(CM_TO_METERS);
-    
-    size_t simdCount = (count * 3) / 4 * 4;
-    
-    for (size_t i = 0; i < simdCount; i += 4) {
-        __m128i incrementVec = _mm_load_si128(reinterpret_cast<const __m128i*>(&increment[i]));
-        __m128 converted = _mm_cvtepi32_ps(incrementVec);
-        __m128 scaled = _mm_mul_ps(converted, scale);
-        _mm_store_ps(&world[i], scaled);
+} // namespace
+
+void VoxelMathSIMD::BoundsBuffer::reserve(size_t count) {
+    for (auto* column : {&m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ}) {
+        column->reserve(count);
     }
-    
-    // Handle remaining elements
-    for (size_t i = simdCount; i < count * 3; ++i) {
-        world[i] = increment[i] * CM_TO_METERS;
+}
+
+void VoxelMathSIMD::BoundsBuffer::clear() {
+    for (auto* column : {&m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ}) {
+        column->clear();
     }
 }
 
-void VoxelMathSIMD::calculateDistancesSSE(const float* pos1, const float* pos2, 
-                                         float* distances, size_t count) {
-    for (size_t i = 0; i < count; ++i) {
-        size_t idx = i * 3;
-        __m128 p1 = _mm_set_ps(0.0f, pos1[idx + 2], pos1[idx + 1], pos1[idx]);
-        __m128 p2 = _mm_set_ps(0.0f, pos2[idx + 2], pos2[idx + 1], pos2[idx]);
-        __m128 diff = _mm_sub_ps(p1, p2);
-        __m128 squared = _mm_mul_ps(diff, diff);
-        
-        // Sum the components
-        __m128 sum = _mm_hadd_ps(squared, squared);
-        sum = _mm_hadd_ps(sum, sum);
-        
-        float result;
-        _mm_store_ss(&result, _mm_sqrt_ss(sum));
-        distances[i] = result;
+void VoxelMathSIMD::BoundsBuffer::push(const Vector3f& min, const Vector3f& max) {
+    m_minX.push_back(min.x);
+    m_minY.push_back(min.y);
+    m_minZ.push_back(min.z);
+    m_maxX.push_back(max.x);
+    m_maxY.push_back(max.y);
+    m_maxZ.push_back(max.z);
+}
+
+VoxelMathSIMD::BoundsSoA VoxelMathSIMD::BoundsBuffer::view() const {
+    return BoundsSoA{m_minX.data(), m_minY.data(), m_minZ.data(),
+                     m_maxX.data(), m_maxY.data(), m_maxZ.data()};
+}
+
+void VoxelMathSIMD::testBoundsAgainstBoxSoA(const BoundsSoA& bounds,
+                                            const Vector3f& boxMin,
+                                            const Vector3f& boxMax,
+                                            BoxTest test,
+                                            bool* results,
+                                            size_t count) {
+    switch (test) {
+        case BoxTest::Overlap: boxTestDispatch<BoxTest::Overlap>(bounds, boxMin, boxMax, results, count); break;
+        case BoxTest::Intersect: boxTestDispatch<BoxTest::Intersect>(bounds, boxMin, boxMax, results, count); break;
+        case BoxTest::Contained: boxTestDispatch<BoxTest::Contained>(bounds, boxMin, boxMax, results, count); break;
+    }
+}
+
+void VoxelMathSIMD::testBoundsAgainstSphereSoA(const BoundsSoA& bounds,
+                                               const Vector3f& center,
+                                               float radius,
+                                               bool* results,
+                                               size_t count) {
+    float radiusSq = radius * radius;
+    size_t done = 0;
+#ifdef VOXEL_MATH_X86_DISPATCH
+    switch (getSIMDLevel()) {
+        case SIMDLevel::AVX512: done = sphereTestAVX512(bounds, center, radiusSq, results, count); break;
+        case SIMDLevel::AVX2: done = sphereTestAVX2(bounds, center, radiusSq, results, count); break;
+        case SIMDLevel::Scalar: break;
     }
+#endif
+    sphereTestScalar(bounds, center, radiusSq, results, done, count);
 }
 
-void VoxelMathSIMD::normalizeVectorsSSE(float* vectors, size_t count) {
-    for (size_t i = 0; i < count; ++i) {
-        size_t idx = i * 3;
-        __m128 vec = _mm_set_ps(0.0f, vectors[idx + 2], vectors[idx + 1], vectors[idx]);
-        __m128 squared = _mm_mul_ps(vec, vec);
-        
-        // Sum the components
-        __m128 sum = _mm_hadd_ps(squared, squared);
-        sum = _mm_hadd_ps(sum, sum);
-        
-        __m128 length = _mm_sqrt_ss(sum);
-        __m128 lengthBcast = _mm_shuffle_ps(length, length, 0);
-        __m128 normalized = _mm_div_ps(vec, lengthBcast);
-        
-        vectors[idx] = _mm_cvtss_f32(normalized);
-        vectors[idx + 1] = _mm_cvtss_f32(_mm_shuffle_ps(normalized, normalized, 1));
-        vectors[idx + 2] = _mm_cvtss_f32(_mm_shuffle_ps(normalized, normalized, 2));
+void VoxelMathSIMD::calculateDistancesSoA(const PointsSoA& points,
+                                          const Vector3f& target,
+                                          float* distances,
+                                          size_t count) {
+    size_t done = 0;
+#ifdef VOXEL_MATH_X86_DISPATCH
+    switch (getSIMDLevel()) {
+        case SIMDLevel::AVX512: done = distancesAVX512(points, target, distances, count); break;
+        case SIMDLevel::AVX2: done = distancesAVX2(points, target, distances, count); break;
+        case SIMDLevel::Scalar: break;
     }
+#endif
+    distancesScalar(points, target, distances, done, count);
 }
 
-void VoxelMathSIMD::calculateDotProductsSSE(const float* vectors1, const float* vectors2,
-                                           float* results, size_t count) {
-    for (size_t i = 0; i < count; ++i) {
-        size_t idx = i * 3;
-        __m128 v1 = _mm_set_ps(0.0f, vectors1[idx + 2], vectors1[idx + 1], vectors1[idx]);
-        __m128 v2 = _mm_set_ps(0.0f, vectors2[idx + 2], vectors2[idx + 1], vectors2[idx]);
-        __m128 product = _mm_mul_ps(v1, v2);
-        
-        // Sum the components
-        __m128 sum = _mm_hadd_ps(product, product);
-        sum = _mm_hadd_ps(sum, sum);
-        
-        _mm_store_ss(&results[i], sum);
+void VoxelMathSIMD::translateIncrementBatch(const IncrementCoordinates* positions,
+                                            IncrementCoordinates* results,
+                                            size_t count,
+                                            const Vector3i& offset) {
+    static_assert(sizeof(IncrementCoordinates) == 3 * sizeof(int),
+                  "IncrementCoordinates must be three packed ints");
+    size_t done = 0;
+#ifdef VOXEL_MATH_X86_DISPATCH
+    switch (getSIMDLevel()) {
+        case SIMDLevel::AVX512: done = translateAVX512(positions, results, offset, count); break;
+        case SIMDLevel::AVX2: done = translateAVX2(positions, results, offset, count); break;
+        case SIMDLevel::Scalar: break;
     }
+#endif
+    translateScalar(positions, results, offset, done, count);
 }
-#endif // __SSE4_1__
 
-// Note: AVX2 and ARM NEON implementations would follow similar patterns
-// but are omitted here for brevity. In a production implementation,
-// you would implement these for maximum performance.
+VoxelMathSIMD::SIMDLevel VoxelMathSIMD::getSupportedSIMDLevel() {
+    return supportedLevel();
+}
+
+VoxelMathSIMD::SIMDLevel VoxelMathSIMD::getSIMDLevel() {
+    return activeLevel().load(std::memory_order_relaxed);
+}
 
-bool VoxelMathSIMD::isAligned(const void* ptr, size_t alignment) {
-    return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+void VoxelMathSIMD::setSIMDLevel(SIMDLevel level) {
+    activeLevel().store(std::min(level, supportedLevel()), std::memory_order_relaxed);
 }
 
-size_t VoxelMathSIMD::alignedSize(size_t size, size_t alignment) {
-    return (size + alignment - 1) & ~(alignment - 1);
+const char* VoxelMathSIMD::getSIMDLevelName(SIMDLevel level) {
+    switch (level) {
+        case SIMDLevel::AVX512: return "AVX-512";
+        case SIMDLevel::AVX2: return "AVX2";
+        case SIMDLevel::Scalar: return "Scalar";
+    }
+    return "Unknown";
 }
 
 } // namespace Math
-} // namespace VoxelEditor
\ No newline at end of file
+} // namespace VoxelEditor
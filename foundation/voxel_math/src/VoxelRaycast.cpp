@@ -5,7 +5,9 @@
 #include "../../math/CoordinateConverter.h"
 #include <algorithm>
 #include <cmath>
+#include <future>
 #include <limits>
+#include <thread>
 
 namespace VoxelEditor {
 namespace Math {
@@ -81,6 +83,104 @@ VoxelRaycast::RaycastResult VoxelRaycast::raycastGrid(const Ray& ray,
     return closestResult;
 }
 
+void VoxelRaycast::raycastGridBatch(const Ray* rays,
+                                    RaycastResult* results,
+                                    size_t count,
+                                    const VoxelData::VoxelGrid& grid,
+                                    VoxelData::VoxelResolution resolution,
+                                    float maxDistance,
+                                    unsigned int threadCount) {
+    if (count == 0) return;
+
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) threadCount = 1;
+    }
+    threadCount = static_cast<unsigned int>(
+        std::min<size_t>(threadCount, std::max<size_t>(1, count / MIN_RAYS_PER_THREAD)));
+
+    if (threadCount == 1) {
+        raycastGridPackets(rays, results, count, grid, resolution, maxDistance);
+        return;
+    }
+
+    // Split on whole packets so no packet straddles two threads
+    constexpr size_t PACKET_SIZE = VoxelData::SparseOctree::RAY_PACKET_SIZE;
+    size_t packets = (count + PACKET_SIZE - 1) / PACKET_SIZE;
+    size_t raysPerThread = (packets + threadCount - 1) / threadCount * PACKET_SIZE;
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(threadCount);
+    for (size_t start = 0; start < count; start += raysPerThread) {
+        size_t chunk = std::min(raysPerThread, count - start);
+        futures.push_back(std::async(std::launch::async, [&, start, chunk]() {
+            raycastGridPackets(rays + start, results + start, chunk, grid, resolution, maxDistance);
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+void VoxelRaycast::raycastGridPackets(const Ray* rays,
+                                      RaycastResult* results,
+                                      size_t count,
+                                      const VoxelData::VoxelGrid& grid,
+                                      VoxelData::VoxelResolution resolution,
+                                      float maxDistance) {
+    constexpr int PACKET_SIZE = VoxelData::SparseOctree::RAY_PACKET_SIZE;
+
+    // Like raycastGrid, only voxels of the requested resolution count
+    if (grid.getResolution() != resolution) {
+        std::fill(results, results + count, RaycastResult());
+        return;
+    }
+
+    // Voxel bounds here are centered on the position in X and Z, while the
+    // grid's boxes start at it; shifting the rays by half a voxel lines the
+    // two up without changing distances
+    float voxelSize = VoxelGridMath::getVoxelSizeMeters(resolution);
+    Vector3f toGridBoxes(voxelSize * 0.5f, 0.0f, voxelSize * 0.5f);
+
+    WorldCoordinates origins[PACKET_SIZE];
+    Vector3f directions[PACKET_SIZE];
+    IncrementCoordinates hitPos[PACKET_SIZE];
+    float hitDistance[PACKET_SIZE];
+    bool hit[PACKET_SIZE];
+
+    for (size_t start = 0; start < count; start += PACKET_SIZE) {
+        int packetSize = static_cast<int>(std::min<size_t>(PACKET_SIZE, count - start));
+        for (int i = 0; i < packetSize; ++i) {
+            origins[i] = WorldCoordinates(rays[start + i].origin + toGridBoxes);
+            directions[i] = rays[start + i].direction;
+        }
+
+        grid.raycastPacket(origins, directions, packetSize, maxDistance, hitPos, hitDistance, hit);
+
+        for (int i = 0; i < packetSize; ++i) {
+            RaycastResult& result = results[start + i];
+            result = RaycastResult();
+            if (!hit[i]) {
+                continue;
+            }
+            // The traversal pads boxes slightly, so take distance and face
+            // from the exact box test unless the ray only grazes it
+            const Ray& ray = rays[start + i];
+            result = raycastVoxel(ray, hitPos[i], resolution);
+            if (result.hit) {
+                continue;
+            }
+            VoxelBounds voxelBounds(hitPos[i], voxelSize);
+            result.hit = true;
+            result.distance = hitDistance[i];
+            result.voxelPos = hitPos[i];
+            result.hitFace = calculateHitFace(ray, voxelBounds, hitDistance[i]);
+            result.hitPoint = WorldCoordinates(ray.getPoint(hitDistance[i]));
+            result.hitNormal = FaceOperations::getFaceNormal(result.hitFace);
+        }
+    }
+}
+
 std::vector<IncrementCoordinates> VoxelRaycast::getVoxelsAlongRay(const Ray& ray,
                                                                   VoxelData::VoxelResolution resolution,
                                                                   float maxDistance) {
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "../include/voxel_math/VoxelRaycast.h"
+#include "../../../core/voxel_data/VoxelGrid.h"
+#include "../../math/Ray.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace VoxelEditor;
+using namespace VoxelEditor::Math;
+
+class BatchRaycastPerformanceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        workspaceSize = Vector3f(5.0f, 5.0f, 5.0f);
+        resolution = VoxelData::VoxelResolution::Size_4cm;
+        grid = std::make_unique<VoxelData::VoxelGrid>(resolution, workspaceSize);
+    }
+
+    // Camera rays through a width x height image plane looking down -Z
+    std::vector<Ray> cameraRays(const Vector3f& eye, int width, int height, float fov) {
+        std::vector<Ray> rays;
+        rays.reserve(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                float u = (2.0f * (x + 0.5f) / width - 1.0f) * fov;
+                float v = (2.0f * (y + 0.5f) / height - 1.0f) * fov;
+                rays.emplace_back(eye, Vector3f(u, v - 0.4f, -1.0f));
+            }
+        }
+        return rays;
+    }
+
+    Vector3f workspaceSize;
+    VoxelData::VoxelResolution resolution;
+    std::unique_ptr<VoxelData::VoxelGrid> grid;
+};
+
+TEST_F(BatchRaycastPerformanceTest, RaysPerSecond) {
+    // About 43k voxels: a terrain of 4cm columns
+    for (int x = -240; x < 240; x += 4) {
+        for (int z = -240; z < 240; z += 4) {
+            int top = 4 * ((x / 4 * 7 + z / 4 * 13 + 1000) % 5);
+            for (int y = 0; y <= top; y += 4) {
+                grid->setVoxel(IncrementCoordinates(x, y, z), true);
+            }
+        }
+    }
+
+    auto rays = cameraRays(Vector3f(0.0f, 1.5f, 3.0f), 320, 240, 0.6f);
+    std::vector<VoxelRaycast::RaycastResult> results(rays.size());
+
+    auto measure = [&](unsigned int threads) {
+        auto start = std::chrono::high_resolution_clock::now();
+        VoxelRaycast::raycastGridBatch(rays.data(), results.data(), rays.size(), *grid, resolution, 1000.0f, threads);
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        return rays.size() / seconds;
+    };
+
+    // Per-ray octree casts as the baseline for the packets
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& ray : rays) {
+        IncrementCoordinates hitPos;
+        float hitDistance;
+        Vector3f offset(0.02f, 0.0f, 0.02f);
+        grid->raycast(WorldCoordinates(ray.origin + offset), ray.direction, 1000.0f, hitPos, hitDistance);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double singleRate = rays.size() / std::chrono::duration<double>(end - start).count();
+
+    double packetRate = measure(1);
+    double threadedRate = measure(0);
+
+    std::cout << "Batch raycast over " << grid->getVoxelCount() << " voxels: "
+              << static_cast<long>(singleRate) << " rays/s single, "
+              << static_cast<long>(packetRate) << " rays/s packets, "
+              << static_cast<long>(threadedRate) << " rays/s threaded" << std::endl;
+
+    EXPECT_GT(packetRate, 100000.0);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "../include/voxel_math/VoxelRaycast.h"
+#include "../../../core/voxel_data/VoxelGrid.h"
+#include "../../math/Ray.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace VoxelEditor;
+using namespace VoxelEditor::Math;
+
+class BatchRaycastTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        workspaceSize = Vector3f(5.0f, 5.0f, 5.0f);
+        resolution = VoxelData::VoxelResolution::Size_4cm;
+        grid = std::make_unique<VoxelData::VoxelGrid>(resolution, workspaceSize);
+    }
+
+    // Camera rays through a width x height image plane looking down -Z
+    std::vector<Ray> cameraRays(const Vector3f& eye, int width, int height, float fov) {
+        std::vector<Ray> rays;
+        rays.reserve(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                float u = (2.0f * (x + 0.5f) / width - 1.0f) * fov;
+                float v = (2.0f * (y + 0.5f) / height - 1.0f) * fov;
+                rays.emplace_back(eye, Vector3f(u, v - 0.4f, -1.0f));
+            }
+        }
+        return rays;
+    }
+
+    Vector3f workspaceSize;
+    VoxelData::VoxelResolution resolution;
+    std::unique_ptr<VoxelData::VoxelGrid> grid;
+};
+
+TEST_F(BatchRaycastTest, MatchesRaycastGrid) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> coord(-60, 60);
+    std::uniform_int_distribution<int> height(0, 80);
+    for (int i = 0; i < 1500; ++i) {
+        grid->setVoxel(IncrementCoordinates(coord(rng), height(rng), coord(rng)), true);
+    }
+
+    std::uniform_real_distribution<float> position(-1.5f, 1.5f);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+    std::vector<Ray> rays;
+    for (int i = 0; i < 500; ++i) {
+        Vector3f target(position(rng) * 0.4f, position(rng) * 0.3f + 0.4f, position(rng) * 0.4f);
+        Vector3f origin(position(rng), position(rng) + 1.5f, position(rng));
+        // Every fourth ray is random and mostly misses
+        Vector3f dir = i % 4 == 0 ? Vector3f(direction(rng), direction(rng), direction(rng)) : target - origin;
+        rays.emplace_back(origin, dir);
+    }
+
+    std::vector<VoxelRaycast::RaycastResult> results(rays.size());
+    VoxelRaycast::raycastGridBatch(rays.data(), results.data(), rays.size(), *grid, resolution, 2.5f);
+
+    int hits = 0;
+    for (size_t i = 0; i < rays.size(); ++i) {
+        auto expected = VoxelRaycast::raycastGrid(rays[i], *grid, resolution, 2.5f);
+        ASSERT_EQ(results[i].hit, expected.hit) << "ray " << i;
+        if (!expected.hit) continue;
+        ++hits;
+        EXPECT_NEAR(results[i].distance, expected.distance, 1e-4f) << "ray " << i;
+        EXPECT_EQ(results[i].voxelPos, expected.voxelPos) << "ray " << i;
+        EXPECT_EQ(results[i].hitFace, expected.hitFace) << "ray " << i;
+    }
+    EXPECT_GT(hits, 100);
+
+    // A grid of another resolution holds nothing to hit
+    VoxelRaycast::raycastGridBatch(rays.data(), results.data(), rays.size(), *grid,
+                                   VoxelData::VoxelResolution::Size_8cm);
+    for (const auto& result : results) {
+        EXPECT_FALSE(result.hit);
+    }
+}
+
+TEST_F(BatchRaycastTest, ThreadedMatchesSingleThread) {
+    for (int x = -100; x < 100; x += 4) {
+        for (int z = -100; z < 100; z += 4) {
+            grid->setVoxel(IncrementCoordinates(x, (x * z) % 3 == 0 ? 4 : 0, z), true);
+        }
+    }
+
+    auto rays = cameraRays(Vector3f(0.1f, 1.0f, 2.0f), 97, 61, 0.5f);
+    std::vector<VoxelRaycast::RaycastResult> single(rays.size());
+    std::vector<VoxelRaycast::RaycastResult> threaded(rays.size());
+    VoxelRaycast::raycastGridBatch(rays.data(), single.data(), rays.size(), *grid, resolution, 1000.0f, 1);
+    VoxelRaycast::raycastGridBatch(rays.data(), threaded.data(), rays.size(), *grid, resolution, 1000.0f, 4);
+
+    for (size_t i = 0; i < rays.size(); ++i) {
+        ASSERT_EQ(threaded[i].hit, single[i].hit) << "ray " << i;
+        EXPECT_EQ(threaded[i].voxelPos, single[i].voxelPos);
+        EXPECT_EQ(threaded[i].distance, single[i].distance);
+    }
+}
+
+// Packets over a terrain hit exactly what per-ray octree casts hit
+TEST_F(BatchRaycastTest, TerrainHitsMatchOctreeCasts) {
+    // About 43k voxels: a terrain of 4cm columns
+    for (int x = -240; x < 240; x += 4) {
+        for (int z = -240; z < 240; z += 4) {
+            int top = 4 * ((x / 4 * 7 + z / 4 * 13 + 1000) % 5);
+            for (int y = 0; y <= top; y += 4) {
+                grid->setVoxel(IncrementCoordinates(x, y, z), true);
+            }
+        }
+    }
+
+    auto rays = cameraRays(Vector3f(0.0f, 1.5f, 3.0f), 64, 48, 0.6f);
+    std::vector<VoxelRaycast::RaycastResult> results(rays.size());
+    VoxelRaycast::raycastGridBatch(rays.data(), results.data(), rays.size(), *grid, resolution, 1000.0f, 1);
+
+    size_t singleHits = 0;
+    for (const auto& ray : rays) {
+        IncrementCoordinates hitPos;
+        float hitDistance;
+        Vector3f offset(0.02f, 0.0f, 0.02f);
+        singleHits += grid->raycast(WorldCoordinates(ray.origin + offset), ray.direction, 1000.0f, hitPos, hitDistance);
+    }
+
+    size_t hits = 0;
+    for (const auto& result : results) {
+        hits += result.hit;
+    }
+    EXPECT_EQ(hits, singleHits);
+    EXPECT_GT(hits, rays.size() / 2);
+}
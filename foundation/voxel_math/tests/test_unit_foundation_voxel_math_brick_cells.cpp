@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "voxel_math/BrickCells.h"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+
+using namespace VoxelEditor;
+using namespace VoxelEditor::Math;
+
+namespace {
+
+BrickCells makeCells(const std::set<uint16_t>& cells) {
+    BrickCells result;
+    for (uint16_t cell : cells) {
+        result.insert(cell);
+    }
+    return result;
+}
+
+std::set<uint16_t> toSet(const BrickCells& cells) {
+    std::set<uint16_t> result;
+    cells.forEach([&](uint16_t cell) { result.insert(cell); });
+    return result;
+}
+
+std::set<uint16_t> randomCells(std::mt19937& rng, uint32_t count) {
+    std::uniform_int_distribution<int> dist(0, BrickCells::BRICK_CELLS - 1);
+    std::set<uint16_t> cells;
+    while (cells.size() < count) {
+        cells.insert(static_cast<uint16_t>(dist(rng)));
+    }
+    return cells;
+}
+
+}
+
+class BrickCellsTest : public ::testing::Test {
+protected:
+    std::mt19937 rng{1234};
+};
+
+// Cells switch to a bitmap past ARRAY_MAX and back once half that remains
+TEST_F(BrickCellsTest, SwitchesRepresentationWithHysteresis) {
+    BrickCells cells;
+    for (uint16_t cell = 0; cell <= BrickCells::ARRAY_MAX; ++cell) {
+        EXPECT_TRUE(cells.insert(cell));
+    }
+    EXPECT_TRUE(cells.isBitmap());
+    EXPECT_FALSE(cells.insert(0));
+    EXPECT_EQ(cells.size(), BrickCells::ARRAY_MAX + 1);
+
+    uint16_t cell = 0;
+    while (cells.size() > BrickCells::ARRAY_MAX / 2 + 1) {
+        EXPECT_TRUE(cells.erase(cell++));
+        EXPECT_TRUE(cells.isBitmap());
+    }
+    EXPECT_TRUE(cells.erase(cell));
+    EXPECT_FALSE(cells.isBitmap());
+    EXPECT_FALSE(cells.contains(cell));
+    EXPECT_TRUE(cells.contains(cell + 1));
+}
+
+// Set algebra matches std::set for every mix of arrays and bitmaps
+TEST_F(BrickCellsTest, SetAlgebraMatchesReference) {
+    const uint32_t sizes[] = {0, 40, BrickCells::ARRAY_MAX, 1500, BrickCells::BRICK_CELLS};
+    for (uint32_t sizeA : sizes) {
+        for (uint32_t sizeB : sizes) {
+            std::set<uint16_t> a = randomCells(rng, sizeA);
+            std::set<uint16_t> b = randomCells(rng, sizeB);
+
+            std::set<uint16_t> expected[4];
+            std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::inserter(expected[0], expected[0].end()));
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::inserter(expected[1], expected[1].end()));
+            std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::inserter(expected[2], expected[2].end()));
+            std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                          std::inserter(expected[3], expected[3].end()));
+
+            BrickCells results[4] = {makeCells(a), makeCells(a), makeCells(a), makeCells(a)};
+            BrickCells other = makeCells(b);
+            results[0].unite(other);
+            results[1].intersect(other);
+            results[2].subtract(other);
+            results[3].symmetricDifference(other);
+
+            for (int op = 0; op < 4; ++op) {
+                EXPECT_EQ(toSet(results[op]), expected[op]) << "op " << op << " sizes " << sizeA << ", " << sizeB;
+                EXPECT_EQ(results[op].size(), expected[op].size());
+                EXPECT_EQ(results[op], makeCells(expected[op]));
+            }
+        }
+    }
+}
+
+// Extent and cell sums agree for arrays and bitmaps
+TEST_F(BrickCellsTest, ExtentAndCellSum) {
+    for (uint32_t count : {5u, 2000u}) {
+        std::set<uint16_t> reference = randomCells(rng, count);
+        BrickCells cells = makeCells(reference);
+        EXPECT_EQ(cells.isBitmap(), count > BrickCells::ARRAY_MAX);
+
+        int expectedLo[3] = {15, 15, 15};
+        int expectedHi[3] = {0, 0, 0};
+        std::array<uint32_t, 3> expectedSum = {0, 0, 0};
+        for (uint16_t cell : reference) {
+            int local[3] = {cell >> 8, (cell >> 4) & 15, cell & 15};
+            for (int axis = 0; axis < 3; ++axis) {
+                expectedLo[axis] = std::min(expectedLo[axis], local[axis]);
+                expectedHi[axis] = std::max(expectedHi[axis], local[axis]);
+                expectedSum[axis] += local[axis];
+            }
+        }
+
+        int lo[3];
+        int hi[3];
+        cells.getExtent(lo, hi);
+        for (int axis = 0; axis < 3; ++axis) {
+            EXPECT_EQ(lo[axis], expectedLo[axis]);
+            EXPECT_EQ(hi[axis], expectedHi[axis]);
+        }
+        EXPECT_EQ(cells.getCellSum(), expectedSum);
+    }
+}
+
+// Keys and cell indices round-trip, including negative coordinates
+TEST_F(BrickCellsTest, AddressingRoundTrips) {
+    const Vector3i positions[] = {
+        Vector3i(0, 0, 0), Vector3i(15, 16, 17), Vector3i(-1, -16, -17), Vector3i(-500000, 123, 499999)
+    };
+    for (const Vector3i& position : positions) {
+        uint64_t key = BrickCells::brickKey(3, position);
+        EXPECT_EQ(BrickCells::keyLevel(key), 3u);
+        Vector3i roundTrip = BrickCells::cellPosition(key, BrickCells::cellIndex(position));
+        EXPECT_EQ(roundTrip.x, position.x);
+        EXPECT_EQ(roundTrip.y, position.y);
+        EXPECT_EQ(roundTrip.z, position.z);
+    }
+    EXPECT_EQ(BrickCells::brickOrigin(BrickCells::brickKey(0, Vector3i(-1, 17, 0))).x, -16);
+    EXPECT_EQ(BrickCells::brickOrigin(BrickCells::brickKey(0, Vector3i(-1, 17, 0))).y, 16);
+}
@@ -0,0 +1,291 @@
+#include <gtest/gtest.h>
+#include "../include/voxel_math/VoxelMathSIMD.h"
+#include "../include/voxel_math/VoxelCollision.h"
+#include "../include/voxel_math/VoxelGridMath.h"
+#include "../../../core/voxel_data/VoxelGrid.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace VoxelEditor;
+using namespace VoxelEditor::Math;
+
+using SIMDLevel = VoxelMathSIMD::SIMDLevel;
+using BoxTest = VoxelMathSIMD::BoxTest;
+
+class VoxelMathSIMDDispatchTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        rng.seed(42);
+    }
+
+    void TearDown() override {
+        VoxelMathSIMD::setSIMDLevel(VoxelMathSIMD::getSupportedSIMDLevel());
+    }
+
+    // Every level this CPU can run, narrowest first
+    std::vector<SIMDLevel> runnableLevels() const {
+        std::vector<SIMDLevel> levels;
+        for (SIMDLevel level : {SIMDLevel::Scalar, SIMDLevel::AVX2, SIMDLevel::AVX512}) {
+            if (level <= VoxelMathSIMD::getSupportedSIMDLevel()) {
+                levels.push_back(level);
+            }
+        }
+        return levels;
+    }
+
+    // Voxel-like boxes on a 1cm lattice, so many of them touch the query
+    // box exactly and the strict/inclusive comparisons are exercised
+    void randomBoxes(size_t count, VoxelMathSIMD::BoundsBuffer& bounds) {
+        std::uniform_int_distribution<int> coord(-40, 40);
+        std::uniform_int_distribution<int> size(1, 16);
+        for (size_t i = 0; i < count; ++i) {
+            Vector3f min(coord(rng) * 0.01f, coord(rng) * 0.01f, coord(rng) * 0.01f);
+            float s = size(rng) * 0.01f;
+            bounds.push(min, min + Vector3f(s, s, s));
+        }
+    }
+
+    // VoxelCollision's overlap rule: touching faces don't count
+    static bool overlaps(const Vector3f& minA, const Vector3f& maxA, const Vector3f& minB, const Vector3f& maxB) {
+        return !(maxA.x <= minB.x || minA.x >= maxB.x ||
+                 maxA.y <= minB.y || minA.y >= maxB.y ||
+                 maxA.z <= minB.z || minA.z >= maxB.z);
+    }
+
+    std::mt19937 rng;
+};
+
+TEST_F(VoxelMathSIMDDispatchTest, LevelSelection) {
+    SIMDLevel supported = VoxelMathSIMD::getSupportedSIMDLevel();
+    EXPECT_EQ(VoxelMathSIMD::getSIMDLevel(), supported);
+
+    VoxelMathSIMD::setSIMDLevel(SIMDLevel::Scalar);
+    EXPECT_EQ(VoxelMathSIMD::getSIMDLevel(), SIMDLevel::Scalar);
+
+    // Asking for more than the CPU has is clamped
+    VoxelMathSIMD::setSIMDLevel(SIMDLevel::AVX512);
+    EXPECT_EQ(VoxelMathSIMD::getSIMDLevel(), supported);
+
+    EXPECT_STREQ(VoxelMathSIMD::getSIMDLevelName(SIMDLevel::AVX2), "AVX2");
+    std::cout << "Supported SIMD level: " << VoxelMathSIMD::getSIMDLevelName(supported) << std::endl;
+}
+
+TEST_F(VoxelMathSIMDDispatchTest, BoxTestsMatchAtEveryLevel) {
+    // Odd count so every level also runs its scalar tail
+    const size_t count = 1003;
+    VoxelMathSIMD::BoundsBuffer bounds;
+    randomBoxes(count, bounds);
+    Vector3f queryMin(-0.1f, -0.05f, -0.12f);
+    Vector3f queryMax(0.08f, 0.1f, 0.04f);
+
+    for (BoxTest test : {BoxTest::Overlap, BoxTest::Intersect, BoxTest::Contained}) {
+        VoxelMathSIMD::setSIMDLevel(SIMDLevel::Scalar);
+        std::unique_ptr<bool[]> expected(new bool[count]);
+        VoxelMathSIMD::testBoundsAgainstBoxSoA(bounds.view(), queryMin, queryMax, test, expected.get(), count);
+
+        // The scalar kernel agrees with the tests it stands in for
+        auto view = bounds.view();
+        for (size_t i = 0; i < count; ++i) {
+            BoundingBox box(Vector3f(view.minX[i], view.minY[i], view.minZ[i]),
+                            Vector3f(view.maxX[i], view.maxY[i], view.maxZ[i]));
+            BoundingBox query(queryMin, queryMax);
+            bool reference = test == BoxTest::Overlap ? overlaps(box.min, box.max, queryMin, queryMax)
+                           : test == BoxTest::Intersect ? query.intersects(box)
+                                                        : query.contains(box);
+            ASSERT_EQ(expected[i], reference) << "box " << i << " test " << static_cast<int>(test);
+        }
+
+        for (SIMDLevel level : runnableLevels()) {
+            VoxelMathSIMD::setSIMDLevel(level);
+            std::unique_ptr<bool[]> results(new bool[count]);
+            VoxelMathSIMD::testBoundsAgainstBoxSoA(bounds.view(), queryMin, queryMax, test, results.get(), count);
+            for (size_t i = 0; i < count; ++i) {
+                ASSERT_EQ(results[i], expected[i]) << VoxelMathSIMD::getSIMDLevelName(level) << " box " << i;
+            }
+        }
+    }
+}
+
+TEST_F(VoxelMathSIMDDispatchTest, SphereTestsMatchAtEveryLevel) {
+    const size_t count = 517;
+    VoxelMathSIMD::BoundsBuffer bounds;
+    randomBoxes(count, bounds);
+    Vector3f center(0.03f, 0.01f, -0.02f);
+    float radius = 0.2f;
+
+    VoxelMathSIMD::setSIMDLevel(SIMDLevel::Scalar);
+    std::unique_ptr<bool[]> expected(new bool[count]);
+    VoxelMathSIMD::testBoundsAgainstSphereSoA(bounds.view(), center, radius, expected.get(), count);
+
+    auto view = bounds.view();
+    size_t inside = 0;
+    for (size_t i = 0; i < count; ++i) {
+        BoundingBox box(Vector3f(view.minX[i], view.minY[i], view.minZ[i]),
+                        Vector3f(view.maxX[i], view.maxY[i], view.maxZ[i]));
+        ASSERT_EQ(expected[i], (box.closestPoint(center) - center).lengthSquared() <= radius * radius);
+        inside += expected[i];
+    }
+    EXPECT_GT(inside, 0u);
+    EXPECT_LT(inside, count);
+
+    for (SIMDLevel level : runnableLevels()) {
+        VoxelMathSIMD::setSIMDLevel(level);
+        std::unique_ptr<bool[]> results(new bool[count]);
+        VoxelMathSIMD::testBoundsAgainstSphereSoA(bounds.view(), center, radius, results.get(), count);
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(results[i], expected[i]) << VoxelMathSIMD::getSIMDLevelName(level) << " box " << i;
+        }
+    }
+}
+
+TEST_F(VoxelMathSIMDDispatchTest, DistancesMatchAtEveryLevel) {
+    const size_t count = 259;
+    std::uniform_real_distribution<float> coord(-3.0f, 3.0f);
+    std::vector<float> x(count), y(count), z(count);
+    for (size_t i = 0; i < count; ++i) {
+        x[i] = coord(rng);
+        y[i] = coord(rng);
+        z[i] = coord(rng);
+    }
+    VoxelMathSIMD::PointsSoA points{x.data(), y.data(), z.data()};
+    Vector3f target(0.5f, -1.0f, 0.25f);
+
+    for (SIMDLevel level : runnableLevels()) {
+        VoxelMathSIMD::setSIMDLevel(level);
+        std::vector<float> distances(count);
+        VoxelMathSIMD::calculateDistancesSoA(points, target, distances.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            // Same operation order at every level, so the results are exact
+            ASSERT_EQ(distances[i], (Vector3f(x[i], y[i], z[i]) - target).length())
+                << VoxelMathSIMD::getSIMDLevelName(level) << " point " << i;
+        }
+    }
+}
+
+TEST_F(VoxelMathSIMDDispatchTest, TranslationMatchesAtEveryLevel) {
+    const size_t count = 1037;
+    std::uniform_int_distribution<int> coord(-1000, 1000);
+    std::vector<IncrementCoordinates> positions;
+    for (size_t i = 0; i < count; ++i) {
+        positions.emplace_back(coord(rng), coord(rng), coord(rng));
+    }
+    Vector3i offset(7, -3, 12);
+
+    for (SIMDLevel level : runnableLevels()) {
+        VoxelMathSIMD::setSIMDLevel(level);
+        // In place, as group moves call it
+        std::vector<IncrementCoordinates> moved = positions;
+        VoxelMathSIMD::transformIncrementBatch(moved.data(), moved.data(), count, nullptr, offset);
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(moved[i], IncrementCoordinates(positions[i].value() + offset))
+                << VoxelMathSIMD::getSIMDLevelName(level) << " position " << i;
+        }
+    }
+}
+
+TEST_F(VoxelMathSIMDDispatchTest, CollisionQueriesMatchFullScan) {
+    VoxelData::VoxelGrid grid(VoxelData::VoxelResolution::Size_4cm, Vector3f(4.0f, 4.0f, 4.0f));
+    std::uniform_int_distribution<int> coord(-60, 60);
+    std::uniform_int_distribution<int> height(0, 60);
+    for (int i = 0; i < 800; ++i) {
+        grid.setVoxel(IncrementCoordinates(coord(rng), height(rng), coord(rng)), true);
+    }
+
+    auto fullScan = [&](const VoxelBounds& region) {
+        std::vector<IncrementCoordinates> found;
+        for (const auto& voxel : grid.getAllVoxels()) {
+            VoxelBounds bounds(voxel.incrementPos, VoxelGridMath::getVoxelSizeMeters(voxel.resolution));
+            if (overlaps(bounds.min().value(), bounds.max().value(), region.min().value(), region.max().value())) {
+                found.push_back(voxel.incrementPos);
+            }
+        }
+        std::sort(found.begin(), found.end());
+        return found;
+    };
+    auto positionsOf = [](const std::vector<VoxelCollision::VoxelInfo>& voxels) {
+        std::vector<IncrementCoordinates> found;
+        for (const auto& voxel : voxels) {
+            found.push_back(voxel.position);
+        }
+        std::sort(found.begin(), found.end());
+        return found;
+    };
+
+    size_t collisions = 0;
+    for (int i = 0; i < 200; ++i) {
+        IncrementCoordinates pos(coord(rng), height(rng), coord(rng));
+        for (auto resolution : {VoxelData::VoxelResolution::Size_1cm, VoxelData::VoxelResolution::Size_4cm,
+                                VoxelData::VoxelResolution::Size_16cm}) {
+            VoxelBounds placement(pos, VoxelGridMath::getVoxelSizeMeters(resolution));
+            auto expected = fullScan(placement);
+            ASSERT_EQ(positionsOf(VoxelCollision::getCollidingVoxels(pos, resolution, grid)), expected)
+                << pos.x() << "," << pos.y() << "," << pos.z() << " res " << static_cast<int>(resolution);
+            ASSERT_EQ(VoxelCollision::checkCollisionWithGrid(pos, resolution, grid), !expected.empty());
+            collisions += !expected.empty();
+        }
+    }
+    EXPECT_GT(collisions, 0u);
+
+    // Regions reaching past the workspace
+    VoxelBounds everything(WorldCoordinates(Vector3f(0.0f, -100.0f, 0.0f)), 200.0f);
+    EXPECT_EQ(positionsOf(VoxelCollision::getVoxelsInRegion(everything, grid)), fullScan(everything));
+    VoxelBounds corner(WorldCoordinates(Vector3f(0.55f, 0.1f, -0.3f)), 0.4f);
+    EXPECT_EQ(positionsOf(VoxelCollision::getVoxelsInRegion(corner, grid)), fullScan(corner));
+}
+
+TEST_F(VoxelMathSIMDDispatchTest, KernelThroughput) {
+    const size_t count = 1 << 16;
+    const int repeats = 20;
+
+    VoxelMathSIMD::BoundsBuffer bounds;
+    randomBoxes(count, bounds);
+    auto view = bounds.view();
+    VoxelMathSIMD::PointsSoA points{view.minX, view.minY, view.minZ};
+    std::vector<IncrementCoordinates> positions(count, IncrementCoordinates(1, 2, 3));
+    std::unique_ptr<bool[]> flags(new bool[count]);
+    std::vector<float> distances(count);
+
+    auto rate = [&](auto&& kernel) {
+        kernel();  // Warm up
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            kernel();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return count * repeats / std::chrono::duration<double>(end - start).count() / 1e6;
+    };
+
+    std::cout << std::left << std::setw(10) << "Level" << std::right
+              << std::setw(12) << "overlap" << std::setw(12) << "contained" << std::setw(12) << "sphere"
+              << std::setw(12) << "distance" << std::setw(12) << "translate"
+              << "  (millions per second)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    for (SIMDLevel level : runnableLevels()) {
+        VoxelMathSIMD::setSIMDLevel(level);
+        double overlap = rate([&] {
+            VoxelMathSIMD::testBoundsAgainstBoxSoA(view, Vector3f(-0.1f), Vector3f(0.1f), BoxTest::Overlap, flags.get(), count);
+        });
+        double contained = rate([&] {
+            VoxelMathSIMD::testBoundsAgainstBoxSoA(view, Vector3f(-0.1f), Vector3f(0.1f), BoxTest::Contained, flags.get(), count);
+        });
+        double sphere = rate([&] {
+            VoxelMathSIMD::testBoundsAgainstSphereSoA(view, Vector3f(0.0f), 0.15f, flags.get(), count);
+        });
+        double distance = rate([&] {
+            VoxelMathSIMD::calculateDistancesSoA(points, Vector3f(0.0f), distances.data(), count);
+        });
+        double translate = rate([&] {
+            VoxelMathSIMD::transformIncrementBatch(positions.data(), positions.data(), count, nullptr, Vector3i(1, 0, -1));
+        });
+        std::cout << std::left << std::setw(10) << VoxelMathSIMD::getSIMDLevelName(level) << std::right
+                  << std::setw(12) << overlap << std::setw(12) << contained << std::setw(12) << sphere
+                  << std::setw(12) << distance << std::setw(12) << translate << std::endl;
+        EXPECT_GT(overlap, 0.0);
+    }
+    std::cout.unsetf(std::ios::fixed);
+}
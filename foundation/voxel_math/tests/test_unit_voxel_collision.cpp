@@ -214,6 +214,24 @@ TEST_F(VoxelCollisionTest, CheckStability) {
         IncrementCoordinates(64, 32, 0), VoxelData::VoxelResolution::Size_32cm, *grid));
 }
 
+TEST_F(VoxelCollisionTest, CheckStabilityThroughGroundedIsland) {
+    auto res = VoxelData::VoxelResolution::Size_32cm;
+    grid->setVoxel(IncrementCoordinates(0, 0, 0), true);
+    grid->setVoxel(IncrementCoordinates(0, 32, 0), true);
+    grid->setVoxel(IncrementCoordinates(32, 32, 0), true);
+
+    // Cantilevered off an island that stands on the ground
+    EXPECT_TRUE(VoxelCollision::checkStability(IncrementCoordinates(64, 32, 0), res, *grid));
+    EXPECT_FALSE(VoxelCollision::checkStability(IncrementCoordinates(96, 64, 0), res, *grid));
+
+    // Removing the base leaves the island floating
+    grid->setVoxel(IncrementCoordinates(0, 0, 0), false);
+    EXPECT_FALSE(VoxelCollision::checkStability(IncrementCoordinates(64, 32, 0), res, *grid));
+
+    grid->setVoxel(IncrementCoordinates(32, 0, 0), true);
+    EXPECT_TRUE(VoxelCollision::checkStability(IncrementCoordinates(64, 32, 0), res, *grid));
+}
+
 // Test edge cases
 TEST_F(VoxelCollisionTest, EdgeCases) {
     // Very small voxels
@@ -119,6 +119,27 @@ TEST_F(VoxelMathSIMDTest, IncrementToWorldBatch) {
     }
 }
 
+// Test batch lattice transform against per-element arithmetic
+TEST_F(VoxelMathSIMDTest, TransformIncrementBatch) {
+    const size_t count = 101;  // Not a multiple of the chunk size
+    auto incrementCoords = generateRandomIncrementCoordinates(count);
+    Vector3i offset(12, -4, 300);
+
+    std::vector<IncrementCoordinates> translated(count);
+    VoxelMathSIMD::transformIncrementBatch(incrementCoords.data(), translated.data(), count, nullptr, offset);
+
+    // 90 degrees about Y: (x, y, z) -> (z, y, -x)
+    const int rotation[9] = {0, 0, 1, 0, 1, 0, -1, 0, 0};
+    std::vector<IncrementCoordinates> rotated = incrementCoords;
+    VoxelMathSIMD::transformIncrementBatch(rotated.data(), rotated.data(), count, rotation, offset);
+
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3i& p = incrementCoords[i].value();
+        EXPECT_EQ(translated[i].value(), p + offset) << "Translation mismatch at index " << i;
+        EXPECT_EQ(rotated[i].value(), Vector3i(p.z, p.y, -p.x) + offset) << "Rotation mismatch at index " << i;
+    }
+}
+
 // Test batch bounds calculation
 TEST_F(VoxelMathSIMDTest, CalculateBoundsBatch) {
     // Note: This test is disabled because calculateBoundsBatch implementation